@@ -148,6 +148,10 @@ int waitpid_test(void);
 
 void mutex_test(void);
 
+/* lockperf.c ***************************************************************/
+
+void lock_perf_test(void);
+
 /* rmutex.c ******************************************************************/
 
 void recursive_mutex_test(void);
@@ -176,6 +180,10 @@ void mqueue_test(void);
 
 void timedmqueue_test(void);
 
+/* mqperf.c *****************************************************************/
+
+void mqueue_perf_test(void);
+
 /* cancel.c *****************************************************************/
 
 void cancel_test(void);
@@ -353,6 +353,14 @@ static int user_main(int argc, char *argv[])
 		check_test_memory_usage();
 #endif
 
+#ifndef CONFIG_DISABLE_PTHREAD
+		/* Measure mutex and semaphore throughput */
+
+		printf("\nuser_main: lock performance test\n");
+		lock_perf_test();
+		check_test_memory_usage();
+#endif
+
 #if !defined(CONFIG_DISABLE_PTHREAD) && defined(CONFIG_PTHREAD_MUTEX_TYPES)
 		/* Verify recursive mutexes */
 
@@ -424,6 +432,14 @@ static int user_main(int argc, char *argv[])
 		check_test_memory_usage();
 #endif
 
+#if !defined(CONFIG_DISABLE_MQUEUE) && !defined(CONFIG_DISABLE_PTHREAD)
+		/* Measure message queue throughput */
+
+		printf("\nuser_main: message queue performance test\n");
+		mqueue_perf_test();
+		check_test_memory_usage();
+#endif
+
 #ifndef CONFIG_DISABLE_SIGNALS
 		/* Verify signal handlers */
 
@@ -0,0 +1,176 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/***********************************************************************
+ * examples/kernel_sample/lockperf.c
+ *
+ * Measures the throughput of pthread mutexes and semaphores, without
+ * contention and with two threads competing for the same mutex.  Run it
+ * with and without CONFIG_PTHREAD_MUTEX_FASTPATH / CONFIG_SEM_FASTPATH to
+ * compare the user-space fast path with the system call path.
+ *
+ ***********************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+#include <pthread.h>
+#include <semaphore.h>
+
+#include "kernel_sample.h"
+
+#define LOCKPERF_LOOPS      100000
+#define LOCKPERF_YIELD_MASK 0xf		/* Yield with the mutex held every 16 loops */
+
+#ifdef CONFIG_CLOCK_MONOTONIC
+#define LOCKPERF_CLOCK      CLOCK_MONOTONIC
+#else
+#define LOCKPERF_CLOCK      CLOCK_REALTIME
+#endif
+
+static pthread_mutex_t g_perf_mutex;
+static volatile uint32_t g_perf_counter;
+
+static uint32_t lockperf_elapsed_usec(FAR const struct timespec *start)
+{
+	struct timespec end;
+
+	clock_gettime(LOCKPERF_CLOCK, &end);
+	return (uint32_t)((end.tv_sec - start->tv_sec) * 1000000 + (end.tv_nsec - start->tv_nsec) / 1000);
+}
+
+static void lockperf_report(FAR const char *name, uint32_t nops, uint32_t usec)
+{
+	if (nops == 0) {
+		return;
+	}
+
+	if (usec == 0) {
+		usec = 1;
+	}
+
+	printf("\t%-24s %8u ops in %8u usec : %6u ns/op, %8u ops/sec\n", name, nops, usec,
+		   (uint32_t)(((uint64_t)usec * 1000) / nops), (uint32_t)(((uint64_t)nops * 1000000) / usec));
+}
+
+static void *lockperf_thread(void *parameter)
+{
+	int i;
+
+	for (i = 0; i < LOCKPERF_LOOPS; i++) {
+		pthread_mutex_lock(&g_perf_mutex);
+		g_perf_counter++;
+
+		/* Give the other thread a chance to find the mutex locked */
+
+		if ((i & LOCKPERF_YIELD_MASK) == 0) {
+			pthread_yield();
+		}
+
+		pthread_mutex_unlock(&g_perf_mutex);
+	}
+
+	return NULL;
+}
+
+static void lockperf_uncontended(void)
+{
+	struct timespec start;
+	sem_t sem;
+	int i;
+
+	pthread_mutex_init(&g_perf_mutex, NULL);
+
+	clock_gettime(LOCKPERF_CLOCK, &start);
+	for (i = 0; i < LOCKPERF_LOOPS; i++) {
+		pthread_mutex_lock(&g_perf_mutex);
+		pthread_mutex_unlock(&g_perf_mutex);
+	}
+	lockperf_report("mutex lock/unlock", LOCKPERF_LOOPS, lockperf_elapsed_usec(&start));
+
+	clock_gettime(LOCKPERF_CLOCK, &start);
+	for (i = 0; i < LOCKPERF_LOOPS; i++) {
+		if (pthread_mutex_trylock(&g_perf_mutex) == OK) {
+			pthread_mutex_unlock(&g_perf_mutex);
+		}
+	}
+	lockperf_report("mutex trylock/unlock", LOCKPERF_LOOPS, lockperf_elapsed_usec(&start));
+
+	pthread_mutex_destroy(&g_perf_mutex);
+
+	/* A semaphore initialized to zero is a signaling semaphore */
+
+	sem_init(&sem, 0, 0);
+
+	clock_gettime(LOCKPERF_CLOCK, &start);
+	for (i = 0; i < LOCKPERF_LOOPS; i++) {
+		sem_post(&sem);
+		sem_wait(&sem);
+	}
+	lockperf_report("sem post/wait", LOCKPERF_LOOPS, lockperf_elapsed_usec(&start));
+
+	sem_destroy(&sem);
+}
+
+static void lockperf_contended(void)
+{
+	struct timespec start;
+	pthread_t thread[2];
+	int i;
+
+	pthread_mutex_init(&g_perf_mutex, NULL);
+	g_perf_counter = 0;
+
+	clock_gettime(LOCKPERF_CLOCK, &start);
+	for (i = 0; i < 2; i++) {
+		if (pthread_create(&thread[i], NULL, lockperf_thread, NULL) != 0) {
+			printf("ERROR: Failed to create thread %d\n", i + 1);
+			thread[i] = 0;
+		}
+	}
+
+	for (i = 0; i < 2; i++) {
+		if (thread[i] != 0) {
+			pthread_join(thread[i], NULL);
+		}
+	}
+	lockperf_report("2 threads lock/unlock", g_perf_counter, lockperf_elapsed_usec(&start));
+
+	if (g_perf_counter != 2 * LOCKPERF_LOOPS) {
+		printf("ERROR: counter is %u, expected %u\n", g_perf_counter, 2 * LOCKPERF_LOOPS);
+	}
+
+	pthread_mutex_destroy(&g_perf_mutex);
+}
+
+void lock_perf_test(void)
+{
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+	printf("Mutex fast path enabled\n");
+#endif
+#ifdef CONFIG_SEM_FASTPATH
+	printf("Semaphore fast path enabled\n");
+#endif
+
+	printf("Uncontended:\n");
+	lockperf_uncontended();
+
+	printf("Contended:\n");
+	lockperf_contended();
+}
@@ -0,0 +1,177 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/***********************************************************************
+ * examples/kernel_sample/mqperf.c
+ *
+ * Measures the message queue throughput with 1, 4 and 16 producer
+ * threads sending to one consumer, which receives with mq_receive() and
+ * with mq_receive_batch().  Run it with and without
+ * CONFIG_MQ_PERQUEUE_SLAB / CONFIG_MQ_PRIO_INDEX to compare.
+ *
+ ***********************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <fcntl.h>
+#include <time.h>
+#include <pthread.h>
+#include <mqueue.h>
+
+#include "kernel_sample.h"
+
+#define MQPERF_NAME         "mqperf"
+#define MQPERF_MSGS         16000	/* Messages per run, split among the producers */
+#define MQPERF_MAXMSG       16
+#define MQPERF_MSGSIZE      32
+#define MQPERF_BATCH        8
+#define MQPERF_NPRIOS       4		/* Producers send with priorities 0 to 3 */
+
+#ifdef CONFIG_CLOCK_MONOTONIC
+#define MQPERF_CLOCK        CLOCK_MONOTONIC
+#else
+#define MQPERF_CLOCK        CLOCK_REALTIME
+#endif
+
+static const int g_mqperf_nproducers[] = { 1, 4, 16 };
+
+static mqd_t g_mqperf_send;
+static int g_mqperf_permsgs;
+
+static uint32_t mqperf_elapsed_usec(FAR const struct timespec *start)
+{
+	struct timespec end;
+
+	clock_gettime(MQPERF_CLOCK, &end);
+	return (uint32_t)((end.tv_sec - start->tv_sec) * 1000000 + (end.tv_nsec - start->tv_nsec) / 1000);
+}
+
+static void *mqperf_producer(void *parameter)
+{
+	char msg[MQPERF_MSGSIZE];
+	int i;
+
+	for (i = 0; i < g_mqperf_permsgs; i++) {
+		msg[0] = (char)i;
+		if (mq_send(g_mqperf_send, msg, MQPERF_MSGSIZE, i % MQPERF_NPRIOS) < 0) {
+			printf("ERROR: mq_send failed\n");
+			break;
+		}
+	}
+
+	return NULL;
+}
+
+static void mqperf_run(mqd_t recv, int nproducers, bool batch)
+{
+	static char msgs[MQPERF_BATCH][MQPERF_MSGSIZE];
+	size_t lens[MQPERF_BATCH];
+	struct timespec start;
+	pthread_t thread[16];
+	uint32_t received = 0;
+	uint32_t expected;
+	uint32_t usec;
+	ssize_t ret;
+	int i;
+
+	g_mqperf_permsgs = MQPERF_MSGS / nproducers;
+	expected = 0;
+
+	clock_gettime(MQPERF_CLOCK, &start);
+	for (i = 0; i < nproducers; i++) {
+		if (pthread_create(&thread[i], NULL, mqperf_producer, NULL) != 0) {
+			printf("ERROR: Failed to create producer %d\n", i + 1);
+			thread[i] = 0;
+		} else {
+			expected += g_mqperf_permsgs;
+		}
+	}
+
+	while (received < expected) {
+		if (batch) {
+			ret = mq_receive_batch(recv, &msgs[0][0], MQPERF_MSGSIZE, lens, MQPERF_BATCH);
+		} else {
+			ret = mq_receive(recv, &msgs[0][0], MQPERF_MSGSIZE, NULL) < 0 ? -1 : 1;
+		}
+
+		if (ret < 0) {
+			printf("ERROR: receive failed\n");
+			break;
+		}
+
+		received += ret;
+	}
+
+	usec = mqperf_elapsed_usec(&start);
+
+	for (i = 0; i < nproducers; i++) {
+		if (thread[i] != 0) {
+			pthread_join(thread[i], NULL);
+		}
+	}
+
+	if (usec == 0) {
+		usec = 1;
+	}
+
+	printf("\t%2d producer(s), %-16s %6u msgs in %8u usec : %8u msgs/sec\n", nproducers,
+		   batch ? "mq_receive_batch" : "mq_receive", received, usec, (uint32_t)(((uint64_t)received * 1000000) / usec));
+}
+
+void mqueue_perf_test(void)
+{
+	struct mq_attr attr;
+	mqd_t recv;
+	int i;
+
+#ifdef CONFIG_MQ_PERQUEUE_SLAB
+	printf("Per-queue message slabs enabled\n");
+#endif
+#ifdef CONFIG_MQ_PRIO_INDEX
+	printf("Priority index enabled\n");
+#endif
+
+	attr.mq_maxmsg = MQPERF_MAXMSG;
+	attr.mq_msgsize = MQPERF_MSGSIZE;
+	attr.mq_flags = 0;
+
+	recv = mq_open(MQPERF_NAME, O_RDONLY | O_CREAT, 0666, &attr);
+	if (recv == (mqd_t)-1) {
+		printf("ERROR: mq_open failed\n");
+		return;
+	}
+
+	g_mqperf_send = mq_open(MQPERF_NAME, O_WRONLY);
+	if (g_mqperf_send == (mqd_t)-1) {
+		printf("ERROR: mq_open failed\n");
+		mq_close(recv);
+		mq_unlink(MQPERF_NAME);
+		return;
+	}
+
+	for (i = 0; i < sizeof(g_mqperf_nproducers) / sizeof(g_mqperf_nproducers[0]); i++) {
+		mqperf_run(recv, g_mqperf_nproducers[i], false);
+		mqperf_run(recv, g_mqperf_nproducers[i], true);
+	}
+
+	mq_close(g_mqperf_send);
+	mq_close(recv);
+	mq_unlink(MQPERF_NAME);
+}
@@ -0,0 +1,335 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include <tinyara/config.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <semaphore.h>
+#include <sys/types.h>
+#include <messaging/messaging.h>
+#include "messaging_sample_internal.h"
+
+#define BENCH_PORT "bench_port"
+
+#define MSG_PRIO 10
+#define TASK_PRIO 100
+#define STACKSIZE 2048
+#define BENCH_MSG_COUNT 200
+#define BENCH_MAX_RECEIVERS 4
+#define BENCH_TIMEOUT_SEC 30
+
+#define LAT_PORT_COUNT 50
+#define LAT_PORT_NAME_LEN 16
+#define LAT_MSG_COUNT 500
+#define LAT_MSG_SIZE 16
+#define LAT_RECV_PRIO 110
+
+extern int fail_cnt;
+
+static int g_bench_msgsize;
+static volatile int g_bench_received;
+static volatile bool g_bench_stop;
+static sem_t g_bench_done_sem;
+static sem_t g_bench_stop_sem;
+
+static char g_lat_ports[LAT_PORT_COUNT][LAT_PORT_NAME_LEN];
+static msg_recv_buf_t g_lat_bufs[LAT_PORT_COUNT];
+static volatile bool g_lat_ready;
+
+static void bench_recv_callback(msg_reply_type_t msg_type, msg_recv_buf_t *recv_data, void *cb_data)
+{
+	if (recv_data == NULL) {
+		return;
+	}
+
+	/* Count the messages of all receivers, the last one wakes up the sender. */
+	if (__atomic_sub_fetch(&g_bench_received, 1, __ATOMIC_RELAXED) == 0) {
+		sem_post(&g_bench_done_sem);
+	}
+}
+
+static int bench_receiver(int argc, FAR char *argv[])
+{
+	int ret;
+	msg_callback_info_t cb_info;
+	msg_recv_buf_t data;
+
+	cb_info.cb_func = bench_recv_callback;
+	cb_info.cb_data = NULL;
+
+	data.buf = (char *)malloc(g_bench_msgsize);
+	if (data.buf == NULL) {
+		fail_cnt++;
+		printf("Fail to allocate benchmark receive buffer.\n");
+		return ERROR;
+	}
+	data.buflen = g_bench_msgsize;
+
+	ret = messaging_recv_nonblock(BENCH_PORT, &data, &cb_info);
+	if (ret != OK) {
+		fail_cnt++;
+		printf("Fail to receive benchmark messages with non-block mode.\n");
+		free(data.buf);
+		return ERROR;
+	}
+
+	/* Messages are received through the callback, which interrupts this wait. */
+	while (!g_bench_stop) {
+		sem_wait(&g_bench_stop_sem);
+	}
+
+	messaging_cleanup(BENCH_PORT);
+	free(data.buf);
+	return OK;
+}
+
+static void bench_run(int nrecv)
+{
+	int ret;
+	int idx;
+	uint32_t msec;
+	uint64_t bytes;
+	struct timespec start;
+	struct timespec end;
+	struct timespec abstime;
+	msg_send_data_t data;
+
+	g_bench_stop = false;
+	g_bench_received = nrecv * BENCH_MSG_COUNT;
+	sem_init(&g_bench_done_sem, 0, 0);
+	sem_init(&g_bench_stop_sem, 0, 0);
+
+	for (idx = 0; idx < nrecv; idx++) {
+		if (task_create("bench_recv", TASK_PRIO, STACKSIZE, bench_receiver, NULL) < 0) {
+			fail_cnt++;
+			printf("Fail to create bench_recv task.\n");
+			nrecv = idx;
+			goto errout;
+		}
+	}
+
+	/* Wait for the receivers to register the port. */
+	sleep(1);
+
+	data.priority = MSG_PRIO;
+	data.msglen = g_bench_msgsize;
+	data.msg = (char *)malloc(g_bench_msgsize);
+	if (data.msg == NULL) {
+		fail_cnt++;
+		printf("Fail to allocate benchmark message.\n");
+		goto errout;
+	}
+	memset(data.msg, 0x5a, g_bench_msgsize);
+
+	clock_gettime(CLOCK_REALTIME, &start);
+
+	for (idx = 0; idx < BENCH_MSG_COUNT; idx++) {
+		ret = messaging_multicast(BENCH_PORT, &data);
+		if (ret != nrecv) {
+			fail_cnt++;
+			printf("Fail to send benchmark message %d, ret %d.\n", idx, ret);
+			free(data.msg);
+			goto errout;
+		}
+	}
+
+	clock_gettime(CLOCK_REALTIME, &abstime);
+	abstime.tv_sec += BENCH_TIMEOUT_SEC;
+	while ((ret = sem_timedwait(&g_bench_done_sem, &abstime)) != OK && errno == EINTR) {
+	}
+	clock_gettime(CLOCK_REALTIME, &end);
+	free(data.msg);
+
+	if (ret != OK) {
+		fail_cnt++;
+		printf("Fail to receive all benchmark messages, %d are missing.\n", g_bench_received);
+		goto errout;
+	}
+
+	msec = (end.tv_sec - start.tv_sec) * 1000 + (end.tv_nsec - start.tv_nsec) / 1000000;
+	if (msec == 0) {
+		msec = 1;
+	}
+	bytes = (uint64_t)nrecv * BENCH_MSG_COUNT * g_bench_msgsize;
+	printf("- %d receiver(s) : %d msgs x %d bytes in %u ms, %u msgs/s, %u KB/s\n", nrecv, BENCH_MSG_COUNT, g_bench_msgsize, msec, (unsigned int)(nrecv * BENCH_MSG_COUNT * 1000 / msec), (unsigned int)(bytes * 1000 / 1024 / msec));
+
+errout:
+	g_bench_stop = true;
+	for (idx = 0; idx < nrecv; idx++) {
+		sem_post(&g_bench_stop_sem);
+	}
+
+	/* Wait for the receivers to clean up the port. */
+	sleep(1);
+
+	sem_destroy(&g_bench_done_sem);
+	sem_destroy(&g_bench_stop_sem);
+}
+
+void benchmark_messaging_sample(int msgsize)
+{
+	int nrecv;
+
+	printf("\n--- Start the Messaging throughput benchmark. ---\n");
+#ifdef CONFIG_MESSAGING_SHARED_PAYLOAD
+	printf("Messages from %d bytes are passed by reference.\n", CONFIG_MESSAGING_SHARED_THRESHOLD);
+#else
+	printf("Messages are copied through the message queue.\n");
+#endif
+
+	g_bench_msgsize = msgsize;
+	for (nrecv = 1; nrecv <= BENCH_MAX_RECEIVERS; nrecv *= 2) {
+		bench_run(nrecv);
+	}
+}
+
+static void lat_recv_callback(msg_reply_type_t msg_type, msg_recv_buf_t *recv_data, void *cb_data)
+{
+}
+
+static int lat_receiver(int argc, FAR char *argv[])
+{
+	int idx;
+	msg_callback_info_t cb_info;
+
+	cb_info.cb_func = lat_recv_callback;
+	cb_info.cb_data = NULL;
+
+	/* Register all ports, the sender uses the last one registered. */
+	for (idx = 0; idx < LAT_PORT_COUNT; idx++) {
+		g_lat_bufs[idx].buf = (char *)malloc(LAT_MSG_SIZE);
+		g_lat_bufs[idx].buflen = LAT_MSG_SIZE;
+		if (g_lat_bufs[idx].buf == NULL || messaging_recv_nonblock(g_lat_ports[idx], &g_lat_bufs[idx], &cb_info) != OK) {
+			fail_cnt++;
+			printf("Fail to register benchmark port %s.\n", g_lat_ports[idx]);
+			free(g_lat_bufs[idx].buf);
+			break;
+		}
+	}
+	g_lat_ready = (idx == LAT_PORT_COUNT);
+
+	while (!g_bench_stop) {
+		sem_wait(&g_bench_stop_sem);
+	}
+
+	while (idx-- > 0) {
+		messaging_cleanup(g_lat_ports[idx]);
+		free(g_lat_bufs[idx].buf);
+	}
+
+	return OK;
+}
+
+static uint32_t lat_elapsed_usec(struct timespec *start)
+{
+	struct timespec end;
+
+	clock_gettime(CLOCK_REALTIME, &end);
+	return (end.tv_sec - start->tv_sec) * 1000000 + (end.tv_nsec - start->tv_nsec) / 1000;
+}
+
+void latency_messaging_sample(void)
+{
+	int idx;
+	uint32_t name_usec;
+	uint32_t port_usec;
+	char msg[LAT_MSG_SIZE];
+	msg_send_data_t data;
+	msg_port_t *port;
+	struct timespec start;
+
+	printf("\n--- Start the Messaging send latency benchmark with %d ports. ---\n", LAT_PORT_COUNT);
+
+	for (idx = 0; idx < LAT_PORT_COUNT; idx++) {
+		snprintf(g_lat_ports[idx], LAT_PORT_NAME_LEN, "lat_port%d", idx);
+	}
+
+	g_bench_stop = false;
+	g_lat_ready = false;
+	sem_init(&g_bench_stop_sem, 0, 0);
+
+	/* The receiver drains its queue as soon as a message arrives. */
+	if (task_create("lat_recv", LAT_RECV_PRIO, STACKSIZE, lat_receiver, NULL) < 0) {
+		fail_cnt++;
+		printf("Fail to create lat_recv task.\n");
+		sem_destroy(&g_bench_stop_sem);
+		return;
+	}
+
+	/* Wait for the receiver to register the ports. */
+	sleep(1);
+	if (!g_lat_ready) {
+		goto errout;
+	}
+
+	memset(msg, 0x5a, sizeof(msg));
+	data.msg = msg;
+	data.msglen = sizeof(msg);
+	data.priority = MSG_PRIO;
+
+	clock_gettime(CLOCK_REALTIME, &start);
+	for (idx = 0; idx < LAT_MSG_COUNT; idx++) {
+		if (messaging_send(g_lat_ports[LAT_PORT_COUNT - 1], &data) != OK) {
+			fail_cnt++;
+			printf("Fail to send benchmark message by port name.\n");
+			goto errout;
+		}
+	}
+	name_usec = lat_elapsed_usec(&start);
+
+	port = messaging_port_open(g_lat_ports[LAT_PORT_COUNT - 1]);
+	if (port == NULL) {
+		fail_cnt++;
+		printf("Fail to open benchmark port.\n");
+		goto errout;
+	}
+
+	clock_gettime(CLOCK_REALTIME, &start);
+	for (idx = 0; idx < LAT_MSG_COUNT; idx++) {
+		if (messaging_port_send(port, &data) != OK) {
+			fail_cnt++;
+			printf("Fail to send benchmark message by port handle.\n");
+			break;
+		}
+	}
+	port_usec = lat_elapsed_usec(&start);
+	messaging_port_close(port);
+
+	if (idx == LAT_MSG_COUNT) {
+		printf("- messaging_send      : %u us per message\n", name_usec / LAT_MSG_COUNT);
+		printf("- messaging_port_send : %u us per message\n", port_usec / LAT_MSG_COUNT);
+	}
+
+errout:
+	g_bench_stop = true;
+	sem_post(&g_bench_stop_sem);
+
+	/* Wait for the receiver to clean up the ports. */
+	sleep(1);
+
+	sem_destroy(&g_bench_stop_sem);
+}
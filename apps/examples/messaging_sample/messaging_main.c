@@ -63,6 +63,10 @@
 
 #define EXEC_NORMAL   0
 #define EXEC_INFINITE 1
+#define EXEC_BENCHMARK 2
+#define EXEC_LATENCY   3
+
+#define BENCH_DEFAULT_MSGSIZE 4096
 
 static volatile bool inf_flag;
 static volatile bool is_running;
@@ -132,13 +136,15 @@ int messaging_main(int argc, char *argv[])
 	int option;
 	char *cmd_arg = NULL;
 	char *cnt_arg = NULL;
+	char *size_arg = NULL;
+	int msgsize;
 	int execution_type = EXEC_NORMAL;
 
-	if (argc >= 4 || argc == 2) {
+	if (argc >= 4 || (argc == 2 && strncmp(argv[1], "-l", 3) != 0)) {
 		goto usage;
 	}
 
-	while ((option = getopt(argc, argv, "r:n:")) != ERROR) {
+	while ((option = getopt(argc, argv, "r:n:b:l")) != ERROR) {
 		switch (option) {
 		case 'r':
 			execution_type = EXEC_INFINITE;
@@ -148,6 +154,13 @@ int messaging_main(int argc, char *argv[])
 			execution_type = EXEC_NORMAL;
 			cnt_arg = optarg;
 			break;
+		case 'b':
+			execution_type = EXEC_BENCHMARK;
+			size_arg = optarg;
+			break;
+		case 'l':
+			execution_type = EXEC_LATENCY;
+			break;
 		case '?':
 		default:
 			goto usage;
@@ -172,6 +185,27 @@ int messaging_main(int argc, char *argv[])
 			goto usage;
 		}
 
+	} else if (execution_type == EXEC_BENCHMARK) {
+		if (is_running) {
+			goto already_running;
+		}
+
+		msgsize = atoi(size_arg);
+		if (msgsize <= 0) {
+			msgsize = BENCH_DEFAULT_MSGSIZE;
+		}
+
+		is_running = true;
+		benchmark_messaging_sample(msgsize);
+		is_running = false;
+	} else if (execution_type == EXEC_LATENCY) {
+		if (is_running) {
+			goto already_running;
+		}
+
+		is_running = true;
+		latency_messaging_sample();
+		is_running = false;
 	} else {
 		if (is_running) {
 			goto already_running;
@@ -196,6 +230,8 @@ usage:
 	printf(" -r start : Execute messaging sample infinitely until stop cmd.\n");
 	printf("    stop  : Stop the messaging sample infinite execution.\n");
 	printf(" -n COUNT : Execute messaging sample COUNT-iterations.\n");
+	printf(" -b SIZE  : Measure the multicast throughput with SIZE-bytes messages (0 : %d bytes).\n", BENCH_DEFAULT_MSGSIZE);
+	printf(" -l       : Measure the send latency by port name and by port handle.\n");
 	return -1;
 already_running:
 	printf("There is already running Messaging Sample.\n");
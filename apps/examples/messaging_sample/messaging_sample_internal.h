@@ -21,5 +21,7 @@
 void noreply_nonblock_messaging_sample(void);
 void sync_block_messaging_sample(void);
 void multicast_messaging_sample(void);
+void benchmark_messaging_sample(int msgsize);
+void latency_messaging_sample(void);
 
 #endif
@@ -0,0 +1,205 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/// @file audiodsp_perf_main.c
+
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <media/audio_dsp.h>
+#include "../perf_timer.h"
+
+#define PERF_RATE       48000	/* One second of frames */
+#define PERF_CHUNK      480		/* Frames per kernel call, 10ms */
+#define PERF_MAX_CH     6
+
+static int16_t g_s16[PERF_CHUNK * PERF_MAX_CH];
+static int16_t g_out[PERF_CHUNK * PERF_MAX_CH];
+static int32_t g_s32[PERF_CHUNK * 2];
+static float g_float[PERF_CHUNK * 2];
+static int16_t g_planar[2][PERF_CHUNK];
+
+/* 5.1 to stereo and stereo to mono, like rechannel() */
+static const int16_t g_mix_5point1[2 * 6] = {
+	16384, 0, 11585, 0, 11585, 0,
+	0, 16384, 11585, 0, 0, 11585,
+};
+
+static const int16_t g_mix_stereo[1 * 2] = { 8192, 8192 };
+
+static const struct {
+	int kernel;
+	const char *name;
+} g_kernels[] = {
+	{ AUDIO_DSP_KERNEL_SCALAR, "scalar" },
+	{ AUDIO_DSP_KERNEL_DSP, "dsp" },
+	{ AUDIO_DSP_KERNEL_NEON, "neon" },
+};
+
+/* Each case processes PERF_CHUNK frames and returns the output samples */
+
+static uint32_t perf_remix_5point1(const struct audio_dsp_ops_s *ops)
+{
+	ops->remix_s16(g_s16, 6, g_out, 2, g_mix_5point1, PERF_CHUNK);
+	return PERF_CHUNK * 2;
+}
+
+static uint32_t perf_remix_stereo(const struct audio_dsp_ops_s *ops)
+{
+	ops->remix_s16(g_s16, 2, g_out, 1, g_mix_stereo, PERF_CHUNK);
+	return PERF_CHUNK;
+}
+
+static uint32_t perf_gain(const struct audio_dsp_ops_s *ops)
+{
+	ops->gain_s16(g_s16, g_out, PERF_CHUNK * 2, AUDIO_DSP_GAIN_ONE / 2);
+	return PERF_CHUNK * 2;
+}
+
+static uint32_t perf_s16_to_s32(const struct audio_dsp_ops_s *ops)
+{
+	ops->s16_to_s32(g_s16, g_s32, PERF_CHUNK * 2);
+	return PERF_CHUNK * 2;
+}
+
+static uint32_t perf_s32_to_s16(const struct audio_dsp_ops_s *ops)
+{
+	ops->s32_to_s16(g_s32, g_out, PERF_CHUNK * 2);
+	return PERF_CHUNK * 2;
+}
+
+static uint32_t perf_s16_to_float(const struct audio_dsp_ops_s *ops)
+{
+	ops->s16_to_float(g_s16, g_float, PERF_CHUNK * 2);
+	return PERF_CHUNK * 2;
+}
+
+static uint32_t perf_float_to_s16(const struct audio_dsp_ops_s *ops)
+{
+	ops->float_to_s16(g_float, g_out, PERF_CHUNK * 2);
+	return PERF_CHUNK * 2;
+}
+
+static uint32_t perf_deinterleave(const struct audio_dsp_ops_s *ops)
+{
+	int16_t *planar[2] = { g_planar[0], g_planar[1] };
+
+	ops->deinterleave_s16(g_s16, 2, planar, PERF_CHUNK);
+	return PERF_CHUNK * 2;
+}
+
+static uint32_t perf_interleave(const struct audio_dsp_ops_s *ops)
+{
+	const int16_t *planar[2] = { g_planar[0], g_planar[1] };
+
+	ops->interleave_s16(planar, 2, g_out, PERF_CHUNK);
+	return PERF_CHUNK * 2;
+}
+
+static const struct {
+	uint32_t (*run)(const struct audio_dsp_ops_s *ops);
+	const char *name;
+} g_cases[] = {
+	{ perf_remix_5point1, "remix 5.1->2" },
+	{ perf_remix_stereo, "remix 2->1" },
+	{ perf_gain, "gain" },
+	{ perf_s16_to_s32, "s16->s32" },
+	{ perf_s32_to_s16, "s32->s16" },
+	{ perf_s16_to_float, "s16->float" },
+	{ perf_float_to_s16, "float->s16" },
+	{ perf_deinterleave, "deinterleave" },
+	{ perf_interleave, "interleave" },
+};
+
+/*
+ * @fn                   :perf_case
+ * @description          :Run one case over one second of audio with the
+ *                        given kernels
+ * @return               :void
+ */
+static void perf_case(struct perf_timer_s *timer, int index, const struct audio_dsp_ops_s *ops, const char *kernel)
+{
+	uint32_t samples = 0;
+	uint64_t cycles;
+	long long usec;
+	int frames;
+
+	perf_timer_start(timer);
+
+	for (frames = 0; frames < PERF_RATE; frames += PERF_CHUNK) {
+		samples += g_cases[index].run(ops);
+	}
+
+	usec = perf_timer_stop(timer, &cycles);
+	if (usec == 0) {
+		usec = 1;
+	}
+
+	if (cycles != 0) {
+		printf("%-12s %-8s : %6u samples, %8lld usec, %4u.%02u cycles/sample, %6u Ksamples/s\n", g_cases[index].name, kernel, samples, usec,
+			   (unsigned int)(cycles / samples), (unsigned int)(cycles * 100 / samples % 100), (unsigned int)(samples * 1000LL / usec));
+	} else {
+		printf("%-12s %-8s : %6u samples, %8lld usec, %6u ns/sample, %6u Ksamples/s\n", g_cases[index].name, kernel, samples, usec,
+			   (unsigned int)(usec * 1000 / samples), (unsigned int)(samples * 1000LL / usec));
+	}
+}
+
+/****************************************************************************
+ * audiodsp_perf_main
+ ****************************************************************************/
+
+#ifdef CONFIG_BUILD_KERNEL
+int main(int argc, FAR char *argv[])
+#else
+int audiodsp_perf_main(int argc, char *argv[])
+#endif
+{
+	struct perf_timer_s timer;
+	const struct audio_dsp_ops_s *ops;
+	uint32_t seed = 1;
+	int i;
+	int j;
+
+	for (i = 0; i < PERF_CHUNK * PERF_MAX_CH; i++) {
+		seed = seed * 1103515245 + 12345;
+		g_s16[i] = (int16_t)(seed >> 16);
+	}
+	for (i = 0; i < PERF_CHUNK * 2; i++) {
+		g_s32[i] = (int32_t)g_s16[i] << 16;
+		g_float[i] = (float)g_s16[i] / 32768.0f;
+	}
+
+	perf_timer_open(&timer);
+
+	for (i = 0; i < sizeof(g_cases) / sizeof(g_cases[0]); i++) {
+		for (j = 0; j < sizeof(g_kernels) / sizeof(g_kernels[0]); j++) {
+			ops = audio_dsp_get_ops(g_kernels[j].kernel);
+			if (ops == NULL) {
+				printf("%-12s %-8s : not built in\n", g_cases[i].name, g_kernels[j].name);
+				continue;
+			}
+			perf_case(&timer, i, ops, g_kernels[j].name);
+		}
+	}
+
+	perf_timer_close(&timer);
+
+	return OK;
+}
@@ -0,0 +1,110 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/// @file compress_load_perf_main.c
+
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <tinyara/os_api_test_drv.h>
+
+#define PERF_FILE	CONFIG_EXAMPLES_COMPRESS_LOAD_PERF_FILE
+#define PERF_OFFSET	CONFIG_EXAMPLES_COMPRESS_LOAD_PERF_OFFSET
+#define PERF_LOOPS	CONFIG_EXAMPLES_COMPRESS_LOAD_PERF_LOOPS
+
+/*
+ * @fn                   :perf_load
+ * @description          :Load the binary PERF_LOOPS times with the block
+ *                        cache enabled or disabled and print the average
+ *                        load time and the cache statistics of a load
+ * @return               :average load time in usec, or -1 on failure
+ */
+static long perf_load(int fd, bool cache)
+{
+	struct compress_loadperf_s perf;
+	uint32_t total = 0;
+	uint32_t min = UINT32_MAX;
+	uint32_t max = 0;
+	int loop;
+
+	for (loop = 0; loop < PERF_LOOPS; loop++) {
+		memset(&perf, 0, sizeof(perf));
+		perf.path = PERF_FILE;
+		perf.offset = PERF_OFFSET;
+		perf.cache = cache;
+
+		if (ioctl(fd, TESTIOC_COMPRESSION_LOAD_PERF, (unsigned long)&perf) != OK) {
+			printf("Loading %s failed, errno %d\n", PERF_FILE, errno);
+			return -1;
+		}
+
+		total += perf.usec;
+		if (perf.usec < min) {
+			min = perf.usec;
+		}
+		if (perf.usec > max) {
+			max = perf.usec;
+		}
+	}
+
+	printf("cache %-3s : avg %8u usec, min %8u, max %8u | hits %5u, misses %5u, prefetched %5u\n", cache ? "on" : "off", total / PERF_LOOPS, min, max, perf.hits, perf.misses, perf.prefetched);
+	return total / PERF_LOOPS;
+}
+
+/****************************************************************************
+ * compress_load_perf_main
+ ****************************************************************************/
+
+#ifdef CONFIG_BUILD_KERNEL
+int main(int argc, FAR char *argv[])
+#else
+int compress_load_perf_main(int argc, char *argv[])
+#endif
+{
+	long off;
+	long on;
+	int fd;
+
+	fd = open(OS_API_TEST_DRVPATH, O_WRONLY);
+	if (fd < 0) {
+		printf("Cannot open %s, errno %d\n", OS_API_TEST_DRVPATH, errno);
+		return ERROR;
+	}
+
+	printf("Loading %s %d times for each configuration\n", PERF_FILE, PERF_LOOPS);
+
+	off = perf_load(fd, false);
+	on = perf_load(fd, true);
+	close(fd);
+
+	if (off < 0 || on < 0) {
+		return ERROR;
+	}
+
+	if (on > 0) {
+		printf("Speedup with cache : %ld.%02ldx\n", off / on, (off * 100 / on) % 100);
+	}
+
+	return OK;
+}
@@ -0,0 +1,101 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/// @file mp3dec_perf_main.c
+
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <errno.h>
+#include <audiocodec/mp3dec_perf.h>
+#include "../perf_timer.h"
+
+#define PERF_FRAMES     100		/* About 2.6s at 44.1KHz */
+
+static const struct {
+	int stages;
+	const char *name;
+} g_cases[] = {
+	{ MP3DEC_PERF_IMDCT, "imdct" },
+	{ MP3DEC_PERF_SYNTHESIS, "synthesis" },
+	{ MP3DEC_PERF_IMDCT | MP3DEC_PERF_SYNTHESIS, "frame" },
+};
+
+/*
+ * @fn                   :perf_case
+ * @description          :Decode PERF_FRAMES stereo frames through the given
+ *                        stages. The checksum of the last granule of each
+ *                        frame must not depend on the kernels built in.
+ * @return               :void
+ */
+static void perf_case(struct perf_timer_s *timer, int index)
+{
+	uint32_t sum = 2166136261U;
+	uint64_t cycles;
+	long long usec;
+	int frame;
+
+	mp3dec_perf_reset();
+
+	perf_timer_start(timer);
+
+	for (frame = 0; frame < PERF_FRAMES; frame++) {
+		sum = mp3dec_perf_frame(frame, g_cases[index].stages, sum);
+	}
+
+	usec = perf_timer_stop(timer, &cycles);
+
+	if (cycles != 0) {
+		printf("%-10s : %3d frames, %8lld usec, %8u cycles/frame", g_cases[index].name, PERF_FRAMES, usec, (unsigned int)(cycles / PERF_FRAMES));
+	} else {
+		printf("%-10s : %3d frames, %8lld usec, %8u usec/frame", g_cases[index].name, PERF_FRAMES, usec, (unsigned int)(usec / PERF_FRAMES));
+	}
+	if (g_cases[index].stages & MP3DEC_PERF_SYNTHESIS) {
+		printf(", checksum %08x", sum);
+	}
+	printf("\n");
+}
+
+/****************************************************************************
+ * mp3dec_perf_main
+ ****************************************************************************/
+
+#ifdef CONFIG_BUILD_KERNEL
+int main(int argc, FAR char *argv[])
+#else
+int mp3dec_perf_main(int argc, char *argv[])
+#endif
+{
+	struct perf_timer_s timer;
+	int i;
+
+	perf_timer_open(&timer);
+
+#ifdef CONFIG_AUDIO_CODEC_MP3_ARM_DSP
+	printf("MP3 decoder with ARM DSP kernels\n");
+#else
+	printf("MP3 decoder with C kernels\n");
+#endif
+	for (i = 0; i < sizeof(g_cases) / sizeof(g_cases[0]); i++) {
+		perf_case(&timer, i);
+	}
+
+	perf_timer_close(&timer);
+
+	return OK;
+}
@@ -0,0 +1,115 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/// @file perf_timer.h
+/// @brief Elapsed time and cycle measurement shared by the performance examples
+
+#ifndef __APPS_EXAMPLES_PERFORMANCE_PERF_TIMER_H
+#define __APPS_EXAMPLES_PERFORMANCE_PERF_TIMER_H
+
+#include <tinyara/config.h>
+#include <sys/types.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#ifdef CONFIG_PERF_COUNTERS
+#include <tinyara/perf.h>
+#include <tinyara/fs/ioctl.h>
+#endif
+
+struct perf_timer_s {
+	int fd;						/* /dev/perf, or -1 if cycles are not counted */
+	struct timespec start;		/* Time of the last perf_timer_start() */
+};
+
+static inline long long perf_elapsed_usec(const struct timespec *start, const struct timespec *end)
+{
+	return (long long)(end->tv_sec - start->tv_sec) * 1000000LL + (end->tv_nsec - start->tv_nsec) / 1000;
+}
+
+/*
+ * @fn                   :perf_timer_open
+ * @description          :Count the cycles of this task through /dev/perf if
+ *                        CONFIG_PERF_COUNTERS is enabled and the device can
+ *                        be configured; otherwise only the time is measured
+ * @return               :void
+ */
+static inline void perf_timer_open(struct perf_timer_s *timer)
+{
+#ifdef CONFIG_PERF_COUNTERS
+	struct perf_config_s config;
+
+	timer->fd = open(PERF_DRVPATH, O_RDWR);
+	config.nevents = 1;
+	config.events[0] = PERF_EVENT_CYCLES;
+	if (timer->fd >= 0 && ioctl(timer->fd, PERFIOC_CONFIG, (unsigned long)&config) < 0) {
+		close(timer->fd);
+		timer->fd = -1;
+	}
+#else
+	timer->fd = -1;
+#endif
+}
+
+static inline void perf_timer_close(struct perf_timer_s *timer)
+{
+	if (timer->fd >= 0) {
+		close(timer->fd);
+		timer->fd = -1;
+	}
+}
+
+static inline void perf_timer_start(struct perf_timer_s *timer)
+{
+#ifdef CONFIG_PERF_COUNTERS
+	if (timer->fd >= 0) {
+		(void)ioctl(timer->fd, PERFIOC_RESET, PERF_PID_SELF);
+	}
+#endif
+	clock_gettime(CLOCK_REALTIME, &timer->start);
+}
+
+/*
+ * @fn                   :perf_timer_stop
+ * @description          :Measure the time since perf_timer_start() and read
+ *                        the cycles of this task counted meanwhile
+ * @return               :elapsed usec; *cycles is 0 if they are not counted
+ */
+static inline long long perf_timer_stop(struct perf_timer_s *timer, uint64_t *cycles)
+{
+	struct timespec end;
+#ifdef CONFIG_PERF_COUNTERS
+	struct perf_read_s result;
+#endif
+
+	clock_gettime(CLOCK_REALTIME, &end);
+
+	*cycles = 0;
+#ifdef CONFIG_PERF_COUNTERS
+	result.pid = PERF_PID_SELF;
+	if (timer->fd >= 0 && ioctl(timer->fd, PERFIOC_READ, (unsigned long)&result) == OK && result.nevents == 1) {
+		*cycles = result.counts[0];
+	}
+#endif
+
+	return perf_elapsed_usec(&timer->start, &end);
+}
+
+#endif							/* __APPS_EXAMPLES_PERFORMANCE_PERF_TIMER_H */
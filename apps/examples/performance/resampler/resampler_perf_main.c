@@ -0,0 +1,140 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/// @file resampler_perf_main.c
+
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <media/samplerate.h>
+#include "../perf_timer.h"
+
+#define PERF_CHANNELS   2
+#define PERF_CHUNK      256		/* Input frames per src_simple() call */
+#define PERF_OUT_FRAMES 1024
+
+static int16_t g_input[PERF_CHUNK * PERF_CHANNELS];
+static int16_t g_output[PERF_OUT_FRAMES * PERF_CHANNELS];
+
+static const struct {
+	int kernel;
+	const char *name;
+} g_kernels[] = {
+	{ SRC_KERNEL_SCALAR, "scalar" },
+	{ SRC_KERNEL_DSP, "dsp" },
+	{ SRC_KERNEL_NEON, "neon" },
+};
+
+/*
+ * @fn                   :perf_resample
+ * @description          :Resample one second of audio with the given kernel
+ * @return               :OK, or ERROR if the kernel is not built in
+ */
+static int perf_resample(struct perf_timer_s *timer, int in_rate, int out_rate, int kernel, const char *name)
+{
+	src_handle_t handle;
+	src_data_t data;
+	uint64_t cycles;
+	long long usec;
+	int out_frames = 0;
+	int in_frames;
+
+	handle = src_init(CONFIG_AUDIO_RESAMPLER_BUFSIZE);
+	if (handle == NULL) {
+		return ERROR;
+	}
+
+	if (src_set_kernel(handle, kernel) != SRC_ERR_NO_ERROR) {
+		src_destroy(handle);
+		return ERROR;
+	}
+
+	perf_timer_start(timer);
+
+	for (in_frames = 0; in_frames < in_rate; in_frames += PERF_CHUNK) {
+		memset(&data, 0, sizeof(data));
+		data.data_in = g_input;
+		data.input_frames = PERF_CHUNK;
+		data.origin_sample_rate = in_rate;
+		data.origin_sample_width = SAMPLE_WIDTH_16BITS;
+		data.origin_channel_num = PERF_CHANNELS;
+		data.desired_sample_rate = out_rate;
+		data.desired_sample_width = SAMPLE_WIDTH_16BITS;
+		data.desired_channel_num = PERF_CHANNELS;
+		data.data_out = g_output;
+		data.out_buf_length = sizeof(g_output);
+
+		if (src_simple(handle, &data) != SRC_ERR_NO_ERROR) {
+			break;
+		}
+		out_frames += data.output_frames_gen;
+	}
+
+	usec = perf_timer_stop(timer, &cycles);
+	src_destroy(handle);
+
+	if (out_frames == 0) {
+		return OK;
+	}
+
+	if (cycles != 0) {
+		printf("%5d -> %5d %-8s : %6d frames, %8lld usec, %6u cycles/frame\n", in_rate, out_rate, name, out_frames, usec, (unsigned int)(cycles / out_frames));
+	} else {
+		printf("%5d -> %5d %-8s : %6d frames, %8lld usec, %6u ns/frame\n", in_rate, out_rate, name, out_frames, usec, (unsigned int)(usec * 1000 / out_frames));
+	}
+
+	return OK;
+}
+
+/****************************************************************************
+ * resampler_perf_main
+ ****************************************************************************/
+
+#ifdef CONFIG_BUILD_KERNEL
+int main(int argc, FAR char *argv[])
+#else
+int resampler_perf_main(int argc, char *argv[])
+#endif
+{
+	static const int rates[][2] = { { 44100, 48000 }, { 48000, 16000 } };
+	struct perf_timer_s timer;
+	uint32_t seed = 1;
+	int i;
+	int j;
+
+	for (i = 0; i < PERF_CHUNK * PERF_CHANNELS; i++) {
+		seed = seed * 1103515245 + 12345;
+		g_input[i] = (int16_t)(seed >> 16) >> 2;
+	}
+
+	perf_timer_open(&timer);
+
+	for (i = 0; i < sizeof(rates) / sizeof(rates[0]); i++) {
+		for (j = 0; j < sizeof(g_kernels) / sizeof(g_kernels[0]); j++) {
+			if (perf_resample(&timer, rates[i][0], rates[i][1], g_kernels[j].kernel, g_kernels[j].name) != OK) {
+				printf("%5d -> %5d %-8s : not built in\n", rates[i][0], rates[i][1], g_kernels[j].name);
+			}
+		}
+	}
+
+	perf_timer_close(&timer);
+
+	return OK;
+}
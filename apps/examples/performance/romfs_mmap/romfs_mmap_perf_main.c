@@ -0,0 +1,164 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/// @file romfs_mmap_perf_main.c
+
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "../perf_timer.h"
+
+#define PERF_FILE	CONFIG_EXAMPLES_ROMFS_MMAP_PERF_FILE
+#define PERF_CHUNK	CONFIG_EXAMPLES_ROMFS_MMAP_PERF_CHUNK
+#define PERF_LOOPS	CONFIG_EXAMPLES_ROMFS_MMAP_PERF_LOOPS
+
+static uint8_t g_chunk[PERF_CHUNK];
+
+static uint32_t checksum(const uint8_t *buf, size_t len, uint32_t sum)
+{
+	while (len--) {
+		sum += *buf++;
+	}
+	return sum;
+}
+
+static void print_result(const char *name, long long usec, off_t size, uint32_t sum)
+{
+	long long total = (long long)size * PERF_LOOPS;
+
+	printf("%-14s : %8lld usec, %6lld KB/s (checksum %08x)\n", name, usec, usec > 0 ? (total * 1000000LL / 1024) / usec : 0, sum);
+}
+
+/*
+ * @fn                   :perf_read
+ * @description          :Stream the file with read() into a chunk buffer
+ * @return               :checksum of the data read, or 0 on failure
+ */
+static uint32_t perf_read(off_t size)
+{
+	struct timespec start;
+	struct timespec end;
+	uint32_t sum = 0;
+	ssize_t nread;
+	int loop;
+	int fd;
+
+	clock_gettime(CLOCK_REALTIME, &start);
+	for (loop = 0; loop < PERF_LOOPS; loop++) {
+		fd = open(PERF_FILE, O_RDONLY);
+		if (fd < 0) {
+			printf("open %s failed, errno %d\n", PERF_FILE, errno);
+			return 0;
+		}
+		while ((nread = read(fd, g_chunk, PERF_CHUNK)) > 0) {
+			sum = checksum(g_chunk, nread, sum);
+		}
+		close(fd);
+	}
+	clock_gettime(CLOCK_REALTIME, &end);
+
+	print_result("read()", perf_elapsed_usec(&start, &end), size, sum);
+	return sum;
+}
+
+/*
+ * @fn                   :perf_mmap
+ * @description          :Stream the file through a mapping, either copying
+ *                        each chunk out like read() does or consuming the
+ *                        data in place
+ * @return               :checksum of the data read, or 0 on failure
+ */
+static uint32_t perf_mmap(off_t size, bool copy)
+{
+	struct timespec start;
+	struct timespec end;
+	const uint8_t *addr;
+	uint32_t sum = 0;
+	off_t pos;
+	size_t len;
+	int loop;
+	int fd;
+
+	clock_gettime(CLOCK_REALTIME, &start);
+	for (loop = 0; loop < PERF_LOOPS; loop++) {
+		fd = open(PERF_FILE, O_RDONLY);
+		if (fd < 0) {
+			printf("open %s failed, errno %d\n", PERF_FILE, errno);
+			return 0;
+		}
+		addr = (const uint8_t *)mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+		if (addr == MAP_FAILED) {
+			printf("mmap failed, errno %d. Is %s on XIP media?\n", errno, PERF_FILE);
+			close(fd);
+			return 0;
+		}
+		for (pos = 0; pos < size; pos += len) {
+			len = (size - pos) > PERF_CHUNK ? PERF_CHUNK : (size - pos);
+			if (copy) {
+				memcpy(g_chunk, addr + pos, len);
+				sum = checksum(g_chunk, len, sum);
+			} else {
+				sum = checksum(addr + pos, len, sum);
+			}
+		}
+		munmap((void *)addr, size);
+		close(fd);
+	}
+	clock_gettime(CLOCK_REALTIME, &end);
+
+	print_result(copy ? "mmap()+memcpy" : "mmap() direct", perf_elapsed_usec(&start, &end), size, sum);
+	return sum;
+}
+
+/****************************************************************************
+ * romfs_mmap_perf_main
+ ****************************************************************************/
+
+#ifdef CONFIG_BUILD_KERNEL
+int main(int argc, FAR char *argv[])
+#else
+int romfs_mmap_perf_main(int argc, char *argv[])
+#endif
+{
+	struct stat st;
+	uint32_t sum;
+
+	if (stat(PERF_FILE, &st) < 0 || st.st_size <= 0) {
+		printf("Cannot stat %s, errno %d\n", PERF_FILE, errno);
+		return ERROR;
+	}
+
+	printf("Streaming %s (%d bytes) %d times in %d byte chunks\n", PERF_FILE, (int)st.st_size, PERF_LOOPS, PERF_CHUNK);
+
+	sum = perf_read(st.st_size);
+	if (perf_mmap(st.st_size, true) != sum || perf_mmap(st.st_size, false) != sum) {
+		printf("Checksum mismatch between read() and mmap()\n");
+		return ERROR;
+	}
+
+	return OK;
+}
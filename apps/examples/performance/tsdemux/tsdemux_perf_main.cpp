@@ -0,0 +1,305 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/// @file tsdemux_perf_main.cpp
+
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <memory>
+#include <media/Demuxer.h>
+#include "../perf_timer.h"
+
+using namespace media;
+
+#define TS_PACKET_SIZE      188
+#define TS_PAYLOAD_SIZE     (TS_PACKET_SIZE - 4)
+#define TS_PID_PAT          0x0000
+#define TS_PID_PMT          0x0100
+#define TS_PID_AUDIO        0x0101
+#define TS_PID_NULL         0x1fff
+
+#define PES_HEADER_SIZE     14		/* With PTS */
+#define PES_ES_SIZE         1400	/* Last TS packet of the PES is stuffed */
+#define PES_PER_SEGMENT     4
+#define NULL_INTERVAL       4		/* A null packet after every 4 audio ones */
+
+/*
+ * One segment is PAT, PMT and 4 PES packets of 8 TS packets each, 32 audio
+ * packets keep the continuity counter going when the segment is repeated.
+ */
+#define AUDIO_PACKETS       (PES_PER_SEGMENT * 8)
+#define SEGMENT_PACKETS     (2 + AUDIO_PACKETS + AUDIO_PACKETS / NULL_INTERVAL)
+#define SEGMENT_SIZE        (SEGMENT_PACKETS * TS_PACKET_SIZE)
+#define SEGMENT_ES_SIZE     (PES_PER_SEGMENT * PES_ES_SIZE)
+
+#define PERF_SEGMENTS       256		/* About 2MB of TS */
+#define PERF_PULL_SIZE      1024
+
+static uint8_t g_segment[SEGMENT_SIZE];
+static uint8_t g_es[SEGMENT_ES_SIZE];
+static uint8_t g_pull[PERF_PULL_SIZE];
+
+static uint32_t crc32_mpeg2(const uint8_t *data, int length)
+{
+	uint32_t crc = 0xffffffff;
+	int i;
+
+	while (length--) {
+		crc ^= (uint32_t)(*data++) << 24;
+		for (i = 0; i < 8; i++) {
+			crc = (crc & 0x80000000) ? (crc << 1) ^ 0x04c11db7 : (crc << 1);
+		}
+	}
+	return crc;
+}
+
+static uint8_t *put_ts_header(uint8_t *pkt, uint16_t pid, bool start, uint8_t cc, int payload)
+{
+	int stuffing = TS_PAYLOAD_SIZE - payload;
+
+	pkt[0] = 0x47;
+	pkt[1] = (start ? 0x40 : 0x00) | (pid >> 8);
+	pkt[2] = pid & 0xff;
+	pkt[3] = (stuffing > 0 ? 0x30 : 0x10) | (cc & 0x0f);
+	if (stuffing == 0) {
+		return pkt + 4;
+	}
+
+	/* Adaptation field with stuffing bytes only */
+	pkt[4] = stuffing - 1;
+	if (stuffing > 1) {
+		pkt[5] = 0x00;
+		memset(pkt + 6, 0xff, stuffing - 2);
+	}
+	return pkt + 4 + stuffing;
+}
+
+static uint8_t *put_section(uint8_t *pkt, uint16_t pid, const uint8_t *section, int length)
+{
+	uint8_t *p = put_ts_header(pkt, pid, true, 0, TS_PAYLOAD_SIZE);
+	uint32_t crc = crc32_mpeg2(section, length);
+
+	*p++ = 0x00;				/* pointer_field */
+	memcpy(p, section, length);
+	p += length;
+	*p++ = crc >> 24;
+	*p++ = crc >> 16;
+	*p++ = crc >> 8;
+	*p++ = crc;
+	memset(p, 0xff, pkt + TS_PACKET_SIZE - p);
+	return pkt + TS_PACKET_SIZE;
+}
+
+/*
+ * @fn                   :make_segment
+ * @description          :Generate a transport stream segment with one AAC
+ *                        audio program, and the audio elementary stream
+ *                        it carries
+ * @return               :void
+ */
+static void make_segment(void)
+{
+	static const uint8_t pat[] = {
+		0x00, 0xb0, 0x0d, 0x00, 0x01, 0xc1, 0x00, 0x00,
+		0x00, 0x01, 0xe0 | (TS_PID_PMT >> 8), TS_PID_PMT & 0xff,
+	};
+	static const uint8_t pmt[] = {
+		0x02, 0xb0, 0x12, 0x00, 0x01, 0xc1, 0x00, 0x00,
+		0xe0 | (TS_PID_AUDIO >> 8), TS_PID_AUDIO & 0xff, 0xf0, 0x00,
+		0x0f, 0xe0 | (TS_PID_AUDIO >> 8), TS_PID_AUDIO & 0xff, 0xf0, 0x00,
+	};
+	uint8_t *pkt = g_segment;
+	uint8_t *p;
+	uint8_t cc = 0;
+	int audio = 0;
+	int es = 0;
+	int pes;
+	int left;
+	int len;
+	int i;
+
+	for (i = 0; i < SEGMENT_ES_SIZE; i++) {
+		g_es[i] = (uint8_t)(i * 7 + (i >> 8));
+	}
+
+	pkt = put_section(pkt, TS_PID_PAT, pat, sizeof(pat));
+	pkt = put_section(pkt, TS_PID_PMT, pmt, sizeof(pmt));
+
+	for (pes = 0; pes < PES_PER_SEGMENT; pes++) {
+		uint32_t pts = pes * 1920;
+		uint16_t pesLength = 3 + 5 + PES_ES_SIZE;
+		bool start = true;
+
+		left = PES_HEADER_SIZE + PES_ES_SIZE;
+		while (left > 0) {
+			len = left < TS_PAYLOAD_SIZE ? left : TS_PAYLOAD_SIZE;
+			p = put_ts_header(pkt, TS_PID_AUDIO, start, cc++, len);
+			left -= len;
+			if (start) {
+				/* PES header with PTS, the ES data follows it */
+				p[0] = 0x00;
+				p[1] = 0x00;
+				p[2] = 0x01;
+				p[3] = 0xc0;
+				p[4] = pesLength >> 8;
+				p[5] = pesLength & 0xff;
+				p[6] = 0x80;
+				p[7] = 0x80;
+				p[8] = 0x05;
+				p[9] = 0x21 | ((pts >> 29) & 0x0e);
+				p[10] = pts >> 22;
+				p[11] = 0x01 | ((pts >> 14) & 0xfe);
+				p[12] = pts >> 7;
+				p[13] = 0x01 | ((pts << 1) & 0xfe);
+				p += PES_HEADER_SIZE;
+				len -= PES_HEADER_SIZE;
+				start = false;
+			}
+			memcpy(p, &g_es[es], len);
+			es += len;
+			pkt += TS_PACKET_SIZE;
+
+			if (++audio % NULL_INTERVAL == 0) {
+				put_ts_header(pkt, TS_PID_NULL, false, 0, TS_PAYLOAD_SIZE);
+				memset(pkt + 4, 0xff, TS_PAYLOAD_SIZE);
+				pkt += TS_PACKET_SIZE;
+			}
+		}
+	}
+}
+
+/* Compare the pulled data with the ES of the repeated segments */
+static bool check_es(size_t pulled, size_t size)
+{
+	size_t pos = pulled % SEGMENT_ES_SIZE;
+	size_t len;
+	size_t i;
+
+	for (i = 0; i < size; i += len) {
+		len = SEGMENT_ES_SIZE - pos;
+		if (len > size - i) {
+			len = size - i;
+		}
+		if (memcmp(&g_pull[i], &g_es[pos], len) != 0) {
+			return false;
+		}
+		pos = 0;
+	}
+	return true;
+}
+
+/****************************************************************************
+ * tsdemux_perf_main
+ ****************************************************************************/
+
+extern "C" {
+#ifdef CONFIG_BUILD_KERNEL
+int main(int argc, FAR char *argv[])
+#else
+int tsdemux_perf_main(int argc, char *argv[])
+#endif
+{
+	struct timespec start;
+	struct timespec end;
+	size_t pushed = 0;
+	size_t pulled = 0;
+	size_t offset = 0;
+	size_t mismatch = 0;
+	size_t size;
+	size_t total = (size_t)PERF_SEGMENTS * SEGMENT_SIZE;
+	long long usec;
+	ssize_t ret;
+	bool prepared = false;
+
+	make_segment();
+
+	auto demuxer = Demuxer::create(AUDIO_TYPE_MP2T);
+	if (!demuxer) {
+		printf("Create demuxer failed\n");
+		return ERROR;
+	}
+
+#ifdef CONFIG_CONTAINER_MPEG2TS_IN_PLACE
+	printf("MPEG-2 TS demuxer, in place\n");
+#else
+	printf("MPEG-2 TS demuxer, with PES packets\n");
+#endif
+
+	clock_gettime(CLOCK_REALTIME, &start);
+
+	while (pushed < total) {
+		/* Push no more than the space left, or it waits for it */
+		size = SEGMENT_SIZE - offset;
+		if (size > demuxer->getAvailSpace()) {
+			size = demuxer->getAvailSpace();
+		}
+		ret = demuxer->pushData(&g_segment[offset], size);
+		if (ret < 0) {
+			printf("Push data failed, error %d\n", (int)ret);
+			return ERROR;
+		}
+		pushed += ret;
+		offset = (offset + ret) % SEGMENT_SIZE;
+
+		if (!prepared) {
+			ret = demuxer->prepare();
+			if (ret == DEMUXER_ERROR_WANT_DATA) {
+				continue;
+			}
+			if (ret != DEMUXER_ERROR_NONE) {
+				printf("Prepare failed, error %d\n", (int)ret);
+				return ERROR;
+			}
+			prepared = true;
+		}
+
+		/* Pull until the demuxer wants more data, so there's space to push */
+		while ((ret = demuxer->pullData(g_pull, sizeof(g_pull))) > 0) {
+			if (!check_es(pulled, ret)) {
+				mismatch++;
+			}
+			pulled += ret;
+		}
+		if (ret != DEMUXER_ERROR_WANT_DATA) {
+			printf("Pull data failed, error %d\n", (int)ret);
+			return ERROR;
+		}
+	}
+
+	clock_gettime(CLOCK_REALTIME, &end);
+	usec = perf_elapsed_usec(&start, &end);
+	if (usec == 0) {
+		usec = 1;
+	}
+
+	printf("TS %u bytes, ES %u bytes, %8lld usec, %u.%02u Mbit/s\n", (unsigned int)pushed, (unsigned int)pulled, usec,
+		   (unsigned int)(pushed * 8LL / usec), (unsigned int)(pushed * 800LL / usec % 100));
+
+	/* The last PES packets may still be in the demuxer */
+	if (mismatch != 0 || pulled + SEGMENT_ES_SIZE < (size_t)PERF_SEGMENTS * SEGMENT_ES_SIZE) {
+		printf("ES data is wrong, %u pulls mismatch\n", (unsigned int)mismatch);
+		return ERROR;
+	}
+	printf("ES data OK\n");
+
+	return OK;
+}
+}
@@ -0,0 +1,205 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+#include <stdint.h>
+#include <string.h>
+#include <media/audio_dsp.h>
+#include "remix.h"
+#include "tc_common.h"
+
+/* Not a multiple of any vector width, so the scalar tails run too */
+#define AUDIODSP_FRAMES     251
+#define AUDIODSP_SAMPLES    (AUDIODSP_FRAMES * AUDIO_DSP_MAX_CH)
+
+static int16_t g_s16[AUDIODSP_SAMPLES];
+static int32_t g_s32[AUDIODSP_SAMPLES];
+static float g_float[AUDIODSP_SAMPLES];
+static int16_t g_ref[AUDIODSP_SAMPLES];
+static int16_t g_out[AUDIODSP_SAMPLES];
+static int32_t g_ref32[AUDIODSP_SAMPLES];
+static int32_t g_out32[AUDIODSP_SAMPLES];
+static float g_reff[AUDIODSP_SAMPLES];
+static float g_outf[AUDIODSP_SAMPLES];
+static int16_t g_planar[AUDIO_DSP_MAX_CH][AUDIODSP_FRAMES];
+
+static void fill_input(void)
+{
+	uint32_t seed = 1;
+	int i;
+
+	/* Full scale values, and floats beyond it, exercise the saturation */
+
+	for (i = 0; i < AUDIODSP_SAMPLES; i++) {
+		seed = seed * 1103515245 + 12345;
+		g_s16[i] = (int16_t)(seed >> 16);
+		g_s32[i] = (int32_t)seed;
+		g_float[i] = (float)g_s16[i] / 27000.0f;
+	}
+}
+
+/* Compare all kernels of ops with the scalar ones */
+static int compare_kernels(const struct audio_dsp_ops_s *ops)
+{
+	const struct audio_dsp_ops_s *ref = audio_dsp_get_ops(AUDIO_DSP_KERNEL_SCALAR);
+	int16_t *planar[AUDIO_DSP_MAX_CH];
+	int16_t matrix[AUDIO_DSP_MAX_CH * AUDIO_DSP_MAX_CH];
+	uint32_t in_ch, out_ch;
+	uint32_t i;
+
+	for (i = 0; i < AUDIO_DSP_MAX_CH; i++) {
+		planar[i] = g_planar[i];
+	}
+
+	for (in_ch = 1; in_ch <= AUDIO_DSP_MAX_CH; in_ch++) {
+		for (out_ch = 1; out_ch <= AUDIO_DSP_MAX_CH; out_ch++) {
+			/* Rows sum to less than 4.0 */
+			for (i = 0; i < in_ch * out_ch; i++) {
+				matrix[i] = g_s16[i] / (int16_t)(4 * in_ch);
+			}
+			ref->remix_s16(g_s16, in_ch, g_ref, out_ch, matrix, AUDIODSP_FRAMES);
+			ops->remix_s16(g_s16, in_ch, g_out, out_ch, matrix, AUDIODSP_FRAMES);
+			if (memcmp(g_ref, g_out, AUDIODSP_FRAMES * out_ch * sizeof(int16_t)) != 0) {
+				return ERROR;
+			}
+
+			if (out_ch <= in_ch) {
+				memcpy(g_out, g_s16, AUDIODSP_FRAMES * in_ch * sizeof(int16_t));
+				ops->remix_s16(g_out, in_ch, g_out, out_ch, matrix, AUDIODSP_FRAMES);
+				if (memcmp(g_ref, g_out, AUDIODSP_FRAMES * out_ch * sizeof(int16_t)) != 0) {
+					return ERROR;
+				}
+			}
+		}
+
+		ops->deinterleave_s16(g_s16, in_ch, planar, AUDIODSP_FRAMES);
+		ops->interleave_s16((const int16_t *const *)planar, in_ch, g_out, AUDIODSP_FRAMES);
+		if (memcmp(g_s16, g_out, AUDIODSP_FRAMES * in_ch * sizeof(int16_t)) != 0) {
+			return ERROR;
+		}
+	}
+
+	ref->gain_s16(g_s16, g_ref, AUDIODSP_SAMPLES, AUDIO_DSP_GAIN_ONE * 3 / 2);
+	ops->gain_s16(g_s16, g_out, AUDIODSP_SAMPLES, AUDIO_DSP_GAIN_ONE * 3 / 2);
+	if (memcmp(g_ref, g_out, sizeof(g_out)) != 0) {
+		return ERROR;
+	}
+
+	ref->s16_to_s32(g_s16, g_ref32, AUDIODSP_SAMPLES);
+	ops->s16_to_s32(g_s16, g_out32, AUDIODSP_SAMPLES);
+	if (memcmp(g_ref32, g_out32, sizeof(g_out32)) != 0) {
+		return ERROR;
+	}
+
+	ref->s32_to_s16(g_s32, g_ref, AUDIODSP_SAMPLES);
+	ops->s32_to_s16(g_s32, g_out, AUDIODSP_SAMPLES);
+	if (memcmp(g_ref, g_out, sizeof(g_out)) != 0) {
+		return ERROR;
+	}
+
+	ref->s16_to_float(g_s16, g_reff, AUDIODSP_SAMPLES);
+	ops->s16_to_float(g_s16, g_outf, AUDIODSP_SAMPLES);
+	if (memcmp(g_reff, g_outf, sizeof(g_outf)) != 0) {
+		return ERROR;
+	}
+
+	ref->float_to_s16(g_float, g_ref, AUDIODSP_SAMPLES);
+	ops->float_to_s16(g_float, g_out, AUDIODSP_SAMPLES);
+	if (memcmp(g_ref, g_out, sizeof(g_out)) != 0) {
+		return ERROR;
+	}
+
+	return OK;
+}
+
+static void utc_media_audiodsp_bitexact_p(void)
+{
+	int kernel;
+
+	TC_ASSERT_NEQ("audio_dsp_get_ops", audio_dsp_get_ops(AUDIO_DSP_KERNEL_AUTO), NULL);
+	TC_ASSERT_NEQ("audio_dsp_get_ops", audio_dsp_get_ops(AUDIO_DSP_KERNEL_SCALAR), NULL);
+
+	/* Kernels which are not built in are skipped */
+
+	for (kernel = AUDIO_DSP_KERNEL_AUTO; kernel <= AUDIO_DSP_KERNEL_NEON; kernel++) {
+		if (kernel == AUDIO_DSP_KERNEL_SCALAR || audio_dsp_get_ops(kernel) == NULL) {
+			continue;
+		}
+		TC_ASSERT_EQ("audio_dsp_ops_s", compare_kernels(audio_dsp_get_ops(kernel)), OK);
+	}
+
+	TC_ASSERT_EQ("audio_dsp_get_ops", audio_dsp_get_ops(AUDIO_DSP_KERNEL_NEON + 1), NULL);
+	TC_SUCCESS_RESULT();
+}
+
+static void utc_media_audiodsp_values_p(void)
+{
+	static const int16_t s16[4] = { 1000, -1000, INT16_MAX, INT16_MIN };
+	static const float f[4] = { 1.0f, -1.0f, 0.5f / 32768, -0.5f / 32768 };
+	int16_t out[4];
+
+	audio_dsp_gain_s16(s16, out, 4, AUDIO_DSP_GAIN_ONE * 2);
+	TC_ASSERT_EQ("audio_dsp_gain_s16", out[0], 2000);
+	TC_ASSERT_EQ("audio_dsp_gain_s16", out[1], -2000);
+	TC_ASSERT_EQ("audio_dsp_gain_s16", out[2], INT16_MAX);
+	TC_ASSERT_EQ("audio_dsp_gain_s16", out[3], INT16_MIN);
+
+	audio_dsp_float_to_s16(f, out, 4);
+	TC_ASSERT_EQ("audio_dsp_float_to_s16", out[0], INT16_MAX);
+	TC_ASSERT_EQ("audio_dsp_float_to_s16", out[1], INT16_MIN);
+	TC_ASSERT_EQ("audio_dsp_float_to_s16", out[2], 1);
+	TC_ASSERT_EQ("audio_dsp_float_to_s16", out[3], -1);
+
+	TC_SUCCESS_RESULT();
+}
+
+static void utc_media_rechannel_p(void)
+{
+	/* FL FR FC LFE BL BR */
+	int16_t frames[2 * 6] = { 1000, 2000, 1000, 5000, 1000, 3000, INT16_MAX, INT16_MAX, INT16_MAX, 0, INT16_MAX, INT16_MAX };
+	int16_t mono[4] = { 100, -201, 7, 8 };
+
+	/* Both back channels are mixed in with the center at -3dB */
+	TC_ASSERT_EQ("rechannel", rechannel(ch2layout(6), ch2layout(2), frames, 2, frames, 2), 2);
+	TC_ASSERT_EQ("rechannel", frames[0], 2414);
+	TC_ASSERT_EQ("rechannel", frames[1], 4828);
+	TC_ASSERT_EQ("rechannel", frames[2], INT16_MAX);
+	TC_ASSERT_EQ("rechannel", frames[3], INT16_MAX);
+
+	TC_ASSERT_EQ("rechannel", rechannel(ch2layout(2), ch2layout(1), mono, 2, mono, 2), 2);
+	TC_ASSERT_EQ("rechannel", mono[0], -50);
+	TC_ASSERT_EQ("rechannel", mono[1], 8);
+
+	TC_ASSERT_EQ("rechannel", rechannel(ch2layout(1), ch2layout(2), mono, 2, mono, 2), 2);
+	TC_ASSERT_EQ("rechannel", mono[0], -50);
+	TC_ASSERT_EQ("rechannel", mono[1], -50);
+	TC_ASSERT_EQ("rechannel", mono[2], 8);
+	TC_ASSERT_EQ("rechannel", mono[3], 8);
+
+	TC_SUCCESS_RESULT();
+}
+
+int utc_media_audiodsp_main(void)
+{
+	fill_input();
+
+	utc_media_audiodsp_bitexact_p();
+	utc_media_audiodsp_values_p();
+	utc_media_rechannel_p();
+	return 0;
+}
@@ -55,6 +55,12 @@ int utc_media_bufferoutputdatasource_main(void);
 #ifdef CONFIG_MEDIA_VOICE_SPEECH_DETECTOR
 int utc_media_SpeechDetector_main(void);
 #endif
+#ifdef CONFIG_AUDIO_RESAMPLER_POLYPHASE
+extern "C" int utc_media_resampler_main(void);
+#endif
+extern "C" int utc_media_audiodsp_main(void);
+extern "C" int utc_media_ringbuffer_main(void);
+int utc_media_streambuffer_main(void);
 #endif
 
 extern "C"
@@ -91,6 +97,12 @@ int utc_media_main(int argc, char *argv[])
 #ifdef CONFIG_MEDIA_VOICE_SPEECH_DETECTOR
 	utc_media_SpeechDetector_main();
 #endif
+#ifdef CONFIG_AUDIO_RESAMPLER_POLYPHASE
+	utc_media_resampler_main();
+#endif
+	utc_media_audiodsp_main();
+	utc_media_ringbuffer_main();
+	utc_media_streambuffer_main();
 #endif
 
 	(void)testcase_state_handler(TC_END, "Media UTC");
@@ -16,6 +16,7 @@
  *
  ****************************************************************************/
 
+#include <tinyara/config.h>
 #include <memory>
 #include <string.h>
 #include <media/MediaPlayer.h>
@@ -641,6 +642,50 @@ static void utc_media_MediaPlayer_isPlaying_n(void)
 	TC_SUCCESS_RESULT();
 }
 
+static void utc_media_MediaPlayer_getPipelineStats_p(void)
+{
+	media::player_pipeline_stats_t stats;
+	media::MediaPlayer mp;
+	std::unique_ptr<media::stream::FileInputDataSource> source = std::move(std::unique_ptr<media::stream::FileInputDataSource>(new media::stream::FileInputDataSource(dummyfilepath)));
+	mp.create();
+	mp.setDataSource(std::move(source));
+	mp.prepare();
+
+#ifdef CONFIG_MEDIA_PLAYER_DECODE_AHEAD
+	TC_ASSERT_EQ_CLEANUP("utc_media_MediaPlayer_getPipelineStats", mp.getPipelineStats(&stats), media::PLAYER_OK, goto cleanup);
+	TC_ASSERT_EQ_CLEANUP("utc_media_MediaPlayer_getPipelineStats", stats.buffers, CONFIG_MEDIA_PLAYER_DECODE_AHEAD_BUFFERS, goto cleanup);
+	TC_ASSERT_LEQ_CLEANUP("utc_media_MediaPlayer_getPipelineStats", stats.decoded, stats.buffers, goto cleanup);
+	TC_ASSERT_EQ_CLEANUP("utc_media_MediaPlayer_getPipelineStats", stats.underruns, 0, goto cleanup);
+#else
+	TC_ASSERT_EQ_CLEANUP("utc_media_MediaPlayer_getPipelineStats", mp.getPipelineStats(&stats), media::PLAYER_ERROR_INVALID_OPERATION, goto cleanup);
+#endif
+
+	TC_SUCCESS_RESULT();
+cleanup:
+	mp.unprepare();
+	mp.destroy();
+}
+
+static void utc_media_MediaPlayer_getPipelineStats_n(void)
+{
+	/* getPipelineStats without create */
+	{
+		media::player_pipeline_stats_t stats;
+		media::MediaPlayer mp;
+		TC_ASSERT_EQ("utc_media_MediaPlayer_getPipelineStats", mp.getPipelineStats(&stats), media::PLAYER_ERROR_NOT_ALIVE);
+	}
+
+	/* getPipelineStats with nullptr */
+	{
+		media::MediaPlayer mp;
+		mp.create();
+		TC_ASSERT_EQ_CLEANUP("utc_media_MediaPlayer_getPipelineStats", mp.getPipelineStats(nullptr), media::PLAYER_ERROR_INVALID_PARAMETER, mp.destroy());
+		mp.destroy();
+	}
+
+	TC_SUCCESS_RESULT();
+}
+
 static void utc_media_MediaPlayer_operator_equal_p(void)
 {
 	media::MediaPlayer mp;
@@ -705,6 +750,9 @@ int utc_media_MediaPlayer_main(void)
 	utc_media_MediaPlayer_isPlaying_p();
 	utc_media_MediaPlayer_isPlaying_n();
 
+	utc_media_MediaPlayer_getPipelineStats_p();
+	utc_media_MediaPlayer_getPipelineStats_n();
+
 	utc_media_MediaPlayer_operator_equal_p();
 	utc_media_MediaPlayer_operator_equal_n();
 
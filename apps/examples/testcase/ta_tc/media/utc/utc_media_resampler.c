@@ -0,0 +1,149 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <media/samplerate.h>
+#include "tc_common.h"
+
+#define RESAMPLER_IN_FRAMES     256
+#define RESAMPLER_OUT_FRAMES    1024
+#define RESAMPLER_CHANNELS      2
+#define RESAMPLER_LOOPS         16
+
+static int16_t g_input[RESAMPLER_IN_FRAMES * RESAMPLER_CHANNELS];
+static int16_t g_ref_output[RESAMPLER_LOOPS][RESAMPLER_OUT_FRAMES * RESAMPLER_CHANNELS];
+static int16_t g_output[RESAMPLER_OUT_FRAMES * RESAMPLER_CHANNELS];
+static int g_ref_frames[RESAMPLER_LOOPS];
+
+static void fill_input(void)
+{
+	uint32_t seed = 1;
+	int i;
+
+	/* Full scale noise exercises the saturation of the output */
+
+	for (i = 0; i < RESAMPLER_IN_FRAMES * RESAMPLER_CHANNELS; i++) {
+		seed = seed * 1103515245 + 12345;
+		g_input[i] = (int16_t)(seed >> 16);
+	}
+}
+
+static bool kernel_supported(int kernel)
+{
+	src_handle_t handle = src_init(CONFIG_AUDIO_RESAMPLER_BUFSIZE);
+	bool supported;
+
+	supported = handle != NULL && src_set_kernel(handle, kernel) == SRC_ERR_NO_ERROR;
+	src_destroy(handle);
+	return supported;
+}
+
+/* Resample RESAMPLER_LOOPS buffers with the given kernel. With reference
+ * set, the output is saved, otherwise it is compared with the saved one.
+ */
+static int resample_with_kernel(int in_rate, int out_rate, int kernel, bool reference)
+{
+	src_handle_t handle;
+	src_data_t data;
+	int ret = OK;
+	int i;
+
+	handle = src_init(CONFIG_AUDIO_RESAMPLER_BUFSIZE);
+	if (handle == NULL) {
+		return ERROR;
+	}
+
+	if (src_set_kernel(handle, kernel) != SRC_ERR_NO_ERROR) {
+		src_destroy(handle);
+		return ERROR;
+	}
+
+	for (i = 0; i < RESAMPLER_LOOPS && ret == OK; i++) {
+		memset(&data, 0, sizeof(data));
+		data.data_in = g_input;
+		data.input_frames = RESAMPLER_IN_FRAMES;
+		data.origin_sample_rate = in_rate;
+		data.origin_sample_width = SAMPLE_WIDTH_16BITS;
+		data.origin_channel_num = RESAMPLER_CHANNELS;
+		data.desired_sample_rate = out_rate;
+		data.desired_sample_width = SAMPLE_WIDTH_16BITS;
+		data.desired_channel_num = RESAMPLER_CHANNELS;
+		data.data_out = reference ? g_ref_output[i] : g_output;
+		data.out_buf_length = sizeof(g_output);
+
+		if (src_simple(handle, &data) != SRC_ERR_NO_ERROR) {
+			ret = ERROR;
+		} else if (reference) {
+			g_ref_frames[i] = data.output_frames_gen;
+		} else if (data.output_frames_gen != g_ref_frames[i] ||
+				   memcmp(g_output, g_ref_output[i], data.output_frames_gen * RESAMPLER_CHANNELS * sizeof(int16_t)) != 0) {
+			ret = ERROR;
+		}
+	}
+
+	src_destroy(handle);
+	return ret;
+}
+
+static void utc_media_resampler_bitexact(int in_rate, int out_rate)
+{
+	int kernel;
+	int ret;
+
+	ret = resample_with_kernel(in_rate, out_rate, SRC_KERNEL_SCALAR, true);
+	TC_ASSERT_EQ("src_simple", ret, OK);
+
+	/* Kernels which are not built in are skipped */
+
+	for (kernel = SRC_KERNEL_AUTO; kernel <= SRC_KERNEL_NEON; kernel++) {
+		if (kernel == SRC_KERNEL_SCALAR || !kernel_supported(kernel)) {
+			continue;
+		}
+
+		ret = resample_with_kernel(in_rate, out_rate, kernel, false);
+		TC_ASSERT_EQ("src_simple", ret, OK);
+	}
+
+	TC_SUCCESS_RESULT();
+}
+
+static void utc_media_resampler_set_kernel_n(void)
+{
+	src_handle_t handle = src_init(CONFIG_AUDIO_RESAMPLER_BUFSIZE);
+	TC_ASSERT_NEQ("src_init", handle, NULL);
+
+	TC_ASSERT_EQ_CLEANUP("src_set_kernel", src_set_kernel(handle, SRC_KERNEL_NEON + 1), SRC_ERR_NOT_SUPPORT, src_destroy(handle));
+	TC_ASSERT_EQ_CLEANUP("src_set_kernel", src_set_kernel(NULL, SRC_KERNEL_SCALAR), SRC_ERR_BAD_PARAMS, src_destroy(handle));
+
+	src_destroy(handle);
+	TC_SUCCESS_RESULT();
+}
+
+int utc_media_resampler_main(void)
+{
+	fill_input();
+
+	utc_media_resampler_bitexact(44100, 48000);
+	utc_media_resampler_bitexact(48000, 16000);
+	utc_media_resampler_set_kernel_n();
+	return 0;
+}
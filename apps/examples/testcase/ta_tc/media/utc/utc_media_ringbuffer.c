@@ -0,0 +1,89 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+#include <stdint.h>
+#include <string.h>
+#include "rb.h"
+#include "tc_common.h"
+
+#define RINGBUFFER_DEPTH 10
+
+static void utc_media_rb_reserve_commit_p(void)
+{
+	rb_t rb;
+	void *ptr;
+
+	TC_ASSERT("rb_init", rb_init(&rb, RINGBUFFER_DEPTH));
+
+	TC_ASSERT_EQ_CLEANUP("rb_reserve", rb_reserve(&rb, &ptr), RINGBUFFER_DEPTH, rb_free(&rb));
+	TC_ASSERT_EQ_CLEANUP("rb_reserve", ptr, rb.buf, rb_free(&rb));
+	memcpy(ptr, "abcdefg", 7);
+	TC_ASSERT_EQ_CLEANUP("rb_commit", rb_commit(&rb, 7), 7, rb_free(&rb));
+	TC_ASSERT_EQ_CLEANUP("rb_commit", rb_used(&rb), 7, rb_free(&rb));
+	TC_ASSERT_EQ_CLEANUP("rb_read", rb_read(&rb, NULL, 5), 5, rb_free(&rb));
+
+	/* Free space wraps around: only the tail is contiguous */
+	TC_ASSERT_EQ_CLEANUP("rb_reserve", rb_reserve(&rb, &ptr), 3, rb_free(&rb));
+	memcpy(ptr, "hij", 3);
+	TC_ASSERT_EQ_CLEANUP("rb_commit", rb_commit(&rb, 3), 3, rb_free(&rb));
+	TC_ASSERT_EQ_CLEANUP("rb_reserve", rb_reserve(&rb, &ptr), 5, rb_free(&rb));
+	TC_ASSERT_EQ_CLEANUP("rb_reserve", ptr, rb.buf, rb_free(&rb));
+	memcpy(ptr, "klmno", 5);
+
+	/* Commit never goes beyond the free space */
+	TC_ASSERT_EQ_CLEANUP("rb_commit", rb_commit(&rb, 6), 5, rb_free(&rb));
+	TC_ASSERT_EQ_CLEANUP("rb_reserve", rb_reserve(&rb, &ptr), 0, rb_free(&rb));
+
+	rb_free(&rb);
+	TC_SUCCESS_RESULT();
+}
+
+static void utc_media_rb_peek_p(void)
+{
+	rb_t rb;
+	void *ptr;
+	uint8_t data[RINGBUFFER_DEPTH];
+
+	TC_ASSERT("rb_init", rb_init(&rb, RINGBUFFER_DEPTH));
+
+	TC_ASSERT_EQ_CLEANUP("rb_peek", rb_peek(&rb, &ptr), 0, rb_free(&rb));
+	TC_ASSERT_EQ_CLEANUP("rb_write", rb_write(&rb, "abcdefgh", 8), 8, rb_free(&rb));
+	TC_ASSERT_EQ_CLEANUP("rb_read", rb_read(&rb, data, 5), 5, rb_free(&rb));
+	TC_ASSERT_EQ_CLEANUP("rb_write", rb_write(&rb, "ijklm", 5), 5, rb_free(&rb));
+
+	/* Data wraps around: only the tail is contiguous */
+	TC_ASSERT_EQ_CLEANUP("rb_peek", rb_peek(&rb, &ptr), 5, rb_free(&rb));
+	TC_ASSERT_EQ_CLEANUP("rb_peek", memcmp(ptr, "fghij", 5), 0, rb_free(&rb));
+	TC_ASSERT_EQ_CLEANUP("rb_read", rb_read(&rb, NULL, 5), 5, rb_free(&rb));
+	TC_ASSERT_EQ_CLEANUP("rb_peek", rb_peek(&rb, &ptr), 3, rb_free(&rb));
+	TC_ASSERT_EQ_CLEANUP("rb_peek", ptr, rb.buf, rb_free(&rb));
+	TC_ASSERT_EQ_CLEANUP("rb_peek", memcmp(ptr, "klm", 3), 0, rb_free(&rb));
+	TC_ASSERT_EQ_CLEANUP("rb_read", rb_read(&rb, NULL, 3), 3, rb_free(&rb));
+	TC_ASSERT_EQ_CLEANUP("rb_peek", rb_peek(&rb, &ptr), 0, rb_free(&rb));
+
+	rb_free(&rb);
+	TC_SUCCESS_RESULT();
+}
+
+int utc_media_ringbuffer_main(void)
+{
+	utc_media_rb_reserve_commit_p();
+	utc_media_rb_peek_p();
+	return 0;
+}
@@ -0,0 +1,119 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+#include <thread>
+#include "StreamBuffer.h"
+#include "tc_common.h"
+
+using namespace std;
+using namespace media;
+using namespace media::stream;
+
+#define STREAMBUFFER_SIZE 64
+#define STREAMBUFFER_TOTAL 4096
+#define STREAMBUFFER_CHUNK 24
+
+static void streambuffer_produce(shared_ptr<StreamBuffer> stream)
+{
+	unsigned char chunk[STREAMBUFFER_CHUNK];
+	size_t written = 0;
+
+	while (written < STREAMBUFFER_TOTAL) {
+		size_t size = STREAMBUFFER_TOTAL - written;
+		if (size > STREAMBUFFER_CHUNK) {
+			size = STREAMBUFFER_CHUNK;
+		}
+		if (stream->sizeOfSpace() < size) {
+			auto lock = stream->getLock();
+			stream->waitForSpace(lock, size);
+			continue;
+		}
+		for (size_t i = 0; i < size; i++) {
+			chunk[i] = (unsigned char)(written + i);
+		}
+		written += stream->write(chunk, size);
+		stream->wakeUp();
+	}
+
+	stream->setEndOfStream();
+	stream->wakeUp();
+}
+
+static void utc_media_StreamBuffer_lockFree_p(void)
+{
+	auto stream = StreamBuffer::Builder().setBufferSize(STREAMBUFFER_SIZE).setThreshold(1).setLockFree(true).build();
+	TC_ASSERT_NEQ("utc_media_StreamBuffer_lockFree", stream, nullptr);
+	TC_ASSERT("utc_media_StreamBuffer_lockFree", stream->isLockFree());
+
+	/* Reads in other sizes than the writes, so both sides wait in turn */
+	thread producer(streambuffer_produce, stream);
+	unsigned char chunk[STREAMBUFFER_CHUNK / 2 + 1];
+	size_t total = 0;
+	size_t mismatch = 0;
+	while (true) {
+		if (stream->sizeOfData() == 0) {
+			if (stream->isEndOfStream() && stream->sizeOfData() == 0) {
+				break;
+			}
+			auto lock = stream->getLock();
+			stream->waitForData(lock);
+			continue;
+		}
+		size_t size = stream->read(chunk, sizeof(chunk));
+		stream->wakeUp();
+		for (size_t i = 0; i < size; i++) {
+			if (chunk[i] != (unsigned char)(total + i)) {
+				mismatch++;
+			}
+		}
+		total += size;
+	}
+	producer.join();
+
+	TC_ASSERT_EQ("utc_media_StreamBuffer_lockFree", total, STREAMBUFFER_TOTAL);
+	TC_ASSERT_EQ("utc_media_StreamBuffer_lockFree", mismatch, 0);
+	TC_SUCCESS_RESULT();
+}
+
+static void utc_media_StreamBuffer_lockFree_endOfStream_p(void)
+{
+	auto stream = StreamBuffer::Builder().setBufferSize(STREAMBUFFER_SIZE).setThreshold(1).setLockFree(true).build();
+	TC_ASSERT_NEQ("utc_media_StreamBuffer_lockFree_endOfStream", stream, nullptr);
+
+	/* The end of stream wakes a reader waiting on an empty buffer */
+	thread producer([stream] {
+		stream->setEndOfStream();
+		stream->wakeUp();
+	});
+	while (!stream->isEndOfStream()) {
+		auto lock = stream->getLock();
+		stream->waitForData(lock);
+	}
+	producer.join();
+
+	TC_ASSERT_EQ("utc_media_StreamBuffer_lockFree_endOfStream", stream->sizeOfData(), 0);
+	TC_SUCCESS_RESULT();
+}
+
+int utc_media_streambuffer_main(void)
+{
+	utc_media_StreamBuffer_lockFree_p();
+	utc_media_StreamBuffer_lockFree_endOfStream_p();
+	return 0;
+}
@@ -15,6 +15,7 @@
  * language governing permissions and limitations under the License.
  *
  ****************************************************************************/
+#include <tinyara/config.h>
 #include <stdio.h>
 #include <string.h>
 #include <stdbool.h>
@@ -36,6 +37,11 @@
 
 #define TC_REPLY_MSG "reply_msg"
 
+#ifdef CONFIG_MESSAGING_SHARED_PAYLOAD
+#define TC_SHARED_PORT "shared_port"
+#define TC_SHARED_MSGLEN (CONFIG_MESSAGING_SHARED_THRESHOLD * 2)
+#endif
+
 #define TC_OK   0
 #define TC_FAIL 1
 
@@ -44,6 +50,9 @@ static bool tc_block_chk = TC_OK;
 static bool tc_nonblock_chk = TC_OK;
 static bool tc_reply_chk = TC_OK;
 static bool tc_cleanup_chk = false;
+#ifdef CONFIG_MESSAGING_SHARED_PAYLOAD
+static bool tc_shared_chk = TC_OK;
+#endif
 
 static void utc_messaging_recv_block_n(void)
 {
@@ -149,6 +158,84 @@ static void utc_messaging_recv_block_p(void)
 	TC_SUCCESS_RESULT();
 }
 
+#ifdef CONFIG_MESSAGING_SHARED_PAYLOAD
+static void shared_sender(int argc, FAR char *argv[])
+{
+	int ret;
+	msg_send_data_t data;
+
+	data.msglen = TC_SHARED_MSGLEN;
+	data.priority = 100;
+	data.msg = (char *)malloc(data.msglen);
+	if (data.msg == NULL) {
+		tc_shared_chk = TC_FAIL;
+		(void)sem_post(&recv_sem);
+		return;
+	}
+
+	memset(data.msg, 'a', data.msglen);
+
+	ret = messaging_send(TC_SHARED_PORT, &data);
+	if (ret != OK) {
+		tc_shared_chk = TC_FAIL;
+		(void)sem_post(&recv_sem);
+	}
+
+	free((void *)data.msg);
+}
+
+static void shared_receiver(int argc, FAR char *argv[])
+{
+	int ret;
+	msg_recv_buf_t recv_buf;
+
+	ret = sem_wait(&recv_sem);
+	if (ret != OK) {
+		tc_shared_chk = TC_FAIL;
+		return;
+	}
+
+	/* The message is passed by reference, and does not fit into this buffer. */
+	recv_buf.buflen = TC_SHARED_MSGLEN / 2;
+	recv_buf.buf = (char *)malloc(recv_buf.buflen);
+	if (recv_buf.buf == NULL) {
+		tc_shared_chk = TC_FAIL;
+		(void)sem_post(&recv_sem);
+		return;
+	}
+
+	ret = messaging_recv_block(TC_SHARED_PORT, &recv_buf);
+	if (ret != ERROR) {
+		tc_shared_chk = TC_FAIL;
+	}
+
+	free(recv_buf.buf);
+
+	(void)sem_post(&recv_sem);
+}
+
+static void utc_messaging_recv_block_shared_n(void)
+{
+	int ret;
+
+	tc_shared_chk = TC_OK;
+	sem_init(&recv_sem, 0, 1);
+
+	ret = task_create("shared_receiver", TASK_PRIO, STACKSIZE, (main_t)shared_receiver, (FAR char * const *)NULL);
+	TC_ASSERT_GEQ("messaging_recv_block", ret, 0);
+
+	ret = task_create("shared_sender", TASK_PRIO, STACKSIZE, (main_t)shared_sender, (FAR char * const *)NULL);
+	TC_ASSERT_GEQ("messaging_recv_block", ret, 0);
+
+	ret = sem_wait(&recv_sem);
+	TC_ASSERT_EQ_CLEANUP("messaging_recv_block", tc_shared_chk, TC_OK, sem_destroy(&recv_sem));
+	TC_ASSERT_EQ_CLEANUP("messaging_recv_block", ret, OK, sem_destroy(&recv_sem));
+
+	sem_destroy(&recv_sem);
+	TC_SUCCESS_RESULT();
+}
+#endif
+
 static void nonblock_callback(msg_reply_type_t msg_type, msg_recv_buf_t *recv_data, void *cb_data)
 {
 	int ret;
@@ -349,6 +436,9 @@ void utc_messaging_recv_reply_and_cleanup_main(void)
 {
 	utc_messaging_recv_block_n();
 	utc_messaging_recv_block_p();
+#ifdef CONFIG_MESSAGING_SHARED_PAYLOAD
+	utc_messaging_recv_block_shared_n();
+#endif
 
 	utc_messaging_recv_nonblock_n();
 	utc_messaging_recv_nonblock_p();
@@ -62,6 +62,11 @@
 #define CPULOAD_BUFLEN 128
 #define CPULOADMON_RUNNING_FOREVER -1
 
+#ifdef CONFIG_SCHED_PROFILER
+/* Number of samples fetched from the driver at once */
+#define CPULOAD_PROF_READSIZE 8
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -344,11 +349,104 @@ errout_with_free:
 	return ERROR;
 }
 
+#ifdef CONFIG_SCHED_PROFILER
+static void cpuload_print_pid_name(char *buf, void *arg)
+{
+	int i;
+	stat_data stat_info[PROC_STAT_MAX];
+
+	stat_info[0] = buf;
+
+	for (i = 0; i < PROC_STAT_MAX - 1; i++) {
+		stat_info[i] = strtok_r(stat_info[i], " ", &stat_info[i + 1]);
+	}
+
+#if (CONFIG_TASK_NAME_SIZE > 0)
+	printf("@PFN:%s %s\n", stat_info[PROC_STAT_PID], stat_info[PROC_STAT_NAME]);
+#endif
+}
+
+static int cpuload_read_name(FAR struct dirent *entryp, FAR void *arg)
+{
+	char *filepath;
+	char buf[CPULOAD_BUFLEN];
+
+	asprintf(&filepath, "%s/%s/%s", PROCFS_MOUNT_POINT, entryp->d_name, "stat");
+	(void)utils_readfile(filepath, buf, CPULOAD_BUFLEN, cpuload_print_pid_name, NULL);
+	free(filepath);
+	return OK;
+}
+
+/* Run a profiling session of seconds in the foreground and print the
+ * samples as "@PF:" lines for os/tools/profile_report.py.
+ */
+
+static int cpuload_profile(int seconds, int period)
+{
+	int fd;
+	int ret;
+	int i;
+	int j;
+	uint32_t total = 0;
+	struct cpuload_profile_s cfg;
+	struct cpuload_profread_s req;
+	struct cpuload_sample_s samples[CPULOAD_PROF_READSIZE];
+
+	fd = open(CPULOAD_DRVPATH, O_RDWR);
+	if (fd < 0) {
+		printf("Fail to open cpuload driver. errno %d\n", errno);
+		return ERROR;
+	}
+
+	cfg.nsamples = (seconds * CLOCKS_PER_SEC + period - 1) / period;
+	cfg.period = period;
+	ret = ioctl(fd, CPULOADIOC_PROFSTART, (unsigned long)&cfg);
+	if (ret < 0) {
+		printf("Fail to start profiling. errno %d\n", errno);
+		close(fd);
+		return ERROR;
+	}
+
+	printf("Profiling for %ds, a sample every %d tick(s)...\n", seconds, period);
+	sleep(seconds);
+	(void)ioctl(fd, CPULOADIOC_PROFSTOP, 0);
+
+	printf("@PFI:%d %d %d\n", CLOCKS_PER_SEC, period, CPULOAD_PROFILE_DEPTH);
+	utils_proc_pid_foreach(cpuload_read_name, NULL);
+
+	req.pos = 0;
+	req.dropped = 0;
+	req.samples = samples;
+	req.nsamples = CPULOAD_PROF_READSIZE;
+	while ((ret = ioctl(fd, CPULOADIOC_PROFREAD, (unsigned long)&req)) > 0) {
+		for (i = 0; i < ret; i++) {
+			printf("@PF:%d", samples[i].pid);
+			for (j = 0; j < samples[i].depth; j++) {
+				printf(" %08x", (unsigned int)samples[i].pc[j]);
+			}
+			printf("\n");
+		}
+		total += ret;
+	}
+	printf("@PFE:%u %u\n", (unsigned int)total, (unsigned int)req.dropped);
+
+	(void)ioctl(fd, CPULOADIOC_PROFRELEASE, 0);
+	close(fd);
+	return ret < 0 ? ERROR : OK;
+}
+#endif
+
 static void cpuload_show_usage(void)
 {
 	printf("\nUsage: cpuload [-s <snapshot interval(s)>] [-i <print interval(s)>] [-n <iterations>]\n");
 	printf("    Or, cpuload stop\n");
+#ifdef CONFIG_SCHED_PROFILER
+	printf("    Or, cpuload -p <profiling time(s)> [-r <ticks per sample>]\n");
+#endif
 	printf("Start/Stop CPU load monitor daemon\n");
+#ifdef CONFIG_SCHED_PROFILER
+	printf("With -p, sample the interrupted code and print it for os/tools/profile_report.py\n");
+#endif
 }
 
 /****************************************************************************
@@ -359,6 +457,10 @@ int utils_cpuload(int argc, char **args)
 	int opt;
 	int ret;
 	long value;
+#ifdef CONFIG_SCHED_PROFILER
+	int prof_seconds = 0;
+	int prof_period = 1;
+#endif
 
 	if (argc >= 2) {
 		if (!strncmp(args[1], "--help", strlen("--help") + 1)) {
@@ -391,7 +493,7 @@ int utils_cpuload(int argc, char **args)
 		 *  TASH >> cpuload -s 60 -i 10
 		 *  CPU monitor starts with snapshot mode and shows measured values every 10 seconds.
 		 */
-		while ((opt = getopt(argc, args, "s:i:n:")) != ERROR) {
+		while ((opt = getopt(argc, args, "s:i:n:p:r:")) != ERROR) {
 			switch (opt) {
 			case 's':
 				/* set snapshot interval */
@@ -420,12 +522,37 @@ int utils_cpuload(int argc, char **args)
 				}
 				cpuload_count = value;
 				break;
+#ifdef CONFIG_SCHED_PROFILER
+			case 'p':
+				/* set profiling time */
+				prof_seconds = atoi(optarg);
+				if (prof_seconds <= 0) {
+					printf("Invalid input");
+					goto show_usage;
+				}
+				break;
+			case 'r':
+				/* set sampling period in ticks */
+				prof_period = atoi(optarg);
+				if (prof_period <= 0 || prof_period > UINT16_MAX) {
+					printf("Invalid input");
+					goto show_usage;
+				}
+				break;
+#endif
 			default:
 				printf("Invalid input");
 				goto show_usage;
 			}
 		}
 	}
+
+#ifdef CONFIG_SCHED_PROFILER
+	if (prof_seconds > 0) {
+		return cpuload_profile(prof_seconds, prof_period);
+	}
+#endif
+
 	/* Set started flag to avoid creation more than 1 daemon by another request */
 	is_started = true;
 
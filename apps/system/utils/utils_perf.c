@@ -0,0 +1,313 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include <tinyara/config.h>
+#include <sys/types.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/ioctl.h>
+#include <tinyara/perf.h>
+#include <tinyara/fs/ioctl.h>
+#ifdef CONFIG_TASH_COMMAND_INTERFACE
+#include <apps/shell/tash.h>
+#endif
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+#define PERF_CMDNAME_LEN 32
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+static const char *const perf_event_names[PERF_EVENT_MAX] = {
+	[PERF_EVENT_CYCLES]         = "cycles",
+	[PERF_EVENT_INSTRUCTIONS]   = "instructions",
+	[PERF_EVENT_CACHE_REFS]     = "cache-references",
+	[PERF_EVENT_CACHE_MISSES]   = "cache-misses",
+	[PERF_EVENT_ICACHE_MISSES]  = "icache-misses",
+	[PERF_EVENT_BRANCH_MISSES]  = "branch-misses",
+	[PERF_EVENT_EXCEPTIONS]     = "exceptions",
+	[PERF_EVENT_STALL_CYCLES]   = "stall-cycles",
+	[PERF_EVENT_LSU_CYCLES]     = "lsu-cycles",
+	[PERF_EVENT_EXC_CYCLES]     = "exc-cycles",
+	[PERF_EVENT_SLEEP_CYCLES]   = "sleep-cycles",
+	[PERF_EVENT_FOLDED]         = "folded",
+};
+
+/* Events tried in this order when none are given with -e */
+static const uint8_t perf_default_events[] = {
+	PERF_EVENT_CYCLES,
+	PERF_EVENT_INSTRUCTIONS,
+	PERF_EVENT_CACHE_MISSES,
+	PERF_EVENT_BRANCH_MISSES,
+	PERF_EVENT_STALL_CYCLES,
+	PERF_EVENT_LSU_CYCLES,
+	PERF_EVENT_EXC_CYCLES,
+	PERF_EVENT_CACHE_REFS,
+	PERF_EVENT_SLEEP_CYCLES,
+	PERF_EVENT_FOLDED,
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+static void perf_show_usage(void)
+{
+	printf("\nUsage: perf list\n");
+	printf("   Or: perf stat [-e <event>[,<event>...]] -a <seconds>\n");
+	printf("   Or: perf stat [-e <event>[,<event>...]] -p <pid> <seconds>\n");
+#ifdef CONFIG_TASH_COMMAND_INTERFACE
+	printf("   Or: perf stat [-e <event>[,<event>...]] <command> [<args>...]\n");
+#endif
+	printf("Count hardware events of all tasks, of one task or of a command\n");
+}
+
+static int perf_event_byname(const char *name, size_t len)
+{
+	int i;
+
+	for (i = 0; i < PERF_EVENT_MAX; i++) {
+		if (strlen(perf_event_names[i]) == len && strncmp(perf_event_names[i], name, len) == 0) {
+			return i;
+		}
+	}
+
+	return ERROR;
+}
+
+/* Configure the events of the comma separated list, or as many of the
+ * default events as the CPU supports if list is NULL.
+ */
+static int perf_configure(int fd, const char *list)
+{
+	struct perf_config_s config;
+	const char *end;
+	int event;
+	int i;
+
+	config.nevents = 0;
+
+	if (list != NULL) {
+		while (*list != '\0') {
+			end = strchr(list, ',');
+			if (end == NULL) {
+				end = list + strlen(list);
+			}
+
+			event = perf_event_byname(list, end - list);
+			if (event < 0) {
+				printf("perf: unknown event '%.*s'\n", (int)(end - list), list);
+				return ERROR;
+			}
+
+			if (config.nevents == PERF_MAX_COUNTERS) {
+				printf("perf: at most %d events can be counted\n", PERF_MAX_COUNTERS);
+				return ERROR;
+			}
+
+			config.events[config.nevents++] = event;
+			list = *end == ',' ? end + 1 : end;
+		}
+
+		if (ioctl(fd, PERFIOC_CONFIG, (unsigned long)&config) < 0) {
+			printf("perf: cannot count these events, errno %d\n", errno);
+			return ERROR;
+		}
+
+		return OK;
+	}
+
+	for (i = 0; i < sizeof(perf_default_events) && config.nevents < PERF_MAX_COUNTERS; i++) {
+		config.events[config.nevents++] = perf_default_events[i];
+		if (ioctl(fd, PERFIOC_CONFIG, (unsigned long)&config) < 0) {
+			/* Not implemented by this CPU, or out of counters */
+			config.nevents--;
+		}
+	}
+
+	if (config.nevents == 0) {
+		printf("perf: no event can be counted\n");
+		return ERROR;
+	}
+
+	return ioctl(fd, PERFIOC_CONFIG, (unsigned long)&config) < 0 ? ERROR : OK;
+}
+
+static void perf_print(const char *what, struct perf_read_s *result, struct timespec *start)
+{
+	struct timespec now;
+	uint64_t cycles = 0;
+	uint64_t instructions = 0;
+	uint32_t msec;
+	int i;
+
+	clock_gettime(CLOCK_REALTIME, &now);
+	msec = (now.tv_sec - start->tv_sec) * 1000 + (now.tv_nsec - start->tv_nsec) / 1000000;
+
+	printf("\n Performance counter stats for %s:\n\n", what);
+	for (i = 0; i < result->nevents; i++) {
+		printf(" %20llu      %s\n", (unsigned long long)result->counts[i], perf_event_names[result->events[i]]);
+		if (result->events[i] == PERF_EVENT_CYCLES) {
+			cycles = result->counts[i];
+		} else if (result->events[i] == PERF_EVENT_INSTRUCTIONS) {
+			instructions = result->counts[i];
+		}
+	}
+
+	if (cycles != 0 && instructions != 0) {
+		printf("\n %20u.%02u  instructions per cycle\n", (unsigned int)(instructions / cycles), (unsigned int)(instructions * 100 / cycles % 100));
+	}
+	printf("\n %17u.%03u  seconds time elapsed\n\n", msec / 1000, msec % 1000);
+}
+
+#ifdef CONFIG_TASH_COMMAND_INTERFACE
+/* Run a TASH command as a function call in this task, like TASH runs
+ * synchronous commands, so that its events are counted on this task.
+ */
+static int perf_run_command(int argc, char **args)
+{
+	char name[PERF_CMDNAME_LEN];
+	TASH_CMD_CALLBACK cb;
+	int count;
+	int i;
+
+	count = tash_get_cmdscount();
+	for (i = 0; i < count; i++) {
+		if (tash_get_cmdpair(name, &cb, i) == OK && strncmp(name, args[0], PERF_CMDNAME_LEN) == 0) {
+			return cb(argc, args);
+		}
+	}
+
+	printf("perf: command '%s' not found\n", args[0]);
+	return ERROR;
+}
+#endif
+
+static int perf_stat(int argc, char **args)
+{
+	struct perf_read_s result;
+	struct timespec start;
+	const char *events = NULL;
+	char what[PERF_CMDNAME_LEN + 16];
+	int seconds = 0;
+	int ret = ERROR;
+	int fd;
+	int i;
+
+	result.pid = PERF_PID_SELF;
+
+	for (i = 2; i < argc && args[i][0] == '-'; i++) {
+		if (strcmp(args[i], "-e") == 0 && i + 1 < argc) {
+			events = args[++i];
+		} else if (strcmp(args[i], "-a") == 0 && i + 1 < argc) {
+			result.pid = PERF_PID_ALL;
+			seconds = atoi(args[++i]);
+		} else if (strcmp(args[i], "-p") == 0 && i + 2 < argc) {
+			result.pid = atoi(args[++i]);
+			seconds = atoi(args[++i]);
+			if (result.pid <= 0) {
+				seconds = 0;
+			}
+		} else {
+			break;
+		}
+	}
+
+	if (result.pid != PERF_PID_SELF ? (seconds <= 0 || i != argc) : i >= argc) {
+		perf_show_usage();
+		return ERROR;
+	}
+#ifndef CONFIG_TASH_COMMAND_INTERFACE
+	if (result.pid == PERF_PID_SELF) {
+		perf_show_usage();
+		return ERROR;
+	}
+#endif
+
+	fd = open(PERF_DRVPATH, O_RDWR);
+	if (fd < 0) {
+		printf("perf: cannot open %s, errno %d\n", PERF_DRVPATH, errno);
+		return ERROR;
+	}
+
+	if (perf_configure(fd, events) != OK) {
+		goto errout;
+	}
+
+	clock_gettime(CLOCK_REALTIME, &start);
+
+	if (result.pid == PERF_PID_SELF) {
+#ifdef CONFIG_TASH_COMMAND_INTERFACE
+		(void)ioctl(fd, PERFIOC_RESET, PERF_PID_SELF);
+		perf_run_command(argc - i, &args[i]);
+		snprintf(what, sizeof(what), "'%s'", args[i]);
+#endif
+	} else {
+		sleep(seconds);
+		if (result.pid == PERF_PID_ALL) {
+			snprintf(what, sizeof(what), "all tasks");
+		} else {
+			snprintf(what, sizeof(what), "pid %d", result.pid);
+		}
+	}
+
+	if (ioctl(fd, PERFIOC_READ, (unsigned long)&result) < 0) {
+		printf("perf: cannot read the counters, errno %d\n", errno);
+		goto errout;
+	}
+
+	perf_print(what, &result, &start);
+	ret = OK;
+
+errout:
+	close(fd);
+	return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+int utils_perf(int argc, char **args)
+{
+	int i;
+
+	if (argc >= 2 && strcmp(args[1], "list") == 0) {
+		printf("Events (not all are implemented by every CPU):\n");
+		for (i = 0; i < PERF_EVENT_MAX; i++) {
+			printf("  %s\n", perf_event_names[i]);
+		}
+		return OK;
+	}
+
+	if (argc >= 3 && strcmp(args[1], "stat") == 0) {
+		return perf_stat(argc, args);
+	}
+
+	perf_show_usage();
+	return ERROR;
+}
@@ -27,9 +27,16 @@
 #include <tinyara/config.h>
 #include <tinyara/ttrace.h>
 #include <tinyara/clock.h>
+#ifdef CONFIG_TTRACE_KERNEL
+#include <dirent.h>
+#include <tinyara/fs/fs.h>
+#endif
 
 #define MAX_TAG_NAMESIZE 4
 
+#define TTRACE_KEXPORT             'x'
+#define TTRACE_KREAD_NEVENTS       32
+
 struct tag_list {
 	const char *name;
 	const char *longname;
@@ -45,11 +52,23 @@ static const struct tag_list ttrace_tags[] = {
 	{"ipc",     "IPC",           TTRACE_TAG_IPC},
 };
 
+#ifdef CONFIG_TTRACE_KERNEL
+static const struct tag_list ttrace_ktags[] = {
+	{"sched",   "Context switch",     TTRACE_KTAG_SCHED},
+	{"irq",     "Interrupt",          TTRACE_KTAG_IRQ},
+	{"sem",     "Semaphore",          TTRACE_KTAG_SEM},
+	{"heap",    "Kernel heap",        TTRACE_KTAG_HEAP},
+};
+
+int selected_ktags = 0;
+#endif
+
 int param = 0;
 int selected_tags = 0;
 int is_overwritable = 0;
 
 static void show_help(void);
+static int run_cmd(FILE *fp, int cmd, int arg);
 void wait_ttrace_dump(void);
 
 static int print_uid_packet(struct trace_packet *packet)
@@ -112,6 +131,11 @@ static void show_help()
 	printf("    -i     Show information(state, available/selected/TP used tags, bufsize)\r\n");
 	printf("    -d     Dump trace buffer, It should be run after finish\r\n");
 	printf("    -p     Print trace buffer, It should be run after finish\r\n");
+#ifdef CONFIG_TTRACE_KERNEL
+	printf("    -k     Start kernel tracing of sched, irq, sem and heap events(default all)\r\n");
+	printf("    -x     Stop kernel tracing and export the events\r\n");
+	printf("           Convert the output with tools/ttrace_parser/ttrace_export.py\r\n");
+#endif
 }
 
 static int assign_tag(char *name)
@@ -126,6 +150,119 @@ static int assign_tag(char *name)
 	return tags;
 }
 
+#ifdef CONFIG_TTRACE_KERNEL
+static int assign_ktag(char *name)
+{
+	int i = 0;
+	int len_tags = sizeof(ttrace_ktags) / sizeof(struct tag_list);
+	for (i = 0; i < len_tags; i++)
+		if (strcmp(name, ttrace_ktags[i].name) == 0) {
+			return ttrace_ktags[i].tags;
+		}
+	return 0;
+}
+
+#if defined(CONFIG_FS_PROCFS) && CONFIG_TASK_NAME_SIZE > 0
+static void export_task_names(void)
+{
+	DIR *dirp;
+	FILE *fp;
+	struct dirent *entryp;
+	char path[32];
+	char line[CONFIG_TASK_NAME_SIZE + 16];
+	size_t len;
+
+	dirp = opendir(PROCFS_MOUNT_POINT);
+	if (dirp == NULL) {
+		return;
+	}
+
+	while ((entryp = readdir(dirp)) != NULL) {
+		if (entryp->d_name[0] < '0' || entryp->d_name[0] > '9') {
+			continue;
+		}
+
+		snprintf(path, sizeof(path), "%s/%s/status", PROCFS_MOUNT_POINT, entryp->d_name);
+		fp = fopen(path, "r");
+		if (fp == NULL) {
+			continue;
+		}
+
+		/* The first line is "Name:       <name>" */
+
+		if (fgets(line, sizeof(line), fp) != NULL && strncmp(line, "Name:", 5) == 0) {
+			len = strlen(line);
+			if (len > 0 && line[len - 1] == '\n') {
+				line[len - 1] = '\0';
+			}
+			printf("@TTN:%s %s\r\n", entryp->d_name, line + 5 + strspn(line + 5, " "));
+		}
+		fclose(fp);
+	}
+
+	closedir(dirp);
+}
+#else
+#define export_task_names()
+#endif
+
+/* Print the kernel events as "@TT:" lines, which are converted to a
+ * timeline on the host by tools/ttrace_parser/ttrace_export.py
+ */
+
+static int export_kevents(FILE *file)
+{
+	struct trace_kinfo info;
+	struct trace_kread req;
+	struct trace_kevent *events;
+	uint32_t lost = 0;
+	int count = 0;
+	int ret;
+	int i;
+
+	if (run_cmd(file, TTRACE_KINFO, (int)&info) != OK) {
+		return TTRACE_INVALID;
+	}
+
+	events = (struct trace_kevent *)malloc(TTRACE_KREAD_NEVENTS * sizeof(struct trace_kevent));
+	if (events == NULL) {
+		printf("Failed to allocate buffer in ttrace\r\n");
+		return TTRACE_INVALID;
+	}
+
+	printf("@TTI:%u %u\r\n", info.freq, info.nevents);
+	export_task_names();
+
+	req.pos = 0;
+	req.events = events;
+	req.nevents = TTRACE_KREAD_NEVENTS;
+	while (1) {
+		req.lost = 0;
+		ret = run_cmd(file, TTRACE_KREAD, (int)&req);
+		if (ret < 0) {
+			break;
+		}
+
+		for (i = 0; i < ret; i++) {
+			printf("@TT:%u %u %d %u %x %x\r\n", events[i].seq - 1, events[i].timestamp, events[i].pid,
+				   events[i].type, events[i].arg0, events[i].arg1);
+		}
+		count += ret;
+		lost += req.lost;
+
+		if (ret == 0 && req.lost == 0) {
+			break;
+		}
+	}
+
+	printf("@TTE:%d %u\r\n", count, lost);
+	printf("%d events exported, %u lost\r\n", count, lost);
+
+	free(events);
+	return TTRACE_VALID;
+}
+#endif
+
 static int parse_args(int argc, char **args)
 {
 	int cmd = 0;
@@ -143,10 +280,12 @@ static int parse_args(int argc, char **args)
 	 * -g : TTRACE_FUNC_TAG, TP's tag(hidden to user)
 	 * -d : TTRACE_DUMP, dump mode(hang), It should be run after finish.
 	 * -p : TTRACE_PRINT, print traces, It should be run after finish.
+	 * -k : TTRACE_KSTART, start tracing the kernel events.
+	 * -x : TTRACE_KEXPORT, stop tracing the kernel events and export them.
 	 */
 	while (1) {
 		optarg = NULL;
-		ret = getopt(argc, args, "sofidpb:");
+		ret = getopt(argc, args, "sofidpkxb:");
 		if (ret == '?') {
 			show_help();
 			return TTRACE_INVALID;
@@ -172,6 +311,9 @@ static int parse_args(int argc, char **args)
 		printf("args[%d], %s\r\n", i, args[i]);
 		// Add args[i] to tag list
 		selected_tags |= assign_tag(args[i]);
+#ifdef CONFIG_TTRACE_KERNEL
+		selected_ktags |= assign_ktag(args[i]);
+#endif
 	}
 	printf("selected tags: %d\r\n", selected_tags);
 	return cmd;
@@ -272,6 +414,15 @@ static int send_cmds(FILE *file, int cmd)
 	int ret = 0;
 	int bufsize = 0;
 
+#ifdef CONFIG_TTRACE_KERNEL
+	if (cmd == TTRACE_KSTART) {
+		return run_cmd(file, TTRACE_KSTART, selected_ktags != 0 ? selected_ktags : TTRACE_KTAG_ALL);
+	} else if (cmd == TTRACE_KEXPORT) {
+		run_cmd(file, TTRACE_KSTART, 0);
+		return export_kevents(file);
+	}
+#endif
+
 	if (cmd == TTRACE_START) {
 		ret = run_cmd(file, TTRACE_SELECTED_TAG, selected_tags);
 		ret = run_cmd(file, TTRACE_OVERWRITE, is_overwritable);
@@ -306,6 +457,9 @@ int utils_ttrace(int argc, char **args)
 	}
 
 	selected_tags = 0;
+#ifdef CONFIG_TTRACE_KERNEL
+	selected_ktags = 0;
+#endif
 	cmd = parse_args(argc, args);
 	if (cmd <= TTRACE_INVALID) {
 		return TTRACE_INVALID;
@@ -82,6 +82,10 @@ extern "C"
 
 #include "pv_mp3dec_fxd_op_msc_evc.h"
 
+#elif defined(PV_ARM_V7EM)
+
+#include "pv_mp3dec_fxd_op_armv7em.h"
+
 #else
 
 #ifndef C_EQUIVALENT
@@ -0,0 +1,139 @@
+/******************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+/*
+------------------------------------------------------------------------------
+ INCLUDE DESCRIPTION
+
+ Fixed point functions for cores with the ARMv7E-M DSP extension
+ (Cortex-M4/M7/M33/M55, also ARMv7-A/R).
+
+ The results are bit-exact with pv_mp3dec_fxd_op_c_equivalent.h, so the
+ decoder output does not change:
+ - SMMUL and SMMLA keep the high word of the 64 bits product, which
+   truncates exactly like the shift by 32 of the C version.
+ - SMMLS rounds the other way, (L_sub*2^32 - a*b) >> 32 is one less than
+   L_sub - ((a*b) >> 32) when the low word is not zero, so fxp_msb32_Q32
+   subtracts the SMMUL result instead.
+ - The Q26 to Q30 products need both words of SMULL. The compiler already
+   emits SMULL and the shifts for the C version, so they stay in C.
+
+ The __asm__ statements are not volatile, so the compiler can schedule them
+ with the loads of the IMDCT and polyphase filter loops.
+
+------------------------------------------------------------------------------
+*/
+
+#ifndef PV_MP3DEC_FXD_OP_ARMV7EM_H
+#define PV_MP3DEC_FXD_OP_ARMV7EM_H
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "pvmp3_audio_type_defs.h"
+
+
+#if defined(PV_ARM_V7EM)
+
+#ifndef __ARM_FEATURE_DSP
+#error "PV_ARM_V7EM needs a core with the DSP extension"
+#endif
+
+#define Qfmt_31(a)   (Int32)((float)(a)*0x7FFFFFFF)
+
+#define Qfmt15(x)   (Int16)((x)*((Int32)1<<15) + ((x)>=0?0.5F:-0.5F))
+
+
+    static inline int32 pv_abs(int32 a)
+    {
+        int32 b = (a < 0) ? -a : a;
+        return b;
+    }
+
+
+    static inline Int32 fxp_mul32_Q32(const Int32 a, const Int32 b)
+    {
+        Int32 result;
+
+        __asm__("smmul %0, %1, %2"
+    : "=r"(result)
+            : "r"(a), "r"(b));
+
+        return result;
+    }
+
+    static inline Int32 fxp_mac32_Q32(Int32 L_add, const Int32 a, const Int32 b)
+    {
+        Int32 result;
+
+        __asm__("smmla %0, %1, %2, %3"
+    : "=r"(result)
+            : "r"(a), "r"(b), "r"(L_add));
+
+        return result;
+    }
+
+    static inline Int32 fxp_msb32_Q32(Int32 L_sub, const Int32 a, const Int32 b)
+    {
+        return (L_sub - fxp_mul32_Q32(a, b));
+    }
+
+
+    static inline Int32 fxp_mul32_Q30(const Int32 a, const Int32 b)
+    {
+        return (Int32)(((int64)(a) * b) >> 30);
+    }
+
+    static inline Int32 fxp_mac32_Q30(const Int32 a, const Int32 b, Int32 L_add)
+    {
+        return (L_add + (Int32)(((int64)(a) * b) >> 30));
+    }
+
+    static inline Int32 fxp_mul32_Q29(const Int32 a, const Int32 b)
+    {
+        return (Int32)(((int64)(a) * b) >> 29);
+    }
+
+    static inline Int32 fxp_mul32_Q28(const Int32 a, const Int32 b)
+    {
+        return (Int32)(((int64)(a) * b) >> 28);
+    }
+
+    static inline Int32 fxp_mul32_Q27(const Int32 a, const Int32 b)
+    {
+        return (Int32)(((int64)(a) * b) >> 27);
+    }
+
+    static inline Int32 fxp_mul32_Q26(const Int32 a, const Int32 b)
+    {
+        return (Int32)(((int64)(a) * b) >> 26);
+    }
+
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif   /*  PV_MP3DEC_FXD_OP_ARMV7EM_H  */
+
@@ -126,6 +126,12 @@ Returns
 /* function is inlined in header file */
 
 
+#elif defined(PV_ARM_V7EM)
+
+
+/* function is inlined in header file */
+
+
 #else
 
 int32 pvmp3_normalize(int32 x)
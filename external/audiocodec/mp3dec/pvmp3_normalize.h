@@ -106,6 +106,14 @@ __inline int32 pvmp3_normalize(int32 x)
 
 }
 
+#elif defined(PV_ARM_V7EM)
+
+/* Only called with x > 0, where it equals the leading zeros less one */
+static inline int32 pvmp3_normalize(int32 x)
+{
+    return (__builtin_clz(x) - 1);
+}
+
 #else
 
 #ifdef __cplusplus
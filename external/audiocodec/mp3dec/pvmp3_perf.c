@@ -0,0 +1,94 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/*
+ * Benchmark hooks, see audiocodec/mp3dec_perf.h. Nothing here is linked
+ * unless the hooks are called.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <audiocodec/mp3dec_perf.h>
+#include "pvmp3_audio_type_defs.h"
+#include "pvmp3_dec_defs.h"
+#include "s_tmp3dec_chan.h"
+#include "pvmp3_imdct_synth.h"
+#include "pvmp3_poly_phase_synthesis.h"
+
+#define PERF_CHANNELS   2
+#define PERF_GRANULES   2		/* MPEG-1 layer III */
+#define PERF_LINES      (SUBBANDS_NUMBER * FILTERBANK_BANDS)
+
+/* Like the decoder's tmp3dec_file, the channel states are large */
+static tmp3dec_chan g_chan[PERF_CHANNELS];
+static int32 g_scratch[198];
+static int32 g_spectrum[PERF_CHANNELS][PERF_LINES];
+static int16 g_pcm[PERF_CHANNELS * PERF_LINES];
+
+/*
+ * Random lines, falling off with the frequency like dequantized ones.
+ * A few peaks clip, so the saturation is checked too.
+ */
+static void fill_spectrum(void)
+{
+	uint32_t seed = 1;
+	int ch;
+	int i;
+
+	for (ch = 0; ch < PERF_CHANNELS; ch++) {
+		for (i = 0; i < PERF_LINES; i++) {
+			seed = seed * 1103515245 + 12345;
+			g_spectrum[ch][i] = ((int32)seed >> 9) / (1 + i / 32);
+		}
+	}
+}
+
+void mp3dec_perf_reset(void)
+{
+	fill_spectrum();
+	memset(g_chan, 0, sizeof(g_chan));
+	memset(g_pcm, 0, sizeof(g_pcm));
+}
+
+/* Every fourth frame uses short blocks, so the 6 points IMDCT runs too */
+uint32_t mp3dec_perf_frame(int frame, int stages, uint32_t sum)
+{
+	uint32 blk_type = (frame % 4 == 3) ? 2 : 0;
+	int gr;
+	int ch;
+	int i;
+
+	for (gr = 0; gr < PERF_GRANULES; gr++) {
+		for (ch = 0; ch < PERF_CHANNELS; ch++) {
+			memcpy(g_chan[ch].work_buf_int32, g_spectrum[ch], sizeof(g_spectrum[ch]));
+			g_chan[ch].used_freq_lines = PERF_LINES;
+			if (stages & MP3DEC_PERF_IMDCT) {
+				pvmp3_imdct_synth(g_chan[ch].work_buf_int32, g_chan[ch].overlap, blk_type, 0, g_chan[ch].used_freq_lines, g_scratch);
+			}
+			if (stages & MP3DEC_PERF_SYNTHESIS) {
+				pvmp3_poly_phase_synthesis(&g_chan[ch], PERF_CHANNELS, flat, &g_pcm[ch]);
+			}
+		}
+	}
+
+	/* FNV-1a over the 16 bits samples */
+	for (i = 0; i < PERF_CHANNELS * PERF_LINES; i++) {
+		sum = (sum ^ (uint16_t)g_pcm[i]) * 16777619;
+	}
+	return sum;
+}
@@ -121,6 +121,20 @@ extern "C"
         return sample ;
     }
 
+#elif defined(PV_ARM_V7EM)
+
+    /* SSAT gives the same 0x7FFF and -0x8000 as the C version */
+    static inline int16 saturate16(int32 sample)
+    {
+        int32 result;
+
+        __asm__("ssat %0, #16, %1"
+    : "=r"(result)
+            : "r"(sample));
+
+        return result;
+    }
+
 #else
 
     inline int16 saturate16(int32 sample)
@@ -0,0 +1,69 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/*
+ * Benchmark hooks of the MP3 decoder. They run its IMDCT and polyphase
+ * synthesis over generated frames, built with the same flags as the decoder,
+ * so that examples/performance/mp3dec does not need its private headers.
+ */
+
+#ifndef __AUDIOCODEC_MP3DEC_PERF_H
+#define __AUDIOCODEC_MP3DEC_PERF_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Stages of mp3dec_perf_frame() */
+
+#define MP3DEC_PERF_IMDCT       (1 << 0)
+#define MP3DEC_PERF_SYNTHESIS   (1 << 1)
+
+/****************************************************************************
+ * Name: mp3dec_perf_reset
+ *
+ * Description:
+ *   Generate the spectrum of the test frames and clear the channel states
+ *   and the PCM output.
+ *
+ ****************************************************************************/
+
+void mp3dec_perf_reset(void);
+
+/****************************************************************************
+ * Name: mp3dec_perf_frame
+ *
+ * Description:
+ *   Run the two granules of stereo frame 'frame' through 'stages'.  Every
+ *   fourth frame uses short blocks.  The PCM of the last granule is folded
+ *   into 'sum' with FNV-1a; it does not depend on the kernels built in.
+ *
+ * Returned Value:
+ *   The updated checksum.
+ *
+ ****************************************************************************/
+
+uint32_t mp3dec_perf_frame(int frame, int stages, uint32_t sum);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif							/* __AUDIOCODEC_MP3DEC_PERF_H */
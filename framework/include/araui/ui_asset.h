@@ -130,6 +130,21 @@ ui_asset_t ui_font_asset_create_from_buffer(const uint8_t *buf);
  */
 ui_error_t ui_font_asset_destroy(ui_asset_t font);
 
+/**
+ * @brief Set the pre-rasterized glyph atlas of the font asset.
+ *
+ * The atlas is generated from the same font file by tools/araui/font2c, and it must be valid
+ * until the font asset is destroyed. It is used only if CONFIG_UI_GLYPH_ATLAS is enabled.
+ *
+ * @param[in] font Handle of the font asset
+ * @param[in] atlas Pointer address of the atlas, NULL to unset it
+ * @return On success, UI_OK is returned. On failure, the defined error type is returned.
+ *
+ * @see ui_font_asset_create_from_file()
+ * @see ui_font_asset_create_from_buffer()
+ */
+ui_error_t ui_font_asset_set_atlas(ui_asset_t font, const uint8_t *atlas);
+
 #ifdef __cplusplus
 }
 #endif
@@ -150,6 +150,22 @@ binmgr_result_type_e binary_manager_get_state(char *binary_name, int *state);
  */
 binmgr_result_type_e binary_manager_set_bootparam(uint8_t type, binary_setbp_result_t *update_result);
 
+#ifdef CONFIG_ELF_LAZY_LOAD
+/**
+ * @brief Load a section of the caller's binary that is loaded on demand
+ * @details @b #include <binary_manager/binary_manager.h>\n
+ *  It sends a message the binary manager to read, decompress and relocate the section
+ *  which contains addr. Sections whose name starts with CONFIG_ELF_LAZY_SECTION_PREFIX
+ *  are not loaded at boot and must be loaded with this API before they are used.
+ *  Loading a section which is already loaded returns BINMGR_OK.
+ * @param[in] addr An address in the section to load, for example a function in it
+ * @return A defined value of binmgr_result_type_e in <tinyara/binary_manager.h>
+ *         0 (BINMGR_OK) on success. On failure, negative value is returned.
+ * @since TizenRT v4.0
+ */
+binmgr_result_type_e binary_manager_load_section(void *addr);
+#endif
+
 #endif
 /**
  * @}
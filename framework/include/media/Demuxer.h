@@ -16,6 +16,19 @@
  *
  ******************************************************************/
 
+/**
+ * @ingroup MEDIA
+ * @{
+ */
+
+/**
+ * @cond
+ * @internal
+ * @file media/Demuxer.h
+ * @brief Media Demuxer APIs
+ * @endcond
+ */
+
 #ifndef __MEDIA_DEMUXER_H
 #define __MEDIA_DEMUXER_H
 
@@ -144,3 +157,4 @@ private:
 } // namespace media
 
 #endif /* __MEDIA_DEMUXER_H */
+/** @} */ // end of MEDIA group
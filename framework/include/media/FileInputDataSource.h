@@ -106,8 +106,14 @@ public:
 	ssize_t read(unsigned char *buf, size_t size) override;
 
 private:
+	void mapFile();
+	void unmapFile();
+
 	std::string mDataPath;
 	FILE *mFp;
+	const unsigned char *mMapBase;
+	size_t mMapSize;
+	size_t mMapPos;
 };
 } // namespace stream
 } // namespace media
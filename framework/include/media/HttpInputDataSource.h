@@ -34,6 +34,7 @@
 #include <curl/curl.h>
 #include <curl/easy.h>
 #include <pthread.h>
+#include <atomic>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
@@ -140,7 +141,7 @@ private:
 	std::mutex mMutex;
 	std::condition_variable mCondv;
 	bool mIsHeaderReceived;
-	bool mIsDataReceived;
+	std::atomic<bool> mIsDataReceived;
 	std::shared_ptr<HttpStream> mHttpStream;
 	std::shared_ptr<StreamBuffer> mStreamBuffer;
 	std::shared_ptr<StreamBufferReader> mBufferReader;
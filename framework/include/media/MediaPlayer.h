@@ -59,6 +59,29 @@ typedef enum player_error_e player_error_t;
 const int PLAYER_OK = PLAYER_ERROR_NONE;
 typedef int player_result_t;
 
+/**
+ * @brief Statistics of the decode-ahead playback pipeline
+ * @details @b #include <media/MediaPlayer.h>
+ * Counted since the player was prepared, see CONFIG_MEDIA_PLAYER_DECODE_AHEAD.
+ * @since TizenRT v4.0
+ */
+typedef struct player_pipeline_stats_s {
+	/** Number of PCM buffers decoded ahead of the output */
+	unsigned int buffers;
+	/** Buffers decoded and not output yet */
+	unsigned int decoded;
+	/** Fewest decoded buffers the output found, 0 after an underrun */
+	unsigned int minDecoded;
+	/** Encoded bytes fetched from the source and not decoded yet */
+	unsigned int fetched;
+	/** Times the output had to wait for decoding */
+	unsigned int underruns;
+	/** Time from fetching encoded data to outputting its PCM data, in ms, of the last buffer */
+	unsigned int latency;
+	/** Maximum latency, in ms */
+	unsigned int maxLatency;
+} player_pipeline_stats_t;
+
 class MediaPlayerImpl;
 
 /**
@@ -228,6 +251,18 @@ public:
 	 * @since TizenRT v2.1 PRE
 	 */
 	bool isPlaying();
+
+	/**
+	 * @brief Get the statistics of the decode-ahead playback pipeline
+	 * @details @b #include <media/MediaPlayer.h>
+	 * This function is a synchronous API
+	 * The player should be prepared.
+	 * @param[out] stats The statistics
+	 * @return The result of the getPipelineStats operation,
+	 *         PLAYER_ERROR_INVALID_OPERATION if CONFIG_MEDIA_PLAYER_DECODE_AHEAD is disabled
+	 * @since TizenRT v4.0
+	 */
+	player_result_t getPipelineStats(player_pipeline_stats_t *stats);
 private:
 	std::shared_ptr<MediaPlayerImpl> mPMpImpl;
 	uint64_t mId;
@@ -0,0 +1,131 @@
+/******************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+/**
+ * @ingroup MEDIA
+ * @{
+ */
+
+/**
+ * @cond
+ * @internal
+ * @file media/audio_dsp.h
+ * @brief Media audio DSP kernel APIs
+ * @endcond
+ */
+
+#ifndef AUDIO_DSP_H
+#define AUDIO_DSP_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+// Max channel num of a frame given to the remix and (de)interleave kernels
+#define AUDIO_DSP_MAX_CH        (8)
+
+// Remix matrix coefficients are Q14: 1.0 is AUDIO_DSP_MIX_ONE
+#define AUDIO_DSP_MIX_SHIFT     (14)
+#define AUDIO_DSP_MIX_ONE       (1 << AUDIO_DSP_MIX_SHIFT)
+
+// Gains are Q12: 1.0 is AUDIO_DSP_GAIN_ONE, the max is almost 8.0
+#define AUDIO_DSP_GAIN_SHIFT    (12)
+#define AUDIO_DSP_GAIN_ONE      (1 << AUDIO_DSP_GAIN_SHIFT)
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+enum audio_dsp_kernel_e {
+	AUDIO_DSP_KERNEL_AUTO = 0,  // best kernel built in
+	AUDIO_DSP_KERNEL_SCALAR,    // portable C, the reference
+	AUDIO_DSP_KERNEL_DSP,       // ARMv7E-M DSP extension
+	AUDIO_DSP_KERNEL_NEON,      // ARM Advanced SIMD
+};
+
+/**
+ * @structure audio_dsp_ops_s
+ * @brief     Batch kernels of one implementation. All implementations give
+ *            exactly the same output as the scalar one. Samples are
+ *            interleaved unless the parameter is named planar.
+ */
+struct audio_dsp_ops_s {
+	/**
+	 * Mix frames of in_ch channels to frames of out_ch channels:
+	 * output[o] = sat16(sum(matrix[o * in_ch + i] * input[i]) >> 14), rounded.
+	 * The sum of the absolute coefficients of a row must stay below 4.0.
+	 * output may be input when out_ch <= in_ch.
+	 */
+	void (*remix_s16)(const int16_t *input, uint32_t in_ch, int16_t *output, uint32_t out_ch, const int16_t *matrix, uint32_t frames);
+
+	/**
+	 * output = sat16(input * gain >> 12), rounded. output may be input.
+	 */
+	void (*gain_s16)(const int16_t *input, int16_t *output, uint32_t samples, int16_t gain);
+
+	/**
+	 * Q15 to Q31 and back, the latter rounded and saturated.
+	 */
+	void (*s16_to_s32)(const int16_t *input, int32_t *output, uint32_t samples);
+	void (*s32_to_s16)(const int32_t *input, int16_t *output, uint32_t samples);
+
+	/**
+	 * Q15 to float in [-1.0, 1.0) and back, the latter rounded half away
+	 * from zero and saturated.
+	 */
+	void (*s16_to_float)(const int16_t *input, float *output, uint32_t samples);
+	void (*float_to_s16)(const float *input, int16_t *output, uint32_t samples);
+
+	/**
+	 * Planar buffers of each channel to interleaved frames and back.
+	 */
+	void (*interleave_s16)(const int16_t *const *planar, uint32_t channels, int16_t *output, uint32_t frames);
+	void (*deinterleave_s16)(const int16_t *input, uint32_t channels, int16_t *const *planar, uint32_t frames);
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+/**
+ * @brief   Get the kernels of the given AUDIO_DSP_KERNEL_* type.
+ * @return  NULL if the type is not supported by this build.
+ */
+const struct audio_dsp_ops_s *audio_dsp_get_ops(int kernel);
+
+/**
+ * @brief   Shortcuts to the AUDIO_DSP_KERNEL_AUTO kernels, see audio_dsp_ops_s.
+ */
+void audio_dsp_remix_s16(const int16_t *input, uint32_t in_ch, int16_t *output, uint32_t out_ch, const int16_t *matrix, uint32_t frames);
+void audio_dsp_gain_s16(const int16_t *input, int16_t *output, uint32_t samples, int16_t gain);
+void audio_dsp_s16_to_s32(const int16_t *input, int32_t *output, uint32_t samples);
+void audio_dsp_s32_to_s16(const int32_t *input, int16_t *output, uint32_t samples);
+void audio_dsp_s16_to_float(const int16_t *input, float *output, uint32_t samples);
+void audio_dsp_float_to_s16(const float *input, int16_t *output, uint32_t samples);
+void audio_dsp_interleave_s16(const int16_t *const *planar, uint32_t channels, int16_t *output, uint32_t frames);
+void audio_dsp_deinterleave_s16(const int16_t *input, uint32_t channels, int16_t *const *planar, uint32_t frames);
+
+#ifdef __cplusplus
+}		/* extern "C" */
+#endif	/* __cplusplus */
+
+#endif	/* AUDIO_DSP_H */
+/** @} */ // end of MEDIA group
@@ -29,6 +29,19 @@
 **     http://www.mega-nerd.com/SRC/api.html
 */
 
+/**
+ * @ingroup MEDIA
+ * @{
+ */
+
+/**
+ * @cond
+ * @internal
+ * @file media/samplerate.h
+ * @brief Media sample rate converter APIs
+ * @endcond
+ */
+
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -67,6 +80,17 @@ enum {
 	SAMPLE_WIDTH_MAX = SAMPLE_WIDTH_32BITS,
 };
 
+/**
+ * @enum  Define kernels of the polyphase resampler, see src_set_kernel().
+ * @brief All kernels generate exactly the same output.
+ */
+enum {
+	SRC_KERNEL_AUTO = 0,    // fastest kernel supported by the build
+	SRC_KERNEL_SCALAR,      // portable C
+	SRC_KERNEL_DSP,         // ARMv7E-M DSP extension (SMLAD)
+	SRC_KERNEL_NEON,        // ARM Advanced SIMD
+};
+
 /**
  * @typedef src_handle_t, SRC(Sample Rate Convertor) hanlde type declaration.
  * @brief   NULL means invalid handle.
@@ -146,9 +170,19 @@ int src_destroy(src_handle_t handle);
  */
 bool src_is_valid_ratio(float ratio);
 
+/**
+ * @brief   Select the kernel of the polyphase resampler.
+ * @remarks It can be changed at any time, the default is SRC_KERNEL_AUTO.
+ *          Only available with CONFIG_AUDIO_RESAMPLER_POLYPHASE.
+ * @param   handle: pointer to a SRC instance, returned by src_init().
+ * @param   kernel: one of SRC_KERNEL_*.
+ * @return  0 on success, SRC_ERR_NOT_SUPPORT if the kernel is not built in.
+ */
+int src_set_kernel(src_handle_t handle, int kernel);
+
 #ifdef __cplusplus
 }		/* extern "C" */
 #endif	/* __cplusplus */
 
 #endif	/* SAMPLERATE_H */
-
+/** @} */ // end of MEDIA group
@@ -81,6 +81,11 @@ struct msg_callback_info_s {
 };
 typedef struct msg_callback_info_s msg_callback_info_t;
 
+/**
+ * @brief The handle of a message port which is resolved once by messaging_port_open
+ */
+typedef struct msg_port_s msg_port_t;
+
 /**
  * @brief Send(unicast) message with sync mode.
  * @details @b #include <messaging/messaging.h>\n
@@ -203,6 +208,51 @@ int messaging_recv_nonblock(const char *port_name, msg_recv_buf_t *recv_buf, msg
  */
 int messaging_cleanup(const char *port_name);
 
+/**
+ * @brief Resolve the message port name into a handle for sending.
+ * @details @b #include <messaging/messaging.h>\n
+ * Sending with the handle does not look up the port name again.\n
+ * The port does not need to have receivers yet.
+ * @param[in] port_name The message port name to send.
+ * @return On success, the handle of the port is returned. On failure, NULL is returned.
+ * @since TizenRT v4.0
+ */
+msg_port_t *messaging_port_open(const char *port_name);
+/**
+ * @brief Send(unicast) message with noreply mode to the port handle.
+ * @details @b #include <messaging/messaging.h>\n
+ * Same as messaging_send, with the handle from messaging_port_open.
+ * @param[in] port The handle of the message port to send.
+ * @param[in] send_data\n
+ *		  msg          : The message to be sent.\n
+ *		  msglen       : The length of message to be sent.\n
+ *		  priority     : A non-negative integer that specifies the priority of this message.
+ * @return On success, OK is returned. On failure, ERROR is returned.
+ * @since TizenRT v4.0
+ */
+int messaging_port_send(msg_port_t *port, msg_send_data_t *send_data);
+/**
+ * @brief Send(multicast) message to the port handle.
+ * @details @b #include <messaging/messaging.h>\n
+ * Same as messaging_multicast, with the handle from messaging_port_open.
+ * @param[in] port The handle of the message port to send.
+ * @param[in] send_data\n
+ *		  msg          : The message to be sent.\n
+ *		  msglen       : The length of message to be sent.\n
+ *		  priority     : A non-negative integer that specifies the priority of this message.
+ * @return On success, the number of receivers who received the message is returned. On failure, ERROR is returned.
+ * @since TizenRT v4.0
+ */
+int messaging_port_multicast(msg_port_t *port, msg_send_data_t *send_data);
+/**
+ * @brief Release the handle from messaging_port_open.
+ * @details @b #include <messaging/messaging.h>\n
+ * @param[in] port The handle of the message port.
+ * @return On success, OK is returned. On failure, ERROR is returned.
+ * @since TizenRT v4.0
+ */
+int messaging_port_close(msg_port_t *port);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -28,12 +28,26 @@
 #include "ui_request_callback.h"
 #include "ui_debug.h"
 
+#if defined(CONFIG_UI_GLYPH_CACHE)
+#include "utils/glyph_cache.h"
+#endif
+
 #define STB_TRUETYPE_IMPLEMENTATION 
 #include <stb/stb_truetype.h>
 
 #define DEFAULT_GLYPH_MAP_CAPACITY 256
 
+#if defined(CONFIG_UI_GLYPH_ATLAS)
+typedef struct {
+	ui_font_asset_body_t *body;
+	const uint8_t *atlas;
+} ui_set_atlas_info_t;
+#endif
+
 static void _ui_font_asset_destroy_func(void *userdata);
+#if defined(CONFIG_UI_GLYPH_ATLAS)
+static void _ui_font_asset_set_atlas_func(void *userdata);
+#endif
 
 ui_asset_t ui_font_asset_create_from_file(const char *filename)
 {
@@ -169,12 +183,74 @@ ui_error_t ui_font_asset_destroy(ui_asset_t font)
 	return UI_OK;
 }
 
+ui_error_t ui_font_asset_set_atlas(ui_asset_t font, const uint8_t *atlas)
+{
+#if defined(CONFIG_UI_GLYPH_ATLAS)
+	ui_set_atlas_info_t *info;
+
+	if (!ui_is_running()) {
+		return UI_NOT_RUNNING;
+	}
+
+	if (!font || !ui_asset_check_type(font, UI_FONT_ASSET)) {
+		return UI_INVALID_PARAM;
+	}
+
+	if (atlas && ((const ui_glyph_atlas_t *)atlas)->magic != UI_GLYPH_ATLAS_MAGIC) {
+		UI_LOGE("error: invalid glyph atlas!\n");
+		return UI_INVALID_PARAM;
+	}
+
+	info = (ui_set_atlas_info_t *)UI_ALLOC(sizeof(ui_set_atlas_info_t));
+	if (!info) {
+		return UI_NOT_ENOUGH_MEMORY;
+	}
+
+	memset(info, 0, sizeof(ui_set_atlas_info_t));
+
+	info->body = (ui_font_asset_body_t *)font;
+	info->atlas = atlas;
+
+	if (ui_request_callback(_ui_font_asset_set_atlas_func, info) != UI_OK) {
+		UI_FREE(info);
+		return UI_OPERATION_FAIL;
+	}
+
+	return UI_OK;
+#else
+	UI_LOGE("error: CONFIG_UI_GLYPH_ATLAS is not enabled!\n");
+	return UI_OPERATION_FAIL;
+#endif
+}
+
+#if defined(CONFIG_UI_GLYPH_ATLAS)
+static void _ui_font_asset_set_atlas_func(void *userdata)
+{
+	ui_set_atlas_info_t *info;
+
+	if (!userdata || !((ui_set_atlas_info_t *)userdata)->body) {
+		UI_LOGE("error: Invalid parameter!\n");
+		return;
+	}
+
+	info = (ui_set_atlas_info_t *)userdata;
+
+	info->body->atlas = info->atlas;
+
+	UI_FREE(info);
+}
+#endif
+
 static void _ui_font_asset_destroy_func(void *userdata)
 {
 	ui_font_asset_body_t *body;
 
 	body = (ui_font_asset_body_t *)userdata;
 
+#if defined(CONFIG_UI_GLYPH_CACHE)
+	glyph_cache_remove_font(body);
+#endif
+
 	UI_FREE(body->ttf_buf);
 	UI_FREE(body);
 }
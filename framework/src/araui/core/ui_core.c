@@ -46,6 +46,10 @@
 #include "utils/emoji.h"
 #endif
 
+#if defined(CONFIG_UI_GLYPH_CACHE)
+#include "utils/glyph_cache.h"
+#endif
+
 #define UI_CORE_THREAD_NAME "UI Core Service"
 #define CONFIG_UI_GLOBAL_X_THRESHOLD     20
 #define CONFIG_UI_GLOBAL_Y_THRESHOLD     20
@@ -198,6 +202,10 @@ ui_error_t ui_stop(void)
 		return UI_OPERATION_FAIL;
 	}
 
+#if defined(CONFIG_UI_GLYPH_CACHE)
+	glyph_cache_clear();
+#endif
+
 	return UI_OK;
 }
 
@@ -460,8 +468,12 @@ static void *_ui_core_thread_loop(void *param)
 
 		clock_gettime(CLOCK_MONOTONIC, &now);
 
-		dt = ((now.tv_sec - before.tv_sec) * 1000) + ((now.tv_nsec - before.tv_nsec) / 1000000);
-		before = now;
+		dt = (uint32_t)((((int64_t)(now.tv_sec - before.tv_sec) * 1000000000) + (now.tv_nsec - before.tv_nsec)) / 1000000);
+
+		// Keep the part below a millisecond for the next frame, so frames faster than 1ms still animate
+		before.tv_nsec += (dt % 1000) * 1000000;
+		before.tv_sec += (dt / 1000) + (before.tv_nsec / 1000000000);
+		before.tv_nsec %= 1000000000;
 
 #if (CONFIG_UI_MAXIMUM_FPS > 0)
 		if (dt < ms_per_frame) {
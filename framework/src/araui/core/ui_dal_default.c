@@ -59,6 +59,16 @@ UI_DAL ui_rect_t ui_dal_get_viewport(void)
 	return (ui_rect_t){ 0, 0, 0, 0 };
 }
 
+#if defined(CONFIG_UI_SPAN_RENDERER)
+
+UI_DAL void ui_dal_blit_rgba8888(int32_t x, int32_t y, int32_t width, int32_t height,
+    const uint8_t *buf, int32_t stride)
+{
+
+}
+
+#endif // CONFIG_UI_SPAN_RENDERER
+
 #if defined(CONFIG_UI_ENABLE_TOUCH)
 
 UI_DAL bool ui_dal_get_touch(bool *pressed, ui_coord_t *coord)
@@ -0,0 +1,581 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+#if defined(UI_PLATFORM_LINUX)
+#define _GNU_SOURCE
+#endif
+
+#include <tinyara/config.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <tinyara/board.h>
+#include <tinyara/lcd/lcd.h>
+
+//!< AraUI Public
+#include <araui/ui_commons.h>
+
+//!< AraUI Internal
+#include "ui_debug.h"
+#include "ui_commons_internal.h"
+#include "dal/ui_dal.h"
+
+/****************************************************************************
+ * Macros
+ ****************************************************************************/
+#if defined(CONFIG_UI_DISPLAY_RGB565)
+#define FB_BPP          (2)
+#else
+#define FB_BPP          (3)
+#endif
+#define FB_STRIDE       (CONFIG_UI_DISPLAY_WIDTH * FB_BPP)
+#define FB_SIZE         (FB_STRIDE * CONFIG_UI_DISPLAY_HEIGHT)
+
+#if defined(CONFIG_UI_DAL_LCD_DOUBLE_BUFFER) || defined(CONFIG_UI_DAL_LCD_PARTIAL_BUFFER)
+#define UI_DAL_LCD_TRANSFER_THREAD
+#define UI_DAL_LCD_THREAD_NAME "UI LCD Transfer"
+#define UI_DAL_LCD_QUEUE_SIZE  (16)
+#endif
+
+#if defined(CONFIG_UI_DAL_LCD_DOUBLE_BUFFER)
+#define UI_DAL_LCD_FRAME_RECTS (16)
+#endif
+
+#if defined(CONFIG_UI_DAL_LCD_PARTIAL_BUFFER)
+// Rows of a transfer buffer, kept within 1 and the display height
+#if CONFIG_UI_DAL_LCD_PARTIAL_ROWS < 1
+#define STAGE_ROWS      (1)
+#elif CONFIG_UI_DAL_LCD_PARTIAL_ROWS > CONFIG_UI_DISPLAY_HEIGHT
+#define STAGE_ROWS      (CONFIG_UI_DISPLAY_HEIGHT)
+#else
+#define STAGE_ROWS      (CONFIG_UI_DAL_LCD_PARTIAL_ROWS)
+#endif
+#define STAGE_SIZE      (FB_STRIDE * STAGE_ROWS)
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* A region of a framebuffer or of a transfer buffer to send to the LCD */
+typedef struct {
+	const uint8_t *buf;		//!< First pixel of the region
+	int32_t stride;			//!< Bytes from the start of a row to the next one
+	int32_t x;
+	int32_t y;
+	int32_t width;
+	int32_t height;
+	bool vsync;			//!< First region of a frame
+} ui_dal_lcd_job_t;
+
+/****************************************************************************
+ * Private Variables
+ ****************************************************************************/
+static struct lcd_dev_s        *g_lcd;
+static struct lcd_planeinfo_s   g_pinfo;
+static uint8_t                 *g_fb[2];
+static uint8_t                 *g_back;
+static ui_rect_t                g_viewport = {0, };
+static bool                     g_frame_start;
+
+#if defined(UI_DAL_LCD_TRANSFER_THREAD)
+static pthread_t                g_thread;
+static pthread_mutex_t          g_mutex;
+static pthread_cond_t           g_cond;
+static ui_dal_lcd_job_t         g_queue[UI_DAL_LCD_QUEUE_SIZE];
+static uint32_t                 g_submitted;
+static uint32_t                 g_completed;
+static bool                     g_stop;
+#endif
+
+#if defined(CONFIG_UI_DAL_LCD_DOUBLE_BUFFER)
+static int                      g_back_idx;
+static uint32_t                 g_fb_seq[2];
+static ui_rect_t                g_rects[UI_DAL_LCD_FRAME_RECTS];
+static int                      g_rect_count;
+#endif
+
+#if defined(CONFIG_UI_DAL_LCD_PARTIAL_BUFFER)
+static uint8_t                 *g_stage[2];
+static uint32_t                 g_stage_seq[2];
+static int                      g_stage_idx;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+static void _ui_dal_lcd_transfer(const ui_dal_lcd_job_t *job)
+{
+	int32_t i;
+
+#if defined(CONFIG_UI_DAL_LCD_VSYNC)
+	if (job->vsync && g_lcd->waitvsync) {
+		g_lcd->waitvsync(g_lcd);
+	}
+#endif
+
+#if defined(CONFIG_LCD_DMA_SUPPORT)
+	if (g_pinfo.putdma) {
+		if (job->stride == job->width * FB_BPP) {
+			g_pinfo.putdma(job->y, job->x, job->y + job->height - 1, job->x + job->width - 1, job->buf);
+			return;
+		}
+
+		for (i = 0; i < job->height; i++) {
+			g_pinfo.putdma(job->y + i, job->x, job->y + i, job->x + job->width - 1, job->buf + i * job->stride);
+		}
+		return;
+	}
+#endif
+
+	for (i = 0; i < job->height; i++) {
+		g_pinfo.putrun(job->y + i, job->x, job->buf + i * job->stride, job->width);
+	}
+}
+
+#if defined(UI_DAL_LCD_TRANSFER_THREAD)
+
+/*
+ * The jobs are sent in the order of submission. A job is numbered by
+ * g_submitted after it is queued, and it is done when g_completed reaches
+ * the number, so its buffer can be written again.
+ */
+static void *_ui_dal_lcd_thread_loop(void *param)
+{
+	ui_dal_lcd_job_t job;
+
+	pthread_mutex_lock(&g_mutex);
+	while (true) {
+		while (!g_stop && g_completed == g_submitted) {
+			pthread_cond_wait(&g_cond, &g_mutex);
+		}
+
+		if (g_completed == g_submitted) {
+			break;
+		}
+
+		job = g_queue[g_completed % UI_DAL_LCD_QUEUE_SIZE];
+		pthread_mutex_unlock(&g_mutex);
+
+		_ui_dal_lcd_transfer(&job);
+
+		pthread_mutex_lock(&g_mutex);
+		g_completed++;
+		pthread_cond_broadcast(&g_cond);
+	}
+	pthread_mutex_unlock(&g_mutex);
+
+	return NULL;
+}
+
+static uint32_t _ui_dal_lcd_submit(const uint8_t *buf, int32_t stride, int32_t x, int32_t y, int32_t width, int32_t height)
+{
+	ui_dal_lcd_job_t *job;
+	uint32_t seq;
+
+	pthread_mutex_lock(&g_mutex);
+	while (g_submitted - g_completed >= UI_DAL_LCD_QUEUE_SIZE) {
+		pthread_cond_wait(&g_cond, &g_mutex);
+	}
+
+	job = &g_queue[g_submitted % UI_DAL_LCD_QUEUE_SIZE];
+	job->buf = buf;
+	job->stride = stride;
+	job->x = x;
+	job->y = y;
+	job->width = width;
+	job->height = height;
+	job->vsync = g_frame_start;
+	g_frame_start = false;
+
+	seq = ++g_submitted;
+	pthread_cond_broadcast(&g_cond);
+	pthread_mutex_unlock(&g_mutex);
+
+	return seq;
+}
+
+static void _ui_dal_lcd_wait(uint32_t seq)
+{
+	pthread_mutex_lock(&g_mutex);
+	while ((int32_t)(g_completed - seq) < 0) {
+		pthread_cond_wait(&g_cond, &g_mutex);
+	}
+	pthread_mutex_unlock(&g_mutex);
+}
+
+static ui_error_t _ui_dal_lcd_thread_start(void)
+{
+	pthread_attr_t attr;
+
+	g_submitted = 0;
+	g_completed = 0;
+	g_stop = false;
+
+	if (pthread_mutex_init(&g_mutex, NULL)) {
+		return UI_INIT_FAILURE;
+	}
+
+	if (pthread_cond_init(&g_cond, NULL)) {
+		pthread_mutex_destroy(&g_mutex);
+		return UI_INIT_FAILURE;
+	}
+
+	if (pthread_attr_init(&attr)) {
+		pthread_cond_destroy(&g_cond);
+		pthread_mutex_destroy(&g_mutex);
+		return UI_INIT_FAILURE;
+	}
+
+#if defined(UI_PLATFORM_TIZENRT)
+	attr.stacksize = CONFIG_UI_DAL_LCD_STACK_SIZE;
+#endif
+
+	if (pthread_create(&g_thread, &attr, _ui_dal_lcd_thread_loop, NULL)) {
+		pthread_cond_destroy(&g_cond);
+		pthread_mutex_destroy(&g_mutex);
+		return UI_INIT_FAILURE;
+	}
+
+#if !defined(UI_PLATFORM_DARWIN)
+	if (pthread_setname_np(g_thread, UI_DAL_LCD_THREAD_NAME)) {
+		UI_LOGE("error: failed to set pthread name!\n");
+	}
+#endif
+
+	return UI_OK;
+}
+
+static void _ui_dal_lcd_thread_stop(void)
+{
+	pthread_mutex_lock(&g_mutex);
+	g_stop = true;
+	pthread_cond_broadcast(&g_cond);
+	pthread_mutex_unlock(&g_mutex);
+
+	pthread_join(g_thread, NULL);
+
+	pthread_cond_destroy(&g_cond);
+	pthread_mutex_destroy(&g_mutex);
+}
+
+#endif // UI_DAL_LCD_TRANSFER_THREAD
+
+#if defined(CONFIG_UI_DAL_LCD_DOUBLE_BUFFER)
+
+/*
+ * Hand the redrawn regions of the back buffer to the transfer thread, and
+ * render the next frame into the other framebuffer. It is written again
+ * after the transfers of the frame before.
+ */
+static void _ui_dal_lcd_present(void)
+{
+	int32_t offset;
+	int i;
+
+	for (i = 0; i < g_rect_count; i++) {
+		offset = g_rects[i].y * FB_STRIDE + g_rects[i].x * FB_BPP;
+		g_fb_seq[g_back_idx] = _ui_dal_lcd_submit(g_back + offset, FB_STRIDE,
+			g_rects[i].x, g_rects[i].y, g_rects[i].width, g_rects[i].height);
+	}
+	g_rect_count = 0;
+
+	g_back_idx ^= 1;
+	g_back = g_fb[g_back_idx];
+	_ui_dal_lcd_wait(g_fb_seq[g_back_idx]);
+}
+
+#endif // CONFIG_UI_DAL_LCD_DOUBLE_BUFFER
+
+#if defined(CONFIG_UI_DISPLAY_RGB565)
+
+static inline void _ui_dal_lcd_blend(uint8_t *dst, uint32_t r, uint32_t g, uint32_t b, uint32_t a)
+{
+	uint16_t *p = (uint16_t *)dst;
+	uint32_t br;
+	uint32_t bg;
+	uint32_t bb;
+
+	if (a != 255) {
+		br = (*p >> 8) & 0xf8;
+		bg = (*p >> 3) & 0xfc;
+		bb = (*p << 3) & 0xf8;
+		r = ((r * a) + (br * (255 - a))) / 255;
+		g = ((g * a) + (bg * (255 - a))) / 255;
+		b = ((b * a) + (bb * (255 - a))) / 255;
+	}
+
+	*p = (uint16_t)(((r & 0xf8) << 8) | ((g & 0xfc) << 3) | (b >> 3));
+}
+
+#else
+
+static inline void _ui_dal_lcd_blend(uint8_t *dst, uint32_t r, uint32_t g, uint32_t b, uint32_t a)
+{
+	if (a == 255) {
+		dst[0] = r;
+		dst[1] = g;
+		dst[2] = b;
+	} else {
+		dst[0] = ((r * a) + (dst[0] * (255 - a))) / 255;
+		dst[1] = ((g * a) + (dst[1] * (255 - a))) / 255;
+		dst[2] = ((b * a) + (dst[2] * (255 - a))) / 255;
+	}
+}
+
+#endif
+
+/****************************************************************************
+ * DAL Interface Implementation
+ ****************************************************************************/
+UI_DAL ui_error_t ui_dal_init(void)
+{
+	struct fb_videoinfo_s vinfo;
+
+	g_lcd = board_lcd_getdev(CONFIG_UI_DAL_LCD_DEVNO);
+	if (!g_lcd) {
+		if (board_lcd_initialize() < 0) {
+			UI_LOGE("error: cannot initialize the lcd!\n");
+			return UI_INIT_FAILURE;
+		}
+		g_lcd = board_lcd_getdev(CONFIG_UI_DAL_LCD_DEVNO);
+	}
+
+	if (!g_lcd || g_lcd->getvideoinfo(g_lcd, &vinfo) < 0 || g_lcd->getplaneinfo(g_lcd, 0, &g_pinfo) < 0) {
+		UI_LOGE("error: cannot get the lcd information!\n");
+		return UI_INIT_FAILURE;
+	}
+
+	if (vinfo.xres != CONFIG_UI_DISPLAY_WIDTH || vinfo.yres != CONFIG_UI_DISPLAY_HEIGHT || g_pinfo.bpp != FB_BPP * 8) {
+		UI_LOGE("error: the lcd is %dx%d %dbpp, not the display of the UI!\n", vinfo.xres, vinfo.yres, g_pinfo.bpp);
+		return UI_INIT_FAILURE;
+	}
+
+	g_fb[0] = (uint8_t *)UI_ALLOC(FB_SIZE);
+	if (!g_fb[0]) {
+		UI_LOGE("error: cannot alloc the framebuffer!\n");
+		return UI_INIT_FAILURE;
+	}
+	memset(g_fb[0], 0, FB_SIZE);
+	g_back = g_fb[0];
+
+#if defined(CONFIG_UI_DAL_LCD_DOUBLE_BUFFER)
+	g_fb[1] = (uint8_t *)UI_ALLOC(FB_SIZE);
+	if (!g_fb[1]) {
+		UI_LOGE("error: cannot alloc the framebuffer!\n");
+		UI_FREE(g_fb[0]);
+		return UI_INIT_FAILURE;
+	}
+	memset(g_fb[1], 0, FB_SIZE);
+	g_back_idx = 0;
+	g_fb_seq[0] = 0;
+	g_fb_seq[1] = 0;
+	g_rect_count = 0;
+#endif
+
+#if defined(CONFIG_UI_DAL_LCD_PARTIAL_BUFFER)
+	g_stage[0] = (uint8_t *)UI_ALLOC(STAGE_SIZE * 2);
+	if (!g_stage[0]) {
+		UI_LOGE("error: cannot alloc the transfer buffer!\n");
+		UI_FREE(g_fb[0]);
+		return UI_INIT_FAILURE;
+	}
+	g_stage[1] = g_stage[0] + STAGE_SIZE;
+	g_stage_seq[0] = 0;
+	g_stage_seq[1] = 0;
+	g_stage_idx = 0;
+#endif
+
+#if defined(UI_DAL_LCD_TRANSFER_THREAD)
+	if (_ui_dal_lcd_thread_start() != UI_OK) {
+		UI_LOGE("error: cannot create the transfer thread!\n");
+		UI_FREE(g_fb[0]);
+#if defined(CONFIG_UI_DAL_LCD_DOUBLE_BUFFER)
+		UI_FREE(g_fb[1]);
+#else
+		UI_FREE(g_stage[0]);
+#endif
+		return UI_INIT_FAILURE;
+	}
+#endif
+
+	g_frame_start = true;
+	g_lcd->setpower(g_lcd, LCD_FULL_ON);
+
+	return UI_OK;
+}
+
+UI_DAL ui_error_t ui_dal_deinit(void)
+{
+#if defined(CONFIG_UI_DAL_LCD_DOUBLE_BUFFER)
+	_ui_dal_lcd_present();
+#endif
+
+#if defined(UI_DAL_LCD_TRANSFER_THREAD)
+	_ui_dal_lcd_thread_stop();
+#endif
+
+	UI_FREE(g_fb[0]);
+#if defined(CONFIG_UI_DAL_LCD_DOUBLE_BUFFER)
+	UI_FREE(g_fb[1]);
+#endif
+#if defined(CONFIG_UI_DAL_LCD_PARTIAL_BUFFER)
+	UI_FREE(g_stage[0]);
+#endif
+
+	g_lcd->setpower(g_lcd, LCD_FULL_OFF);
+	g_lcd = NULL;
+
+	return UI_OK;
+}
+
+UI_DAL void ui_dal_redraw(int32_t x, int32_t y, int32_t width, int32_t height)
+{
+#if defined(CONFIG_UI_DAL_LCD_DOUBLE_BUFFER)
+	ui_rect_t *last;
+	int32_t x2;
+	int32_t y2;
+#elif defined(CONFIG_UI_DAL_LCD_PARTIAL_BUFFER)
+	int32_t rows;
+	int32_t i;
+#else
+	ui_dal_lcd_job_t job;
+#endif
+
+	if (width <= 0 || height <= 0) {
+		return;
+	}
+
+#if defined(CONFIG_UI_DAL_LCD_DOUBLE_BUFFER)
+	// Sent at the start of the next frame, too many regions are merged into the last one
+	if (g_rect_count < UI_DAL_LCD_FRAME_RECTS) {
+		g_rects[g_rect_count].x = x;
+		g_rects[g_rect_count].y = y;
+		g_rects[g_rect_count].width = width;
+		g_rects[g_rect_count].height = height;
+		g_rect_count++;
+	} else {
+		last = &g_rects[UI_DAL_LCD_FRAME_RECTS - 1];
+		x2 = UI_MAX(last->x + last->width, x + width);
+		y2 = UI_MAX(last->y + last->height, y + height);
+		last->x = UI_MIN(last->x, x);
+		last->y = UI_MIN(last->y, y);
+		last->width = x2 - last->x;
+		last->height = y2 - last->y;
+	}
+#elif defined(CONFIG_UI_DAL_LCD_PARTIAL_BUFFER)
+	// Copied to the transfer buffers in turn, while the other one is being sent
+	while (height > 0) {
+		rows = UI_MIN(height, STAGE_ROWS);
+		_ui_dal_lcd_wait(g_stage_seq[g_stage_idx]);
+
+		for (i = 0; i < rows; i++) {
+			memcpy(g_stage[g_stage_idx] + i * width * FB_BPP, g_back + (y + i) * FB_STRIDE + x * FB_BPP, width * FB_BPP);
+		}
+		g_stage_seq[g_stage_idx] = _ui_dal_lcd_submit(g_stage[g_stage_idx], width * FB_BPP, x, y, width, rows);
+		g_stage_idx ^= 1;
+
+		y += rows;
+		height -= rows;
+	}
+#else
+	job.buf = g_back + y * FB_STRIDE + x * FB_BPP;
+	job.stride = FB_STRIDE;
+	job.x = x;
+	job.y = y;
+	job.width = width;
+	job.height = height;
+	job.vsync = g_frame_start;
+	g_frame_start = false;
+
+	_ui_dal_lcd_transfer(&job);
+#endif
+}
+
+/* Called at the start of each frame of the UI loop */
+UI_DAL void ui_dal_clear(void)
+{
+#if defined(CONFIG_UI_DAL_LCD_DOUBLE_BUFFER)
+	if (g_rect_count) {
+		_ui_dal_lcd_present();
+	}
+#endif
+
+	g_frame_start = true;
+	memset(g_back, 0, FB_SIZE);
+}
+
+UI_DAL void ui_dal_put_pixel_rgba8888(int32_t x, int32_t y, ui_color_t color)
+{
+	ui_color_rgba8888_t *fg;
+
+	if (x < 0 || x >= CONFIG_UI_DISPLAY_WIDTH || y < 0 || y >= CONFIG_UI_DISPLAY_HEIGHT) {
+		return;
+	}
+
+	fg = (ui_color_rgba8888_t *)&color;
+	_ui_dal_lcd_blend(&g_back[y * FB_STRIDE + x * FB_BPP], fg->r, fg->g, fg->b, fg->a);
+}
+
+UI_DAL void ui_dal_put_pixel_rgb888(int32_t x, int32_t y, ui_color_t color)
+{
+	ui_color_rgb888_t *fg;
+
+	if (x < 0 || x >= CONFIG_UI_DISPLAY_WIDTH || y < 0 || y >= CONFIG_UI_DISPLAY_HEIGHT) {
+		return;
+	}
+
+	fg = (ui_color_rgb888_t *)&color;
+	_ui_dal_lcd_blend(&g_back[y * FB_STRIDE + x * FB_BPP], fg->r, fg->g, fg->b, 255);
+}
+
+#if defined(CONFIG_UI_SPAN_RENDERER)
+UI_DAL void ui_dal_blit_rgba8888(int32_t x, int32_t y, int32_t width, int32_t height,
+	const uint8_t *buf, int32_t stride)
+{
+	const uint8_t *fg;
+	uint8_t *bg;
+	int i;
+	int j;
+
+	for (i = 0; i < height; i++) {
+		fg = buf + i * stride;
+		bg = &g_back[(y + i) * FB_STRIDE + x * FB_BPP];
+		for (j = 0; j < width; j++, fg += 4, bg += FB_BPP) {
+			if (fg[3] != 0) {
+				_ui_dal_lcd_blend(bg, fg[0], fg[1], fg[2], fg[3]);
+			}
+		}
+	}
+}
+#endif
+
+UI_DAL ui_error_t ui_dal_set_viewport(int32_t x, int32_t y, int32_t width, int32_t height)
+{
+	g_viewport.x = x;
+	g_viewport.y = y;
+	g_viewport.width = width;
+	g_viewport.height = height;
+
+	return UI_OK;
+}
+
+UI_DAL ui_rect_t ui_dal_get_viewport(void)
+{
+	return g_viewport;
+}
@@ -40,6 +40,7 @@ static void _ui_window_create_func(void *userdata);
 static void _ui_window_destroy_func(void *userdata);
 #if defined(CONFIG_UI_PARTIAL_UPDATE)
 static ui_rect_t *_ui_window_get_mempool_rect(void);
+static bool _ui_window_redraw_rect_mergeable(ui_rect_t *r1, ui_rect_t *r2);
 #endif
 
 ui_error_t ui_window_list_init(void)
@@ -258,8 +259,7 @@ ui_error_t ui_window_add_redraw_list(ui_rect_t redraw_rect)
 {
 	ui_rect_t *window;
 	ui_rect_t *new_area;
-	ui_rect_t previous;
-	ui_rect_t ret;
+	bool merged;
 	int iter;
 
 	if (redraw_rect.x < 0) {
@@ -294,33 +294,27 @@ ui_error_t ui_window_add_redraw_list(ui_rect_t redraw_rect)
 		new_area->height = CONFIG_UI_DISPLAY_HEIGHT - new_area->y;
 	}
 
-	vec_foreach(&g_window_redraw_list, window, iter) {
-		// window is whole screen case
-		if ((window->x == 0) && (window->y == 0) &&
-			(window->width == CONFIG_UI_DISPLAY_WIDTH) &&
-			(window->height == CONFIG_UI_DISPLAY_HEIGHT)) {
-			return UI_OK;
+	// The merged area may reach the rects which were passed, so merge until nothing changes
+	do {
+		merged = false;
+		vec_foreach(&g_window_redraw_list, window, iter) {
+			// window is whole screen case
+			if ((window->x == 0) && (window->y == 0) &&
+				(window->width == CONFIG_UI_DISPLAY_WIDTH) &&
+				(window->height == CONFIG_UI_DISPLAY_HEIGHT)) {
+				return UI_OK;
+			}
+
+			if (!_ui_window_redraw_rect_mergeable(window, new_area)) {
+				continue;
+			}
+
+			*new_area = ui_get_contain_rect(*window, *new_area);
+			vec_splice(&g_window_redraw_list, iter, 1);
+			iter--;
+			merged = true;
 		}
-
-		previous.x = window->x;
-		previous.y = window->y;
-		previous.width = window->width;
-		previous.height = window->height;
-
-		ret = ui_rect_intersect(previous, *new_area);
-		if (ret.x == 0 && ret.y == 0 && ret.width == 0 && ret.height == 0) {
-			continue;
-		}
-
-		ret = ui_get_contain_rect(previous, *new_area);
-		new_area->x = ret.x;
-		new_area->y = ret.y;
-		new_area->width = ret.width;
-		new_area->height = ret.height;
-
-		vec_remove(&g_window_redraw_list, window);
-		iter--;
-	}
+	} while (merged);
 
 	vec_push(&g_window_redraw_list, new_area);
 
@@ -345,6 +339,25 @@ static ui_rect_t *_ui_window_get_mempool_rect(void)
 
 	return &g_rect_mempool[alloc_idx];
 }
+
+/**
+ * @brief Rects are merged when they overlap or touch, or when the rect containing
+ * both is not larger than them. Each rect of the list walks the widget tree and
+ * is sent to the DAL, so less rects are cheaper even if a few pixels more are drawn.
+ */
+static bool _ui_window_redraw_rect_mergeable(ui_rect_t *r1, ui_rect_t *r2)
+{
+	ui_rect_t contain;
+
+	if (r1->x <= r2->x + r2->width && r2->x <= r1->x + r1->width &&
+		r1->y <= r2->y + r2->height && r2->y <= r1->y + r1->height) {
+		return true;
+	}
+
+	contain = ui_get_contain_rect(*r1, *r2);
+
+	return contain.width * contain.height <= r1->width * r1->height + r2->width * r2->height;
+}
 #endif // CONFIG_UI_PARTIAL_UPDATE
 
 ui_window_body_t *ui_window_get_current(void)
@@ -121,6 +121,28 @@ UI_DAL ui_error_t ui_dal_set_viewport(int32_t x, int32_t y, int32_t width, int32
  */
 UI_DAL ui_rect_t ui_dal_get_viewport(void);
 
+#if defined(CONFIG_UI_SPAN_RENDERER)
+
+/**
+ * @brief ui_dal_blit_rgba8888()
+ *
+ * Put a rectangular region of RGBA8888 pixels to (x, y) coordinate.
+ * The pixels are blended like ui_dal_put_pixel_rgba8888() does.
+ * The region is inside of the viewport, so it does not need to be clipped.
+ *
+ * @param[in] x x coordinate of the region
+ * @param[in] y y coordinate of the region
+ * @param[in] width Width of the region
+ * @param[in] height Height of the region
+ * @param[in] buf Pixels of the region, 4 bytes per pixel in r, g, b, a order
+ * @param[in] stride Bytes from the start of a row of buf to the next one
+ *
+ */
+UI_DAL void ui_dal_blit_rgba8888(int32_t x, int32_t y, int32_t width, int32_t height,
+    const uint8_t *buf, int32_t stride);
+
+#endif // CONFIG_UI_SPAN_RENDERER
+
 #if defined(CONFIG_UI_ENABLE_TOUCH)
 
 /**
@@ -60,6 +60,9 @@ typedef struct {
 	bool from_buf;
 	stbtt_fontinfo ttf_info;
 	uint8_t *ttf_buf;
+#if defined(CONFIG_UI_GLYPH_ATLAS)
+	const uint8_t *atlas;
+#endif
 } ui_font_asset_body_t;
 
 #ifdef __cplusplus
@@ -0,0 +1,80 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __GLYPH_CACHE_H__
+#define __GLYPH_CACHE_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include <araui/ui_commons.h>
+#include "ui_asset_internal.h"
+
+#define UI_GLYPH_ATLAS_MAGIC (0x534c4741) // "AGLS"
+
+/**
+ * @brief Rasterized glyph. A8 for the font glyphs, RGBA8888 for the emoji of an atlas.
+ */
+typedef struct {
+	int16_t offset_y;		//!< Top of the bitmap from the baseline
+	uint16_t width;
+	uint16_t height;
+	uint16_t pf;			//!< ui_pixel_format_t
+	const uint8_t *bitmap;
+} ui_glyph_t;
+
+/**
+ * @brief Header of the glyph atlas generated by tools/araui/font2c.
+ * The entries follow the header in the order of utf_code, and the offset of
+ * each bitmap is from the start of the atlas.
+ */
+typedef struct {
+	uint32_t magic;
+	uint32_t font_size;
+	uint32_t glyph_count;
+	uint32_t header_size;	//!< Size of the header and the entries
+} ui_glyph_atlas_t;
+
+typedef struct {
+	uint32_t utf_code;
+	int16_t offset_y;
+	uint16_t width;
+	uint16_t height;
+	uint16_t pf;
+	uint32_t offset;
+} ui_glyph_atlas_entry_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Get the glyph of utf_code from the atlas of the font or the cache.
+ * A glyph which is not cached is rasterized and the least recently used glyphs
+ * are dropped to keep the cache in CONFIG_UI_GLYPH_CACHE_SIZE bytes.
+ * The glyph is valid until the next call. Emoji are only found in the atlas.
+ */
+const ui_glyph_t *glyph_cache_get(ui_font_asset_body_t *font, size_t font_size, uint32_t utf_code);
+
+void glyph_cache_remove_font(ui_font_asset_body_t *font);
+void glyph_cache_clear(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __GLYPH_CACHE_H__
@@ -19,6 +19,7 @@
 #include <tinyara/config.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 #include <float.h>
 #include <math.h>
 #include <vec/vec.h>
@@ -40,10 +41,21 @@
 
 #define CONFIG_UI_DEFAULT_FILL_COLOR 0x000000
 
+#if defined(CONFIG_UI_SPAN_RENDERER)
+#define UI_FIXED_SHIFT (16)
+#define UI_FIXED_ONE (1 << UI_FIXED_SHIFT)
+#define UI_SPAN_BUF_SIZE (CONFIG_UI_DISPLAY_WIDTH * CONFIG_UI_SPAN_TILE_HEIGHT)
+#endif
+
 /****************************************************************************
  * Private function declaration
  ****************************************************************************/
 static void ui_draw_triangle_segment(int32_t y1, int32_t y2);
+#if defined(CONFIG_UI_SPAN_RENDERER)
+static bool ui_span_prepare(void);
+static void ui_draw_rect(float x1, float y1, float x2, float y2, ui_uv_t uv1, ui_uv_t uv2);
+static void ui_fetch_span(ui_color_t *dst, int32_t count, int32_t u, int32_t v, int32_t du, int32_t dv);
+#endif
 
 /****************************************************************************
  * Private types
@@ -82,6 +94,28 @@ float g_pk_dudx_;
 float g_pk_dvdx_;
 float g_pk_dzdx_;
 
+#if defined(CONFIG_UI_SPAN_RENDERER)
+//!< Spans of pixels which are passed to the DAL
+static ui_color_t g_span_buf[UI_SPAN_BUF_SIZE];
+
+//!< Viewport of the DAL in the display, [x1, x2) and [y1, y2)
+static int32_t g_clip_x1;
+static int32_t g_clip_y1;
+static int32_t g_clip_x2;
+static int32_t g_clip_y2;
+
+//!< Texel steps per pixel, and offsets to the pixel center, in fixed point
+static int32_t g_span_du;
+static int32_t g_span_dv;
+static int32_t g_span_cu;
+static int32_t g_span_cv;
+
+static inline int32_t ui_fixed(float value)
+{
+	return (int32_t)(value >= 0.0f ? value + 0.5f : value - 0.5f);
+}
+#endif
+
 /****************************************************************************
  * Public function implementation
  ****************************************************************************/
@@ -220,6 +254,14 @@ void ui_render_triangle_uv(ui_mat3_t *trans_mat,
 	float dZdY_V2V3;
 	float dZdY_V1V2;
 	float denom;
+#if defined(CONFIG_UI_SPAN_RENDERER)
+	float dudy;
+	float dvdy;
+
+	if (!ui_span_prepare()) {
+		return;
+	}
+#endif
 
 	v1 = ui_mat3_vec3_multiply(trans_mat, &v1);
 	v2 = ui_mat3_vec3_multiply(trans_mat, &v2);
@@ -288,6 +330,16 @@ void ui_render_triangle_uv(ui_mat3_t *trans_mat,
 	g_pk_dvdx_ = g_pk_dvdx * UI_SUB_DIVIDE_SIZE;
 	g_pk_dzdx_ = g_pk_dzdx * UI_SUB_DIVIDE_SIZE;
 
+#if defined(CONFIG_UI_SPAN_RENDERER)
+	dudy = ((u_b - u_a) * (v3.x - v1.x) - (u_c - u_a) * (v2.x - v1.x)) * denom;
+	dvdy = ((v_b - v_a) * (v3.x - v1.x) - (v_c - v_a) * (v2.x - v1.x)) * denom;
+
+	g_span_du = ui_fixed(g_pk_dudx * g_rc.tex_width * UI_FIXED_ONE);
+	g_span_dv = ui_fixed(g_pk_dvdx * g_rc.tex_height * UI_FIXED_ONE);
+	g_span_cu = ui_fixed((g_pk_dudx + dudy) * 0.5f * g_rc.tex_width * UI_FIXED_ONE);
+	g_span_cv = ui_fixed((g_pk_dvdx + dvdy) * 0.5f * g_rc.tex_height * UI_FIXED_ONE);
+#endif
+
 	bool mid = dXdY_V1V3 < dXdY_V1V2;
 	if (!mid) {
 		prestep = UI_SUB_PIX(v1.y);
@@ -395,6 +447,32 @@ void ui_render_quad_uv(ui_mat3_t *trans_mat,
 	ui_vec3_t v1, ui_vec3_t v2, ui_vec3_t v3, ui_vec3_t v4,
 	ui_uv_t uv1, ui_uv_t uv2, ui_uv_t uv3, ui_uv_t uv4)
 {
+#if defined(CONFIG_UI_SPAN_RENDERER)
+	ui_vec3_t p1;
+	ui_vec3_t p2;
+	ui_vec3_t p3;
+	ui_vec3_t p4;
+
+	// Neither rotated nor skewed, the quad may be a rectangle of the texture
+	if (trans_mat->m[0][1] == 0.0f && trans_mat->m[1][0] == 0.0f &&
+		trans_mat->m[2][0] == 0.0f && trans_mat->m[2][1] == 0.0f && trans_mat->m[2][2] == 1.0f) {
+		p1 = ui_mat3_vec3_multiply(trans_mat, &v1);
+		p2 = ui_mat3_vec3_multiply(trans_mat, &v2);
+		p3 = ui_mat3_vec3_multiply(trans_mat, &v3);
+		p4 = ui_mat3_vec3_multiply(trans_mat, &v4);
+
+		if ((p1.x == p2.x && p3.x == p4.x && p2.y == p3.y && p4.y == p1.y &&
+			uv1.u == uv2.u && uv3.u == uv4.u && uv2.v == uv3.v && uv4.v == uv1.v) ||
+			(p1.y == p2.y && p3.y == p4.y && p2.x == p3.x && p4.x == p1.x &&
+			uv1.v == uv2.v && uv3.v == uv4.v && uv2.u == uv3.u && uv4.u == uv1.u)) {
+			if (ui_span_prepare()) {
+				ui_draw_rect(p1.x, p1.y, p3.x, p3.y, uv1, uv3);
+			}
+			return;
+		}
+	}
+#endif
+
 	ui_render_triangle_uv(trans_mat, v1, v2, v3, uv1, uv2, uv3);
 	ui_render_triangle_uv(trans_mat, v1, v3, v4, uv1, uv3, uv4);
 }
@@ -402,6 +480,255 @@ void ui_render_quad_uv(ui_mat3_t *trans_mat,
 /****************************************************************************
  * Private function implementation
  ****************************************************************************/
+#if defined(CONFIG_UI_SPAN_RENDERER)
+
+/**
+ * @brief Clip to the viewport of the DAL.
+ *
+ * @return false if there is nothing to draw.
+ */
+static bool ui_span_prepare(void)
+{
+	ui_rect_t vp;
+
+	if (!g_rc.texture) {
+		return false;
+	}
+
+	vp = ui_dal_get_viewport();
+	g_clip_x1 = UI_MAX(vp.x, 0);
+	g_clip_y1 = UI_MAX(vp.y, 0);
+	g_clip_x2 = UI_MIN(vp.x + vp.width, CONFIG_UI_DISPLAY_WIDTH);
+	g_clip_y2 = UI_MIN(vp.y + vp.height, CONFIG_UI_DISPLAY_HEIGHT);
+
+	return g_clip_x1 < g_clip_x2 && g_clip_y1 < g_clip_y2;
+}
+
+/**
+ * @brief Keep count steps of a linear texture coordinate inside of [0, max].
+ *
+ * All steps are inside if both ends are. They are only off by a rounding
+ * error at the edges of the texture.
+ */
+static void ui_clamp_coord(int32_t *start, int32_t *step, int32_t count, int32_t max)
+{
+	int32_t end = *start + *step * (count - 1);
+
+	if (*start >= 0 && *start <= max && end >= 0 && end <= max) {
+		return;
+	}
+
+	*start = UI_MIN(UI_MAX(*start, 0), max);
+	end = UI_MIN(UI_MAX(end, 0), max);
+	*step = (count > 1) ? (end - *start) / (count - 1) : 0;
+}
+
+static void ui_fetch_span(ui_color_t *dst, int32_t count, int32_t u, int32_t v, int32_t du, int32_t dv)
+{
+	const uint8_t *texel;
+	ui_color_t fill;
+
+	ui_clamp_coord(&u, &du, count, (g_rc.tex_width << UI_FIXED_SHIFT) - 1);
+	ui_clamp_coord(&v, &dv, count, (g_rc.tex_height << UI_FIXED_SHIFT) - 1);
+
+	switch (g_rc.tex_pf) {
+	case UI_PIXEL_FORMAT_RGBA8888:
+		while (count--) {
+			texel = &g_rc.texture[(((v >> UI_FIXED_SHIFT) * g_rc.tex_width) + (u >> UI_FIXED_SHIFT)) * 4];
+			*dst++ = UI_COLOR_RGBA8888(texel[0], texel[1], texel[2], texel[3]);
+			u += du;
+			v += dv;
+		}
+		break;
+	case UI_PIXEL_FORMAT_RGB888:
+		while (count--) {
+			texel = &g_rc.texture[(((v >> UI_FIXED_SHIFT) * g_rc.tex_width) + (u >> UI_FIXED_SHIFT)) * 3];
+			*dst++ = UI_COLOR_RGBA8888(texel[0], texel[1], texel[2], 0xff);
+			u += du;
+			v += dv;
+		}
+		break;
+	case UI_PIXEL_FORMAT_A8:
+		fill = UI_COLOR_RGBA8888(
+			(g_rc.fill_color & 0xff0000) >> 16,
+			(g_rc.fill_color & 0x00ff00) >> 8,
+			(g_rc.fill_color & 0x0000ff) >> 0,
+			0);
+		while (count--) {
+			texel = &g_rc.texture[((v >> UI_FIXED_SHIFT) * g_rc.tex_width) + (u >> UI_FIXED_SHIFT)];
+			*dst++ = fill | ((ui_color_t)texel[0] << 24);
+			u += du;
+			v += dv;
+		}
+		break;
+	default:
+		memset(dst, 0, count * sizeof(ui_color_t));
+		break;
+	}
+}
+
+/**
+ * @brief Draw the rectangle from (x1, y1) to (x2, y2), textured from uv1 to uv2.
+ *
+ * The rows are fetched into the span buffer, and blitted a band at once.
+ * When the texture is scaled up, a row which repeats the previous one is copied.
+ * An unscaled RGBA8888 texture is blitted from the bitmap itself.
+ */
+static void ui_draw_rect(float x1, float y1, float x2, float y2, ui_uv_t uv1, ui_uv_t uv2)
+{
+	float dudx;
+	float dvdy;
+	int32_t left;
+	int32_t top;
+	int32_t right;
+	int32_t bottom;
+	int32_t width;
+	int32_t tile_rows;
+	int32_t rows;
+	int32_t y;
+	int32_t u;
+	int32_t v;
+	int32_t du;
+	int32_t dv;
+	int32_t iv;
+	int32_t prev_iv;
+	ui_color_t *line;
+
+	if (x1 > x2) {
+		UI_SWAP(x1, x2);
+		UI_SWAP(uv1.u, uv2.u);
+	}
+	if (y1 > y2) {
+		UI_SWAP(y1, y2);
+		UI_SWAP(uv1.v, uv2.v);
+	}
+
+	// Same pixels as the triangles of the quad cover
+	left = (int32_t)ceilf(x1);
+	top = (int32_t)ceilf(y1);
+	right = (int32_t)ceilf(x2);
+	bottom = (int32_t)ceilf(y2);
+
+	if (left == right || top == bottom) {
+		return;
+	}
+
+	dudx = (uv2.u - uv1.u) / (x2 - x1);
+	dvdy = (uv2.v - uv1.v) / (y2 - y1);
+
+	left = UI_MAX(left, g_clip_x1);
+	top = UI_MAX(top, g_clip_y1);
+	right = UI_MIN(right, g_clip_x2);
+	bottom = UI_MIN(bottom, g_clip_y2);
+
+	if (left >= right || top >= bottom) {
+		return;
+	}
+
+	width = right - left;
+
+	// Texels at the pixel centers
+	u = ui_fixed((uv1.u + ((left + 0.5f) - x1) * dudx) * g_rc.tex_width * UI_FIXED_ONE);
+	v = ui_fixed((uv1.v + ((top + 0.5f) - y1) * dvdy) * g_rc.tex_height * UI_FIXED_ONE);
+	du = ui_fixed(dudx * g_rc.tex_width * UI_FIXED_ONE);
+	dv = ui_fixed(dvdy * g_rc.tex_height * UI_FIXED_ONE);
+
+	ui_clamp_coord(&v, &dv, bottom - top, (g_rc.tex_height << UI_FIXED_SHIFT) - 1);
+
+	if (g_rc.tex_pf == UI_PIXEL_FORMAT_RGBA8888 && du == UI_FIXED_ONE && dv == UI_FIXED_ONE) {
+		ui_clamp_coord(&u, &du, width, (g_rc.tex_width << UI_FIXED_SHIFT) - 1);
+		if (du == UI_FIXED_ONE) {
+			ui_dal_blit_rgba8888(left, top, width, bottom - top,
+				&g_rc.texture[(((v >> UI_FIXED_SHIFT) * g_rc.tex_width) + (u >> UI_FIXED_SHIFT)) * 4],
+				g_rc.tex_width * 4);
+			return;
+		}
+	}
+
+	tile_rows = UI_SPAN_BUF_SIZE / width;
+	rows = 0;
+	prev_iv = -1;
+
+	for (y = top; y < bottom; y++) {
+		line = &g_span_buf[rows * width];
+		iv = v >> UI_FIXED_SHIFT;
+		if (rows > 0 && iv == prev_iv) {
+			memcpy(line, &g_span_buf[(rows - 1) * width], width * sizeof(ui_color_t));
+		} else {
+			ui_fetch_span(line, width, u, v, du, 0);
+			prev_iv = iv;
+		}
+		v += dv;
+
+		if (++rows == tile_rows || y == bottom - 1) {
+			ui_dal_blit_rgba8888(left, y - rows + 1, width, rows,
+				(const uint8_t *)g_span_buf, width * sizeof(ui_color_t));
+			rows = 0;
+		}
+	}
+}
+
+static void ui_draw_triangle_segment(int32_t y1, int32_t y2)
+{
+	float scale_u;
+	float scale_v;
+	float sub_pix;
+	int32_t x1;
+	int32_t x2;
+	int32_t y;
+	int32_t u;
+	int32_t v;
+
+	// Step the edges over the rows above the viewport
+	if (y1 < g_clip_y1) {
+		y = UI_MIN(y2, g_clip_y1) - y1;
+		g_leftu += g_left_dudy * y;
+		g_leftv += g_left_dvdy * y;
+		g_leftz += g_left_dzdy * y;
+		g_leftx += g_left_dxdy * y;
+		g_rightx += g_right_dxdy * y;
+		y1 += y;
+	}
+	if (y2 > g_clip_y2) {
+		y2 = g_clip_y2;
+	}
+
+	scale_u = (float)g_rc.tex_width * UI_FIXED_ONE;
+	scale_v = (float)g_rc.tex_height * UI_FIXED_ONE;
+
+	for (y = y1; y < y2; y++) {
+		x1 = ceilf(g_leftx);
+		x2 = ceilf(g_rightx);
+
+		sub_pix = UI_SUB_PIX(g_leftx);
+		u = ui_fixed((g_leftu + sub_pix * g_pk_dudx) * scale_u) + g_span_cu;
+		v = ui_fixed((g_leftv + sub_pix * g_pk_dvdx) * scale_v) + g_span_cv;
+
+		if (x1 < g_clip_x1) {
+			u += (g_clip_x1 - x1) * g_span_du;
+			v += (g_clip_x1 - x1) * g_span_dv;
+			x1 = g_clip_x1;
+		}
+		if (x2 > g_clip_x2) {
+			x2 = g_clip_x2;
+		}
+
+		if (x1 < x2) {
+			ui_fetch_span(g_span_buf, x2 - x1, u, v, g_span_du, g_span_dv);
+			ui_dal_blit_rgba8888(x1, y, x2 - x1, 1,
+				(const uint8_t *)g_span_buf, (x2 - x1) * sizeof(ui_color_t));
+		}
+
+		g_leftu += g_left_dudy;
+		g_leftv += g_left_dvdy;
+		g_leftz += g_left_dzdy;
+		g_leftx += g_left_dxdy;
+		g_rightx += g_right_dxdy;
+	}
+}
+
+#else
+
 static void ui_draw_triangle_segment(int32_t y1, int32_t y2)
 {
 	float u;
@@ -554,3 +881,4 @@ static void ui_draw_triangle_segment(int32_t y1, int32_t y2)
 	}
 }
 
+#endif // CONFIG_UI_SPAN_RENDERER
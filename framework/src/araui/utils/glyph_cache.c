@@ -0,0 +1,317 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+#include <tinyara/config.h>
+#include <string.h>
+#include <stdint.h>
+#include <stb/stb_truetype.h>
+#include <araui/ui_commons.h>
+#include "ui_debug.h"
+#include "ui_commons_internal.h"
+#include "ui_asset_internal.h"
+#include "utils/glyph_cache.h"
+
+#if defined(CONFIG_UI_ENABLE_EMOJI)
+#include "utils/emoji.h"
+#endif
+
+#define GLYPH_CACHE_BUCKETS (64)
+
+/*
+ * The bitmap of a glyph is allocated right after its entry. Every entry is
+ * in a hash bucket and in the LRU list, the most recently used one first.
+ */
+typedef struct glyph_entry_s {
+	struct glyph_entry_s *hash_next;
+	struct glyph_entry_s *lru_prev;
+	struct glyph_entry_s *lru_next;
+	ui_font_asset_body_t *font;
+	size_t font_size;
+	uint32_t utf_code;
+	size_t mem_size;
+	ui_glyph_t glyph;
+} glyph_entry_t;
+
+static glyph_entry_t *_glyph_cache_find(ui_font_asset_body_t *font, size_t font_size, uint32_t utf_code, uint32_t hash);
+static glyph_entry_t *_glyph_cache_rasterize(ui_font_asset_body_t *font, size_t font_size, uint32_t utf_code);
+static void _glyph_cache_insert(glyph_entry_t *entry, uint32_t hash);
+static void _glyph_cache_remove(glyph_entry_t *entry);
+static void _glyph_cache_lru_unlink(glyph_entry_t *entry);
+static void _glyph_cache_lru_push(glyph_entry_t *entry);
+
+#if defined(CONFIG_UI_GLYPH_ATLAS)
+static const ui_glyph_t *_glyph_atlas_find(const uint8_t *atlas, size_t font_size, uint32_t utf_code);
+#endif
+
+static glyph_entry_t *g_glyph_bucket[GLYPH_CACHE_BUCKETS];
+static glyph_entry_t *g_glyph_lru_head;
+static glyph_entry_t *g_glyph_lru_tail;
+static size_t g_glyph_cache_used;
+
+//!< A glyph larger than the cache, freed at the next call
+static glyph_entry_t *g_glyph_uncached;
+
+static inline uint32_t _glyph_cache_hash(ui_font_asset_body_t *font, size_t font_size, uint32_t utf_code)
+{
+	return ((uint32_t)((uintptr_t)font >> 4) ^ ((uint32_t)font_size * 31) ^ (utf_code * 2654435761U)) % GLYPH_CACHE_BUCKETS;
+}
+
+const ui_glyph_t *glyph_cache_get(ui_font_asset_body_t *font, size_t font_size, uint32_t utf_code)
+{
+	glyph_entry_t *entry;
+	uint32_t hash;
+
+	if (!font) {
+		return NULL;
+	}
+
+#if defined(CONFIG_UI_GLYPH_ATLAS)
+	if (font->atlas) {
+		const ui_glyph_t *glyph = _glyph_atlas_find(font->atlas, font_size, utf_code);
+		if (glyph) {
+			return glyph;
+		}
+	}
+#endif
+
+#if defined(CONFIG_UI_ENABLE_EMOJI)
+	if (is_emoji(utf_code)) {
+		return NULL;
+	}
+#endif
+
+	if (g_glyph_uncached) {
+		UI_FREE(g_glyph_uncached);
+		g_glyph_uncached = NULL;
+	}
+
+	hash = _glyph_cache_hash(font, font_size, utf_code);
+
+	entry = _glyph_cache_find(font, font_size, utf_code, hash);
+	if (entry) {
+		_glyph_cache_lru_unlink(entry);
+		_glyph_cache_lru_push(entry);
+		return &entry->glyph;
+	}
+
+	entry = _glyph_cache_rasterize(font, font_size, utf_code);
+	if (!entry) {
+		return NULL;
+	}
+
+	if (entry->mem_size > CONFIG_UI_GLYPH_CACHE_SIZE) {
+		g_glyph_uncached = entry;
+		return &entry->glyph;
+	}
+
+	while (g_glyph_cache_used + entry->mem_size > CONFIG_UI_GLYPH_CACHE_SIZE) {
+		_glyph_cache_remove(g_glyph_lru_tail);
+	}
+
+	_glyph_cache_insert(entry, hash);
+
+	return &entry->glyph;
+}
+
+void glyph_cache_remove_font(ui_font_asset_body_t *font)
+{
+	glyph_entry_t *entry;
+	glyph_entry_t *next;
+
+	entry = g_glyph_lru_head;
+	while (entry) {
+		next = entry->lru_next;
+		if (entry->font == font) {
+			_glyph_cache_remove(entry);
+		}
+		entry = next;
+	}
+
+	if (g_glyph_uncached && g_glyph_uncached->font == font) {
+		UI_FREE(g_glyph_uncached);
+		g_glyph_uncached = NULL;
+	}
+}
+
+void glyph_cache_clear(void)
+{
+	while (g_glyph_lru_tail) {
+		_glyph_cache_remove(g_glyph_lru_tail);
+	}
+
+	if (g_glyph_uncached) {
+		UI_FREE(g_glyph_uncached);
+		g_glyph_uncached = NULL;
+	}
+}
+
+static glyph_entry_t *_glyph_cache_find(ui_font_asset_body_t *font, size_t font_size, uint32_t utf_code, uint32_t hash)
+{
+	glyph_entry_t *entry;
+
+	for (entry = g_glyph_bucket[hash]; entry; entry = entry->hash_next) {
+		if (entry->utf_code == utf_code && entry->font_size == font_size && entry->font == font) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+static glyph_entry_t *_glyph_cache_rasterize(ui_font_asset_body_t *font, size_t font_size, uint32_t utf_code)
+{
+	glyph_entry_t *entry;
+	uint8_t *bitmap;
+	float scale;
+	int c_x1;
+	int c_y1;
+	int c_x2;
+	int c_y2;
+	int out_w;
+	int out_h;
+
+	scale = stbtt_ScaleForPixelHeight(&font->ttf_info, font_size);
+	stbtt_GetCodepointBitmapBox(&font->ttf_info, utf_code, scale, scale, &c_x1, &c_y1, &c_x2, &c_y2);
+
+	out_w = c_x2 - c_x1;
+	out_h = c_y2 - c_y1;
+	if (out_w <= 0 || out_h <= 0) {
+		// Such as a space, cached to skip the lookup of the font next time
+		out_w = 0;
+		out_h = 0;
+	}
+
+	entry = (glyph_entry_t *)UI_ALLOC(sizeof(glyph_entry_t) + out_w * out_h);
+	if (!entry) {
+		UI_LOGE("error: out of memory!\n");
+		return NULL;
+	}
+
+	memset(entry, 0, sizeof(glyph_entry_t));
+	entry->font = font;
+	entry->font_size = font_size;
+	entry->utf_code = utf_code;
+	entry->mem_size = sizeof(glyph_entry_t) + out_w * out_h;
+
+	bitmap = (uint8_t *)(entry + 1);
+	if (out_w && out_h) {
+		stbtt_MakeCodepointBitmap(&font->ttf_info, bitmap, out_w, out_h, out_w, scale, scale, utf_code);
+	}
+
+	entry->glyph.offset_y = (int16_t)c_y1;
+	entry->glyph.width = (uint16_t)out_w;
+	entry->glyph.height = (uint16_t)out_h;
+	entry->glyph.pf = UI_PIXEL_FORMAT_A8;
+	entry->glyph.bitmap = bitmap;
+
+	return entry;
+}
+
+static void _glyph_cache_insert(glyph_entry_t *entry, uint32_t hash)
+{
+	entry->hash_next = g_glyph_bucket[hash];
+	g_glyph_bucket[hash] = entry;
+
+	_glyph_cache_lru_push(entry);
+	g_glyph_cache_used += entry->mem_size;
+}
+
+static void _glyph_cache_remove(glyph_entry_t *entry)
+{
+	glyph_entry_t **link;
+
+	link = &g_glyph_bucket[_glyph_cache_hash(entry->font, entry->font_size, entry->utf_code)];
+	while (*link != entry) {
+		link = &(*link)->hash_next;
+	}
+	*link = entry->hash_next;
+
+	_glyph_cache_lru_unlink(entry);
+	g_glyph_cache_used -= entry->mem_size;
+
+	UI_FREE(entry);
+}
+
+static void _glyph_cache_lru_unlink(glyph_entry_t *entry)
+{
+	if (entry->lru_prev) {
+		entry->lru_prev->lru_next = entry->lru_next;
+	} else {
+		g_glyph_lru_head = entry->lru_next;
+	}
+
+	if (entry->lru_next) {
+		entry->lru_next->lru_prev = entry->lru_prev;
+	} else {
+		g_glyph_lru_tail = entry->lru_prev;
+	}
+
+	entry->lru_prev = NULL;
+	entry->lru_next = NULL;
+}
+
+static void _glyph_cache_lru_push(glyph_entry_t *entry)
+{
+	entry->lru_prev = NULL;
+	entry->lru_next = g_glyph_lru_head;
+
+	if (g_glyph_lru_head) {
+		g_glyph_lru_head->lru_prev = entry;
+	} else {
+		g_glyph_lru_tail = entry;
+	}
+	g_glyph_lru_head = entry;
+}
+
+#if defined(CONFIG_UI_GLYPH_ATLAS)
+static const ui_glyph_t *_glyph_atlas_find(const uint8_t *atlas, size_t font_size, uint32_t utf_code)
+{
+	static ui_glyph_t glyph;
+	const ui_glyph_atlas_t *header;
+	const ui_glyph_atlas_entry_t *entries;
+	int32_t low;
+	int32_t high;
+	int32_t mid;
+
+	header = (const ui_glyph_atlas_t *)atlas;
+	if (header->font_size != font_size) {
+		return NULL;
+	}
+
+	entries = (const ui_glyph_atlas_entry_t *)(atlas + sizeof(ui_glyph_atlas_t));
+	low = 0;
+	high = (int32_t)header->glyph_count - 1;
+
+	while (low <= high) {
+		mid = (low + high) >> 1;
+		if (entries[mid].utf_code < utf_code) {
+			low = mid + 1;
+		} else if (entries[mid].utf_code > utf_code) {
+			high = mid - 1;
+		} else {
+			glyph.offset_y = entries[mid].offset_y;
+			glyph.width = entries[mid].width;
+			glyph.height = entries[mid].height;
+			glyph.pf = entries[mid].pf;
+			glyph.bitmap = atlas + entries[mid].offset;
+			return &glyph;
+		}
+	}
+
+	return NULL;
+}
+#endif
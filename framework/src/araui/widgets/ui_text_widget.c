@@ -38,6 +38,10 @@
 #include "utils/emoji.h"
 #endif
 
+#if defined(CONFIG_UI_GLYPH_CACHE)
+#include "utils/glyph_cache.h"
+#endif
+
 typedef struct {
 	ui_text_widget_body_t *body;
 	char *text;
@@ -78,7 +82,14 @@ static void _ui_text_widget_set_word_wrap_func(void *userdata);
 static void _ui_text_widget_set_font_size_func(void *userdata);
 static void _ui_text_widget_calculate_line_num(ui_text_widget_body_t *body);
 
+#if defined(CONFIG_UI_ENABLE_EMOJI)
+static void _ui_text_widget_draw_emoji(ui_text_widget_body_t *body, int x, int y,
+	const uint8_t *bitmap, int32_t width, int32_t height, ui_pixel_format_t pf);
+#endif
+
+#if !defined(CONFIG_UI_GLYPH_CACHE)
 static uint8_t g_glyph_bitmap[CONFIG_UI_GLYPH_BITMAP_WIDTH * CONFIG_UI_GLYPH_BITMAP_HEIGHT];
+#endif
 
 ui_widget_t ui_text_widget_create(int32_t width, int32_t height, ui_asset_t font, const char *text, size_t font_size)
 {
@@ -432,12 +443,16 @@ static void _ui_text_widget_render_func(ui_widget_t widget, uint32_t dt)
 	float scale;
 	int ascent;
 	int i;
+#if defined(CONFIG_UI_GLYPH_CACHE)
+	const ui_glyph_t *glyph;
+#else
 	int c_x1;
 	int c_y1;
 	int c_x2;
 	int c_y2;
 	int out_w;
 	int out_h;
+#endif
 	int x;
 	int y;
 	int32_t text_width;
@@ -457,10 +472,6 @@ static void _ui_text_widget_render_func(ui_widget_t widget, uint32_t dt)
 
 #if defined(CONFIG_UI_ENABLE_EMOJI)
 	ui_bitmap_data_t *emoji_bitmap;
-	ui_vec3_t emoji_v1;
-	ui_vec3_t emoji_v2;
-	ui_vec3_t emoji_v3;
-	ui_vec3_t emoji_v4;
 #endif
 
 	if (!widget) {
@@ -475,7 +486,11 @@ static void _ui_text_widget_render_func(ui_widget_t widget, uint32_t dt)
 		return;
 	}
 
+#if defined(CONFIG_UI_GLYPH_CACHE)
+	ui_renderer_set_fill_color(body->font_color);
+#else
 	memset(g_glyph_bitmap, 0, CONFIG_UI_GLYPH_BITMAP_WIDTH * CONFIG_UI_GLYPH_BITMAP_HEIGHT);
+#endif
 
 	scale = stbtt_ScaleForPixelHeight(&(body->font->ttf_info), body->font_size);
 
@@ -542,29 +557,41 @@ static void _ui_text_widget_render_func(ui_widget_t widget, uint32_t dt)
 			// If the code is emoji
 			if (is_emoji(body->utf_code[draw_idx])) {
 				emoji_bitmap = emoji_get_bitmap(body->utf_code[draw_idx]);
+#if defined(CONFIG_UI_GLYPH_CACHE)
+				// The emoji of the glyph atlas are scaled to the font size already
+				glyph = glyph_cache_get(body->font, body->font_size, body->utf_code[draw_idx]);
+				if (glyph) {
+					_ui_text_widget_draw_emoji(body, x, y, glyph->bitmap, glyph->width, glyph->height, (ui_pixel_format_t)glyph->pf);
+				} else if (emoji_bitmap) {
+#else
 				if (emoji_bitmap) {
-					ui_renderer_set_texture(
-						((uint8_t *)emoji_bitmap) + sizeof(ui_bitmap_data_t),
-						emoji_bitmap->width,
-						emoji_bitmap->height,
-						emoji_bitmap->pf);
-
-						emoji_v1 = (ui_vec3_t){ .x = x - body->base.global_rect.x, .y = y - body->base.global_rect.y, .w = 1.0f };
-						emoji_v2 = (ui_vec3_t){ .x = x - body->base.global_rect.x, .y = y - body->base.global_rect.y + body->font_size, .w = 1.0f };
-						emoji_v3 = (ui_vec3_t){ .x = x - body->base.global_rect.x + body->font_size, .y = y - body->base.global_rect.y + body->font_size, .w = 1.0f };
-						emoji_v4 = (ui_vec3_t){ .x = x - body->base.global_rect.x + body->font_size, .y = y - body->base.global_rect.y, .w = 1.0f };
-
-						ui_render_quad_uv(&body->base.trans_mat, emoji_v1, emoji_v2, emoji_v3, emoji_v4,
-							(ui_uv_t){ 0.0f, 0.0f },
-							(ui_uv_t){ 0.0f, 1.0f },
-							(ui_uv_t){ 1.0f, 1.0f },
-							(ui_uv_t){ 1.0f, 0.0f });
-
-						ui_renderer_set_texture(NULL, 0, 0, UI_PIXEL_FORMAT_UNKNOWN);
+#endif
+					_ui_text_widget_draw_emoji(body, x, y, ((uint8_t *)emoji_bitmap) + sizeof(ui_bitmap_data_t),
+						emoji_bitmap->width, emoji_bitmap->height, emoji_bitmap->pf);
 				}
 				x += body->font_size;
 			} else {
 #endif
+#if defined(CONFIG_UI_GLYPH_CACHE)
+				glyph = glyph_cache_get(body->font, body->font_size, body->utf_code[draw_idx]);
+				if (glyph && glyph->width && glyph->height) {
+					ui_renderer_translate(&body->base.trans_mat, &text_mat, (float)x, (float)(y + ascent + glyph->offset_y));
+					ui_renderer_set_texture((uint8_t *)glyph->bitmap, glyph->width, glyph->height, UI_PIXEL_FORMAT_A8);
+
+					v1 = (ui_vec3_t){ .x = 0.0f, .y = 0.0f, .w = 1.0f };
+					v2 = (ui_vec3_t){ .x = 0.0f, .y = glyph->height, .w = 1.0f };
+					v3 = (ui_vec3_t){ .x = glyph->width, .y = glyph->height, .w = 1.0f };
+					v4 = (ui_vec3_t){ .x = glyph->width, .y = 0.0f, .w = 1.0f };
+
+					ui_render_quad_uv(&text_mat, v1, v2, v3, v4,
+								(ui_uv_t){ 0.0f, 0.0f },
+								(ui_uv_t){ 0.0f, 1.0f },
+								(ui_uv_t){ 1.0f, 1.0f },
+								(ui_uv_t){ 1.0f, 0.0f });
+
+					ui_renderer_set_texture(NULL, 0, 0, UI_PIXEL_FORMAT_UNKNOWN);
+				}
+#else
 				/* get bounding box for character (may be offset to account for chars that dip above or below the line */
 				stbtt_GetCodepointBitmapBox(&(body->font->ttf_info), body->utf_code[draw_idx],
 					scale, scale, &c_x1, &c_y1, &c_x2, &c_y2);
@@ -613,6 +640,7 @@ static void _ui_text_widget_render_func(ui_widget_t widget, uint32_t dt)
 				ui_renderer_set_texture(NULL, 0, 0, UI_PIXEL_FORMAT_UNKNOWN);
 				ui_renderer_set_fill_color(CONFIG_UI_DEFAULT_FILL_COLOR);
 				memset(g_glyph_bitmap, 0, out_w * out_h);
+#endif
 
 				x += body->width_array[draw_idx];
 #if defined(CONFIG_UI_ENABLE_EMOJI)
@@ -623,8 +651,38 @@ static void _ui_text_widget_render_func(ui_widget_t widget, uint32_t dt)
 
 		y += body->font_size;
 	}
+
+#if defined(CONFIG_UI_GLYPH_CACHE)
+	ui_renderer_set_fill_color(CONFIG_UI_DEFAULT_FILL_COLOR);
+#endif
 }
 
+#if defined(CONFIG_UI_ENABLE_EMOJI)
+static void _ui_text_widget_draw_emoji(ui_text_widget_body_t *body, int x, int y,
+	const uint8_t *bitmap, int32_t width, int32_t height, ui_pixel_format_t pf)
+{
+	ui_vec3_t emoji_v1;
+	ui_vec3_t emoji_v2;
+	ui_vec3_t emoji_v3;
+	ui_vec3_t emoji_v4;
+
+	ui_renderer_set_texture((uint8_t *)bitmap, width, height, pf);
+
+	emoji_v1 = (ui_vec3_t){ .x = x - body->base.global_rect.x, .y = y - body->base.global_rect.y, .w = 1.0f };
+	emoji_v2 = (ui_vec3_t){ .x = x - body->base.global_rect.x, .y = y - body->base.global_rect.y + body->font_size, .w = 1.0f };
+	emoji_v3 = (ui_vec3_t){ .x = x - body->base.global_rect.x + body->font_size, .y = y - body->base.global_rect.y + body->font_size, .w = 1.0f };
+	emoji_v4 = (ui_vec3_t){ .x = x - body->base.global_rect.x + body->font_size, .y = y - body->base.global_rect.y, .w = 1.0f };
+
+	ui_render_quad_uv(&body->base.trans_mat, emoji_v1, emoji_v2, emoji_v3, emoji_v4,
+		(ui_uv_t){ 0.0f, 0.0f },
+		(ui_uv_t){ 0.0f, 1.0f },
+		(ui_uv_t){ 1.0f, 1.0f },
+		(ui_uv_t){ 1.0f, 0.0f });
+
+	ui_renderer_set_texture(NULL, 0, 0, UI_PIXEL_FORMAT_UNKNOWN);
+}
+#endif
+
 static void _ui_text_widget_removed_func(ui_widget_t widget)
 {
 	ui_text_widget_body_t *body;
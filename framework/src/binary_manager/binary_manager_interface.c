@@ -67,6 +67,11 @@ binmgr_result_type_e binary_manager_set_request(binmgr_request_t *request_msg, i
 		}
 		request_msg->data.cb_info = (binmgr_cb_t *)arg;
 		break;
+#ifdef CONFIG_ELF_LAZY_LOAD
+	case BINMGR_LOAD_SECTION:
+		request_msg->data.addr = (uintptr_t)arg;
+		break;
+#endif
 	case BINMGR_UPDATE:
 	default:
 		break;
@@ -153,6 +153,15 @@ size_t Decoder::getAvailSpace()
 #endif
 }
 
+size_t Decoder::getDataSize()
+{
+#ifdef CONFIG_AUDIO_CODEC
+	return rb_used(mDecoder.rbsp->rbp);
+#else
+	return 0;
+#endif
+}
+
 #ifdef CONFIG_AUDIO_CODEC
 bool Decoder::mConfig(int audioType)
 {
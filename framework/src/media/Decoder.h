@@ -43,6 +43,7 @@ public:
 	bool getFrame(unsigned char *buf, size_t *size, unsigned int *sampleRate, unsigned short *channels);
 	bool empty();
 	size_t getAvailSpace();
+	size_t getDataSize();
 
 private:
 #ifdef CONFIG_AUDIO_CODEC
@@ -18,7 +18,7 @@
 
 #include <tinyara/config.h>
 #include <debug.h>
-#include "Demuxer.h"
+#include <media/Demuxer.h>
 #ifdef CONFIG_CONTAINER_MPEG2TS
 #include "demux/mpeg2ts/TSDemuxer.h"
 #endif
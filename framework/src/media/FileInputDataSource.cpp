@@ -18,7 +18,12 @@
 
 #include <tinyara/config.h>
 #include <stdio.h>
+#include <string.h>
 #include <debug.h>
+#ifdef CONFIG_FILE_DATASOURCE_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 #include <media/FileInputDataSource.h>
 #include <media/MediaUtils.h>
@@ -29,21 +34,30 @@ namespace stream {
 FileInputDataSource::FileInputDataSource() :
 	InputDataSource(),
 	mDataPath(""),
-	mFp(nullptr)
+	mFp(nullptr),
+	mMapBase(nullptr),
+	mMapSize(0),
+	mMapPos(0)
 {
 }
 
 FileInputDataSource::FileInputDataSource(const std::string &dataPath) :
 	InputDataSource(),
 	mDataPath(dataPath),
-	mFp(nullptr)
+	mFp(nullptr),
+	mMapBase(nullptr),
+	mMapSize(0),
+	mMapPos(0)
 {
 }
 
 FileInputDataSource::FileInputDataSource(const FileInputDataSource &source) :
 	InputDataSource(source),
 	mDataPath(source.mDataPath),
-	mFp(source.mFp)
+	mFp(source.mFp),
+	mMapBase(source.mMapBase),
+	mMapSize(source.mMapSize),
+	mMapPos(source.mMapPos)
 {
 }
 
@@ -97,6 +111,7 @@ bool FileInputDataSource::open()
 			break;
 		}
 
+		mapFile();
 		return true;
 	}
 
@@ -108,6 +123,7 @@ bool FileInputDataSource::close()
 {
 	bool ret = true;
 	if (mFp) {
+		unmapFile();
 		if (fclose(mFp) == OK) {
 			mFp = nullptr;
 			medvdbg("close success!!\n");
@@ -143,6 +159,18 @@ ssize_t FileInputDataSource::read(unsigned char *buf, size_t size)
 		return EOF;
 	}
 
+	if (mMapBase) {
+		/* The file is mapped, copy straight from the media */
+		size_t rlen = mMapSize - mMapPos;
+		if (rlen > size) {
+			rlen = size;
+		}
+		memcpy(buf, mMapBase + mMapPos, rlen);
+		mMapPos += rlen;
+		medvdbg("read size : %d\n", rlen);
+		return rlen;
+	}
+
 	size_t rlen = fread(buf, sizeof(unsigned char), size, mFp);
 	medvdbg("read size : %d\n", rlen);
 	if (rlen == 0) {
@@ -159,6 +187,49 @@ ssize_t FileInputDataSource::read(unsigned char *buf, size_t size)
 	return rlen;
 }
 
+void FileInputDataSource::mapFile()
+{
+#ifdef CONFIG_FILE_DATASOURCE_MMAP
+	struct stat st;
+	long pos;
+	void *addr;
+
+	if (fstat(fileno(mFp), &st) != OK || st.st_size <= 0) {
+		return;
+	}
+
+	/* Continue from wherever header parsing left the stream */
+	pos = ftell(mFp);
+	if (pos < 0 || pos > st.st_size) {
+		return;
+	}
+
+	addr = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fileno(mFp), 0);
+	if (addr == MAP_FAILED) {
+		/* Not on directly accessible media, keep using fread() */
+		medvdbg("mmap is not available, errno : %d\n", errno);
+		return;
+	}
+
+	mMapBase = (const unsigned char *)addr;
+	mMapSize = st.st_size;
+	mMapPos = pos;
+	medvdbg("file mapped at %p, size : %d\n", addr, mMapSize);
+#endif
+}
+
+void FileInputDataSource::unmapFile()
+{
+#ifdef CONFIG_FILE_DATASOURCE_MMAP
+	if (mMapBase) {
+		munmap((void *)mMapBase, mMapSize);
+		mMapBase = nullptr;
+		mMapSize = 0;
+		mMapPos = 0;
+	}
+#endif
+}
+
 FileInputDataSource::~FileInputDataSource()
 {
 	if (isPrepared()) {
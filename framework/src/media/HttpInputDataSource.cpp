@@ -61,7 +61,7 @@ HttpInputDataSource::HttpInputDataSource(const std::string &url)
 }
 
 HttpInputDataSource::HttpInputDataSource(const HttpInputDataSource &source)
-	: InputDataSource(source), mUrl(source.mUrl), mThread((pthread_t)0), mIsHeaderReceived(source.mIsHeaderReceived), mIsDataReceived(source.mIsDataReceived)
+	: InputDataSource(source), mUrl(source.mUrl), mThread((pthread_t)0), mIsHeaderReceived(source.mIsHeaderReceived), mIsDataReceived(source.mIsDataReceived.load())
 {
 }
 
@@ -84,6 +84,7 @@ bool HttpInputDataSource::open()
 		mStreamBuffer = StreamBuffer::Builder()
 								.setBufferSize(CONFIG_HTTPSOURCE_DOWNLOAD_BUFFER_SIZE)
 								.setThreshold(CONFIG_HTTPSOURCE_DOWNLOAD_BUFFER_THRESHOLD)
+								.setLockFree(true)
 								.build();
 
 		if (mStreamBuffer == nullptr) {
@@ -135,7 +136,7 @@ bool HttpInputDataSource::open()
 	case AUDIO_TYPE_MP3:
 	case AUDIO_TYPE_AAC: {
 		// wait for audio stream data
-		if (!mCondv.wait_for(lock, WAIT_DATA_TIMEOUT, [=]{ return mIsDataReceived; })) {
+		if (!mCondv.wait_for(lock, WAIT_DATA_TIMEOUT, [=]{ return mIsDataReceived.load(); })) {
 			meddbg("download:: wait audio data timeout!\n");
 			mBufferWriter->setEndOfStream();
 			return false;
@@ -236,6 +237,9 @@ void HttpInputDataSource::onBufferUnderrun()
 
 void HttpInputDataSource::onBufferUpdated(ssize_t change, size_t current)
 {
+	// The buffer is lock-free, so this is called by both the downloader and
+	// the reader without mMutex, hence mIsDataReceived is atomic. It is only
+	// set under mMutex, so that the waiter in open() can't miss the notify.
 	if (!mIsDataReceived) {
 		if (current >= mStreamBuffer->getThreshold()) {
 			medvdbg("Enough data received!\n");
@@ -21,11 +21,29 @@
 #include <debug.h>
 #include <pthread.h>
 #include <media/MediaUtils.h>
+#include <media/Demuxer.h>
 
 #include "InputHandler.h"
 #include "MediaPlayerImpl.h"
 #include "Decoder.h"
-#include "Demuxer.h"
+
+#ifdef CONFIG_MEDIA_PLAYER_DECODE_AHEAD
+#ifndef CONFIG_MEDIA_PLAYER_DECODE_AHEAD_BUFFERS
+#define CONFIG_MEDIA_PLAYER_DECODE_AHEAD_BUFFERS 4
+#endif
+#ifndef CONFIG_MEDIA_PLAYER_DECODE_AHEAD_BUFFER_SIZE
+#define CONFIG_MEDIA_PLAYER_DECODE_AHEAD_BUFFER_SIZE 4096
+#endif
+#ifndef CONFIG_MEDIA_PLAYER_DECODE_AHEAD_THRESHOLD
+#define CONFIG_MEDIA_PLAYER_DECODE_AHEAD_THRESHOLD 2
+#endif
+#ifndef CONFIG_MEDIA_PLAYER_FETCH_STACKSIZE
+#define CONFIG_MEDIA_PLAYER_FETCH_STACKSIZE 4096
+#endif
+
+/* The player waits this long for a decoded buffer before it runs commands */
+#define DECODE_AHEAD_WAIT std::chrono::milliseconds(10)
+#endif
 
 namespace media {
 namespace stream {
@@ -33,7 +51,21 @@ namespace stream {
 InputHandler::InputHandler() :
 	mDecoder(nullptr),
 	mState(BUFFER_STATE_EMPTY),
-	mTotalBytes(0)
+	mTotalBytes(0),
+	mSourceBuffer(nullptr),
+	mSourceBufferSize(0)
+#ifdef CONFIG_MEDIA_PLAYER_DECODE_AHEAD
+	,
+	mFetcher(0),
+	mIsFetcherAlive(false),
+	mOutputBuffer(nullptr),
+	mStampHead(0),
+	mStampCount(0),
+	mFetchedBytes(0),
+	mConsumedBytes(0),
+	mLatency(0),
+	mMaxLatency(0)
+#endif
 {
 	mWorkerStackSize = CONFIG_INPUT_DATASOURCE_STACKSIZE;
 }
@@ -74,6 +106,30 @@ bool InputHandler::doStandBy()
 
 bool InputHandler::open()
 {
+#ifdef CONFIG_MEDIA_PLAYER_DECODE_AHEAD
+	// The stream buffer holds encoded data, from the fetcher to the worker only
+	if (!getStreamBuffer()) {
+		auto streamBuffer = StreamBuffer::Builder()
+								.setBufferSize(CONFIG_HANDLER_STREAM_BUFFER_SIZE)
+								.setThreshold(CONFIG_HANDLER_STREAM_BUFFER_THRESHOLD)
+								.setLockFree(true)
+								.build();
+		if (!streamBuffer) {
+			meddbg("streamBuffer is nullptr!\n");
+			return false;
+		}
+		setStreamBuffer(streamBuffer);
+	}
+
+	// Whole frames of any format fit in a buffer
+	if (!mPCMPool.init(CONFIG_MEDIA_PLAYER_DECODE_AHEAD_BUFFERS, CONFIG_MEDIA_PLAYER_DECODE_AHEAD_BUFFER_SIZE & ~0xf)) {
+		meddbg("PCM buffer pool init failed!\n");
+		return false;
+	}
+	mLatency = 0;
+	mMaxLatency = 0;
+#endif
+
 	// Open stream handler and start buffering
 	if (!StreamHandler::open()) {
 		meddbg("StreamHandler::open failed!\n");
@@ -82,7 +138,11 @@ bool InputHandler::open()
 
 	// Wait buffering done
 	std::unique_lock<std::mutex> lock(mMutex);
+#ifdef CONFIG_MEDIA_PLAYER_DECODE_AHEAD
+	if (mState < BUFFER_STATE_BUFFERED && !mPCMPool.isEndOfStream()) {
+#else
 	if (mState < BUFFER_STATE_BUFFERED) {
+#endif
 		medvdbg("PCM buffering...\n");
 		mCondv.wait(lock);
 		medvdbg("PCM buffering done!\n");
@@ -94,34 +154,216 @@ bool InputHandler::open()
 bool InputHandler::close()
 {
 	bool ret = StreamHandler::close();
+	freeSourceBuffer();
+#ifdef CONFIG_MEDIA_PLAYER_DECODE_AHEAD
+	mOutputBuffer = nullptr;
+	mPCMPool.release();
+#endif
 	// Terminate buffering
 	std::unique_lock<std::mutex> lock(mMutex);
 	mCondv.notify_one();
 	return ret;
 }
 
+bool InputHandler::start()
+{
+	if (!StreamHandler::start()) {
+		return false;
+	}
+
+#ifdef CONFIG_MEDIA_PLAYER_DECODE_AHEAD
+	if (!mIsFetcherAlive) {
+		mIsFetcherAlive = true;
+
+		pthread_attr_t attr;
+		pthread_attr_init(&attr);
+		pthread_attr_setstacksize(&attr, CONFIG_MEDIA_PLAYER_FETCH_STACKSIZE);
+		int ret = pthread_create(&mFetcher, &attr, static_cast<pthread_startroutine_t>(InputHandler::fetcherMain), this);
+		if (ret != OK) {
+			meddbg("Fail to create fetcher thread, return value : %d\n", ret);
+			mIsFetcherAlive = false;
+			StreamHandler::stop();
+			return false;
+		}
+		pthread_setname_np(mFetcher, "InputFetcher");
+	}
+#endif
+
+	return true;
+}
+
+bool InputHandler::stop()
+{
+#ifdef CONFIG_MEDIA_PLAYER_DECODE_AHEAD
+	if (mIsFetcherAlive) {
+		mIsFetcherAlive = false;
+		// Fetcher may be blocked in writing the stream buffer
+		mBufferWriter->setEndOfStream();
+		pthread_join(mFetcher, NULL);
+	}
+	// Worker may be blocked in getting a free PCM buffer
+	mPCMPool.stop();
+#endif
+	return StreamHandler::stop();
+}
+
 ssize_t InputHandler::read(unsigned char *buf, size_t size)
 {
 	size_t rlen = 0;
 
+#ifdef CONFIG_MEDIA_PLAYER_DECODE_AHEAD
+	// Copy across decoded buffers
+	while (rlen < size) {
+		unsigned char *data;
+		ssize_t len = peek(&data, size - rlen);
+		if (len <= 0) {
+			break;
+		}
+		memcpy(buf + rlen, data, (size_t)len);
+		consume((size_t)len);
+		rlen += (size_t)len;
+	}
+#else
 	if (mBufferReader) {
 		rlen = mBufferReader->read(buf, size);
 	}
+#endif
 
 	return (ssize_t)rlen;
 }
 
+ssize_t InputHandler::peek(unsigned char **buf, size_t size)
+{
+	size_t len = 0;
+
+#ifdef CONFIG_MEDIA_PLAYER_DECODE_AHEAD
+	if (!mOutputBuffer) {
+		unsigned int underruns = mPCMPool.getUnderrunCount();
+		mOutputBuffer = mPCMPool.getDecoded(DECODE_AHEAD_WAIT);
+		if (mPCMPool.getUnderrunCount() != underruns) {
+			auto mp = getPlayer();
+			if (mp) {
+				mp->notifyObserver(PLAYER_OBSERVER_COMMAND_BUFFER_UNDERRUN);
+			}
+		}
+		if (!mOutputBuffer) {
+			return 0;
+		}
+
+		auto elapsed = PCMBufferPool::clock::now() - mOutputBuffer->stamp;
+		mLatency = (unsigned int)std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+		if (mLatency > mMaxLatency) {
+			mMaxLatency = mLatency;
+		}
+	}
+
+	*buf = mOutputBuffer->data + mOutputBuffer->offset;
+	len = mOutputBuffer->size - mOutputBuffer->offset;
+	if (len > size) {
+		len = size;
+	}
+#else
+	if (mBufferReader) {
+		len = mBufferReader->peek(buf, size);
+	}
+#endif
+
+	return (ssize_t)len;
+}
+
+ssize_t InputHandler::consume(size_t size)
+{
+	size_t len = 0;
+
+#ifdef CONFIG_MEDIA_PLAYER_DECODE_AHEAD
+	if (mOutputBuffer) {
+		len = mOutputBuffer->size - mOutputBuffer->offset;
+		if (len > size) {
+			len = size;
+		}
+		mOutputBuffer->offset += len;
+		if (mOutputBuffer->offset == mOutputBuffer->size) {
+			mPCMPool.putFree(mOutputBuffer);
+			mOutputBuffer = nullptr;
+		}
+	}
+#else
+	if (mBufferReader) {
+		len = mBufferReader->consume(size);
+	}
+#endif
+
+	return (ssize_t)len;
+}
+
+bool InputHandler::isEndOfStream()
+{
+#ifdef CONFIG_MEDIA_PLAYER_DECODE_AHEAD
+	return !mOutputBuffer && mPCMPool.isEndOfStream();
+#else
+	return !mBufferReader || (mBufferReader->isEndOfStream() && mBufferReader->sizeOfData() == 0);
+#endif
+}
+
+bool InputHandler::getPipelineStats(player_pipeline_stats_t *stats)
+{
+#ifdef CONFIG_MEDIA_PLAYER_DECODE_AHEAD
+	stats->buffers = (unsigned int)mPCMPool.getCount();
+	stats->decoded = (unsigned int)mPCMPool.sizeOfDecoded();
+	stats->minDecoded = (unsigned int)mPCMPool.getMinDecoded();
+	stats->fetched = mBufferReader ? (unsigned int)mBufferReader->sizeOfData() : 0;
+	stats->underruns = mPCMPool.getUnderrunCount();
+	stats->latency = mLatency;
+	stats->maxLatency = mMaxLatency;
+	return true;
+#else
+	return false;
+#endif
+}
+
 void InputHandler::resetWorker()
 {
 	mState = BUFFER_STATE_EMPTY;
 	mTotalBytes = 0;
+#ifdef CONFIG_MEDIA_PLAYER_DECODE_AHEAD
+	mPCMPool.reset();
+	mOutputBuffer = nullptr;
+	mStampHead = 0;
+	mStampCount = 0;
+	mFetchedBytes = 0;
+	mConsumedBytes = 0;
+#endif
+}
+
+unsigned char *InputHandler::getSourceBuffer(size_t size)
+{
+	// Grow only, so the worker does not allocate a buffer in each round
+	if (size > mSourceBufferSize) {
+		freeSourceBuffer();
+		mSourceBuffer = new unsigned char[size];
+		if (mSourceBuffer) {
+			mSourceBufferSize = size;
+		}
+	}
+
+	return mSourceBuffer;
+}
+
+void InputHandler::freeSourceBuffer()
+{
+	delete[] mSourceBuffer;
+	mSourceBuffer = nullptr;
+	mSourceBufferSize = 0;
 }
 
 bool InputHandler::processWorker()
 {
+#ifdef CONFIG_MEDIA_PLAYER_DECODE_AHEAD
+	return decodeAhead();
+#else
 	size_t size = getAvailSpace();
 	if (size > 0) {
-		auto buf = new unsigned char[size];
+		auto buf = getSourceBuffer(size);
 		if (!buf) {
 			meddbg("run out of memory! size: 0x%x\n", size);
 			return false;
@@ -131,12 +373,10 @@ bool InputHandler::processWorker()
 		if (readLen <= 0) {
 			// Error occurred, or inputting finished
 			mBufferWriter->setEndOfStream();
-			delete[] buf;
 			return false;
 		}
 
 		ssize_t writeLen = writeToStreamBuffer(buf, (size_t)readLen);
-		delete[] buf;
 		if (writeLen <= 0) {
 			meddbg("write to stream buffer failed!\n");
 			mBufferWriter->setEndOfStream();
@@ -145,10 +385,215 @@ bool InputHandler::processWorker()
 	}
 
 	return true;
+#endif
+}
+
+#ifdef CONFIG_MEDIA_PLAYER_DECODE_AHEAD
+void *InputHandler::fetcherMain(void *arg)
+{
+	auto handler = static_cast<InputHandler *>(arg);
+	medvdbg("InputHandler::fetcherMain()\n");
+
+	while (handler->mIsFetcherAlive && handler->fetchSource()) {
+	}
+
+	medvdbg("InputHandler fetcher exit\n");
+	return NULL;
 }
 
+bool InputHandler::fetchSource()
+{
+	ssize_t readLen;
+
+	if (!mDemuxer) {
+		// Read the source into the stream buffer in place, a quarter at a time
+		unsigned char *span = nullptr;
+		size_t size = mBufferWriter->reserve(&span, mStreamBuffer->getBufferSize() / 4);
+		if (size == 0) {
+			// Stopped
+			return false;
+		}
+
+		readLen = readFromSource(span, size);
+		if (readLen <= 0) {
+			// Error occurred, or inputting finished
+			mBufferWriter->setEndOfStream();
+			return false;
+		}
+
+		mBufferWriter->commit((size_t)readLen);
+		stampFetched((size_t)readLen);
+		return true;
+	}
+
+	size_t size = mDemuxer->getAvailSpace();
+	auto buf = getSourceBuffer(size);
+	if (!buf) {
+		meddbg("run out of memory! size: 0x%x\n", size);
+		mBufferWriter->setEndOfStream();
+		return false;
+	}
+
+	readLen = readFromSource(buf, size);
+	if (readLen <= 0) {
+		mBufferWriter->setEndOfStream();
+		return false;
+	}
+
+	// Pass the elementary stream on
+	size_t used = 0;
+	while (1) {
+		unsigned char *buffES = nullptr;
+		size_t sizeES = size;
+		ssize_t ret = getElementaryStream(buf, (size_t)readLen, &used, &buffES, &sizeES);
+		if (ret < 0) {
+			meddbg("getElementaryStream failed! error: %d\n", ret);
+			mBufferWriter->setEndOfStream();
+			return false;
+		}
+		if (ret == 0) {
+			// want more data
+			break;
+		}
+
+		if (mBufferWriter->write(buffES, sizeES) != sizeES) {
+			// Stopped
+			return false;
+		}
+		stampFetched(sizeES);
+	}
+
+	return true;
+}
+
+void InputHandler::stampFetched(size_t size)
+{
+	std::lock_guard<std::mutex> lock(mStampMtx);
+	mFetchedBytes += size;
+
+	if (mStampCount == FETCH_STAMPS) {
+		// Extend the last chunk, whose data is then a little older than stamped
+		mStamps[(mStampHead + mStampCount - 1) % FETCH_STAMPS].end = mFetchedBytes;
+		return;
+	}
+
+	fetch_stamp_s &stamp = mStamps[(mStampHead + mStampCount) % FETCH_STAMPS];
+	stamp.end = mFetchedBytes;
+	stamp.time = PCMBufferPool::clock::now();
+	mStampCount++;
+}
+
+PCMBufferPool::clock::time_point InputHandler::getFetchStamp()
+{
+	// Encoded data up to this offset was decoded, the next byte is being decoded
+	uint64_t offset = mConsumedBytes;
+	if (mDecoder) {
+		offset -= mDecoder->getDataSize();
+	}
+
+	std::lock_guard<std::mutex> lock(mStampMtx);
+	while (mStampCount > 0 && mStamps[mStampHead].end <= offset) {
+		mStampHead = (mStampHead + 1) % FETCH_STAMPS;
+		mStampCount--;
+	}
+
+	if (mStampCount == 0) {
+		return PCMBufferPool::clock::now();
+	}
+	return mStamps[mStampHead].time;
+}
+
+bool InputHandler::decodeAhead()
+{
+	auto buffer = mPCMPool.getFree();
+	if (!buffer) {
+		// Stopped
+		return false;
+	}
+	// Only decoding updates the state, it follows the output by getting free buffers
+	updatePCMBufferState();
+
+	size_t capacity = mPCMPool.getBufferSize();
+	bool eos = false;
+	while (buffer->size < capacity && mIsWorkerAlive) {
+		if (buffer->size == 0) {
+			buffer->stamp = getFetchStamp();
+		}
+
+		unsigned char *out = buffer->data + buffer->size;
+		size_t size = capacity - buffer->size;
+		if (mDecoder && getDecodeFrames(out, &size)) {
+			buffer->size += size;
+			continue;
+		}
+
+		// Decoder wants more data, or PCM data is copied as it is
+		unsigned char *span = nullptr;
+		size_t len = mBufferReader->peek(&span, 1);
+		if (len == 0) {
+			eos = true;
+			break;
+		}
+
+		if (mDecoder) {
+			size_t avail = mDecoder->getAvailSpace();
+			if (len > avail) {
+				len = avail;
+			}
+			len = mDecoder->pushData(span, len);
+			if (len == 0) {
+				meddbg("push data to decoder failed!\n");
+				eos = true;
+				break;
+			}
+		} else {
+			if (len > size) {
+				len = size;
+			}
+			memcpy(out, span, len);
+			buffer->size += len;
+		}
+		mBufferReader->consume(len);
+		mConsumedBytes += len;
+	}
+
+	if (buffer->size > 0) {
+		mPCMPool.putDecoded(buffer);
+		updatePCMBufferState();
+	}
+
+	if (eos) {
+		medvdbg("decoding finished\n");
+		mPCMPool.setEndOfStream();
+		// Short streams may never fill up to the threshold
+		std::unique_lock<std::mutex> lock(mMutex);
+		mCondv.notify_one();
+		return false;
+	}
+
+	return true;
+}
+
+void InputHandler::updatePCMBufferState()
+{
+	size_t decoded = mPCMPool.sizeOfDecoded();
+	if (decoded == 0) {
+		setBufferState(BUFFER_STATE_EMPTY);
+	} else if (decoded == mPCMPool.getCount()) {
+		setBufferState(BUFFER_STATE_FULL);
+	} else if (decoded >= CONFIG_MEDIA_PLAYER_DECODE_AHEAD_THRESHOLD) {
+		setBufferState(BUFFER_STATE_BUFFERED);
+	} else {
+		setBufferState(BUFFER_STATE_BUFFERING);
+	}
+}
+#endif
+
 void InputHandler::sleepWorker()
 {
+	// With CONFIG_MEDIA_PLAYER_DECODE_AHEAD, decoding waits for encoded
+	// data and free PCM buffers itself
+#ifndef CONFIG_MEDIA_PLAYER_DECODE_AHEAD
 	bool bEOS = mBufferReader->isEndOfStream();
 	size_t spaces = mBufferWriter->sizeOfSpace();
 
@@ -156,6 +601,7 @@ void InputHandler::sleepWorker()
 	if (bEOS || (spaces == 0)) {
 		StreamHandler::sleepWorker();
 	}
+#endif
 }
 
 void InputHandler::setBufferState(buffer_state_t state)
@@ -184,10 +630,14 @@ void InputHandler::onBufferOverrun()
 
 void InputHandler::onBufferUnderrun()
 {
+	// With CONFIG_MEDIA_PLAYER_DECODE_AHEAD, fetching fell behind decoding:
+	// the output is notified only if the decoded buffers run out too, see peek().
+#ifndef CONFIG_MEDIA_PLAYER_DECODE_AHEAD
 	auto mp = getPlayer();
 	if (mp) {
 		mp->notifyObserver(PLAYER_OBSERVER_COMMAND_BUFFER_UNDERRUN);
 	}
+#endif
 }
 
 void InputHandler::onBufferUpdated(ssize_t change, size_t current)
@@ -197,6 +647,8 @@ void InputHandler::onBufferUpdated(ssize_t change, size_t current)
 		wakenWorker();
 	}
 
+#ifndef CONFIG_MEDIA_PLAYER_DECODE_AHEAD
+	// Or else the buffer state follows the decoded buffers, see updatePCMBufferState()
 	if (current == 0) {
 		setBufferState(BUFFER_STATE_EMPTY);
 	} else if (current == mStreamBuffer->getBufferSize()) {
@@ -206,6 +658,7 @@ void InputHandler::onBufferUpdated(ssize_t change, size_t current)
 	} else {
 		setBufferState(BUFFER_STATE_BUFFERING);
 	}
+#endif
 
 	if (change > 0) {
 		mTotalBytes += change;
@@ -255,6 +708,24 @@ ssize_t InputHandler::writeToStreamBuffer(unsigned char *buf, size_t size)
 		while (1) {
 			unsigned char *buffPCM = buf;
 			size_t sizePCM = used;
+
+			// Output PCM data into the stream buffer in place if there's
+			// enough contiguous space, or else copy it from `buf`.
+			bool inPlace = false;
+			if (sizePCM > 0) {
+				unsigned char *span = nullptr;
+				size_t sizeSpan = mBufferWriter->reserve(&span, sizePCM);
+				if (sizeSpan == 0) {
+					meddbg("End of writting!\n");
+					return EOF;
+				}
+				if (sizeSpan >= sizePCM) {
+					inPlace = true;
+					buffPCM = span;
+					sizePCM = sizeSpan;
+				}
+			}
+
 			ret = getPCM(buffES, sizeES, &usedES, &buffPCM, &sizePCM);
 			if (ret < 0) {
 				meddbg("getPCM failed! error: %d\n", ret);
@@ -266,7 +737,12 @@ ssize_t InputHandler::writeToStreamBuffer(unsigned char *buf, size_t size)
 			}
 
 			// write PCM data to stream buffer
-			size_t written = mBufferWriter->write(buffPCM, sizePCM);
+			size_t written;
+			if (inPlace) {
+				written = mBufferWriter->commit(sizePCM);
+			} else {
+				written = mBufferWriter->write(buffPCM, sizePCM);
+			}
 			if (written != sizePCM) {
 				meddbg("End of writting!\n");
 				return EOF;
@@ -18,16 +18,22 @@
 #ifndef __MEDIA_INPUTHANDLER_H
 #define __MEDIA_INPUTHANDLER_H
 
+#include <tinyara/config.h>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <condition_variable>
 #include <sys/types.h>
 
 #include <media/InputDataSource.h>
+#include <media/MediaPlayer.h>
+#include <media/Demuxer.h>
 #include "StreamHandler.h"
+#ifdef CONFIG_MEDIA_PLAYER_DECODE_AHEAD
+#include "PCMBufferPool.h"
+#endif
 
 #include "Decoder.h"
-#include "Demuxer.h"
 
 namespace media {
 class MediaPlayerImpl;
@@ -48,7 +54,26 @@ public:
 	bool doStandBy();
 	bool open() override;
 	bool close() override;
+	bool start() override;
+	bool stop() override;
 	ssize_t read(unsigned char *buf, size_t size);
+	/**
+	 * Get PCM data in place, see StreamBufferReader::peek(), and release it
+	 * by consume() after use.
+	 * With CONFIG_MEDIA_PLAYER_DECODE_AHEAD, it gets the next decoded
+	 * buffer and only waits a little for it: 0 is returned when decoding
+	 * fell behind, see isEndOfStream().
+	 */
+	ssize_t peek(unsigned char **buf, size_t size);
+	ssize_t consume(size_t size);
+	/**
+	 * All PCM data was read.
+	 */
+	bool isEndOfStream();
+	/**
+	 * Get the statistics of the decode-ahead pipeline since open().
+	 */
+	bool getPipelineStats(player_pipeline_stats_t *stats);
 
 	void setBufferState(buffer_state_t state);
 
@@ -76,6 +101,16 @@ private:
 	ssize_t getPCM(unsigned char *buf, size_t size, size_t *used, unsigned char **out, size_t *expect);
 	size_t fetchData(unsigned char *buf, size_t size, size_t *used, unsigned char **out, size_t *expect);
 	ssize_t readFromSource(unsigned char *buf, size_t size);
+	unsigned char *getSourceBuffer(size_t size);
+	void freeSourceBuffer();
+#ifdef CONFIG_MEDIA_PLAYER_DECODE_AHEAD
+	static void *fetcherMain(void *arg);
+	bool fetchSource();
+	bool decodeAhead();
+	void stampFetched(size_t size);
+	PCMBufferPool::clock::time_point getFetchStamp();
+	void updatePCMBufferState();
+#endif
 
 	std::mutex mMutex;
 	std::condition_variable mCondv;
@@ -87,6 +122,35 @@ private:
 
 	buffer_state_t mState;
 	size_t mTotalBytes;
+	// Reused by processWorker() to read the source
+	unsigned char *mSourceBuffer;
+	size_t mSourceBufferSize;
+#ifdef CONFIG_MEDIA_PLAYER_DECODE_AHEAD
+	/* Pipeline: the fetcher reads and demuxes the source into the stream
+	 * buffer, the worker decodes it into mPCMPool, the player outputs it.
+	 */
+	pthread_t mFetcher;
+	std::atomic<bool> mIsFetcherAlive;
+	PCMBufferPool mPCMPool;
+	// Buffer being output by the player
+	PCMBufferPool::Buffer *mOutputBuffer;
+
+	// When the encoded data up to each end offset was fetched
+	struct fetch_stamp_s {
+		uint64_t end;
+		PCMBufferPool::clock::time_point time;
+	};
+	static const size_t FETCH_STAMPS = 16;
+	std::mutex mStampMtx;
+	fetch_stamp_s mStamps[FETCH_STAMPS];
+	size_t mStampHead;
+	size_t mStampCount;
+	uint64_t mFetchedBytes;
+	uint64_t mConsumedBytes;
+
+	unsigned int mLatency;
+	unsigned int mMaxLatency;
+#endif
 };
 } // namespace stream
 } // namespace media
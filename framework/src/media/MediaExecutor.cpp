@@ -0,0 +1,248 @@
+/* ****************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#include <tinyara/config.h>
+#include <debug.h>
+#include <sched.h>
+
+#include "MediaExecutor.h"
+#include "MediaWorker.h"
+
+/* The player and recorder executors get the stack of their worker */
+
+#ifndef CONFIG_MEDIA_PLAYER_STACKSIZE
+#define CONFIG_MEDIA_PLAYER_STACKSIZE 4096
+#endif
+
+#ifndef CONFIG_MEDIA_RECORDER_STACKSIZE
+#define CONFIG_MEDIA_RECORDER_STACKSIZE 12288
+#endif
+
+/* The observer executor threads get the largest stack of the observers */
+
+#if defined(CONFIG_MEDIA_PLAYER_OBSERVER_STACKSIZE) && defined(CONFIG_MEDIA_RECORDER_OBSERVER_STACKSIZE)
+#if CONFIG_MEDIA_PLAYER_OBSERVER_STACKSIZE > CONFIG_MEDIA_RECORDER_OBSERVER_STACKSIZE
+#define MEDIA_OBSERVER_EXECUTOR_STACKSIZE CONFIG_MEDIA_PLAYER_OBSERVER_STACKSIZE
+#else
+#define MEDIA_OBSERVER_EXECUTOR_STACKSIZE CONFIG_MEDIA_RECORDER_OBSERVER_STACKSIZE
+#endif
+#elif defined(CONFIG_MEDIA_PLAYER_OBSERVER_STACKSIZE)
+#define MEDIA_OBSERVER_EXECUTOR_STACKSIZE CONFIG_MEDIA_PLAYER_OBSERVER_STACKSIZE
+#elif defined(CONFIG_MEDIA_RECORDER_OBSERVER_STACKSIZE)
+#define MEDIA_OBSERVER_EXECUTOR_STACKSIZE CONFIG_MEDIA_RECORDER_OBSERVER_STACKSIZE
+#else
+#define MEDIA_OBSERVER_EXECUTOR_STACKSIZE 2048
+#endif
+
+namespace media {
+
+MediaExecutor::MediaExecutor(const char *name, int threads, long stacksize) :
+	mName(name),
+	mNumThreads(threads),
+	mStacksize(stacksize),
+	mPriority(100),
+	mStarted(0),
+	mRefCnt(0),
+	mStopping(false),
+	mReadyHead(nullptr),
+	mReadyTail(nullptr)
+{
+	medvdbg("%s: %d threads, stack size %ld\n", mName, mNumThreads, mStacksize);
+}
+
+MediaExecutor &MediaExecutor::getPlayerExecutor()
+{
+	static MediaExecutor executor("MediaPlayerExecutor", CONFIG_MEDIA_EXECUTOR_THREADS, CONFIG_MEDIA_PLAYER_STACKSIZE);
+	return executor;
+}
+
+MediaExecutor &MediaExecutor::getRecorderExecutor()
+{
+	static MediaExecutor executor("MediaRecorderExecutor", CONFIG_MEDIA_EXECUTOR_THREADS, CONFIG_MEDIA_RECORDER_STACKSIZE);
+	return executor;
+}
+
+MediaExecutor &MediaExecutor::getObserverExecutor()
+{
+	static MediaExecutor executor("MediaObserverExecutor", CONFIG_MEDIA_OBSERVER_EXECUTOR_THREADS, MEDIA_OBSERVER_EXECUTOR_STACKSIZE);
+	return executor;
+}
+
+bool MediaExecutor::attach()
+{
+	std::lock_guard<std::mutex> life(mLifeMtx);
+	std::unique_lock<std::mutex> lock(mMutex);
+	++mRefCnt;
+	medvdbg("%s::attach() - increase RefCnt : %d\n", mName, mRefCnt);
+	if (mStarted > 0) {
+		return true;
+	}
+
+	mStopping = false;
+	while (mStarted < mNumThreads) {
+		int ret;
+		struct sched_param sparam;
+		pthread_attr_t attr;
+		pthread_attr_init(&attr);
+		pthread_attr_setstacksize(&attr, mStacksize);
+		sparam.sched_priority = mPriority;
+		pthread_attr_setschedparam(&attr, &sparam);
+		ret = pthread_create(&mThreads[mStarted], &attr, static_cast<pthread_startroutine_t>(MediaExecutor::executorLooper), this);
+		if (ret != OK) {
+			meddbg("Fail to create executor thread, return value : %d\n", ret);
+			break;
+		}
+		pthread_setname_np(mThreads[mStarted], mName);
+		mStarted++;
+	}
+
+	if (mStarted == 0) {
+		--mRefCnt;
+		return false;
+	}
+
+	return true;
+}
+
+void MediaExecutor::detach()
+{
+	std::lock_guard<std::mutex> life(mLifeMtx);
+	std::unique_lock<std::mutex> lock(mMutex);
+	if (mRefCnt > 0) {
+		--mRefCnt;
+	}
+	medvdbg("%s::detach() - decrease RefCnt : %d\n", mName, mRefCnt);
+	// A thread can not join itself, so its pool stays until the next detach.
+	if (mRefCnt > 0 || mStarted == 0 || isExecutorThread()) {
+		return;
+	}
+
+	mStopping = true;
+	mCondv.notify_all();
+	lock.unlock();
+
+	for (int i = 0; i < mStarted; i++) {
+		pthread_join(mThreads[i], NULL);
+	}
+	medvdbg("%s::detach() - %d threads exited\n", mName, mStarted);
+
+	lock.lock();
+	mStarted = 0;
+	mStopping = false;
+}
+
+void MediaExecutor::schedule(MediaWorker *worker)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	switch (worker->mState) {
+	case MediaWorker::STATE_IDLE:
+		pushReady(worker);
+		break;
+	case MediaWorker::STATE_RUNNING:
+		// Run it again after the current task
+		worker->mRescheduled = true;
+		break;
+	case MediaWorker::STATE_READY:
+		break;
+	}
+}
+
+void MediaExecutor::drain(MediaWorker *worker)
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+	if (mStarted == 0 || isExecutorThread()) {
+		return;
+	}
+
+	while (worker->mState == MediaWorker::STATE_RUNNING || !worker->mWorkerQueue.isEmpty()) {
+		mIdleCondv.wait(lock);
+	}
+}
+
+void *MediaExecutor::executorLooper(void *arg)
+{
+	auto executor = static_cast<MediaExecutor *>(arg);
+	medvdbg("%s : executorLooper\n", executor->mName);
+	executor->run();
+	return NULL;
+}
+
+void MediaExecutor::run()
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+	while (true) {
+		while (mReadyHead == nullptr && !mStopping) {
+			mCondv.wait(lock);
+		}
+		// Workers were drained before the last one detached
+		if (mStopping) {
+			break;
+		}
+
+		MediaWorker *worker = popReady();
+		worker->mState = MediaWorker::STATE_RUNNING;
+		worker->mRescheduled = false;
+		lock.unlock();
+
+		bool more = worker->runOnce();
+
+		lock.lock();
+		worker->mState = MediaWorker::STATE_IDLE;
+		if (more || worker->mRescheduled) {
+			// To the tail, so workers take turns
+			pushReady(worker);
+		}
+		mIdleCondv.notify_all();
+	}
+}
+
+bool MediaExecutor::isExecutorThread()
+{
+	pthread_t self = pthread_self();
+	for (int i = 0; i < mStarted; i++) {
+		if (pthread_equal(mThreads[i], self)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void MediaExecutor::pushReady(MediaWorker *worker)
+{
+	worker->mState = MediaWorker::STATE_READY;
+	worker->mNextReady = nullptr;
+	if (mReadyTail) {
+		mReadyTail->mNextReady = worker;
+	} else {
+		mReadyHead = worker;
+	}
+	mReadyTail = worker;
+	mCondv.notify_one();
+}
+
+MediaWorker *MediaExecutor::popReady()
+{
+	MediaWorker *worker = mReadyHead;
+	mReadyHead = worker->mNextReady;
+	if (mReadyHead == nullptr) {
+		mReadyTail = nullptr;
+	}
+	worker->mNextReady = nullptr;
+	return worker;
+}
+} // namespace media
@@ -0,0 +1,101 @@
+/* ****************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#ifndef __MEDIA_MEDIAEXECUTOR_H
+#define __MEDIA_MEDIAEXECUTOR_H
+
+#include <tinyara/config.h>
+#include <pthread.h>
+#include <mutex>
+#include <condition_variable>
+
+#ifndef CONFIG_MEDIA_EXECUTOR_THREADS
+#define CONFIG_MEDIA_EXECUTOR_THREADS 1
+#endif
+
+#ifndef CONFIG_MEDIA_OBSERVER_EXECUTOR_THREADS
+#define CONFIG_MEDIA_OBSERVER_EXECUTOR_THREADS 1
+#endif
+
+namespace media {
+class MediaWorker;
+
+/**
+ * A small pool of threads shared by MediaWorkers. Each worker is a strand:
+ * its tasks run in order and never on two threads at the same time, but
+ * any thread of the pool may run them.
+ *
+ * Workers which may block on other workers (the observers, whose callbacks
+ * may call synchronous player or recorder APIs) have their own executor,
+ * so they can never hold all the threads the players and recorders need.
+ */
+class MediaExecutor
+{
+public:
+	/**
+	 * Executors of the player and of the recorder workers. They are
+	 * separate, so a blocking write of the playback and a blocking read of
+	 * the capture do not take turns on the same threads.
+	 */
+	static MediaExecutor &getPlayerExecutor();
+	static MediaExecutor &getRecorderExecutor();
+	/**
+	 * Executor of the observer workers.
+	 */
+	static MediaExecutor &getObserverExecutor();
+
+	/**
+	 * Start the threads with the first worker, and stop them with the last.
+	 */
+	bool attach();
+	void detach();
+	/**
+	 * Make the worker run on a thread, as it has something to do.
+	 */
+	void schedule(MediaWorker *worker);
+	/**
+	 * Wait until all tasks of the worker ran.
+	 * It does not wait if called by a thread of this executor.
+	 */
+	void drain(MediaWorker *worker);
+
+private:
+	MediaExecutor(const char *name, int threads, long stacksize);
+	static void *executorLooper(void *arg);
+	void run();
+	bool isExecutorThread();
+	void pushReady(MediaWorker *worker);
+	MediaWorker *popReady();
+
+	const char *mName;
+	int mNumThreads;
+	long mStacksize;
+	int mPriority;
+	pthread_t mThreads[CONFIG_MEDIA_EXECUTOR_THREADS > CONFIG_MEDIA_OBSERVER_EXECUTOR_THREADS ? CONFIG_MEDIA_EXECUTOR_THREADS : CONFIG_MEDIA_OBSERVER_EXECUTOR_THREADS];
+	int mStarted;
+	int mRefCnt;
+	bool mStopping;
+	MediaWorker *mReadyHead;
+	MediaWorker *mReadyTail;
+	std::mutex mMutex;
+	std::condition_variable mCondv;
+	std::condition_variable mIdleCondv;
+	std::mutex mLifeMtx;
+};
+} // namespace media
+#endif
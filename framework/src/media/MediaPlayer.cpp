@@ -102,6 +102,11 @@ bool MediaPlayer::isPlaying()
 	return mPMpImpl->isPlaying();
 }
 
+player_result_t MediaPlayer::getPipelineStats(player_pipeline_stats_t *stats)
+{
+	return mPMpImpl->getPipelineStats(stats);
+}
+
 MediaPlayer::~MediaPlayer()
 {
 }
@@ -524,6 +524,51 @@ void MediaPlayerImpl::setPlayerVolume(uint8_t vol, player_result_t &ret)
 	return notifySync();
 }
 
+player_result_t MediaPlayerImpl::getPipelineStats(player_pipeline_stats_t *stats)
+{
+	player_result_t ret = PLAYER_OK;
+
+	std::unique_lock<std::mutex> lock(mCmdMtx);
+	medvdbg("MediaPlayer getPipelineStats\n");
+
+	if (stats == nullptr) {
+		meddbg("The given argument is invalid.\n");
+		return PLAYER_ERROR_INVALID_PARAMETER;
+	}
+
+	PlayerWorker &mpw = PlayerWorker::getWorker();
+	if (!mpw.isAlive()) {
+		meddbg("PlayerWorker is not alive\n");
+		return PLAYER_ERROR_NOT_ALIVE;
+	}
+
+	mpw.enQueue(&MediaPlayerImpl::getPlayerPipelineStats, shared_from_this(), stats, std::ref(ret));
+	mSyncCv.wait(lock);
+
+	return ret;
+}
+
+void MediaPlayerImpl::getPlayerPipelineStats(player_pipeline_stats_t *stats, player_result_t &ret)
+{
+	medvdbg("MediaPlayer Worker : getPipelineStats\n");
+#ifdef CONFIG_MEDIA_PLAYER_DECODE_AHEAD
+	if (mCurState != PLAYER_STATE_READY && mCurState != PLAYER_STATE_PLAYING && mCurState != PLAYER_STATE_PAUSED) {
+		meddbg("%s Fail : invalid state\n", __func__);
+		LOG_STATE_DEBUG(mCurState);
+		ret = PLAYER_ERROR_INVALID_STATE;
+		return notifySync();
+	}
+
+	if (!mInputHandler.getPipelineStats(stats)) {
+		ret = PLAYER_ERROR_INTERNAL_OPERATION_FAILED;
+	}
+#else
+	meddbg("Decode-ahead pipeline is not supported\n");
+	ret = PLAYER_ERROR_INVALID_OPERATION;
+#endif
+	notifySync();
+}
+
 player_result_t MediaPlayerImpl::setDataSource(std::unique_ptr<stream::InputDataSource> source)
 {
 	player_result_t ret = PLAYER_OK;
@@ -746,10 +791,36 @@ void MediaPlayerImpl::notifyAsync(player_event_t event)
 
 void MediaPlayerImpl::playback()
 {
-	ssize_t num_read = mInputHandler.read(mBuffer, (int)mBufSize);
+	// Output PCM data in the stream buffer in place, unless the contiguous
+	// data is less than one frame or not sample aligned; then copy it to mBuffer.
+	unsigned char *data = nullptr;
+	unsigned int frames = 0;
+	ssize_t num_read = mInputHandler.peek(&data, (size_t)mBufSize);
+	if (num_read == 0 && !mInputHandler.isEndOfStream()) {
+		// Decoding fell behind, give queued commands a chance and retry
+		return;
+	}
+	if (num_read > mBufSize) {
+		num_read = mBufSize;
+	}
+	if (num_read > 0 && ((uintptr_t)data & 0x1) == 0) {
+		frames = get_user_output_bytes_to_frame((unsigned int)num_read);
+	}
+	bool inPlace = (frames > 0);
+	if (inPlace) {
+		num_read = (ssize_t)get_user_output_frames_to_byte(frames);
+	} else {
+		data = mBuffer;
+		num_read = mInputHandler.read(mBuffer, (int)mBufSize);
+		frames = get_user_output_bytes_to_frame((unsigned int)num_read);
+	}
 	medvdbg("num_read : %d\n", num_read);
 	if (num_read > 0) {
-		int ret = start_audio_stream_out(mBuffer, get_user_output_bytes_to_frame((unsigned int)num_read));
+		int ret = start_audio_stream_out(data, frames);
+		if (inPlace) {
+			// Release the data only after it was output
+			mInputHandler.consume((size_t)num_read);
+		}
 		if (ret < 0) {
 			notifyObserver(PLAYER_OBSERVER_COMMAND_PLAYBACK_ERROR, PLAYER_ERROR_INTERNAL_OPERATION_FAILED);
 			PlayerWorker &mpw = PlayerWorker::getWorker();
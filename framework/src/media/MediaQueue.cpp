@@ -16,31 +16,86 @@
  *
  ******************************************************************/
 
+#include <debug.h>
 #include "MediaQueue.h"
 
 namespace media {
-MediaQueue::MediaQueue()
+void MediaTask::reset()
 {
+	if (mDestroy) {
+		mDestroy(&mStorage);
+		mInvoke = nullptr;
+		mDestroy = nullptr;
+	}
 }
+
+MediaQueue::MediaQueue() : mHead(0), mCount(0)
+{
+}
+
 MediaQueue::~MediaQueue()
 {
+	while (!mOverflow.empty()) {
+		delete mOverflow.front();
+		mOverflow.pop();
+	}
+}
+
+MediaTask *MediaQueue::allocTask()
+{
+	// Slots are used in order, so once tasks overflow the next ones have to
+	// wait in the overflow queue too.
+	if (mCount < CONFIG_MEDIA_WORKER_QUEUE_SIZE && mOverflow.empty()) {
+		return &mSlots[(mHead + mCount) % CONFIG_MEDIA_WORKER_QUEUE_SIZE];
+	}
+
+	medwdbg("all %d slots are in use\n", CONFIG_MEDIA_WORKER_QUEUE_SIZE);
+	MediaTask *task = new MediaTask;
+	if (!task) {
+		meddbg("run out of memory!\n");
+	}
+	return task;
 }
 
-std::function<void()> MediaQueue::deQueue()
+void MediaQueue::pushTask(MediaTask *task)
+{
+	if (task >= mSlots && task < mSlots + CONFIG_MEDIA_WORKER_QUEUE_SIZE) {
+		mCount++;
+	} else {
+		mOverflow.push(task);
+	}
+}
+
+bool MediaQueue::runOne()
 {
 	std::unique_lock<std::mutex> lock(mQueueMtx);
-	if (mQueueData.empty()) {
-		mQueueCv.wait(lock);
+	if (mCount > 0) {
+		// Run the task in its slot, which stays in use until it returns.
+		MediaTask *task = &mSlots[mHead];
+		lock.unlock();
+		task->run();
+		task->reset();
+		lock.lock();
+		mHead = (mHead + 1) % CONFIG_MEDIA_WORKER_QUEUE_SIZE;
+		mCount--;
+		return true;
+	}
+
+	if (!mOverflow.empty()) {
+		MediaTask *task = mOverflow.front();
+		mOverflow.pop();
+		lock.unlock();
+		task->run();
+		delete task;
+		return true;
 	}
 
-	auto data = std::move(mQueueData.front());
-	mQueueData.pop();
-	return data;
+	return false;
 }
 
 bool MediaQueue::isEmpty()
 {
 	std::unique_lock<std::mutex> lock(mQueueMtx);
-	return mQueueData.empty();
+	return mCount == 0 && mOverflow.empty();
 }
 } // namespace media
@@ -19,14 +19,63 @@
 #ifndef __MEDIA_QUEUE_H
 #define __MEDIA_QUEUE_H
 
+#include <tinyara/config.h>
 #include <mutex>
-#include <condition_variable>
 #include <queue>
-#include <atomic>
-#include <iostream>
+#include <new>
+#include <type_traits>
 #include <functional>
 
+#ifndef CONFIG_MEDIA_WORKER_QUEUE_SIZE
+#define CONFIG_MEDIA_WORKER_QUEUE_SIZE 16
+#endif
+
 namespace media {
+/**
+ * A callable bound with its arguments (see std::bind), which is stored in
+ * place so queuing it does not allocate memory.
+ */
+class MediaTask
+{
+public:
+	// A member function, a shared_ptr and a few more arguments fit
+	static const size_t STORAGE_SIZE = 12 * sizeof(void *);
+
+	MediaTask() : mInvoke(nullptr), mDestroy(nullptr) {}
+	~MediaTask() { reset(); }
+	MediaTask(const MediaTask &) = delete;
+	MediaTask &operator=(const MediaTask &) = delete;
+
+	template <typename _Bound>
+	void set(_Bound &&__bound) {
+		typedef typename std::decay<_Bound>::type Bound;
+		static_assert(sizeof(Bound) <= STORAGE_SIZE, "MediaTask::STORAGE_SIZE is too small for the arguments");
+		static_assert(alignof(Bound) <= alignof(Storage), "MediaTask::Storage is not aligned for the arguments");
+		reset();
+		new (&mStorage) Bound(std::forward<_Bound>(__bound));
+		mInvoke = &invoke<Bound>;
+		mDestroy = &destroy<Bound>;
+	}
+	void run() { mInvoke(&mStorage); }
+	void reset();
+
+private:
+	template <typename Bound>
+	static void invoke(void *bound) { (*static_cast<Bound *>(bound))(); }
+	template <typename Bound>
+	static void destroy(void *bound) { static_cast<Bound *>(bound)->~Bound(); }
+
+	typedef typename std::aligned_storage<STORAGE_SIZE>::type Storage;
+	Storage mStorage;
+	void (*mInvoke)(void *);
+	void (*mDestroy)(void *);
+};
+
+/**
+ * Tasks of one MediaWorker, in CONFIG_MEDIA_WORKER_QUEUE_SIZE fixed slots.
+ * When all slots are in use, further tasks are allocated on the heap rather
+ * than blocking the caller, which may be the worker of the other side.
+ */
 class MediaQueue
 {
 public:
@@ -35,16 +84,28 @@ public:
 	template <typename _Callable, typename... _Args>
 	void enQueue(_Callable &&__f, _Args &&... __args) {
 		std::unique_lock<std::mutex> lock(mQueueMtx);
-		std::function<void()> func = std::bind(std::forward<_Callable>(__f), std::forward<_Args>(__args)...);
-		mQueueData.push(func);
-		mQueueCv.notify_one();
+		MediaTask *task = allocTask();
+		if (task) {
+			task->set(std::bind(std::forward<_Callable>(__f), std::forward<_Args>(__args)...));
+			pushTask(task);
+		}
 	}
-	std::function<void()> deQueue();
+	/**
+	 * Run the oldest task in the calling thread.
+	 * Only one thread runs the tasks at a time.
+	 * @return false if there's no task.
+	 */
+	bool runOne();
 	bool isEmpty();
 
 private:
-	std::queue<std::function<void()>> mQueueData;
-	std::condition_variable mQueueCv;
+	MediaTask *allocTask();
+	void pushTask(MediaTask *task);
+
+	MediaTask mSlots[CONFIG_MEDIA_WORKER_QUEUE_SIZE];
+	size_t mHead;
+	size_t mCount;
+	std::queue<MediaTask *> mOverflow;
 	std::mutex mQueueMtx;
 };
 } // namespace media
@@ -17,20 +17,18 @@
  ******************************************************************/
 
 #include <debug.h>
-#include <sched.h>
-#include <pthread.h>
 
 #include "MediaWorker.h"
 
 namespace media {
 
-MediaWorker::MediaWorker() :
-	mStacksize(PTHREAD_STACK_DEFAULT),
-	mPriority(100),
-	mThreadName("MediaWorker"),
-	mIsRunning(false),
+MediaWorker::MediaWorker(MediaExecutor &executor) :
+	mWorkerName("MediaWorker"),
+	mExecutor(executor),
 	mRefCnt(0),
-	mWorkerThread(0)
+	mState(STATE_IDLE),
+	mRescheduled(false),
+	mNextReady(nullptr)
 {
 	medvdbg("MediaWorker::MediaWorker()\n");
 }
@@ -43,47 +41,32 @@ void MediaWorker::startWorker()
 {
 	std::unique_lock<std::mutex> lock(mRefMtx);
 	++mRefCnt;
-	medvdbg("%s::startWorker() - increase RefCnt : %d\n", mThreadName, mRefCnt);
+	medvdbg("%s::startWorker() - increase RefCnt : %d\n", mWorkerName, mRefCnt);
 	if (mRefCnt == 1) {
-		int ret;
-		struct sched_param sparam;
-		pthread_attr_t attr;
-		pthread_attr_init(&attr);
-		pthread_attr_setstacksize(&attr, mStacksize);
-		sparam.sched_priority = mPriority;
-		pthread_attr_setschedparam(&attr, &sparam);
-		mIsRunning = true;
-		ret = pthread_create(&mWorkerThread, &attr, static_cast<pthread_startroutine_t>(MediaWorker::mediaLooper), this);
-		if (ret != OK) {
-			medvdbg("Fail to create worker thread, return value : %d\n", ret);
+		if (!mExecutor.attach()) {
+			medvdbg("Fail to attach to the executor\n");
 			--mRefCnt;
-			mIsRunning = false;
 			return;
 		}
-		pthread_setname_np(mWorkerThread, mThreadName);
+		// Tasks may be queued before starting
+		mExecutor.schedule(this);
 	}
 }
 
 void MediaWorker::stopWorker()
 {
 	std::unique_lock<std::mutex> lock(mRefMtx);
-	if (mRefCnt > 0) {
-		--mRefCnt;
-	}
-	medvdbg("%s::stopWorker() - decrease RefCnt : %d\n", mThreadName, mRefCnt);
 	if (mRefCnt <= 0) {
-		std::atomic<bool> &refBool = mIsRunning;
-		mWorkerQueue.enQueue([&refBool]() {
-			refBool = false;
-		});
-		pthread_join(mWorkerThread, NULL);
-		medvdbg("%s::stopWorker() - mWorkerthread exited\n", mThreadName);
+		return;
+	}
+	--mRefCnt;
+	medvdbg("%s::stopWorker() - decrease RefCnt : %d\n", mWorkerName, mRefCnt);
+	if (mRefCnt == 0) {
+		// Run the remaining tasks before releasing the threads
+		mExecutor.drain(this);
+		mExecutor.detach();
+		medvdbg("%s::stopWorker() - detached\n", mWorkerName);
 	}
-}
-
-std::function<void()> MediaWorker::deQueue()
-{
-	return mWorkerQueue.deQueue();
 }
 
 bool MediaWorker::processLoop()
@@ -91,21 +74,15 @@ bool MediaWorker::processLoop()
 	return false;
 }
 
-void *MediaWorker::mediaLooper(void *arg)
+bool MediaWorker::runOnce()
 {
-	auto worker = static_cast<MediaWorker *>(arg);
-	medvdbg("MediaWorker : mediaLooper\n");
-
-	while (worker->mIsRunning) {
-		while (worker->processLoop() && worker->mWorkerQueue.isEmpty());
-
-		std::function<void()> run = worker->deQueue();
-		medvdbg("MediaWorker : deQueue\n");
-		if (run != nullptr) {
-			run();
-		}
+	// Tasks go first, then one round of the loop
+	if (mWorkerQueue.runOne()) {
+		medvdbg("%s : task done\n", mWorkerName);
+		return true;
 	}
-	return NULL;
+
+	return processLoop();
 }
 
 bool MediaWorker::isAlive()
@@ -20,16 +20,20 @@
 #define __MEDIA_MEDIAWORKER_HPP
 
 #include <sys/types.h>
-#include <atomic>
 #include <mutex>
 
 #include "MediaQueue.h"
+#include "MediaExecutor.h"
 
 namespace media {
+/**
+ * Runs tasks in order on the threads of a MediaExecutor.
+ * In between the tasks, processLoop() is run as long as it returns true.
+ */
 class MediaWorker
 {
 public:
-	MediaWorker();
+	MediaWorker(MediaExecutor &executor);
 	virtual ~MediaWorker();
 
 	void startWorker();
@@ -38,24 +42,31 @@ public:
 	template <typename _Callable, typename... _Args>
 	void enQueue(_Callable &&__f, _Args &&... __args) {
 		mWorkerQueue.enQueue(__f, __args...);
+		mExecutor.schedule(this);
 	}
-	std::function<void()> deQueue();
 	bool isAlive();
 
 protected:
-	long mStacksize;
-	int mPriority;
-	const char *mThreadName;
+	const char *mWorkerName;
 	virtual bool processLoop();
 
 private:
-	static void *mediaLooper(void *);
+	friend class MediaExecutor;
+	enum worker_state_e {
+		STATE_IDLE,
+		STATE_READY,
+		STATE_RUNNING,
+	};
+	bool runOnce();
 
+	MediaExecutor &mExecutor;
 	MediaQueue mWorkerQueue;
-	std::atomic<bool> mIsRunning;
 	int mRefCnt;
-	pthread_t mWorkerThread;
 	std::mutex mRefMtx;
+	// Scheduling state, guarded by the executor
+	worker_state_e mState;
+	bool mRescheduled;
+	MediaWorker *mNextReady;
 };
 } // namespace media
 #endif
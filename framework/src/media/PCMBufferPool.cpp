@@ -0,0 +1,203 @@
+/******************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#include <debug.h>
+
+#include "PCMBufferPool.h"
+
+namespace media {
+namespace stream {
+
+PCMBufferPool::PCMBufferPool() :
+	mBuffers(nullptr),
+	mData(nullptr),
+	mCount(0),
+	mBufferSize(0),
+	mHead(0),
+	mDecoded(0),
+	mEOS(false),
+	mStopped(false),
+	mStarving(false),
+	mStarted(false),
+	mMinDecoded(0),
+	mUnderruns(0)
+{
+}
+
+PCMBufferPool::~PCMBufferPool()
+{
+	release();
+}
+
+bool PCMBufferPool::init(size_t count, size_t size)
+{
+	release();
+
+	if (count == 0 || size == 0) {
+		meddbg("invalid pool, count %u size %u\n", count, size);
+		return false;
+	}
+
+	mBuffers = new Buffer[count];
+	mData = new unsigned char[count * size];
+	if (!mBuffers || !mData) {
+		meddbg("run out of memory! count %u size %u\n", count, size);
+		release();
+		return false;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		mBuffers[i].data = mData + i * size;
+	}
+	mCount = count;
+	mBufferSize = size;
+	reset();
+	resetStatistics();
+	return true;
+}
+
+void PCMBufferPool::release()
+{
+	delete[] mBuffers;
+	delete[] mData;
+	mBuffers = nullptr;
+	mData = nullptr;
+	mCount = 0;
+	mBufferSize = 0;
+}
+
+void PCMBufferPool::reset()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	mHead = 0;
+	mDecoded = 0;
+	mEOS = false;
+	mStopped = false;
+	mStarving = false;
+	mStarted = false;
+}
+
+void PCMBufferPool::stop()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	mStopped = true;
+	mFreeCondv.notify_all();
+	mDecodedCondv.notify_all();
+}
+
+PCMBufferPool::Buffer *PCMBufferPool::getFree()
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+	while (mDecoded == mCount && !mStopped) {
+		mFreeCondv.wait(lock);
+	}
+
+	if (mStopped) {
+		return nullptr;
+	}
+
+	Buffer *buffer = &mBuffers[(mHead + mDecoded) % mCount];
+	buffer->size = 0;
+	buffer->offset = 0;
+	return buffer;
+}
+
+void PCMBufferPool::putDecoded(Buffer *buffer)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	mDecoded++;
+	mDecodedCondv.notify_one();
+}
+
+void PCMBufferPool::setEndOfStream()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	mEOS = true;
+	mDecodedCondv.notify_one();
+}
+
+PCMBufferPool::Buffer *PCMBufferPool::getDecoded(std::chrono::milliseconds timeout)
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+	if (mDecoded == 0 && !mEOS && !mStopped) {
+		// Playback ran ahead of decoding, count it once until it catches up
+		if (mStarted && !mStarving) {
+			mStarving = true;
+			mUnderruns++;
+			medvdbg("underrun %u\n", mUnderruns);
+		}
+		mDecodedCondv.wait_for(lock, timeout, [this] { return mDecoded > 0 || mEOS || mStopped; });
+	}
+
+	if (mDecoded == 0) {
+		if (mStarving) {
+			mMinDecoded = 0;
+		}
+		return nullptr;
+	}
+
+	// Level the output found, before taking its buffer
+	if (mDecoded < mMinDecoded) {
+		mMinDecoded = mDecoded;
+	}
+	mStarted = true;
+	mStarving = false;
+	return &mBuffers[mHead];
+}
+
+void PCMBufferPool::putFree(Buffer *buffer)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	mHead = (mHead + 1) % mCount;
+	mDecoded--;
+	mFreeCondv.notify_one();
+}
+
+bool PCMBufferPool::isEndOfStream()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mEOS && mDecoded == 0;
+}
+
+size_t PCMBufferPool::sizeOfDecoded()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mDecoded;
+}
+
+size_t PCMBufferPool::getMinDecoded()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mMinDecoded;
+}
+
+unsigned int PCMBufferPool::getUnderrunCount()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mUnderruns;
+}
+
+void PCMBufferPool::resetStatistics()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	mMinDecoded = mCount;
+	mUnderruns = 0;
+}
+
+} // namespace stream
+} // namespace media
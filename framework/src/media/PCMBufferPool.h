@@ -0,0 +1,125 @@
+/******************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#ifndef __MEDIA_PCMBUFFERPOOL_H
+#define __MEDIA_PCMBUFFERPOOL_H
+
+#include <sys/types.h>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+
+namespace media {
+namespace stream {
+
+/**
+ * Preallocated PCM buffers passed from one decoding thread to one output
+ * thread, in order. The decoder fills free buffers ahead of the output,
+ * which plays and releases them.
+ */
+class PCMBufferPool
+{
+public:
+	typedef std::chrono::steady_clock clock;
+
+	struct Buffer {
+		unsigned char *data;
+		// Decoded bytes
+		size_t size;
+		// Bytes already output
+		size_t offset;
+		// When the encoded data of the first sample was fetched
+		clock::time_point stamp;
+	};
+
+	PCMBufferPool();
+	~PCMBufferPool();
+
+	/**
+	 * Allocate count buffers of size bytes.
+	 */
+	bool init(size_t count, size_t size);
+	void release();
+	/**
+	 * Free all buffers and clear end-of-stream, the statistics are kept.
+	 */
+	void reset();
+	/**
+	 * Wake up both sides, getFree() returns nullptr until reset().
+	 */
+	void stop();
+
+	/**
+	 * Get the next buffer to fill, waiting until one is free.
+	 * @return nullptr if stopped.
+	 */
+	Buffer *getFree();
+	/**
+	 * Pass the buffer from getFree() to the output.
+	 */
+	void putDecoded(Buffer *buffer);
+	/**
+	 * No more buffers will be decoded.
+	 */
+	void setEndOfStream();
+
+	/**
+	 * Get the next buffer to output, waiting up to timeout for it.
+	 * It counts an underrun when the decoder fell behind the output.
+	 * @return nullptr on timeout, on end of stream or if stopped.
+	 */
+	Buffer *getDecoded(std::chrono::milliseconds timeout);
+	/**
+	 * Free the buffer from getDecoded().
+	 */
+	void putFree(Buffer *buffer);
+	/**
+	 * All decoded buffers were output.
+	 */
+	bool isEndOfStream();
+
+	size_t getCount() { return mCount; }
+	size_t getBufferSize() { return mBufferSize; }
+	size_t sizeOfDecoded();
+	size_t getMinDecoded();
+	unsigned int getUnderrunCount();
+	void resetStatistics();
+
+private:
+	std::mutex mMutex;
+	std::condition_variable mFreeCondv;
+	std::condition_variable mDecodedCondv;
+	Buffer *mBuffers;
+	unsigned char *mData;
+	size_t mCount;
+	size_t mBufferSize;
+	// Ring of buffers: mDecoded buffers from mHead are decoded
+	size_t mHead;
+	size_t mDecoded;
+	bool mEOS;
+	bool mStopped;
+	// Statistics
+	bool mStarving;
+	bool mStarted;
+	size_t mMinDecoded;
+	unsigned int mUnderruns;
+};
+
+} // namespace stream
+} // namespace media
+#endif
@@ -21,15 +21,10 @@
 #include <debug.h>
 #include "PlayerObserverWorker.h"
 
-#ifndef CONFIG_MEDIA_PLAYER_OBSERVER_STACKSIZE
-#define CONFIG_MEDIA_PLAYER_OBSERVER_STACKSIZE 2048
-#endif
-
 namespace media {
-PlayerObserverWorker::PlayerObserverWorker()
+PlayerObserverWorker::PlayerObserverWorker() : MediaWorker(MediaExecutor::getObserverExecutor())
 {
-	mThreadName = "PlayerObserverWorker";
-	mStacksize = CONFIG_MEDIA_PLAYER_OBSERVER_STACKSIZE;
+	mWorkerName = "PlayerObserverWorker";
 }
 
 PlayerObserverWorker::~PlayerObserverWorker()
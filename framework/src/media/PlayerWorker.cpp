@@ -22,17 +22,12 @@
 #include "PlayerWorker.h"
 #include "MediaPlayerImpl.h"
 
-#ifndef CONFIG_MEDIA_PLAYER_STACKSIZE
-#define CONFIG_MEDIA_PLAYER_STACKSIZE 4096
-#endif
-
 using namespace std;
 
 namespace media {
-PlayerWorker::PlayerWorker() : mCurPlayer(nullptr)
+PlayerWorker::PlayerWorker() : MediaWorker(MediaExecutor::getPlayerExecutor()), mCurPlayer(nullptr)
 {
-	mThreadName = "PlayerWorker";
-	mStacksize = CONFIG_MEDIA_PLAYER_STACKSIZE;
+	mWorkerName = "PlayerWorker";
 }
 
 PlayerWorker::~PlayerWorker()
@@ -19,16 +19,11 @@
 #include <tinyara/config.h>
 #include "RecorderObserverWorker.h"
 
-#ifndef CONFIG_MEDIA_RECORDER_OBSERVER_STACKSIZE
-#define CONFIG_MEDIA_RECORDER_OBSERVER_STACKSIZE 2048
-#endif
-
 namespace media {
 
-RecorderObserverWorker::RecorderObserverWorker()
+RecorderObserverWorker::RecorderObserverWorker() : MediaWorker(MediaExecutor::getObserverExecutor())
 {
-	mThreadName = "RecorderObserverWorker";
-	mStacksize = CONFIG_MEDIA_RECORDER_OBSERVER_STACKSIZE;
+	mWorkerName = "RecorderObserverWorker";
 }
 RecorderObserverWorker::~RecorderObserverWorker()
 {
@@ -20,17 +20,12 @@
 #include <debug.h>
 #include "RecorderWorker.h"
 
-#ifndef CONFIG_MEDIA_RECORDER_STACKSIZE
-#define CONFIG_MEDIA_RECORDER_STACKSIZE 4096
-#endif
-
 namespace media {
 
-RecorderWorker::RecorderWorker()
+RecorderWorker::RecorderWorker() : MediaWorker(MediaExecutor::getRecorderExecutor())
 {
 	medvdbg("RecorderWorker::RecorderWorker()\n");
-	mThreadName = "RecorderWorker";
-	mStacksize = CONFIG_MEDIA_RECORDER_STACKSIZE;
+	mWorkerName = "RecorderWorker";
 }
 RecorderWorker::~RecorderWorker()
 {
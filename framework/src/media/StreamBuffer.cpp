@@ -45,8 +45,8 @@
 namespace media {
 namespace stream {
 
-StreamBuffer::StreamBuffer(size_t bufferSize, size_t threshold)
-	: mObserver(nullptr), mEOS(false), mBufferSize(bufferSize), mThreshold(threshold)
+StreamBuffer::StreamBuffer(size_t bufferSize, size_t threshold, bool lockFree)
+	: mObserver(nullptr), mEOS(false), mWaiters(0), mBufferSize(bufferSize), mThreshold(threshold), mLockFree(lockFree)
 {
 	mRingBuf.buf = nullptr;
 	mRingBuf.depth = 0;
@@ -92,6 +92,26 @@ size_t StreamBuffer::write(unsigned char *buf, size_t size)
 	return rb_write(&mRingBuf, buf, size);
 }
 
+size_t StreamBuffer::reserve(unsigned char **buf)
+{
+	return rb_reserve(&mRingBuf, (void **)buf);
+}
+
+size_t StreamBuffer::commit(size_t size)
+{
+	return rb_commit(&mRingBuf, size);
+}
+
+size_t StreamBuffer::peek(unsigned char **buf)
+{
+	return rb_peek(&mRingBuf, (void **)buf);
+}
+
+size_t StreamBuffer::consume(size_t size)
+{
+	return rb_read(&mRingBuf, nullptr, size);
+}
+
 size_t StreamBuffer::sizeOfSpace()
 {
 	return rb_avail(&mRingBuf);
@@ -112,6 +132,58 @@ bool StreamBuffer::isEndOfStream()
 	return mEOS;
 }
 
+std::unique_lock<std::mutex> StreamBuffer::getLock()
+{
+	if (mLockFree) {
+		return std::unique_lock<std::mutex>(mMutex, std::defer_lock);
+	}
+
+	return std::unique_lock<std::mutex>(mMutex);
+}
+
+void StreamBuffer::waitForData(std::unique_lock<std::mutex> &lock, size_t size)
+{
+	waitFor(lock, true, size);
+}
+
+void StreamBuffer::waitForSpace(std::unique_lock<std::mutex> &lock, size_t size)
+{
+	waitFor(lock, false, size);
+}
+
+void StreamBuffer::waitFor(std::unique_lock<std::mutex> &lock, bool forData, size_t size)
+{
+	if (!mLockFree) {
+		mCondv.wait(lock);
+		return;
+	}
+
+	// Count the waiter before checking the buffer, and wakeUp() checks the
+	// count after updating the buffer: at least one side sees the other one.
+	std::unique_lock<std::mutex> waitLock(mMutex);
+	mWaiters++;
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (!mEOS && (forData ? sizeOfData() : sizeOfSpace()) < size) {
+		mCondv.wait(waitLock);
+	}
+	mWaiters--;
+}
+
+void StreamBuffer::wakeUp()
+{
+	if (!mLockFree) {
+		mCondv.notify_one();
+		return;
+	}
+
+	// Both sides may be waiting a moment, when one was woken but not run yet
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (mWaiters > 0) {
+		std::lock_guard<std::mutex> lock(mMutex);
+		mCondv.notify_all();
+	}
+}
+
 void StreamBuffer::setObserver(BufferObserverInterface *observer)
 {
 	mObserver = observer;
@@ -140,7 +212,7 @@ void StreamBuffer::notifyObserver(State st, ...)
 }
 
 StreamBuffer::Builder::Builder()
-	: mBufferSize(CONFIG_STREAM_BUFFER_SIZE_DEFAULT), mThreshold(CONFIG_STREAM_BUFFER_THRESHOLD_DEFAULT)
+	: mBufferSize(CONFIG_STREAM_BUFFER_SIZE_DEFAULT), mThreshold(CONFIG_STREAM_BUFFER_THRESHOLD_DEFAULT), mLockFree(false)
 {
 }
 
@@ -166,13 +238,19 @@ StreamBuffer::Builder &StreamBuffer::Builder::setThreshold(size_t threshold)
 	return *this;
 }
 
+StreamBuffer::Builder &StreamBuffer::Builder::setLockFree(bool lockFree)
+{
+	mLockFree = lockFree;
+	return *this;
+}
+
 std::shared_ptr<StreamBuffer> StreamBuffer::Builder::build()
 {
 	if (mThreshold > mBufferSize) {
 		mThreshold = mBufferSize;
 	}
 
-	auto instance = std::make_shared<StreamBuffer>(mBufferSize, mThreshold);
+	auto instance = std::make_shared<StreamBuffer>(mBufferSize, mThreshold, mLockFree);
 	if (instance->init(mBufferSize)) {
 		return instance;
 	}
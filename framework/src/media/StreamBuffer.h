@@ -19,6 +19,7 @@
 #ifndef __MEDIA_STREAMBUFFER_H
 #define __MEDIA_STREAMBUFFER_H
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <condition_variable>
@@ -38,14 +39,19 @@ public:
 		Builder();
 		Builder &setBufferSize(size_t bufferSize);
 		Builder &setThreshold(size_t threshold);
+		/**
+		 * Build a lock-free buffer, see isLockFree().
+		 */
+		Builder &setLockFree(bool lockFree);
 		std::shared_ptr<StreamBuffer> build();
 
 	private:
 		size_t mBufferSize;
 		size_t mThreshold;
+		bool mLockFree;
 	};
 
-	StreamBuffer(size_t bufferSize, size_t threshold);
+	StreamBuffer(size_t bufferSize, size_t threshold, bool lockFree = false);
 	virtual ~StreamBuffer();
 	/**
 	 * Initialize stream buffer with specific buffer size.
@@ -63,6 +69,28 @@ public:
 	void setObserver(BufferObserverInterface *observer);
 	std::mutex &getMutex() { return mMutex; }
 	std::condition_variable &getCondv() { return mCondv; }
+	/**
+	 * A lock-free buffer supports exactly one reader thread and one writer
+	 * thread. Reading and writing do not take the mutex, it is only used
+	 * to sleep when the buffer is empty or full. Observers are notified from
+	 * both threads without serialization, so they must be thread-safe.
+	 */
+	bool isLockFree() { return mLockFree; }
+	/**
+	 * Get a lock of the mutex, which is not locked for a lock-free buffer.
+	 */
+	std::unique_lock<std::mutex> getLock();
+	/**
+	 * Wait for size bytes of data (or space) with the lock got from getLock(),
+	 * until the other side calls wakeUp() or the end-of-stream flag is set.
+	 * It may return earlier, callers check the buffer again.
+	 */
+	void waitForData(std::unique_lock<std::mutex> &lock, size_t size = 1);
+	void waitForSpace(std::unique_lock<std::mutex> &lock, size_t size = 1);
+	/**
+	 * Wake up the other side, which may be waiting for data or space.
+	 */
+	void wakeUp();
 
 public:
 	enum class State {
@@ -87,6 +115,26 @@ public:
 	 * Write(push) data into stream buffer.
 	 */
 	size_t write(unsigned char *buf, size_t size);
+	/**
+	 * Get the contiguous space at the write position, to be filled in place
+	 * and published by commit(). Return bytes of the space, which may be
+	 * less than sizeOfSpace() when the space wraps around.
+	 */
+	size_t reserve(unsigned char **buf);
+	/**
+	 * Publish data written to the space got from reserve().
+	 */
+	size_t commit(size_t size);
+	/**
+	 * Get the contiguous data at the read position, to be used in place and
+	 * released by consume(). Return bytes of the data, which may be less
+	 * than sizeOfData() when the data wraps around.
+	 */
+	size_t peek(unsigned char **buf);
+	/**
+	 * Release data got from peek().
+	 */
+	size_t consume(size_t size);
 	/**
 	 * Get bytes of data available in stream buffer.
 	 */
@@ -107,13 +155,17 @@ public:
 	size_t getThreshold() { return mThreshold; }
 
 private:
+	void waitFor(std::unique_lock<std::mutex> &lock, bool forData, size_t size);
+
 	std::mutex mMutex;
 	std::condition_variable mCondv;
 	BufferObserverInterface *mObserver;
 	rb_t mRingBuf;
-	bool mEOS;
+	std::atomic<bool> mEOS;
+	std::atomic<int> mWaiters;
 	size_t mBufferSize;
 	size_t mThreshold;
+	bool mLockFree;
 };
 
 } // namespace stream
@@ -36,7 +36,7 @@ StreamBufferReader::StreamBufferReader(std::shared_ptr<StreamBuffer> stream)
 size_t StreamBufferReader::copy(unsigned char *buf, size_t size, size_t offset)
 {
 	medvdbg("offset %lu, size %lu\n", offset, size);
-	std::lock_guard<std::mutex> lock(mStream->getMutex());
+	auto lock = mStream->getLock();
 	size_t len = mStream->copy(buf, size, offset);
 	medvdbg("copied %lu\n", len);
 	return len;
@@ -45,7 +45,7 @@ size_t StreamBufferReader::copy(unsigned char *buf, size_t size, size_t offset)
 size_t StreamBufferReader::read(unsigned char *buf, size_t size, bool sync)
 {
 	medvdbg("size %lu sync %c\n", size, sync ? 'Y' : 'N');
-	std::unique_lock<std::mutex> lock(mStream->getMutex());
+	auto lock = mStream->getLock();
 
 	size_t rlen = 0;
 
@@ -67,9 +67,9 @@ size_t StreamBufferReader::read(unsigned char *buf, size_t size, bool sync)
 				// Notify observer, shouldn't be blocked.
 				mStream->notifyObserver(StreamBuffer::State::UNDERRUN);
 				// Writer may be waiting for more spaces, so it's necessary to notify after reading.
-				mStream->getCondv().notify_one();
+				mStream->wakeUp();
 				// Then wait notification from writer.
-				mStream->getCondv().wait(lock);
+				mStream->waitForData(lock);
 			}
 		}
 
@@ -80,21 +80,58 @@ size_t StreamBufferReader::read(unsigned char *buf, size_t size, bool sync)
 	}
 
 	// Writer may be waiting for more spaces, so it's necessary to notify after reading.
-	mStream->getCondv().notify_one();
+	mStream->wakeUp();
 
 	medvdbg("read %lu\n", rlen);
 	return rlen;
 }
 
+size_t StreamBufferReader::peek(unsigned char **buf, size_t size, bool sync)
+{
+	medvdbg("size %lu sync %c\n", size, sync ? 'Y' : 'N');
+	auto lock = mStream->getLock();
+
+	// Never wait for more than the whole buffer
+	if (size > mStream->getBufferSize()) {
+		size = mStream->getBufferSize();
+	}
+
+	if (sync) {
+		while (mStream->sizeOfData() < size && !mStream->isEndOfStream()) {
+			mStream->notifyObserver(StreamBuffer::State::UNDERRUN);
+			mStream->wakeUp();
+			mStream->waitForData(lock, size);
+		}
+	}
+
+	size_t len = mStream->peek(buf);
+	medvdbg("peeked %lu\n", len);
+	return len;
+}
+
+size_t StreamBufferReader::consume(size_t size)
+{
+	auto lock = mStream->getLock();
+
+	size_t len = mStream->consume(size);
+	mStream->notifyObserver(StreamBuffer::State::UPDATED, -((ssize_t) len));
+
+	// Writer may be waiting for more spaces, so it's necessary to notify after reading.
+	mStream->wakeUp();
+
+	medvdbg("consumed %lu\n", len);
+	return len;
+}
+
 size_t StreamBufferReader::sizeOfData()
 {
-	std::lock_guard<std::mutex> lock(mStream->getMutex());
+	auto lock = mStream->getLock();
 	return mStream->sizeOfData();
 }
 
 bool StreamBufferReader::isEndOfStream()
 {
-	std::lock_guard<std::mutex> lock(mStream->getMutex());
+	auto lock = mStream->getLock();
 	return mStream->isEndOfStream();
 }
 
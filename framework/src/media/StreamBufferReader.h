@@ -33,6 +33,16 @@ public:
 public:
 	virtual size_t copy(unsigned char *buf, size_t size, size_t offset = 0);
 	virtual size_t read(unsigned char *buf, size_t size, bool sync = true);
+	/**
+	 * Get the contiguous data at the read position to use it in place,
+	 * after waiting for size bytes of data or end-of-stream if sync.
+	 * The returned bytes may be less than size when the data wraps around.
+	 */
+	virtual size_t peek(unsigned char **buf, size_t size, bool sync = true);
+	/**
+	 * Release data got from peek().
+	 */
+	virtual size_t consume(size_t size);
 	virtual size_t sizeOfData();
 
 public:
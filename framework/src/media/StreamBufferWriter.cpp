@@ -36,7 +36,7 @@ StreamBufferWriter::StreamBufferWriter(std::shared_ptr<StreamBuffer> stream)
 size_t StreamBufferWriter::write(unsigned char *buf, size_t size, bool sync)
 {
 	medvdbg("size %lu sync %c\n", size, sync ? 'Y' : 'N');
-	std::unique_lock<std::mutex> lock(mStream->getMutex());
+	auto lock = mStream->getLock();
 
 	size_t wlen = 0;
 
@@ -59,9 +59,9 @@ size_t StreamBufferWriter::write(unsigned char *buf, size_t size, bool sync)
 				// Notify observer, shouldn't be blocked.
 				mStream->notifyObserver(StreamBuffer::State::OVERRUN);
 				// Reader may be waiting for more data, so it's necessary to notify after writing.
-				mStream->getCondv().notify_one();
+				mStream->wakeUp();
 				// Then wait notification from reader.
-				mStream->getCondv().wait(lock);
+				mStream->waitForSpace(lock);
 			}
 		}
 	} else {
@@ -70,27 +70,70 @@ size_t StreamBufferWriter::write(unsigned char *buf, size_t size, bool sync)
 	}
 
 	// Reader may be waiting for more data, so it's necessary to notify after writing.
-	mStream->getCondv().notify_one();
+	mStream->wakeUp();
 
 	medvdbg("written %lu\n", wlen);
 	return wlen;
 }
 
+size_t StreamBufferWriter::reserve(unsigned char **buf, size_t size, bool sync)
+{
+	medvdbg("size %lu sync %c\n", size, sync ? 'Y' : 'N');
+	auto lock = mStream->getLock();
+
+	// Never wait for more than the whole buffer
+	if (size > mStream->getBufferSize()) {
+		size = mStream->getBufferSize();
+	}
+
+	if (sync) {
+		while (mStream->sizeOfSpace() < size && !mStream->isEndOfStream()) {
+			mStream->notifyObserver(StreamBuffer::State::OVERRUN);
+			mStream->wakeUp();
+			mStream->waitForSpace(lock, size);
+		}
+	}
+
+	// Streaming may be stopped (EOS was set)
+	if (mStream->isEndOfStream()) {
+		medvdbg("EOS break\n");
+		return 0;
+	}
+
+	size_t len = mStream->reserve(buf);
+	medvdbg("reserved %lu\n", len);
+	return len;
+}
+
+size_t StreamBufferWriter::commit(size_t size)
+{
+	auto lock = mStream->getLock();
+
+	size_t len = mStream->commit(size);
+	mStream->notifyObserver(StreamBuffer::State::UPDATED, (ssize_t) len);
+
+	// Reader may be waiting for more data, so it's necessary to notify after writing.
+	mStream->wakeUp();
+
+	medvdbg("committed %lu\n", len);
+	return len;
+}
+
 size_t StreamBufferWriter::sizeOfSpace()
 {
-	std::lock_guard<std::mutex> lock(mStream->getMutex());
+	auto lock = mStream->getLock();
 	return mStream->sizeOfSpace();
 }
 
 void StreamBufferWriter::setEndOfStream()
 {
-	std::lock_guard<std::mutex> lock(mStream->getMutex());
+	auto lock = mStream->getLock();
 
 	// Set EOS flag in stream.
 	mStream->setEndOfStream();
 
 	// Reader may be waiting for more data, so it's necessary to notify.
-	mStream->getCondv().notify_one();
+	mStream->wakeUp();
 }
 
 } // namespace stream
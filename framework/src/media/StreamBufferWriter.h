@@ -32,6 +32,17 @@ public:
 
 public:
 	virtual size_t write(unsigned char *buf, size_t size, bool sync = true);
+	/**
+	 * Get the contiguous space at the write position to fill it in place,
+	 * after waiting for size bytes of space if sync. Return 0 once
+	 * end-of-stream was set. The returned bytes may be less than size when
+	 * the space wraps around.
+	 */
+	virtual size_t reserve(unsigned char **buf, size_t size, bool sync = true);
+	/**
+	 * Publish data written to the space got from reserve().
+	 */
+	virtual size_t commit(size_t size);
 	virtual size_t sizeOfSpace();
 
 public:
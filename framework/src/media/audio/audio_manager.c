@@ -30,9 +30,12 @@
 #include <mqueue.h>
 #include <tinyara/audio/audio.h>
 #include <tinyalsa/tinyalsa.h>
+#include <media/samplerate.h>
+#ifdef CONFIG_AUDIO_SOFTWARE_VOLUME
+#include <media/audio_dsp.h>
+#endif
 
 #include "audio_manager.h"
-#include "resample/samplerate.h"
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -118,6 +121,9 @@ struct audio_device_config_s {
 	enum audio_card_status_e status;
 	uint8_t volume;
 	uint8_t max_volume;
+#ifdef CONFIG_AUDIO_SOFTWARE_VOLUME
+	int16_t gain;               // Q12 gain of the output volume, applied to the samples
+#endif
 	audio_device_type_t device_type;
 	device_process_type_t device_process_type;
 	mqd_t process_handler;
@@ -146,6 +152,10 @@ struct audio_card_info_s {
 	struct pcm *pcm;
 	stream_policy_t policy;
 	struct audio_resample_s resample;
+#ifdef CONFIG_AUDIO_SOFTWARE_VOLUME
+	void *gain_buffer;          // buffer of the output samples scaled by the software volume
+	uint32_t gain_buffer_size;  // size in bytes of the gain buffer
+#endif
 	pthread_mutex_t card_mutex;
 };
 
@@ -242,6 +252,12 @@ static audio_manager_result_t find_audio_card(audio_io_direction_t direct)
 		if (type == type_chr) {
 			pthread_mutex_lock(&(card[card_id].card_mutex));
 			card[card_id].config[device_id].status = AUDIO_CARD_IDLE;
+#ifdef CONFIG_AUDIO_SOFTWARE_VOLUME
+			if (direct == OUTPUT) {
+				card[card_id].config[device_id].volume = AUDIO_DEVICE_MAX_VOLUME;
+				card[card_id].config[device_id].gain = AUDIO_DSP_GAIN_ONE;
+			}
+#endif
 			card[card_id].card_id = card_id;
 			card[card_id].device_id = device_id;
 			found_cards++;
@@ -516,6 +532,13 @@ static audio_manager_result_t get_audio_volume(audio_io_direction_t direct)
 	audio_config_t *config;
 	char card_path[AUDIO_DEVICE_FULL_PATH_LENGTH];
 
+#ifdef CONFIG_AUDIO_SOFTWARE_VOLUME
+	/* The output volume is not read back from the device, see set_audio_volume() */
+	if (direct == OUTPUT) {
+		return AUDIO_MANAGER_SUCCESS;
+	}
+#endif
+
 	caps_desc.caps.ac_len = sizeof(struct audio_caps_s);
 	caps_desc.caps.ac_type = AUDIO_TYPE_FEATURE;
 
@@ -566,6 +589,22 @@ static audio_manager_result_t set_audio_volume(audio_io_direction_t direct, uint
 		volume = AUDIO_DEVICE_MAX_VOLUME;
 	}
 
+#ifdef CONFIG_AUDIO_SOFTWARE_VOLUME
+	/* Scale the samples in start_audio_stream_out() instead of configuring the device */
+	if (direct == OUTPUT) {
+		card = &g_audio_out_cards[g_actual_audio_out_card_id];
+		config = &card->config[card->device_id];
+
+		pthread_mutex_lock(&card->card_mutex);
+		config->volume = volume;
+		config->gain = volume * AUDIO_DSP_GAIN_ONE / AUDIO_DEVICE_MAX_VOLUME;
+		pthread_mutex_unlock(&card->card_mutex);
+
+		medvdbg("Volume = %d (gain %d)\n", volume, config->gain);
+		return AUDIO_MANAGER_SUCCESS;
+	}
+#endif
+
 	/* get system volume before set */
 	ret = get_audio_volume(direct);
 	if (ret != AUDIO_MANAGER_SUCCESS) {
@@ -968,6 +1007,30 @@ int start_audio_stream_out(void *data, unsigned int frames)
 		frames = card->resample.frames;
 	}
 
+#ifdef CONFIG_AUDIO_SOFTWARE_VOLUME
+	if (card->config[card->device_id].gain != AUDIO_DSP_GAIN_ONE) {
+		unsigned int size = get_card_output_frames_to_byte(frames);
+		void *gain_data = data;
+
+		// The caller's data is read-only, so scale it into the gain buffer unless it was resampled
+		if (!card->resample.necessary) {
+			if (card->gain_buffer_size < size) {
+				gain_data = realloc(card->gain_buffer, size);
+				if (!gain_data) {
+					meddbg("realloc for a gain buffer is failed, size = %u\n", size);
+					ret = AUDIO_MANAGER_OPERATION_FAIL;
+					goto error_with_lock;
+				}
+				card->gain_buffer = gain_data;
+				card->gain_buffer_size = size;
+			}
+			gain_data = card->gain_buffer;
+		}
+		audio_dsp_gain_s16((const int16_t *)data, (int16_t *)gain_data, size / sizeof(int16_t), card->config[card->device_id].gain);
+		data = gain_data;
+	}
+#endif
+
 	if (card->config[card->device_id].status == AUDIO_CARD_PAUSE) {
 		ret = ioctl(pcm_get_file_descriptor(card->pcm), AUDIOIOC_RESUME, 0UL);
 		if (ret < 0) {
@@ -1201,6 +1264,14 @@ audio_manager_result_t reset_audio_stream_out(void)
 		}
 	}
 
+#ifdef CONFIG_AUDIO_SOFTWARE_VOLUME
+	if (card->gain_buffer) {
+		free(card->gain_buffer);
+		card->gain_buffer = NULL;
+		card->gain_buffer_size = 0;
+	}
+#endif
+
 	card->config[card->device_id].status = AUDIO_CARD_IDLE;
 	card->policy = STREAM_TYPE_MEDIA;
 
@@ -166,6 +166,7 @@ int start_audio_stream_in(void *data, unsigned int frames);
  *   Write the specified frame data to the output stream.
  *   If the output audio device have been paused, resume and proceed the writing.
  *   If the resampling flag is set, resamplings are performed for all target frames.
+ *   With CONFIG_AUDIO_SOFTWARE_VOLUME, the volume is applied to the frames in place.
  *
  * Input parameters:
  *   data: buffer to transfer the frame data
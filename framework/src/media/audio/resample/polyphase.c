@@ -0,0 +1,314 @@
+/******************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <media/samplerate.h>
+#include <media/audio_dsp.h>
+#include "polyphase.h"
+
+#if defined(__ARM_FEATURE_SIMD32) && __ARM_FEATURE_SIMD32
+#include <arm_acle.h>
+#define POLYPHASE_HAVE_DSP
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define POLYPHASE_HAVE_NEON
+#endif
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+// Pass band edge relative to the lower Nyquist frequency
+#define POLYPHASE_PASSBAND  (0.90f)
+
+#define POLYPHASE_PI        (3.14159265358979f)
+
+// Q15 coefficients
+#define Q15_SHIFT           (15)
+#define Q15_ONE             (1 << Q15_SHIFT)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+static int32_t gcd(int32_t a, int32_t b)
+{
+	int32_t t;
+
+	while (b != 0) {
+		t = a % b;
+		a = b;
+		b = t;
+	}
+
+	return a;
+}
+
+static int16_t clip(int32_t x)
+{
+	if (x < INT16_MIN) {
+		return INT16_MIN;
+	} else if (x > INT16_MAX) {
+		return INT16_MAX;
+	}
+
+	return x;
+}
+
+/**
+ * @brief   Portable kernel, the reference for the others.
+ *          It accumulates modulo 2^32 like SMLAD, so the partial sums may
+ *          wrap. The result is still exact: the Blackman windowed rows have
+ *          a sum of absolute coefficients below 1.9 in Q15, which bounds the
+ *          dot product of full scale samples below 2^31.
+ */
+static int32_t dot_scalar(const int16_t *x, const int16_t *h, int32_t ntaps)
+{
+	uint32_t sum = 0;
+	int32_t i;
+
+	for (i = 0; i < ntaps; i += 4) {
+		sum += (uint32_t)(x[i] * h[i]);
+		sum += (uint32_t)(x[i + 1] * h[i + 1]);
+		sum += (uint32_t)(x[i + 2] * h[i + 2]);
+		sum += (uint32_t)(x[i + 3] * h[i + 3]);
+	}
+
+	return (int32_t)sum;
+}
+
+#ifdef POLYPHASE_HAVE_DSP
+/**
+ * @brief   ARMv7E-M DSP extension kernel: two multiply-accumulates per SMLAD.
+ *          x is not always word aligned, the loads rely on unaligned access.
+ */
+static int32_t dot_dsp(const int16_t *x, const int16_t *h, int32_t ntaps)
+{
+	int16x2_t x01, x23, h01, h23;
+	int32_t sum = 0;
+	int32_t i;
+
+	for (i = 0; i < ntaps; i += 4) {
+		memcpy(&x01, x + i, sizeof(x01));
+		memcpy(&x23, x + i + 2, sizeof(x23));
+		memcpy(&h01, h + i, sizeof(h01));
+		memcpy(&h23, h + i + 2, sizeof(h23));
+		sum = __smlad(x01, h01, sum);
+		sum = __smlad(x23, h23, sum);
+	}
+
+	return sum;
+}
+#endif
+
+#ifdef POLYPHASE_HAVE_NEON
+/**
+ * @brief   Advanced SIMD kernel: eight multiply-accumulates per iteration
+ *          into four 32 bits lanes, which are summed at the end.
+ */
+static int32_t dot_neon(const int16_t *x, const int16_t *h, int32_t ntaps)
+{
+	int32x4_t acc = vdupq_n_s32(0);
+	int16x8_t xv, hv;
+	int32x2_t sum;
+	int32_t i;
+
+	for (i = 0; i < ntaps; i += 8) {
+		xv = vld1q_s16(x + i);
+		hv = vld1q_s16(h + i);
+		acc = vmlal_s16(acc, vget_low_s16(xv), vget_low_s16(hv));
+		acc = vmlal_s16(acc, vget_high_s16(xv), vget_high_s16(hv));
+	}
+
+	sum = vadd_s32(vget_low_s32(acc), vget_high_s32(acc));
+	sum = vpadd_s32(sum, sum);
+	return vget_lane_s32(sum, 0);
+}
+#endif
+
+/**
+ * @brief   Design the prototype low pass filter at nphases times the input
+ *          rate and split it into one row of coefficients per phase.
+ */
+static void design_filter(struct polyphase_s *pp)
+{
+	int32_t length = pp->nphases * pp->ntaps;
+	float center = (float)(length - 1) / 2;
+	float cutoff;
+	float t, w, h;
+	int32_t i, p, k;
+
+	// Cut off at the lower of both Nyquist frequencies, in cycles per sample
+	// of the upsampled signal.
+	cutoff = POLYPHASE_PASSBAND * 0.5f / (float)pp->nphases;
+	if (pp->step > pp->nphases) {
+		cutoff = POLYPHASE_PASSBAND * 0.5f / (float)pp->step;
+	}
+
+	for (i = 0; i < length; i++) {
+		// Windowed sinc with the gain of the interpolation
+		t = (float)i - center;
+		if (t == 0.0f) {
+			h = 2.0f * cutoff;
+		} else {
+			h = sinf(2.0f * POLYPHASE_PI * cutoff * t) / (POLYPHASE_PI * t);
+		}
+
+		// Blackman window
+		w = 0.42f - 0.5f * cosf(2.0f * POLYPHASE_PI * i / (length - 1)) + 0.08f * cosf(4.0f * POLYPHASE_PI * i / (length - 1));
+		h *= w * (float)pp->nphases;
+
+		// Coefficient i belongs to phase i % nphases, tap i / nphases. Each
+		// row is stored time reversed so that the kernels walk the input and
+		// the coefficients forward.
+		p = i % pp->nphases;
+		k = pp->ntaps - 1 - i / pp->nphases;
+		h *= Q15_ONE;
+		pp->coeff[p * pp->ntaps + k] = clip((int32_t)(h >= 0.0f ? h + 0.5f : h - 0.5f));
+	}
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+polyphase_dot_t polyphase_kernel(int kernel)
+{
+	switch (kernel) {
+	case SRC_KERNEL_AUTO:
+#if defined(POLYPHASE_HAVE_NEON)
+		return dot_neon;
+#elif defined(POLYPHASE_HAVE_DSP)
+		return dot_dsp;
+#else
+		return dot_scalar;
+#endif
+	case SRC_KERNEL_SCALAR:
+		return dot_scalar;
+#ifdef POLYPHASE_HAVE_DSP
+	case SRC_KERNEL_DSP:
+		return dot_dsp;
+#endif
+#ifdef POLYPHASE_HAVE_NEON
+	case SRC_KERNEL_NEON:
+		return dot_neon;
+#endif
+	default:
+		return NULL;
+	}
+}
+
+int polyphase_init(struct polyphase_s *pp, int in_rate, int out_rate, int max_frames)
+{
+	int32_t div = gcd(in_rate, out_rate);
+	int32_t decimation;
+	int32_t i;
+
+	memset(pp, 0, sizeof(struct polyphase_s));
+
+	pp->nphases = out_rate / div;
+	pp->step = in_rate / div;
+	if (pp->nphases > POLYPHASE_MAX_PHASES) {
+		return SRC_ERR_NOT_SUPPORT;
+	}
+
+	// A longer filter keeps the transition band when down resampling
+	decimation = (pp->step + pp->nphases - 1) / pp->nphases;
+	pp->ntaps = POLYPHASE_TAPS * decimation;
+
+	pp->coeff = (int16_t *)malloc(pp->nphases * pp->ntaps * sizeof(int16_t));
+	if (pp->coeff == NULL) {
+		return SRC_ERR_MALLOC_FAILED;
+	}
+
+	pp->planar_frames = max_frames;
+	for (i = 0; i < POLYPHASE_MAX_CH; i++) {
+		pp->planar[i] = (int16_t *)malloc(max_frames * sizeof(int16_t));
+		if (pp->planar[i] == NULL) {
+			polyphase_deinit(pp);
+			return SRC_ERR_MALLOC_FAILED;
+		}
+	}
+
+	design_filter(pp);
+	pp->dot = polyphase_kernel(SRC_KERNEL_AUTO);
+	return SRC_ERR_NO_ERROR;
+}
+
+void polyphase_deinit(struct polyphase_s *pp)
+{
+	int32_t i;
+
+	free(pp->coeff);
+	pp->coeff = NULL;
+
+	for (i = 0; i < POLYPHASE_MAX_CH; i++) {
+		free(pp->planar[i]);
+		pp->planar[i] = NULL;
+	}
+}
+
+int32_t polyphase_process(struct polyphase_s *pp, const int16_t *input, int32_t channels, int32_t *num_frames_in, int16_t *output, int32_t max_out)
+{
+	int32_t frames = *num_frames_in + pp->ntaps - 1;
+	int32_t step_int = pp->step / pp->nphases;
+	int32_t step_frac = pp->step % pp->nphases;
+	int32_t phase = pp->phase;
+	const int16_t *coeff;
+	const int16_t *x[POLYPHASE_MAX_CH];
+	int32_t pos = 0;
+	int32_t out = 0;
+	int32_t ch;
+
+	if (frames > pp->planar_frames || channels > POLYPHASE_MAX_CH) {
+		*num_frames_in = 0;
+		return 0;
+	}
+
+	// De-interleave once, so that the kernels read each channel contiguously
+	if (channels == 1) {
+		x[0] = input;
+	} else {
+		audio_dsp_deinterleave_s16(input, channels, pp->planar, frames);
+		x[0] = pp->planar[0];
+		x[1] = pp->planar[1];
+	}
+
+	while (pos < *num_frames_in && out < max_out) {
+		coeff = pp->coeff + phase * pp->ntaps;
+		for (ch = 0; ch < channels; ch++) {
+			*output++ = clip((pp->dot(x[ch] + pos, coeff, pp->ntaps) + (1 << (Q15_SHIFT - 1))) >> Q15_SHIFT);
+		}
+		out++;
+
+		pos += step_int;
+		phase += step_frac;
+		if (phase >= pp->nphases) {
+			phase -= pp->nphases;
+			pos++;
+		}
+	}
+
+	// pos may pass *num_frames_in by less than the decimation factor, which
+	// is covered by the ntaps - 1 frames after them.
+	*num_frames_in = pos;
+	pp->phase = phase;
+	return out;
+}
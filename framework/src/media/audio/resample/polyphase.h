@@ -0,0 +1,104 @@
+/******************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#ifndef POLYPHASE_H
+#define POLYPHASE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif	/* __cplusplus */
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+// Max channel num supported by the polyphase resampler
+#define POLYPHASE_MAX_CH        (2)
+
+// Max number of phases (interpolation factor after reducing the rates)
+#define POLYPHASE_MAX_PHASES    (256)
+
+// Taps per phase when up resampling, multiplied by the decimation factor
+// when down resampling. Multiple of 8 for the vector kernels.
+#define POLYPHASE_TAPS          (16)
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+/**
+ * @brief   Kernel computing the dot product of ntaps input samples with
+ *          ntaps Q15 coefficients. ntaps is a multiple of 8.
+ *          All kernels return exactly the same result.
+ */
+typedef int32_t (*polyphase_dot_t)(const int16_t *x, const int16_t *h, int32_t ntaps);
+
+/**
+ * @structure polyphase_s
+ * @brief     Polyphase FIR resampler converting by nphases / step.
+ *            Output frame i is computed from ntaps input frames with the
+ *            coefficients of phase (i * step) % nphases.
+ */
+struct polyphase_s {
+	int16_t *coeff;                     // nphases rows of ntaps Q15 coefficients, time reversed
+	int16_t *planar[POLYPHASE_MAX_CH];  // de-interleaved input of each channel
+	int32_t planar_frames;              // capability of each planar buffer in frames
+	int32_t nphases;                    // interpolation factor L
+	int32_t step;                       // decimation factor M
+	int32_t ntaps;                      // taps per phase
+	int32_t phase;                      // phase of the next output frame
+	polyphase_dot_t dot;                // selected kernel
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+/**
+ * @brief   Compute the phase tables for converting in_rate to out_rate.
+ * @param   max_frames: max number of input frames given to polyphase_process().
+ * @return  0 on success, SRC_ERR_NOT_SUPPORT if the ratio needs more than
+ *          POLYPHASE_MAX_PHASES phases, SRC_ERR_MALLOC_FAILED.
+ */
+int polyphase_init(struct polyphase_s *pp, int in_rate, int out_rate, int max_frames);
+
+/**
+ * @brief   Free the tables and buffers allocated by polyphase_init().
+ */
+void polyphase_deinit(struct polyphase_s *pp);
+
+/**
+ * @brief   Get the dot product kernel of the given SRC_KERNEL_* type.
+ * @return  NULL if the kernel is not supported by this build.
+ */
+polyphase_dot_t polyphase_kernel(int kernel);
+
+/**
+ * @brief   Resample interleaved frames.
+ * @param   input: *num_frames_in + ntaps - 1 interleaved frames.
+ * @param   num_frames_in: give the number of frames at which output frames
+ *          may start, retrieve number of frames used.
+ * @param   output: buffer for max_out interleaved frames.
+ * @return  number of frames generated.
+ */
+int32_t polyphase_process(struct polyphase_s *pp, const int16_t *input, int32_t channels, int32_t *num_frames_in, int16_t *output, int32_t max_out);
+
+#ifdef __cplusplus
+}		/* extern "C" */
+#endif	/* __cplusplus */
+
+#endif	/* POLYPHASE_H */
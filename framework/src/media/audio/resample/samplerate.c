@@ -24,12 +24,16 @@
 ** file at : https://github.com/erikd/libsamplerate/blob/master/COPYING
 */
 
+#include <tinyara/config.h>
 #include <stdio.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
-#include "samplerate.h"
+#include <media/samplerate.h>
+#ifdef CONFIG_AUDIO_RESAMPLER_POLYPHASE
+#include "polyphase.h"
+#endif
 #include "../../utils/remix.h"
 
 
@@ -119,6 +123,12 @@ struct src_context_s {
 	float ratio;            // (float)new_sample_rate / (float)old_sample_rate
 	float inverse_ratio;    // (float)old_sample_rate / (float)new_sample_rate
 	uint32_t fp_frac;       // fraction part value of last fixed point index
+	int out_frames;         // capability of the external output buffer in frames
+#ifdef CONFIG_AUDIO_RESAMPLER_POLYPHASE
+	int kernel;             // SRC_KERNEL_* selected by src_set_kernel()
+	bool polyphase_ready;   // polyphase tables computed for these rates
+	struct polyphase_s polyphase;
+#endif
 	/**
 	 * @brief   Function pointer to resampling process function
 	 * @param   src_context_t *: pointer to resampler object.
@@ -244,6 +254,17 @@ static int32_t downresample_int(src_context_t *src, int32_t *num_frames_in)
 	return num_frames_out;
 }
 
+#ifdef CONFIG_AUDIO_RESAMPLER_POLYPHASE
+/**
+ * It handles all ratios whose interpolation factor is at most POLYPHASE_MAX_PHASES,
+ * with precomputed phase tables instead of linear interpolation.
+ */
+static int32_t resample_polyphase(src_context_t *src, int32_t *num_frames_in)
+{
+	return polyphase_process(&src->polyphase, src->in_buffer, src->new_channel_num, num_frames_in, src->out_buffer, src->out_frames);
+}
+#endif
+
 /**
  * @brief   Do filtering once new frames added to internal buffer.
  * @param   src: pointer to resampler object.
@@ -361,6 +382,17 @@ static int init_src_context(src_context_t *src, src_data_t *src_data)
 		// TODO: Noises appeared in ratio 2.* cases, consider fir-filtering after converting process
 	}
 
+#ifdef CONFIG_AUDIO_RESAMPLER_POLYPHASE
+	// Prefer the polyphase filter, keep the functions above for the ratios it does not support
+	if (polyphase_init(&src->polyphase, src->old_sample_rate, src->new_sample_rate, src->in_buffer_frames) == SRC_ERR_NO_ERROR) {
+		src->polyphase.dot = polyphase_kernel(src->kernel);
+		src->polyphase_ready = true;
+		src->filter_coeff = NULL;
+		src->overlap_frames = src->polyphase.ntaps - 1;
+		src->src_func = resample_polyphase;
+	}
+#endif
+
 	return SRC_ERR_NO_ERROR;
 }
 
@@ -378,6 +410,10 @@ src_handle_t src_init(int size)
 	src->in_buffer_bytes = (((size + max_frame_size - 1) / max_frame_size) * max_frame_size);
 	src->in_buffer_frames = 0;
 	src->in_buffer = NULL;
+#ifdef CONFIG_AUDIO_RESAMPLER_POLYPHASE
+	src->kernel = SRC_KERNEL_AUTO;
+	src->polyphase_ready = false;
+#endif
 	// Other members will be initilized before first use,
 	// as soon as in_buffer allocated in init_src_context().
 
@@ -392,6 +428,12 @@ int src_destroy(src_handle_t handle)
 	free(src->in_buffer);
 	src->in_buffer = NULL;
 
+#ifdef CONFIG_AUDIO_RESAMPLER_POLYPHASE
+	if (src->polyphase_ready) {
+		polyphase_deinit(&src->polyphase);
+	}
+#endif
+
 	free(src);
 	return SRC_ERR_NO_ERROR;
 }
@@ -405,6 +447,25 @@ bool src_is_valid_ratio(float ratio)
 	return false;
 }
 
+int src_set_kernel(src_handle_t handle, int kernel)
+{
+	src_context_t *src = (src_context_t *)handle;
+	RETURN_VAL_IF_FAIL((src != NULL), SRC_ERR_BAD_PARAMS);
+
+#ifdef CONFIG_AUDIO_RESAMPLER_POLYPHASE
+	polyphase_dot_t dot = polyphase_kernel(kernel);
+	RETURN_VAL_IF_FAIL((dot != NULL), SRC_ERR_NOT_SUPPORT);
+
+	src->kernel = kernel;
+	if (src->polyphase_ready) {
+		src->polyphase.dot = dot;
+	}
+	return SRC_ERR_NO_ERROR;
+#else
+	return SRC_ERR_NOT_SUPPORT;
+#endif
+}
+
 int src_simple(src_handle_t handle, src_data_t *src_data)
 {
 	// Convert and check src_handle
@@ -442,6 +503,7 @@ int src_simple(src_handle_t handle, src_data_t *src_data)
 
 	// Update output buffer to src context (used in converting proccess functions)
 	src->out_buffer = (int16_t *)src_data->data_out;
+	src->out_frames = out_buffer_frames;
 
 	// Move remaining frames in internal buffer
 	if ((src->used_frames > 0) && (src->left_frames > 0)) {
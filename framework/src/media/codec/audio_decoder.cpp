@@ -26,9 +26,9 @@
 #include <pthread.h>
 #include <debug.h>
 #include <media/MediaTypes.h>
+#include <media/samplerate.h>
 #include "audio_decoder.h"
 #include "../utils/internal_defs.h"
-#include "../audio/resample/samplerate.h"
 
 using namespace media;
 
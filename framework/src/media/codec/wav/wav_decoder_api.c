@@ -22,9 +22,9 @@
 #include <string.h>
 #include <stdlib.h>
 #include <debug.h>
+#include <media/samplerate.h>
 #include "../../utils/internal_defs.h"
 #include "../../utils/rbs.h"
-#include "../../audio/resample/samplerate.h"
 #include "../audio_decoder.h"
 #include "wav_decoder_api.h"
 
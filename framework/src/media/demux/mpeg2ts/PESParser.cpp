@@ -68,6 +68,49 @@ bool PESParser::parse(std::shared_ptr<PESPacket> pPESPacket)
 	return parseStream(&pData[PES_PACKET_HEAD_BYTES], mPacketLength);
 }
 
+int PESParser::parseHeader(uint8_t *pData, uint16_t size, uint32_t *esDataLen)
+{
+	if (size < PES_PACKET_HEAD_BYTES + PES_STREAM_HEAD_BYTES) {
+		meddbg("PES header is split across TS packets, not supported!\n");
+		reset();
+		return -1;
+	}
+
+	mPacketStartCodePrefix = PACKET_START_CODE_PREFIX(pData);
+	mStreamId = STREAM_ID(pData);
+	mPacketLength = PACKET_LENGTH(pData);
+
+	if (mPacketStartCodePrefix != PES_PACKET_START_CODE_PREFIX) {
+		meddbg("Invalid PES packet, not match PES_PACKET_START_CODE_PREFIX!\n");
+		reset();
+		return -1;
+	}
+
+	if (!parseStream(&pData[PES_PACKET_HEAD_BYTES], mPacketLength)) {
+		return -1;
+	}
+
+	int headLen = PES_PACKET_HEAD_BYTES + PES_STREAM_HEAD_BYTES + mPESHeaderDataLength;
+	if (headLen > size) {
+		meddbg("PES header is split across TS packets, not supported!\n");
+		reset();
+		return -1;
+	}
+
+	if (mPacketLength == 0) {
+		// unbounded, the PES packet ends at the next one
+		*esDataLen = UINT32_MAX;
+	} else if (headLen <= PES_PACKET_HEAD_BYTES + mPacketLength) {
+		*esDataLen = PES_PACKET_HEAD_BYTES + mPacketLength - headLen;
+	} else {
+		meddbg("Packet length overflow!\n");
+		reset();
+		return -1;
+	}
+
+	return headLen;
+}
+
 bool PESParser::parseStream(uint8_t *pData, uint32_t size)
 {
 	if (mStreamId >= 0xc0 && mStreamId <= 0xdf) {
@@ -34,6 +34,12 @@ public:
 	virtual ~PESParser();
 	// parse PES packet, and the parser will add reference to the packet.
 	bool parse(std::shared_ptr<PESPacket> pPESPacket);
+	// parse PES packet header at the start of the given payload in place,
+	// the payload of the following TS packets is not needed.
+	// esDataLen, ES data length of the whole PES packet, UINT32_MAX if unbounded.
+	// on success, return length of the header, the ES data follow it.
+	// on failure, return negative value.
+	int parseHeader(uint8_t *pData, uint16_t size, uint32_t *esDataLen);
 	// get ES data in PES
 	uint8_t *getESData(void);
 	// get ES data length
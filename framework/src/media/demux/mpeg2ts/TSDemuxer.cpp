@@ -39,6 +39,8 @@
 #define TS_SYNC_COUNT               (3)
 // threshold is not used, we don't have any buffer observer now.
 #define TS_DEMUX_BUFFER_THRESHOLD   (CONFIG_DEMUX_BUFFER_SIZE / 2)
+// Continuity counter's module value
+#define CONTINUITY_COUNTER_MOD      (16)
 
 namespace media {
 
@@ -46,6 +48,12 @@ TSDemuxer::TSDemuxer()
 	: Demuxer(AUDIO_TYPE_MP2T)
 	, mPESPid(INVALID_PID)
 	, mPESDataUsed(0)
+#ifdef CONFIG_CONTAINER_MPEG2TS_IN_PLACE
+	, mESData(nullptr)
+	, mESDataLen(0)
+	, mPESRemaining(0)
+	, mContinuityCounter(0)
+#endif
 {
 }
 
@@ -143,6 +151,35 @@ ssize_t TSDemuxer::pullData(uint8_t *buf, size_t size, void *param)
 	int ret = DEMUXER_ERROR_NONE;
 	size_t fill = 0;
 	size_t need;
+#ifdef CONFIG_CONTAINER_MPEG2TS_IN_PLACE
+	while (fill < size) {
+		if (mESDataLen == 0) {
+			ret = loadESData();
+			if (ret == DEMUXER_ERROR_WANT_DATA) {
+				medvdbg("Push more data to get ES data\n");
+				break;
+			}
+
+			if (ret != DEMUXER_ERROR_NONE) {
+				meddbg("Get ES data failed! error: %d\n", ret);
+				break;
+			}
+		}
+
+		need = size - fill;
+		if (need > mESDataLen) {
+			need = mESDataLen;
+		}
+		memcpy(&buf[fill], mESData, need);
+		mESData += need;
+		mESDataLen -= need;
+		fill += need;
+		if (mESDataLen == 0) {
+			// all ES data in the TS packet have been read, release the packet.
+			mBufferReader->consume(TSPacket::PACKET_SIZE);
+		}
+	} // end while
+#else
 	while (fill < size) {
 		need = size - fill;
 		if (mPESParser->getESData() != nullptr) {
@@ -188,6 +225,7 @@ ssize_t TSDemuxer::pullData(uint8_t *buf, size_t size, void *param)
 			continue;
 		}
 	} // end while
+#endif
 
 	if (fill == 0) {
 		medvdbg("Got nothing, please check error: %d\n", ret);
@@ -449,6 +487,105 @@ int TSDemuxer::getPESPacket(std::shared_ptr<PESPacket> &pPESPacket)
 	return ret;
 }
 
+#ifdef CONFIG_CONTAINER_MPEG2TS_IN_PLACE
+int TSDemuxer::peekTSPacket(std::shared_ptr<TSPacket> pTSPacket)
+{
+	uint8_t *pData = nullptr;
+	uint8_t buffLen; // TSPacket::PACKET_SIZE
+	int syncOffset;
+
+	while (1) {
+		if (mBufferReader->peek(&pData, TSPacket::PACKET_SIZE, false) < TSPacket::PACKET_SIZE) {
+			// packet wraps around the end of the stream buffer, or it's incomplete.
+			pData = pTSPacket->getPacketBuffer(&buffLen);
+			if (mBufferReader->copy(pData, buffLen) != buffLen) {
+				// data in buffer is not enough!
+				return DEMUXER_ERROR_WANT_DATA;
+			}
+		}
+
+		if (pTSPacket->parse(pData)) {
+			return DEMUXER_ERROR_NONE;
+		}
+
+		syncOffset = resync(pData, 0);
+		if (syncOffset < 0) {
+			// sync failed, negative value means error code.
+			return syncOffset;
+		}
+		// drop bytes before the sync byte
+		mBufferReader->consume((size_t)syncOffset);
+	}
+}
+
+int TSDemuxer::loadESData(void)
+{
+	int ret;
+
+	while ((ret = peekTSPacket(mTSPacket)) == DEMUXER_ERROR_NONE) {
+		if (isPESPid(mTSPacket->getPid()) && unpackESData(mTSPacket)) {
+			return DEMUXER_ERROR_NONE;
+		}
+		// nothing to pull in this packet
+		mBufferReader->consume(TSPacket::PACKET_SIZE);
+	}
+
+	return ret;
+}
+
+bool TSDemuxer::unpackESData(std::shared_ptr<TSPacket> pTSPacket)
+{
+	uint8_t  lenPayload = 0;
+	uint8_t *ptrPayload = pTSPacket->getPayloadData(&lenPayload);
+	if (!ptrPayload) {
+		// no payload
+		return false;
+	}
+
+	if (pTSPacket->payloadUnitStartIndicator()) {
+		// new PES packet start
+		if (mPESRemaining != 0 && mPESRemaining != UINT32_MAX) {
+			meddbg("PES packet ends %u bytes early!\n", mPESRemaining);
+		}
+		int headLen = mPESParser->parseHeader(ptrPayload, lenPayload, &mPESRemaining);
+		if (headLen < 0) {
+			meddbg("PES parse failed!\n");
+			mPESRemaining = 0;
+			return false;
+		}
+		ptrPayload += headLen;
+		lenPayload -= headLen;
+	} else {
+		if (mPESRemaining == 0) {
+			// no PES packet in progress, wait for the next one.
+			return false;
+		}
+		if (pTSPacket->continuityCounter() == mContinuityCounter) {
+			// duplicate packet
+			return false;
+		}
+		if (pTSPacket->continuityCounter() != ((mContinuityCounter + 1) % CONTINUITY_COUNTER_MOD)) {
+			// ES data already pulled can't be taken back, so drop the rest of the PES packet.
+			meddbg("continuity counter(0x%x) do not match, current 0x%x, drop PES packet!\n", pTSPacket->continuityCounter(), mContinuityCounter);
+			mPESRemaining = 0;
+			return false;
+		}
+	}
+	mContinuityCounter = pTSPacket->continuityCounter();
+
+	if (mPESRemaining != UINT32_MAX) {
+		if (lenPayload > mPESRemaining) {
+			lenPayload = (uint8_t)mPESRemaining;
+		}
+		mPESRemaining -= lenPayload;
+	}
+
+	mESData = ptrPayload;
+	mESDataLen = lenPayload;
+	return (mESDataLen != 0);
+}
+#endif
+
 bool TSDemuxer::isReady(void)
 {
 	return (mParserManager->isPATReceived() && mParserManager->isPMTReceived());
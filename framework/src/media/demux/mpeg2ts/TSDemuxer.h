@@ -27,7 +27,7 @@
 #include <list>
 #include <memory>
 #include <media/MediaTypes.h>
-#include "../../Demuxer.h"
+#include <media/Demuxer.h>
 
 class ParserManager;
 class Section;
@@ -94,6 +94,21 @@ private:
 	std::shared_ptr<PESPacket> PESUnpack(std::shared_ptr<TSPacket> pTSPacket);
 	// resync TS packet by TSPacket::SYNC_BYTE
 	int resync(uint8_t *pPacketData, size_t offset);
+#ifdef CONFIG_CONTAINER_MPEG2TS_IN_PLACE
+	// parse the TS packet at the read position of the stream buffer in place,
+	// it's copied only if it wraps around the end of the buffer.
+	// return value:
+	// on success, return 0
+	// on failure, return negative value (see demuxer_error_e)
+	int peekTSPacket(std::shared_ptr<TSPacket> pTSPacket);
+	// skip TS packets until one carrying ES data of the audio PES, which is
+	// left at the read position with its ES data in mESData.
+	// return demuxer_error_e
+	int loadESData(void);
+	// get ES data in the payload of the TS packet, parsing the PES header in
+	// case of unit start. return false if the packet has no ES data for us.
+	bool unpackESData(std::shared_ptr<TSPacket> pTSPacket);
+#endif
 
 private:
 	// <pid, section_ptr> pairs in map to take incomplete sections
@@ -114,6 +129,17 @@ private:
 	std::shared_ptr<TSPacket> mTSPacket;
 	uint16_t mPESPid;
 	size_t mPESDataUsed;
+#ifdef CONFIG_CONTAINER_MPEG2TS_IN_PLACE
+	// ES data of the TS packet at the read position, not pulled yet.
+	// the PES packet is never reassembled, its ES data are pulled from the
+	// payload of each TS packet in the stream buffer, like a scatter list.
+	uint8_t *mESData;
+	size_t mESDataLen;
+	// ES data remaining in the current PES packet
+	uint32_t mPESRemaining;
+	// continuity counter of the last TS packet of the current PES packet
+	uint8_t mContinuityCounter;
+#endif
 };
 
 } // namespace media
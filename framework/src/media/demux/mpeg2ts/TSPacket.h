@@ -69,6 +69,9 @@ public:
 	// parse transport packet stored in packet data buffer
 	// get packet buffer and put data in the buffer firstly
 	bool parse(void);
+	// parse transport packet in the given 188 bytes in place, without copying
+	// them. the data must stay valid as long as the payload is used.
+	bool parse(uint8_t *pData);
 
 	// getters
 	ts_pid_t getPid(void) { return mPid; }
@@ -87,6 +90,8 @@ public:
 private:
 	// packet data array
 	uint8_t mData[PACKET_SIZE];
+	// packet parsed, mData or the data given to parse
+	uint8_t *mPacket;
 	// sync byte
 	uint8_t mSyncByte;
 	// transport error indicator
@@ -0,0 +1,702 @@
+/******************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ******************************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <media/audio_dsp.h>
+
+#if defined(__ARM_FEATURE_SIMD32) && __ARM_FEATURE_SIMD32 && defined(__ARM_FEATURE_DSP) && !defined(__ARM_BIG_ENDIAN)
+#include <arm_acle.h>
+#define AUDIO_DSP_HAVE_DSP
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define AUDIO_DSP_HAVE_NEON
+#endif
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+#define MIX_ROUND       (1 << (AUDIO_DSP_MIX_SHIFT - 1))
+#define GAIN_ROUND      (1 << (AUDIO_DSP_GAIN_SHIFT - 1))
+
+// Q15 full scale as float
+#define FLOAT_SCALE     (32768.0f)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+static inline int16_t clip(int32_t x)
+{
+	if (x < INT16_MIN) {
+		return INT16_MIN;
+	} else if (x > INT16_MAX) {
+		return INT16_MAX;
+	}
+
+	return x;
+}
+
+// Round to nearest, half away from zero, and saturate
+static inline int16_t float_round(float x)
+{
+	float v = x * FLOAT_SCALE;
+
+	v += v < 0.0f ? -0.5f : 0.5f;
+	if (v >= (float)INT16_MAX) {
+		return INT16_MAX;
+	} else if (v <= (float)INT16_MIN) {
+		return INT16_MIN;
+	}
+
+	return (int16_t)(int32_t)v;
+}
+
+/**
+ * @brief   Portable kernels, the reference for the others.
+ */
+static void remix_scalar(const int16_t *input, uint32_t in_ch, int16_t *output, uint32_t out_ch, const int16_t *matrix, uint32_t frames)
+{
+	int16_t frame[AUDIO_DSP_MAX_CH];
+	const int16_t *row;
+	int32_t sum;
+	uint32_t f, i, o;
+
+	for (f = 0; f < frames; f++) {
+		// Copy the frame first, the output may overwrite it
+		memcpy(frame, input, in_ch * sizeof(int16_t));
+		input += in_ch;
+
+		row = matrix;
+		for (o = 0; o < out_ch; o++) {
+			sum = 0;
+			for (i = 0; i < in_ch; i++) {
+				sum += frame[i] * row[i];
+			}
+			*output++ = clip((sum + MIX_ROUND) >> AUDIO_DSP_MIX_SHIFT);
+			row += in_ch;
+		}
+	}
+}
+
+static void gain_scalar(const int16_t *input, int16_t *output, uint32_t samples, int16_t gain)
+{
+	uint32_t i;
+
+	for (i = 0; i < samples; i++) {
+		output[i] = clip((input[i] * gain + GAIN_ROUND) >> AUDIO_DSP_GAIN_SHIFT);
+	}
+}
+
+static void s16_to_s32_scalar(const int16_t *input, int32_t *output, uint32_t samples)
+{
+	uint32_t i;
+
+	for (i = 0; i < samples; i++) {
+		output[i] = (int32_t)input[i] << 16;
+	}
+}
+
+static void s32_to_s16_scalar(const int32_t *input, int16_t *output, uint32_t samples)
+{
+	uint32_t i;
+
+	// (x + 0x8000) >> 16 without the overflow of the addition
+	for (i = 0; i < samples; i++) {
+		output[i] = clip((input[i] >> 16) + ((input[i] >> 15) & 1));
+	}
+}
+
+static void s16_to_float_scalar(const int16_t *input, float *output, uint32_t samples)
+{
+	uint32_t i;
+
+	for (i = 0; i < samples; i++) {
+		output[i] = (float)input[i] * (1.0f / FLOAT_SCALE);
+	}
+}
+
+static void float_to_s16_scalar(const float *input, int16_t *output, uint32_t samples)
+{
+	uint32_t i;
+
+	for (i = 0; i < samples; i++) {
+		output[i] = float_round(input[i]);
+	}
+}
+
+static void interleave_scalar(const int16_t *const *planar, uint32_t channels, int16_t *output, uint32_t frames)
+{
+	const int16_t *src;
+	int16_t *dst;
+	uint32_t ch, f;
+
+	for (ch = 0; ch < channels; ch++) {
+		src = planar[ch];
+		dst = output + ch;
+		for (f = 0; f < frames; f++) {
+			*dst = src[f];
+			dst += channels;
+		}
+	}
+}
+
+static void deinterleave_scalar(const int16_t *input, uint32_t channels, int16_t *const *planar, uint32_t frames)
+{
+	const int16_t *src;
+	int16_t *dst;
+	uint32_t ch, f;
+
+	for (ch = 0; ch < channels; ch++) {
+		src = input + ch;
+		dst = planar[ch];
+		for (f = 0; f < frames; f++) {
+			dst[f] = *src;
+			src += channels;
+		}
+	}
+}
+
+#if defined(AUDIO_DSP_HAVE_DSP) || defined(AUDIO_DSP_HAVE_NEON)
+/**
+ * @brief   Interleave or de-interleave the frames from start on with the
+ *          scalar kernel, after a vector kernel did the frames before.
+ */
+static void interleave_tail(const int16_t *const *planar, uint32_t channels, int16_t *output, uint32_t start, uint32_t frames)
+{
+	const int16_t *src[AUDIO_DSP_MAX_CH];
+	uint32_t ch;
+
+	for (ch = 0; ch < channels; ch++) {
+		src[ch] = planar[ch] + start;
+	}
+	interleave_scalar(src, channels, output + start * channels, frames - start);
+}
+
+static void deinterleave_tail(const int16_t *input, uint32_t channels, int16_t *const *planar, uint32_t start, uint32_t frames)
+{
+	int16_t *dst[AUDIO_DSP_MAX_CH];
+	uint32_t ch;
+
+	for (ch = 0; ch < channels; ch++) {
+		dst[ch] = planar[ch] + start;
+	}
+	deinterleave_scalar(input + start * channels, channels, dst, frames - start);
+}
+#endif
+
+#ifdef AUDIO_DSP_HAVE_DSP
+/**
+ * @brief   ARMv7E-M DSP extension kernels: two multiply-accumulates per
+ *          SMLAD, SSAT instead of compare and branch, halfword pairs moved
+ *          as words. Samples are not always word aligned, the loads rely on
+ *          unaligned access.
+ */
+static void remix_dsp(const int16_t *input, uint32_t in_ch, int16_t *output, uint32_t out_ch, const int16_t *matrix, uint32_t frames)
+{
+	int16_t frame[AUDIO_DSP_MAX_CH];
+	int16_t mixed[AUDIO_DSP_MAX_CH];
+	const int16_t *row;
+	int16x2_t x, m;
+	int32_t sum;
+	uint32_t f, i, o;
+
+	for (f = 0; f < frames; f++) {
+		memcpy(frame, input, in_ch * sizeof(int16_t));
+		input += in_ch;
+
+		row = matrix;
+		for (o = 0; o < out_ch; o++) {
+			sum = 0;
+			for (i = 0; i + 2 <= in_ch; i += 2) {
+				memcpy(&x, frame + i, sizeof(x));
+				memcpy(&m, row + i, sizeof(m));
+				sum = __smlad(x, m, sum);
+			}
+			if (i < in_ch) {
+				sum += frame[i] * row[i];
+			}
+			mixed[o] = __ssat((sum + MIX_ROUND) >> AUDIO_DSP_MIX_SHIFT, 16);
+			row += in_ch;
+		}
+
+		memcpy(output, mixed, out_ch * sizeof(int16_t));
+		output += out_ch;
+	}
+}
+
+static void gain_dsp(const int16_t *input, int16_t *output, uint32_t samples, int16_t gain)
+{
+	int16x2_t g = (int16x2_t)(((uint32_t)(uint16_t)gain << 16) | (uint16_t)gain);
+	int16x2_t x;
+	uint32_t lo, hi, y;
+	uint32_t i;
+
+	for (i = 0; i + 2 <= samples; i += 2) {
+		memcpy(&x, input + i, sizeof(x));
+		lo = (uint32_t)__ssat((__smulbb(x, g) + GAIN_ROUND) >> AUDIO_DSP_GAIN_SHIFT, 16);
+		hi = (uint32_t)__ssat((__smultb(x, g) + GAIN_ROUND) >> AUDIO_DSP_GAIN_SHIFT, 16);
+		y = (lo & 0xffff) | (hi << 16);
+		memcpy(output + i, &y, sizeof(y));
+	}
+
+	gain_scalar(input + i, output + i, samples - i, gain);
+}
+
+static void s32_to_s16_dsp(const int32_t *input, int16_t *output, uint32_t samples)
+{
+	uint32_t i;
+
+	for (i = 0; i < samples; i++) {
+		output[i] = (int16_t)__ssat((input[i] >> 16) + ((input[i] >> 15) & 1), 16);
+	}
+}
+
+static void interleave_dsp(const int16_t *const *planar, uint32_t channels, int16_t *output, uint32_t frames)
+{
+	uint32_t l, r, w[2];
+	uint32_t f = 0;
+
+	if (channels == 2) {
+		// L0 L1 and R0 R1 to L0 R0 L1 R1, PKHBT and PKHTB
+		for (; f + 2 <= frames; f += 2) {
+			memcpy(&l, planar[0] + f, sizeof(l));
+			memcpy(&r, planar[1] + f, sizeof(r));
+			w[0] = (l & 0xffff) | (r << 16);
+			w[1] = (l >> 16) | (r & 0xffff0000);
+			memcpy(output + 2 * f, w, sizeof(w));
+		}
+	}
+
+	interleave_tail(planar, channels, output, f, frames);
+}
+
+static void deinterleave_dsp(const int16_t *input, uint32_t channels, int16_t *const *planar, uint32_t frames)
+{
+	uint32_t l, r, w[2];
+	uint32_t f = 0;
+
+	if (channels == 2) {
+		for (; f + 2 <= frames; f += 2) {
+			memcpy(w, input + 2 * f, sizeof(w));
+			l = (w[0] & 0xffff) | (w[1] << 16);
+			r = (w[0] >> 16) | (w[1] & 0xffff0000);
+			memcpy(planar[0] + f, &l, sizeof(l));
+			memcpy(planar[1] + f, &r, sizeof(r));
+		}
+	}
+
+	deinterleave_tail(input, channels, planar, f, frames);
+}
+#endif
+
+#ifdef AUDIO_DSP_HAVE_NEON
+/**
+ * @brief   Advanced SIMD kernels. Up to 4 channels, frames are
+ *          de-interleaved into lanes by VLDn/VSTn and 4 or 8 frames are
+ *          processed per iteration. The frames left are done by the scalar
+ *          kernels.
+ */
+static uint32_t remix_neon_lanes(const int16_t *input, uint32_t in_ch, int16_t *output, uint32_t out_ch, const int16_t *matrix, uint32_t frames)
+{
+	int16x4_t x[4], y[4];
+	int16x4x2_t v2;
+	int16x4x3_t v3;
+	int16x4x4_t v4;
+	int32x4_t acc;
+	uint32_t f, i, o;
+
+	for (f = 0; f + 4 <= frames; f += 4) {
+		switch (in_ch) {
+		case 1:
+			x[0] = vld1_s16(input);
+			break;
+		case 2:
+			v2 = vld2_s16(input);
+			x[0] = v2.val[0];
+			x[1] = v2.val[1];
+			break;
+		case 3:
+			v3 = vld3_s16(input);
+			x[0] = v3.val[0];
+			x[1] = v3.val[1];
+			x[2] = v3.val[2];
+			break;
+		default:
+			v4 = vld4_s16(input);
+			x[0] = v4.val[0];
+			x[1] = v4.val[1];
+			x[2] = v4.val[2];
+			x[3] = v4.val[3];
+			break;
+		}
+		input += 4 * in_ch;
+
+		for (o = 0; o < out_ch; o++) {
+			acc = vmull_n_s16(x[0], matrix[o * in_ch]);
+			for (i = 1; i < in_ch; i++) {
+				acc = vmlal_n_s16(acc, x[i], matrix[o * in_ch + i]);
+			}
+			y[o] = vqrshrn_n_s32(acc, AUDIO_DSP_MIX_SHIFT);
+		}
+
+		switch (out_ch) {
+		case 1:
+			vst1_s16(output, y[0]);
+			break;
+		case 2:
+			v2.val[0] = y[0];
+			v2.val[1] = y[1];
+			vst2_s16(output, v2);
+			break;
+		case 3:
+			v3.val[0] = y[0];
+			v3.val[1] = y[1];
+			v3.val[2] = y[2];
+			vst3_s16(output, v3);
+			break;
+		default:
+			v4.val[0] = y[0];
+			v4.val[1] = y[1];
+			v4.val[2] = y[2];
+			v4.val[3] = y[3];
+			vst4_s16(output, v4);
+			break;
+		}
+		output += 4 * out_ch;
+	}
+
+	return f;
+}
+
+/**
+ * @brief   More than 4 input channels: one frame per iteration as a vector
+ *          of 8 lanes, multiplied with rows padded with zero. The lanes after
+ *          in_ch belong to the next frame, so the last frames are left.
+ */
+static uint32_t remix_neon_frame(const int16_t *input, uint32_t in_ch, int16_t *output, uint32_t out_ch, const int16_t *matrix, uint32_t frames)
+{
+	int16_t rows[AUDIO_DSP_MAX_CH][8];
+	int16_t mixed[AUDIO_DSP_MAX_CH];
+	int16x8_t x, m;
+	int32x4_t acc;
+	int32x2_t sum;
+	uint32_t f, o;
+
+	memset(rows, 0, sizeof(rows));
+	for (o = 0; o < out_ch; o++) {
+		memcpy(rows[o], matrix + o * in_ch, in_ch * sizeof(int16_t));
+	}
+
+	for (f = 0; (f * in_ch) + 8 <= frames * in_ch; f++) {
+		x = vld1q_s16(input);
+		input += in_ch;
+
+		for (o = 0; o < out_ch; o++) {
+			m = vld1q_s16(rows[o]);
+			acc = vmull_s16(vget_low_s16(x), vget_low_s16(m));
+			acc = vmlal_s16(acc, vget_high_s16(x), vget_high_s16(m));
+			sum = vadd_s32(vget_low_s32(acc), vget_high_s32(acc));
+			sum = vpadd_s32(sum, sum);
+			mixed[o] = clip((vget_lane_s32(sum, 0) + MIX_ROUND) >> AUDIO_DSP_MIX_SHIFT);
+		}
+
+		memcpy(output, mixed, out_ch * sizeof(int16_t));
+		output += out_ch;
+	}
+
+	return f;
+}
+
+static void remix_neon(const int16_t *input, uint32_t in_ch, int16_t *output, uint32_t out_ch, const int16_t *matrix, uint32_t frames)
+{
+	uint32_t f;
+
+	if (in_ch <= 4 && out_ch <= 4) {
+		f = remix_neon_lanes(input, in_ch, output, out_ch, matrix, frames);
+	} else {
+		f = remix_neon_frame(input, in_ch, output, out_ch, matrix, frames);
+	}
+
+	remix_scalar(input + f * in_ch, in_ch, output + f * out_ch, out_ch, matrix, frames - f);
+}
+
+static void gain_neon(const int16_t *input, int16_t *output, uint32_t samples, int16_t gain)
+{
+	int16x8_t x;
+	int32x4_t lo, hi;
+	uint32_t i;
+
+	for (i = 0; i + 8 <= samples; i += 8) {
+		x = vld1q_s16(input + i);
+		lo = vmull_n_s16(vget_low_s16(x), gain);
+		hi = vmull_n_s16(vget_high_s16(x), gain);
+		vst1q_s16(output + i, vcombine_s16(vqrshrn_n_s32(lo, AUDIO_DSP_GAIN_SHIFT), vqrshrn_n_s32(hi, AUDIO_DSP_GAIN_SHIFT)));
+	}
+
+	gain_scalar(input + i, output + i, samples - i, gain);
+}
+
+static void s16_to_s32_neon(const int16_t *input, int32_t *output, uint32_t samples)
+{
+	int16x8_t x;
+	uint32_t i;
+
+	for (i = 0; i + 8 <= samples; i += 8) {
+		x = vld1q_s16(input + i);
+		vst1q_s32(output + i, vshll_n_s16(vget_low_s16(x), 16));
+		vst1q_s32(output + i + 4, vshll_n_s16(vget_high_s16(x), 16));
+	}
+
+	s16_to_s32_scalar(input + i, output + i, samples - i);
+}
+
+static void s32_to_s16_neon(const int32_t *input, int16_t *output, uint32_t samples)
+{
+	uint32_t i;
+
+	for (i = 0; i + 8 <= samples; i += 8) {
+		vst1q_s16(output + i, vcombine_s16(vqrshrn_n_s32(vld1q_s32(input + i), 16), vqrshrn_n_s32(vld1q_s32(input + i + 4), 16)));
+	}
+
+	s32_to_s16_scalar(input + i, output + i, samples - i);
+}
+
+static void s16_to_float_neon(const int16_t *input, float *output, uint32_t samples)
+{
+	int16x8_t x;
+	uint32_t i;
+
+	for (i = 0; i + 8 <= samples; i += 8) {
+		x = vld1q_s16(input + i);
+		vst1q_f32(output + i, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(x))), 1.0f / FLOAT_SCALE));
+		vst1q_f32(output + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(x))), 1.0f / FLOAT_SCALE));
+	}
+
+	s16_to_float_scalar(input + i, output + i, samples - i);
+}
+
+static void float_to_s16_neon(const float *input, int16_t *output, uint32_t samples)
+{
+	const uint32x4_t sign = vdupq_n_u32(0x80000000);
+	const float32x4_t half = vdupq_n_f32(0.5f);
+	float32x4_t lo, hi;
+	uint32_t i;
+
+	// VCVT truncates and saturates, adding 0.5 with the sign of the value
+	// first rounds half away from zero like float_round().
+	for (i = 0; i + 8 <= samples; i += 8) {
+		lo = vmulq_n_f32(vld1q_f32(input + i), FLOAT_SCALE);
+		hi = vmulq_n_f32(vld1q_f32(input + i + 4), FLOAT_SCALE);
+		lo = vaddq_f32(lo, vbslq_f32(sign, lo, half));
+		hi = vaddq_f32(hi, vbslq_f32(sign, hi, half));
+		vst1q_s16(output + i, vcombine_s16(vqmovn_s32(vcvtq_s32_f32(lo)), vqmovn_s32(vcvtq_s32_f32(hi))));
+	}
+
+	float_to_s16_scalar(input + i, output + i, samples - i);
+}
+
+static void interleave_neon(const int16_t *const *planar, uint32_t channels, int16_t *output, uint32_t frames)
+{
+	int16x8x2_t v2;
+	int16x8x3_t v3;
+	int16x8x4_t v4;
+	uint32_t f = 0;
+
+	switch (channels) {
+	case 2:
+		for (; f + 8 <= frames; f += 8) {
+			v2.val[0] = vld1q_s16(planar[0] + f);
+			v2.val[1] = vld1q_s16(planar[1] + f);
+			vst2q_s16(output + 2 * f, v2);
+		}
+		break;
+	case 3:
+		for (; f + 8 <= frames; f += 8) {
+			v3.val[0] = vld1q_s16(planar[0] + f);
+			v3.val[1] = vld1q_s16(planar[1] + f);
+			v3.val[2] = vld1q_s16(planar[2] + f);
+			vst3q_s16(output + 3 * f, v3);
+		}
+		break;
+	case 4:
+		for (; f + 8 <= frames; f += 8) {
+			v4.val[0] = vld1q_s16(planar[0] + f);
+			v4.val[1] = vld1q_s16(planar[1] + f);
+			v4.val[2] = vld1q_s16(planar[2] + f);
+			v4.val[3] = vld1q_s16(planar[3] + f);
+			vst4q_s16(output + 4 * f, v4);
+		}
+		break;
+	default:
+		break;
+	}
+
+	interleave_tail(planar, channels, output, f, frames);
+}
+
+static void deinterleave_neon(const int16_t *input, uint32_t channels, int16_t *const *planar, uint32_t frames)
+{
+	int16x8x2_t v2;
+	int16x8x3_t v3;
+	int16x8x4_t v4;
+	uint32_t f = 0;
+
+	switch (channels) {
+	case 2:
+		for (; f + 8 <= frames; f += 8) {
+			v2 = vld2q_s16(input + 2 * f);
+			vst1q_s16(planar[0] + f, v2.val[0]);
+			vst1q_s16(planar[1] + f, v2.val[1]);
+		}
+		break;
+	case 3:
+		for (; f + 8 <= frames; f += 8) {
+			v3 = vld3q_s16(input + 3 * f);
+			vst1q_s16(planar[0] + f, v3.val[0]);
+			vst1q_s16(planar[1] + f, v3.val[1]);
+			vst1q_s16(planar[2] + f, v3.val[2]);
+		}
+		break;
+	case 4:
+		for (; f + 8 <= frames; f += 8) {
+			v4 = vld4q_s16(input + 4 * f);
+			vst1q_s16(planar[0] + f, v4.val[0]);
+			vst1q_s16(planar[1] + f, v4.val[1]);
+			vst1q_s16(planar[2] + f, v4.val[2]);
+			vst1q_s16(planar[3] + f, v4.val[3]);
+		}
+		break;
+	default:
+		break;
+	}
+
+	deinterleave_tail(input, channels, planar, f, frames);
+}
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+static const struct audio_dsp_ops_s g_audio_dsp_scalar = {
+	.remix_s16 = remix_scalar,
+	.gain_s16 = gain_scalar,
+	.s16_to_s32 = s16_to_s32_scalar,
+	.s32_to_s16 = s32_to_s16_scalar,
+	.s16_to_float = s16_to_float_scalar,
+	.float_to_s16 = float_to_s16_scalar,
+	.interleave_s16 = interleave_scalar,
+	.deinterleave_s16 = deinterleave_scalar,
+};
+
+#ifdef AUDIO_DSP_HAVE_DSP
+// Widening and float conversions gain nothing from the DSP extension
+static const struct audio_dsp_ops_s g_audio_dsp_dsp = {
+	.remix_s16 = remix_dsp,
+	.gain_s16 = gain_dsp,
+	.s16_to_s32 = s16_to_s32_scalar,
+	.s32_to_s16 = s32_to_s16_dsp,
+	.s16_to_float = s16_to_float_scalar,
+	.float_to_s16 = float_to_s16_scalar,
+	.interleave_s16 = interleave_dsp,
+	.deinterleave_s16 = deinterleave_dsp,
+};
+#endif
+
+#ifdef AUDIO_DSP_HAVE_NEON
+static const struct audio_dsp_ops_s g_audio_dsp_neon = {
+	.remix_s16 = remix_neon,
+	.gain_s16 = gain_neon,
+	.s16_to_s32 = s16_to_s32_neon,
+	.s32_to_s16 = s32_to_s16_neon,
+	.s16_to_float = s16_to_float_neon,
+	.float_to_s16 = float_to_s16_neon,
+	.interleave_s16 = interleave_neon,
+	.deinterleave_s16 = deinterleave_neon,
+};
+#define g_audio_dsp_auto g_audio_dsp_neon
+#elif defined(AUDIO_DSP_HAVE_DSP)
+#define g_audio_dsp_auto g_audio_dsp_dsp
+#else
+#define g_audio_dsp_auto g_audio_dsp_scalar
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+const struct audio_dsp_ops_s *audio_dsp_get_ops(int kernel)
+{
+	switch (kernel) {
+	case AUDIO_DSP_KERNEL_AUTO:
+		return &g_audio_dsp_auto;
+	case AUDIO_DSP_KERNEL_SCALAR:
+		return &g_audio_dsp_scalar;
+#ifdef AUDIO_DSP_HAVE_DSP
+	case AUDIO_DSP_KERNEL_DSP:
+		return &g_audio_dsp_dsp;
+#endif
+#ifdef AUDIO_DSP_HAVE_NEON
+	case AUDIO_DSP_KERNEL_NEON:
+		return &g_audio_dsp_neon;
+#endif
+	default:
+		return NULL;
+	}
+}
+
+void audio_dsp_remix_s16(const int16_t *input, uint32_t in_ch, int16_t *output, uint32_t out_ch, const int16_t *matrix, uint32_t frames)
+{
+	g_audio_dsp_auto.remix_s16(input, in_ch, output, out_ch, matrix, frames);
+}
+
+void audio_dsp_gain_s16(const int16_t *input, int16_t *output, uint32_t samples, int16_t gain)
+{
+	g_audio_dsp_auto.gain_s16(input, output, samples, gain);
+}
+
+void audio_dsp_s16_to_s32(const int16_t *input, int32_t *output, uint32_t samples)
+{
+	g_audio_dsp_auto.s16_to_s32(input, output, samples);
+}
+
+void audio_dsp_s32_to_s16(const int32_t *input, int16_t *output, uint32_t samples)
+{
+	g_audio_dsp_auto.s32_to_s16(input, output, samples);
+}
+
+void audio_dsp_s16_to_float(const int16_t *input, float *output, uint32_t samples)
+{
+	g_audio_dsp_auto.s16_to_float(input, output, samples);
+}
+
+void audio_dsp_float_to_s16(const float *input, int16_t *output, uint32_t samples)
+{
+	g_audio_dsp_auto.float_to_s16(input, output, samples);
+}
+
+void audio_dsp_interleave_s16(const int16_t *const *planar, uint32_t channels, int16_t *output, uint32_t frames)
+{
+	g_audio_dsp_auto.interleave_s16(planar, channels, output, frames);
+}
+
+void audio_dsp_deinterleave_s16(const int16_t *input, uint32_t channels, int16_t *const *planar, uint32_t frames)
+{
+	g_audio_dsp_auto.deinterleave_s16(input, channels, planar, frames);
+}
@@ -24,8 +24,9 @@
 #include "rb.h"
 #include "internal_defs.h"
 
-#define IS_EMPTY(rbp) (rbp->rd_idx == rbp->wr_idx)
-#define IS_FULL(rbp) ((rbp->rd_idx & IDX_MASK) == (rbp->wr_idx & IDX_MASK) && (rbp->rd_idx & MSB_MASK) != (rbp->wr_idx & MSB_MASK))
+/* Indexes are shared by the writer and the reader, see rb_s */
+#define LOAD_IDX(p_idx) __atomic_load_n(p_idx, __ATOMIC_ACQUIRE)
+#define STORE_IDX(p_idx, idx) __atomic_store_n(p_idx, idx, __ATOMIC_RELEASE)
 
 /**
  * @brief  Increase the buffer index while writing or reading the ring-buffer.
@@ -64,12 +65,15 @@ size_t rb_used(rb_p rbp)
 {
 	RETURN_VAL_IF_FAIL(rbp != NULL, SIZE_ZERO);
 
-	if (IS_EMPTY(rbp)) {
+	size_t wr_idx = LOAD_IDX(&rbp->wr_idx);
+	size_t rd_idx = LOAD_IDX(&rbp->rd_idx);
+
+	if (wr_idx == rd_idx) {
 		return SIZE_ZERO;
 	}
 
-	size_t wr_idx = (rbp->wr_idx & IDX_MASK);
-	size_t rd_idx = (rbp->rd_idx & IDX_MASK);
+	wr_idx &= IDX_MASK;
+	rd_idx &= IDX_MASK;
 
 	if (wr_idx > rd_idx) {
 		return (wr_idx - rd_idx);
@@ -109,6 +113,39 @@ size_t rb_write(rb_p rbp, const void *ptr, size_t len)
 	return len;
 }
 
+size_t rb_reserve(rb_p rbp, void **ptr)
+{
+	RETURN_VAL_IF_FAIL(rbp != NULL, SIZE_ZERO);
+	RETURN_VAL_IF_FAIL(ptr != NULL, SIZE_ZERO);
+
+	size_t avail = rb_avail(rbp);
+	size_t wr_idx = (rbp->wr_idx & IDX_MASK);
+
+	*ptr = (void *)((uint8_t *)rbp->buf + wr_idx);
+	return MINIMUM(avail, rbp->depth - wr_idx);
+}
+
+size_t rb_commit(rb_p rbp, size_t len)
+{
+	RETURN_VAL_IF_FAIL(rbp != NULL, SIZE_ZERO);
+
+	len = MINIMUM(len, rb_avail(rbp));
+	_incr(rbp, &rbp->wr_idx, len);
+	return len;
+}
+
+size_t rb_peek(rb_p rbp, void **ptr)
+{
+	RETURN_VAL_IF_FAIL(rbp != NULL, SIZE_ZERO);
+	RETURN_VAL_IF_FAIL(ptr != NULL, SIZE_ZERO);
+
+	size_t used = rb_used(rbp);
+	size_t rd_idx = (rbp->rd_idx & IDX_MASK);
+
+	*ptr = (void *)((uint8_t *)rbp->buf + rd_idx);
+	return MINIMUM(used, rbp->depth - rd_idx);
+}
+
 size_t rb_read(rb_p rbp, void *ptr, size_t len)
 {
 	RETURN_VAL_IF_FAIL(rbp != NULL, SIZE_ZERO);
@@ -159,8 +196,8 @@ bool rb_reset(rb_p rbp)
 {
 	RETURN_VAL_IF_FAIL(rbp != NULL, false);
 
-	rbp->rd_idx = 0;
-	rbp->wr_idx = 0;
+	STORE_IDX(&rbp->rd_idx, 0);
+	STORE_IDX(&rbp->wr_idx, 0);
 
 	return true;
 }
@@ -176,5 +213,5 @@ static void _incr(rb_p rbp, volatile size_t *p_idx, size_t len)
 		idx -= rbp->depth;
 	}
 
-	*p_idx = msb | idx;
+	STORE_IDX(p_idx, msb | idx);
 }
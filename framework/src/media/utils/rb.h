@@ -30,7 +30,12 @@ extern "C" {
 #define IDX_MASK (SIZE_MAX>>1)
 #define MSB_MASK (~IDX_MASK)    /* also the maximum value of the buffer depth */
 
-/* ring buffer structure */
+/* ring buffer structure
+ *
+ * One writer and one reader may use the ring-buffer from two threads without
+ * a lock: each index is only stored by its owner, with release semantics, and
+ * loaded by the other side with acquire semantics.
+ */
 struct rb_s {
 	void *buf;                  /* pointer to the buffer allocated   */
 	size_t depth;               /* maximum size of the ring buffer   */
@@ -102,6 +107,35 @@ size_t rb_read(rb_p rbp, void *ptr, size_t len);
  */
 size_t rb_read_ext(rb_p rbp, void *ptr, size_t len, size_t offset);
 
+/**
+ * @brief  Get the contiguous free space at the write index, so the writer
+ *         can fill it in place. Only one reservation can be pending and it
+ *         is published by rb_commit().
+ * @param  rbp: Pointer to the ring-buffer object
+ * @param  ptr: Pointer to save the start of the free space
+ * @return size of the contiguous free space, range[0, rb_avail()].
+ *         It is less than rb_avail() when the free space wraps around.
+ */
+size_t rb_reserve(rb_p rbp, void **ptr);
+
+/**
+ * @brief  Publish data written to the space got from rb_reserve().
+ * @param  rbp: Pointer to the ring-buffer object
+ * @param  len: length of the data written
+ * @return size wr_idx increased, range[0, len]
+ */
+size_t rb_commit(rb_p rbp, size_t len);
+
+/**
+ * @brief  Get the contiguous data at the read index, so the reader can use
+ *         it in place. Release it with rb_read(rbp, NULL, len) when done.
+ * @param  rbp: Pointer to the ring-buffer object
+ * @param  ptr: Pointer to save the start of the data
+ * @return size of the contiguous data, range[0, rb_used()].
+ *         It is less than rb_used() when the data wraps around.
+ */
+size_t rb_peek(rb_p rbp, void **ptr);
+
 /**
  * @brief  Reset ring-buffer, data in ring-buffer will be dropped.
  * @param  rbp: Pointer to the ring-buffer object
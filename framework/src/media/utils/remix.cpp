@@ -19,6 +19,7 @@
 #include <string.h>
 #include <debug.h>
 #include <media/MediaTypes.h>
+#include <media/audio_dsp.h>
 #include "internal_defs.h"
 #include "remix.h"
 
@@ -82,17 +83,52 @@ using namespace media;
                                 output[1] = input[1] + coeff * (input[2] + input[4])
  6 (5.1)        2 (Stereo)      output[0] = input[0] + coeff * (input[2] + input[4])
                                 output[1] = input[1] + coeff * (input[2] + input[5])
+ n (Multi)      1 (Mono)        output[0] = 0.5 * (stereo output[0] + stereo output[1])
+
+ coeff is 0.7071 (-3dB). The rules are applied as Q14 mixing matrices by
+ audio_dsp_remix_s16(), with rounding and saturation.
 */
 
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
-#define MIX_COEFF   7071 / 1000 // 0.7071, DONOT (7071 / 1000)
+#define MIX_ONE     AUDIO_DSP_MIX_ONE
+#define MIX_HALF    (AUDIO_DSP_MIX_ONE / 2)
+#define MIX_COEFF   11585 // 0.7071 in Q14
 
 /****************************************************************************
  * Private Declarations
  ****************************************************************************/
-
+// Rows of the stereo output: FL then FR
+static const int16_t g_mix_2point1[2 * 3] = {
+	MIX_ONE, 0, 0,
+	0, MIX_ONE, 0,
+};
+
+static const int16_t g_mix_surround[2 * 3] = {
+	MIX_ONE, 0, MIX_HALF,
+	0, MIX_ONE, MIX_HALF,
+};
+
+static const int16_t g_mix_3point1[2 * 4] = {
+	MIX_ONE, 0, MIX_HALF, 0,
+	0, MIX_ONE, MIX_HALF, 0,
+};
+
+static const int16_t g_mix_quad[2 * 4] = {
+	MIX_HALF, 0, MIX_HALF, 0,
+	0, MIX_HALF, 0, MIX_HALF,
+};
+
+static const int16_t g_mix_5point0_back[2 * 5] = {
+	MIX_ONE, 0, MIX_COEFF, MIX_COEFF, 0,
+	0, MIX_ONE, MIX_COEFF, 0, MIX_COEFF,
+};
+
+static const int16_t g_mix_5point1_back[2 * 6] = {
+	MIX_ONE, 0, MIX_COEFF, 0, MIX_COEFF, 0,
+	0, MIX_ONE, MIX_COEFF, 0, 0, MIX_COEFF,
+};
 
 /****************************************************************************
  * Private Functions
@@ -142,16 +178,25 @@ uint32_t ch2layout(uint32_t nb_chs)
 	}
 }
 
-// Clip an integer value (32 bits) to a signed short type value(16 bits)
-static int16_t clip(int32_t x)
+// Get the stereo mixing matrix of a multi-channel layout
+static const int16_t *stereo_matrix(uint32_t layout)
 {
-	if (x < INT16_MIN) {
-		return INT16_MIN;
-	} else if (x > INT16_MAX) {
-		return INT16_MAX;
+	switch (layout) {
+	case CH_LAYOUT_2POINT1:
+		return g_mix_2point1;
+	case CH_LAYOUT_SURROUND:
+		return g_mix_surround;
+	case CH_LAYOUT_3POINT1:
+		return g_mix_3point1;
+	case CH_LAYOUT_QUAD:
+		return g_mix_quad;
+	case CH_LAYOUT_5POINT0_BACK:
+		return g_mix_5point0_back;
+	case CH_LAYOUT_5POINT1_BACK:
+		return g_mix_5point1_back;
+	default:
+		return NULL;
 	}
-
-	return x;
 }
 
 /****************************************************************************
@@ -173,149 +218,53 @@ int32_t rechannel(uint32_t in_layout, uint32_t out_layout, const int16_t *input,
 		return (int32_t)out_frames;
 	}
 
-	// Multi -> mono in two steps
-	if ((in_layout != CH_LAYOUT_MONO && in_layout != CH_LAYOUT_STEREO) && (out_layout == CH_LAYOUT_MONO)) {
-		// Firstly, multi -> stereo
-		int32_t ret = rechannel(in_layout, CH_LAYOUT_STEREO, input, in_frames, output, max_frames);
-		if (ret < 0) {
-			return ret;
-		}
-		// And then, stereo -> mono
-		return rechannel(CH_LAYOUT_STEREO, CH_LAYOUT_MONO, output, (uint32_t)ret, output, max_frames);
-	}
-
-	// Now consider scenarios:
-	// stereo -> mono, mono -> stereo, multi -> stereo.
-
-	const int16_t *in_fl, *in_fr, *in_fc, /* *in_lfe, */ *in_bl, *in_br;
 	uint32_t in_ch = layout2ch(in_layout);
 	uint32_t out_ch = layout2ch(out_layout);
-	uint32_t out_samples = out_frames * out_ch;
-	int16_t *out_end = &output[out_samples];
-	int16_t *out_fl = &output[0];
-	int16_t *out_fr = &output[1];
-	int16_t *out_fc;
 
-	switch (in_layout) {
-	case CH_LAYOUT_MONO: { // out_layout: CH_LAYOUT_STEREO
+	if (in_layout == CH_LAYOUT_MONO) { // out_layout: CH_LAYOUT_STEREO
 		// Maybe input == output, upmix backward.
-		in_fc = &input[out_frames * in_ch - 1];
-		out_fl = &output[out_samples - 2];
-		out_fr = &output[out_samples - 1];
+		const int16_t *in_fc = &input[out_frames - 1];
+		int16_t *out_fl = &output[out_frames * out_ch - 2];
 
 		while (output <= out_fl) {
-			*out_fr = *in_fc;
-			*out_fl = *in_fc;
+			out_fl[0] = *in_fc;
+			out_fl[1] = *in_fc;
 
-			out_fr -= out_ch;
 			out_fl -= out_ch;
-			in_fc -= in_ch;
-		}
-	} break;
-
-	case CH_LAYOUT_STEREO: { // out_layout: CH_LAYOUT_MONO
-		in_fl = &input[0];
-		in_fr = &input[1];
-		out_fc = &output[0];
-
-		while (out_fc < out_end) {
-			*out_fc = ((int32_t)*in_fl + *in_fr) / 2;
-
-			out_fc += out_ch;
-			in_fl += in_ch;
-			in_fr += in_ch;
+			in_fc--;
 		}
-	} break;
-
-	// Below cases process: multi -> stereo
-
-	case CH_LAYOUT_2POINT1: {
-		in_fl = &input[0];
-		in_fr = &input[1];
-		// in_lfe at &input[2]
-
-		while (out_fl < out_end) {
-			*out_fl = *in_fl;
-			*out_fr = *in_fr;
-
-			out_fl += out_ch;
-			out_fr += out_ch;
-			in_fl += in_ch;
-			in_fr += in_ch;
-		}
-	} break;
-
-	case CH_LAYOUT_3POINT1:  // fall through
-	case CH_LAYOUT_SURROUND: {
-		in_fl = &input[0];
-		in_fr = &input[1];
-		in_fc = &input[2];
-		// in_lfe at &input[3]
-
-		while (out_fl < out_end) {
-			*out_fl = clip((int32_t)*in_fl + *in_fc / 2);
-			*out_fr = clip((int32_t)*in_fr + *in_fc / 2);
-
-			out_fl += out_ch;
-			out_fr += out_ch;
-			in_fl += in_ch;
-			in_fr += in_ch;
-			in_fc += in_ch;
-		}
-	} break;
-
-	case CH_LAYOUT_QUAD: {
-		in_fl = &input[0];
-		in_fr = &input[1];
-		in_bl = &input[2];
-		in_br = &input[3];
-
-		while (out_fl < out_end) {
-			*out_fl = ((int32_t)*in_fl + *in_bl) / 2;
-			*out_fr = ((int32_t)*in_fr + *in_br) / 2;
+		return (int32_t)out_frames;
+	}
 
-			out_fl += out_ch;
-			out_fr += out_ch;
-			in_fl += in_ch;
-			in_fr += in_ch;
-			in_bl += in_ch;
-			in_br += in_ch;
+	// Now consider scenarios:
+	// stereo -> mono, multi -> stereo, multi -> mono.
+	// All of them reduce the channels, so the output may overwrite the input.
+
+	int16_t matrix[2 * AUDIO_DSP_MAX_CH];
+	const int16_t *stereo;
+	uint32_t i;
+
+	if (in_layout == CH_LAYOUT_STEREO) {
+		matrix[0] = MIX_HALF;
+		matrix[1] = MIX_HALF;
+	} else {
+		stereo = stereo_matrix(in_layout);
+		if (stereo == NULL) {
+			// unsupported in_layout
+			meddbg("unsupported in_layout 0x%x\n", in_layout);
+			return -1;
 		}
-	} break;
 
-	case CH_LAYOUT_5POINT1_BACK: // fall through
-	case CH_LAYOUT_5POINT0_BACK: {
-		in_fl = &input[0];
-		in_fr = &input[1];
-		in_fc = &input[2];
-		if (in_layout == CH_LAYOUT_5POINT1_BACK) {
-			// in_lfe at &input[3]
-			in_bl = &input[4];
-			in_br = &input[5];
+		if (out_layout == CH_LAYOUT_STEREO) {
+			memcpy(matrix, stereo, 2 * in_ch * sizeof(int16_t));
 		} else {
-			in_bl = &input[3];
-			in_br = &input[4];
+			// Mono is the average of both stereo rows
+			for (i = 0; i < in_ch; i++) {
+				matrix[i] = (stereo[i] + stereo[in_ch + i]) / 2;
+			}
 		}
-
-		while (out_fl < out_end) {
-			*out_fl = clip(*in_fl + ((int32_t)*in_fc + *in_bl) * MIX_COEFF);
-			*out_fr = clip(*in_fr + ((int32_t)*in_fc + *in_br) * MIX_COEFF);
-
-			out_fl += out_ch;
-			out_fr += out_ch;
-			in_fl += in_ch;
-			in_fr += in_ch;
-			in_fc += in_ch;
-			in_bl += in_ch;
-			in_br += in_ch;
-		}
-	} break;
-
-	default:
-		// unsupported in_layout
-		meddbg("unsupported in_layout 0x%x\n", in_layout);
-		return -1;
 	}
 
+	audio_dsp_remix_s16(input, in_ch, output, out_ch, matrix, out_frames);
 	return (int32_t)out_frames;
 }
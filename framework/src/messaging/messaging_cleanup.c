@@ -95,6 +95,7 @@ int messaging_cleanup(const char *port_name)
 	do {
 		if ((strncmp(port_info->name, port_name, strlen(port_name) + 1) == 0) && (my_pid == port_info->pid)) {
 			cleanup_pid = port_info->pid;
+			messaging_drop_packets(port_info->mqdes);
 			mq_close(port_info->mqdes);
 			sq_rem((FAR sq_entry_t *)port_info, port_info_list_ptr);
 			MSG_FREE(port_info->data);
@@ -121,6 +121,9 @@ int messaging_parse_packet(char *packet, char *buf, int buflen, pid_t *sender_pi
 	uint32_t parsing_version;
 	int ret = OK;
 	uint32_t offset;
+#ifdef CONFIG_MESSAGING_SHARED_PAYLOAD
+	msg_shbuf_t *shbuf;
+#endif
 
 	my_version = messaging_get_version();
 
@@ -138,6 +141,31 @@ int messaging_parse_packet(char *packet, char *buf, int buflen, pid_t *sender_pi
 		parsing_version = my_version;
 	}
 	switch (parsing_version) {
+	case 2:
+		if (((messaging_packet_t *)packet)->msg_type & MSG_PACKET_SHARED) {
+#ifdef CONFIG_MESSAGING_SHARED_PAYLOAD
+			/* Copy from the shared buffer, and release the reference which sender took for us. */
+			*sender_pid = ((messaging_packet_t *)packet)->sender_pid;
+			*msg_type = ((messaging_packet_t *)packet)->msg_type & ~MSG_PACKET_SHARED;
+			memcpy(&shbuf, packet + offset, sizeof(msg_shbuf_t *));
+			if (shbuf->msglen > buflen) {
+				/* Fail as mq_receive does for a message larger than the buffer. */
+				msgdbg("[Messaging] recv fail : message %d is larger than buffer %d.\n", shbuf->msglen, buflen);
+				messaging_shbuf_release(shbuf);
+				set_errno(EMSGSIZE);
+				ret = ERROR;
+				break;
+			}
+			memcpy(buf, shbuf->data, shbuf->msglen);
+			messaging_shbuf_release(shbuf);
+			ret = OK;
+#else
+			msgdbg("[Messaging] Shared packet is not supported.\n");
+			ret = ERROR;
+#endif
+			break;
+		}
+		/* Fall through - version 2 packet without shared buffer is the same as version 1. */
 	case 1:
 		*sender_pid = ((messaging_packet_t *)packet)->sender_pid;
 		*msg_type = ((messaging_packet_t *)packet)->msg_type;
@@ -152,6 +180,65 @@ int messaging_parse_packet(char *packet, char *buf, int buflen, pid_t *sender_pi
 
 	return ret;
 }
+/****************************************************************************
+ * Name : messaging_packet_size
+ *
+ * Description:
+ *  Get the size of received packet as if the message was copied in the packet.
+ *  The packet should be checked before it is parsed.
+ ****************************************************************************/
+int messaging_packet_size(char *packet, int size)
+{
+#ifdef CONFIG_MESSAGING_SHARED_PAYLOAD
+	msg_shbuf_t *shbuf;
+
+	if (((messaging_packet_t *)packet)->version >= 2 && (((messaging_packet_t *)packet)->msg_type & MSG_PACKET_SHARED)) {
+		memcpy(&shbuf, packet + ((messaging_packet_t *)packet)->offset, sizeof(msg_shbuf_t *));
+		return MSG_HEADER_SIZE + shbuf->msglen;
+	}
+#endif
+	return size;
+}
+/****************************************************************************
+ * Name : messaging_drop_packets
+ *
+ * Description:
+ *  Discard the packets left in the queue before it is closed.
+ *  The shared buffers of discarded packets are released.
+ ****************************************************************************/
+void messaging_drop_packets(mqd_t mqdes)
+{
+#ifdef CONFIG_MESSAGING_SHARED_PAYLOAD
+	struct mq_attr attr;
+	char *packet;
+	msg_shbuf_t *shbuf;
+
+	if (mq_getattr(mqdes, &attr) < 0 || attr.mq_curmsgs == 0) {
+		return;
+	}
+
+	packet = (char *)MSG_ALLOC(attr.mq_msgsize);
+	if (packet == NULL) {
+		msgdbg("[Messaging] drop fail : out of memory for packet.\n");
+		return;
+	}
+
+	while (attr.mq_curmsgs > 0) {
+		if (mq_receive(mqdes, packet, attr.mq_msgsize, 0) < 0) {
+			break;
+		}
+		if (((messaging_packet_t *)packet)->version >= 2 && (((messaging_packet_t *)packet)->msg_type & MSG_PACKET_SHARED)) {
+			memcpy(&shbuf, packet + ((messaging_packet_t *)packet)->offset, sizeof(msg_shbuf_t *));
+			messaging_shbuf_release(shbuf);
+		}
+		if (mq_getattr(mqdes, &attr) < 0) {
+			break;
+		}
+	}
+
+	MSG_FREE(packet);
+#endif
+}
 /****************************************************************************
  * Name : messaging_set_notification
  * 
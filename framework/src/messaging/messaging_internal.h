@@ -20,6 +20,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <queue.h>
+#include <sys/prctl.h>
 #include <messaging/messaging.h>
 
 
@@ -34,8 +35,11 @@
 #define MSG_ASPRINTF asprintf
 #endif
 
-#define MSG_VERSION 1
+#define MSG_VERSION 2
 /* Messaging Version 1 */
+/* Messaging Version 2 : Same header as version 1. If MSG_PACKET_SHARED is set in msg_type,
+ * the packet carries a pointer to the msg_shbuf_t which holds the message instead of the message.
+ */
 struct messaging_packet_s {
 	uint32_t version;
 	uint32_t offset;
@@ -48,6 +52,20 @@ typedef struct messaging_packet_s messaging_packet_t;
 
 #define MAX_PORT_NAME_SIZE 64
 
+#define MSG_PACKET_SHARED 0x80000000
+
+/**
+ * @brief The shared buffer which holds a message passed by reference.
+ * @details It is allocated once by the sender and referenced by every packet which was sent with it.
+ * The last one who releases it, the sender or a receiver, frees it.
+ */
+struct msg_shbuf_s {
+	uint32_t refs;
+	int msglen;
+	char data[1];
+};
+typedef struct msg_shbuf_s msg_shbuf_t;
+
 /**
  * @brief The type of handling message internally
  * @details MSG_INFO_SAVE    : For saving receiver information\n
@@ -65,6 +83,9 @@ typedef enum msg_info_type_e msg_info_type_t;
 #define SAVE_MSG_RECEIVER(port_name)  messaging_handle_data(MSG_INFO_SAVE, port_name, NULL, NULL)
 #define READ_MSG_RECEIVER(port_name, recv_arr, recv_cnt)  messaging_handle_data(MSG_INFO_READ, port_name, recv_arr, &recv_cnt)
 #define FREE_MSG_RECEIVER(port_name)  messaging_handle_data(MSG_INFO_REMOVE, port_name, NULL, NULL)
+#define READ_MSG_RECEIVER_PORT(port_id, recv_arr, recv_cnt)  prctl(PR_MSG_READ_PORT, port_id, recv_arr, &recv_cnt)
+
+#define MSG_PORT_ID_NONE 0
 
 /**
  * @brief The type of sending message
@@ -106,6 +127,15 @@ struct msg_port_info_s {
 };
 typedef struct msg_port_info_s msg_port_info_t;
 
+/**
+ * @brief The message port resolved by messaging_port_open.
+ * @details id is the port id of the receivers' registry in the kernel.
+ */
+struct msg_port_s {
+	int id;
+	char name[MAX_PORT_NAME_SIZE];
+};
+
 /**
  * @brief Internal function for setting callback function to the messaging signal.
  */
@@ -121,11 +151,11 @@ int messaging_handle_data(msg_info_type_t type, const char *port_name, int *data
 /**
  * @brief Internal function for unicast and multicast send APIs.
  */
-int messaging_send_internal(const char *port_name, msg_send_type_t msg_type, msg_send_data_t *send_data, msg_recv_buf_t *recv_data, msg_callback_info_t *cb_info);
+int messaging_send_internal(const char *port_name, int port_id, msg_send_type_t msg_type, msg_send_data_t *send_data, msg_recv_buf_t *recv_data, msg_callback_info_t *cb_info);
 /**
  * @brief Internal function for sending message packet which has header and message.
  */
-int messaging_send_packet(const char *port_name, msg_send_type_t msg_type, msg_send_data_t *send_data, msg_callback_info_t *cb_info);
+int messaging_send_packet(const char *port_name, msg_send_type_t msg_type, msg_send_data_t *send_data, msg_shbuf_t *shbuf);
 /**
  * @brief Internal function for receiving APIs.
  */
@@ -138,6 +168,28 @@ void messaging_run_callback(int signo, siginfo_t *data);
  * @brief Internal function for parsing received packet
  */
 int messaging_parse_packet(char *packet, char *buf, int buflen, pid_t *sender_pid, int *msg_type);
+/**
+ * @brief Internal function for getting the size of received packet as if the message was copied in it
+ */
+int messaging_packet_size(char *packet, int size);
+/**
+ * @brief Internal function for discarding the packets left in the queue before closing it
+ */
+void messaging_drop_packets(mqd_t mqdes);
+#ifdef CONFIG_MESSAGING_SHARED_PAYLOAD
+/**
+ * @brief Internal function for allocating a shared buffer and copying the message in it
+ */
+msg_shbuf_t *messaging_shbuf_alloc(msg_send_data_t *send_data);
+/**
+ * @brief Internal function for taking a reference to the shared buffer
+ */
+void messaging_shbuf_hold(msg_shbuf_t *shbuf);
+/**
+ * @brief Internal function for releasing a reference to the shared buffer
+ */
+void messaging_shbuf_release(msg_shbuf_t *shbuf);
+#endif
 /**
  * @brief Internal function for getting g_port_info_list
  */
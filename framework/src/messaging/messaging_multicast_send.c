@@ -43,7 +43,7 @@ int messaging_multicast(const char *port_name, msg_send_data_t *send_data)
 		return ERROR;
 	}
 
-	ret = messaging_send_internal(port_name, MSG_SEND_MULTI, send_data, NULL, NULL);
+	ret = messaging_send_internal(port_name, MSG_PORT_ID_NONE, MSG_SEND_MULTI, send_data, NULL, NULL);
 	if (ret == ERROR) {
 		return ERROR;
 	}
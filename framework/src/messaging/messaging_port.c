@@ -0,0 +1,128 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include <tinyara/config.h>
+#include <debug.h>
+#include <errno.h>
+#include <string.h>
+#include <sys/prctl.h>
+#include <sys/types.h>
+#include <messaging/messaging.h>
+#include "messaging_internal.h"
+
+/****************************************************************************
+ * private functions
+ ****************************************************************************/
+static int messaging_port_check(msg_port_t *port, msg_send_data_t *send_data)
+{
+	if (port == NULL) {
+		msgdbg("[Messaging] port send fail : no port.\n");
+		return ERROR;
+	}
+
+	if (send_data == NULL || send_data->msg == NULL || send_data->msglen <= 0 || send_data->priority < 0) {
+		msgdbg("[Messaging] port send fail : invalid param of send data.\n");
+		return ERROR;
+	}
+
+	return OK;
+}
+
+/****************************************************************************
+ * public functions
+ ****************************************************************************/
+/****************************************************************************
+ * messaging_port_open
+ ****************************************************************************/
+msg_port_t *messaging_port_open(const char *port_name)
+{
+	msg_port_t *port;
+
+	if (port_name == NULL || strlen(port_name) >= MAX_PORT_NAME_SIZE) {
+		msgdbg("[Messaging] port open fail : invalid port name.\n");
+		return NULL;
+	}
+
+	port = (msg_port_t *)MSG_ALLOC(sizeof(msg_port_t));
+	if (port == NULL) {
+		msgdbg("[Messaging] port open fail : out of memory.\n");
+		return NULL;
+	}
+
+	/* The kernel interns the port name, and the port id finds it directly. */
+	port->id = prctl(PR_MSG_OPEN, port_name);
+	if (port->id <= 0) {
+		msgdbg("[Messaging] port open fail : errno %d.\n", errno);
+		MSG_FREE(port);
+		return NULL;
+	}
+	strncpy(port->name, port_name, MAX_PORT_NAME_SIZE);
+
+	return port;
+}
+
+/****************************************************************************
+ * messaging_port_send
+ ****************************************************************************/
+int messaging_port_send(msg_port_t *port, msg_send_data_t *send_data)
+{
+	int ret;
+
+	if (messaging_port_check(port, send_data) != OK) {
+		return ERROR;
+	}
+
+	ret = messaging_send_internal(port->name, port->id, MSG_SEND_NOREPLY, send_data, NULL, NULL);
+	if (ret == ERROR) {
+		return ERROR;
+	}
+
+	return OK;
+}
+
+/****************************************************************************
+ * messaging_port_multicast
+ ****************************************************************************/
+int messaging_port_multicast(msg_port_t *port, msg_send_data_t *send_data)
+{
+	if (messaging_port_check(port, send_data) != OK) {
+		return ERROR;
+	}
+
+	return messaging_send_internal(port->name, port->id, MSG_SEND_MULTI, send_data, NULL, NULL);
+}
+
+/****************************************************************************
+ * messaging_port_close
+ ****************************************************************************/
+int messaging_port_close(msg_port_t *port)
+{
+	int ret;
+
+	if (port == NULL) {
+		msgdbg("[Messaging] port close fail : no port.\n");
+		return ERROR;
+	}
+
+	ret = prctl(PR_MSG_CLOSE, port->id);
+	MSG_FREE(port);
+
+	return ret == OK ? OK : ERROR;
+}
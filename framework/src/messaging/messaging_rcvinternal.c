@@ -82,6 +82,7 @@ static int messaging_rcv_nonblock(mqd_t mqdes, const char *port_name, msg_recv_b
 	while (1) {
 		recv_size_chk = mq_receive(mqdes, (char *)recv_packet, recv_size, 0);
 		if (recv_size_chk > 0 && recv_size_chk <= recv_size) {
+			recv_size_chk = messaging_packet_size(recv_packet, recv_size_chk);
 			ret = messaging_parse_packet(recv_packet, recv_buf->buf, recv_buf->buflen, &recv_buf->sender_pid, &msg_type);
 			if (ret != OK) {
 				MSG_FREE(recv_packet);
@@ -196,6 +197,7 @@ static int messaging_rcv_block(mqd_t mqdes, const char *port_name, msg_recv_buf_
 
 cleanup_return:
 	MSG_FREE(recv_packet);
+	messaging_drop_packets(mqdes);
 	mq_close(mqdes);
 	MSG_ASPRINTF(&internal_portname, "%s%d", port_name, getpid());
 	mq_unlink(internal_portname);
@@ -0,0 +1,76 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include <tinyara/config.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/types.h>
+#include <messaging/messaging.h>
+#include "messaging_internal.h"
+
+/****************************************************************************
+ * Name : messaging_shbuf_alloc
+ *
+ * Description:
+ *  Allocate a shared buffer and copy the message in it.
+ *  The sender holds the only reference of the new buffer.
+ *
+ * Return Value:
+ *  On success, the shared buffer is returned.; On failure, NULL is returned.
+ ****************************************************************************/
+msg_shbuf_t *messaging_shbuf_alloc(msg_send_data_t *send_data)
+{
+	msg_shbuf_t *shbuf;
+
+	shbuf = (msg_shbuf_t *)MSG_ALLOC(offsetof(msg_shbuf_t, data) + send_data->msglen);
+	if (shbuf == NULL) {
+		return NULL;
+	}
+
+	shbuf->refs = 1;
+	shbuf->msglen = send_data->msglen;
+	memcpy(shbuf->data, send_data->msg, send_data->msglen);
+
+	return shbuf;
+}
+/****************************************************************************
+ * Name : messaging_shbuf_hold
+ *
+ * Description:
+ *  Take a reference to the shared buffer for a packet which is sent.
+ ****************************************************************************/
+void messaging_shbuf_hold(msg_shbuf_t *shbuf)
+{
+	__atomic_add_fetch(&shbuf->refs, 1, __ATOMIC_RELAXED);
+}
+/****************************************************************************
+ * Name : messaging_shbuf_release
+ *
+ * Description:
+ *  Release a reference to the shared buffer. The last reference frees it.
+ *  Receivers release it from their own task, so the count is atomic.
+ ****************************************************************************/
+void messaging_shbuf_release(msg_shbuf_t *shbuf)
+{
+	if (__atomic_sub_fetch(&shbuf->refs, 1, __ATOMIC_ACQ_REL) == 0) {
+		MSG_FREE(shbuf);
+	}
+}
@@ -100,11 +100,12 @@ static int messaging_set_async_callback(const char *port_name, msg_recv_buf_t *r
  *  msg       : The message to be sent
  *  msglen    : The length of message to be sent
  *  priority  : A non-negative integer that specifies the priority of this message
+ *  shbuf     : The shared buffer which holds the message, or NULL to copy the message in the packet
  * 
  * Return Value:
  *  On success, 0 (OK) is returned.; On failure, -1 (ERROR) is returned.
  ****************************************************************************/
-int messaging_send_packet(const char *port_name, msg_send_type_t msg_type, msg_send_data_t *send_data, msg_callback_info_t *cb_info)
+int messaging_send_packet(const char *port_name, msg_send_type_t msg_type, msg_send_data_t *send_data, msg_shbuf_t *shbuf)
 {
 	int ret = OK;
 	mqd_t mqdes;
@@ -115,7 +116,11 @@ int messaging_send_packet(const char *port_name, msg_send_type_t msg_type, msg_s
 	uint32_t msg_offset;
 	uint32_t msg_version;
 
-	send_size = MSG_HEADER_SIZE + send_data->msglen;
+	if (shbuf != NULL) {
+		send_size = MSG_HEADER_SIZE + sizeof(msg_shbuf_t *);
+	} else {
+		send_size = MSG_HEADER_SIZE + send_data->msglen;
+	}
 
 	internal_attr.mq_maxmsg = CONFIG_MESSAGING_MAXMSG;
 	internal_attr.mq_msgsize = send_size;
@@ -143,6 +148,7 @@ int messaging_send_packet(const char *port_name, msg_send_type_t msg_type, msg_s
 	 * +--------------------------------------------------------------------------------------------------------+
 	 * | version(4bytes) | msg_offset(4bytes) | sender_pid(4bytes) | msg type(4bytes) | message(Max 65515bytes) |
 	 * +--------------------------------------------------------------------------------------------------------+
+	 * A shared packet(version 2) carries the pointer to the shared buffer as message.
 	 */
 
 	/* Add data header for message version and msg offset. */
@@ -164,12 +170,26 @@ int messaging_send_packet(const char *port_name, msg_send_type_t msg_type, msg_s
 	}
 	((messaging_packet_t *)send_packet)->msg_type = send_type;
 
-	/* Copy the real send message. */
-	memcpy(send_packet + msg_offset, send_data->msg, send_data->msglen);
+	if (shbuf != NULL) {
+#ifdef CONFIG_MESSAGING_SHARED_PAYLOAD
+		/* The receiver releases the reference which is taken for it here. */
+		((messaging_packet_t *)send_packet)->msg_type |= MSG_PACKET_SHARED;
+		memcpy(send_packet + msg_offset, &shbuf, sizeof(msg_shbuf_t *));
+		messaging_shbuf_hold(shbuf);
+#endif
+	} else {
+		/* Copy the real send message. */
+		memcpy(send_packet + msg_offset, send_data->msg, send_data->msglen);
+	}
 
 	ret = mq_send(mqdes, (char *)send_packet, send_size, send_data->priority);
 	if (ret != OK) {
 		msgdbg("[Messaging] send fail : errno %d.\n", errno);
+#ifdef CONFIG_MESSAGING_SHARED_PAYLOAD
+		if (shbuf != NULL) {
+			messaging_shbuf_release(shbuf);
+		}
+#endif
 		MSG_FREE(send_packet);
 		mq_close(mqdes);
 		mq_unlink(port_name);
@@ -196,6 +216,7 @@ static void messaging_init_recv_arr(int *arr)
  *
  * Input Parameters:
  *  port_name : The message port name to send
+ *  port_id   : The port id of port_name if it was resolved, or MSG_PORT_ID_NONE
  *  msg       : The message to be sent
  *  msglen    : The length of message to be sent
  *  priority  : A non-negative integer that specifies the priority of this message
@@ -204,7 +225,7 @@ static void messaging_init_recv_arr(int *arr)
  *  On success, the number of waiting receivers is returned.
  *  On failure, -1 (ERROR) is returned.
  ****************************************************************************/
-int messaging_send_internal(const char *port_name, msg_send_type_t msg_type, msg_send_data_t *send_data, msg_recv_buf_t *recv_data, msg_callback_info_t *cb_info)
+int messaging_send_internal(const char *port_name, int port_id, msg_send_type_t msg_type, msg_send_data_t *send_data, msg_recv_buf_t *recv_data, msg_callback_info_t *cb_info)
 {
 	int recv_idx;
 	int ret = ERROR;
@@ -212,18 +233,37 @@ int messaging_send_internal(const char *port_name, msg_send_type_t msg_type, msg
 	int recv_arr[CONFIG_MESSAGING_RECV_LIST_SIZE];
 	char *private_portname;
 	int recv_cnt;
+	int sent_cnt = 0;
+	msg_shbuf_t *shbuf = NULL;
+
+#ifdef CONFIG_MESSAGING_SHARED_PAYLOAD
+	/* A large message is copied once into a shared buffer, and all receivers get the same buffer. */
+	if (send_data->msglen >= CONFIG_MESSAGING_SHARED_THRESHOLD) {
+		shbuf = messaging_shbuf_alloc(send_data);
+		if (shbuf == NULL) {
+			msgdbg("[Messaging] send fail : out of memory for shared buffer.\n");
+			return ERROR;
+		}
+	}
+#endif
 
 	/* Check that how many receivers are waiting. */
 	while (read_status != MSG_READ_ALL) {
 		(void)messaging_init_recv_arr(recv_arr);
-		read_status = READ_MSG_RECEIVER(port_name, recv_arr, recv_cnt);
+		if (port_id != MSG_PORT_ID_NONE) {
+			read_status = READ_MSG_RECEIVER_PORT(port_id, recv_arr, recv_cnt);
+		} else {
+			read_status = READ_MSG_RECEIVER(port_name, recv_arr, recv_cnt);
+		}
 		if (read_status == ERROR) {
-			return ERROR;
+			ret = ERROR;
+			goto errout;
 		}
 
 		if (msg_type != MSG_SEND_MULTI && recv_cnt > 1) {
 			msgdbg("[Messaging] send fail : too many receivers(%d)are waiting.\n", recv_cnt);
-			return ERROR;
+			ret = ERROR;
+			goto errout;
 		}
 
 		/* Send message to each receivers. */
@@ -234,25 +274,34 @@ int messaging_send_internal(const char *port_name, msg_send_type_t msg_type, msg
 			MSG_ASPRINTF(&private_portname, "%s%d", port_name, recv_arr[recv_idx]);
 			if (private_portname == NULL) {
 				msgdbg("[Messaging] send fail : out of memory for private portname.\n");
-				return ERROR;
+				ret = ERROR;
+				goto errout;
 			}
 			if (msg_type == MSG_SEND_ASYNC) {
 				if (recv_cnt == 1) {
 					ret = messaging_set_async_callback(port_name, recv_data, cb_info);
 					if (ret != OK) {
 						MSG_FREE(private_portname);
-						return ERROR;
+						ret = ERROR;
+						goto errout;
 					}
 				}
-				ret = messaging_send_packet(private_portname, msg_type, send_data, cb_info);
-			} else {
-				ret = messaging_send_packet(private_portname, msg_type, send_data, NULL);
 			}
+			ret = messaging_send_packet(private_portname, msg_type, send_data, shbuf);
 			MSG_FREE(private_portname);
 		}
+		sent_cnt += recv_cnt;
 	}
 	if (ret == OK) {
-		return recv_cnt;
+		ret = sent_cnt;
+	}
+
+errout:
+#ifdef CONFIG_MESSAGING_SHARED_PAYLOAD
+	/* Drop the reference of the sender. The buffer lives until all receivers have read it. */
+	if (shbuf != NULL) {
+		messaging_shbuf_release(shbuf);
 	}
+#endif
 	return ret;
 }
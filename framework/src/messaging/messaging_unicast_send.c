@@ -123,7 +123,7 @@ int messaging_send_sync(const char *port_name, msg_send_data_t *send_data, msg_r
 		return ERROR;
 	}
 
-	ret = messaging_send_internal(port_name, MSG_SEND_SYNC, send_data, NULL, NULL);
+	ret = messaging_send_internal(port_name, MSG_PORT_ID_NONE, MSG_SEND_SYNC, send_data, NULL, NULL);
 	if (ret == ERROR) {
 		return ERROR;
 	}
@@ -158,7 +158,7 @@ int messaging_send_async(const char *port_name, msg_send_data_t *send_data, msg_
 		return ERROR;
 	}
 
-	ret = messaging_send_internal(port_name, MSG_SEND_ASYNC, send_data, reply_buf, cb_info);
+	ret = messaging_send_internal(port_name, MSG_PORT_ID_NONE, MSG_SEND_ASYNC, send_data, reply_buf, cb_info);
 	if (ret == ERROR) {
 		return ERROR;
 	}
@@ -182,7 +182,7 @@ int messaging_send(const char *port_name, msg_send_data_t *send_data)
 		return ERROR;
 	}
 
-	ret = messaging_send_internal(port_name, MSG_SEND_NOREPLY, send_data, NULL, NULL);
+	ret = messaging_send_internal(port_name, MSG_PORT_ID_NONE, MSG_SEND_NOREPLY, send_data, NULL, NULL);
 	if (ret == ERROR) {
 		return ERROR;
 	}
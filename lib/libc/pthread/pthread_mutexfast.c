@@ -0,0 +1,134 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#if defined(CONFIG_PTHREAD_MUTEX_FASTPATH) && !defined(__KERNEL__)
+
+/* From here on the standard names refer to the system calls */
+
+#undef pthread_mutex_lock
+#undef pthread_mutex_trylock
+#undef pthread_mutex_unlock
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_mutex_fastacquire
+ *
+ * Description:
+ *   Try to lock a free mutex without entering the kernel.  The owner is
+ *   identified by an address on its stack because getpid() is a system
+ *   call.  Only NORMAL mutexes can be handled here; the other types need
+ *   the pid of the caller for the recursion and error checks.
+ *
+ ****************************************************************************/
+
+static inline bool pthread_mutex_fastacquire(FAR pthread_mutex_t *mutex)
+{
+	int expected = -1;
+
+#ifdef CONFIG_PTHREAD_MUTEX_TYPES
+	if (mutex->type != PTHREAD_MUTEX_NORMAL) {
+		return false;
+	}
+#endif
+
+	return __atomic_compare_exchange_n(&mutex->pid, &expected, _PTHREAD_MUTEX_FASTOWNER(&expected), false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_mutex_fastlock
+ *
+ * Description:
+ *   pthread_mutex_lock() for applications.  An uncontended mutex is locked
+ *   with a single compare-and-swap.  Otherwise the kernel takes over the
+ *   mutex from its owner, boosts the priority of the owner if needed and
+ *   blocks the caller.
+ *
+ ****************************************************************************/
+
+int pthread_mutex_fastlock(FAR pthread_mutex_t *mutex)
+{
+	if (mutex != NULL && pthread_mutex_fastacquire(mutex)) {
+		return OK;
+	}
+
+	return pthread_mutex_lock(mutex);
+}
+
+/****************************************************************************
+ * Name: pthread_mutex_fasttrylock
+ *
+ * Description:
+ *   pthread_mutex_trylock() for applications.
+ *
+ ****************************************************************************/
+
+int pthread_mutex_fasttrylock(FAR pthread_mutex_t *mutex)
+{
+	if (mutex != NULL && pthread_mutex_fastacquire(mutex)) {
+		return OK;
+	}
+
+	return pthread_mutex_trylock(mutex);
+}
+
+/****************************************************************************
+ * Name: pthread_mutex_fastunlock
+ *
+ * Description:
+ *   pthread_mutex_unlock() for applications.  A mutex which is still owned
+ *   from user space has no waiters and is released with a single
+ *   compare-and-swap.  Once the kernel has taken over the mutex, the
+ *   release must go through the kernel to wake up the waiter and restore
+ *   the priority of the caller.
+ *
+ ****************************************************************************/
+
+int pthread_mutex_fastunlock(FAR pthread_mutex_t *mutex)
+{
+	int owner;
+
+	if (mutex != NULL) {
+		owner = __atomic_load_n(&mutex->pid, __ATOMIC_RELAXED);
+		if (owner > 0 && (owner & _PTHREAD_MUTEX_FASTOWNED) != 0 &&
+			__atomic_compare_exchange_n(&mutex->pid, &owner, -1, false, __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+			return OK;
+		}
+	}
+
+	return pthread_mutex_unlock(mutex);
+}
+
+#endif							/* CONFIG_PTHREAD_MUTEX_FASTPATH && !__KERNEL__ */
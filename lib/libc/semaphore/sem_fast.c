@@ -0,0 +1,153 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <limits.h>
+#include <semaphore.h>
+
+#if defined(CONFIG_SEM_FASTPATH) && !defined(__KERNEL__)
+
+/* From here on the standard names refer to the system calls */
+
+#undef sem_wait
+#undef sem_trywait
+#undef sem_post
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sem_fastallowed
+ *
+ * Description:
+ *   Return true if the count of the semaphore may be changed without
+ *   entering the kernel.  Semaphores which save their holders for priority
+ *   inheritance need the kernel to maintain the holder list; only the
+ *   signaling semaphores skip it.
+ *
+ ****************************************************************************/
+
+static inline bool sem_fastallowed(FAR sem_t *sem)
+{
+	if (sem == NULL || (sem->flags & FLAGS_INITIALIZED) == 0) {
+		return false;
+	}
+#ifdef SAVE_SEM_HOLDER
+	return (sem->flags & FLAGS_SIGSEM) != 0;
+#else
+	return true;
+#endif
+}
+
+/****************************************************************************
+ * Name: sem_fasttake
+ *
+ * Description:
+ *   Decrement a positive count.  Returns false if the caller would block.
+ *
+ ****************************************************************************/
+
+static inline bool sem_fasttake(FAR sem_t *sem)
+{
+	int16_t count = __atomic_load_n(&sem->semcount, __ATOMIC_RELAXED);
+
+	while (count > 0) {
+		if (__atomic_compare_exchange_n(&sem->semcount, &count, count - 1, true, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sem_fastwait
+ *
+ * Description:
+ *   sem_wait() for applications.  sem_wait() is a cancellation point, so
+ *   the kernel is always entered when cancellation points are enabled.
+ *
+ ****************************************************************************/
+
+int sem_fastwait(FAR sem_t *sem)
+{
+#ifndef CONFIG_CANCELLATION_POINTS
+	if (sem_fastallowed(sem) && sem_fasttake(sem)) {
+		return OK;
+	}
+#endif
+
+	return sem_wait(sem);
+}
+
+/****************************************************************************
+ * Name: sem_fasttrywait
+ *
+ * Description:
+ *   sem_trywait() for applications.
+ *
+ ****************************************************************************/
+
+int sem_fasttrywait(FAR sem_t *sem)
+{
+	if (sem_fastallowed(sem) && sem_fasttake(sem)) {
+		return OK;
+	}
+
+	return sem_trywait(sem);
+}
+
+/****************************************************************************
+ * Name: sem_fastpost
+ *
+ * Description:
+ *   sem_post() for applications.  A negative count means that tasks are
+ *   waiting and one of them has to be woken up by the kernel.
+ *
+ ****************************************************************************/
+
+int sem_fastpost(FAR sem_t *sem)
+{
+	int16_t count;
+
+	if (sem_fastallowed(sem)) {
+		count = __atomic_load_n(&sem->semcount, __ATOMIC_RELAXED);
+		while (count >= 0 && count < SEM_VALUE_MAX) {
+			if (__atomic_compare_exchange_n(&sem->semcount, &count, count + 1, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+				return OK;
+			}
+		}
+	}
+
+	return sem_post(sem);
+}
+
+#endif							/* CONFIG_SEM_FASTPATH && !__KERNEL__ */
@@ -158,6 +158,10 @@ bool up_interrupt_context(void);
 #ifdef __cplusplus
 }
 #endif
+
+/* Route irqsave()/irqrestore() through the critical section monitor */
+
+#include <tinyara/irqlatency.h>
 #endif
 
 #endif							/* __ARCH_ARM_INCLUDE_IRQ_H */
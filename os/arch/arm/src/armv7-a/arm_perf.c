@@ -39,10 +39,14 @@
  * Included Files
  ****************************************************************************/
 
+#include <errno.h>
+
 #include <tinyara/arch.h>
 #include <tinyara/clock.h>
+#include <tinyara/perf.h>
 
 #include "arm_internal.h"
+#include "barriers.h"
 #include "sctlr.h"
 
 /****************************************************************************
@@ -51,6 +55,26 @@
 
 static uint32_t g_cpu_freq;
 
+#ifdef CONFIG_PERF_COUNTERS
+/* PMU event number of each PERF_EVENT_*, zero if it is not implemented.
+ * PERF_EVENT_CYCLES uses the dedicated cycle counter instead.
+ */
+
+static const uint8_t g_perf_pmu_events[PERF_EVENT_MAX] =
+{
+  [PERF_EVENT_INSTRUCTIONS]  = PMETSR_INSTARCHEXEC,
+  [PERF_EVENT_CACHE_REFS]    = PMETSR_L1_DC_ACC,
+  [PERF_EVENT_CACHE_MISSES]  = PMETSR_L1_DC_FILL,
+  [PERF_EVENT_ICACHE_MISSES] = PMETSR_L1_IC_FILL,
+  [PERF_EVENT_BRANCH_MISSES] = PMETSR_MISPREDICTEDBRANCHEXEC,
+  [PERF_EVENT_EXCEPTIONS]    = PMETSR_EXCEPETIONTAKEN,
+};
+
+/* PMU event counter of each configured event, -1 for the cycle counter */
+
+static int8_t g_perf_counter[PERF_MAX_COUNTERS];
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -102,3 +126,87 @@ void up_perf_convert(uint32_t elapsed, struct timespec *ts)
   left        = elapsed - ts->tv_sec * g_cpu_freq;
   ts->tv_nsec = NSEC_PER_SEC * (uint64_t)left / g_cpu_freq;
 }
+
+#ifdef CONFIG_PERF_COUNTERS
+/****************************************************************************
+ * Name: up_perf_counters_config
+ *
+ * Description:
+ *   Assign the events to the PMU event counters in order, and the cycles
+ *   to PMCCNTR.
+ *
+ ****************************************************************************/
+
+int up_perf_counters_config(const uint8_t *events, int nevents,
+                            uint32_t *masks)
+{
+  unsigned int ncounters;
+  unsigned int enable = 0;
+  int next = 0;
+  int i;
+
+  ncounters = (cp15_pmu_rdpmcr() & PMCR_N_MASK) >> PMCR_N_SHIFT;
+
+  for (i = 0; i < nevents; i++)
+    {
+      if (events[i] == PERF_EVENT_CYCLES)
+        {
+          if (enable & PMCESR_CCES)
+            {
+              return -EBUSY;
+            }
+
+          g_perf_counter[i] = -1;
+          enable |= PMCESR_CCES;
+        }
+      else if (events[i] < PERF_EVENT_MAX &&
+               g_perf_pmu_events[events[i]] != 0)
+        {
+          if (next >= ncounters)
+            {
+              return -EBUSY;
+            }
+
+          cp15_pmu_wrecsr(next);
+          ARM_ISB();
+          cp15_pmu_wretsr(g_perf_pmu_events[events[i]]);
+          g_perf_counter[i] = next;
+          enable |= 1 << next;
+          next++;
+        }
+      else
+        {
+          return -ENOTSUP;
+        }
+
+      masks[i] = 0xffffffff;
+    }
+
+  cp15_pmu_cesr(enable);
+  cp15_pmu_pmcr(PMCR_E);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: up_perf_counters_read
+ ****************************************************************************/
+
+void up_perf_counters_read(uint32_t *values, int nevents)
+{
+  int i;
+
+  for (i = 0; i < nevents; i++)
+    {
+      if (g_perf_counter[i] < 0)
+        {
+          values[i] = cp15_pmu_rdccr();
+        }
+      else
+        {
+          cp15_pmu_wrecsr(g_perf_counter[i]);
+          ARM_ISB();
+          values[i] = cp15_pmu_rdecr();
+        }
+    }
+}
+#endif
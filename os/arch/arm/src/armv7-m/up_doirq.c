@@ -60,6 +60,7 @@
 #include <assert.h>
 
 #include <tinyara/irq.h>
+#include <tinyara/irqlatency.h>
 #include <tinyara/arch.h>
 #include <arch/board/board.h>
 
@@ -91,6 +92,8 @@ int g_irq_nums[3] = {0}; /* Array to store the last three interrupt numbers */
 
 uint32_t *up_doirq(int irq, uint32_t *regs)
 {
+	irqlatency_entry();
+
 	/* Store the last three interrupt numbers for reference during assert */
 	g_irq_nums[2] = g_irq_nums[1];
 	g_irq_nums[1] = g_irq_nums[0];
@@ -0,0 +1,149 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * arch/arm/src/armv7-r/arm_perf.c
+ *
+ *   Event counters of the Performance Monitors Unit.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdint.h>
+#include <errno.h>
+
+#include <tinyara/arch.h>
+#include <tinyara/perf.h>
+
+#include "sctlr.h"
+
+#ifdef CONFIG_PERF_COUNTERS
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Architectural PMU event numbers */
+
+#define PMU_EVENT_L1I_REFILL        0x01
+#define PMU_EVENT_L1D_REFILL        0x03
+#define PMU_EVENT_L1D_ACCESS        0x04
+#define PMU_EVENT_INSTRUCTIONS      0x08
+#define PMU_EVENT_EXCEPTIONS        0x09
+#define PMU_EVENT_BRANCH_MISPRED    0x10
+
+/* Count enable bit of the cycle counter in PMCNTENSET */
+
+#define PMU_CYCLE_COUNTER           (1 << 31)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* PMU event number of each PERF_EVENT_*, zero if it is not implemented.
+ * PERF_EVENT_CYCLES uses the dedicated cycle counter instead.
+ */
+
+static const uint8_t g_perf_pmu_events[PERF_EVENT_MAX] = {
+	[PERF_EVENT_INSTRUCTIONS] = PMU_EVENT_INSTRUCTIONS,
+	[PERF_EVENT_CACHE_REFS] = PMU_EVENT_L1D_ACCESS,
+	[PERF_EVENT_CACHE_MISSES] = PMU_EVENT_L1D_REFILL,
+	[PERF_EVENT_ICACHE_MISSES] = PMU_EVENT_L1I_REFILL,
+	[PERF_EVENT_BRANCH_MISSES] = PMU_EVENT_BRANCH_MISPRED,
+	[PERF_EVENT_EXCEPTIONS] = PMU_EVENT_EXCEPTIONS,
+};
+
+/* PMU event counter of each configured event, -1 for the cycle counter */
+
+static int8_t g_perf_counter[PERF_MAX_COUNTERS];
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: up_perf_counters_config
+ *
+ * Description:
+ *   Assign the events to the PMU event counters in order, and the cycles
+ *   to PMCCNTR.  The Cortex-R4 and R5 have three event counters.
+ *
+ ****************************************************************************/
+
+int up_perf_counters_config(FAR const uint8_t *events, int nevents, FAR uint32_t *masks)
+{
+	unsigned int ncounters;
+	unsigned int enable = 0;
+	int next = 0;
+	int i;
+
+	ncounters = (cp15_rdpmcr() & PCMR_N_MASK) >> PCMR_N_SHIFT;
+
+	for (i = 0; i < nevents; i++) {
+		if (events[i] == PERF_EVENT_CYCLES) {
+			if (enable & PMU_CYCLE_COUNTER) {
+				return -EBUSY;
+			}
+
+			g_perf_counter[i] = -1;
+			enable |= PMU_CYCLE_COUNTER;
+		} else if (events[i] < PERF_EVENT_MAX && g_perf_pmu_events[events[i]] != 0) {
+			if (next >= ncounters) {
+				return -EBUSY;
+			}
+
+			cp15_wrpmselr(next);
+			cp15_wrpmxevtyper(g_perf_pmu_events[events[i]]);
+			g_perf_counter[i] = next;
+			enable |= 1 << next;
+			next++;
+		} else {
+			return -ENOTSUP;
+		}
+
+		masks[i] = 0xffffffff;
+	}
+
+	cp15_wrpmcntenset(enable);
+	cp15_wrpmcr(cp15_rdpmcr() | PCMR_E);
+	return OK;
+}
+
+/****************************************************************************
+ * Name: up_perf_counters_read
+ ****************************************************************************/
+
+void up_perf_counters_read(FAR uint32_t *values, int nevents)
+{
+	int i;
+
+	for (i = 0; i < nevents; i++) {
+		if (g_perf_counter[i] < 0) {
+			values[i] = cp15_rdpmccntr();
+		} else {
+			cp15_wrpmselr(g_perf_counter[i]);
+			values[i] = cp15_rdpmxevcntr();
+		}
+	}
+}
+
+#endif							/* CONFIG_PERF_COUNTERS */
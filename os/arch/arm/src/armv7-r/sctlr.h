@@ -530,6 +530,78 @@ static inline void cp15_wrpmcr(unsigned int pmcr)
 	);
 }
 
+/* Write the Performance Monitors Count Enable Set register (PMCNTENSET) */
+
+static inline void cp15_wrpmcntenset(unsigned int cntenset)
+{
+	__asm__ __volatile__
+	(
+		"\tmcr p15, 0, %0, c9, c12, 1\n"
+		:
+		: "r"(cntenset)
+		: "memory"
+	);
+}
+
+/* Write the Performance Monitors Event Counter Selection Register (PMSELR) */
+
+static inline void cp15_wrpmselr(unsigned int pmselr)
+{
+	__asm__ __volatile__
+	(
+		"\tmcr p15, 0, %0, c9, c12, 5\n"
+		"\tisb\n"
+		:
+		: "r"(pmselr)
+		: "memory"
+	);
+}
+
+/* Read the Performance Monitors Cycle Count Register (PMCCNTR) */
+
+static inline unsigned int cp15_rdpmccntr(void)
+{
+	unsigned int pmccntr;
+	__asm__ __volatile__
+	(
+		"\tmrc p15, 0, %0, c9, c13, 0\n"
+		: "=r"(pmccntr)
+		:
+		: "memory"
+	);
+
+	return pmccntr;
+}
+
+/* Write the Event Type Select Register (PMXEVTYPER) of the selected counter */
+
+static inline void cp15_wrpmxevtyper(unsigned int evtyper)
+{
+	__asm__ __volatile__
+	(
+		"\tmcr p15, 0, %0, c9, c13, 1\n"
+		:
+		: "r"(evtyper)
+		: "memory"
+	);
+}
+
+/* Read the Event Count Register (PMXEVCNTR) of the selected counter */
+
+static inline unsigned int cp15_rdpmxevcntr(void)
+{
+	unsigned int evcntr;
+	__asm__ __volatile__
+	(
+		"\tmrc p15, 0, %0, c9, c13, 2\n"
+		: "=r"(evcntr)
+		:
+		: "memory"
+	);
+
+	return evcntr;
+}
+
 #endif							/* __ASSEMBLY__ */
 
 /****************************************************************************
@@ -0,0 +1,296 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * arch/arm/src/armv8-m/up_perf.c
+ *
+ *   Cycle and profiling counters of the Data Watchpoint and Trace unit and
+ *   call stack sampling of the interrupted context.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+
+#include <tinyara/arch.h>
+#include <tinyara/perf.h>
+#include <arch/irq.h>
+
+#include "sched/sched.h"
+#include "up_arch.h"
+#include "up_internal.h"
+#include "nvic.h"
+#include "dwt.h"
+
+#ifdef CONFIG_ARCH_HAVE_PERF_EVENTS
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Number of stack words searched for return addresses per call stack */
+
+#define PERF_STACK_SCANWORDS    256
+
+/* LR holds an EXC_RETURN value when an exception handler was interrupted */
+
+#define PERF_EXC_RETURN_MASK    0xff000000
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static uint32_t g_perf_freq;
+
+#ifdef CONFIG_PERF_COUNTERS
+/* DWT counters by PERF_EVENT_*.  Only CYCCNT has 32 bits, the profiling
+ * counters are 8 bits wide.
+ */
+
+static const struct {
+	uint8_t event;
+	uint32_t reg;
+	uint32_t enable;
+	uint32_t mask;
+} g_perf_dwt[] = {
+	{ PERF_EVENT_CYCLES,       DWT_CYCCNT,   DWT_CTRL_CYCCNTENA_Msk,   0xffffffff },
+	{ PERF_EVENT_STALL_CYCLES, DWT_CPICNT,   DWT_CTRL_CPIEVTENA_Msk,   0xff },
+	{ PERF_EVENT_LSU_CYCLES,   DWT_LSUCNT,   DWT_CTRL_LSUEVTENA_Msk,   0xff },
+	{ PERF_EVENT_EXC_CYCLES,   DWT_EXCCNT,   DWT_CTRL_EXCEVTENA_Msk,   0xff },
+	{ PERF_EVENT_SLEEP_CYCLES, DWT_SLEEPCNT, DWT_CTRL_SLEEPEVTENA_Msk, 0xff },
+	{ PERF_EVENT_FOLDED,       DWT_FOLDCNT,  DWT_CTRL_FOLDEVTENA_Msk,  0xff },
+};
+
+/* Counter register of each configured event */
+
+static uint32_t g_perf_regs[PERF_MAX_COUNTERS];
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static bool up_perf_istext(uint32_t addr)
+{
+	if (addr >= (uint32_t)&_stext_flash && addr < (uint32_t)&_etext_flash) {
+		return true;
+	}
+#ifdef CONFIG_ARCH_HAVE_RAM_KERNEL_TEXT
+	if (addr >= (uint32_t)&_stext_ram && addr < (uint32_t)&_etext_ram) {
+		return true;
+	}
+#endif
+	return false;
+}
+
+/****************************************************************************
+ * Name: up_perf_isreturn
+ *
+ * Description:
+ *   Check whether value is a Thumb return address, that is an odd address
+ *   in the text which follows a BL or a BLX instruction.
+ *
+ ****************************************************************************/
+
+static bool up_perf_isreturn(uint32_t value)
+{
+	uint32_t addr = value & ~1;
+	uint16_t insn;
+
+	if ((value & 1) == 0 || !up_perf_istext(addr - 4) || !up_perf_istext(addr)) {
+		return false;
+	}
+
+	/* BLX <Rm> */
+
+	insn = *(FAR const uint16_t *)(addr - 2);
+	if ((insn & 0xff87) == 0x4780) {
+		return true;
+	}
+
+	/* BL <label>, 32-bit */
+
+	return (*(FAR const uint16_t *)(addr - 4) & 0xf800) == 0xf000 && (insn & 0xd000) == 0xd000;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: up_perf_init
+ *
+ * Description:
+ *   Enable the trace blocks and start DWT CYCCNT.  arg is the frequency of
+ *   the CPU clock in Hz.
+ *
+ ****************************************************************************/
+
+void up_perf_init(FAR void *arg)
+{
+	g_perf_freq = (uint32_t)(uintptr_t)arg;
+
+	modifyreg32(NVIC_DEMCR, 0, NVIC_DEMCR_TRCENA);
+	putreg32(0, DWT_CYCCNT);
+	modifyreg32(DWT_CTRL, 0, DWT_CTRL_CYCCNTENA_Msk);
+}
+
+/****************************************************************************
+ * Name: up_perf_gettime
+ ****************************************************************************/
+
+uint32_t up_perf_gettime(void)
+{
+	return getreg32(DWT_CYCCNT);
+}
+
+/****************************************************************************
+ * Name: up_perf_getfreq
+ ****************************************************************************/
+
+uint32_t up_perf_getfreq(void)
+{
+	return g_perf_freq;
+}
+
+/****************************************************************************
+ * Name: up_perf_callstack
+ *
+ * Description:
+ *   Report the interrupted PC, LR if it is a return address, and the
+ *   return addresses found in the stack of the interrupted task.  Thumb
+ *   code built with GCC keeps no frame chain that could be followed, so
+ *   the words just above the interrupted SP are searched instead, and only
+ *   values pointing behind a call instruction are taken.  Stale return
+ *   addresses left in uninitialized locals may still show up.  Nothing is
+ *   walked when an exception handler was interrupted.
+ *
+ ****************************************************************************/
+
+int up_perf_callstack(FAR uint32_t *pcs, int depth)
+{
+	FAR uint32_t *regs = (FAR uint32_t *)current_regs;
+	FAR struct tcb_s *rtcb = this_task();
+	FAR uint32_t *sp;
+	FAR uint32_t *top;
+	uint32_t value;
+	int n = 0;
+
+	if (regs == NULL || depth <= 0) {
+		return 0;
+	}
+
+	pcs[n++] = regs[REG_PC];
+
+	value = regs[REG_LR];
+	if ((value & PERF_EXC_RETURN_MASK) == PERF_EXC_RETURN_MASK) {
+		return n;
+	}
+
+	if (n < depth && up_perf_isreturn(value)) {
+		pcs[n++] = value & ~1;
+	}
+
+	sp = (FAR uint32_t *)regs[REG_SP];
+	top = (FAR uint32_t *)rtcb->adj_stack_ptr;
+	if (sp < (FAR uint32_t *)rtcb->stack_alloc_ptr || sp >= top) {
+		return n;
+	}
+
+	if (top - sp > PERF_STACK_SCANWORDS) {
+		top = sp + PERF_STACK_SCANWORDS;
+	}
+
+	for (; sp < top && n < depth; sp++) {
+		value = *sp;
+		if (up_perf_isreturn(value) && (value & ~1) != pcs[n - 1]) {
+			pcs[n++] = value & ~1;
+		}
+	}
+
+	return n;
+}
+
+#ifdef CONFIG_PERF_COUNTERS
+/****************************************************************************
+ * Name: up_perf_counters_config
+ *
+ * Description:
+ *   Map the events to the DWT counters.  Each counter counts one fixed
+ *   event, so an event may be given only once.  The counters are never
+ *   stopped again: CYCCNT is shared with the timestamps and the others
+ *   cost nothing while they are not read.
+ *
+ ****************************************************************************/
+
+int up_perf_counters_config(FAR const uint8_t *events, int nevents, FAR uint32_t *masks)
+{
+	uint32_t enable = 0;
+	int i;
+	int j;
+
+	if (nevents > PERF_MAX_COUNTERS) {
+		return -EBUSY;
+	}
+
+	for (i = 0; i < nevents; i++) {
+		for (j = 0; j < sizeof(g_perf_dwt) / sizeof(g_perf_dwt[0]); j++) {
+			if (g_perf_dwt[j].event == events[i]) {
+				break;
+			}
+		}
+
+		if (j == sizeof(g_perf_dwt) / sizeof(g_perf_dwt[0])) {
+			return -ENOTSUP;
+		}
+
+		if (enable & g_perf_dwt[j].enable) {
+			return -EBUSY;
+		}
+
+		enable |= g_perf_dwt[j].enable;
+		g_perf_regs[i] = g_perf_dwt[j].reg;
+		masks[i] = g_perf_dwt[j].mask;
+	}
+
+	modifyreg32(NVIC_DEMCR, 0, NVIC_DEMCR_TRCENA);
+	modifyreg32(DWT_CTRL, 0, enable);
+	return OK;
+}
+
+/****************************************************************************
+ * Name: up_perf_counters_read
+ ****************************************************************************/
+
+void up_perf_counters_read(FAR uint32_t *values, int nevents)
+{
+	int i;
+
+	for (i = 0; i < nevents; i++) {
+		values[i] = getreg32(g_perf_regs[i]);
+	}
+}
+#endif
+
+#endif							/* CONFIG_ARCH_HAVE_PERF_EVENTS */
@@ -37,6 +37,9 @@
 #include "mpu.h"
 #endif
 #include <tinyara/arch.h>
+#include <tinyara/ttrace.h>
+#include <tinyara/perf.h>
+#include <tinyara/irqlatency.h>
 
 #include "up_internal.h"
 #include "sched/sched.h"
@@ -72,6 +75,9 @@ void up_restoretask(struct tcb_s *tcb)
 		/* Save the task name which will be scheduled */
 		save_task_scheduling_status(tcb);
 #endif
+		ttrace_switch(tcb);
+		perf_update(tcb);
+		irqlatency_switch();
 
 		/* Restore the MPU registers in case we are switching to an application task */
 #ifdef CONFIG_APP_BINARY_SEPARATION
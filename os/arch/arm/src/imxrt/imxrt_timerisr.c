@@ -245,4 +245,10 @@ void up_timer_initialize(void)
 	/* And enable the timer interrupt */
 
 	up_enable_irq(IMXRT_IRQ_SYSTICK);
+
+#ifdef CONFIG_ARCH_HAVE_PERF_EVENTS
+	/* Start the cycle counter used for fine grained timestamps */
+
+	up_perf_init((FAR void *)BOARD_CPU_FREQUENCY);
+#endif
 }
@@ -156,4 +156,10 @@ void up_timer_initialize(void)
 	/* And enable the timer interrupt */
 
 	up_enable_irq(TIVA_IRQ_SYSTICK);
+
+#ifdef CONFIG_ARCH_HAVE_PERF_EVENTS
+	/* Start the cycle counter used for fine grained timestamps */
+
+	up_perf_init((FAR void *)SYSCLK_FREQUENCY);
+#endif
 }
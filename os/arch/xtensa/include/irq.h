@@ -320,5 +320,9 @@ irqstate_t xtensa_disable_interrupts(irqstate_t mask);
 }
 #endif
 
+/* Route irqsave()/irqrestore() through the critical section monitor */
+
+#include <tinyara/irqlatency.h>
+
 #endif							/* __ASSEMBLY__ */
 #endif							/* __ARCH_XTENSA_INCLUDE_IRQ_H */
@@ -76,6 +76,9 @@
  ****************************************************************************/
 
 static uint32_t g_tick_divisor;
+#ifdef CONFIG_ARCH_HAVE_PERF_EVENTS
+static uint32_t g_perf_freq;
+#endif
 
 /****************************************************************************
  * Private Functions
@@ -218,4 +221,62 @@ void xtensa_timer_initialize(void)
 
 	up_enable_irq(ESP32_CPUINT_TIMER0);
 
+#ifdef CONFIG_ARCH_HAVE_PERF_EVENTS
+	up_perf_init((FAR void *)BOARD_CLOCK_FREQUENCY);
+#endif
 }
+
+#ifdef CONFIG_ARCH_HAVE_PERF_EVENTS
+/****************************************************************************
+ * Name: up_perf_init, up_perf_gettime and up_perf_getfreq
+ *
+ * Description:
+ *   CCOUNT is always running at the CPU clock, so there is nothing to
+ *   enable.
+ *
+ ****************************************************************************/
+
+void up_perf_init(FAR void *arg)
+{
+	g_perf_freq = (uint32_t)(uintptr_t)arg;
+}
+
+uint32_t up_perf_gettime(void)
+{
+	return xtensa_getcount();
+}
+
+uint32_t up_perf_getfreq(void)
+{
+	return g_perf_freq;
+}
+
+/****************************************************************************
+ * Name: up_perf_callstack
+ *
+ * Description:
+ *   Report the interrupted PC and the return address held in a0.  With the
+ *   windowed ABI the two top bits of a0 hold the window increment instead
+ *   of address bits, so they are taken from the PC.  Deeper frames live in
+ *   register windows which may not have been spilled, so they are not
+ *   walked.
+ *
+ ****************************************************************************/
+
+int up_perf_callstack(FAR uint32_t *pcs, int depth)
+{
+	FAR volatile uint32_t *regs = CURRENT_REGS;
+	int n = 0;
+
+	if (regs == NULL || depth <= 0) {
+		return 0;
+	}
+
+	pcs[n++] = regs[REG_PC];
+	if (n < depth && regs[REG_A0] != 0) {
+		pcs[n++] = (regs[REG_A0] & 0x3fffffff) | (regs[REG_PC] & 0xc0000000);
+	}
+
+	return n;
+}
+#endif
@@ -58,6 +58,7 @@
 
 #include <stdint.h>
 #include <tinyara/irq.h>
+#include <tinyara/irqlatency.h>
 #include <tinyara/arch.h>
 #include <assert.h>
 
@@ -76,6 +77,7 @@
 
 uint32_t *xtensa_irq_dispatch(int irq, uint32_t *regs)
 {
+	irqlatency_entry();
 
 #ifdef CONFIG_SUPPRESS_INTERRUPTS
 	board_autoled_on(LED_INIRQ);
@@ -67,6 +67,7 @@
 #include <tinyara/mm/mm.h>
 #include <tinyara/kmalloc.h>
 #include <tinyara/binfmt/binfmt.h>
+#include <tinyara/binfmt/elf.h>
 
 #include "binfmt.h"
 
@@ -114,6 +115,9 @@ int binfmt_exit(FAR struct binary_s *bin)
 	}
 
 	elf_delete_bin_section_addr(bin->binary_idx);
+#ifdef CONFIG_ELF_LAZY_LOAD
+	elf_lazy_release(bin->binary_idx);
+#endif
 
 	uheap_start = (uint32_t)bin->uheap;
 	uheap_end = uheap_start + bin->sizes[BIN_HEAP];
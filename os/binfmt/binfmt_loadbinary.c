@@ -32,6 +32,7 @@
 #include <tinyara/kmalloc.h>
 #include <tinyara/sched.h>
 #include <tinyara/binfmt/binfmt.h>
+#include <tinyara/binfmt/elf.h>
 #include <tinyara/binary_manager.h>
 
 #ifdef CONFIG_SAVE_BIN_SECTION_ADDR
@@ -217,6 +218,9 @@ int load_binary(int binary_idx, FAR const char *filename, load_attr_t *load_attr
 		errcode = pid;
 		berr("ERROR: Failed to execute program '%s': %d\n", filename, errcode);
 		elf_delete_bin_section_addr(bin->binary_idx);
+#ifdef CONFIG_ELF_LAZY_LOAD
+		elf_lazy_release(bin->binary_idx);
+#endif
 		goto errout_with_unload;
 	}
 
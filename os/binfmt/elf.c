@@ -216,6 +216,14 @@ static int elf_loadbinary(FAR struct binary_s *binp)
 	loadinfo.filelen = binp->filelen;
 	loadinfo.binp = binp;
 
+#ifdef CONFIG_ELF_LAZY_LOAD
+	/* Sections of other binaries may be loaded on demand meanwhile, and
+	 * both use the same decompression buffers.
+	 */
+
+	elf_lazy_lock();
+#endif
+
 	ret = elf_init(binp->filename, &loadinfo);
 	if (ret != 0) {
 		elf_dumploadinfo(&loadinfo);
@@ -240,6 +248,15 @@ static int elf_loadbinary(FAR struct binary_s *binp)
 		goto errout_with_load;
 	}
 
+#ifdef CONFIG_ELF_LAZY_LOAD
+	/* Keep what is needed to load the deferred sections later */
+
+	ret = elf_lazy_save(&loadinfo, binp->filename);
+	if (ret != 0) {
+		berr("Failed to save deferred sections: %d\n", ret);
+		goto errout_with_load;
+	}
+#endif
 
 	binp->entrypt = (main_t)((uint32_t)loadinfo.binp->sections[BIN_TEXT] + loadinfo.ehdr.e_entry);
 	if (binp->stacksize == 0) {
@@ -263,6 +280,9 @@ static int elf_loadbinary(FAR struct binary_s *binp)
 
 	elf_dumpentrypt(binp, &loadinfo);
 	elf_uninit(&loadinfo);
+#ifdef CONFIG_ELF_LAZY_LOAD
+	elf_lazy_unlock();
+#endif
 	return OK;
 
 errout_with_load:
@@ -270,6 +290,9 @@ errout_with_load:
 errout_with_init:
 	elf_uninit(&loadinfo);
 errout:
+#ifdef CONFIG_ELF_LAZY_LOAD
+	elf_lazy_unlock();
+#endif
 	return ret;
 }
 
@@ -138,6 +138,20 @@ int elf_loadshdrs(FAR struct elf_loadinfo_s *loadinfo);
 
 int elf_findsection(FAR struct elf_loadinfo_s *loadinfo, FAR const char *sectname);
 
+/****************************************************************************
+ * Name: elf_sectname
+ *
+ * Description:
+ *   Get the name of the section 'shdr' in loadinfo->iobuffer[].
+ *
+ * Returned Value:
+ *   0 (OK) is returned on success and a negated errno is returned on
+ *   failure.
+ *
+ ****************************************************************************/
+
+int elf_sectname(FAR struct elf_loadinfo_s *loadinfo, FAR const Elf32_Shdr *shdr);
+
 /****************************************************************************
  * Name: elf_readstrtab
  *
@@ -426,4 +440,84 @@ void *elf_find_start_section_addr(struct binary_s *binp);
 #endif
 #endif /* CONFIG_APP_BINARY_SEPARATION */
 
+#ifdef CONFIG_ELF_LAZY_LOAD
+/****************************************************************************
+ * Name: elf_lazy_defer
+ *
+ * Description:
+ *   Decide whether the allocated section 'shndx' is loaded on demand.  A
+ *   deferred section is not read; its memory at 'dest' is filled with a
+ *   fault pattern instead.
+ *
+ * Returned Value:
+ *   1 if the section is deferred, 0 if it must be read now, a negated
+ *   errno value on failure.
+ *
+ ****************************************************************************/
+
+int elf_lazy_defer(FAR struct elf_loadinfo_s *loadinfo, int shndx, FAR uint8_t *dest);
+
+/****************************************************************************
+ * Name: elf_lazy_deferrel
+ *
+ * Description:
+ *   Return true if the relocation section 'relidx' applies to the deferred
+ *   section 'dstidx' and must not be processed by elf_bind().
+ *
+ ****************************************************************************/
+
+bool elf_lazy_deferrel(FAR struct elf_loadinfo_s *loadinfo, int relidx, int dstidx);
+
+/****************************************************************************
+ * Name: elf_lazy_save
+ *
+ * Description:
+ *   Keep the deferred section information of a bound binary so that the
+ *   sections can be loaded later by elf_lazy_load().
+ *
+ * Returned Value:
+ *   0 (OK) is returned on success and a negated errno is returned on
+ *   failure.
+ *
+ ****************************************************************************/
+
+int elf_lazy_save(FAR struct elf_loadinfo_s *loadinfo, FAR const char *filename);
+
+/****************************************************************************
+ * Name: elf_lazy_lock / elf_lazy_unlock
+ *
+ * Description:
+ *   Serialize loading binaries with loading deferred sections.  Both use the
+ *   same decompression state.
+ *
+ ****************************************************************************/
+
+void elf_lazy_lock(void);
+void elf_lazy_unlock(void);
+
+/****************************************************************************
+ * Name: elf_lazy_free
+ *
+ * Description:
+ *   Free the deferred section information of a load that did not complete.
+ *
+ ****************************************************************************/
+
+void elf_lazy_free(FAR struct elf_loadinfo_s *loadinfo);
+
+/****************************************************************************
+ * Name: elf_bind_section
+ *
+ * Description:
+ *   Apply the relocation section 'relidx' to a section loaded on demand.
+ *
+ * Returned Value:
+ *   0 (OK) is returned on success and a negated errno is returned on
+ *   failure.
+ *
+ ****************************************************************************/
+
+int elf_bind_section(FAR struct elf_loadinfo_s *loadinfo, int relidx);
+#endif
+
 #endif							/* __BINFMT_LIBELF_LIBELF_H */
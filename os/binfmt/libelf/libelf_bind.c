@@ -450,6 +450,14 @@ int elf_bind(FAR struct elf_loadinfo_s *loadinfo, FAR const struct symtab_s *exp
 			continue;
 		}
 
+#ifdef CONFIG_ELF_LAZY_LOAD
+		/* Sections loaded on demand are relocated when they are loaded */
+
+		if (elf_lazy_deferrel(loadinfo, i, infosec)) {
+			continue;
+		}
+#endif
+
 		/* Process the relocations by type */
 
 		if (loadinfo->shdr[i].sh_type == SHT_REL) {
@@ -488,3 +496,64 @@ ret_err:
 
 	return ret;
 }
+
+#ifdef CONFIG_ELF_LAZY_LOAD
+/****************************************************************************
+ * Name: elf_bind_section
+ *
+ * Description:
+ *   Apply the relocation section 'relidx' of a binary that is already
+ *   bound.  Used to relocate a section that was loaded on demand.
+ *
+ * Returned Value:
+ *   0 (OK) is returned on success and a negated errno is returned on
+ *   failure.
+ *
+ ****************************************************************************/
+
+int elf_bind_section(FAR struct elf_loadinfo_s *loadinfo, int relidx)
+{
+	FAR const struct symtab_s *exports = loadinfo->binp->exports;
+	int nexports = loadinfo->binp->nexports;
+	int ret;
+
+	ret = elf_findsymtab(loadinfo);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (!loadinfo->cached_read && elf_readsymtab(loadinfo) == -ENOMEM) {
+		elf_enable_caching(loadinfo);
+	}
+
+	if (!loadinfo->cached_read && elf_readstrtab(loadinfo) == -ENOMEM) {
+		elf_enable_caching(loadinfo);
+	}
+
+#ifdef CONFIG_SUPPORT_COMMON_BINARY
+	if (!loadinfo->binp->islibrary) {
+		exports = (struct symtab_s *)g_lib_symhash;
+		nexports = g_num_lib_syms;
+	}
+#endif
+
+	/* Process the relocations by type, as elf_bind() does */
+
+	if (loadinfo->shdr[relidx].sh_type == SHT_REL) {
+		ret = elf_relocate(loadinfo, relidx, exports, nexports);
+	} else if (loadinfo->shdr[relidx].sh_type == SHT_RELA) {
+		ret = elf_relocateadd(loadinfo, relidx, exports, nexports);
+	}
+
+	if (loadinfo->strtab) {
+		kmm_free((void *)loadinfo->strtab);
+		loadinfo->strtab = (uintptr_t)NULL;
+	}
+	if (loadinfo->symtab) {
+		kmm_free((void *)loadinfo->symtab);
+		loadinfo->symtab = (uintptr_t)NULL;
+	}
+
+	return ret;
+}
+#endif
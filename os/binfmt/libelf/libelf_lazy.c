@@ -0,0 +1,416 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <semaphore.h>
+#include <assert.h>
+#include <debug.h>
+#include <errno.h>
+
+#include <tinyara/kmalloc.h>
+#include <tinyara/binfmt/binfmt.h>
+#include <tinyara/binfmt/elf.h>
+#include <tinyara/binary_manager.h>
+
+#include "libelf.h"
+
+#ifdef CONFIG_ELF_LAZY_LOAD
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Deferred sections are filled with this byte until they are loaded.
+ * 0xdede is the Thumb UDF instruction, so a call into a section that was
+ * not loaded yet ends in a usage fault instead of running garbage.
+ */
+
+#define ELF_LAZY_FILL		0xde
+
+#define ELF_LAZY_PREFIX_LEN	(sizeof(CONFIG_ELF_LAZY_SECTION_PREFIX) - 1)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* A section whose loading is deferred */
+
+struct elf_lazysect_s {
+	uint16_t shndx;				/* Index of the section */
+	uint16_t relidx;			/* Index of its relocation section, 0 if none */
+	bool loaded;				/* Section data is in place and relocated */
+};
+
+/* Everything needed to load the deferred sections of one binary after the
+ * loader is done with it.
+ */
+
+struct elf_lazy_s {
+	char filename[BINARY_PATH_LEN];	/* Binary to read the sections from */
+	off_t filelen;				/* Length of the binary */
+	uint16_t offset;			/* Size of the binary header */
+	FAR struct binary_s *binp;	/* Loaded binary the sections belong to */
+	FAR Elf32_Shdr *shdr;		/* Section headers with the load addresses */
+	uint16_t nsects;			/* Number of entries in sect[] */
+	struct elf_lazysect_s sect[CONFIG_ELF_LAZY_MAX_SECTIONS];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Deferred sections of each loaded binary, indexed by binary index */
+
+static FAR struct elf_lazy_s *g_elf_lazy[CONFIG_NUM_APPS + 1];
+
+/* Held while a binary or a deferred section is being loaded */
+
+static sem_t g_elf_lazysem = SEM_INITIALIZER(1);
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: elf_lazy_find
+ *
+ * Description:
+ *   Return the deferred section entry for section 'shndx', or NULL.
+ ****************************************************************************/
+static FAR struct elf_lazysect_s *elf_lazy_find(FAR struct elf_lazy_s *lazy, int shndx)
+{
+	int i;
+
+	if (lazy == NULL) {
+		return NULL;
+	}
+
+	for (i = 0; i < lazy->nsects; i++) {
+		if (lazy->sect[i].shndx == shndx) {
+			return &lazy->sect[i];
+		}
+	}
+
+	return NULL;
+}
+
+/****************************************************************************
+ * Name: elf_lazy_drop
+ *
+ * Description:
+ *   Free the deferred sections of binary 'bin_idx'.  Must be called with
+ *   the lock held.
+ ****************************************************************************/
+static void elf_lazy_drop(int bin_idx)
+{
+	FAR struct elf_lazy_s *lazy = g_elf_lazy[bin_idx];
+
+	if (lazy != NULL) {
+		g_elf_lazy[bin_idx] = NULL;
+		kmm_free(lazy->shdr);
+		kmm_free(lazy);
+	}
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: elf_lazy_lock
+ ****************************************************************************/
+void elf_lazy_lock(void)
+{
+	while (sem_wait(&g_elf_lazysem) != OK) {
+		ASSERT(get_errno() == EINTR);
+	}
+}
+
+/****************************************************************************
+ * Name: elf_lazy_unlock
+ ****************************************************************************/
+void elf_lazy_unlock(void)
+{
+	sem_post(&g_elf_lazysem);
+}
+
+/****************************************************************************
+ * Name: elf_lazy_defer
+ *
+ * Description:
+ *   Called by the loader for each allocated section before it is read.  If
+ *   the section is read-only and its name starts with
+ *   CONFIG_ELF_LAZY_SECTION_PREFIX, its memory at 'dest' is only filled
+ *   with ELF_LAZY_FILL and the section is recorded for loading on demand.
+ *
+ * Returned Value:
+ *   1 if the section is deferred, 0 if it must be loaded now, a negated
+ *   errno value on failure.
+ ****************************************************************************/
+int elf_lazy_defer(FAR struct elf_loadinfo_s *loadinfo, int shndx, FAR uint8_t *dest)
+{
+	FAR Elf32_Shdr *shdr = &loadinfo->shdr[shndx];
+	int ret;
+
+	if ((shdr->sh_flags & SHF_WRITE) != 0 || shdr->sh_type != SHT_PROGBITS) {
+		return 0;
+	}
+
+	ret = elf_allocbuffer(loadinfo);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = elf_sectname(loadinfo, shdr);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (strncmp((FAR const char *)loadinfo->iobuffer, CONFIG_ELF_LAZY_SECTION_PREFIX, ELF_LAZY_PREFIX_LEN) != 0) {
+		return 0;
+	}
+
+	if (loadinfo->lazy == NULL) {
+		loadinfo->lazy = (FAR struct elf_lazy_s *)kmm_zalloc(sizeof(struct elf_lazy_s));
+		if (loadinfo->lazy == NULL) {
+			return -ENOMEM;
+		}
+	}
+
+	if (loadinfo->lazy->nsects >= CONFIG_ELF_LAZY_MAX_SECTIONS) {
+		bwarn("Too many deferred sections, loading %s now\n", loadinfo->iobuffer);
+		return 0;
+	}
+
+	loadinfo->lazy->sect[loadinfo->lazy->nsects].shndx = shndx;
+	loadinfo->lazy->nsects++;
+
+	memset(dest, ELF_LAZY_FILL, shdr->sh_size);
+
+	binfo("Deferred section %d %s, %u bytes\n", shndx, loadinfo->iobuffer, shdr->sh_size);
+	return 1;
+}
+
+/****************************************************************************
+ * Name: elf_lazy_deferrel
+ *
+ * Description:
+ *   Called by elf_bind() for each relocation section 'relidx' that applies
+ *   to section 'dstidx'.  Relocations of a deferred section are recorded
+ *   and applied when the section is loaded.
+ *
+ * Returned Value:
+ *   true if the relocations must be skipped now.
+ ****************************************************************************/
+bool elf_lazy_deferrel(FAR struct elf_loadinfo_s *loadinfo, int relidx, int dstidx)
+{
+	FAR struct elf_lazysect_s *sect;
+
+	sect = elf_lazy_find(loadinfo->lazy, dstidx);
+	if (sect == NULL) {
+		return false;
+	}
+
+	sect->relidx = relidx;
+	return true;
+}
+
+/****************************************************************************
+ * Name: elf_lazy_save
+ *
+ * Description:
+ *   Keep the information needed to load the deferred sections once the
+ *   binary is bound.  The section headers are taken over from 'loadinfo'.
+ *   Called from elf_loadbinary() with the lock held.
+ *
+ * Returned Value:
+ *   0 (OK) on success, a negated errno value on failure.
+ ****************************************************************************/
+int elf_lazy_save(FAR struct elf_loadinfo_s *loadinfo, FAR const char *filename)
+{
+	FAR struct elf_lazy_s *lazy = loadinfo->lazy;
+	int bin_idx = loadinfo->binp->binary_idx;
+
+	if (bin_idx < 0 || bin_idx > CONFIG_NUM_APPS) {
+		return -EINVAL;
+	}
+
+	/* Forget the sections of a previous load of the same binary */
+
+	elf_lazy_drop(bin_idx);
+
+	if (lazy == NULL) {
+		return OK;
+	}
+
+	strncpy(lazy->filename, filename, BINARY_PATH_LEN - 1);
+	lazy->filelen = loadinfo->filelen;
+	lazy->offset = loadinfo->offset;
+	lazy->binp = loadinfo->binp;
+	lazy->shdr = loadinfo->shdr;
+	loadinfo->shdr = NULL;
+	loadinfo->lazy = NULL;
+	g_elf_lazy[bin_idx] = lazy;
+
+	binfo("[%s] %d sections deferred\n", loadinfo->binp->bin_name, lazy->nsects);
+	return OK;
+}
+
+/****************************************************************************
+ * Name: elf_lazy_free
+ *
+ * Description:
+ *   Free deferred section state of a load that did not complete.
+ ****************************************************************************/
+void elf_lazy_free(FAR struct elf_loadinfo_s *loadinfo)
+{
+	if (loadinfo->lazy) {
+		kmm_free(loadinfo->lazy);
+		loadinfo->lazy = NULL;
+	}
+}
+
+/****************************************************************************
+ * Name: elf_lazy_load
+ *
+ * Description:
+ *   Read, decompress and relocate the deferred section of binary 'bin_idx'
+ *   that contains 'addr'.  Loading a section that is already loaded is not
+ *   an error.
+ *
+ *   This runs in the binary manager thread, which writes to the text of the
+ *   binary while the binary's own MPU regions are not active.
+ *
+ * Returned Value:
+ *   0 (OK) on success, a negated errno value on failure.
+ ****************************************************************************/
+int elf_lazy_load(int bin_idx, uintptr_t addr)
+{
+	struct elf_loadinfo_s loadinfo;
+	FAR struct elf_lazy_s *lazy;
+	FAR struct elf_lazysect_s *sect = NULL;
+	FAR Elf32_Shdr *shdr = NULL;
+	int ret;
+	int i;
+
+	if (bin_idx < 0 || bin_idx > CONFIG_NUM_APPS) {
+		return -EINVAL;
+	}
+
+	elf_lazy_lock();
+
+	lazy = g_elf_lazy[bin_idx];
+	if (lazy == NULL) {
+		ret = -ENOENT;
+		goto errout;
+	}
+
+	for (i = 0; i < lazy->nsects; i++) {
+		shdr = &lazy->shdr[lazy->sect[i].shndx];
+		if (addr >= shdr->sh_addr && addr < shdr->sh_addr + shdr->sh_size) {
+			sect = &lazy->sect[i];
+			break;
+		}
+	}
+
+	if (sect == NULL) {
+		ret = -ENOENT;
+		goto errout;
+	}
+
+	if (sect->loaded) {
+		ret = OK;
+		goto errout;
+	}
+
+	memset(&loadinfo, 0, sizeof(struct elf_loadinfo_s));
+	loadinfo.offset = lazy->offset;
+	loadinfo.filelen = lazy->filelen;
+	loadinfo.binp = lazy->binp;
+
+	ret = elf_init(lazy->filename, &loadinfo);
+	if (ret < 0) {
+		berr("Failed to open %s for demand loading: %d\n", lazy->filename, ret);
+		goto errout_with_init;
+	}
+
+	/* Use the section headers as they were at load time, with sh_addr
+	 * holding the load addresses.
+	 */
+
+	loadinfo.shdr = lazy->shdr;
+
+	ret = elf_read(&loadinfo, (FAR uint8_t *)shdr->sh_addr, shdr->sh_size, shdr->sh_offset);
+	if (ret < 0) {
+		berr("Failed to read section %d: %d\n", sect->shndx, ret);
+		goto errout_with_init;
+	}
+
+	if (sect->relidx != 0) {
+		ret = elf_bind_section(&loadinfo, sect->relidx);
+		if (ret < 0) {
+			berr("Failed to relocate section %d: %d\n", sect->shndx, ret);
+			goto errout_with_init;
+		}
+	}
+
+#if defined(CONFIG_ARCH_HAVE_COHERENT_DCACHE)
+	/* Clean the D-cache and invalidate the I-cache of every section loaded,
+	 * whether it was relocated or not.
+	 */
+
+	up_coherent_dcache(shdr->sh_addr, shdr->sh_size);
+#endif
+
+	sect->loaded = true;
+	binfo("[%s] section %d loaded at %08x\n", lazy->binp->bin_name, sect->shndx, shdr->sh_addr);
+
+errout_with_init:
+	loadinfo.shdr = NULL;
+	elf_uninit(&loadinfo);
+errout:
+	elf_lazy_unlock();
+	return ret;
+}
+
+/****************************************************************************
+ * Name: elf_lazy_release
+ *
+ * Description:
+ *   Forget the deferred sections of binary 'bin_idx' when it is unloaded.
+ ****************************************************************************/
+void elf_lazy_release(int bin_idx)
+{
+	if (bin_idx < 0 || bin_idx > CONFIG_NUM_APPS) {
+		return;
+	}
+
+	elf_lazy_lock();
+	elf_lazy_drop(bin_idx);
+	elf_lazy_unlock();
+}
+
+#endif							/* CONFIG_ELF_LAZY_LOAD */
@@ -230,13 +230,27 @@ static inline int elf_loadfile(FAR struct elf_loadinfo_s *loadinfo)
 		 */
 
 		if (shdr->sh_type != SHT_NOBITS) {
-			/* Read the section data from sh_offset to the memory region */
+#ifdef CONFIG_ELF_LAZY_LOAD
+			/* Sections loaded on demand are not read now */
 
-			ret = elf_read(loadinfo, *pptr, shdr->sh_size, shdr->sh_offset);
+			ret = elf_lazy_defer(loadinfo, i, *pptr);
 			if (ret < 0) {
-				berr("ERROR: Failed to read section %d: %d\n", i, ret);
+				berr("ERROR: Failed to defer section %d: %d\n", i, ret);
 				return ret;
 			}
+#else
+			ret = 0;
+#endif
+
+			/* Read the section data from sh_offset to the memory region */
+
+			if (ret == 0) {
+				ret = elf_read(loadinfo, *pptr, shdr->sh_size, shdr->sh_offset);
+				if (ret < 0) {
+					berr("ERROR: Failed to read section %d: %d\n", i, ret);
+					return ret;
+				}
+			}
 		}
 
 		/* Update sh_addr to point to copy in memory */
@@ -99,7 +99,7 @@ static bin_addr_info_t g_bin_addr_list[CONFIG_NUM_APPS + 1];
  *
  ****************************************************************************/
 
-static inline int elf_sectname(FAR struct elf_loadinfo_s *loadinfo, FAR const Elf32_Shdr *shdr)
+int elf_sectname(FAR struct elf_loadinfo_s *loadinfo, FAR const Elf32_Shdr *shdr)
 {
 	FAR Elf32_Shdr *shstr;
 	FAR uint8_t *buffer;
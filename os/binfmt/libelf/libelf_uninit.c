@@ -103,6 +103,12 @@ int elf_uninit(struct elf_loadinfo_s *loadinfo)
 
 	elf_freebuffers(loadinfo);
 
+#ifdef CONFIG_ELF_LAZY_LOAD
+	/* Free the deferred sections of a load that did not complete */
+
+	elf_lazy_free(loadinfo);
+#endif
+
 	/* Free buffers used for decompression */
 #ifdef CONFIG_COMPRESSED_BINARY
 	compress_uninit();
@@ -27,9 +27,13 @@
 #include <string.h>
 #include <debug.h>
 #include <errno.h>
+#include <semaphore.h>
 
 #include <tinyara/fs/fs.h>
 #include <tinyara/binfmt/compression/compress_read.h>
+#ifdef CONFIG_COMPRESSION_PREFETCH
+#include <tinyara/wqueue.h>
+#endif
 
 #if CONFIG_COMPRESSION_TYPE == LZMA
 #include <tinyara/lzma/LzmaLib.h>
@@ -37,6 +41,56 @@
 #include <miniz/miniz.h>
 #endif
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Prefetching needs a second cache entry to decompress into while the
+ * reader is still consuming the current block.
+ */
+
+#if defined(CONFIG_COMPRESSION_PREFETCH) && CONFIG_COMPRESSION_CACHE_BLOCKS > 1
+#define COMPRESS_PREFETCH 1
+#endif
+
+/* States of a decompressed block cache entry */
+
+#define COMPRESS_BLOCK_EMPTY    0	/* Entry holds no data */
+#define COMPRESS_BLOCK_VALID    1	/* Entry holds decompressed 'block_number' */
+#define COMPRESS_BLOCK_LOADING  2	/* 'block_number' is being decompressed into the entry */
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One decompressed block held in the cache */
+
+struct compress_block_s {
+	int block_number;			/* Index of the compressed block held here */
+	uint8_t state;				/* See COMPRESS_BLOCK_* definitions */
+	uint32_t stamp;				/* Time of last use, for LRU replacement */
+	unsigned char *out_buffer;	/* Decompressed data, 'blocksize' bytes */
+};
+
+/* LRU cache of decompressed blocks of the binary being loaded.  The entries
+ * are allocated by compress_init() and released by compress_uninit().
+ */
+
+struct compress_cache_s {
+	sem_t sem;					/* Protects the entries and the statistics */
+	bool enabled;				/* Set by compress_set_cache() */
+	uint32_t stamp;				/* LRU clock */
+	struct compress_block_s blocks[CONFIG_COMPRESSION_CACHE_BLOCKS];
+	struct compress_cache_stats_s stats;
+#ifdef COMPRESS_PREFETCH
+	sem_t busy;					/* Held by the worker while it decompresses */
+	struct work_s work;			/* Prefetch work on the low priority queue */
+	struct file file;			/* Private open file used by the worker */
+	uint16_t binary_header_size;	/* Binary header size of the open file */
+	unsigned char *read_buffer;	/* Compressed data read by the worker */
+#endif
+};
+
 /****************************************************************************
  * Private Declarations
  ****************************************************************************/
@@ -44,6 +98,14 @@
 static struct s_header *compression_header;
 static struct s_buffer buffers;
 
+static struct compress_cache_s g_cache = {
+	.sem = SEM_INITIALIZER(1),
+	.enabled = true,
+#ifdef COMPRESS_PREFETCH
+	.busy = SEM_INITIALIZER(1),
+#endif
+};
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -278,6 +340,407 @@ static off_t compress_read_block(int filfd, uint16_t binary_header_size, FAR uin
 	return nbytes;
 }
 
+/****************************************************************************
+ * Name: compress_cache_semtake
+ ****************************************************************************/
+static void compress_cache_semtake(FAR sem_t *sem)
+{
+	while (sem_wait(sem) != OK) {
+		/* The only case that an error should occur here is if the wait was
+		 * awakened by a signal.
+		 */
+
+		ASSERT(get_errno() == EINTR);
+	}
+}
+
+/****************************************************************************
+ * Name: compress_readbuf_size
+ *
+ * Description:
+ *   Size of the buffer needed to hold one compressed block
+ ****************************************************************************/
+static size_t compress_readbuf_size(void)
+{
+#if CONFIG_COMPRESSION_TYPE == LZMA
+	return compression_header->blocksize + LZMA_PROPS_SIZE;
+#elif CONFIG_COMPRESSION_TYPE == MINIZ
+	return compressBound(compression_header->blocksize);
+#else
+	return compression_header->blocksize;
+#endif
+}
+
+/****************************************************************************
+ * Name: compress_decompress
+ *
+ * Description:
+ *   Decompress 'block_readsize' bytes of block 'index' in 'read_buffer' into
+ *   'out_buffer'
+ *
+ * Returned Value:
+ *   Non-negative value on Success.
+ *   Negative value on Failure.
+ ****************************************************************************/
+static int compress_decompress(unsigned char *out_buffer, unsigned char *read_buffer, off_t block_readsize, int index)
+{
+#if CONFIG_COMPRESSION_TYPE == LZMA
+	unsigned int writesize;
+	unsigned int size = (unsigned int)block_readsize;
+#elif CONFIG_COMPRESSION_TYPE == MINIZ
+	long unsigned int writesize;
+	long unsigned int size = (long unsigned int)block_readsize;
+#endif
+
+	return compress_decompress_block(out_buffer, &writesize, read_buffer, &size, index);
+}
+
+/****************************************************************************
+ * Name: compress_cache_find
+ *
+ * Description:
+ *   Look up 'block_number' in the cache.  Must be called with the cache
+ *   semaphore held.
+ *
+ * Returned Value:
+ *   The entry holding or loading the block, NULL if it is not cached.
+ ****************************************************************************/
+static FAR struct compress_block_s *compress_cache_find(int block_number)
+{
+	int i;
+
+	if (!g_cache.enabled) {
+		return NULL;
+	}
+
+	for (i = 0; i < CONFIG_COMPRESSION_CACHE_BLOCKS; i++) {
+		if (g_cache.blocks[i].state != COMPRESS_BLOCK_EMPTY && g_cache.blocks[i].block_number == block_number) {
+			return &g_cache.blocks[i];
+		}
+	}
+
+	return NULL;
+}
+
+/****************************************************************************
+ * Name: compress_cache_victim
+ *
+ * Description:
+ *   Pick the entry to be reused for a new block: an empty entry if there is
+ *   one, otherwise the least recently used valid entry.  Entries being
+ *   loaded are never picked.  Must be called with the cache semaphore held.
+ ****************************************************************************/
+static FAR struct compress_block_s *compress_cache_victim(void)
+{
+	FAR struct compress_block_s *victim = NULL;
+	FAR struct compress_block_s *block;
+	int i;
+
+	for (i = 0; i < CONFIG_COMPRESSION_CACHE_BLOCKS; i++) {
+		block = &g_cache.blocks[i];
+		if (block->state == COMPRESS_BLOCK_EMPTY) {
+			return block;
+		}
+
+		if (block->state == COMPRESS_BLOCK_VALID && (victim == NULL || (int32_t)(block->stamp - victim->stamp) < 0)) {
+			victim = block;
+		}
+	}
+
+	DEBUGASSERT(victim != NULL);
+	return victim;
+}
+
+/****************************************************************************
+ * Name: compress_cache_invalidate
+ *
+ * Description:
+ *   Drop all cached blocks.  Must be called with the cache semaphore held.
+ ****************************************************************************/
+static void compress_cache_invalidate(void)
+{
+	int i;
+
+	for (i = 0; i < CONFIG_COMPRESSION_CACHE_BLOCKS; i++) {
+		if (g_cache.blocks[i].state == COMPRESS_BLOCK_VALID) {
+			g_cache.blocks[i].state = COMPRESS_BLOCK_EMPTY;
+		}
+	}
+}
+
+#ifdef COMPRESS_PREFETCH
+/****************************************************************************
+ * Name: compress_prefetch_worker
+ *
+ * Description:
+ *   Runs on the low priority work queue.  Reads and decompresses the block
+ *   passed in 'arg' into the cache through the worker's private open file,
+ *   so that the loader finds it there when it reaches it.
+ ****************************************************************************/
+static void compress_prefetch_worker(FAR void *arg)
+{
+	FAR struct compress_block_s *block;
+	int block_number = (int)(intptr_t)arg;
+	off_t block_offset;
+	off_t readsize;
+	ssize_t nbytes;
+	int ret;
+
+	/* The loader waits on 'busy' when it needs the block being prefetched,
+	 * which also lends this thread its priority.
+	 */
+
+	compress_cache_semtake(&g_cache.busy);
+	compress_cache_semtake(&g_cache.sem);
+
+	/* compress_uninit() may have run since the work was queued */
+
+	if (compression_header == NULL || g_cache.file.f_inode == NULL || compress_cache_find(block_number) != NULL) {
+		sem_post(&g_cache.sem);
+		sem_post(&g_cache.busy);
+		return;
+	}
+
+	block = compress_cache_victim();
+	block->block_number = block_number;
+	block->state = COMPRESS_BLOCK_LOADING;
+	sem_post(&g_cache.sem);
+
+	block_offset = compress_offset_block(-1, g_cache.binary_header_size, block_number);
+	readsize = compress_offset_block(-1, g_cache.binary_header_size, block_number + 1) - block_offset;
+
+	nbytes = file_pread(&g_cache.file, g_cache.read_buffer, readsize, block_offset);
+	if (nbytes != readsize) {
+		bcmpdbg("Prefetch read for compressed block %d failed\n", block_number);
+		ret = ERROR;
+	} else {
+		ret = compress_decompress(block->out_buffer, g_cache.read_buffer, readsize, block_number);
+	}
+
+	compress_cache_semtake(&g_cache.sem);
+	if (ret < 0) {
+		block->state = COMPRESS_BLOCK_EMPTY;
+	} else {
+		block->state = COMPRESS_BLOCK_VALID;
+		block->stamp = ++g_cache.stamp;
+		g_cache.stats.prefetched++;
+	}
+	sem_post(&g_cache.sem);
+	sem_post(&g_cache.busy);
+}
+
+/****************************************************************************
+ * Name: compress_prefetch
+ *
+ * Description:
+ *   Queue decompression of 'block_number' if there is such a block and the
+ *   worker is idle.
+ ****************************************************************************/
+static void compress_prefetch(int block_number)
+{
+	if (!g_cache.enabled || g_cache.file.f_inode == NULL || block_number >= compression_header->sections) {
+		return;
+	}
+
+	if (work_available(&g_cache.work)) {
+		work_queue(LPWORK, &g_cache.work, compress_prefetch_worker, (FAR void *)(intptr_t)block_number, 0);
+	}
+}
+#endif
+
+/****************************************************************************
+ * Name: compress_cache_get
+ *
+ * Description:
+ *   Return the cache entry holding decompressed 'block_number', reading and
+ *   decompressing it first if it is not cached.  On success the cache
+ *   semaphore is left held so that the entry cannot be reused while the
+ *   caller copies data out of it.
+ *
+ * Returned Value:
+ *   OK (0) on Success
+ *   Negative value on Failure
+ ****************************************************************************/
+static int compress_cache_get(int filfd, uint16_t binary_header_size, int block_number, FAR struct compress_block_s **blockp)
+{
+	FAR struct compress_block_s *block;
+	off_t block_readsize;
+	int ret;
+
+	for (;;) {
+		compress_cache_semtake(&g_cache.sem);
+		block = compress_cache_find(block_number);
+		if (block == NULL) {
+			break;
+		}
+
+		if (block->state == COMPRESS_BLOCK_VALID) {
+			block->stamp = ++g_cache.stamp;
+			g_cache.stats.hits++;
+			*blockp = block;
+			return OK;
+		}
+
+		/* The prefetch worker is decompressing this block, wait for it */
+
+		sem_post(&g_cache.sem);
+#ifdef COMPRESS_PREFETCH
+		compress_cache_semtake(&g_cache.busy);
+		sem_post(&g_cache.busy);
+#else
+		DEBUGPANIC();
+#endif
+	}
+
+	/* Not cached: claim an entry and decompress the block into it */
+
+	block = compress_cache_victim();
+	block->block_number = block_number;
+	block->state = COMPRESS_BLOCK_LOADING;
+	g_cache.stats.misses++;
+	sem_post(&g_cache.sem);
+
+	block_readsize = compress_read_block(filfd, binary_header_size, buffers.read_buffer, block_number);
+	if (block_readsize < 0) {
+		bcmpdbg("Read for compressed block %d failed\n", block_number);
+		ret = block_readsize;
+	} else {
+		ret = compress_decompress(block->out_buffer, buffers.read_buffer, block_readsize, block_number);
+		if (ret < 0) {
+			bcmpdbg("Failed to decompress %d block of this binary\n", block_number);
+		}
+	}
+
+	compress_cache_semtake(&g_cache.sem);
+	if (ret < 0) {
+		block->state = COMPRESS_BLOCK_EMPTY;
+		sem_post(&g_cache.sem);
+		return ret;
+	}
+
+	block->state = COMPRESS_BLOCK_VALID;
+	block->stamp = ++g_cache.stamp;
+	*blockp = block;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: compress_free_buffers
+ *
+ * Description:
+ *   Release the read buffers and the cache entries
+ ****************************************************************************/
+static void compress_free_buffers(void)
+{
+	int i;
+
+	if (buffers.read_buffer) {
+		kmm_free(buffers.read_buffer);
+		buffers.read_buffer = NULL;
+	}
+
+	for (i = 0; i < CONFIG_COMPRESSION_CACHE_BLOCKS; i++) {
+		if (g_cache.blocks[i].out_buffer) {
+			kmm_free(g_cache.blocks[i].out_buffer);
+			g_cache.blocks[i].out_buffer = NULL;
+		}
+		g_cache.blocks[i].state = COMPRESS_BLOCK_EMPTY;
+	}
+
+#ifdef COMPRESS_PREFETCH
+	if (g_cache.read_buffer) {
+		kmm_free(g_cache.read_buffer);
+		g_cache.read_buffer = NULL;
+	}
+#endif
+}
+
+/****************************************************************************
+ * Name: compress_alloc_buffers
+ *
+ * Description:
+ *   Allocate the read buffer and the decompressed block cache entries
+ *
+ * Returned value:
+ *   OK (0) on Success
+ *   -ENOMEM on Failure
+ ****************************************************************************/
+static int compress_alloc_buffers(void)
+{
+	int i;
+
+	buffers.read_buffer = (unsigned char *)kmm_malloc(compress_readbuf_size());
+	if (buffers.read_buffer == NULL) {
+		return -ENOMEM;
+	}
+
+	for (i = 0; i < CONFIG_COMPRESSION_CACHE_BLOCKS; i++) {
+		g_cache.blocks[i].state = COMPRESS_BLOCK_EMPTY;
+		g_cache.blocks[i].out_buffer = (unsigned char *)kmm_malloc(compression_header->blocksize);
+		if (g_cache.blocks[i].out_buffer == NULL) {
+			compress_free_buffers();
+			return -ENOMEM;
+		}
+	}
+
+	return OK;
+}
+
+#ifdef COMPRESS_PREFETCH
+/****************************************************************************
+ * Name: compress_prefetch_init
+ *
+ * Description:
+ *   Give the prefetch worker its own open file and read buffer.  The worker
+ *   runs in a different task group, so it cannot use 'filfd'.  Prefetching
+ *   is simply left off if either cannot be set up.
+ ****************************************************************************/
+static void compress_prefetch_init(int filfd, uint16_t binary_header_size)
+{
+	FAR struct file *filep;
+
+	g_cache.binary_header_size = binary_header_size;
+
+	if (fs_getfilep(filfd, &filep) < 0) {
+		return;
+	}
+
+	g_cache.read_buffer = (unsigned char *)kmm_malloc(compress_readbuf_size());
+	if (g_cache.read_buffer == NULL) {
+		return;
+	}
+
+	if (file_dup2(filep, &g_cache.file) < 0) {
+		bcmpdbg("Failed to open file for prefetching, prefetch disabled\n");
+		kmm_free(g_cache.read_buffer);
+		g_cache.read_buffer = NULL;
+	}
+}
+
+/****************************************************************************
+ * Name: compress_prefetch_uninit
+ *
+ * Description:
+ *   Stop the prefetch worker and close its open file
+ ****************************************************************************/
+static void compress_prefetch_uninit(void)
+{
+	work_cancel(LPWORK, &g_cache.work);
+
+	/* Wait for a worker that is already running to finish */
+
+	compress_cache_semtake(&g_cache.busy);
+	if (g_cache.file.f_inode != NULL) {
+		file_close(&g_cache.file);
+	}
+	sem_post(&g_cache.busy);
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
 /****************************************************************************
  * Name: compress_read
  *
@@ -302,14 +765,7 @@ int compress_read(int filfd, uint16_t binary_header_size, FAR uint8_t *buffer, s
 	int block_size_to_write;	/* Size to write into buffer from decompressed block */
 	int buffer_index;
 	int blocksize;
-	int block_readsize;
-#if CONFIG_COMPRESSION_TYPE == LZMA
-	unsigned int writesize;
-	unsigned int size;
-#elif CONFIG_COMPRESSION_TYPE == MINIZ
-	long unsigned int writesize;
-	long unsigned int size;
-#endif
+	FAR struct compress_block_s *block;
 
 	/* Setting first block, end block and number of blocks to read and decompressed */
 	blocksize = compression_header->blocksize;
@@ -325,25 +781,10 @@ int compress_read(int filfd, uint16_t binary_header_size, FAR uint8_t *buffer, s
 	/* Actual Offset in uncompressed file is same as Offset passed to this function */
 	actual_offset = offset;
 
-	/* Reading and decompressing blocks from first_block to last_block. Then writing to buffer. */
+	/* Getting blocks from first_block to last_block from the cache, decompressing on a miss. Then writing to buffer. */
 	for (; index < first_block + no_blocks; index++) {
-		/* Read compressed 'index' block into read_buffer */
-		block_readsize = compress_read_block(filfd, binary_header_size, buffers.read_buffer, index);
-		if (block_readsize < 0) {
-			bcmpdbg("Read for compressed block %d failed\n", index);
-			buffer_index = block_readsize;
-			goto error_compress_read;
-		}
-
-#if CONFIG_COMPRESSION_TYPE == LZMA
-		size = (unsigned int)block_readsize;
-#elif CONFIG_COMPRESSION_TYPE == MINIZ
-		size = (long unsigned int)block_readsize;
-#endif
-		/* Decompress block in read_buffer to out_buffer */
-		ret = compress_decompress_block(buffers.out_buffer, &writesize, buffers.read_buffer, &size, index);
-		if (ret == ERROR) {
-			bcmpdbg("Failed to decompress %d block of this binary\n", index);
+		ret = compress_cache_get(filfd, binary_header_size, index, &block);
+		if (ret < 0) {
 			buffer_index = ret;
 			goto error_compress_read;
 		}
@@ -355,7 +796,7 @@ int compress_read(int filfd, uint16_t binary_header_size, FAR uint8_t *buffer, s
 			 * Otherwise, write from start_offset to end_offset into buffer.
 			 */
 			block_size_to_write = ((index + 1) * blocksize - 1 > actual_offset + readsize - 1 ? readsize : (index + 1) * blocksize - actual_offset);
-			memcpy(&buffer[buffer_index], &buffers.out_buffer[actual_offset - (index * blocksize)], block_size_to_write);
+			memcpy(&buffer[buffer_index], &block->out_buffer[actual_offset - (index * blocksize)], block_size_to_write);
 			buffer_index += block_size_to_write;
 		} else if (index == last_block) {
 			/*
@@ -364,7 +805,7 @@ int compress_read(int filfd, uint16_t binary_header_size, FAR uint8_t *buffer, s
 			 * Write from start_offset to end_offset from this block into buffer.
 			 */
 			block_size_to_write = actual_offset + readsize - (index * blocksize);
-			memcpy(&buffer[buffer_index], &buffers.out_buffer[0], block_size_to_write);
+			memcpy(&buffer[buffer_index], &block->out_buffer[0], block_size_to_write);
 			buffer_index += block_size_to_write;
 		} else {
 			/*
@@ -372,11 +813,18 @@ int compress_read(int filfd, uint16_t binary_header_size, FAR uint8_t *buffer, s
 			 * So, write entire block into buffer.
 			 */
 			block_size_to_write = blocksize;
-			memcpy(&buffer[buffer_index], &buffers.out_buffer[0], block_size_to_write);
+			memcpy(&buffer[buffer_index], &block->out_buffer[0], block_size_to_write);
 			buffer_index += block_size_to_write;
 		}
+
+		sem_post(&g_cache.sem);
 	}
 
+#ifdef COMPRESS_PREFETCH
+	/* The loader mostly reads forward, so start on the next block while the caller consumes this data */
+	compress_prefetch(last_block + 1);
+#endif
+
 error_compress_read:
 	return buffer_index;
 }
@@ -405,31 +853,19 @@ int compress_init(int filfd, uint16_t offset, off_t *filelen)
 	/* Assign file length as that of uncompressed file */
 	*filelen = compression_header->binary_size;
 
-#if CONFIG_COMPRESSION_TYPE == LZMA
-	/* Allocating memory for read and out buffer to be used for LZMA decompression */
-	if (compression_header->compression_format == COMPRESSION_TYPE_LZMA) {
-		buffers.read_buffer = (unsigned char *)kmm_malloc(compression_header->blocksize + LZMA_PROPS_SIZE);
-		if (buffers.read_buffer == NULL) {
-			return -ENOMEM;
-		}
-		buffers.out_buffer = (unsigned char *)kmm_malloc(compression_header->blocksize);
-		if (buffers.out_buffer == NULL) {
-			kmm_free(buffers.read_buffer);
-			return -ENOMEM;
-		}
-	}
-#elif CONFIG_COMPRESSION_TYPE == MINIZ
-	/* Allocating memory for read and out buffer to be used for Miniz decompression */
-	if (compression_header->compression_format == COMPRESSION_TYPE_MINIZ) {
-		buffers.read_buffer = (unsigned char *)kmm_malloc(compressBound(compression_header->blocksize));
-		if (buffers.read_buffer == NULL) {
-			return -ENOMEM;
-		}
-		buffers.out_buffer = (unsigned char *)kmm_malloc(compression_header->blocksize);
-		if (buffers.out_buffer == NULL) {
-			kmm_free(buffers.read_buffer);
-			return -ENOMEM;
+#if CONFIG_COMPRESSION_TYPE == LZMA || CONFIG_COMPRESSION_TYPE == MINIZ
+	/* Allocating memory for read buffer and decompressed block cache, LZMA and MINIZ match the format ids */
+	if (compression_header->compression_format == CONFIG_COMPRESSION_TYPE) {
+		memset(&g_cache.stats, 0, sizeof(struct compress_cache_stats_s));
+
+		ret = compress_alloc_buffers();
+		if (ret != OK) {
+			goto error_compress_init;
 		}
+
+#ifdef COMPRESS_PREFETCH
+		compress_prefetch_init(filfd, offset);
+#endif
 	}
 #endif
 
@@ -448,25 +884,49 @@ error_compress_init:
  ****************************************************************************/
 void compress_uninit(void)
 {
-#if CONFIG_COMPRESSION_TYPE == LZMA || CONFIG_COMPRESSION_TYPE == MINIZ
-	/* Freeing memory allocated to read_buffer and out_buffer for file decompression */
-	if (compression_header->compression_format == COMPRESSION_TYPE_LZMA || compression_header->compression_format == COMPRESSION_TYPE_MINIZ) {
-		if (buffers.read_buffer) {
-			kmm_free(buffers.read_buffer);
-			buffers.read_buffer = NULL;
-		}
-		if (buffers.out_buffer) {
-			kmm_free(buffers.out_buffer);
-			buffers.out_buffer = NULL;
-		}
-	}
+#ifdef COMPRESS_PREFETCH
+	compress_prefetch_uninit();
 #endif
 
+	/* Freeing memory allocated to read buffer and decompressed blocks */
+	compress_cache_semtake(&g_cache.sem);
+	compress_free_buffers();
+
 	kmm_free(compression_header);
 	compression_header = NULL;
+	sem_post(&g_cache.sem);
 }
 
 struct s_header *get_compression_header(void)
 {
 	return compression_header;
 }
+
+/****************************************************************************
+ * Name: compress_set_cache
+ *
+ * Description:
+ *   Enable or disable the decompressed block cache and prefetching
+ ****************************************************************************/
+void compress_set_cache(bool enable)
+{
+	compress_cache_semtake(&g_cache.sem);
+	g_cache.enabled = enable;
+	if (!enable) {
+		compress_cache_invalidate();
+	}
+	sem_post(&g_cache.sem);
+}
+
+/****************************************************************************
+ * Name: compress_get_cachestats
+ *
+ * Description:
+ *   Return the cache statistics of the binary being loaded
+ ****************************************************************************/
+void compress_get_cachestats(FAR struct compress_cache_stats_s *stats)
+{
+	compress_cache_semtake(&g_cache.sem);
+	memcpy(stats, &g_cache.stats, sizeof(struct compress_cache_stats_s));
+	sem_post(&g_cache.sem);
+}
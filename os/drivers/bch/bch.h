@@ -62,6 +62,9 @@
 #include <stdbool.h>
 #include <semaphore.h>
 #include <tinyara/fs/fs.h>
+#ifdef CONFIG_FS_BCACHE
+#include <tinyara/fs/bcache.h>
+#endif
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -69,6 +72,20 @@
 #define bchlib_semgive(d)	sem_post(&(d)->sem)	/* To match bchlib_semtake */
 #define MAX_OPENCNT			(255)				/* Limit of uint8_t */
 
+/* Access to the underlying block driver, optionally through the shared
+ * block buffer cache.  Without CONFIG_BCH_BCACHE, writes still have to drop
+ * the copies that other users of the driver keep in that cache.
+ */
+#ifdef CONFIG_BCH_BCACHE
+#define bchlib_hwread(b, buf, s, n)  bcache_read((b)->inode, buf, s, n, (b)->sectsize)
+#define bchlib_hwwrite(b, buf, s, n) bcache_write((b)->inode, buf, s, n, (b)->sectsize)
+#else
+#define bchlib_hwread(b, buf, s, n)  (b)->inode->u.i_bops->read((b)->inode, buf, s, n)
+#ifndef CONFIG_FS_BCACHE
+#define bchlib_hwwrite(b, buf, s, n) (b)->inode->u.i_bops->write((b)->inode, buf, s, n)
+#endif
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -108,6 +125,9 @@ EXTERN const struct file_operations bch_fops;
 EXTERN void bchlib_semtake(FAR struct bchlib_s *bch);
 EXTERN int  bchlib_flushsector(FAR struct bchlib_s *bch);
 EXTERN int  bchlib_readsector(FAR struct bchlib_s *bch, size_t sector);
+#if defined(CONFIG_FS_BCACHE) && !defined(CONFIG_BCH_BCACHE)
+EXTERN ssize_t bchlib_hwwrite(FAR struct bchlib_s *bch, FAR const uint8_t *buffer, size_t sector, unsigned int nsectors);
+#endif
 
 #undef EXTERN
 #if defined(__cplusplus)
@@ -158,6 +158,9 @@ static int bch_close(FAR struct file *filep)
 	/* Flush any dirty pages remaining in the cache */
 	bchlib_semtake(bch);
 	(void)bchlib_flushsector(bch);
+#ifdef CONFIG_BCH_BCACHE
+	(void)bcache_sync(bch->inode);
+#endif
 
 	/*
 	 * Decrement the reference count (I don't use bchlib_decref() because I
@@ -331,6 +334,18 @@ static int bch_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 
 		bchlib_semgive(bch);
 	}
+#ifdef CONFIG_BCH_BCACHE
+	/* Is this a request to write back the cached sectors? */
+	else if (cmd == BIOC_FLUSH) {
+		bchlib_semtake(bch);
+		ret = bchlib_flushsector(bch);
+		if (ret >= 0) {
+			ret = bcache_sync(bch->inode);
+		}
+
+		bchlib_semgive(bch);
+	}
+#endif
 #ifdef CONFIG_BCH_ENCRYPTION
 	/* Is this a request to set the encryption key? */
 	else if (cmd == DIOC_SETKEY) {
@@ -117,6 +117,26 @@ static int bch_cypher(FAR struct bchlib_s *bch, int encrypt)
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
+/****************************************************************************
+ * Name: bchlib_hwwrite
+ *
+ * Description:
+ *   Write sectors directly to the block driver.  Another user of the driver,
+ *   e.g. ROMFS, may hold copies of them in the shared buffer cache; drop
+ *   those so that they are read again from the media.
+ *
+ ****************************************************************************/
+#if defined(CONFIG_FS_BCACHE) && !defined(CONFIG_BCH_BCACHE)
+ssize_t bchlib_hwwrite(FAR struct bchlib_s *bch, FAR const uint8_t *buffer, size_t sector, unsigned int nsectors)
+{
+	ssize_t ret;
+
+	ret = bch->inode->u.i_bops->write(bch->inode, buffer, sector, nsectors);
+	bcache_discard(bch->inode, sector, ret > 0 ? (unsigned int)ret : nsectors);
+	return ret;
+}
+#endif
+
 /****************************************************************************
  * Name: bchlib_flushsector
  *
@@ -129,7 +149,6 @@ static int bch_cypher(FAR struct bchlib_s *bch, int encrypt)
  ****************************************************************************/
 int bchlib_flushsector(FAR struct bchlib_s *bch)
 {
-	FAR struct inode *inode;
 	ssize_t ret = OK;
 
 	/*
@@ -137,15 +156,13 @@ int bchlib_flushsector(FAR struct bchlib_s *bch)
 	 * media.
 	 */
 	if (bch->dirty) {
-		inode = bch->inode;
-
 #if defined(CONFIG_BCH_ENCRYPTION)
 		/* Encrypt data as necessary */
 		bch_cypher(bch, CYPHER_ENCRYPT);
 #endif
 
 		/* Write the sector to the media */
-		ret = inode->u.i_bops->write(inode, bch->buffer, bch->sector, 1);
+		ret = bchlib_hwwrite(bch, bch->buffer, bch->sector, 1);
 		if (ret < 0) {
 			fdbg("Write failed: %d\n");
 		}
@@ -177,16 +194,13 @@ int bchlib_flushsector(FAR struct bchlib_s *bch)
  ****************************************************************************/
 int bchlib_readsector(FAR struct bchlib_s *bch, size_t sector)
 {
-	FAR struct inode *inode;
 	ssize_t ret = OK;
 
 	if (bch->sector != sector) {
-		inode = bch->inode;
-
 		(void)bchlib_flushsector(bch);
 		bch->sector = (size_t)-1;
 
-		ret = inode->u.i_bops->read(inode, bch->buffer, sector, 1);
+		ret = bchlib_hwread(bch, bch->buffer, sector, 1);
 		if (ret < 0) {
 			fdbg("Read failed: %d\n");
 		}
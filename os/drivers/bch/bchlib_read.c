@@ -159,8 +159,7 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, size_t offset, size_t le
 			nsectors = bch->nsectors - sector;
 		}
 
-		ret = bch->inode->u.i_bops->read(bch->inode, (FAR uint8_t *)buffer,
-						sector, nsectors);
+		ret = bchlib_hwread(bch, (FAR uint8_t *)buffer, sector, nsectors);
 		if (ret < 0) {
 			fdbg("ERROR: Read failed: %d\n");
 			return ret;
@@ -90,6 +90,11 @@ int bchlib_teardown(FAR void *handle)
 	/* Flush any pending data to the block driver */
 	bchlib_flushsector(bch);
 
+#ifdef CONFIG_BCH_BCACHE
+	/* Write back and drop our sectors from the shared buffer cache */
+	(void)bcache_invalidate(bch->inode);
+#endif
+
 	/* Close the block driver */
 	(void)close_blockdriver(bch->inode);
 
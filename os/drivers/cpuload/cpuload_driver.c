@@ -100,6 +100,22 @@ static int cpuload_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 			ret = OK;
 		}
 		break;
+#ifdef CONFIG_SCHED_PROFILER
+	case CPULOADIOC_PROFSTART:
+		ret = sched_start_profile((FAR const struct cpuload_profile_s *)arg);
+		break;
+	case CPULOADIOC_PROFSTOP:
+		sched_stop_profile();
+		ret = OK;
+		break;
+	case CPULOADIOC_PROFREAD:
+		ret = sched_read_profile((FAR struct cpuload_profread_s *)arg);
+		break;
+	case CPULOADIOC_PROFRELEASE:
+		sched_clear_profile();
+		ret = OK;
+		break;
+#endif
 	default:
 		break;
 	}
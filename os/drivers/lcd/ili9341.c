@@ -502,6 +502,9 @@ static int ili9341_getpower(struct lcd_dev_s *dev);
 static int ili9341_setpower(struct lcd_dev_s *dev, int power);
 static int ili9341_getcontrast(struct lcd_dev_s *dev);
 static int ili9341_setcontrast(struct lcd_dev_s *dev, unsigned int contrast);
+#ifdef CONFIG_LCD_TEARING_EFFECT
+static int ili9341_waitvsync(struct lcd_dev_s *dev);
+#endif
 
 /****************************************************************************
  * Private Data
@@ -887,6 +890,16 @@ static int ili9341_hwinitialize(FAR struct ili9341_dev_s *dev)
 	lcd->sendcmd(lcd, ILI9341_SLEEP_OUT);
 	up_mdelay(120);
 
+#ifdef CONFIG_LCD_TEARING_EFFECT
+	/* Tearing effect line on, V-blanking information only */
+
+	if (lcd->waitte) {
+		lcdvdbg("ili9341 LCD driver: Tearing effect line on\n");
+		lcd->sendcmd(lcd, ILI9341_TEARING_EFFECT_LINE_ON);
+		lcd->sendparam(lcd, 0x00);
+	}
+#endif
+
 	/* Deselect the device */
 
 	lcd->deselect(lcd);
@@ -1198,6 +1211,37 @@ static int ili9341_setcontrast(struct lcd_dev_s *dev, unsigned int contrast)
 	return -ENOSYS;
 }
 
+#ifdef CONFIG_LCD_TEARING_EFFECT
+/****************************************************************************
+ * Name:  ili9341_waitvsync
+ *
+ * Description:
+ *   Wait for the start of the next vertical blanking period, signaled by the
+ *   tearing effect line.
+ *
+ * Input Parameters:
+ *   dev   - A reference to the lcd driver structure
+ *
+ * Returned Value:
+ *
+ *  On success - OK
+ *  On error   - -ENOSYS, the tearing effect line is not connected.
+ *
+ ****************************************************************************/
+
+static int ili9341_waitvsync(struct lcd_dev_s *dev)
+{
+	FAR struct ili9341_dev_s *priv = (FAR struct ili9341_dev_s *)dev;
+	FAR struct ili9341_lcd_s *lcd = priv->lcd;
+
+	if (!lcd->waitte) {
+		return -ENOSYS;
+	}
+
+	return lcd->waitte(lcd);
+}
+#endif
+
 
 /****************************************************************************
  * Name:  ili9341_initialize
@@ -1242,6 +1286,9 @@ ili9341_initialize(FAR struct ili9341_lcd_s *lcd, int devno)
 			dev->setpower     = ili9341_setpower;
 			dev->getcontrast  = ili9341_getcontrast;
 			dev->setcontrast  = ili9341_setcontrast;
+#ifdef CONFIG_LCD_TEARING_EFFECT
+			dev->waitvsync    = ili9341_waitvsync;
+#endif
 			priv->lcd         = lcd;
 
 			/* Initialze the LCD driver */
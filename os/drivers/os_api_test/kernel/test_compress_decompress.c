@@ -27,6 +27,9 @@
 #include <debug.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <elf32.h>
 
 #include <tinyara/os_api_test_drv.h>
 #include <tinyara/binfmt/compression/compress_read.h>
@@ -96,6 +99,181 @@ static int test_compress_decompress_function(unsigned long arg)
 	return OK;
 }
 
+/****************************************************************************
+ * Name: compress_loadperf_read
+ *
+ * Description:
+ *   Read 'size' bytes at 'offset' of the uncompressed binary, in pieces of
+ *   at most one compression block like the loader's I/O buffer.
+ ****************************************************************************/
+
+static int compress_loadperf_read(int fd, uint16_t binhdr_size, FAR uint8_t *buffer, size_t bufsize, size_t size, off_t offset)
+{
+	size_t readsize;
+	int ret;
+
+	while (size > 0) {
+		readsize = size > bufsize ? bufsize : size;
+		ret = compress_read(fd, binhdr_size, buffer, readsize, offset);
+		if (ret != (int)readsize) {
+			berr("Read of %u bytes at offset %lu failed : %d\n", (unsigned int)readsize, (unsigned long)offset, ret);
+			return ret < 0 ? ret : -EIO;
+		}
+		size -= readsize;
+		offset += readsize;
+	}
+
+	return OK;
+}
+
+/****************************************************************************
+ * Name: compress_loadperf_load
+ *
+ * Description:
+ *   Replay the reads that the ELF loader issues for a compressed binary:
+ *   the ELF header, the section headers, every allocated section in order,
+ *   and then every relocation table followed by the symbol that each
+ *   relocation refers to.  The symbol lookups are what seek backwards
+ *   into blocks that were already decompressed.
+ ****************************************************************************/
+
+static int compress_loadperf_load(int fd, uint16_t binhdr_size)
+{
+	Elf32_Ehdr ehdr;
+	Elf32_Shdr *shdr = NULL;
+	Elf32_Shdr *symtab;
+	Elf32_Rel *rel;
+	Elf32_Sym sym;
+	uint8_t *buffer = NULL;
+	size_t bufsize;
+	off_t filelen;
+	size_t nrel;
+	size_t i;
+	size_t j;
+	int ret;
+
+	ret = compress_init(fd, binhdr_size, &filelen);
+	if (ret != OK) {
+		berr("Failed to read header for compressed binary : %d\n", ret);
+		return ret;
+	}
+
+	bufsize = get_compression_header()->blocksize;
+	buffer = (uint8_t *)kmm_malloc(bufsize);
+	if (buffer == NULL) {
+		ret = -ENOMEM;
+		goto errout;
+	}
+
+	ret = compress_loadperf_read(fd, binhdr_size, (FAR uint8_t *)&ehdr, sizeof(Elf32_Ehdr), sizeof(Elf32_Ehdr), 0);
+	if (ret != OK) {
+		goto errout;
+	}
+
+	shdr = (Elf32_Shdr *)kmm_malloc(ehdr.e_shnum * sizeof(Elf32_Shdr));
+	if (shdr == NULL) {
+		ret = -ENOMEM;
+		goto errout;
+	}
+
+	ret = compress_loadperf_read(fd, binhdr_size, (FAR uint8_t *)shdr, ehdr.e_shnum * sizeof(Elf32_Shdr), ehdr.e_shnum * sizeof(Elf32_Shdr), ehdr.e_shoff);
+	if (ret != OK) {
+		goto errout;
+	}
+
+	/* Load the allocated sections */
+
+	for (i = 0; i < ehdr.e_shnum; i++) {
+		if ((shdr[i].sh_flags & SHF_ALLOC) != 0 && shdr[i].sh_type != SHT_NOBITS) {
+			ret = compress_loadperf_read(fd, binhdr_size, buffer, bufsize, shdr[i].sh_size, shdr[i].sh_offset);
+			if (ret != OK) {
+				goto errout;
+			}
+		}
+	}
+
+	/* Bind: read each relocation and then the symbol it refers to */
+
+	for (i = 0; i < ehdr.e_shnum; i++) {
+		if (shdr[i].sh_type != SHT_REL || shdr[i].sh_link >= ehdr.e_shnum) {
+			continue;
+		}
+
+		symtab = &shdr[shdr[i].sh_link];
+		nrel = shdr[i].sh_size / sizeof(Elf32_Rel);
+		for (j = 0; j < nrel; j++) {
+			rel = (Elf32_Rel *)buffer;
+			ret = compress_loadperf_read(fd, binhdr_size, buffer, bufsize, sizeof(Elf32_Rel), shdr[i].sh_offset + j * sizeof(Elf32_Rel));
+			if (ret != OK) {
+				goto errout;
+			}
+
+			ret = compress_loadperf_read(fd, binhdr_size, (FAR uint8_t *)&sym, sizeof(Elf32_Sym), sizeof(Elf32_Sym), symtab->sh_offset + ELF32_R_SYM(rel->r_info) * sizeof(Elf32_Sym));
+			if (ret != OK) {
+				goto errout;
+			}
+		}
+	}
+
+errout:
+	if (shdr) {
+		kmm_free(shdr);
+	}
+	if (buffer) {
+		kmm_free(buffer);
+	}
+	compress_uninit();
+	return ret;
+}
+
+/****************************************************************************
+ * Name: test_compress_load_perf
+ *
+ * Description:
+ *   Time one load of the compressed binary described by 'arg' with the
+ *   decompressed block cache enabled or disabled.
+ ****************************************************************************/
+
+static int test_compress_load_perf(unsigned long arg)
+{
+	struct compress_loadperf_s *perf = (struct compress_loadperf_s *)arg;
+	struct compress_cache_stats_s stats;
+	struct timespec start;
+	struct timespec end;
+	int fd;
+	int ret;
+
+	if (perf == NULL || perf->path == NULL) {
+		return -EINVAL;
+	}
+
+	fd = open(perf->path, O_RDONLY);
+	if (fd < 0) {
+		int errval = get_errno();
+		berr("Failed to open %s ERROR = %d\n", perf->path, errval);
+		return -errval;
+	}
+
+	compress_set_cache(perf->cache);
+
+	clock_gettime(CLOCK_REALTIME, &start);
+	ret = compress_loadperf_load(fd, perf->offset);
+	clock_gettime(CLOCK_REALTIME, &end);
+
+	/* compress_uninit leaves the statistics of the last load in place */
+
+	compress_get_cachestats(&stats);
+	compress_set_cache(true);
+	close(fd);
+
+	perf->usec = (end.tv_sec - start.tv_sec) * 1000000 + (end.tv_nsec - start.tv_nsec) / 1000;
+	perf->hits = stats.hits;
+	perf->misses = stats.misses;
+	perf->prefetched = stats.prefetched;
+
+	return ret;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -108,6 +286,9 @@ int test_compress_decompress(int cmd, unsigned long arg)
 	case TESTIOC_COMPRESSION_TEST:
 		ret = test_compress_decompress_function(arg);
 		break;
+	case TESTIOC_COMPRESSION_LOAD_PERF:
+		ret = test_compress_load_perf(arg);
+		break;
 	}
 	return ret;
 }
@@ -124,8 +124,9 @@ static int os_api_test_drv_ioctl(FAR struct file *filep, int cmd, unsigned long
 	case TESTIOC_TASK_INIT_TEST:
 		ret = test_task(cmd, arg);
 		break;
-#ifdef CONFIG_TC_COMPRESS_READ
+#if defined(CONFIG_TC_COMPRESS_READ) || defined(CONFIG_EXAMPLES_COMPRESS_LOAD_PERF)
 	case TESTIOC_COMPRESSION_TEST:
+	case TESTIOC_COMPRESSION_LOAD_PERF:
 		ret = test_compress_decompress(cmd, arg);
 		break;
 #endif
@@ -0,0 +1,257 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+
+#include <tinyara/arch.h>
+#include <tinyara/sched.h>
+#include <tinyara/perf.h>
+#include <tinyara/fs/fs.h>
+#include <tinyara/fs/ioctl.h>
+#include <arch/irq.h>
+
+#include "sched/sched.h"
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int perf_ioctl(FAR struct file *filep, int cmd, unsigned long arg);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct file_operations g_perf_fops = {
+	0,							/* open */
+	0,							/* close */
+	0,							/* read */
+	0,							/* write */
+	0,							/* seek */
+	perf_ioctl					/* ioctl */
+#ifndef CONFIG_DISABLE_POLL
+	, 0							/* poll */
+#endif
+};
+
+/* Configured events; zero events means that nothing is counted */
+
+static uint8_t g_perf_nevents;
+static uint8_t g_perf_events[PERF_MAX_COUNTERS];
+static uint32_t g_perf_masks[PERF_MAX_COUNTERS];
+
+/* Raw counter values at the last update and the task running since then */
+
+static uint32_t g_perf_last[PERF_MAX_COUNTERS];
+static pid_t g_perf_prev;
+
+/* Events counted for all tasks together, including those which exited */
+
+static uint64_t g_perf_total[PERF_MAX_COUNTERS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void perf_clear_task(FAR struct tcb_s *tcb, FAR void *arg)
+{
+	memset(tcb->perf_counts, 0, sizeof(tcb->perf_counts));
+}
+
+/****************************************************************************
+ * Name: perf_configure
+ *
+ * Description:
+ *   Program the counters for the new events and reset all counts.  Called
+ *   with interrupts disabled.
+ *
+ ****************************************************************************/
+
+static int perf_configure(FAR const struct perf_config_s *config)
+{
+	int ret;
+	int i;
+
+	g_perf_nevents = 0;
+
+	if (config->nevents > PERF_MAX_COUNTERS) {
+		return -EINVAL;
+	}
+
+	for (i = 0; i < config->nevents; i++) {
+		if (config->events[i] >= PERF_EVENT_MAX) {
+			return -EINVAL;
+		}
+	}
+
+	if (config->nevents == 0) {
+		return OK;
+	}
+
+	ret = up_perf_counters_config(config->events, config->nevents, g_perf_masks);
+	if (ret < 0) {
+		return ret;
+	}
+
+	memcpy(g_perf_events, config->events, config->nevents);
+	memset(g_perf_total, 0, sizeof(g_perf_total));
+	sched_foreach(perf_clear_task, NULL);
+
+	up_perf_counters_read(g_perf_last, config->nevents);
+	g_perf_prev = this_task()->pid;
+	g_perf_nevents = config->nevents;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: perf_ioctl
+ ****************************************************************************/
+
+static int perf_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
+{
+	FAR struct perf_read_s *req;
+	FAR struct tcb_s *tcb;
+	irqstate_t flags;
+	pid_t pid;
+	int ret = -EINVAL;
+
+	switch (cmd) {
+	case PERFIOC_CONFIG:
+		if (arg == 0) {
+			break;
+		}
+
+		flags = irqsave();
+		ret = perf_configure((FAR const struct perf_config_s *)arg);
+		irqrestore(flags);
+		break;
+
+	case PERFIOC_READ:
+		req = (FAR struct perf_read_s *)arg;
+		if (req == NULL) {
+			break;
+		}
+
+		flags = irqsave();
+
+		/* Bring the counts of the caller, which is running, up to date */
+
+		perf_update(this_task());
+
+		req->nevents = g_perf_nevents;
+		memcpy(req->events, g_perf_events, g_perf_nevents);
+
+		if (req->pid == PERF_PID_ALL) {
+			memcpy(req->counts, g_perf_total, g_perf_nevents * sizeof(uint64_t));
+			ret = OK;
+		} else {
+			tcb = req->pid == PERF_PID_SELF ? this_task() : sched_gettcb(req->pid);
+			if (tcb != NULL) {
+				memcpy(req->counts, tcb->perf_counts, g_perf_nevents * sizeof(uint64_t));
+				ret = OK;
+			} else {
+				ret = -ESRCH;
+			}
+		}
+
+		irqrestore(flags);
+		break;
+
+	case PERFIOC_RESET:
+		pid = (pid_t)arg;
+		ret = OK;
+
+		flags = irqsave();
+		perf_update(this_task());
+
+		if (pid == PERF_PID_ALL) {
+			memset(g_perf_total, 0, sizeof(g_perf_total));
+			sched_foreach(perf_clear_task, NULL);
+		} else {
+			tcb = pid == PERF_PID_SELF ? this_task() : sched_gettcb(pid);
+			if (tcb != NULL) {
+				perf_clear_task(tcb, NULL);
+			} else {
+				ret = -ESRCH;
+			}
+		}
+
+		irqrestore(flags);
+		break;
+
+	default:
+		break;
+	}
+
+	return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: perf_update
+ ****************************************************************************/
+
+void perf_update(FAR struct tcb_s *tcb)
+{
+	FAR struct tcb_s *prev;
+	uint32_t now[PERF_MAX_COUNTERS];
+	uint32_t delta;
+	int i;
+
+	if (g_perf_nevents == 0) {
+		return;
+	}
+
+	up_perf_counters_read(now, g_perf_nevents);
+
+	/* The previous task may have exited in the meantime */
+
+	prev = sched_gettcb(g_perf_prev);
+
+	for (i = 0; i < g_perf_nevents; i++) {
+		delta = (now[i] - g_perf_last[i]) & g_perf_masks[i];
+		g_perf_last[i] = now[i];
+		g_perf_total[i] += delta;
+		if (prev != NULL) {
+			prev->perf_counts[i] += delta;
+		}
+	}
+
+	g_perf_prev = tcb->pid;
+}
+
+/****************************************************************************
+ * Name: perf_initialize
+ ****************************************************************************/
+
+void perf_initialize(void)
+{
+	(void)register_driver(PERF_DRVPATH, &g_perf_fops, 0666, NULL);
+}
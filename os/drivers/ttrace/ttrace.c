@@ -41,6 +41,7 @@
 #include <tinyara/fs/fs.h>
 #include <tinyara/arch.h>
 #include <tinyara/ringbuf.h>
+#include <tinyara/ttrace.h>
 
 #include <arch/irq.h>
 
@@ -231,6 +232,17 @@ static int ttrace_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 		ttdbg("Resize of trace buffer is not supported yet.\r\n");
 		ttdbg("Trace buffer size should be defined by menuconfig.\r\n");
 		break;
+#ifdef CONFIG_TTRACE_KERNEL
+	case TTRACE_KSTART:
+		ret = ttrace_kstart((uint32_t)arg);
+		break;
+	case TTRACE_KINFO:
+		ret = ttrace_kinfo((FAR struct trace_kinfo *)arg);
+		break;
+	case TTRACE_KREAD:
+		ret = ttrace_kread((FAR struct trace_kread *)arg);
+		break;
+#endif
 	default:
 		ttdbg("Invalid commands, cmd: %c, arg: %d\r\n", cmd, arg);
 		break;
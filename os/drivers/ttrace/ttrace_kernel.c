@@ -0,0 +1,275 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+
+#include <tinyara/arch.h>
+#include <tinyara/clock.h>
+#include <tinyara/sched.h>
+#include <tinyara/ttrace.h>
+
+#include "sched/sched.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define TTRACE_KMASK            (CONFIG_TTRACE_KERNEL_NEVENTS - 1)
+
+#if (CONFIG_TTRACE_KERNEL_NEVENTS & TTRACE_KMASK) != 0
+#error CONFIG_TTRACE_KERNEL_NEVENTS must be a power of two
+#endif
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* Enabled TTRACE_KTAG_* categories, tested inline by the tracepoints */
+
+volatile uint32_t g_ttrace_ktags;
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct trace_kevent g_ttrace_kring[CONFIG_TTRACE_KERNEL_NEVENTS];
+
+/* Number of events reserved since the start.  The event with the sequence
+ * number n lives in g_ttrace_kring[n & TTRACE_KMASK].
+ */
+
+static uint32_t g_ttrace_khead;
+
+/* The task which was switched in last */
+
+static pid_t g_ttrace_kprev;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static inline uint32_t ttrace_ktimestamp(void)
+{
+#ifdef CONFIG_ARCH_HAVE_PERF_EVENTS
+	return up_perf_gettime();
+#else
+	return (uint32_t)clock_systimer();
+#endif
+}
+
+static inline uint32_t ttrace_kfreq(void)
+{
+#ifdef CONFIG_ARCH_HAVE_PERF_EVENTS
+	return up_perf_getfreq();
+#else
+	return TICK_PER_SEC;
+#endif
+}
+
+/****************************************************************************
+ * Name: ttrace_kput
+ *
+ * Description:
+ *   Reserve the next slot of the ring with an atomic increment and fill
+ *   it.  The sequence number is cleared while the event is written and
+ *   published last, so a reader can tell a complete event from one which
+ *   is being written or was overwritten.  Interrupt handlers may nest
+ *   anywhere in here; they simply take the following slots.
+ *
+ ****************************************************************************/
+
+static void ttrace_kput(pid_t pid, uint8_t type, uint32_t arg0, uint32_t arg1)
+{
+	FAR struct trace_kevent *ev;
+	uint32_t seq;
+
+	seq = __atomic_fetch_add(&g_ttrace_khead, 1, __ATOMIC_RELAXED);
+	ev = &g_ttrace_kring[seq & TTRACE_KMASK];
+
+	__atomic_store_n(&ev->seq, 0, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+
+	ev->timestamp = ttrace_ktimestamp();
+	ev->pid = pid;
+	ev->type = type;
+	ev->cpu = 0;
+	ev->arg0 = arg0;
+	ev->arg1 = arg1;
+
+	__atomic_store_n(&ev->seq, seq + 1, __ATOMIC_RELEASE);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ttrace_kevent
+ *
+ * Description:
+ *   Record an event of the running task.  Called through the ttrace_*()
+ *   tracepoint macros once the category of the event is enabled.
+ *
+ ****************************************************************************/
+
+void ttrace_kevent(uint8_t type, uint32_t arg0, uint32_t arg1)
+{
+	FAR struct tcb_s *rtcb = this_task();
+
+	ttrace_kput(rtcb != NULL ? rtcb->pid : -1, type, arg0, arg1);
+}
+
+/****************************************************************************
+ * Name: ttrace_kswitch
+ *
+ * Description:
+ *   Record a context switch to tcb.  Called from the context switch logic
+ *   with interrupts disabled.
+ *
+ ****************************************************************************/
+
+void ttrace_kswitch(FAR struct tcb_s *tcb)
+{
+	pid_t prev = g_ttrace_kprev;
+
+	g_ttrace_kprev = tcb->pid;
+	ttrace_kput(tcb->pid, TTRACE_KEVENT_SWITCH, tcb->sched_priority, (uint32_t)prev);
+}
+
+/****************************************************************************
+ * Name: ttrace_kstart
+ *
+ * Description:
+ *   Enable the given TTRACE_KTAG_* categories.  The ring is emptied when
+ *   tracing starts from the stopped state.  Zero stops tracing and keeps
+ *   the recorded events for reading.
+ *
+ ****************************************************************************/
+
+int ttrace_kstart(uint32_t tags)
+{
+	FAR struct tcb_s *rtcb;
+
+	tags &= TTRACE_KTAG_ALL;
+
+	if (tags != 0 && g_ttrace_ktags == 0) {
+		memset(g_ttrace_kring, 0, sizeof(g_ttrace_kring));
+		g_ttrace_khead = 0;
+
+		rtcb = this_task();
+		g_ttrace_kprev = rtcb->pid;
+	}
+
+	g_ttrace_ktags = tags;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: ttrace_kinfo
+ ****************************************************************************/
+
+int ttrace_kinfo(FAR struct trace_kinfo *info)
+{
+	if (info == NULL) {
+		return -EINVAL;
+	}
+
+	info->freq = ttrace_kfreq();
+	info->nevents = CONFIG_TTRACE_KERNEL_NEVENTS;
+	info->head = __atomic_load_n(&g_ttrace_khead, __ATOMIC_ACQUIRE);
+	info->tags = g_ttrace_ktags;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: ttrace_kread
+ *
+ * Description:
+ *   Copy the complete events from req->pos on into req->events.  Events
+ *   which were overwritten before they could be read are counted in
+ *   req->lost.  Reading stops at an event which is still being written,
+ *   so that it can be picked up by the next call.  Tracing may be left
+ *   running while reading.
+ *
+ * Returned Value:
+ *   The number of events copied, or a negated errno value.
+ *
+ ****************************************************************************/
+
+int ttrace_kread(FAR struct trace_kread *req)
+{
+	FAR struct trace_kevent *ev;
+	uint32_t head;
+	uint32_t pos;
+	uint32_t seq;
+	int nread = 0;
+
+	if (req == NULL || req->events == NULL) {
+		return -EINVAL;
+	}
+
+	head = __atomic_load_n(&g_ttrace_khead, __ATOMIC_ACQUIRE);
+	pos = req->pos;
+	req->lost = 0;
+
+	if ((int32_t)(head - pos) < 0) {
+		/* The ring was restarted after the previous read */
+
+		pos = 0;
+	}
+
+	if (head - pos > CONFIG_TTRACE_KERNEL_NEVENTS) {
+		req->lost = head - pos - CONFIG_TTRACE_KERNEL_NEVENTS;
+		pos = head - CONFIG_TTRACE_KERNEL_NEVENTS;
+	}
+
+	while (pos != head && nread < req->nevents) {
+		ev = &g_ttrace_kring[pos & TTRACE_KMASK];
+
+		seq = __atomic_load_n(&ev->seq, __ATOMIC_ACQUIRE);
+		if (seq == pos + 1) {
+			memcpy(&req->events[nread], ev, sizeof(struct trace_kevent));
+			__atomic_thread_fence(__ATOMIC_ACQUIRE);
+			seq = __atomic_load_n(&ev->seq, __ATOMIC_RELAXED);
+		}
+
+		if (seq == pos + 1) {
+			nread++;
+		} else if (seq == 0 || (int32_t)(seq - (pos + 1)) < 0) {
+			/* Reserved, but not complete yet */
+
+			break;
+		} else {
+			req->lost++;
+		}
+
+		pos++;
+	}
+
+	req->pos = pos;
+	return nread;
+}
@@ -0,0 +1,723 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <semaphore.h>
+#include <errno.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <tinyara/kmalloc.h>
+#include <tinyara/semaphore.h>
+#include <tinyara/fs/fs.h>
+#include <tinyara/fs/bcache.h>
+
+#ifdef CONFIG_FS_BCACHE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define BCACHE_NENTRIES     CONFIG_FS_BCACHE_NSECTORS
+#define BCACHE_SECTORSIZE   CONFIG_FS_BCACHE_SECTORSIZE
+#define BCACHE_NHASH        CONFIG_FS_BCACHE_NHASH
+
+/* Once this many entries are dirty, the device being written is synced */
+
+#define BCACHE_DIRTY_LIMIT  ((BCACHE_NENTRIES * 3) / 4)
+
+/* Entry flags */
+
+#define BCACHE_VALID        (1 << 0)	/* Entry holds a sector */
+#define BCACHE_DIRTY        (1 << 1)	/* Sector differs from the media */
+#define BCACHE_REF          (1 << 2)	/* Referenced since the clock hand passed */
+#define BCACHE_BUSY         (1 << 3)	/* Being written back; data must not change */
+
+#define BCACHE_HASH(i, s)   ((((uintptr_t)(i) >> 4) ^ (uintptr_t)(s)) % BCACHE_NHASH)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct bcache_entry_s {
+	FAR struct bcache_entry_s *hnext;	/* Next entry in the hash chain */
+	FAR struct inode *inode;			/* Block driver owning the sector */
+	size_t sector;						/* Sector number on that driver */
+	FAR uint8_t *data;					/* BCACHE_SECTORSIZE bytes of sector data */
+	uint16_t sectsize;					/* Size of the sector (<= BCACHE_SECTORSIZE) */
+	uint8_t flags;						/* See BCACHE_* flags */
+};
+
+/* 'sem' only protects the cache metadata and is never held across a call
+ * into a block driver.  'wgen' is incremented after every write that reaches
+ * a driver so that a read miss, which is done without 'sem', can tell
+ * whether the data it read may already be stale before it caches it.
+ */
+
+struct bcache_s {
+	sem_t sem;							/* Mutual exclusion */
+	sem_t iowait;						/* Posted when a BUSY entry is released */
+	uint16_t nwaiters;					/* Threads waiting on 'iowait' */
+	uint16_t nbusy;						/* Entries with BCACHE_BUSY set */
+	bool initialized;					/* true: pool has been allocated */
+	uint16_t hand;						/* Clock hand for replacement */
+	uint32_t wgen;						/* Driver write generation */
+	FAR struct bcache_entry_s *hash[BCACHE_NHASH];
+	struct bcache_entry_s entries[BCACHE_NENTRIES];
+	struct bcache_stats_s stats;
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct bcache_s g_bcache;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void bcache_semtake(void)
+{
+	while (sem_wait(&g_bcache.sem) != OK) {
+		/* The only case that an error should occur here is if the wait was
+		 * awakened by a signal.
+		 */
+
+		ASSERT(get_errno() == EINTR);
+	}
+}
+
+#define bcache_semgive() sem_post(&g_bcache.sem)
+
+/****************************************************************************
+ * Name: bcache_waitbusy
+ *
+ * Description:
+ *   Release the cache, wait until some BUSY entry is released and take the
+ *   cache again.  The caller must look its entry up again afterwards.
+ *
+ ****************************************************************************/
+
+static void bcache_waitbusy(void)
+{
+	g_bcache.nwaiters++;
+	bcache_semgive();
+
+	while (sem_wait(&g_bcache.iowait) != OK) {
+		ASSERT(get_errno() == EINTR);
+	}
+
+	bcache_semtake();
+}
+
+/****************************************************************************
+ * Name: bcache_wakebusy
+ ****************************************************************************/
+
+static void bcache_wakebusy(void)
+{
+	while (g_bcache.nwaiters > 0) {
+		g_bcache.nwaiters--;
+		sem_post(&g_bcache.iowait);
+	}
+}
+
+/****************************************************************************
+ * Name: bcache_find
+ ****************************************************************************/
+
+static FAR struct bcache_entry_s *bcache_find(FAR struct inode *inode, size_t sector)
+{
+	FAR struct bcache_entry_s *entry;
+
+	for (entry = g_bcache.hash[BCACHE_HASH(inode, sector)]; entry; entry = entry->hnext) {
+		if (entry->inode == inode && entry->sector == sector) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+/****************************************************************************
+ * Name: bcache_hash
+ ****************************************************************************/
+
+static void bcache_hash(FAR struct bcache_entry_s *entry, FAR struct inode *inode, size_t sector, uint16_t sectsize)
+{
+	int hash = BCACHE_HASH(inode, sector);
+
+	entry->inode = inode;
+	entry->sector = sector;
+	entry->sectsize = sectsize;
+	entry->flags = BCACHE_VALID | BCACHE_REF;
+	entry->hnext = g_bcache.hash[hash];
+	g_bcache.hash[hash] = entry;
+	g_bcache.stats.nused++;
+}
+
+/****************************************************************************
+ * Name: bcache_unhash
+ ****************************************************************************/
+
+static void bcache_unhash(FAR struct bcache_entry_s *entry)
+{
+	FAR struct bcache_entry_s **pprev;
+
+	pprev = &g_bcache.hash[BCACHE_HASH(entry->inode, entry->sector)];
+	while (*pprev) {
+		if (*pprev == entry) {
+			*pprev = entry->hnext;
+			break;
+		}
+		pprev = &(*pprev)->hnext;
+	}
+
+	entry->hnext = NULL;
+	entry->flags = 0;
+	g_bcache.stats.nused--;
+}
+
+/****************************************************************************
+ * Name: bcache_writeback
+ *
+ * Description:
+ *   Write a dirty entry to its driver.  The cache is released during the
+ *   write; the entry is marked BUSY meanwhile so that it is neither evicted
+ *   nor modified.
+ *
+ ****************************************************************************/
+
+static int bcache_writeback(FAR struct bcache_entry_s *entry)
+{
+	FAR struct inode *inode = entry->inode;
+	size_t sector = entry->sector;
+	ssize_t ret;
+
+	DEBUGASSERT((entry->flags & BCACHE_BUSY) == 0);
+
+	if ((entry->flags & BCACHE_DIRTY) == 0) {
+		return OK;
+	}
+
+	entry->flags |= BCACHE_BUSY;
+	g_bcache.nbusy++;
+	bcache_semgive();
+
+	ret = inode->u.i_bops->write(inode, entry->data, sector, 1);
+
+	bcache_semtake();
+	entry->flags &= ~BCACHE_BUSY;
+	g_bcache.nbusy--;
+	g_bcache.wgen++;
+	bcache_wakebusy();
+
+	if (ret < 0) {
+		fdbg("ERROR: write back of sector %d failed: %d\n", sector, ret);
+		return (int)ret;
+	}
+
+	entry->flags &= ~BCACHE_DIRTY;
+	g_bcache.stats.ndirty--;
+	g_bcache.stats.writebacks++;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: bcache_alloc
+ *
+ * Description:
+ *   Select a free entry with the CLOCK algorithm.  The returned entry is not
+ *   hashed yet.  If 'writeback' is true, dirty victims are written back, which
+ *   releases the cache for the duration of the write, so the caller must
+ *   look its sector up again before hashing the entry.  Otherwise only clean
+ *   victims are taken and the cache is never released.
+ *
+ *   Returns NULL if no entry could be freed.
+ *
+ ****************************************************************************/
+
+static FAR struct bcache_entry_s *bcache_alloc(bool writeback)
+{
+	FAR struct bcache_entry_s *entry;
+	unsigned int scanned = 0;
+
+	for (;;) {
+		/* Two full turns clear every reference bit; if nothing was found
+		 * by then, every candidate is busy or dirty.
+		 */
+
+		if (scanned++ >= 2 * BCACHE_NENTRIES) {
+			if (!writeback) {
+				return NULL;
+			}
+
+			if (g_bcache.nbusy > 0) {
+				bcache_waitbusy();
+			}
+
+			scanned = 0;
+		}
+
+		entry = &g_bcache.entries[g_bcache.hand];
+		g_bcache.hand = (g_bcache.hand + 1) % BCACHE_NENTRIES;
+
+		if ((entry->flags & BCACHE_VALID) == 0) {
+			return entry;
+		}
+
+		if ((entry->flags & BCACHE_BUSY) != 0) {
+			continue;
+		}
+
+		if ((entry->flags & BCACHE_REF) != 0) {
+			/* Give it a second chance */
+
+			entry->flags &= ~BCACHE_REF;
+			continue;
+		}
+
+		if ((entry->flags & BCACHE_DIRTY) != 0) {
+			if (!writeback) {
+				continue;
+			}
+
+			if (bcache_writeback(entry) < 0) {
+				return NULL;
+			}
+
+			/* It may have been referenced while the cache was released */
+
+			if ((entry->flags & (BCACHE_VALID | BCACHE_REF | BCACHE_DIRTY | BCACHE_BUSY)) != BCACHE_VALID) {
+				continue;
+			}
+		}
+
+		bcache_unhash(entry);
+		g_bcache.stats.evictions++;
+		return entry;
+	}
+}
+
+/****************************************************************************
+ * Name: bcache_get
+ *
+ * Description:
+ *   Return the entry holding (inode, sector), allocating one if needed.  The
+ *   returned entry is never BUSY.
+ *
+ ****************************************************************************/
+
+static FAR struct bcache_entry_s *bcache_get(FAR struct inode *inode, size_t sector, uint16_t sectsize)
+{
+	FAR struct bcache_entry_s *entry;
+
+	for (;;) {
+		entry = bcache_find(inode, sector);
+		if (!entry) {
+			entry = bcache_alloc(true);
+			if (!entry) {
+				return NULL;
+			}
+
+			/* Someone else may have cached the sector while the victim was
+			 * being written back.  The free entry is simply left unused.
+			 */
+
+			if (bcache_find(inode, sector)) {
+				continue;
+			}
+
+			bcache_hash(entry, inode, sector, sectsize);
+			return entry;
+		}
+
+		if ((entry->flags & BCACHE_BUSY) == 0) {
+			return entry;
+		}
+
+		bcache_waitbusy();
+	}
+}
+
+/****************************************************************************
+ * Name: bcache_sync_locked
+ ****************************************************************************/
+
+static int bcache_sync_locked(FAR struct inode *inode, bool invalidate)
+{
+	FAR struct bcache_entry_s *entry;
+	int result = OK;
+	int ret;
+	int i;
+
+	for (i = 0; i < BCACHE_NENTRIES; i++) {
+		entry = &g_bcache.entries[i];
+		if ((entry->flags & BCACHE_VALID) == 0 || (inode && entry->inode != inode)) {
+			continue;
+		}
+
+		if ((entry->flags & BCACHE_BUSY) != 0) {
+			/* Another thread is writing it back; look at it again */
+
+			bcache_waitbusy();
+			i--;
+			continue;
+		}
+
+		ret = bcache_writeback(entry);
+		if (ret < 0) {
+			result = ret;
+			continue;
+		}
+
+		if (invalidate) {
+			bcache_unhash(entry);
+		}
+	}
+
+	return result;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: bcache_initialize
+ ****************************************************************************/
+
+void bcache_initialize(void)
+{
+	FAR uint8_t *pool;
+	int i;
+
+	sem_init(&g_bcache.sem, 0, 1);
+
+	/* iowait is a signaling semaphore, so priority inheritance must be off */
+
+	sem_init(&g_bcache.iowait, 0, 0);
+	sem_setprotocol(&g_bcache.iowait, SEM_PRIO_NONE);
+
+	pool = (FAR uint8_t *)kmm_malloc(BCACHE_NENTRIES * BCACHE_SECTORSIZE);
+	if (!pool) {
+		fdbg("ERROR: Failed to allocate %d bytes for the buffer cache\n", BCACHE_NENTRIES * BCACHE_SECTORSIZE);
+		return;
+	}
+
+	for (i = 0; i < BCACHE_NENTRIES; i++) {
+		g_bcache.entries[i].data = pool + i * BCACHE_SECTORSIZE;
+	}
+
+	g_bcache.stats.nentries = BCACHE_NENTRIES;
+	g_bcache.initialized = true;
+}
+
+/****************************************************************************
+ * Name: bcache_read
+ ****************************************************************************/
+
+ssize_t bcache_read(FAR struct inode *inode, FAR unsigned char *buffer, size_t start_sector, unsigned int nsectors, uint16_t sectsize)
+{
+	FAR struct bcache_entry_s *entry;
+	unsigned int nmiss;
+	unsigned int done;
+	unsigned int i;
+	uint32_t wgen;
+	size_t sector;
+	ssize_t ret;
+
+	DEBUGASSERT(inode && inode->u.i_bops && inode->u.i_bops->read);
+
+	if (!g_bcache.initialized || sectsize > BCACHE_SECTORSIZE) {
+		g_bcache.stats.bypasses += nsectors;
+		return inode->u.i_bops->read(inode, buffer, start_sector, nsectors);
+	}
+
+	bcache_semtake();
+
+	done = 0;
+	while (done < nsectors) {
+		/* Copy out every sector that is already cached.  A BUSY entry is
+		 * only being written back, so its data is stable.
+		 */
+
+		entry = bcache_find(inode, start_sector + done);
+		if (entry) {
+			memcpy(buffer + done * sectsize, entry->data, sectsize);
+			entry->flags |= BCACHE_REF;
+			g_bcache.stats.hits++;
+			done++;
+			continue;
+		}
+
+		/* Gather the run of missing sectors and read it from the media in
+		 * one request, directly into the caller's buffer.  The cache is
+		 * released meanwhile so that other devices are not held up.
+		 */
+
+		for (nmiss = 1; done + nmiss < nsectors; nmiss++) {
+			if (bcache_find(inode, start_sector + done + nmiss)) {
+				break;
+			}
+		}
+
+		wgen = g_bcache.wgen;
+		bcache_semgive();
+
+		ret = inode->u.i_bops->read(inode, buffer + done * sectsize, start_sector + done, nmiss);
+
+		bcache_semtake();
+		if (ret < 0) {
+			bcache_semgive();
+			return done > 0 ? (ssize_t)done : ret;
+		}
+
+		g_bcache.stats.misses += nmiss;
+
+		/* Keep a copy of what was read, unless a driver was written since
+		 * the read started; the data may then be older than the media.  A
+		 * run longer than the cache would only evict itself, so only the
+		 * tail of it is retained.  Sectors cached by someone else in the
+		 * meantime are newer and are left alone.
+		 */
+
+		if (g_bcache.wgen == wgen) {
+			i = nmiss > BCACHE_NENTRIES ? nmiss - BCACHE_NENTRIES : 0;
+			for (; i < nmiss; i++) {
+				sector = start_sector + done + i;
+				if (bcache_find(inode, sector)) {
+					continue;
+				}
+
+				entry = bcache_alloc(false);
+				if (!entry) {
+					break;
+				}
+
+				bcache_hash(entry, inode, sector, sectsize);
+				memcpy(entry->data, buffer + (done + i) * sectsize, sectsize);
+			}
+		}
+
+		done += nmiss;
+	}
+
+	bcache_semgive();
+	return (ssize_t)nsectors;
+}
+
+/****************************************************************************
+ * Name: bcache_write
+ ****************************************************************************/
+
+ssize_t bcache_write(FAR struct inode *inode, FAR const unsigned char *buffer, size_t start_sector, unsigned int nsectors, uint16_t sectsize)
+{
+	FAR struct bcache_entry_s *entry;
+	unsigned int nwritten;
+	unsigned int i;
+	uint32_t wgen;
+	ssize_t ret;
+
+	DEBUGASSERT(inode && inode->u.i_bops && inode->u.i_bops->write);
+
+	if (!g_bcache.initialized || sectsize > BCACHE_SECTORSIZE) {
+		g_bcache.stats.bypasses += nsectors;
+		return inode->u.i_bops->write(inode, buffer, start_sector, nsectors);
+	}
+
+	bcache_semtake();
+
+	/* Large writes would flush the whole cache; write them through and only
+	 * refresh the copies that are already cached.
+	 */
+
+	if (nsectors > BCACHE_NENTRIES / 2) {
+		wgen = g_bcache.wgen;
+		bcache_semgive();
+
+		ret = inode->u.i_bops->write(inode, buffer, start_sector, nsectors);
+
+		bcache_semtake();
+
+		/* Only the sectors the driver reports as written are refreshed.  If
+		 * another write reached a driver meanwhile, it may have landed
+		 * after this one, so the copies are kept dirty to be written again.
+		 */
+
+		nwritten = ret > 0 ? (unsigned int)ret : 0;
+		for (i = 0; i < nwritten; i++) {
+			entry = bcache_find(inode, start_sector + i);
+			if (!entry) {
+				continue;
+			}
+
+			if ((entry->flags & BCACHE_BUSY) != 0) {
+				bcache_waitbusy();
+				i--;
+				continue;
+			}
+
+			memcpy(entry->data, buffer + i * sectsize, sectsize);
+			if (g_bcache.wgen == wgen) {
+				if ((entry->flags & BCACHE_DIRTY) != 0) {
+					entry->flags &= ~BCACHE_DIRTY;
+					g_bcache.stats.ndirty--;
+				}
+			} else if ((entry->flags & BCACHE_DIRTY) == 0) {
+				entry->flags |= BCACHE_DIRTY;
+				g_bcache.stats.ndirty++;
+			}
+		}
+
+		g_bcache.wgen++;
+		bcache_semgive();
+		return ret;
+	}
+
+	for (i = 0; i < nsectors; i++) {
+		entry = bcache_get(inode, start_sector + i, sectsize);
+		if (!entry) {
+			bcache_semgive();
+			return i > 0 ? (ssize_t)i : -EIO;
+		}
+
+		memcpy(entry->data, buffer + i * sectsize, sectsize);
+		entry->flags |= BCACHE_REF;
+		if ((entry->flags & BCACHE_DIRTY) == 0) {
+			entry->flags |= BCACHE_DIRTY;
+			g_bcache.stats.ndirty++;
+		}
+	}
+
+	/* Do not let dirty data pile up; it makes every later miss pay for a
+	 * write back.
+	 */
+
+	if (g_bcache.stats.ndirty >= BCACHE_DIRTY_LIMIT) {
+		ret = bcache_sync_locked(inode, false);
+		if (ret < 0) {
+			bcache_semgive();
+			return ret;
+		}
+	}
+
+	bcache_semgive();
+	return (ssize_t)nsectors;
+}
+
+/****************************************************************************
+ * Name: bcache_sync
+ ****************************************************************************/
+
+int bcache_sync(FAR struct inode *inode)
+{
+	int ret;
+
+	if (!g_bcache.initialized) {
+		return OK;
+	}
+
+	bcache_semtake();
+	ret = bcache_sync_locked(inode, false);
+	bcache_semgive();
+	return ret;
+}
+
+/****************************************************************************
+ * Name: bcache_invalidate
+ ****************************************************************************/
+
+int bcache_invalidate(FAR struct inode *inode)
+{
+	int ret;
+
+	if (!g_bcache.initialized) {
+		return OK;
+	}
+
+	bcache_semtake();
+	ret = bcache_sync_locked(inode, true);
+	bcache_semgive();
+	return ret;
+}
+
+/****************************************************************************
+ * Name: bcache_discard
+ ****************************************************************************/
+
+void bcache_discard(FAR struct inode *inode, size_t start_sector, unsigned int nsectors)
+{
+	FAR struct bcache_entry_s *entry;
+	unsigned int i;
+
+	if (!g_bcache.initialized) {
+		return;
+	}
+
+	bcache_semtake();
+
+	for (i = 0; i < nsectors && g_bcache.stats.nused > 0; i++) {
+		entry = bcache_find(inode, start_sector + i);
+		if (!entry) {
+			continue;
+		}
+
+		if ((entry->flags & BCACHE_BUSY) != 0) {
+			bcache_waitbusy();
+			i--;
+			continue;
+		}
+
+		if ((entry->flags & BCACHE_DIRTY) != 0) {
+			g_bcache.stats.ndirty--;
+		}
+
+		bcache_unhash(entry);
+	}
+
+	/* A read miss that overlapped the driver write must not cache its data */
+
+	g_bcache.wgen++;
+	bcache_semgive();
+}
+
+/****************************************************************************
+ * Name: bcache_getstats
+ ****************************************************************************/
+
+void bcache_getstats(FAR struct bcache_stats_s *stats)
+{
+	DEBUGASSERT(stats);
+
+	bcache_semtake();
+	memcpy(stats, &g_bcache.stats, sizeof(struct bcache_stats_s));
+	bcache_semgive();
+}
+
+#endif							/* CONFIG_FS_BCACHE */
@@ -58,6 +58,9 @@
 #include <sys/mount.h>
 #include <debug.h>
 #include <tinyara/fs/fs.h>
+#ifdef CONFIG_FS_BCACHE
+#include <tinyara/fs/bcache.h>
+#endif
 
 #include "inode/inode.h"
 
@@ -141,6 +144,12 @@ void fs_initialize(void)
 
 #endif
 
+#ifdef CONFIG_FS_BCACHE
+	/* Allocate the shared block buffer cache */
+
+	bcache_initialize();
+#endif
+
 #if !defined(CONFIG_DISABLE_PSEUDOFS_OPERATIONS) && \
 	!defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_BCH)
 	/* Initialize for unique character device used in  */
@@ -0,0 +1,141 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <stdint.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <tinyara/fs/fs.h>
+#include <tinyara/fs/ioctl.h>
+
+#include "inode/inode.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mmap
+ *
+ * Description:
+ *   Map a file opened on directly accessible media (for example a ROMFS
+ *   volume on a memory-mapped MTD device) into the caller's address space.
+ *   No copy is made: the returned address points straight into the media,
+ *   so the mapping is read-only and stays valid until the file system is
+ *   unmounted.
+ *
+ *   Only the subset of mmap() that can be honoured without a RAM copy is
+ *   supported:
+ *
+ *   - 'start' is only a hint and is ignored, so MAP_FIXED is not supported.
+ *   - MAP_ANONYMOUS and PROT_WRITE are not supported.
+ *   - The file system must support the FIOC_MMAP ioctl.
+ *
+ * Input Parameters:
+ *   start  - Address hint (ignored)
+ *   length - The length of the mapping
+ *   prot   - Access protections; only PROT_READ/PROT_EXEC are supported
+ *   flags  - MAP_SHARED or MAP_PRIVATE (both behave the same here)
+ *   fd     - File descriptor of the file to be mapped
+ *   offset - Offset into the file where the mapping begins
+ *
+ * Returned Value:
+ *   On success, mmap() returns a pointer to the mapped area. On error, the
+ *   value MAP_FAILED is returned, and errno is set appropriately.
+ *
+ *   EBADF
+ *     'fd' is not a valid file descriptor.
+ *   EINVAL
+ *     'length' is zero or MAP_FIXED was requested.
+ *   ENODEV
+ *     The underlying file system does not support direct mapping.
+ *   ENOSYS
+ *     Writable or anonymous mappings were requested.
+ *   ENXIO
+ *     The range [offset, offset + length) is outside of the file.
+ *
+ ****************************************************************************/
+
+FAR void *mmap(FAR void *start, size_t length, int prot, int flags, int fd, off_t offset)
+{
+	FAR struct file *filep;
+	FAR uint8_t *addr;
+	struct stat buf;
+	int errcode;
+	int ret;
+
+	if (length == 0 || offset < 0 || (flags & MAP_FIXED) != 0) {
+		fdbg("ERROR: Invalid arguments, length=%d offset=%d flags=%04x\n", length, offset, flags);
+		errcode = EINVAL;
+		goto errout;
+	}
+
+	/* A writable or anonymous mapping would require a RAM backed copy of
+	 * the data which is not what this interface is for.
+	 */
+
+	if ((prot & PROT_WRITE) != 0 || (flags & MAP_ANONYMOUS) != 0) {
+		fdbg("ERROR: Unsupported options, prot=%x flags=%04x\n", prot, flags);
+		errcode = ENOSYS;
+		goto errout;
+	}
+
+	ret = fs_getfilep(fd, &filep);
+	if (ret < 0) {
+		errcode = -ret;
+		goto errout;
+	}
+
+	/* The mapping must lie completely inside of the file */
+
+	ret = fstat(fd, &buf);
+	if (ret < 0) {
+		errcode = get_errno();
+		goto errout;
+	}
+
+	if ((off_t)length > buf.st_size || offset > buf.st_size - (off_t)length) {
+		fdbg("ERROR: Range %d+%d is outside of the file (%d bytes)\n", offset, length, buf.st_size);
+		errcode = ENXIO;
+		goto errout;
+	}
+
+	/* Ask the file system for the address of the file data on the media */
+
+	ret = file_ioctl(filep, FIOC_MMAP, (unsigned long)((uintptr_t)&addr));
+	if (ret < 0) {
+		fvdbg("FIOC_MMAP is not supported: %d\n", ret);
+		errcode = ENODEV;
+		goto errout;
+	}
+
+	return (FAR void *)(addr + offset);
+
+errout:
+	set_errno(errcode);
+	return MAP_FAILED;
+}
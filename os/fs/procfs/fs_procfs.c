@@ -110,7 +110,10 @@ extern const struct procfs_operations smartfs_procfsoperations;
 extern const struct procfs_operations power_procfsoperations;
 extern const struct procfs_operations cm_operations;
 extern const struct procfs_operations irqs_operations;
+extern const struct procfs_operations irqlatency_operations;
 extern const struct procfs_operations ereport_operations;
+extern const struct procfs_operations bcache_operations;
+extern const struct procfs_operations wqueue_operations;
 
 /* And even worse, this one is specific to the STM32.  The solution to
  * this nasty couple would be to replace this hard-coded, ROM-able
@@ -140,10 +143,18 @@ static const struct procfs_entry_s g_procfsentries[] = {
 	{"fs/smartfs**", &smartfs_procfsoperations},
 #endif
 
+#if defined(CONFIG_FS_BCACHE) && !defined(CONFIG_FS_PROCFS_EXCLUDE_BCACHE)
+	{"bcache", &bcache_operations},
+#endif
+
 #if defined(CONFIG_DEBUG_IRQ_INFO) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IRQS)
 	{"irqs", &irqs_operations},
 #endif
 
+#if defined(CONFIG_IRQ_LATENCY) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IRQLATENCY)
+	{"irqlatency", &irqlatency_operations},
+#endif
+
 #if defined(CONFIG_MTD) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MTD)
 	{"mtd", &mtd_procfsoperations},
 #endif
@@ -164,6 +175,10 @@ static const struct procfs_entry_s g_procfsentries[] = {
 	{"version", &version_operations},
 #endif
 
+#if defined(CONFIG_SCHED_WORKQUEUE_STATS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_WQUEUE)
+	{"wqueue", &wqueue_operations},
+#endif
+
 #if defined(CONFIG_CM) && !defined(CONFIG_FS_PROCFS_EXCLUDE_CONNECTIVITY)
 	{"connectivity**", &cm_operations},
 #endif
@@ -0,0 +1,293 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <tinyara/kmalloc.h>
+#include <tinyara/fs/fs.h>
+#include <tinyara/fs/procfs.h>
+#include <tinyara/fs/bcache.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS)
+#if defined(CONFIG_FS_BCACHE) && !defined(CONFIG_FS_PROCFS_EXCLUDE_BCACHE)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+/* Determines the size of an intermediate buffer that must be large enough
+ * to hold the whole report generated by this logic.
+ */
+
+#define BCACHE_REPORTLEN 256
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct bcache_file_s {
+	struct procfs_file_s base;	/* Base open file structure */
+	unsigned int linesize;		/* Number of valid characters in line[] */
+	char line[BCACHE_REPORTLEN];	/* Pre-allocated buffer for the report */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int bcache_open(FAR struct file *filep, FAR const char *relpath, int oflags, mode_t mode);
+static int bcache_close(FAR struct file *filep);
+static ssize_t bcache_procread(FAR struct file *filep, FAR char *buffer, size_t buflen);
+
+static int bcache_dup(FAR const struct file *oldp, FAR struct file *newp);
+
+static int bcache_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Variables
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations bcache_operations = {
+	bcache_open,				/* open */
+	bcache_close,				/* close */
+	bcache_procread,			/* read */
+	NULL,						/* write */
+
+	bcache_dup,					/* dup */
+
+	NULL,						/* opendir */
+	NULL,						/* closedir */
+	NULL,						/* readdir */
+	NULL,						/* rewinddir */
+
+	bcache_stat					/* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: bcache_open
+ ****************************************************************************/
+
+static int bcache_open(FAR struct file *filep, FAR const char *relpath, int oflags, mode_t mode)
+{
+	FAR struct bcache_file_s *attr;
+
+	fvdbg("Open '%s'\n", relpath);
+
+	/* PROCFS is read-only.  Any attempt to open with any kind of write
+	 * access is not permitted.
+	 */
+
+	if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0) {
+		fdbg("ERROR: Only O_RDONLY supported\n");
+		return -EACCES;
+	}
+
+	/* "bcache" is the only acceptable value for the relpath */
+
+	if (strcmp(relpath, "bcache") != 0) {
+		fdbg("ERROR: relpath is '%s'\n", relpath);
+		return -ENOENT;
+	}
+
+	/* Allocate a container to hold the file attributes */
+
+	attr = (FAR struct bcache_file_s *)kmm_zalloc(sizeof(struct bcache_file_s));
+	if (!attr) {
+		fdbg("ERROR: Failed to allocate file attributes\n");
+		return -ENOMEM;
+	}
+
+	/* Save the attributes as the open-specific state in filep->f_priv */
+
+	filep->f_priv = (FAR void *)attr;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: bcache_close
+ ****************************************************************************/
+
+static int bcache_close(FAR struct file *filep)
+{
+	FAR struct bcache_file_s *attr;
+
+	/* Recover our private data from the struct file instance */
+
+	attr = (FAR struct bcache_file_s *)filep->f_priv;
+	DEBUGASSERT(attr);
+
+	/* Release the file attributes structure */
+
+	kmm_free(attr);
+	filep->f_priv = NULL;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: bcache_procread
+ ****************************************************************************/
+
+static ssize_t bcache_procread(FAR struct file *filep, FAR char *buffer, size_t buflen)
+{
+	FAR struct bcache_file_s *attr;
+	struct bcache_stats_s stats;
+	uint32_t lookups;
+	off_t offset;
+	ssize_t ret;
+
+	fvdbg("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+	/* Recover our private data from the struct file instance */
+
+	attr = (FAR struct bcache_file_s *)filep->f_priv;
+	DEBUGASSERT(attr);
+
+	/* Take a snapshot on the first read so that the report stays stable if
+	 * the user reads it in pieces.
+	 */
+
+	if (filep->f_pos == 0) {
+		bcache_getstats(&stats);
+		lookups = stats.hits + stats.misses;
+
+		attr->linesize = snprintf(attr->line, BCACHE_REPORTLEN,
+								  "Budget:     %u bytes (%u x %u)\n"
+								  "Used:       %u\n"
+								  "Dirty:      %u\n"
+								  "Hits:       %u\n"
+								  "Misses:     %u\n"
+								  "Hit ratio:  %u%%\n"
+								  "Evictions:  %u\n"
+								  "Writebacks: %u\n"
+								  "Bypasses:   %u\n",
+								  stats.nentries * CONFIG_FS_BCACHE_SECTORSIZE, stats.nentries, CONFIG_FS_BCACHE_SECTORSIZE,
+								  stats.nused, stats.ndirty, stats.hits, stats.misses,
+								  lookups ? (unsigned int)(((uint64_t)stats.hits * 100) / lookups) : 0,
+								  stats.evictions, stats.writebacks, stats.bypasses);
+		if (attr->linesize >= BCACHE_REPORTLEN) {
+			attr->linesize = BCACHE_REPORTLEN - 1;
+		}
+	}
+
+	/* Transfer the report to user receive buffer */
+
+	offset = filep->f_pos;
+	ret = procfs_memcpy(attr->line, attr->linesize, buffer, buflen, &offset);
+
+	/* Update the file offset */
+
+	if (ret > 0) {
+		filep->f_pos += ret;
+	}
+
+	return ret;
+}
+
+/****************************************************************************
+ * Name: bcache_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int bcache_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+	FAR struct bcache_file_s *oldattr;
+	FAR struct bcache_file_s *newattr;
+
+	fvdbg("Dup %p->%p\n", oldp, newp);
+
+	/* Recover our private data from the old struct file instance */
+
+	oldattr = (FAR struct bcache_file_s *)oldp->f_priv;
+	DEBUGASSERT(oldattr);
+
+	/* Allocate a new container to hold the task and attribute selection */
+
+	newattr = (FAR struct bcache_file_s *)kmm_malloc(sizeof(struct bcache_file_s));
+	if (!newattr) {
+		fdbg("ERROR: Failed to allocate file attributes\n");
+		return -ENOMEM;
+	}
+
+	/* The copy the file attributes from the old attributes to the new */
+
+	memcpy(newattr, oldattr, sizeof(struct bcache_file_s));
+
+	/* Save the new attributes in the new file structure */
+
+	newp->f_priv = (FAR void *)newattr;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: bcache_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int bcache_stat(const char *relpath, struct stat *buf)
+{
+	/* "bcache" is the only acceptable value for the relpath */
+
+	if (strcmp(relpath, "bcache") != 0) {
+		fdbg("ERROR: relpath is '%s'\n", relpath);
+		return -ENOENT;
+	}
+
+	/* "bcache" is the name for a read-only file */
+
+	buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+	buf->st_size = 0;
+	buf->st_blksize = 0;
+	buf->st_blocks = 0;
+	return OK;
+}
+
+#endif							/* CONFIG_FS_BCACHE && !CONFIG_FS_PROCFS_EXCLUDE_BCACHE */
+#endif							/* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS */
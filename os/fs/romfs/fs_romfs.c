@@ -76,6 +76,9 @@
 #include <tinyara/kmalloc.h>
 #include <tinyara/fs/fs.h>
 #include <tinyara/fs/ioctl.h>
+#ifdef CONFIG_FS_BCACHE
+#include <tinyara/fs/bcache.h>
+#endif
 #include <tinyara/fs/dirent.h>
 
 #include "fs_romfs.h"
@@ -391,6 +394,17 @@ static ssize_t romfs_read(FAR struct file *filep, FAR char *buffer, size_t bufle
 		buflen = bytesleft;
 	}
 
+	/* If the media is directly accessible, there is no need to go through
+	 * the sector cache.  Copy everything straight from the media.
+	 */
+
+	if (rm->rm_xipbase) {
+		memcpy(userbuffer, rm->rm_xipbase + rf->rf_startoffset + filep->f_pos, buflen);
+		filep->f_pos += buflen;
+		romfs_semgive(rm);
+		return buflen;
+	}
+
 	/* Loop until either (1) all data has been transferred, or (2) an
 	 * error occurs.
 	 */
@@ -1016,6 +1030,11 @@ static int romfs_unbind(FAR void *handle, FAR struct inode **blkdriver)
 		if (rm->rm_blkdriver) {
 			struct inode *inode = rm->rm_blkdriver;
 			if (inode) {
+#ifdef CONFIG_FS_BCACHE
+				/* Drop our sectors from the shared buffer cache */
+
+				(void)bcache_invalidate(inode);
+#endif
 				if (inode->u.i_bops && inode->u.i_bops->close) {
 					(void)inode->u.i_bops->close(inode);
 				}
@@ -71,6 +71,9 @@
 #include <tinyara/kmalloc.h>
 #include <tinyara/fs/ioctl.h>
 #include <tinyara/fs/dirent.h>
+#ifdef CONFIG_FS_BCACHE
+#include <tinyara/fs/bcache.h>
+#endif
 
 #include "fs_romfs.h"
 
@@ -405,7 +408,11 @@ int romfs_hwread(struct romfs_mountpt_s *rm, uint8_t *buffer, uint32_t sector, u
 
 		DEBUGASSERT(inode);
 		if (inode->u.i_bops && inode->u.i_bops->read) {
+#ifdef CONFIG_FS_BCACHE
+			nsectorsread = bcache_read(inode, buffer, sector, nsectors, rm->rm_hwsectorsize);
+#else
 			nsectorsread = inode->u.i_bops->read(inode, buffer, sector, nsectors);
+#endif
 
 			if (nsectorsread == (ssize_t)nsectors) {
 				ret = OK;
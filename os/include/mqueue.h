@@ -165,6 +165,16 @@ ssize_t mq_receive(mqd_t mqdes, FAR char *msg, size_t msglen, FAR int *prio);
  * @since TizenRT v1.0
  */
 ssize_t mq_timedreceive(mqd_t mqdes, FAR char *msg, size_t msglen, FAR int *prio, FAR const struct timespec *abstime);
+/**
+ * @brief receive up to nmsgs messages from a message queue at once
+ * @details @b #include <mqueue.h> \n
+ * SYSTEM CALL API \n
+ * Message i is copied to msgs + i * msglen and its length is stored in
+ * lens[i].  Blocks like mq_receive() until one message is queued, then
+ * returns the number of messages received.
+ * @since TizenRT v4.0
+ */
+ssize_t mq_receive_batch(mqd_t mqdes, FAR char *msgs, size_t msglen, FAR size_t *lens, int nmsgs);
 /**
  * @brief notify process that a message is available
  * @details @b #include <mqueue.h> \n
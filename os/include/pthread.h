@@ -204,6 +204,19 @@
 #define _PTHREAD_MFLAGS_INCONSISTENT  (1 << 1)	/* Mutex is in an inconsistent state */
 #define _PTHREAD_MFLAGS_NRECOVERABLE  (1 << 2)	/* Inconsistent mutex has been unlocked */
 
+/*
+ * Values for struct pthread_mutex_s pid used by the user-space fast path
+ * (CONFIG_PTHREAD_MUTEX_FASTPATH).  getpid() is a system call itself, so an
+ * uncontended lock stores an address on the stack of the owner together
+ * with _PTHREAD_MUTEX_FASTOWNED instead of its pid.  The kernel maps the
+ * address back to the owner and stores the real pid when it takes over the
+ * mutex on contention.
+ */
+#define _PTHREAD_MUTEX_FASTOWNED      0x40000000	/* Locked from user space */
+#define _PTHREAD_MUTEX_FASTOWNER(sp)  (_PTHREAD_MUTEX_FASTOWNED | (int)((uintptr_t)(sp) >> 2))
+#define _PTHREAD_MUTEX_FASTSTACK(pid) ((uintptr_t)((pid) & ~_PTHREAD_MUTEX_FASTOWNED) << 2)
+#define _PTHREAD_MUTEX_HANDOFF        (-2)	/* Being passed to a waiter */
+
 /*
  * Maximum values of pthread key operation
  */
@@ -562,6 +575,25 @@ int pthread_mutex_trylock(FAR pthread_mutex_t *mutex);
  */
 int pthread_mutex_unlock(FAR pthread_mutex_t *mutex);
 
+#if defined(CONFIG_PTHREAD_MUTEX_FASTPATH) && !defined(__KERNEL__) && !defined(__SYSCALL_BUILD__)
+/**
+ * @cond
+ * @internal
+ * User-space lock and unlock which only trap into the kernel when the mutex
+ * is contended.  The standard names are mapped to them for applications.
+ */
+int pthread_mutex_fastlock(FAR pthread_mutex_t *mutex);
+int pthread_mutex_fasttrylock(FAR pthread_mutex_t *mutex);
+int pthread_mutex_fastunlock(FAR pthread_mutex_t *mutex);
+
+#define pthread_mutex_lock(m)         pthread_mutex_fastlock(m)
+#define pthread_mutex_trylock(m)      pthread_mutex_fasttrylock(m)
+#define pthread_mutex_unlock(m)       pthread_mutex_fastunlock(m)
+/**
+ * @endcond
+ */
+#endif
+
 /**
  * @cond
  * @internal
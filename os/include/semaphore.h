@@ -242,6 +242,26 @@ int sem_trywait(FAR sem_t *sem);
  * @since TizenRT v1.0
  */
 int sem_post(FAR sem_t *sem);
+
+#if defined(CONFIG_SEM_FASTPATH) && !defined(__KERNEL__) && !defined(__SYSCALL_BUILD__)
+/**
+ * @cond
+ * @internal
+ * User-space wait and post which only trap into the kernel when a task has
+ * to block or be woken up.  The standard names are mapped to them for
+ * applications.
+ */
+int sem_fastwait(FAR sem_t *sem);
+int sem_fasttrywait(FAR sem_t *sem);
+int sem_fastpost(FAR sem_t *sem);
+
+#define sem_wait(s)                   sem_fastwait(s)
+#define sem_trywait(s)                sem_fasttrywait(s)
+#define sem_post(s)                   sem_fastpost(s)
+/**
+ * @endcond
+ */
+#endif
 /**
  * @ingroup SEMAPHORE_KERNEL
  * @brief get the value of a semaphore
@@ -125,7 +125,10 @@ enum prctl_type_e {
 	PR_REBOOT_REASON_WRITE,
 	PR_REBOOT_REASON_CLEAR,
 	PR_SET_SECURITY_LEVEL,
-	PR_GET_SECURITY_LEVEL
+	PR_GET_SECURITY_LEVEL,
+	PR_MSG_OPEN,
+	PR_MSG_CLOSE,
+	PR_MSG_READ_PORT
 };
 
 /****************************************************************************
@@ -433,7 +433,8 @@
 #define SYS_mq_timedreceive            (__SYS_mqueue + 7)
 #define SYS_mq_timedsend               (__SYS_mqueue + 8)
 #define SYS_mq_unlink                  (__SYS_mqueue + 9)
-#define __SYS_environ                  (__SYS_mqueue + 10)
+#define SYS_mq_receive_batch           (__SYS_mqueue + 10)
+#define __SYS_environ                  (__SYS_mqueue + 11)
 #else
 #define __SYS_environ                  __SYS_mqueue
 #endif
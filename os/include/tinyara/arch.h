@@ -1697,6 +1697,72 @@ int up_timer_cancel(FAR struct timespec *ts);
 int up_timer_start(FAR const struct timespec *ts);
 #endif
 
+/****************************************************************************
+ * Name: up_perf_init, up_perf_gettime and up_perf_getfreq
+ *
+ * Description:
+ *   Free-running cycle counter of the CPU (DWT CYCCNT on ARMv7-M/ARMv8-M,
+ *   CCOUNT on Xtensa) used for fine grained timestamps.
+ *
+ *   up_perf_init() enables the counter.  It is called by the chip-specific
+ *   timer initialization with the counter frequency in Hz passed as arg.
+ *   up_perf_gettime() returns the current 32-bit count, which wraps.
+ *   up_perf_getfreq() returns the frequency given to up_perf_init().
+ *
+ *   The functions may be called from interrupt handlers and must not take
+ *   any lock.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ARCH_HAVE_PERF_EVENTS
+void up_perf_init(FAR void *arg);
+uint32_t up_perf_gettime(void);
+uint32_t up_perf_getfreq(void);
+
+/****************************************************************************
+ * Name: up_perf_callstack
+ *
+ * Description:
+ *   Record the code addresses of the context interrupted by the current
+ *   interrupt into pcs, at most depth of them: the interrupted PC first,
+ *   then the return addresses of its callers, innermost first.  Only
+ *   return addresses which can be found cheaply and safely are reported,
+ *   e.g. by following frame pointers inside of the stack of the task.
+ *   Must only be called from an interrupt handler.
+ *
+ * Returned Value:
+ *   The number of addresses stored in pcs; zero if there is no
+ *   interrupted context.
+ *
+ ****************************************************************************/
+
+int up_perf_callstack(FAR uint32_t *pcs, int depth);
+#endif
+
+/****************************************************************************
+ * Name: up_perf_counters_config and up_perf_counters_read
+ *
+ * Description:
+ *   Hardware event counters used by the perf counter driver (see
+ *   tinyara/perf.h).
+ *
+ *   up_perf_counters_config() programs the counters to count the given
+ *   PERF_EVENT_* events, one counter per event, and stores the mask of the
+ *   valid bits of each counter in masks.  It returns -ENOTSUP if one of
+ *   the events is not implemented and -EBUSY if there are not enough
+ *   counters.
+ *
+ *   up_perf_counters_read() stores the raw, wrapping values of the
+ *   configured counters into values.  It is called with interrupts
+ *   disabled on every context switch and must be cheap.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ARCH_HAVE_PERF_COUNTERS
+int up_perf_counters_config(FAR const uint8_t *events, int nevents, FAR uint32_t *masks);
+void up_perf_counters_read(FAR uint32_t *values, int nevents);
+#endif
+
 /****************************************************************************
  * Name: up_romgetc
  *
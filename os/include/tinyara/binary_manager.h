@@ -114,6 +114,9 @@ enum binmgr_request_msg_type {
 	BINMGR_NOTIFY_STARTED,
 	BINMGR_REGISTER_STATECB,
 	BINMGR_UNREGISTER_STATECB,
+#ifdef CONFIG_ELF_LAZY_LOAD
+	BINMGR_LOAD_SECTION,
+#endif
 #ifdef CONFIG_BINMGR_RECOVERY
 	BINMGR_FAULT,
 #endif
@@ -228,6 +231,7 @@ struct binmgr_request_s {
 		uint8_t type;
 		char bin_name[BIN_NAME_MAX];
 		binmgr_cb_t *cb_info;
+		uintptr_t addr;
 	} data;
 };
 typedef struct binmgr_request_s binmgr_request_t;
@@ -268,6 +272,11 @@ struct binmgr_getinfo_all_response_s {
 };
 typedef struct binmgr_getinfo_all_response_s binmgr_getinfo_all_response_t;
 
+struct binmgr_loadsection_response_s {
+	binmgr_result_type_e result;
+};
+typedef struct binmgr_loadsection_response_s binmgr_loadsection_response_t;
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -23,6 +23,8 @@
  * Included Files
  ****************************************************************************/
 #include <tinyara/compression.h>
+#include <stdbool.h>
+#include <stdint.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -32,10 +34,18 @@
  * Public Types
  ****************************************************************************/
 
-/* Struct for buffers to be used for read/decompression */
+/* Struct for buffers to be used for read/decompression.  Decompressed
+ * blocks are kept in the block cache.
+ */
 struct s_buffer {
 	unsigned char *read_buffer;
-	unsigned char *out_buffer;
+};
+
+/* Decompressed block cache statistics of the binary being loaded */
+struct compress_cache_stats_s {
+	uint32_t hits;				/* Blocks found in the cache */
+	uint32_t misses;			/* Blocks decompressed by the reader */
+	uint32_t prefetched;			/* Blocks decompressed ahead by the worker */
 };
 
 /****************************************************************************
@@ -88,4 +98,29 @@ int compress_read(int filfd, uint16_t binary_header_size, FAR uint8_t *buffer, s
  ****************************************************************************/
 struct s_header *get_compression_header(void);
 
+/****************************************************************************
+ * Name: compress_set_cache
+ *
+ * Description:
+ *   Enable or disable the decompressed block cache and prefetching.  When
+ *   disabled, every block is decompressed again each time it is read.  The
+ *   cache is enabled by default.
+ *
+ * Returned Value:
+ *   None
+ ****************************************************************************/
+void compress_set_cache(bool enable);
+
+/****************************************************************************
+ * Name: compress_get_cachestats
+ *
+ * Description:
+ *   Return the decompressed block cache statistics.  They are reset by
+ *   compress_init.
+ *
+ * Returned Value:
+ *   None
+ ****************************************************************************/
+void compress_get_cachestats(FAR struct compress_cache_stats_s *stats);
+
 #endif							/* __INCLUDE_COMPRESS_READ_H */
@@ -108,6 +108,8 @@
  * of an ELF binary.
  */
 
+struct elf_lazy_s;
+
 struct elf_loadinfo_s {
 	int filfd;				/* Descriptor for the file being loaded */
 	off_t filelen;				/* Length of the entire ELF file */
@@ -133,6 +135,10 @@ struct elf_loadinfo_s {
 	struct binary_s *binp;			/* Back pointer to binary object */
 
 	bool cached_read;			/* Whether to use caching while loading */
+
+#ifdef CONFIG_ELF_LAZY_LOAD
+	FAR struct elf_lazy_s *lazy;		/* Sections deferred while loading */
+#endif
 };
 
 #ifdef CONFIG_APP_BINARY_SEPARATION
@@ -291,6 +297,34 @@ void *elf_find_text_section_addr(int bin_idx);
 void elf_show_all_bin_section_addr(void);
 #endif
 
+#ifdef CONFIG_ELF_LAZY_LOAD
+/****************************************************************************
+ * Name: elf_lazy_load
+ *
+ * Description:
+ *   Read, decompress and relocate the deferred section of binary 'bin_idx'
+ *   that contains the address 'addr'.
+ *
+ * Returned Value:
+ *   0 (OK) is returned on success and a negated errno is returned on
+ *   failure.  -ENOENT means 'addr' is not in a deferred section.
+ *
+ ****************************************************************************/
+
+int elf_lazy_load(int bin_idx, uintptr_t addr);
+
+/****************************************************************************
+ * Name: elf_lazy_release
+ *
+ * Description:
+ *   Release the deferred section information of binary 'bin_idx'.  Called
+ *   when the binary is unloaded.
+ *
+ ****************************************************************************/
+
+void elf_lazy_release(int bin_idx);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
@@ -24,11 +24,50 @@
  ****************************************************************************/
 #include <tinyara/config.h>
 
+#include <stdint.h>
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
 #define CPULOAD_DRVPATH     "/dev/cpuload"
 
+#ifdef CONFIG_SCHED_PROFILER
+#define CPULOAD_PROFILE_DEPTH   CONFIG_SCHED_PROFILER_DEPTH
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* Argument of CPULOADIOC_PROFSTART */
+
+struct cpuload_profile_s {
+	uint32_t nsamples;			/* Number of samples kept by the session */
+	uint16_t period;			/* Sampling period in cpuload ticks */
+};
+
+/* One sample: the interrupted PC in pc[0] followed by the return
+ * addresses of its callers, innermost first.
+ */
+
+struct cpuload_sample_s {
+	int16_t pid;				/* Task which was interrupted */
+	uint8_t depth;				/* Number of valid entries in pc */
+	uint8_t reserved;
+	uint32_t pc[CPULOAD_PROFILE_DEPTH];
+};
+
+/* Argument of CPULOADIOC_PROFREAD.  pos is the index of the first sample
+ * to copy and is advanced by the number of samples copied.
+ */
+
+struct cpuload_profread_s {
+	uint32_t pos;				/* In/out: index of the next sample */
+	uint32_t dropped;			/* Out: samples lost because the session was full */
+	FAR struct cpuload_sample_s *samples;
+	uint16_t nsamples;			/* Capacity of samples */
+};
+#endif
+
 void cpuload_initialize(void);
 
 #ifdef __cplusplus
@@ -0,0 +1,157 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_TINYARA_FS_BCACHE_H
+#define __INCLUDE_TINYARA_FS_BCACHE_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+
+#ifdef CONFIG_FS_BCACHE
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* Buffer cache statistics, reported through /proc/bcache */
+
+struct bcache_stats_s {
+	uint32_t nentries;			/* Number of cache entries (RAM budget / sector size) */
+	uint32_t nused;				/* Number of entries holding a sector */
+	uint32_t ndirty;			/* Number of entries not yet written to the media */
+	uint32_t hits;				/* Sector reads satisfied from the cache */
+	uint32_t misses;			/* Sector reads that had to go to the media */
+	uint32_t evictions;			/* Entries reclaimed by the replacement policy */
+	uint32_t writebacks;		/* Dirty sectors written to the media */
+	uint32_t bypasses;			/* Sectors too large to be cached */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C" {
+#else
+#define EXTERN extern
+#endif
+
+struct inode;
+
+/****************************************************************************
+ * Name: bcache_initialize
+ *
+ * Description:
+ *   Allocate the cache entries and the sector pool.  Called once from
+ *   fs_initialize().
+ *
+ ****************************************************************************/
+
+void bcache_initialize(void);
+
+/****************************************************************************
+ * Name: bcache_read
+ *
+ * Description:
+ *   Read sectors from the block driver 'inode' through the shared cache.
+ *   Sectors larger than CONFIG_FS_BCACHE_SECTORSIZE are read directly from
+ *   the driver.
+ *
+ * Returned Value:
+ *   The number of sectors read on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+ssize_t bcache_read(FAR struct inode *inode, FAR unsigned char *buffer, size_t start_sector, unsigned int nsectors, uint16_t sectsize);
+
+/****************************************************************************
+ * Name: bcache_write
+ *
+ * Description:
+ *   Write sectors to the block driver 'inode' through the shared cache.  The
+ *   data is kept dirty in the cache until bcache_sync() is called, the entry
+ *   is evicted, or too many entries become dirty.
+ *
+ * Returned Value:
+ *   The number of sectors written on success; a negated errno value on
+ *   failure.
+ *
+ ****************************************************************************/
+
+ssize_t bcache_write(FAR struct inode *inode, FAR const unsigned char *buffer, size_t start_sector, unsigned int nsectors, uint16_t sectsize);
+
+/****************************************************************************
+ * Name: bcache_sync
+ *
+ * Description:
+ *   Write all dirty sectors of 'inode' to the media.  If 'inode' is NULL,
+ *   dirty sectors of all devices are written.
+ *
+ ****************************************************************************/
+
+int bcache_sync(FAR struct inode *inode);
+
+/****************************************************************************
+ * Name: bcache_invalidate
+ *
+ * Description:
+ *   Write back and then drop all cached sectors of 'inode'.  Must be called
+ *   before a block driver that used the cache is closed.
+ *
+ ****************************************************************************/
+
+int bcache_invalidate(FAR struct inode *inode);
+
+/****************************************************************************
+ * Name: bcache_discard
+ *
+ * Description:
+ *   Drop the cached copies of 'nsectors' sectors of 'inode' starting at
+ *   'start_sector' without writing them back.  Anyone who writes a block
+ *   driver directly, bypassing the cache, must call this after the write so
+ *   that other users of the driver do not keep reading stale sectors.
+ *
+ ****************************************************************************/
+
+void bcache_discard(FAR struct inode *inode, size_t start_sector, unsigned int nsectors);
+
+/****************************************************************************
+ * Name: bcache_getstats
+ *
+ * Description:
+ *   Return a snapshot of the cache statistics.
+ *
+ ****************************************************************************/
+
+void bcache_getstats(FAR struct bcache_stats_s *stats);
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+
+#endif							/* CONFIG_FS_BCACHE */
+#endif							/* __INCLUDE_TINYARA_FS_BCACHE_H */
@@ -101,6 +101,7 @@
 #define _IOTBUSBASE     (0x2600)	/* iotbus ioctl commands */
 #define _FBIOCBASE      (0x2700)	/* Frame buffer character driver ioctl commands */
 #define _CPULOADBASE    (0x2800)	/* cpuload ioctl commands */
+#define _PERFBASE       (0x2900)	/* perf counter ioctl commands */
 #define _TESTIOCBASE    (0xfe00)	/* KERNEL TEST DRV module ioctl commands */
 
 
@@ -256,6 +257,11 @@
 										 *		to reveal physical sector.
 										 * OUT: Physical sector number align with
 										 *		logical sector number */
+#define BIOC_FLUSH      _BIOC(0x000E)	/* Write back sectors held dirty in the
+										 * block buffer cache.
+										 * IN:  None
+										 * OUT: None (ioctl return value provides
+										 *      success/failure indication). */
 #define BIOC_DEBUGCMD   _BIOC(0x00FF)	/* Send driver specific debug command /
 										 * data to the block device.
 										 * IN:  Pointer to a struct defined for
@@ -441,6 +447,20 @@
 #define CPULOADIOC_START              _CPULOADIOC(0x0001)
 #define CPULOADIOC_STOP               _CPULOADIOC(0x0002)
 #define CPULOADIOC_GETVALUE           _CPULOADIOC(0x0003)
+#define CPULOADIOC_PROFSTART          _CPULOADIOC(0x0004)
+#define CPULOADIOC_PROFSTOP           _CPULOADIOC(0x0005)
+#define CPULOADIOC_PROFREAD           _CPULOADIOC(0x0006)
+#define CPULOADIOC_PROFRELEASE        _CPULOADIOC(0x0007)
+
+/* Perf counter driver ioctl definitions *******************/
+/* (see tinyara/perf.h) */
+
+#define _PERFIOCVALID(c)      (_IOC_TYPE(c) == _PERFBASE)
+#define _PERFIOC(nr)          _IOC(_PERFBASE, nr)
+
+#define PERFIOC_CONFIG                _PERFIOC(0x0001)
+#define PERFIOC_READ                  _PERFIOC(0x0002)
+#define PERFIOC_RESET                 _PERFIOC(0x0003)
 
 /* Audio driver ioctl definitions *************************************/
 /* (see tinyara/audio/audio.h) */
@@ -0,0 +1,140 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_TINYARA_IRQLATENCY_H
+#define __INCLUDE_TINYARA_IRQLATENCY_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+
+/* The architecture irq.h includes this header at its end, after its own
+ * irqsave() and irqrestore() are defined.
+ */
+
+#include <arch/irq.h>
+
+#if defined(CONFIG_IRQ_LATENCY) && (defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__))
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Every critical section of the kernel is timed: irqsave() and irqrestore()
+ * are routed through the monitor, which records the duration of the
+ * outermost section against the code address which called irqsave().
+ */
+
+#define irqsave()                   irqlatency_save()
+#define irqrestore(f)               irqlatency_restore(f)
+
+/* Histogram buckets: below 1us, below 2us, ... below 1024us and above */
+
+#define IRQLATENCY_NBUCKETS         12
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C" {
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: irqlatency_save and irqlatency_restore
+ *
+ * Description:
+ *   Instrumented irqsave() and irqrestore().  A section starts when
+ *   irqsave() is called with interrupts enabled, and ends when the flags
+ *   returned then are restored.
+ *
+ ****************************************************************************/
+
+irqstate_t irqlatency_save(void);
+void irqlatency_restore(irqstate_t flags);
+
+/****************************************************************************
+ * Name: irqlatency_preempt_off and irqlatency_preempt_on
+ *
+ * Description:
+ *   Time sections with preemption disabled.  Called by sched_lock() when
+ *   the lock count becomes non-zero, with the caller of sched_lock() as
+ *   site, and by sched_unlock() when it drops back to zero.
+ *
+ ****************************************************************************/
+
+void irqlatency_preempt_off(FAR void *site);
+void irqlatency_preempt_on(void);
+
+/****************************************************************************
+ * Name: irqlatency_switch
+ *
+ * Description:
+ *   Called on every context switch.  A task which blocks inside of a
+ *   critical section leaves it when the next task runs, so any open
+ *   section ends here.
+ *
+ ****************************************************************************/
+
+void irqlatency_switch(void);
+
+/****************************************************************************
+ * Name: irqlatency_entry and irqlatency_dispatch
+ *
+ * Description:
+ *   irqlatency_entry() is called by the architecture as early as possible
+ *   on interrupt entry.  irq_dispatch() calls irqlatency_dispatch() right
+ *   before the handler, which records the time since the entry as the
+ *   latency of the irq.
+ *
+ ****************************************************************************/
+
+void irqlatency_entry(void);
+void irqlatency_dispatch(int irq);
+
+/****************************************************************************
+ * Name: irqlatency_reset
+ *
+ * Description:
+ *   Clear all statistics.
+ *
+ ****************************************************************************/
+
+void irqlatency_reset(void);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#else							/* CONFIG_IRQ_LATENCY && (CONFIG_BUILD_FLAT || __KERNEL__) */
+#define irqlatency_preempt_off(site)
+#define irqlatency_preempt_on()
+#define irqlatency_switch()
+#define irqlatency_entry()
+#define irqlatency_dispatch(irq)
+#endif							/* CONFIG_IRQ_LATENCY && (CONFIG_BUILD_FLAT || __KERNEL__) */
+
+#endif							/* __INCLUDE_TINYARA_IRQLATENCY_H */
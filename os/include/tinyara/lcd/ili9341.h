@@ -238,6 +238,8 @@ struct ili9341_lcd_s {
 	 *                backlight level of the connected LED driver.
 	 *                The implementation in detail is part of the platform
 	 *                specific sub driver.
+	 *  - waitte      Wait for the rising edge of the tearing effect line
+	 *                (optional). NULL if the line is not connected.
 	 *
 	 */
 
@@ -251,6 +253,9 @@ struct ili9341_lcd_s {
 	int (*sendgram)(FAR struct ili9341_lcd_s *lcd,
 					const uint16_t *wd, uint32_t nwords);
 	int (*backlight)(FAR struct ili9341_lcd_s *lcd, int level);
+#ifdef CONFIG_LCD_TEARING_EFFECT
+	int (*waitte)(FAR struct ili9341_lcd_s *lcd);
+#endif
 
 	/* mcu interface specific data following */
 };
@@ -196,6 +196,15 @@ struct lcd_dev_s {
 	/* Set LCD panel contrast (0-CONFIG_LCD_MAXCONTRAST) */
 
 	int (*setcontrast)(struct lcd_dev_s *dev, unsigned int contrast);
+
+#ifdef CONFIG_LCD_TEARING_EFFECT
+	/* Wait for the start of the next vertical blanking period, signaled by
+	 * the tearing effect line of the panel.  Returns -ENOSYS if the panel has
+	 * no tearing effect line.
+	 */
+
+	int (*waitvsync)(struct lcd_dev_s *dev);
+#endif
 };
 
 struct dsi_ops_s {
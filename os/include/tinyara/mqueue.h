@@ -82,6 +82,8 @@
 
 struct mq_des;					/* forward reference */
 
+struct mq_prioindex_s;			/* Forward reference */
+
 struct mqueue_inode_s {
 	FAR struct inode *inode;	/* Containing inode */
 	sq_queue_t msglist;			/* Prioritized message list */
@@ -90,6 +92,13 @@ struct mqueue_inode_s {
 	int16_t nwaitnotfull;		/* Number tasks waiting for not full */
 	int16_t nwaitnotempty;		/* Number tasks waiting for not empty */
 	size_t maxmsgsize;			/* Max size of message in message queue */
+#ifdef CONFIG_MQ_PERQUEUE_SLAB
+	sq_queue_t msgfree;			/* Free messages of the slab of this queue */
+	FAR void *slab;				/* Messages preallocated when the queue was created */
+#endif
+#ifdef CONFIG_MQ_PRIO_INDEX
+	FAR struct mq_prioindex_s *prioidx;	/* Last message of each priority in msglist */
+#endif
 #ifndef CONFIG_DISABLE_SIGNALS
 	FAR struct mq_des *ntmqdes;	/* Notification: Owning mqdes (NULL if none) */
 	pid_t ntpid;				/* Notification: Receiving Task's PID */
@@ -28,6 +28,8 @@
  ****************************************************************************/
 
 #include <tinyara/config.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <tinyara/fs/ioctl.h>
 
 #ifdef CONFIG_DRIVERS_OS_API_TEST
@@ -87,9 +89,28 @@
 #if defined(CONFIG_AUTOMOUNT_USERFS) && defined(CONFIG_EXAMPLES_TESTCASE_FILESYSTEM)
 #define TESTIOC_GET_FS_PARTNO			_TESTIOC(24)
 #endif
+#define TESTIOC_COMPRESSION_LOAD_PERF		_TESTIOC(25)
 
 #define OS_API_TEST_DRVPATH	"/dev/os_api_test"
 
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* TESTIOC_COMPRESSION_LOAD_PERF argument: loads a compressed ELF binary
+ * once and reports the time taken and the block cache statistics.
+ */
+
+struct compress_loadperf_s {
+	FAR const char *path;		/* Compressed binary to load */
+	uint16_t offset;		/* Size of the binary header preceding it */
+	bool cache;			/* Load with the decompressed block cache enabled */
+	uint32_t usec;			/* Returned: load time */
+	uint32_t hits;			/* Returned: blocks found in the cache */
+	uint32_t misses;		/* Returned: blocks decompressed by the loader */
+	uint32_t prefetched;		/* Returned: blocks decompressed ahead of the loader */
+};
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -0,0 +1,139 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_TINYARA_PERF_H
+#define __INCLUDE_TINYARA_PERF_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#ifdef CONFIG_PERF_COUNTERS
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define PERF_DRVPATH                "/dev/perf"
+
+/* Number of events which can be counted at the same time */
+
+#define PERF_MAX_COUNTERS           CONFIG_PERF_NCOUNTERS
+
+/* Special pid values of PERFIOC_READ and PERFIOC_RESET */
+
+#define PERF_PID_SELF               0		/* The calling task */
+#define PERF_PID_ALL                (-1)	/* All tasks together */
+
+/* Events.  Which of them can be counted depends on the CPU: the ARMv7-A/R
+ * PMU counts the architectural events, the ARMv7-M/ARMv8-M DWT the cycle
+ * based profiling counters.  Counting an event which is not implemented
+ * fails with -ENOTSUP.
+ */
+
+#define PERF_EVENT_CYCLES           0		/* CPU cycles */
+#define PERF_EVENT_INSTRUCTIONS     1		/* Instructions executed (PMU) */
+#define PERF_EVENT_CACHE_REFS       2		/* L1 data cache accesses (PMU) */
+#define PERF_EVENT_CACHE_MISSES     3		/* L1 data cache refills (PMU) */
+#define PERF_EVENT_ICACHE_MISSES    4		/* L1 instruction cache refills (PMU) */
+#define PERF_EVENT_BRANCH_MISSES    5		/* Mispredicted branches (PMU) */
+#define PERF_EVENT_EXCEPTIONS       6		/* Exceptions taken (PMU) */
+#define PERF_EVENT_STALL_CYCLES     7		/* Extra cycles of multi-cycle instructions and stalls (DWT CPICNT) */
+#define PERF_EVENT_LSU_CYCLES       8		/* Extra cycles of loads and stores (DWT LSUCNT) */
+#define PERF_EVENT_EXC_CYCLES       9		/* Exception entry and exit overhead cycles (DWT EXCCNT) */
+#define PERF_EVENT_SLEEP_CYCLES     10		/* Cycles spent sleeping (DWT SLEEPCNT) */
+#define PERF_EVENT_FOLDED           11		/* Folded instructions (DWT FOLDCNT) */
+#define PERF_EVENT_MAX              12
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* Argument of PERFIOC_CONFIG: the events to count from now on.  The counts
+ * of all tasks are reset.  Zero events stops counting.
+ */
+
+struct perf_config_s {
+	uint8_t nevents;
+	uint8_t events[PERF_MAX_COUNTERS];
+};
+
+/* Argument of PERFIOC_READ.  pid is set by the caller, the rest is filled
+ * in with the configured events and the counts of the task, including the
+ * current time slice if it is running.
+ */
+
+struct perf_read_s {
+	pid_t pid;
+	uint8_t nevents;
+	uint8_t events[PERF_MAX_COUNTERS];
+	uint64_t counts[PERF_MAX_COUNTERS];
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+struct tcb_s;
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C" {
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: perf_update
+ *
+ * Description:
+ *   Charge the events counted since the last update to the task which was
+ *   running, and account them to tcb from now on.  Called with interrupts
+ *   disabled on every context switch and on every system tick.
+ *
+ ****************************************************************************/
+
+void perf_update(FAR struct tcb_s *tcb);
+
+/****************************************************************************
+ * Name: perf_initialize
+ *
+ * Description:
+ *   Register the perf counter driver at PERF_DRVPATH.
+ *
+ ****************************************************************************/
+
+void perf_initialize(void);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+#endif							/* CONFIG_BUILD_FLAT || __KERNEL__ */
+
+#else							/* CONFIG_PERF_COUNTERS */
+#define perf_update(tcb)
+#endif							/* CONFIG_PERF_COUNTERS */
+
+#endif							/* __INCLUDE_TINYARA_PERF_H */
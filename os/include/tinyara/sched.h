@@ -670,6 +670,9 @@ struct tcb_s {
 #ifdef CONFIG_TASK_MONITOR
 	bool is_active;
 #endif
+#ifdef CONFIG_PERF_COUNTERS
+	uint64_t perf_counts[CONFIG_PERF_NCOUNTERS];	/* Counted events while running, see tinyara/perf.h */
+#endif
 
 	int fin_data;			/* Irq notification Data to be handled */
 	int pending_fin_data;		/* Pended irq notification data */
@@ -885,6 +888,16 @@ void sched_clear_cpuload_snapshot(void);
 void sched_get_cpuload_snapshot(pid_t *result_addr);
 #endif
 
+#ifdef CONFIG_SCHED_PROFILER
+struct cpuload_profile_s;
+struct cpuload_profread_s;
+
+int sched_start_profile(FAR const struct cpuload_profile_s *cfg);
+void sched_stop_profile(void);
+int sched_read_profile(FAR struct cpuload_profread_s *req);
+void sched_clear_profile(void);
+#endif
+
 /********************************************************************************
  * Name: task_starthook
  *
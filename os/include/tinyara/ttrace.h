@@ -56,6 +56,9 @@
 #define TTRACE_BUFFER              'b'
 #define TTRACE_DUMP                'd'
 #define TTRACE_PRINT               'p'
+#define TTRACE_KSTART              'k'
+#define TTRACE_KINFO               'q'
+#define TTRACE_KREAD               'r'
 
 #define TTRACE_CODE_VARIABLE        0
 #define TTRACE_CODE_UNIQUE         (1 << 7)
@@ -76,6 +79,24 @@
 #define TTRACE_TAG_TASK            (1 << 3)
 #define TTRACE_TAG_IPC             (1 << 4)
 
+/* Categories of the kernel events, selected with TTRACE_KSTART */
+
+#define TTRACE_KTAG_SCHED          (1 << 0)
+#define TTRACE_KTAG_IRQ            (1 << 1)
+#define TTRACE_KTAG_SEM            (1 << 2)
+#define TTRACE_KTAG_HEAP           (1 << 3)
+#define TTRACE_KTAG_ALL            0x0f
+
+/* Kernel event types.  pid is the running task unless noted otherwise */
+
+#define TTRACE_KEVENT_SWITCH        1   /* pid: next task, arg0: its priority, arg1: previous pid */
+#define TTRACE_KEVENT_IRQENTER      2   /* arg0: irq number, arg1: handler */
+#define TTRACE_KEVENT_IRQEXIT       3   /* arg0: irq number */
+#define TTRACE_KEVENT_SEMBLOCK      4   /* arg0: semaphore */
+#define TTRACE_KEVENT_SEMWAKE       5   /* arg0: semaphore, arg1: pid of the woken task */
+#define TTRACE_KEVENT_MALLOC        6   /* arg0: address, arg1: size */
+#define TTRACE_KEVENT_FREE          7   /* arg0: address */
+
 /****************************************************************************
  * Public Variables
  ****************************************************************************/
@@ -103,9 +124,35 @@ struct trace_packet {        // total 44 byte(message), 12byte(uid)
 	union trace_message msg;   // 32B
 };
 
+struct trace_kevent {        // total 20B
+	uint32_t seq;              // 4B, sequence number + 1, zero while it is written
+	uint32_t timestamp;        // 4B, cycle counter or system tick, wraps
+	int16_t pid;               // 2B
+	uint8_t type;              // 1B, TTRACE_KEVENT_*
+	uint8_t cpu;               // 1B
+	uint32_t arg0;             // 4B
+	uint32_t arg1;             // 4B
+};
+
+struct trace_kinfo {
+	uint32_t freq;             // Frequency of the timestamps in Hz
+	uint32_t nevents;          // Capacity of the kernel event ring
+	uint32_t head;             // Events recorded since TTRACE_KSTART
+	uint32_t tags;             // Enabled TTRACE_KTAG_* categories
+};
+
+struct trace_kread {
+	uint32_t pos;              // in: first sequence number to read, out: next one
+	uint32_t lost;             // out: events overwritten before they were read
+	FAR struct trace_kevent *events;
+	uint16_t nevents;          // Capacity of events
+};
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
+struct tcb_s;
+
 #if defined(__cplusplus)
 extern "C" {
 #endif
@@ -174,6 +221,53 @@ int trace_sched(struct tcb_s *prev, struct tcb_s *next);
 #endif
 
 #endif /* CONFIG_TTRACE */
+
+/****************************************************************************
+ * Kernel Tracepoints
+ *
+ * Kernel events are written straight into a lock-free ring of fixed size
+ * records without going through /dev/ttrace.  A disabled tracepoint costs
+ * a load and a branch.
+ ****************************************************************************/
+#if defined(CONFIG_TTRACE_KERNEL) && (defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__))
+extern volatile uint32_t g_ttrace_ktags;
+
+void ttrace_kevent(uint8_t type, uint32_t arg0, uint32_t arg1);
+void ttrace_kswitch(FAR struct tcb_s *tcb);
+int ttrace_kstart(uint32_t tags);
+int ttrace_kinfo(FAR struct trace_kinfo *info);
+int ttrace_kread(FAR struct trace_kread *req);
+
+#define TTRACE_KPOINT(tag, type, arg0, arg1) \
+	do { \
+		if ((g_ttrace_ktags & (tag)) != 0) { \
+			ttrace_kevent((type), (uint32_t)(uintptr_t)(arg0), (uint32_t)(uintptr_t)(arg1)); \
+		} \
+	} while (0)
+
+#define ttrace_switch(tcb) \
+	do { \
+		if ((g_ttrace_ktags & TTRACE_KTAG_SCHED) != 0) { \
+			ttrace_kswitch(tcb); \
+		} \
+	} while (0)
+
+#define ttrace_irq_enter(irq, handler) TTRACE_KPOINT(TTRACE_KTAG_IRQ, TTRACE_KEVENT_IRQENTER, irq, handler)
+#define ttrace_irq_exit(irq)           TTRACE_KPOINT(TTRACE_KTAG_IRQ, TTRACE_KEVENT_IRQEXIT, irq, 0)
+#define ttrace_sem_block(sem)          TTRACE_KPOINT(TTRACE_KTAG_SEM, TTRACE_KEVENT_SEMBLOCK, sem, 0)
+#define ttrace_sem_wake(sem, tcb)      TTRACE_KPOINT(TTRACE_KTAG_SEM, TTRACE_KEVENT_SEMWAKE, sem, (tcb)->pid)
+#define ttrace_malloc(mem, size)       TTRACE_KPOINT(TTRACE_KTAG_HEAP, TTRACE_KEVENT_MALLOC, mem, size)
+#define ttrace_free(mem)               TTRACE_KPOINT(TTRACE_KTAG_HEAP, TTRACE_KEVENT_FREE, mem, 0)
+#else
+#define ttrace_switch(tcb)
+#define ttrace_irq_enter(irq, handler)
+#define ttrace_irq_exit(irq)
+#define ttrace_sem_block(sem)
+#define ttrace_sem_wake(sem, tcb)
+#define ttrace_malloc(mem, size)
+#define ttrace_free(mem)
+#endif /* CONFIG_TTRACE_KERNEL && (CONFIG_BUILD_FLAT || __KERNEL__) */
+
 #endif /* __INCLUDE_TINYARA_TTRACE_INTERNAL_H */
 /**
  * @}
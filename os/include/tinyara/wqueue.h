@@ -98,6 +98,13 @@
  *   priority worker thread.  Default: 50
  * CONFIG_SCHED_LPWORKPRIOMAX - The maximum execution priority of the lower
  *   priority worker thread.  Default: 176
+ * CONFIG_SCHED_LPNTHREADS_MIN - The number of threads in the low-priority
+ *   queue's thread pool which are started at boot.  More threads, up to
+ *   CONFIG_SCHED_LPNTHREADS, are started when all of them are busy.
+ *   Default: CONFIG_SCHED_LPNTHREADS
+ * CONFIG_SCHED_LPWORKIDLETIMEOUT - The time in milliseconds after which an
+ *   idle low-priority worker thread above CONFIG_SCHED_LPNTHREADS_MIN
+ *   exits.  Default: 1000
  *
  * The user-mode work queue is only available in the protected or kernel
  * builds.  This those configurations, the user-mode work queue provides the
@@ -203,6 +210,18 @@
 #define CONFIG_SCHED_LPWORKSTACKSIZE CONFIG_IDLETHREAD_STACKSIZE
 #endif
 
+#ifndef CONFIG_SCHED_LPNTHREADS_MIN
+#define CONFIG_SCHED_LPNTHREADS_MIN CONFIG_SCHED_LPNTHREADS
+#endif
+
+#if CONFIG_SCHED_LPNTHREADS_MIN < 1 || CONFIG_SCHED_LPNTHREADS_MIN > CONFIG_SCHED_LPNTHREADS
+#error CONFIG_SCHED_LPNTHREADS_MIN must be between 1 and CONFIG_SCHED_LPNTHREADS
+#endif
+
+#ifndef CONFIG_SCHED_LPWORKIDLETIMEOUT
+#define CONFIG_SCHED_LPWORKIDLETIMEOUT 1000
+#endif
+
 #ifdef CONFIG_WORK_HPWORK
 /* The high priority worker thread should be higher priority than the low
  * priority worker thread.
@@ -266,6 +285,17 @@
 
 #endif							/* CONFIG_SCHED_USRWORK && !__KERNEL__ */
 
+/* Work priorities.  Among the work which is ready to run, the work with the
+ * highest priority is performed first.  Work of the same priority is
+ * performed in the order of the deadlines (queue time plus delay).
+ */
+
+#ifdef CONFIG_SCHED_WORKPRIORITY
+#define WORK_PRIORITY_MIN      0
+#define WORK_PRIORITY_DEFAULT  128
+#define WORK_PRIORITY_MAX      255
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -287,8 +317,30 @@ struct work_s {
 	FAR void *arg;				/* Callback argument */
 	clock_t qtime;			/* Time work queued */
 	clock_t delay;			/* Delay until work performed */
+#ifdef CONFIG_SCHED_WORKPRIORITY
+	uint8_t priority;			/* Priority among the ready work */
+#endif
 };
 
+/* Statistics of one work queue.  Times are in clock ticks.  The wait time
+ * is measured from the deadline of the work to the start of the worker.
+ */
+
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+struct work_stats_s {
+	uint16_t depth;				/* Number of queued work items */
+	uint16_t maxdepth;			/* Largest number of queued work items */
+	uint8_t nworkers;			/* Number of running worker threads */
+	uint8_t maxworkers;			/* Largest number of worker threads */
+	uint32_t nqueued;			/* Number of work items queued */
+	uint32_t nexecuted;			/* Number of work items performed */
+	clock_t waittotal;			/* Sum of the wait times */
+	clock_t waitmax;			/* Longest wait time */
+	clock_t exectotal;			/* Sum of the execution times */
+	clock_t execmax;			/* Longest execution time */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -392,6 +444,32 @@ int work_lpstart(void);
 
 int work_queue(int qid, FAR struct work_s *work, worker_t worker, FAR void *arg, clock_t delay);
 
+/****************************************************************************
+ * Name: work_queue_pri
+ *
+ * Description:
+ *   Queue work like work_queue() with an explicit priority.  When several
+ *   items are ready at the same time, the one with the highest priority is
+ *   performed first.  work_queue() uses WORK_PRIORITY_DEFAULT.
+ *
+ * Input parameters:
+ *   qid      - The work queue ID
+ *   work     - The work structure to queue
+ *   worker   - The worker callback to be invoked
+ *   arg      - The argument that will be passed to the worker callback
+ *   delay    - Delay (in clock ticks) from the time queue until the worker
+ *              is invoked. Zero means to perform the work immediately.
+ *   priority - WORK_PRIORITY_MIN .. WORK_PRIORITY_MAX
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKPRIORITY
+int work_queue_pri(int qid, FAR struct work_s *work, worker_t worker, FAR void *arg, clock_t delay, uint8_t priority);
+#endif
+
 /****************************************************************************
  * Name: work_cancel
  *
@@ -449,6 +527,25 @@ int work_signal(int qid);
 
 #define work_available(work) ((work)->worker == NULL)
 
+/****************************************************************************
+ * Name: work_getstats
+ *
+ * Description:
+ *   Return a snapshot of the statistics of a kernel work queue.
+ *
+ * Input parameters:
+ *   qid   - The work queue ID
+ *   stats - Location to return the statistics
+ *
+ * Returned Value:
+ *   Zero on success, -EINVAL if there is no such work queue
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_SCHED_WORKQUEUE_STATS) && (!defined(CONFIG_BUILD_PROTECTED) || defined(__KERNEL__))
+int work_getstats(int qid, FAR struct work_stats_s *stats);
+#endif
+
 /****************************************************************************
  * Name: lpwork_boostpriority
  *
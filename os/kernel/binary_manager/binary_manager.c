@@ -233,6 +233,11 @@ int binary_manager(int argc, char *argv[])
 		case BINMGR_UNREGISTER_STATECB:
 			binary_manager_unregister_statecb(request_msg.requester_pid);
 			break;
+#ifdef CONFIG_ELF_LAZY_LOAD
+		case BINMGR_LOAD_SECTION:
+			binary_manager_load_section_with_addr(request_msg.requester_pid, request_msg.data.addr);
+			break;
+#endif
 #endif
 		default:
 			bmvdbg("Invalid cmd = %d\n", request_msg.cmd);
@@ -267,6 +267,9 @@ void binary_manager_clear_bin_statecb(int bin_idx);
 int binary_manager_send_statecb_msg(int recv_binidx, char *bin_name, uint8_t state, bool need_response);
 void binary_manager_notify_state_changed(int bin_idx, uint8_t state);
 int binary_manager_execute_loader(int cmd, int bin_idx);
+#ifdef CONFIG_ELF_LAZY_LOAD
+void binary_manager_load_section_with_addr(int requester_pid, uintptr_t addr);
+#endif
 uint32_t binary_manager_get_ucount(void);
 uint32_t binary_manager_get_kcount(void);
 binmgr_kinfo_t *binary_manager_get_kdata(void);
@@ -275,6 +278,7 @@ void binary_manager_get_info_all(int request_pid);
 void binary_manager_get_state_with_name(int request_pid, char *bin_name);
 void binary_manager_send_response(char *q_name, void *response_msg, int msg_size);
 int binary_manager_read_header(int type, char *devpath, void *header_data, bool crc_check);
+int binary_manager_read_header_bufsize(int type, char *devpath, void *header_data, uint32_t max_bufsize);
 int binary_manager_create_entry(int requester_pid, char *bin_name, int version);
 void binary_manager_release_binary_sem(int bin_idx);
 void binary_manager_update_running_state(int bin_id);
@@ -21,6 +21,7 @@
  ****************************************************************************/
 #include <tinyara/config.h>
 #include <stdio.h>
+#include <assert.h>
 #include <debug.h>
 #include <stdlib.h>
 #include <errno.h>
@@ -41,9 +42,17 @@
 #include <tinyara/sched.h>
 #include <tinyara/init.h>
 #include <tinyara/kthread.h>
+#include <tinyara/kmalloc.h>
+#include <tinyara/semaphore.h>
+#ifdef CONFIG_BINMGR_LOADING_TIME
+#include <tinyara/clock.h>
+#endif
 #ifdef CONFIG_OPTIMIZE_APP_RELOAD_TIME
 #include <tinyara/binfmt/binfmt.h>
 #endif
+#ifdef CONFIG_ELF_LAZY_LOAD
+#include <tinyara/binfmt/elf.h>
+#endif
 #ifdef CONFIG_BINMGR_RELOAD_REBOOT
 #include <tinyara/reboot_reason.h>
 #endif
@@ -72,6 +81,42 @@ extern struct binary_s *g_lib_binp;
 /* Partition Name - first partition : "A", second partition : "B" */
 #define GET_PARTNAME(part_idx)  ((part_idx == 0) ? "A" : "B")
 
+#ifdef CONFIG_BINMGR_PIPELINED_LOADING
+#define CHECKER_NAME            "bm_checker"                    /* Checking thread name */
+#define CHECK_CRC_BUFSIZE       CONFIG_BINMGR_PIPELINED_CRC_BUFSIZE
+#else
+#define CHECK_CRC_BUFSIZE       UINT32_MAX
+#endif
+
+/* A binary on its way through the loading stages.
+ * The checking stage verifies the signature and the header of the binary and
+ * the loading stage reads, decompresses, relocates and starts it.
+ */
+struct binmgr_loadjob_s {
+	int bin_idx;
+	int bin_count;                  /* Number of partitions left to try */
+	int result;                     /* Result of the last stage */
+	bool need_update_bp;            /* Binary is loaded from the partition not in bootparam */
+	uint8_t part_idx;               /* Partition to load, BIN_USEIDX is set to it by the loading stage */
+	uint8_t load_priority;          /* Loading priority of the binary in that partition */
+	char devpath[BINARY_PATH_LEN];
+	load_attr_t load_attr;
+#ifdef CONFIG_BINMGR_PIPELINED_LOADING
+	sem_t checked;                  /* Posted when the checking stage is done */
+#endif
+#ifdef CONFIG_BINMGR_LOADING_TIME
+	clock_t check_ticks;            /* Time spent in the checking stage */
+	clock_t wait_ticks;             /* Time the loading stage waited for the checking stage */
+	clock_t load_ticks;             /* Time spent in the loading stage */
+#endif
+};
+
+#ifdef CONFIG_BINMGR_PIPELINED_LOADING
+/* Jobs of loadingall_thread, shared with checking_thread */
+static struct binmgr_loadjob_s *g_loadjobs;
+static int g_nloadjobs;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -149,27 +194,22 @@ static int binary_manager_load_binary(int bin_idx, char *path, load_attr_t *load
 }
 
 /****************************************************************************
- * Name: binary_manager_load
+ * Name: binary_manager_init_loadjob
  *
  * Description:
- *	 This function loads user binary with binary index.
+ *	 This function prepares a loading job for binary with binary index.
  *
  ****************************************************************************/
-static int binary_manager_load(int bin_idx)
+static int binary_manager_init_loadjob(struct binmgr_loadjob_s *job, int bin_idx)
 {
-	int ret;
-	int bin_count;
-	load_attr_t load_attr;
-	bool need_update_bp;
-	char devpath[BINARY_PATH_LEN];
-	user_binary_header_t user_header_data;
-#ifdef CONFIG_SUPPORT_COMMON_BINARY
-	common_binary_header_t common_header_data;
-#endif
 #ifdef CONFIG_OPTIMIZE_APP_RELOAD_TIME
 	struct binary_s *binp;
 #endif
 
+	memset(job, 0, sizeof(struct binmgr_loadjob_s));
+	job->bin_idx = bin_idx;
+	job->result = ERROR;
+
 	if (bin_idx < 0) {
 		bmdbg("Invalid bin idx %d\n", bin_idx);
 		return ERROR;
@@ -181,107 +221,143 @@ static int binary_manager_load(int bin_idx)
 		return ERROR;
 	}
 
+	job->bin_count = BIN_COUNT(bin_idx);
+	job->part_idx = BIN_USEIDX(bin_idx);
+	job->load_priority = BIN_LOAD_PRIORITY(bin_idx, job->part_idx);
+
 #ifdef CONFIG_OPTIMIZE_APP_RELOAD_TIME
 	binp = BIN_LOADINFO(bin_idx);
 	if (binp) {
-		bin_count = 1;
-		snprintf(devpath, BINARY_PATH_LEN, BINMGR_DEVNAME_FMT, BIN_PARTNUM(bin_idx, (BIN_USEIDX(bin_idx))));
-	} else
-#endif
-	{
-		bin_count = BIN_COUNT(bin_idx);
+		job->bin_count = 1;
+		snprintf(job->devpath, BINARY_PATH_LEN, BINMGR_DEVNAME_FMT, BIN_PARTNUM(bin_idx, job->part_idx));
+		job->load_attr = BIN_LOAD_ATTR(bin_idx);
+		job->load_attr.binp = binp;
 	}
+#endif
 
-	need_update_bp = false;
+	job->result = OK;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: binary_manager_check_binary
+ *
+ * Description:
+ *	 This function checks the signature and the header of binary in the
+ *	 partition of the job and fills the loading attributes from the header.
+ *	 If the check fails, the other partition is tried. It only updates the
+ *	 job, so that it can run in checking_thread while another binary is loaded.
+ *
+ ****************************************************************************/
+static int binary_manager_check_binary(struct binmgr_loadjob_s *job)
+{
+	int ret;
+	int bin_idx = job->bin_idx;
+	load_attr_t *load_attr = &job->load_attr;
+	user_binary_header_t user_header_data;
+#ifdef CONFIG_SUPPORT_COMMON_BINARY
+	common_binary_header_t common_header_data;
+#endif
 
-	do {
 #ifdef CONFIG_OPTIMIZE_APP_RELOAD_TIME
-		if (!binp)
+	if (load_attr->binp) {
+		/* Binary is reloaded, it was checked when it was loaded first */
+		return OK;
+	}
 #endif
-		{
+
+	while (job->bin_count > 0) {
 #ifdef CONFIG_BINARY_SIGNING
-			/* Check signature */
-			ret = up_verify_usersignature(BIN_PARTADDR(bin_idx, (BIN_USEIDX(bin_idx))));
-			if (ret == OK) {
-				bmdbg("%s Signature Checking Success\n", BIN_NAME(bin_idx));
-			} else {
-				bmdbg("Invalid Signature, name : %s, address : %p\n", BIN_NAME(bin_idx), BIN_PARTADDR(bin_idx, (BIN_USEIDX(bin_idx))));
-				if (--bin_count > 0) {
-					BIN_USEIDX(bin_idx) ^= 1;
-					need_update_bp = true;
-					bmdbg("Try to read another partition %s\n", GET_PARTNAME(BIN_USEIDX(bin_idx)));
-					continue;
-				} else {
-					bmdbg("No valid binary %s\n", BIN_NAME(bin_idx));
-					break;
-				}
-			}
+		/* Check signature */
+		ret = up_verify_usersignature(BIN_PARTADDR(bin_idx, job->part_idx));
+		if (ret == OK) {
+			bmdbg("%s Signature Checking Success\n", BIN_NAME(bin_idx));
+		} else {
+			bmdbg("Invalid Signature, name : %s, address : %p\n", BIN_NAME(bin_idx), BIN_PARTADDR(bin_idx, job->part_idx));
+			goto try_other_partition;
+		}
 #endif
 
-			/* Read header data and Check crc */
-			snprintf(devpath, BINARY_PATH_LEN, BINMGR_DEVNAME_FMT, BIN_PARTNUM(bin_idx, (BIN_USEIDX(bin_idx))));
+		/* Read header data and Check crc */
+		snprintf(job->devpath, BINARY_PATH_LEN, BINMGR_DEVNAME_FMT, BIN_PARTNUM(bin_idx, job->part_idx));
 #ifdef CONFIG_SUPPORT_COMMON_BINARY
-			if (bin_idx == BM_CMNLIB_IDX) {
-				ret = binary_manager_read_header(BINARY_COMMON, devpath, &common_header_data, true);
-				BIN_VER(bin_idx, BIN_USEIDX(bin_idx)) = common_header_data.version;
-			} else
+		if (bin_idx == BM_CMNLIB_IDX) {
+			ret = binary_manager_read_header_bufsize(BINARY_COMMON, job->devpath, &common_header_data, CHECK_CRC_BUFSIZE);
+			BIN_VER(bin_idx, job->part_idx) = common_header_data.version;
+		} else
 #endif
-			{
-				ret = binary_manager_read_header(BINARY_USERAPP, devpath, &user_header_data, true);
-				BIN_VER(bin_idx, BIN_USEIDX(bin_idx)) = user_header_data.bin_ver;
-			}
-			if (ret == BINMGR_OK) {
-				bmdbg("%s Header Checking Success\n", BIN_NAME(bin_idx));
-			} else {
-				/* Clear version because of invalid binary */
-				BIN_VER(bin_idx, BIN_USEIDX(bin_idx)) = 0;
-				bmdbg("Invalid Header data, name : %s, devpath : %p\n", BIN_NAME(bin_idx), devpath);
-				if (--bin_count > 0) {
-					BIN_USEIDX(bin_idx) ^= 1;
-					need_update_bp = true;
-					bmdbg("Try to read another partition %s\n", GET_PARTNAME(BIN_USEIDX(bin_idx)));
-					continue;
-				} else {
-					bmdbg("No valid binary %s\n", BIN_NAME(bin_idx));
-					break;
-				}
-			}
+		{
+			ret = binary_manager_read_header_bufsize(BINARY_USERAPP, job->devpath, &user_header_data, CHECK_CRC_BUFSIZE);
+			BIN_VER(bin_idx, job->part_idx) = user_header_data.bin_ver;
+		}
+		if (ret == BINMGR_OK) {
+			bmdbg("%s Header Checking Success\n", BIN_NAME(bin_idx));
+		} else {
+			/* Clear version because of invalid binary */
+			BIN_VER(bin_idx, job->part_idx) = 0;
+			bmdbg("Invalid Header data, name : %s, devpath : %p\n", BIN_NAME(bin_idx), job->devpath);
+			goto try_other_partition;
+		}
 #ifdef CONFIG_SUPPORT_COMMON_BINARY
-			if (bin_idx == BM_CMNLIB_IDX) {
-				strncpy(load_attr.bin_name, BM_CMNLIB_NAME, sizeof(BM_CMNLIB_NAME));
-				load_attr.offset = CHECKSUM_SIZE + common_header_data.header_size;
-				load_attr.bin_size = common_header_data.bin_size;
-				load_attr.bin_ver = common_header_data.version;
+		if (bin_idx == BM_CMNLIB_IDX) {
+			strncpy(load_attr->bin_name, BM_CMNLIB_NAME, sizeof(BM_CMNLIB_NAME));
+			load_attr->offset = CHECKSUM_SIZE + common_header_data.header_size;
+			load_attr->bin_size = common_header_data.bin_size;
+			load_attr->bin_ver = common_header_data.version;
 #ifdef CONFIG_BINARY_SIGNING
-				load_attr.offset += USER_SIGN_PREPEND_SIZE;
+			load_attr->offset += USER_SIGN_PREPEND_SIZE;
 #endif
 
-			} else
+		} else
 #endif
-			{
-				strncpy(load_attr.bin_name, user_header_data.bin_name, BIN_NAME_MAX - 1);
-				load_attr.bin_name[BIN_NAME_MAX - 1] = '\0';
-				load_attr.bin_size = user_header_data.bin_size;
-				load_attr.ram_size = user_header_data.bin_ramsize;
-				load_attr.stack_size = user_header_data.bin_stacksize;
-				load_attr.priority = user_header_data.bin_priority;
-				load_attr.offset = CHECKSUM_SIZE + user_header_data.header_size;
+		{
+			strncpy(load_attr->bin_name, user_header_data.bin_name, BIN_NAME_MAX - 1);
+			load_attr->bin_name[BIN_NAME_MAX - 1] = '\0';
+			load_attr->bin_size = user_header_data.bin_size;
+			load_attr->ram_size = user_header_data.bin_ramsize;
+			load_attr->stack_size = user_header_data.bin_stacksize;
+			load_attr->priority = user_header_data.bin_priority;
+			load_attr->offset = CHECKSUM_SIZE + user_header_data.header_size;
 #ifdef CONFIG_BINARY_SIGNING
-				load_attr.offset += USER_SIGN_PREPEND_SIZE;
+			load_attr->offset += USER_SIGN_PREPEND_SIZE;
 #endif
-				load_attr.bin_ver = user_header_data.bin_ver;
-			}
+			load_attr->bin_ver = user_header_data.bin_ver;
 		}
-#ifdef CONFIG_OPTIMIZE_APP_RELOAD_TIME
-		else {
-			load_attr = BIN_LOAD_ATTR(bin_idx);
+		return OK;
+
+try_other_partition:
+		if (--job->bin_count > 0) {
+			job->part_idx ^= 1;
+			job->load_priority = BIN_LOAD_PRIORITY(bin_idx, job->part_idx);
+			job->need_update_bp = true;
+			bmdbg("Try to read another partition %s\n", GET_PARTNAME(job->part_idx));
+		} else {
+			bmdbg("No valid binary %s\n", BIN_NAME(bin_idx));
 		}
-		load_attr.binp = binp;
-#endif
+	}
+
+	return ERROR;
+}
+
+/****************************************************************************
+ * Name: binary_manager_run_loadjob
+ *
+ * Description:
+ *	 This function loads and executes a checked binary. If loading fails, the
+ *	 other partition is checked and loaded.
+ *
+ ****************************************************************************/
+static int binary_manager_run_loadjob(struct binmgr_loadjob_s *job)
+{
+	int ret;
+	int bin_idx = job->bin_idx;
 
-		ret = binary_manager_load_binary(bin_idx, devpath, &load_attr);
+	while (job->result == OK) {
+		/* The partition is chosen by the checking stage, publish it here */
+		BIN_USEIDX(bin_idx) = job->part_idx;
+		ret = binary_manager_load_binary(bin_idx, job->devpath, &job->load_attr);
 		if (ret == OK) {
-			if (need_update_bp) {
+			if (job->need_update_bp) {
 				/* Update boot param data because the binary not written to bootparam is loaded */
 				binmgr_bpdata_t update_bp_data;
 				memcpy(&update_bp_data, binary_manager_get_bpdata(), sizeof(binmgr_bpdata_t));
@@ -297,19 +373,72 @@ static int binary_manager_load(int bin_idx)
 			}
 			return BINMGR_OK;
 		}
-		if (--bin_count > 0) {
+		if (--job->bin_count > 0) {
 			/* Change index 0 to 1 and 1 to 0. */
-			BIN_USEIDX(bin_idx) ^= 1;
-			need_update_bp = true;
-			bmdbg("Try to read another partition %s\n", GET_PARTNAME(BIN_USEIDX(bin_idx)));
+			job->part_idx ^= 1;
+			job->load_priority = BIN_LOAD_PRIORITY(bin_idx, job->part_idx);
+			job->need_update_bp = true;
+			bmdbg("Try to read another partition %s\n", GET_PARTNAME(job->part_idx));
+			job->result = binary_manager_check_binary(job);
 		} else {
 			bmdbg("No valid binary %s\n", BIN_NAME(bin_idx));
+			job->result = ERROR;
 		}
-	} while (bin_count > 0);
+	}
 
 	return ERROR;
 }
 
+#ifdef CONFIG_BINMGR_LOADING_TIME
+/****************************************************************************
+ * Name: binary_manager_show_loadtime
+ *
+ * Description:
+ *	 This function shows the time spent in each loading stage of a binary.
+ *
+ ****************************************************************************/
+static void binary_manager_show_loadtime(struct binmgr_loadjob_s *job)
+{
+	bmdbg("[%s] check %u ms, wait %u ms, load %u ms\n", BIN_NAME(job->bin_idx), (unsigned int)TICK2MSEC(job->check_ticks), (unsigned int)TICK2MSEC(job->wait_ticks), (unsigned int)TICK2MSEC(job->load_ticks));
+}
+#endif
+
+/****************************************************************************
+ * Name: binary_manager_load
+ *
+ * Description:
+ *	 This function loads user binary with binary index.
+ *
+ ****************************************************************************/
+static int binary_manager_load(int bin_idx)
+{
+	int ret;
+	struct binmgr_loadjob_s job;
+#ifdef CONFIG_BINMGR_LOADING_TIME
+	clock_t start;
+#endif
+
+	if (binary_manager_init_loadjob(&job, bin_idx) != OK) {
+		return ERROR;
+	}
+
+#ifdef CONFIG_BINMGR_LOADING_TIME
+	start = clock_systimer();
+#endif
+	job.result = binary_manager_check_binary(&job);
+#ifdef CONFIG_BINMGR_LOADING_TIME
+	job.check_ticks = clock_systimer() - start;
+	start = clock_systimer();
+#endif
+	ret = binary_manager_run_loadjob(&job);
+#ifdef CONFIG_BINMGR_LOADING_TIME
+	job.load_ticks = clock_systimer() - start;
+	binary_manager_show_loadtime(&job);
+#endif
+
+	return ret;
+}
+
 /****************************************************************************
  * Name: binary_manager_terminate_binary
  *
@@ -462,6 +591,216 @@ static int loading_thread(int argc, char *argv[])
 	return binary_manager_load((int)atoi(argv[1]));
 }
 
+#ifdef CONFIG_BINMGR_PIPELINED_LOADING
+/****************************************************************************
+ * Name: binary_manager_set_loader_priority
+ *
+ * Description:
+ *   This function changes the priority of the calling thread to the priority
+ *   of loader for the binary of a job.
+ *
+ ****************************************************************************/
+static void binary_manager_set_loader_priority(struct binmgr_loadjob_s *job)
+{
+	struct sched_param param;
+
+#ifdef CONFIG_SUPPORT_COMMON_BINARY
+	if (job->bin_idx == BM_CMNLIB_IDX) {
+		param.sched_priority = LOADER_PRIORITY_HIGH;
+	} else
+#endif
+	{
+		param.sched_priority = binary_manager_get_loader_priority(job->load_priority);
+	}
+
+	if (param.sched_priority > 0) {
+		sched_setparam(0, &param);
+	}
+}
+
+/****************************************************************************
+ * Name: checking_thread
+ *
+ * Description:
+ *   This thread runs the checking stage of all jobs of loadingall_thread in
+ *   order, so that the next binary is checked while the previous one is loaded.
+ *
+ ****************************************************************************/
+static int checking_thread(int argc, char *argv[])
+{
+	int i;
+	struct binmgr_loadjob_s *job;
+#ifdef CONFIG_BINMGR_LOADING_TIME
+	clock_t start;
+#endif
+
+	for (i = 0; i < g_nloadjobs; i++) {
+		job = &g_loadjobs[i];
+		if (job->result == OK) {
+			binary_manager_set_loader_priority(job);
+#ifdef CONFIG_BINMGR_LOADING_TIME
+			start = clock_systimer();
+#endif
+			job->result = binary_manager_check_binary(job);
+#ifdef CONFIG_BINMGR_LOADING_TIME
+			job->check_ticks = clock_systimer() - start;
+#endif
+		}
+		sem_post(&job->checked);
+	}
+
+	return OK;
+}
+
+/****************************************************************************
+ * Name: binary_manager_wait_checked
+ *
+ * Description:
+ *   This function waits until the checking stage of a job is done.
+ *
+ ****************************************************************************/
+static void binary_manager_wait_checked(struct binmgr_loadjob_s *job)
+{
+	while (sem_wait(&job->checked) != OK) {
+		ASSERT(get_errno() == EINTR);
+	}
+}
+
+/****************************************************************************
+ * Name: loadingall_thread
+ *
+ * Description:
+ *   This function loads all user binaries registered in binary table.
+ *   The common binary is loaded first and then user binaries in the order of
+ *   their loading priority. Checking of each binary is done by checking_thread
+ *   while the previous binary is loaded, and each binary is loaded with the
+ *   priority of its loader.
+ *
+ ****************************************************************************/
+static int loadingall_thread(int argc, char *argv[])
+{
+	int i;
+	int ret;
+	int prio;
+	int bin_idx;
+	int load_cnt;
+	int njobs;
+	uint32_t bin_count;
+	struct binmgr_loadjob_s *jobs;
+	struct binmgr_loadjob_s *job;
+#ifdef CONFIG_BINMGR_LOADING_TIME
+	clock_t start;
+	clock_t begin;
+#endif
+
+	if (!binary_manager_scan_ubin_all()) {
+		return BINMGR_OPERATION_FAIL;
+	}
+
+#ifdef CONFIG_BINMGR_LOADING_TIME
+	begin = clock_systimer();
+#endif
+
+	bin_count = binary_manager_get_ucount();
+	jobs = (struct binmgr_loadjob_s *)kmm_zalloc(sizeof(struct binmgr_loadjob_s) * (bin_count + 1));
+	if (jobs == NULL) {
+		bmdbg("Fail to allocate loading jobs\n");
+		return BINMGR_OPERATION_FAIL;
+	}
+
+	/* Order the jobs : common binary which others depend on first, then
+	 * user binaries from high to low loading priority. checking_thread is
+	 * not running yet, afterwards only the jobs carry the partition index.
+	 */
+	njobs = 0;
+#ifdef CONFIG_SUPPORT_COMMON_BINARY
+	binary_manager_init_loadjob(&jobs[njobs++], BM_CMNLIB_IDX);
+#endif
+	for (prio = BINARY_LOADPRIO_HIGH; prio >= BINARY_LOADPRIO_LOW; prio--) {
+		for (bin_idx = 1; bin_idx <= bin_count; bin_idx++) {
+			if (BIN_LOAD_PRIORITY(bin_idx, BIN_USEIDX(bin_idx)) == prio) {
+				binary_manager_init_loadjob(&jobs[njobs++], bin_idx);
+			}
+		}
+	}
+
+	/* The checked semaphores are used for signaling, not for locking */
+
+	for (i = 0; i < njobs; i++) {
+		sem_init(&jobs[i].checked, 0, 0);
+		sem_setprotocol(&jobs[i].checked, SEM_PRIO_NONE);
+	}
+
+	g_loadjobs = jobs;
+	g_nloadjobs = njobs;
+
+	ret = kernel_thread(CHECKER_NAME, LOADER_PRIORITY_HIGH, LOADER_STACKSIZE, checking_thread, NULL);
+	if (ret < 0) {
+		/* Check the binaries here, one by one */
+		bmdbg("Fail to create checking thread, errno %d\n", errno);
+		checking_thread(0, NULL);
+	}
+
+	load_cnt = 0;
+	for (i = 0; i < njobs; i++) {
+		job = &jobs[i];
+
+#ifdef CONFIG_BINMGR_LOADING_TIME
+		start = clock_systimer();
+#endif
+		binary_manager_wait_checked(job);
+#ifdef CONFIG_BINMGR_LOADING_TIME
+		job->wait_ticks = clock_systimer() - start;
+#endif
+
+		if (job->result != OK) {
+			continue;
+		}
+
+		binary_manager_set_loader_priority(job);
+#ifdef CONFIG_BINMGR_LOADING_TIME
+		start = clock_systimer();
+#endif
+		ret = binary_manager_run_loadjob(job);
+#ifdef CONFIG_BINMGR_LOADING_TIME
+		job->load_ticks = clock_systimer() - start;
+		binary_manager_show_loadtime(job);
+#endif
+		if (ret == OK) {
+			load_cnt++;
+		}
+#ifdef CONFIG_SUPPORT_COMMON_BINARY
+		else if (job->bin_idx == BM_CMNLIB_IDX) {
+			/* User binaries can't be loaded without common binary */
+			load_cnt = 0;
+			break;
+		}
+#endif
+	}
+
+	/* checking_thread uses the jobs until it posts the last one */
+	for (i++; i < njobs; i++) {
+		binary_manager_wait_checked(&jobs[i]);
+	}
+
+#ifdef CONFIG_BINMGR_LOADING_TIME
+	bmdbg("%d binaries loaded in %u ms\n", load_cnt, (unsigned int)TICK2MSEC(clock_systimer() - begin));
+#endif
+
+	for (i = 0; i < njobs; i++) {
+		sem_destroy(&jobs[i].checked);
+	}
+	g_loadjobs = NULL;
+	g_nloadjobs = 0;
+	kmm_free(jobs);
+
+	if (load_cnt > 0) {
+		return load_cnt;
+	}
+
+	return BINMGR_OPERATION_FAIL;
+}
+#else
 /****************************************************************************
  * Name: loadingall_thread
  *
@@ -495,7 +834,7 @@ static int loadingall_thread(int argc, char *argv[])
 	for (bin_idx = 1; bin_idx <= bin_count; bin_idx++) {
 		if (BIN_LOAD_PRIORITY(bin_idx, BIN_USEIDX(bin_idx)) == BINARY_LOADPRIO_HIGH) {
 			ret = binary_manager_load(bin_idx);
-			if (ret > 0) {
+			if (ret == OK) {
 				load_cnt++;
 			}
 		}
@@ -517,6 +856,7 @@ static int loadingall_thread(int argc, char *argv[])
 
 	return BINMGR_OPERATION_FAIL;
 }
+#endif
 
 #ifdef CONFIG_BINMGR_RECOVERY
 /****************************************************************************
@@ -751,3 +1091,45 @@ int binary_manager_execute_loader(int cmd, int bin_idx)
 
 	return ret;
 }
+
+#ifdef CONFIG_ELF_LAZY_LOAD
+/****************************************************************************
+ * Name: binary_manager_load_section_with_addr
+ *
+ * Description:
+ *	 This function loads the deferred section of the requester's binary that
+ *	 contains 'addr' and replies with the result.
+ *
+ ****************************************************************************/
+void binary_manager_load_section_with_addr(int requester_pid, uintptr_t addr)
+{
+	int ret;
+	int bin_idx;
+	struct tcb_s *tcb;
+	char q_name[BIN_PRIVMQ_LEN];
+	binmgr_loadsection_response_t response_msg;
+
+	tcb = sched_gettcb(requester_pid);
+	if (tcb == NULL || tcb->group == NULL || tcb->group->tg_binidx <= 0) {
+		bmdbg("Invalid requester pid %d\n", requester_pid);
+		response_msg.result = BINMGR_INVALID_PARAM;
+		goto send_result;
+	}
+
+	bin_idx = tcb->group->tg_binidx;
+	ret = elf_lazy_load(bin_idx, addr);
+	if (ret == -ENOENT) {
+		bmdbg("No deferred section at %p in %s\n", (void *)addr, BIN_NAME(bin_idx));
+		response_msg.result = BINMGR_NOT_FOUND;
+	} else if (ret < 0) {
+		bmdbg("Failed to load section at %p in %s, %d\n", (void *)addr, BIN_NAME(bin_idx), ret);
+		response_msg.result = BINMGR_OPERATION_FAIL;
+	} else {
+		response_msg.result = BINMGR_OK;
+	}
+
+send_result:
+	snprintf(q_name, BIN_PRIVMQ_LEN, "%s%d", BINMGR_RESPONSE_MQ_PREFIX, requester_pid);
+	binary_manager_send_response(q_name, &response_msg, sizeof(binmgr_loadsection_response_t));
+}
+#endif
@@ -94,6 +94,19 @@ static int binary_manager_verify_header_data(int type, void *header_input)
  *
  *****************************************************************************/
 int binary_manager_read_header(int type, char *devpath, void *header_data, bool crc_check)
+{
+	return binary_manager_read_header_bufsize(type, devpath, header_data, crc_check ? UINT32_MAX : 0);
+}
+
+/*****************************************************************************
+ * Name: binary_manager_read_header_bufsize
+ *
+ * Description:
+ *  Same as binary_manager_read_header, with a buffer of at most max_bufsize
+ *  bytes for CRC checking. CRC is not checked if max_bufsize is 0.
+ *
+ *****************************************************************************/
+int binary_manager_read_header_bufsize(int type, char *devpath, void *header_data, uint32_t max_bufsize)
 {
 	int fd;
 	int ret;
@@ -153,7 +166,7 @@ int binary_manager_read_header(int type, char *devpath, void *header_data, bool
 		goto errout_with_fd;
 	}
 
-	if (crc_check) {
+	if (max_bufsize > 0) {
 		if (type == BINARY_KERNEL) {
 			crc_bufsize = ((kernel_binary_header_t *)header_data)->binary_size;
 			bin_size = ((kernel_binary_header_t *)header_data)->binary_size;
@@ -167,8 +180,12 @@ int binary_manager_read_header(int type, char *devpath, void *header_data, bool
 			bin_size = ((common_binary_header_t *)header_data)->bin_size;
 			crc_hash = ((common_binary_header_t *)header_data)->crc_hash;
 		}
-		size_t max_bufsize = kmm_get_largest_freenode_size() / 2;
-		crc_bufsize = crc_bufsize < max_bufsize ? crc_bufsize : max_bufsize;
+		if (crc_bufsize > max_bufsize) {
+			crc_bufsize = max_bufsize;
+		}
+		if (crc_bufsize > kmm_get_largest_freenode_size() / 2) {
+			crc_bufsize = kmm_get_largest_freenode_size() / 2;
+		}
 		crc_buffer = (uint8_t *)kmm_malloc(crc_bufsize);
 		if (!crc_buffer) {
 			bmdbg("Fail to malloc buffer for checking crc, size %u\n", crc_bufsize);
@@ -78,6 +78,9 @@
 #ifdef CONFIG_SCHED_CPULOAD
 #include <tinyara/cpuload.h>
 #endif
+#ifdef CONFIG_PERF_COUNTERS
+#include <tinyara/perf.h>
+#endif
 #ifdef CONFIG_PRODCONFIG
 #include <tinyara/prodconfig.h>
 #endif
@@ -288,6 +291,10 @@ static inline void os_do_appstart(void)
 	cpuload_initialize();
 #endif
 
+#ifdef CONFIG_PERF_COUNTERS
+	perf_initialize();
+#endif
+
 #ifdef CONFIG_TASK_MANAGER
 	task_manager_drv_register();
 #endif
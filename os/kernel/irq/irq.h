@@ -85,6 +85,38 @@ struct irq {
 
 extern struct irq g_irqvector[NR_IRQS];
 
+#ifdef CONFIG_IRQ_LATENCY
+/* Kinds of sections timed by the critical section monitor */
+
+#define IRQLATENCY_IRQSOFF          0	/* irqsave() to irqrestore() */
+#define IRQLATENCY_PREEMPTOFF       1	/* sched_lock() to sched_unlock() */
+
+/* Statistics of the sections started at one code address.  Durations are
+ * in cycles of up_perf_gettime().
+ */
+
+struct irqlatency_site_s {
+	FAR void *addr;				/* Caller of irqsave() or sched_lock() */
+	uint8_t type;				/* IRQLATENCY_IRQSOFF or IRQLATENCY_PREEMPTOFF */
+	uint32_t count;
+	uint32_t max;
+	uint64_t total;
+	uint32_t hist[IRQLATENCY_NBUCKETS];
+};
+
+/* Latency from interrupt entry to the handler of one irq, in cycles */
+
+struct irqlatency_irq_s {
+	uint32_t count;
+	uint32_t max;
+};
+
+extern struct irqlatency_site_s g_irqlatency_sites[CONFIG_IRQ_LATENCY_NSITES];
+extern struct irqlatency_irq_s g_irqlatency_irqs[NR_IRQS];
+extern uint32_t g_irqlatency_irqhist[IRQLATENCY_NBUCKETS];
+extern uint32_t g_irqlatency_dropped;
+#endif
+
 /****************************************************************************
  * Public Variables
  ****************************************************************************/
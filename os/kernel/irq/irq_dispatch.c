@@ -59,6 +59,8 @@
 #include <debug.h>
 #include <tinyara/arch.h>
 #include <tinyara/irq.h>
+#include <tinyara/ttrace.h>
+#include <tinyara/irqlatency.h>
 
 #include "irq/irq.h"
 
@@ -128,5 +130,8 @@ void irq_dispatch(int irq, FAR void *context)
 
 	/* Then dispatch to the interrupt handler */
 
+	irqlatency_dispatch(irq);
+	ttrace_irq_enter(irq, vector);
 	vector(irq, context, arg);
+	ttrace_irq_exit(irq);
 }
@@ -0,0 +1,347 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * kernel/irq/irq_latency.c
+ *
+ *   Critical section monitor: durations of the sections with interrupts or
+ *   preemption disabled, per code address which started them, and the
+ *   latency from interrupt entry to the handler, per irq.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <tinyara/arch.h>
+#include <tinyara/clock.h>
+#include <tinyara/irq.h>
+#include <tinyara/irqlatency.h>
+
+#include "irq/irq.h"
+
+/* This file implements the instrumented versions, so it uses the plain
+ * architecture irqsave() and irqrestore().
+ */
+
+#undef irqsave
+#undef irqrestore
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Whether flags returned by irqsave() show that interrupts were enabled
+ * before it, that is whether that irqsave() starts the outermost section.
+ */
+
+#if defined(CONFIG_ARCH_ARMV7M_FAMILY) && defined(CONFIG_ARMV7M_USEBASEPRI)
+#define IRQLATENCY_WAS_ENABLED(flags) ((flags) == 0 || (flags) > NVIC_SYSH_DISABLE_PRIORITY)
+#elif defined(CONFIG_ARCH_ARMV8M_FAMILY) && defined(CONFIG_ARMV8M_USEBASEPRI)
+#define IRQLATENCY_WAS_ENABLED(flags) ((flags) == 0 || (flags) > NVIC_SYSH_DISABLE_PRIORITY)
+#elif defined(CONFIG_ARCH_ARMV7M_FAMILY) || defined(CONFIG_ARCH_ARMV8M_FAMILY)
+#define IRQLATENCY_WAS_ENABLED(flags) (((flags) & 1) == 0)	/* PRIMASK */
+#elif defined(CONFIG_ARCH_XTENSA)
+#define IRQLATENCY_WAS_ENABLED(flags) (((flags) & PS_INTLEVEL_MASK) == 0)
+#else
+#error "IRQ_LATENCY does not know the irqstate_t of this architecture"
+#endif
+
+/****************************************************************************
+ * Public Variables
+ ****************************************************************************/
+
+struct irqlatency_site_s g_irqlatency_sites[CONFIG_IRQ_LATENCY_NSITES];
+struct irqlatency_irq_s g_irqlatency_irqs[NR_IRQS];
+uint32_t g_irqlatency_irqhist[IRQLATENCY_NBUCKETS];
+
+/* Sections not recorded because g_irqlatency_sites was full */
+
+uint32_t g_irqlatency_dropped;
+
+/****************************************************************************
+ * Private Variables
+ ****************************************************************************/
+
+/* The section with interrupts disabled which is open, if any */
+
+static bool g_irqoff_open;
+static FAR void *g_irqoff_site;
+static uint32_t g_irqoff_start;
+
+/* The section with preemption disabled which is open, if any */
+
+static bool g_preempt_open;
+static FAR void *g_preempt_site;
+static uint32_t g_preempt_start;
+
+/* Time of the last interrupt entry, consumed by irqlatency_dispatch() */
+
+static bool g_entry_valid;
+static uint32_t g_entry_time;
+
+/* Cycles per microsecond, 0 until the cycle counter frequency is known */
+
+static uint32_t g_cycles_per_usec;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: irqlatency_bucket
+ *
+ * Description:
+ *   Return the histogram bucket of a duration: 0 below 1us, n below 2^n us
+ *   and the last bucket for everything longer.
+ *
+ ****************************************************************************/
+
+static int irqlatency_bucket(uint32_t cycles)
+{
+	uint32_t usec;
+	int bucket;
+
+	if (g_cycles_per_usec == 0) {
+		g_cycles_per_usec = up_perf_getfreq() / USEC_PER_SEC;
+		if (g_cycles_per_usec == 0) {
+			return 0;
+		}
+	}
+
+	usec = cycles / g_cycles_per_usec;
+	if (usec == 0) {
+		return 0;
+	}
+
+	bucket = 32 - __builtin_clz(usec);
+	return bucket < IRQLATENCY_NBUCKETS ? bucket : IRQLATENCY_NBUCKETS - 1;
+}
+
+/****************************************************************************
+ * Name: irqlatency_record
+ *
+ * Description:
+ *   Account a finished section to the entry of its site, which is looked up
+ *   with linear probing and created on first use.  Called with interrupts
+ *   disabled.
+ *
+ ****************************************************************************/
+
+static void irqlatency_record(uint8_t type, FAR void *site, uint32_t cycles)
+{
+	FAR struct irqlatency_site_s *entry;
+	unsigned int index;
+	unsigned int i;
+
+	index = ((uintptr_t)site >> 1) % CONFIG_IRQ_LATENCY_NSITES;
+
+	for (i = 0; i < CONFIG_IRQ_LATENCY_NSITES; i++) {
+		entry = &g_irqlatency_sites[index];
+		if (entry->addr == NULL) {
+			entry->addr = site;
+			entry->type = type;
+			break;
+		}
+
+		if (entry->addr == site && entry->type == type) {
+			break;
+		}
+
+		if (++index == CONFIG_IRQ_LATENCY_NSITES) {
+			index = 0;
+		}
+	}
+
+	if (i == CONFIG_IRQ_LATENCY_NSITES) {
+		g_irqlatency_dropped++;
+		return;
+	}
+
+	entry->count++;
+	entry->total += cycles;
+	if (cycles > entry->max) {
+		entry->max = cycles;
+	}
+
+	entry->hist[irqlatency_bucket(cycles)]++;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: irqlatency_save
+ ****************************************************************************/
+
+irqstate_t irqlatency_save(void)
+{
+	irqstate_t flags = irqsave();
+
+	/* Nested sections are part of the outermost one, which is the one
+	 * entered with interrupts enabled.
+	 */
+
+	if (!g_irqoff_open && IRQLATENCY_WAS_ENABLED(flags)) {
+		g_irqoff_site = __builtin_return_address(0);
+		g_irqoff_start = up_perf_gettime();
+		g_irqoff_open = true;
+	}
+
+	return flags;
+}
+
+/****************************************************************************
+ * Name: irqlatency_restore
+ ****************************************************************************/
+
+void irqlatency_restore(irqstate_t flags)
+{
+	/* Only restoring the flags of the outermost section enables interrupts */
+
+	if (g_irqoff_open && IRQLATENCY_WAS_ENABLED(flags)) {
+		g_irqoff_open = false;
+		irqlatency_record(IRQLATENCY_IRQSOFF, g_irqoff_site, up_perf_gettime() - g_irqoff_start);
+	}
+
+	irqrestore(flags);
+}
+
+/****************************************************************************
+ * Name: irqlatency_preempt_off
+ ****************************************************************************/
+
+void irqlatency_preempt_off(FAR void *site)
+{
+	irqstate_t flags = irqsave();
+
+	if (!g_preempt_open) {
+		g_preempt_site = site;
+		g_preempt_start = up_perf_gettime();
+		g_preempt_open = true;
+	}
+
+	irqrestore(flags);
+}
+
+/****************************************************************************
+ * Name: irqlatency_preempt_on
+ ****************************************************************************/
+
+void irqlatency_preempt_on(void)
+{
+	irqstate_t flags = irqsave();
+
+	if (g_preempt_open) {
+		g_preempt_open = false;
+		irqlatency_record(IRQLATENCY_PREEMPTOFF, g_preempt_site, up_perf_gettime() - g_preempt_start);
+	}
+
+	irqrestore(flags);
+}
+
+/****************************************************************************
+ * Name: irqlatency_switch
+ *
+ * Description:
+ *   The task which resumes restores its own interrupt state, and its
+ *   preemption lock count if it blocked with preemption disabled.  Those
+ *   resumed sections are not timed: the sections it opens from now on are.
+ *
+ ****************************************************************************/
+
+void irqlatency_switch(void)
+{
+	uint32_t now;
+
+	if (!g_irqoff_open && !g_preempt_open) {
+		return;
+	}
+
+	now = up_perf_gettime();
+
+	if (g_irqoff_open) {
+		g_irqoff_open = false;
+		irqlatency_record(IRQLATENCY_IRQSOFF, g_irqoff_site, now - g_irqoff_start);
+	}
+
+	if (g_preempt_open) {
+		g_preempt_open = false;
+		irqlatency_record(IRQLATENCY_PREEMPTOFF, g_preempt_site, now - g_preempt_start);
+	}
+}
+
+/****************************************************************************
+ * Name: irqlatency_entry
+ ****************************************************************************/
+
+void irqlatency_entry(void)
+{
+	g_entry_time = up_perf_gettime();
+	g_entry_valid = true;
+}
+
+/****************************************************************************
+ * Name: irqlatency_dispatch
+ ****************************************************************************/
+
+void irqlatency_dispatch(int irq)
+{
+	uint32_t cycles;
+
+	/* Nested dispatches of demultiplexed irqs share the entry of the first */
+
+	if (!g_entry_valid) {
+		return;
+	}
+
+	g_entry_valid = false;
+	cycles = up_perf_gettime() - g_entry_time;
+
+	if ((unsigned)irq < NR_IRQS) {
+		g_irqlatency_irqs[irq].count++;
+		if (cycles > g_irqlatency_irqs[irq].max) {
+			g_irqlatency_irqs[irq].max = cycles;
+		}
+	}
+
+	g_irqlatency_irqhist[irqlatency_bucket(cycles)]++;
+}
+
+/****************************************************************************
+ * Name: irqlatency_reset
+ ****************************************************************************/
+
+void irqlatency_reset(void)
+{
+	irqstate_t flags = irqsave();
+
+	memset(g_irqlatency_sites, 0, sizeof(g_irqlatency_sites));
+	memset(g_irqlatency_irqs, 0, sizeof(g_irqlatency_irqs));
+	memset(g_irqlatency_irqhist, 0, sizeof(g_irqlatency_irqhist));
+	g_irqlatency_dropped = 0;
+
+	irqrestore(flags);
+}
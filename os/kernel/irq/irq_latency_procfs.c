@@ -0,0 +1,445 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * kernel/irq/irq_latency_procfs.c
+ *
+ *   /proc/irqlatency: report of the critical section monitor.  Reading it
+ *   lists the interrupt latencies and the critical sections, longest
+ *   first.  Writing anything to it clears the statistics.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <tinyara/arch.h>
+#include <tinyara/clock.h>
+#include <tinyara/kmalloc.h>
+#include <tinyara/fs/fs.h>
+#include <tinyara/fs/procfs.h>
+#include <tinyara/irqlatency.h>
+
+#include "irq/irq.h"
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS)
+#if !defined(CONFIG_FS_PROCFS_EXCLUDE_IRQLATENCY)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic.
+ */
+
+#define IRQLATENCY_LINELEN 192
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file".  The statistics are copied
+ * when the file is opened, so that the report is consistent however it is
+ * read.
+ */
+
+struct irqlatency_file_s {
+	struct procfs_file_s base;	/* Base open file structure */
+	uint32_t cycles_per_usec;
+	uint32_t dropped;
+	int nsites;					/* Number of valid entries of sites[] */
+	struct irqlatency_site_s sites[CONFIG_IRQ_LATENCY_NSITES];
+	struct irqlatency_irq_s irqs[NR_IRQS];
+	uint32_t irqhist[IRQLATENCY_NBUCKETS];
+	char line[IRQLATENCY_LINELEN];	/* Pre-allocated buffer for formatted lines */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int irqlatency_open(FAR struct file *filep, FAR const char *relpath, int oflags, mode_t mode);
+static int irqlatency_close(FAR struct file *filep);
+static ssize_t irqlatency_read(FAR struct file *filep, FAR char *buffer, size_t buflen);
+static ssize_t irqlatency_write(FAR struct file *filep, FAR const char *buffer, size_t buflen);
+
+static int irqlatency_dup(FAR const struct file *oldp, FAR struct file *newp);
+
+static int irqlatency_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Variables
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations irqlatency_operations = {
+	irqlatency_open,			/* open */
+	irqlatency_close,			/* close */
+	irqlatency_read,			/* read */
+	irqlatency_write,			/* write */
+
+	irqlatency_dup,				/* dup */
+
+	NULL,						/* opendir */
+	NULL,						/* closedir */
+	NULL,						/* readdir */
+	NULL,						/* rewinddir */
+
+	irqlatency_stat				/* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: irqlatency_snapshot
+ *
+ * Description:
+ *   Copy the statistics into the open file, with the sites sorted by their
+ *   longest section.
+ *
+ ****************************************************************************/
+
+static void irqlatency_snapshot(FAR struct irqlatency_file_s *attr)
+{
+	struct irqlatency_site_s tmp;
+	irqstate_t flags;
+	int i;
+	int j;
+
+	flags = irqsave();
+	memcpy(attr->irqs, g_irqlatency_irqs, sizeof(attr->irqs));
+	memcpy(attr->irqhist, g_irqlatency_irqhist, sizeof(attr->irqhist));
+	attr->dropped = g_irqlatency_dropped;
+
+	attr->nsites = 0;
+	for (i = 0; i < CONFIG_IRQ_LATENCY_NSITES; i++) {
+		if (g_irqlatency_sites[i].addr != NULL && g_irqlatency_sites[i].count != 0) {
+			attr->sites[attr->nsites++] = g_irqlatency_sites[i];
+		}
+	}
+	irqrestore(flags);
+
+	for (i = 1; i < attr->nsites; i++) {
+		tmp = attr->sites[i];
+		for (j = i; j > 0 && attr->sites[j - 1].max < tmp.max; j--) {
+			attr->sites[j] = attr->sites[j - 1];
+		}
+		attr->sites[j] = tmp;
+	}
+
+	attr->cycles_per_usec = up_perf_getfreq() / USEC_PER_SEC;
+	if (attr->cycles_per_usec == 0) {
+		attr->cycles_per_usec = 1;
+	}
+}
+
+/****************************************************************************
+ * Name: irqlatency_usec
+ *
+ * Description:
+ *   Format a duration in cycles as microseconds with two decimals.
+ *
+ ****************************************************************************/
+
+static int irqlatency_usec(FAR struct irqlatency_file_s *attr, int pos, uint64_t cycles)
+{
+	uint64_t centi = cycles * 100 / attr->cycles_per_usec;
+
+	return snprintf(&attr->line[pos], IRQLATENCY_LINELEN - pos, " %7lu.%02u", (unsigned long)(centi / 100), (unsigned int)(centi % 100));
+}
+
+/****************************************************************************
+ * Name: irqlatency_hist
+ *
+ * Description:
+ *   Format a histogram at the end of the line and terminate the line.
+ *
+ ****************************************************************************/
+
+static int irqlatency_hist(FAR struct irqlatency_file_s *attr, int pos, FAR const uint32_t *hist)
+{
+	int i;
+
+	for (i = 0; i < IRQLATENCY_NBUCKETS && pos < IRQLATENCY_LINELEN; i++) {
+		pos += snprintf(&attr->line[pos], IRQLATENCY_LINELEN - pos, " %6u", (unsigned int)hist[i]);
+	}
+
+	if (pos < IRQLATENCY_LINELEN) {
+		pos += snprintf(&attr->line[pos], IRQLATENCY_LINELEN - pos, "\n");
+	}
+
+	return pos < IRQLATENCY_LINELEN ? pos : IRQLATENCY_LINELEN - 1;
+}
+
+/****************************************************************************
+ * Name: irqlatency_open
+ ****************************************************************************/
+
+static int irqlatency_open(FAR struct file *filep, FAR const char *relpath, int oflags, mode_t mode)
+{
+	FAR struct irqlatency_file_s *attr;
+
+	fvdbg("Open '%s'\n", relpath);
+
+	/* "irqlatency" is the only acceptable value for the relpath */
+
+	if (strcmp(relpath, "irqlatency") != 0) {
+		fdbg("ERROR: relpath is '%s'\n", relpath);
+		return -ENOENT;
+	}
+
+	/* Allocate a container to hold the file attributes */
+
+	attr = (FAR struct irqlatency_file_s *)kmm_zalloc(sizeof(struct irqlatency_file_s));
+	if (!attr) {
+		fdbg("ERROR: Failed to allocate file attributes\n");
+		return -ENOMEM;
+	}
+
+	if ((oflags & O_RDONLY) != 0) {
+		irqlatency_snapshot(attr);
+	}
+
+	/* Save the attributes as the open-specific state in filep->f_priv */
+
+	filep->f_priv = (FAR void *)attr;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: irqlatency_close
+ ****************************************************************************/
+
+static int irqlatency_close(FAR struct file *filep)
+{
+	FAR struct irqlatency_file_s *attr;
+
+	/* Recover our private data from the struct file instance */
+
+	attr = (FAR struct irqlatency_file_s *)filep->f_priv;
+	DEBUGASSERT(attr);
+
+	/* Release the file attributes structure */
+
+	kmm_free(attr);
+	filep->f_priv = NULL;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: irqlatency_read
+ ****************************************************************************/
+
+static ssize_t irqlatency_read(FAR struct file *filep, FAR char *buffer, size_t buflen)
+{
+	FAR struct irqlatency_file_s *attr;
+	FAR struct irqlatency_site_s *site;
+	size_t linesize;
+	size_t copysize;
+	size_t totalsize;
+	off_t offset;
+	char label[8];
+	int i;
+
+	fvdbg("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+	/* Recover our private data from the struct file instance */
+
+	attr = (FAR struct irqlatency_file_s *)filep->f_priv;
+	DEBUGASSERT(attr);
+
+	offset = filep->f_pos;
+	totalsize = 0;
+
+	/* Latency from interrupt entry to the handler, per irq */
+
+	linesize = snprintf(attr->line, IRQLATENCY_LINELEN, "%8s %10s %10s\n", "IRQ", "COUNT", "MAX(us)");
+	copysize = procfs_memcpy(attr->line, linesize, buffer, buflen - totalsize, &offset);
+	totalsize += copysize;
+	buffer += copysize;
+
+	for (i = 0; i < NR_IRQS && totalsize < buflen; i++) {
+		if (attr->irqs[i].count == 0) {
+			continue;
+		}
+
+		linesize = snprintf(attr->line, IRQLATENCY_LINELEN, "%8d %10u", i, (unsigned int)attr->irqs[i].count);
+		linesize += irqlatency_usec(attr, linesize, attr->irqs[i].max);
+		linesize += snprintf(&attr->line[linesize], IRQLATENCY_LINELEN - linesize, "\n");
+		copysize = procfs_memcpy(attr->line, linesize, buffer, buflen - totalsize, &offset);
+		totalsize += copysize;
+		buffer += copysize;
+	}
+
+	/* Histograms: the column header gives the upper bound of each bucket */
+
+	if (totalsize < buflen) {
+		linesize = snprintf(attr->line, IRQLATENCY_LINELEN, "\n%-51s", "HISTOGRAM(us)");
+		for (i = 0; i < IRQLATENCY_NBUCKETS - 1; i++) {
+			snprintf(label, sizeof(label), "<%u", 1u << i);
+			linesize += snprintf(&attr->line[linesize], IRQLATENCY_LINELEN - linesize, " %6s", label);
+		}
+		linesize += snprintf(&attr->line[linesize], IRQLATENCY_LINELEN - linesize, " %6s\n", "more");
+		copysize = procfs_memcpy(attr->line, linesize, buffer, buflen - totalsize, &offset);
+		totalsize += copysize;
+		buffer += copysize;
+	}
+
+	if (totalsize < buflen) {
+		linesize = snprintf(attr->line, IRQLATENCY_LINELEN, "%-51s", "irq entry to handler");
+		linesize = irqlatency_hist(attr, linesize, attr->irqhist);
+		copysize = procfs_memcpy(attr->line, linesize, buffer, buflen - totalsize, &offset);
+		totalsize += copysize;
+		buffer += copysize;
+	}
+
+	/* Critical sections, longest first */
+
+	if (totalsize < buflen) {
+		linesize = snprintf(attr->line, IRQLATENCY_LINELEN, "\n%-7s %10s %10s %10s %10s\n", "TYPE", "SITE", "COUNT", "MAX(us)", "AVG(us)");
+		copysize = procfs_memcpy(attr->line, linesize, buffer, buflen - totalsize, &offset);
+		totalsize += copysize;
+		buffer += copysize;
+	}
+
+	for (i = 0; i < attr->nsites && totalsize < buflen; i++) {
+		site = &attr->sites[i];
+		linesize = snprintf(attr->line, IRQLATENCY_LINELEN, "%-7s 0x%08lx %10u",
+							site->type == IRQLATENCY_IRQSOFF ? "irq" : "preempt",
+							(unsigned long)(uintptr_t)site->addr, (unsigned int)site->count);
+		linesize += irqlatency_usec(attr, linesize, site->max);
+		linesize += irqlatency_usec(attr, linesize, site->total / site->count);
+		linesize = irqlatency_hist(attr, linesize, site->hist);
+		copysize = procfs_memcpy(attr->line, linesize, buffer, buflen - totalsize, &offset);
+		totalsize += copysize;
+		buffer += copysize;
+	}
+
+	if (attr->dropped != 0 && totalsize < buflen) {
+		linesize = snprintf(attr->line, IRQLATENCY_LINELEN, "%u sections not recorded, increase CONFIG_IRQ_LATENCY_NSITES\n", (unsigned int)attr->dropped);
+		copysize = procfs_memcpy(attr->line, linesize, buffer, buflen - totalsize, &offset);
+		totalsize += copysize;
+		buffer += copysize;
+	}
+
+	/* Update the file position */
+
+	if (totalsize > 0) {
+		filep->f_pos += totalsize;
+	}
+
+	return totalsize;
+}
+
+/****************************************************************************
+ * Name: irqlatency_write
+ ****************************************************************************/
+
+static ssize_t irqlatency_write(FAR struct file *filep, FAR const char *buffer, size_t buflen)
+{
+	irqlatency_reset();
+	return buflen;
+}
+
+/****************************************************************************
+ * Name: irqlatency_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int irqlatency_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+	FAR struct irqlatency_file_s *oldattr;
+	FAR struct irqlatency_file_s *newattr;
+
+	fvdbg("Dup %p->%p\n", oldp, newp);
+
+	/* Recover our private data from the old struct file instance */
+
+	oldattr = (FAR struct irqlatency_file_s *)oldp->f_priv;
+	DEBUGASSERT(oldattr);
+
+	/* Allocate a new container to hold the task and attribute selection */
+
+	newattr = (FAR struct irqlatency_file_s *)kmm_malloc(sizeof(struct irqlatency_file_s));
+	if (!newattr) {
+		fdbg("ERROR: Failed to allocate file attributes\n");
+		return -ENOMEM;
+	}
+
+	/* The copy the file attributes from the old attributes to the new */
+
+	memcpy(newattr, oldattr, sizeof(struct irqlatency_file_s));
+
+	/* Save the new attributes in the new file structure */
+
+	newp->f_priv = (FAR void *)newattr;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: irqlatency_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int irqlatency_stat(const char *relpath, struct stat *buf)
+{
+	/* "irqlatency" is the only acceptable value for the relpath */
+
+	if (strcmp(relpath, "irqlatency") != 0) {
+		fdbg("ERROR: relpath is '%s'\n", relpath);
+		return -ENOENT;
+	}
+
+	/* Reading gives the report, writing clears the statistics */
+
+	buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR | S_IWUSR;
+	buf->st_size = 0;
+	buf->st_blksize = 0;
+	buf->st_blocks = 0;
+	return OK;
+}
+
+#endif							/* !CONFIG_FS_PROCFS_EXCLUDE_IRQLATENCY */
+#endif							/* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS */
@@ -62,5 +62,8 @@
 int messaging_save_receiver(char *port_name, pid_t recv_pid, int recv_prio);
 int messaging_read_list(char *port_name, int *recv_arr, int *total_cnt);
 int messaging_remove_list(char *port_name);
+int messaging_read_port(int port_id, int *recv_arr, int *total_cnt);
+int messaging_open_port(char *port_name);
+int messaging_close_port(int port_id);
 void messaging_initialize(void);
 #endif							/* __KERNEL_MESSAGING_MESSAGE_CTRL_H */
@@ -74,16 +74,27 @@
 #define MSG_RECV_EXIST   0
 #define MSG_RECV_NOEXIST 1
 
+/* Port nodes are hashed by port name. The port id keeps the bucket of its
+ * port node in the low bits, so that both lookups walk a single bucket.
+ */
+#define MSG_PORT_HASH_BITS 5
+#define MSG_PORT_HASH_SIZE (1 << MSG_PORT_HASH_BITS)
+#define MSG_PORT_HASH_MASK (MSG_PORT_HASH_SIZE - 1)
+#define MSG_PORT_ID_MAX    (0x7fffffff >> MSG_PORT_HASH_BITS)
+
 /****************************************************************************
  * Private Type Declarations
  ****************************************************************************/
 struct msg_port_node_s {
 	struct msg_port_node_s *flink;
 	char port_name[MSG_MAX_PORT_NAME];
+	int port_id;
+	int nopen;
 	pid_t sender_pid;
 	int nreceiver;
 	sem_t port_sem;
 	sq_queue_t recv_node_list;
+	pid_t *recv_cache;
 };
 typedef struct msg_port_node_s msg_port_node_t;
 
@@ -103,11 +114,127 @@ static sem_t port_list_sem;
 /****************************************************************************
  * Private Variables
  ****************************************************************************/
-static sq_queue_t g_port_node_list;
-static int curr_recv_cnt;;
+static sq_queue_t g_port_node_hash[MSG_PORT_HASH_SIZE];
+static int g_port_id_seq;
+static int curr_recv_cnt;
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
+static unsigned int messaging_hash_name(const char *port_name)
+{
+	unsigned int hash = 2166136261u;
+	int len;
+
+	/* FNV-1a of the name as it is stored in the port node */
+	for (len = 0; len < MSG_MAX_PORT_NAME - 1 && port_name[len] != '\0'; len++) {
+		hash = (hash ^ (unsigned char)port_name[len]) * 16777619u;
+	}
+
+	return (hash ^ (hash >> MSG_PORT_HASH_BITS) ^ (hash >> (2 * MSG_PORT_HASH_BITS))) & MSG_PORT_HASH_MASK;
+}
+
+static msg_port_node_t *messaging_find_port(const char *port_name)
+{
+	msg_port_node_t *port_node;
+
+	port_node = (msg_port_node_t *)sq_peek(&g_port_node_hash[messaging_hash_name(port_name)]);
+	while (port_node != NULL) {
+		if (strncmp(port_node->port_name, port_name, MSG_MAX_PORT_NAME - 1) == 0) {
+			return port_node;
+		}
+		port_node = (msg_port_node_t *)sq_next(port_node);
+	}
+
+	return NULL;
+}
+
+static msg_port_node_t *messaging_find_port_id(int port_id)
+{
+	msg_port_node_t *port_node;
+
+	if (port_id <= 0) {
+		return NULL;
+	}
+
+	port_node = (msg_port_node_t *)sq_peek(&g_port_node_hash[port_id & MSG_PORT_HASH_MASK]);
+	while (port_node != NULL) {
+		if (port_node->port_id == port_id) {
+			return port_node;
+		}
+		port_node = (msg_port_node_t *)sq_next(port_node);
+	}
+
+	return NULL;
+}
+
+/****************************************************************************
+ * Name: messaging_create_port
+ *
+ * Description:
+ *   Create the port node of port_name and add it to the hash table.
+ *   The caller holds port_list_sem.
+ *
+ ****************************************************************************/
+static msg_port_node_t *messaging_create_port(const char *port_name)
+{
+	msg_port_node_t *port_node;
+	unsigned int bucket;
+
+	port_node = (msg_port_node_t *)kmm_malloc(sizeof(msg_port_node_t));
+	if (port_node == NULL) {
+		msgdbg("[Messaging] fail to create port : out of memory.\n");
+		return NULL;
+	}
+
+	/* Fill the port node information except sender_pid. */
+	strncpy(port_node->port_name, port_name, MSG_MAX_PORT_NAME - 1);
+	port_node->port_name[MSG_MAX_PORT_NAME - 1] = '\0';
+	bucket = messaging_hash_name(port_node->port_name);
+	if (++g_port_id_seq > MSG_PORT_ID_MAX) {
+		g_port_id_seq = 1;
+	}
+	port_node->port_id = (g_port_id_seq << MSG_PORT_HASH_BITS) | bucket;
+	port_node->nopen = 0;
+	port_node->sender_pid = MSG_SENDER_UNDEFINED;
+	port_node->nreceiver = 0;
+	port_node->recv_cache = NULL;
+	sem_init(&port_node->port_sem, 0, 1);
+	sq_init(&port_node->recv_node_list);
+	sq_addlast((FAR sq_entry_t *)port_node, &g_port_node_hash[bucket]);
+
+	return port_node;
+}
+
+/****************************************************************************
+ * Name: messaging_release_port
+ *
+ * Description:
+ *   Free the port node when it has neither receivers nor open handles.
+ *   The caller holds port_list_sem.
+ *
+ ****************************************************************************/
+static void messaging_release_port(msg_port_node_t *port_node)
+{
+	if (port_node->nreceiver > 0 || port_node->nopen > 0) {
+		return;
+	}
+
+	(void)sq_rem((FAR sq_entry_t *)port_node, &g_port_node_hash[port_node->port_id & MSG_PORT_HASH_MASK]);
+	sem_destroy(&port_node->port_sem);
+	if (port_node->recv_cache != NULL) {
+		kmm_free(port_node->recv_cache);
+	}
+	kmm_free(port_node);
+}
+
+static void messaging_invalidate_cache(msg_port_node_t *port_node)
+{
+	if (port_node->recv_cache != NULL) {
+		kmm_free(port_node->recv_cache);
+		port_node->recv_cache = NULL;
+	}
+}
+
 static int messaging_append_receiver(pid_t pid, int prio, sq_queue_t *queue)
 {
 	msg_recv_node_t *recv_node;
@@ -166,6 +293,75 @@ static int messaging_check_recv_exist(int recv_pid, sq_queue_t *queue)
 
 	return MSG_RECV_NOEXIST;
 }
+
+/****************************************************************************
+ * Name: messaging_read_node
+ *
+ * Description:
+ *   Read the next CONFIG_MESSAGING_RECV_LIST_SIZE receivers of the port.
+ *   The receivers are copied from the cached array of their pids, which is
+ *   built on the first read after the receivers changed.
+ *
+ * Return Value:
+ *   Return the number of receivers read into recv_arr on success.
+ *   Return ERROR on failure.
+ *
+ ****************************************************************************/
+static int messaging_read_node(msg_port_node_t *port_node, int *recv_arr, int *total_cnt)
+{
+	msg_recv_node_t *recv_node;
+	int recv_idx;
+	int recv_cnt;
+
+	sem_wait(&port_node->port_sem);
+
+	*total_cnt = port_node->nreceiver;
+	if (port_node->nreceiver <= 0) {
+		sem_post(&port_node->port_sem);
+		curr_recv_cnt = 0;
+		return 0;
+	}
+
+	if (port_node->recv_cache == NULL) {
+		port_node->recv_cache = (pid_t *)kmm_malloc(port_node->nreceiver * sizeof(pid_t));
+		if (port_node->recv_cache == NULL) {
+			sem_post(&port_node->port_sem);
+			curr_recv_cnt = 0;
+			msgdbg("[Messaging] fail to read receivers list : out of memory.\n");
+			return ERROR;
+		}
+
+		recv_node = (msg_recv_node_t *)sq_peek(&port_node->recv_node_list);
+		for (recv_idx = 0; recv_idx < port_node->nreceiver && recv_node != NULL; recv_idx++) {
+			port_node->recv_cache[recv_idx] = recv_node->pid;
+			recv_node = (msg_recv_node_t *)sq_next(recv_node);
+		}
+	}
+
+	/* Ignore already read information. */
+	if (curr_recv_cnt >= port_node->nreceiver) {
+		curr_recv_cnt = 0;
+	}
+
+	recv_cnt = port_node->nreceiver - curr_recv_cnt;
+	if (recv_cnt > CONFIG_MESSAGING_RECV_LIST_SIZE) {
+		recv_cnt = CONFIG_MESSAGING_RECV_LIST_SIZE;
+	}
+
+	/* Read receivers' information. */
+	for (recv_idx = 0; recv_idx < recv_cnt; recv_idx++) {
+		recv_arr[recv_idx] = port_node->recv_cache[curr_recv_cnt + recv_idx];
+	}
+
+	curr_recv_cnt += recv_cnt;
+	if (curr_recv_cnt == port_node->nreceiver) {
+		curr_recv_cnt = 0;
+	}
+
+	sem_post(&port_node->port_sem);
+
+	return recv_cnt;
+}
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -192,46 +388,36 @@ int messaging_save_receiver(char *port_name, pid_t recv_pid, int recv_prio)
 	int ret;
 	msg_port_node_t *port_node;
 
-	port_node = (msg_port_node_t *)sq_peek(&g_port_node_list);
-	while (port_node != NULL) {
-		if (strncmp(port_node->port_name, port_name, strlen(port_name) + 1) == 0) {
-			ret = messaging_check_recv_exist(recv_pid, &port_node->recv_node_list);
-			if (ret == MSG_RECV_EXIST) {
-				return OK;
-			}
-			port_node->nreceiver++;
-			/* There was already same port node in the list, append recv node to this list. */
-			sem_wait(&port_node->port_sem);
-			ret = messaging_append_receiver(recv_pid, recv_prio, &port_node->recv_node_list);
-			sem_post(&port_node->port_sem);
-			return ret;
-		}
-		port_node = (msg_port_node_t *)sq_next(port_node);
-	}
+	sem_wait(&port_list_sem);
 
-	/* Create new port node which has this port name */
-	port_node = (msg_port_node_t *)kmm_malloc(sizeof(msg_port_node_t));
+	port_node = messaging_find_port(port_name);
 	if (port_node == NULL) {
-		msgdbg("[Messaging] fail to save receiver info : out of memory.\n");
-		return ERROR;
+		/* Create new port node which has this port name */
+		port_node = messaging_create_port(port_name);
+		if (port_node == NULL) {
+			sem_post(&port_list_sem);
+			return ERROR;
+		}
+	} else if (messaging_check_recv_exist(recv_pid, &port_node->recv_node_list) == MSG_RECV_EXIST) {
+		sem_post(&port_list_sem);
+		return OK;
 	}
 
-	/* Fill the port node information except sender_pid. */
-	strncpy(port_node->port_name, port_name, MSG_MAX_PORT_NAME - 1);
-	port_node->port_name[MSG_MAX_PORT_NAME - 1] = '\0';
-	port_node->sender_pid = MSG_SENDER_UNDEFINED;
-	port_node->nreceiver = 1;
-	sem_init(&port_node->port_sem, 0, 1);
-	sq_init(&port_node->recv_node_list);
-	sem_wait(&port_list_sem);
-	sq_addlast((FAR sq_entry_t *)port_node, &g_port_node_list);
-	sem_post(&port_list_sem);
-
-	/* Append recv node to new created port node. */
+	/* Append recv node to the port node. */
 	sem_wait(&port_node->port_sem);
 	ret = messaging_append_receiver(recv_pid, recv_prio, &port_node->recv_node_list);
+	if (ret == OK) {
+		port_node->nreceiver++;
+		messaging_invalidate_cache(port_node);
+	}
 	sem_post(&port_node->port_sem);
 
+	if (ret != OK) {
+		messaging_release_port(port_node);
+	}
+
+	sem_post(&port_list_sem);
+
 	return ret;
 }
 
@@ -245,7 +431,7 @@ int messaging_save_receiver(char *port_name, pid_t recv_pid, int recv_prio)
  *   port_name - A message port name
  *
  * Return Value:
- *   Return the number of receivers who wait the port on success.
+ *   Return the number of receivers read into recv_arr on success.
  *   Return ERROR on failure.
  *
  * Assumptions:
@@ -253,47 +439,118 @@ int messaging_save_receiver(char *port_name, pid_t recv_pid, int recv_prio)
  ****************************************************************************/
 int messaging_read_list(char *port_name, int *recv_arr, int *total_cnt)
 {
-	int recv_idx;
 	msg_port_node_t *port_node;
-	msg_recv_node_t *recv_node;
-	int recv_cnt;
+	int ret;
 
-	port_node = (msg_port_node_t *)sq_peek(&g_port_node_list);
-	while (port_node != NULL) {
-		if (strncmp(port_node->port_name, port_name, strlen(port_name) + 1) == 0) {
-			if (port_node->nreceiver > 0) {
-				*total_cnt = port_node->nreceiver;
-
-				recv_node = (msg_recv_node_t *)sq_peek(&port_node->recv_node_list);
-				if (recv_node == NULL) {
-					curr_recv_cnt = 0;
-					msgdbg("[Messaging] fail to read receivers list.\n");
-					return ERROR;
-				}
-
-				/* Ignore already read information. */
-				for (recv_idx = 0; recv_idx < curr_recv_cnt; recv_idx++) {
-					recv_node = (msg_recv_node_t *)sq_next(recv_node);
-				}
-
-				/* Read receivers' information. */
-				for (recv_idx = 0; recv_idx < CONFIG_MESSAGING_RECV_LIST_SIZE; recv_idx++) {
-					recv_arr[recv_idx] = recv_node->pid;
-					curr_recv_cnt++;
-					recv_node = (msg_recv_node_t *)sq_next(recv_node);
-					if (recv_node == NULL) {
-						recv_cnt = curr_recv_cnt;
-						curr_recv_cnt = 0;
-						return recv_cnt;
-					}
-				}
-			}
-			return curr_recv_cnt;
-		}
-		port_node = (msg_port_node_t *)sq_next(port_node);
+	/* Hold the list so that the port is not released while it is read. */
+	sem_wait(&port_list_sem);
+
+	port_node = messaging_find_port(port_name);
+	if (port_node == NULL) {
+		sem_post(&port_list_sem);
+		return ERROR;
 	}
 
-	return ERROR;
+	ret = messaging_read_node(port_node, recv_arr, total_cnt);
+
+	sem_post(&port_list_sem);
+
+	return ret;
+}
+
+/****************************************************************************
+ * Name: messaging_read_port
+ *
+ * Description:
+ *   Same as messaging_read_list, with the port id which messaging_open_port
+ *   returned instead of the port name.
+ *
+ ****************************************************************************/
+int messaging_read_port(int port_id, int *recv_arr, int *total_cnt)
+{
+	msg_port_node_t *port_node;
+	int ret;
+
+	/* Hold the list so that the port is not released while it is read. */
+	sem_wait(&port_list_sem);
+
+	port_node = messaging_find_port_id(port_id);
+	if (port_node == NULL) {
+		sem_post(&port_list_sem);
+		return ERROR;
+	}
+
+	ret = messaging_read_node(port_node, recv_arr, total_cnt);
+
+	sem_post(&port_list_sem);
+
+	return ret;
+}
+
+/****************************************************************************
+ * Name: messaging_open_port
+ *
+ * Description:
+ *   Resolve the port name into a port id, creating the port if it has no
+ *   receivers yet. The port id stays valid until messaging_close_port.
+ *
+ * Parameters:
+ *   port_name - A message port name
+ *
+ * Return Value:
+ *   The port id (> 0) on success, ERROR on failure.
+ *
+ ****************************************************************************/
+int messaging_open_port(char *port_name)
+{
+	msg_port_node_t *port_node;
+	int port_id = ERROR;
+
+	sem_wait(&port_list_sem);
+
+	port_node = messaging_find_port(port_name);
+	if (port_node == NULL) {
+		port_node = messaging_create_port(port_name);
+	}
+
+	if (port_node != NULL) {
+		port_node->nopen++;
+		port_id = port_node->port_id;
+	}
+
+	sem_post(&port_list_sem);
+
+	return port_id;
+}
+
+/****************************************************************************
+ * Name: messaging_close_port
+ *
+ * Description:
+ *   Release the port id which messaging_open_port returned.
+ *
+ * Return Value:
+ *   OK on success, ERROR on failure.
+ *
+ ****************************************************************************/
+int messaging_close_port(int port_id)
+{
+	msg_port_node_t *port_node;
+
+	sem_wait(&port_list_sem);
+
+	port_node = messaging_find_port_id(port_id);
+	if (port_node == NULL || port_node->nopen == 0) {
+		sem_post(&port_list_sem);
+		return ERROR;
+	}
+
+	port_node->nopen--;
+	messaging_release_port(port_node);
+
+	sem_post(&port_list_sem);
+
+	return OK;
 }
 
 /****************************************************************************
@@ -345,43 +602,38 @@ static int messaging_remove_recv_node(sq_queue_t *recv_node_list)
  ****************************************************************************/
 int messaging_remove_list(char *port_name)
 {
-	int ret = ERROR;
 	msg_port_node_t *port_node;
 
-	port_node = (msg_port_node_t *)sq_peek(&g_port_node_list);
-	while (port_node != NULL) {
-		if (strncmp(port_node->port_name, port_name, strlen(port_name) + 1) == 0) {
-			/* Remove the whole recv node which attached to this port node. */
-			sem_wait(&port_node->port_sem);
-			ret = messaging_remove_recv_node(&port_node->recv_node_list);
-			if (ret == OK) {
-				port_node->nreceiver--;
-			}
-			sem_post(&port_node->port_sem);
+	sem_wait(&port_list_sem);
 
-			if (port_node->nreceiver == 0) {
-				sem_wait(&port_list_sem);
-				(void)sq_rem((FAR sq_entry_t *)port_node, &g_port_node_list);
-				sem_post(&port_list_sem);
-				kmm_free(port_node);
-			}
-			ret = OK;
-			break;
+	port_node = messaging_find_port(port_name);
+	if (port_node != NULL) {
+		/* Remove the recv node of this task which attached to this port node. */
+		sem_wait(&port_node->port_sem);
+		if (messaging_remove_recv_node(&port_node->recv_node_list) == OK) {
+			port_node->nreceiver--;
+			messaging_invalidate_cache(port_node);
 		}
-		port_node = (msg_port_node_t *)sq_next(port_node);
-	}
+		sem_post(&port_node->port_sem);
 
-	if (port_node == NULL) {
-		/* If port_node is NULL, there is no information for removing. */
-		ret = OK;
+		messaging_release_port(port_node);
 	}
 
-	return ret;
+	/* If port_node is NULL, there is no information for removing. */
+	sem_post(&port_list_sem);
+
+	return OK;
 }
 
 void messaging_initialize(void)
 {
+	int bucket;
+
 	/* Initialize a sempahore for port list */
 
 	sem_init(&port_list_sem, 0, 1);
+
+	for (bucket = 0; bucket < MSG_PORT_HASH_SIZE; bucket++) {
+		sq_init(&g_port_node_hash[bucket]);
+	}
 }
@@ -93,9 +93,11 @@
  * Description:
  *   The mq_msgfree function will return a message to the free pool of
  *   messages if it was a pre-allocated message. If the message was
- *   allocated dynamically it will be deallocated.
+ *   allocated dynamically it will be deallocated.  A message of the slab
+ *   of a queue returns to that queue.
  *
  * Inputs:
+ *   msgq - message queue which the message was sent to
  *   mqmsg - message to free
  *
  * Return Value:
@@ -103,7 +105,7 @@
  *
  ************************************************************************/
 
-void mq_msgfree(FAR struct mqueue_msg_s *mqmsg)
+void mq_msgfree(FAR struct mqueue_inode_s *msgq, FAR struct mqueue_msg_s *mqmsg)
 {
 	irqstate_t saved_state;
 
@@ -142,7 +144,18 @@ void mq_msgfree(FAR struct mqueue_msg_s *mqmsg)
 
 	else if (mqmsg->type == MQ_ALLOC_DYN) {
 		sched_kfree(mqmsg);
-	} else {
+	}
+#ifdef CONFIG_MQ_PERQUEUE_SLAB
+
+	/* A message of the slab of its queue goes back to that slab. */
+
+	else if (mqmsg->type == MQ_ALLOC_QUEUE) {
+		saved_state = irqsave();
+		sq_addlast((FAR sq_entry_t *)mqmsg, &msgq->msgfree);
+		irqrestore(saved_state);
+	}
+#endif
+	else {
 		PANIC();
 	}
 }
@@ -56,6 +56,8 @@
 
 #include <tinyara/config.h>
 
+#include <stddef.h>
+#include <stdint.h>
 #include <mqueue.h>
 #include <assert.h>
 
@@ -86,6 +88,76 @@
  * Private Functions
  ****************************************************************************/
 
+#ifdef CONFIG_MQ_PERQUEUE_SLAB
+/****************************************************************************
+ * Name: mq_slaballoc
+ *
+ * Description:
+ *   Preallocate maxmsgs messages with room for maxmsgsize bytes each.  If
+ *   that fails, the queue uses the shared pool of messages only.
+ *
+ ****************************************************************************/
+
+static void mq_slaballoc(FAR struct mqueue_inode_s *msgq)
+{
+	FAR struct mqueue_msg_s *mqmsg;
+	FAR uint8_t *slab;
+	size_t msgsize;
+	int i;
+
+	sq_init(&msgq->msgfree);
+
+	msgsize = offsetof(struct mqueue_msg_s, mail) + msgq->maxmsgsize;
+	msgsize = (msgsize + sizeof(uintptr_t) - 1) & ~(sizeof(uintptr_t) - 1);
+
+	slab = (FAR uint8_t *)kmm_malloc(msgsize * msgq->maxmsgs);
+	if (slab == NULL) {
+		return;
+	}
+
+	for (i = 0; i < msgq->maxmsgs; i++) {
+		mqmsg = (FAR struct mqueue_msg_s *)(slab + i * msgsize);
+		mqmsg->type = MQ_ALLOC_QUEUE;
+		sq_addlast((FAR sq_entry_t *)mqmsg, &msgq->msgfree);
+	}
+
+	msgq->slab = slab;
+}
+#endif
+
+#ifdef CONFIG_MQ_PRIO_INDEX
+/****************************************************************************
+ * Name: mq_prioalloc
+ *
+ * Description:
+ *   Allocate the priority index with one slot per message which the queue
+ *   can hold.  If that fails, messages are inserted by walking the list.
+ *
+ ****************************************************************************/
+
+static void mq_prioalloc(FAR struct mqueue_inode_s *msgq)
+{
+	FAR struct mq_prioindex_s *prioidx;
+	int nslots;
+
+	nslots = msgq->maxmsgs < UINT8_MAX ? msgq->maxmsgs : UINT8_MAX;
+	if (nslots == 0) {
+		return;
+	}
+
+	prioidx = (FAR struct mq_prioindex_s *)kmm_malloc(sizeof(struct mq_prioindex_s) + (nslots - 1) * sizeof(FAR struct mqueue_msg_s *) + nslots);
+	if (prioidx == NULL) {
+		return;
+	}
+
+	prioidx->nslots = nslots;
+	prioidx->freeslot = (FAR uint8_t *)&prioidx->tail[nslots];
+	mq_prioreset(prioidx);
+
+	msgq->prioidx = prioidx;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -140,6 +212,12 @@ FAR struct mqueue_inode_s *mq_msgqalloc(mode_t mode, FAR struct mq_attr *attr)
 
 #ifndef CONFIG_DISABLE_SIGNALS
 		msgq->ntpid = INVALID_PROCESS_ID;
+#endif
+#ifdef CONFIG_MQ_PERQUEUE_SLAB
+		mq_slaballoc(msgq);
+#endif
+#ifdef CONFIG_MQ_PRIO_INDEX
+		mq_prioalloc(msgq);
 #endif
 	}
 
@@ -114,10 +114,21 @@ void mq_msgqfree(FAR struct mqueue_inode_s *msgq)
 		/* Deallocate the message structure. */
 
 		next = curr->next;
-		mq_msgfree(curr);
+		mq_msgfree(msgq, curr);
 		curr = next;
 	}
 
+#ifdef CONFIG_MQ_PERQUEUE_SLAB
+	if (msgq->slab) {
+		sched_kfree(msgq->slab);
+	}
+#endif
+#ifdef CONFIG_MQ_PRIO_INDEX
+	if (msgq->prioidx) {
+		sched_kfree(msgq->prioidx);
+	}
+#endif
+
 	/* Then deallocate the message queue itself */
 
 	sched_kfree(msgq);
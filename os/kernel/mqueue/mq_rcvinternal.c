@@ -96,6 +96,81 @@
  * Public Functions
  ****************************************************************************/
 
+#ifdef CONFIG_MQ_PRIO_INDEX
+/****************************************************************************
+ * Name: mq_prioreset
+ *
+ * Description:
+ *   Forget all priorities of the index, when the queue is empty.
+ *
+ ****************************************************************************/
+
+void mq_prioreset(FAR struct mq_prioindex_s *prioidx)
+{
+	int i;
+
+	memset(prioidx->queued, 0, sizeof(prioidx->queued));
+	memset(prioidx->slot, 0, sizeof(prioidx->slot));
+	prioidx->overflow = false;
+
+	for (i = 0; i < prioidx->nslots; i++) {
+		prioidx->freeslot[i] = i;
+	}
+	prioidx->nfree = prioidx->nslots;
+}
+#endif
+
+/****************************************************************************
+ * Name: mq_msgremfirst
+ *
+ * Description:
+ *   Remove the message with the highest priority from the queue.  Called
+ *   with interrupts disabled.
+ *
+ * Parameters:
+ *   msgq - The message queue
+ *
+ * Return Value:
+ *   The removed message, or NULL if the queue is empty.
+ *
+ ****************************************************************************/
+
+FAR struct mqueue_msg_s *mq_msgremfirst(FAR struct mqueue_inode_s *msgq)
+{
+	FAR struct mqueue_msg_s *rcvmsg;
+#ifdef CONFIG_MQ_PRIO_INDEX
+	FAR struct mq_prioindex_s *prioidx = msgq->prioidx;
+	int slot;
+#endif
+
+	rcvmsg = (FAR struct mqueue_msg_s *)sq_remfirst(&msgq->msglist);
+
+#ifdef CONFIG_MQ_PRIO_INDEX
+	if (rcvmsg && prioidx) {
+		if (prioidx->overflow) {
+			/* The index is usable again once the queue is empty. */
+
+			if (msgq->msglist.head == NULL) {
+				mq_prioreset(prioidx);
+			}
+		} else {
+			/* If this was the last message of its priority, the priority
+			 * is not queued anymore.
+			 */
+
+			slot = prioidx->slot[rcvmsg->priority];
+			if (prioidx->tail[slot - 1] == rcvmsg) {
+				prioidx->queued[rcvmsg->priority >> 5] &= ~((uint32_t)1 << (rcvmsg->priority & 31));
+				prioidx->slot[rcvmsg->priority] = 0;
+				prioidx->freeslot[prioidx->nfree++] = slot - 1;
+			}
+		}
+	}
+#endif
+
+	return rcvmsg;
+}
+
 /****************************************************************************
  * Name: mq_verifyreceive
  *
@@ -195,7 +270,7 @@ FAR struct mqueue_msg_s *mq_waitreceive(mqd_t mqdes)
 
 	/* Get the message from the head of the queue */
 
-	while ((rcvmsg = (FAR struct mqueue_msg_s *)sq_remfirst(&msgq->msglist)) == NULL) {
+	while ((rcvmsg = mq_msgremfirst(msgq)) == NULL) {
 		/* The queue is empty!  Should we block until there the above condition
 		 * has been satisfied?
 		 */
@@ -294,7 +369,7 @@ ssize_t mq_doreceive(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg, FAR char *ubuf
 
 	/* We are done with the message.  Deallocate it now. */
 
-	mq_msgfree(mqmsg);
+	mq_msgfree(mqdes->msgq, mqmsg);
 
 	/* Check if any tasks are waiting for the MQ not full event. */
 
@@ -0,0 +1,143 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/************************************************************************
+ * kernel/mqueue/mq_receivebatch.c
+ ************************************************************************/
+
+/************************************************************************
+ * Included Files
+ ************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <queue.h>
+#include <mqueue.h>
+#include <debug.h>
+#include <tinyara/arch.h>
+#include <tinyara/cancelpt.h>
+
+#include "mqueue/mqueue.h"
+
+/************************************************************************
+ * Public Functions
+ ************************************************************************/
+
+/************************************************************************
+ * Name: mq_receive_batch
+ *
+ * Description:
+ *   This function receives up to 'nmsgs' messages from the message queue
+ *   specified by "mqdes", in the order in which mq_receive() would
+ *   return them.  The messages are taken from the queue in a single
+ *   critical section, which saves the overhead of one call per message
+ *   when a queue is drained.
+ *
+ *   If the message queue is empty and O_NONBLOCK was not set, the call
+ *   blocks until one message is added to the queue, and then returns the
+ *   messages which are queued.  It never waits for 'nmsgs' messages.
+ *
+ * Parameters:
+ *   mqdes - Message Queue Descriptor
+ *   msgs - Buffer of 'nmsgs' slots of 'msglen' bytes each.  Message i is
+ *          copied to msgs + i * msglen.
+ *   msglen - Size of one slot in bytes
+ *   lens - Array of 'nmsgs' entries which receives the length of each
+ *          message.
+ *   nmsgs - The maximum number of messages to receive
+ *
+ * Return Value:
+ *   On success, the number of messages received (at least one).  On
+ *   failure, -1 (ERROR) is returned and the errno is set as for
+ *   mq_receive().
+ *
+ ************************************************************************/
+
+ssize_t mq_receive_batch(mqd_t mqdes, FAR char *msgs, size_t msglen, FAR size_t *lens, int nmsgs)
+{
+	FAR struct mqueue_inode_s *msgq;
+	FAR struct mqueue_msg_s *mqmsg;
+	irqstate_t saved_state;
+	sq_queue_t received;
+	ssize_t ret;
+	int count;
+
+	DEBUGASSERT(up_interrupt_context() == false);
+
+	/* mq_receive_batch() is a cancellation point */
+	(void)enter_cancellation_point();
+
+	if (lens == NULL || nmsgs <= 0) {
+		set_errno(EINVAL);
+		leave_cancellation_point();
+		return ERROR;
+	}
+
+	if (mq_verifyreceive(mqdes, msgs, msglen) != OK) {
+		leave_cancellation_point();
+		return ERROR;
+	}
+
+	msgq = mqdes->msgq;
+	sq_init(&received);
+
+	/* Take the messages off the queue with pre-emption and interrupts
+	 * disabled, as mq_receive() does.  Only the first one may block.
+	 */
+
+	sched_lock();
+	saved_state = irqsave();
+
+	mqmsg = mq_waitreceive(mqdes);
+	if (mqmsg) {
+		sq_addlast((FAR sq_entry_t *)mqmsg, &received);
+
+		for (count = 1; count < nmsgs; count++) {
+			mqmsg = mq_msgremfirst(msgq);
+			if (mqmsg == NULL) {
+				break;
+			}
+
+			msgq->nmsgs--;
+			sq_addlast((FAR sq_entry_t *)mqmsg, &received);
+		}
+	}
+
+	irqrestore(saved_state);
+	sched_unlock();
+
+	if (received.head == NULL) {
+		leave_cancellation_point();
+		return ERROR;
+	}
+
+	/* Copy the messages out.  mq_doreceive() frees each one and wakes up
+	 * a sender waiting for room in the queue.
+	 */
+
+	count = 0;
+	while ((mqmsg = (FAR struct mqueue_msg_s *)sq_remfirst(&received)) != NULL) {
+		ret = mq_doreceive(mqdes, mqmsg, msgs + count * msglen, NULL);
+		lens[count++] = (size_t)ret;
+	}
+
+	leave_cancellation_point();
+	return count;
+}
@@ -96,6 +96,92 @@
  * Private Functions
  ****************************************************************************/
 
+#ifdef CONFIG_MQ_PRIO_INDEX
+/****************************************************************************
+ * Name: mq_prioabove
+ *
+ * Description:
+ *   Return the lowest priority above prio which has messages in the queue,
+ *   or -1 if there is none.
+ *
+ ****************************************************************************/
+
+static int mq_prioabove(FAR struct mq_prioindex_s *prioidx, int prio)
+{
+	uint32_t bits;
+	int word;
+
+	if (++prio > MQ_PRIO_MAX) {
+		return -1;
+	}
+
+	word = prio >> 5;
+	bits = prioidx->queued[word] & (0xffffffff << (prio & 31));
+
+	while (bits == 0) {
+		if (++word == MQ_PRIO_WORDS) {
+			return -1;
+		}
+		bits = prioidx->queued[word];
+	}
+
+	return (word << 5) + __builtin_ctz(bits);
+}
+
+/****************************************************************************
+ * Name: mq_prioinsert
+ *
+ * Description:
+ *   Insert the message after the last message of its priority, or after
+ *   the last message of the next higher priority, and record it as the last
+ *   message of its priority.  Returns false if the index cannot be used.
+ *
+ ****************************************************************************/
+
+static bool mq_prioinsert(FAR struct mqueue_inode_s *msgq, FAR struct mqueue_msg_s *mqmsg)
+{
+	FAR struct mq_prioindex_s *prioidx = msgq->prioidx;
+	FAR struct mqueue_msg_s *prev;
+	int prio = mqmsg->priority;
+	int above;
+	int slot;
+
+	if (prioidx == NULL || prioidx->overflow) {
+		return false;
+	}
+
+	slot = prioidx->slot[prio];
+	if (slot == 0) {
+		if (prioidx->nfree == 0) {
+			/* More priorities are queued than there are slots.  This only
+			 * happens if interrupt handlers overfill the queue.
+			 */
+
+			prioidx->overflow = true;
+			return false;
+		}
+
+		above = mq_prioabove(prioidx, prio);
+		prev = above < 0 ? NULL : prioidx->tail[prioidx->slot[above] - 1];
+
+		slot = prioidx->freeslot[--prioidx->nfree] + 1;
+		prioidx->slot[prio] = slot;
+		prioidx->queued[prio >> 5] |= (uint32_t)1 << (prio & 31);
+	} else {
+		prev = prioidx->tail[slot - 1];
+	}
+
+	if (prev) {
+		sq_addafter((FAR sq_entry_t *)prev, (FAR sq_entry_t *)mqmsg, &msgq->msglist);
+	} else {
+		sq_addfirst((FAR sq_entry_t *)mqmsg, &msgq->msglist);
+	}
+
+	prioidx->tail[slot - 1] = mqmsg;
+	return true;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -167,8 +253,11 @@ int mq_verifysend(mqd_t mqdes, FAR const char *msg, size_t msglen, int prio)
  *   the g_msgfreeirq list.  If this is unsuccessful, the calling interrupt
  *   handler will be notified.
  *
+ *   If the queue has a slab of preallocated messages, a free message of
+ *   the slab is used first.
+ *
  * Inputs:
- *   None
+ *   msgq - The message queue which the message is sent to
  *
  * Return Value:
  *   A reference to the allocated msg structure.
@@ -178,11 +267,23 @@ int mq_verifysend(mqd_t mqdes, FAR const char *msg, size_t msglen, int prio)
  *
  ****************************************************************************/
 
-FAR struct mqueue_msg_s *mq_msgalloc(void)
+FAR struct mqueue_msg_s *mq_msgalloc(FAR struct mqueue_inode_s *msgq)
 {
 	FAR struct mqueue_msg_s *mqmsg;
 	irqstate_t saved_state;
 
+#ifdef CONFIG_MQ_PERQUEUE_SLAB
+	/* Messages of the queue's own slab do not compete with other queues. */
+
+	saved_state = irqsave();
+	mqmsg = (FAR struct mqueue_msg_s *)sq_remfirst(&msgq->msgfree);
+	irqrestore(saved_state);
+
+	if (mqmsg) {
+		return mqmsg;
+	}
+#endif
+
 	/* If we were called from an interrupt handler, then try to get the message
 	 * from generally available list of messages. If this fails, then try the
 	 * list of messages reserved for interrupt handlers
@@ -330,6 +431,50 @@ int mq_waitsend(mqd_t mqdes)
 	return OK;
 }
 
+/****************************************************************************
+ * Name: mq_msginsert
+ *
+ * Description:
+ *   Insert the message in the message list of the queue, which is kept in
+ *   descending priority order, after the messages of the same priority.
+ *   Called with interrupts disabled.
+ *
+ * Parameters:
+ *   msgq - The message queue
+ *   mqmsg - The message, with its priority set
+ *
+ * Return Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void mq_msginsert(FAR struct mqueue_inode_s *msgq, FAR struct mqueue_msg_s *mqmsg)
+{
+	FAR struct mqueue_msg_s *next;
+	FAR struct mqueue_msg_s *prev;
+	int prio = mqmsg->priority;
+
+#ifdef CONFIG_MQ_PRIO_INDEX
+	if (mq_prioinsert(msgq, mqmsg)) {
+		return;
+	}
+#endif
+
+	/* Search the message list to find the location to insert the new
+	 * message. Each is list is maintained in ascending priority order.
+	 */
+
+	for (prev = NULL, next = (FAR struct mqueue_msg_s *)msgq->msglist.head; next && prio <= next->priority; prev = next, next = next->next) ;
+
+	/* Add the message at the right place */
+
+	if (prev) {
+		sq_addafter((FAR sq_entry_t *)prev, (FAR sq_entry_t *)mqmsg, &msgq->msglist);
+	} else {
+		sq_addfirst((FAR sq_entry_t *)mqmsg, &msgq->msglist);
+	}
+}
+
 /****************************************************************************
  * Name: mq_dosend
  *
@@ -357,8 +502,6 @@ int mq_dosend(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg, FAR const char *msg,
 {
 	FAR struct tcb_s *btcb;
 	FAR struct mqueue_inode_s *msgq;
-	FAR struct mqueue_msg_s *next;
-	FAR struct mqueue_msg_s *prev;
 	irqstate_t saved_state;
 
 	trace_begin(TTRACE_TAG_IPC, "mq_dosend");
@@ -380,20 +523,7 @@ int mq_dosend(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg, FAR const char *msg,
 	/* Insert the new message in the message queue */
 
 	saved_state = irqsave();
-
-	/* Search the message list to find the location to insert the new
-	 * message. Each is list is maintained in ascending priority order.
-	 */
-
-	for (prev = NULL, next = (FAR struct mqueue_msg_s *)msgq->msglist.head; next && prio <= next->priority; prev = next, next = next->next) ;
-
-	/* Add the message at the right place */
-
-	if (prev) {
-		sq_addafter((FAR sq_entry_t *)prev, (FAR sq_entry_t *)mqmsg, &msgq->msglist);
-	} else {
-		sq_addfirst((FAR sq_entry_t *)mqmsg, &msgq->msglist);
-	}
+	mq_msginsert(msgq, mqmsg);
 
 	/* Increment the count of messages in the queue */
 
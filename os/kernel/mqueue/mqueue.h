@@ -99,7 +99,8 @@
 enum mqalloc_e {
 	MQ_ALLOC_FIXED = 0,			/* pre-allocated; never freed */
 	MQ_ALLOC_DYN,				/* dynamically allocated; free when unused */
-	MQ_ALLOC_IRQ				/* Preallocated, reserved for interrupt handling */
+	MQ_ALLOC_IRQ,				/* Preallocated, reserved for interrupt handling */
+	MQ_ALLOC_QUEUE				/* Preallocated in the slab of one message queue */
 };
 
 /* This structure describes one buffered POSIX message. */
@@ -112,6 +113,26 @@ struct mqueue_msg_s {
 	char mail[MQ_MAX_BYTES];		/* Message data */
 };
 
+#ifdef CONFIG_MQ_PRIO_INDEX
+/* This structure locates the priorities in the message list of a queue.
+ * The messages of one priority are contiguous in the list, so a new message
+ * goes after the last message of its own priority or, if there is none,
+ * after the last message of the next higher priority which is queued.
+ */
+
+#define MQ_PRIO_WORDS  ((MQ_PRIO_MAX + 32) / 32)
+
+struct mq_prioindex_s {
+	uint32_t queued[MQ_PRIO_WORDS];	/* Bit set for each priority which is queued */
+	uint8_t slot[MQ_PRIO_MAX + 1];	/* 1 + index of the priority in tail[], or 0 */
+	bool overflow;					/* More priorities than slots, index not used */
+	uint8_t nslots;					/* Number of entries in tail[] */
+	uint8_t nfree;					/* Number of free entries in freeslot[] */
+	FAR uint8_t *freeslot;			/* Indexes of unused entries in tail[] */
+	FAR struct mqueue_msg_s *tail[1];	/* Last message of each queued priority */
+};
+#endif
+
 /****************************************************************************
  * Public Variables
  ****************************************************************************/
@@ -155,7 +176,7 @@ void weak_function mq_initialize(void);
 void mq_desblockalloc(void);
 
 FAR struct mqueue_inode_s *mq_findnamed(FAR const char *mq_name);
-void mq_msgfree(FAR struct mqueue_msg_s *mqmsg);
+void mq_msgfree(FAR struct mqueue_inode_s *msgq, FAR struct mqueue_msg_s *mqmsg);
 
 /* mq_waitirq.c ************************************************************/
 
@@ -165,12 +186,17 @@ void mq_waitirq(FAR struct tcb_s *wtcb, int errcode);
 
 int mq_verifyreceive(mqd_t mqdes, FAR char *msg, size_t msglen);
 FAR struct mqueue_msg_s *mq_waitreceive(mqd_t mqdes);
+FAR struct mqueue_msg_s *mq_msgremfirst(FAR struct mqueue_inode_s *msgq);
+#ifdef CONFIG_MQ_PRIO_INDEX
+void mq_prioreset(FAR struct mq_prioindex_s *prioidx);
+#endif
 ssize_t mq_doreceive(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg, FAR char *ubuffer, FAR int *prio);
 
 /* mq_sndinternal.c ********************************************************/
 
 int mq_verifysend(mqd_t mqdes, FAR const char *msg, size_t msglen, int prio);
-FAR struct mqueue_msg_s *mq_msgalloc(void);
+FAR struct mqueue_msg_s *mq_msgalloc(FAR struct mqueue_inode_s *msgq);
+void mq_msginsert(FAR struct mqueue_inode_s *msgq, FAR struct mqueue_msg_s *mqmsg);
 int mq_waitsend(mqd_t mqdes);
 int mq_dosend(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg, FAR const char *msg, size_t msglen, int prio);
 
@@ -139,6 +139,20 @@ void pthread_mutex_inconsistent(FAR struct pthread_tcb_s *tcb);
 #define pthread_mutex_give(m)   pthread_sem_give(&(m)->sem)
 #endif
 
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+void pthread_mutex_claim(FAR struct pthread_mutex_s *mutex);
+
+/* The pid to store when the mutex is released.  If the semaphore is passed
+ * to a waiter, the user-space fast path must not take the mutex before the
+ * waiter has stored its own pid.
+ */
+
+#define pthread_mutex_nopid(m) ((m)->sem.semcount < 0 ? _PTHREAD_MUTEX_HANDOFF : -1)
+#else
+#define pthread_mutex_claim(m)
+#define pthread_mutex_nopid(m) (-1)
+#endif
+
 #if defined(CONFIG_CANCELLATION_POINTS) && !defined(CONFIG_PTHREAD_MUTEX_UNSAFE)
 uint16_t pthread_disable_cancel(void);
 void pthread_enable_cancel(uint16_t oldstate);
@@ -212,6 +212,12 @@ int pthread_cond_timedwait(FAR pthread_cond_t *cond, FAR pthread_mutex_t *mutex,
 	/* pthread_cond_timedwait() is a cancellation point */
 	(void)enter_cancellation_point();
 
+	/* Take over the mutex if it was locked from user space */
+
+	if (mutex != NULL) {
+		pthread_mutex_claim(mutex);
+	}
+
 	/* Make sure that non-NULL references were provided. */
 
 	if (!cond || !mutex) {
@@ -277,7 +283,7 @@ int pthread_cond_timedwait(FAR pthread_cond_t *cond, FAR pthread_mutex_t *mutex,
 				} else {
 					/* Give up the mutex */
 
-					mutex->pid = -1;
+					mutex->pid = pthread_mutex_nopid(mutex);
 					ret = pthread_mutex_give(mutex);
 					if (ret != 0) {
 						/* Restore interrupts  (pre-emption will be enabled when
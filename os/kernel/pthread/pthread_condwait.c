@@ -96,6 +96,12 @@ int pthread_cond_wait(FAR pthread_cond_t *cond, FAR pthread_mutex_t *mutex)
 	/* pthread_cond_wait() is a cancellation point */
 	(void)enter_cancellation_point();
 
+	/* Take over the mutex if it was locked from user space */
+
+	if (mutex != NULL) {
+		pthread_mutex_claim(mutex);
+	}
+
 	/* Make sure that non-NULL references were provided. */
 
 	if (cond == NULL || mutex == NULL) {
@@ -114,7 +120,7 @@ int pthread_cond_wait(FAR pthread_cond_t *cond, FAR pthread_mutex_t *mutex)
 		svdbg("Give up mutex / take cond\n");
 
 		sched_lock();
-		mutex->pid = -1;
+		mutex->pid = pthread_mutex_nopid(mutex);
 		ret = pthread_mutex_give(mutex);
 
 		/* Take the semaphore */
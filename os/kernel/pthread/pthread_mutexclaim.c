@@ -0,0 +1,128 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <tinyara/irq.h>
+#include <tinyara/sched.h>
+
+#include "semaphore/semaphore.h"
+#include "pthread/pthread.h"
+
+#ifdef CONFIG_PTHREAD_MUTEX_FASTPATH
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct pthread_fastowner_s {
+	uintptr_t sp;				/* Stack address stored by the fast path */
+	FAR struct tcb_s *tcb;		/* The task whose stack contains 'sp' */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void pthread_mutex_findowner(FAR struct tcb_s *tcb, FAR void *arg)
+{
+	FAR struct pthread_fastowner_s *owner = (FAR struct pthread_fastowner_s *)arg;
+
+	if (owner->tcb == NULL && tcb->stack_alloc_ptr != NULL &&
+		owner->sp >= (uintptr_t)tcb->stack_alloc_ptr &&
+		owner->sp < (uintptr_t)tcb->adj_stack_ptr) {
+		owner->tcb = tcb;
+	}
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_mutex_claim
+ *
+ * Description:
+ *   Convert a mutex locked by the user-space fast path into a mutex locked
+ *   through the kernel: take the count of the underlying semaphore on
+ *   behalf of the owner, record the owner as the semaphore holder so that
+ *   its priority can be boosted, and store its pid.  This must be done
+ *   before the caller inspects the owner or blocks on the semaphore.
+ *
+ * Parameters:
+ *   mutex - The mutex which is about to be operated on in the kernel
+ *
+ * Return Value:
+ *   None
+ *
+ * Assumptions:
+ *   The conversion is done with interrupts disabled, so the caller does not
+ *   need to disable pre-emption.
+ *
+ ****************************************************************************/
+
+void pthread_mutex_claim(FAR struct pthread_mutex_s *mutex)
+{
+	struct pthread_fastowner_s owner;
+	irqstate_t flags;
+	int pid;
+
+	flags = irqsave();
+
+	pid = mutex->pid;
+	if (pid > 0 && (pid & _PTHREAD_MUTEX_FASTOWNED) != 0) {
+		/* The fast path leaves the semaphore untouched */
+
+		DEBUGASSERT(mutex->sem.semcount == 1);
+		mutex->sem.semcount = 0;
+
+		owner.sp = _PTHREAD_MUTEX_FASTSTACK(pid);
+		owner.tcb = NULL;
+		sched_foreach(pthread_mutex_findowner, &owner);
+		DEBUGASSERT(owner.tcb != NULL);
+
+		if (owner.tcb != NULL) {
+			sem_addholder_tcb(owner.tcb, &mutex->sem);
+			mutex->pid = owner.tcb->pid;
+		} else {
+			/* The owner has gone.  Keep the mutex locked, but make sure that
+			 * the fast path cannot release it anymore.
+			 */
+
+			mutex->pid = pid & ~_PTHREAD_MUTEX_FASTOWNED;
+		}
+#ifdef CONFIG_PTHREAD_MUTEX_TYPES
+		mutex->nlocks = 1;
+#endif
+		svdbg("mutex=0x%p claimed for %d\n", mutex, mutex->pid);
+	}
+
+	irqrestore(flags);
+}
+
+#endif							/* CONFIG_PTHREAD_MUTEX_FASTPATH */
@@ -125,6 +125,10 @@ int pthread_mutex_destroy(FAR pthread_mutex_t *mutex)
 
 		sched_lock();
 
+		/* Take over the mutex if it was locked from user space */
+
+		pthread_mutex_claim(mutex);
+
 		/* Is the semaphore available? */
 
 		if (mutex->pid >= 0) {
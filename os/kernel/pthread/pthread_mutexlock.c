@@ -157,6 +157,10 @@ int pthread_mutex_lock(FAR pthread_mutex_t *mutex)
 
 		sched_lock();
 
+		/* Take over the mutex if it was locked from user space */
+
+		pthread_mutex_claim(mutex);
+
 #ifdef CONFIG_PTHREAD_MUTEX_TYPES
 		/* All mutex types except for NORMAL (and DEFAULT) will return
 		 * and an error  error if the caller does not hold the mutex.
@@ -137,6 +137,10 @@ int pthread_mutex_trylock(FAR pthread_mutex_t *mutex)
 
 		sched_lock();
 
+		/* Take over the mutex if it was locked from user space */
+
+		pthread_mutex_claim(mutex);
+
 		/* Try to get the semaphore. */
 
 		status = pthread_mutex_trytake(mutex);
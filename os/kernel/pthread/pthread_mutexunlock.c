@@ -160,6 +160,10 @@ int pthread_mutex_unlock(FAR pthread_mutex_t *mutex)
 	 */
 	sched_lock();
 
+	/* Take over the mutex if it was locked from user space */
+
+	pthread_mutex_claim(mutex);
+
 	/* The unlock operation is only performed if the mutex is actually locked.
 	 * EPERM *must* be returned if the mutex type is PTHREAD_MUTEX_ERRORCHECK
 	 * or PTHREAD_MUTEX_RECURSIVE, or the mutex is a robust mutex, and the
@@ -239,7 +243,7 @@ int pthread_mutex_unlock(FAR pthread_mutex_t *mutex)
 			{
 				/* Nullify the pid and lock count then post the semaphore */
 
-				mutex->pid = -1;
+				mutex->pid = pthread_mutex_nopid(mutex);
 #ifdef CONFIG_PTHREAD_MUTEX_TYPES
 				mutex->nlocks = 0;
 #endif
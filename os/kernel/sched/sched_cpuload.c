@@ -239,6 +239,9 @@ void weak_function sched_process_cpuload(void)
 			g_cpusnap_head = 0;
 		}
 	}
+#ifdef CONFIG_SCHED_PROFILER
+	sched_profile_sample();
+#endif
 	hash_index = PIDHASH(rtcb->pid);
 
 	for (cpuload_idx = 0; cpuload_idx < SCHED_NCPULOAD; cpuload_idx++) {
@@ -60,6 +60,7 @@
 #include <assert.h>
 
 #include <tinyara/arch.h>
+#include <tinyara/irqlatency.h>
 #include "sched/sched.h"
 
 /************************************************************************
@@ -119,7 +120,9 @@ int sched_lock(void)
 
 	if (rtcb && !up_interrupt_context()) {
 		ASSERT(rtcb->lockcount < MAX_LOCK_COUNT);
-		rtcb->lockcount++;
+		if (rtcb->lockcount++ == 0) {
+			irqlatency_preempt_off(__builtin_return_address(0));
+		}
 	}
 
 	return OK;
@@ -62,6 +62,7 @@
 #include <sched.h>
 #include <tinyara/arch.h>
 #include <tinyara/ttrace.h>
+#include <tinyara/perf.h>
 #endif
 
 #include "sched/sched.h"
@@ -217,6 +218,12 @@ void sched_process_timer(void)
 	}
 #endif
 
+	/* Charge the counted events to the running task on every tick too, so
+	 * that the 32-bit counters cannot wrap while a task runs for long.
+	 */
+
+	perf_update(this_task());
+
 	/* Check if the currently executing task has exceeded its
 	 * timeslice.
 	 */
@@ -0,0 +1,243 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <semaphore.h>
+
+#include <tinyara/arch.h>
+#include <tinyara/sched.h>
+#include <tinyara/kmalloc.h>
+#include <tinyara/cpuload.h>
+#include <arch/irq.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_PROFILER
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Samples of the current session.  Entries below g_prof_count are
+ * complete: the count is only advanced by the timer interrupt once the
+ * sample has been written.
+ */
+
+static FAR struct cpuload_sample_s *g_prof_samples;
+static uint32_t g_prof_size;
+static volatile uint32_t g_prof_count;
+static volatile uint32_t g_prof_dropped;
+
+static uint16_t g_prof_period;
+static uint16_t g_prof_countdown;
+static volatile bool g_prof_running;
+
+/* Serializes starting, reading and clearing the sessions, so that the
+ * samples are not freed while they are copied out.
+ */
+
+static sem_t g_prof_sem = SEM_INITIALIZER(1);
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_profile_sample
+ *
+ * Description:
+ *   Called from sched_process_cpuload() on every CPU load tick, with
+ *   interrupts disabled.  Records the interrupted task and call stack once
+ *   per sampling period.  Samples which do not fit into the session are
+ *   only counted.
+ *
+ ****************************************************************************/
+
+void sched_profile_sample(void)
+{
+	FAR struct cpuload_sample_s *sample;
+
+	if (!g_prof_running || --g_prof_countdown > 0) {
+		return;
+	}
+
+	g_prof_countdown = g_prof_period;
+
+	if (g_prof_count >= g_prof_size) {
+		g_prof_dropped++;
+		return;
+	}
+
+	sample = &g_prof_samples[g_prof_count];
+	sample->pid = this_task()->pid;
+	sample->depth = up_perf_callstack(sample->pc, CPULOAD_PROFILE_DEPTH);
+	sample->reserved = 0;
+	g_prof_count++;
+}
+
+/****************************************************************************
+ * Name: sched_start_profile
+ *
+ * Description:
+ *   Start a new profiling session which keeps up to cfg->nsamples samples,
+ *   taken every cfg->period CPU load ticks.  The samples of the previous
+ *   session are discarded.
+ *
+ * Returned Value:
+ *   OK on success; -EINVAL, -EBUSY if a session is running or -ENOMEM.
+ *
+ ****************************************************************************/
+
+int sched_start_profile(FAR const struct cpuload_profile_s *cfg)
+{
+	FAR struct cpuload_sample_s *samples;
+	FAR struct cpuload_sample_s *old;
+	irqstate_t flags;
+
+	if (cfg == NULL || cfg->nsamples == 0 || cfg->period == 0 || cfg->nsamples > UINT32_MAX / sizeof(struct cpuload_sample_s)) {
+		return -EINVAL;
+	}
+
+	while (sem_wait(&g_prof_sem) < 0);
+
+	if (g_prof_running) {
+		sem_post(&g_prof_sem);
+		return -EBUSY;
+	}
+
+	samples = (FAR struct cpuload_sample_s *)kmm_malloc(cfg->nsamples * sizeof(struct cpuload_sample_s));
+	if (samples == NULL) {
+		sem_post(&g_prof_sem);
+		return -ENOMEM;
+	}
+
+	flags = irqsave();
+	old = g_prof_samples;
+	g_prof_samples = samples;
+	g_prof_size = cfg->nsamples;
+	g_prof_count = 0;
+	g_prof_dropped = 0;
+	g_prof_period = cfg->period;
+	g_prof_countdown = cfg->period;
+	g_prof_running = true;
+	irqrestore(flags);
+
+	if (old != NULL) {
+		kmm_free(old);
+	}
+
+	sem_post(&g_prof_sem);
+	return OK;
+}
+
+/****************************************************************************
+ * Name: sched_stop_profile
+ *
+ * Description:
+ *   Stop sampling.  The samples stay readable until the next session is
+ *   started or sched_clear_profile() is called.
+ *
+ ****************************************************************************/
+
+void sched_stop_profile(void)
+{
+	g_prof_running = false;
+}
+
+/****************************************************************************
+ * Name: sched_read_profile
+ *
+ * Description:
+ *   Copy the samples from req->pos on into req->samples.  The session may
+ *   still be running.
+ *
+ * Returned Value:
+ *   The number of samples copied, or a negated errno value.
+ *
+ ****************************************************************************/
+
+int sched_read_profile(FAR struct cpuload_profread_s *req)
+{
+	uint32_t count;
+	uint32_t n;
+
+	if (req == NULL || req->samples == NULL) {
+		return -EINVAL;
+	}
+
+	while (sem_wait(&g_prof_sem) < 0);
+
+	count = g_prof_count;
+	req->dropped = g_prof_dropped;
+
+	n = 0;
+	if (req->pos < count) {
+		n = count - req->pos;
+		if (n > req->nsamples) {
+			n = req->nsamples;
+		}
+
+		memcpy(req->samples, &g_prof_samples[req->pos], n * sizeof(struct cpuload_sample_s));
+		req->pos += n;
+	}
+
+	sem_post(&g_prof_sem);
+	return (int)n;
+}
+
+/****************************************************************************
+ * Name: sched_clear_profile
+ *
+ * Description:
+ *   Stop sampling and free the samples of the session.
+ *
+ ****************************************************************************/
+
+void sched_clear_profile(void)
+{
+	FAR struct cpuload_sample_s *old;
+	irqstate_t flags;
+
+	while (sem_wait(&g_prof_sem) < 0);
+
+	flags = irqsave();
+	g_prof_running = false;
+	old = g_prof_samples;
+	g_prof_samples = NULL;
+	g_prof_size = 0;
+	g_prof_count = 0;
+	irqrestore(flags);
+
+	if (old != NULL) {
+		kmm_free(old);
+	}
+
+	sem_post(&g_prof_sem);
+}
+
+#endif							/* CONFIG_SCHED_PROFILER */
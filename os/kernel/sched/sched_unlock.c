@@ -58,6 +58,7 @@
 
 #include <tinyara/clock.h>
 #include <tinyara/arch.h>
+#include <tinyara/irqlatency.h>
 
 #include "sched/sched.h"
 
@@ -128,6 +129,7 @@ int sched_unlock(void)
 
 		if (rtcb->lockcount <= 0) {
 			rtcb->lockcount = 0;
+			irqlatency_preempt_on();
 
 			/* Release any ready-to-run tasks that have collected in
 			 * g_pendingtasks.
@@ -63,6 +63,7 @@
 #include <tinyara/arch.h>
 #include <tinyara/sched.h>
 #include <tinyara/mm/mm.h>
+#include <tinyara/ttrace.h>
 
 #include "sched/sched.h"
 #include "semaphore/semaphore.h"
@@ -140,6 +141,7 @@ void sem_unblock_task(sem_t *sem, struct tcb_s *htcb)
 #endif
 			/* Restart the waiting task. */
 
+			ttrace_sem_wake(sem, stcb);
 			up_unblock_task(stcb);
 		}
 	}
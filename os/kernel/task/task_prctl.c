@@ -95,6 +95,38 @@
  * Private Functions
  ************************************************************************/
 
+#ifdef CONFIG_MESSAGING_IPC
+/************************************************************************
+ * Name: messaging_read_status
+ *
+ * Description:
+ *   Report one batch of receivers read by PR_MSG_READ or PR_MSG_READ_PORT.
+ *   recv_cnt gets the number of receivers in the batch, and the batches
+ *   are counted until all receivers of the port were read.
+ *
+ ************************************************************************/
+
+static int messaging_read_status(int ret, int total_cnt, int *recv_cnt)
+{
+	static int curr_cnt = 0;
+
+	if (ret == ERROR) {
+		curr_cnt = 0;
+		return ret;
+	}
+
+	curr_cnt += ret;
+	*recv_cnt = ret;
+	if (curr_cnt >= total_cnt) {
+		/* Read whole receivers information. */
+		curr_cnt = 0;
+		return MSG_READ_ALL;
+	}
+
+	return MSG_READ_YET;
+}
+#endif
+
 /************************************************************************
  * Public Functions
  ************************************************************************/
@@ -209,23 +241,40 @@ int prctl(int option, ...)
 		int *recv_arr = va_arg(ap, int *);
 		int *recv_cnt = va_arg(ap, int *);
 		int total_cnt;
-		static int curr_cnt = 0;
 		int ret;
 		ret = messaging_read_list(port_name, recv_arr, &total_cnt);
-		if (ret == ERROR) {
-			va_end(ap);
-			return ret;
-		}
-		curr_cnt += ret;
-		*recv_cnt = curr_cnt;
 		va_end(ap);
-		if (curr_cnt == total_cnt) {
-			/* Read whole receivers information. */
-			curr_cnt = 0;
-			return MSG_READ_ALL;
-		} else {
-			return MSG_READ_YET;
-		}
+		return messaging_read_status(ret, total_cnt, recv_cnt);
+	}
+	break;
+	case PR_MSG_READ_PORT:
+	{
+		int port_id = va_arg(ap, int);
+		int *recv_arr = va_arg(ap, int *);
+		int *recv_cnt = va_arg(ap, int *);
+		int total_cnt;
+		int ret;
+		ret = messaging_read_port(port_id, recv_arr, &total_cnt);
+		va_end(ap);
+		return messaging_read_status(ret, total_cnt, recv_cnt);
+	}
+	break;
+	case PR_MSG_OPEN:
+	{
+		int ret;
+		char *port_name = va_arg(ap, char *);
+		ret = messaging_open_port(port_name);
+		va_end(ap);
+		return ret;
+	}
+	break;
+	case PR_MSG_CLOSE:
+	{
+		int ret;
+		int port_id = va_arg(ap, int);
+		ret = messaging_close_port(port_id);
+		va_end(ap);
+		return ret;
 	}
 	break;
 	case PR_MSG_REMOVE:
@@ -241,6 +290,9 @@ int prctl(int option, ...)
 	case PR_MSG_SAVE:
 	case PR_MSG_READ:
 	case PR_MSG_REMOVE:
+	case PR_MSG_OPEN:
+	case PR_MSG_CLOSE:
+	case PR_MSG_READ_PORT:
 	{
 		sdbg("Not supported.\n");
 		err = ENOSYS;
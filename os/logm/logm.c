@@ -37,6 +37,7 @@ int g_logm_tail;
 int g_logm_dropmsg_count;
 int g_logm_overflow_offset = -1;
 
+#ifndef CONFIG_LOGM_BINARY
 static void logm_putc(FAR struct lib_outstream_s *this, int ch)
 {
 	if ((g_logm_tail + this->nput + 1) % logm_bufsize != g_logm_head) {
@@ -73,17 +74,43 @@ static void logm_flush(struct lib_outstream_s *stream)
 	sched_unlock();
 }
 #endif
+#endif							/* !CONFIG_LOGM_BINARY */
 
 /* logm_internal hook for syslog & printfs */
 int logm_internal(int flag, int indx, int priority, const char *fmt, va_list ap)
 {
-	irqstate_t flags;
 	int ret = 0;
 	struct lib_outstream_s strm;
+#ifndef CONFIG_LOGM_BINARY
+	irqstate_t flags;
 #ifdef CONFIG_LOGM_TIMESTAMP
 	struct timespec ts;
 #endif
+#endif
+
+#ifdef CONFIG_LOGM_BINARY
+	/* Queue a binary record to be formatted by logm_task.  Interrupts stay
+	 * enabled, so this is done from interrupt handlers as well.
+	 */
+
+	if (LOGM_STATUS(LOGM_READY) && !LOGM_STATUS(LOGM_BUFFER_RESIZE_REQ) && flag == LOGM_NORMAL) {
+		va_list bap;
+
+		va_copy(bap, ap);
+		ret = logm_bin_put(priority, fmt, bap);
+		va_end(bap);
+		if (ret >= 0) {
+			return ret;
+		}
+	}
 
+	/* Low Output: The buffer holds binary records, so it is not flushed here */
+#ifdef CONFIG_ARCH_LOWPUTC
+	lib_lowoutstream(&strm);
+	ret = lib_vsprintf(&strm, fmt, ap);
+#endif
+	return ret;
+#else
 	if (LOGM_STATUS(LOGM_READY) && !LOGM_STATUS(LOGM_BUFFER_RESIZE_REQ) \
 		&& flag == LOGM_NORMAL && !up_interrupt_context()) {
 
@@ -124,6 +151,7 @@ int logm_internal(int flag, int indx, int priority, const char *fmt, va_list ap)
 	}
 
 	return ret;
+#endif
 }
 
 /* logm api */
@@ -20,6 +20,7 @@
 
 #include <tinyara/config.h>
 #include <stdint.h>
+#include <stdarg.h>
 
 /****************************************************************************
  * Preprocessor Definitions
@@ -51,6 +52,39 @@
 #define LOGM_STATUS_SET(a) (logm_status |= (a))
 #define LOGM_STATUS_CLEAR(a) (logm_status &= ~(a))
 
+#ifdef CONFIG_LOGM_BINARY
+/* Binary records.  A record starts with struct logm_bin_hdr_s, followed by
+ * the format string if it is not referenced by address, followed by the
+ * arguments in the order of the format:  an int for each '*' width or
+ * precision, 4 bytes for int, long and pointer values, 8 bytes for long
+ * long and double values and NUL-terminated strings.  Records are padded
+ * to a multiple of 4 bytes and the tag is written last.
+ */
+
+#ifdef CONFIG_LOGM_BINARY_RECORDSIZE
+#define LOGM_BIN_RECORDSIZE CONFIG_LOGM_BINARY_RECORDSIZE
+#else
+#define LOGM_BIN_RECORDSIZE (128)
+#endif
+
+#define LOGM_BIN_MAGIC 0x4c4d
+#define LOGM_BIN_TAG(len) (((uint32_t)LOGM_BIN_MAGIC << 16) | (uint32_t)(len))
+#define LOGM_BIN_TAGLEN(tag) ((int)((tag) & 0xffff))
+#define LOGM_BIN_TAGVALID(tag) (((tag) >> 16) == LOGM_BIN_MAGIC)
+#define LOGM_BIN_ALIGN(x) (((x) + 3) & ~3)
+
+#define LOGM_BIN_INLINEFMT BIT(0)	/* The format string follows the header */
+
+struct logm_bin_hdr_s {
+	uint32_t tag;				/* LOGM_BIN_TAG(length of the record) */
+	uint32_t ticks;				/* System time in clock ticks */
+	int16_t pid;				/* The task which logged the message */
+	uint8_t priority;			/* Log level */
+	uint8_t flags;				/* LOGM_BIN_xxx */
+	uint32_t fmt;				/* Address of the format string */
+};
+#endif
+
 /****************************************************************************
  * Private Declarations
  ****************************************************************************/
@@ -74,12 +108,19 @@ EXTERN int logm_bufsize;
 EXTERN uint8_t logm_status;
 EXTERN volatile int new_logm_bufsize;
 EXTERN volatile int logm_print_interval;
+#ifdef CONFIG_LOGM_BINARY
+EXTERN volatile int g_logm_bin_writers;
+#endif
 
 /************************************************************************************
  * Private Function Prototypes
  ************************************************************************************/
 int logm_task(int argc, char *argv[]);
 void logm_register_tashcmds(void);
+#ifdef CONFIG_LOGM_BINARY
+int logm_bin_put(int priority, const char *fmt, va_list ap);
+void logm_bin_flush(void);
+#endif
 
 #undef EXTERN
 #if defined(__cplusplus)
@@ -0,0 +1,691 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdarg.h>
+#include <string.h>
+#include <unistd.h>
+#include <assert.h>
+
+#include <tinyara/arch.h>
+#include <tinyara/clock.h>
+#include <tinyara/logm.h>
+
+#include "logm.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define LOGM_BIN_SPECSIZE 24	/* Longest conversion specification printed */
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* Kinds of arguments of a conversion specification */
+
+enum logm_bin_arg_e {
+	LOGM_BIN_ARG_NONE,			/* "%%" or an unknown conversion */
+	LOGM_BIN_ARG_INT,
+	LOGM_BIN_ARG_LONG,
+	LOGM_BIN_ARG_LLONG,
+	LOGM_BIN_ARG_PTR,
+	LOGM_BIN_ARG_DOUBLE,
+	LOGM_BIN_ARG_STR,
+	LOGM_BIN_ARG_COUNT			/* "%n", nothing is printed */
+};
+
+/* One conversion specification of a format string */
+
+struct logm_bin_spec_s {
+	FAR const char *start;		/* The '%' */
+	int len;					/* Length of the specification */
+	uint8_t nstar;				/* Number of '*' width/precision arguments */
+	uint8_t type;				/* enum logm_bin_arg_e */
+};
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* Number of tasks writing a record.  The buffer is not resized while
+ * a record is written.
+ */
+
+volatile int g_logm_bin_writers;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: logm_bin_nextspec
+ *
+ * Description:
+ *   Find the next conversion specification in a format string.  Returns
+ *   the position after the specification, or NULL at the end of the
+ *   format.  The producer and the consumer of a record both use this, so
+ *   they agree on the arguments which are stored.
+ *
+ ****************************************************************************/
+
+static FAR const char *logm_bin_nextspec(FAR const char *fmt, FAR struct logm_bin_spec_s *spec)
+{
+	int lmod = 0;
+
+	while (*fmt != '\0' && *fmt != '%') {
+		fmt++;
+	}
+
+	if (*fmt == '\0') {
+		return NULL;
+	}
+
+	spec->start = fmt++;
+	spec->nstar = 0;
+
+	/* Flags, field width and precision */
+
+	while (*fmt == '-' || *fmt == '+' || *fmt == ' ' || *fmt == '#' || *fmt == '0') {
+		fmt++;
+	}
+
+	if (*fmt == '*') {
+		spec->nstar++;
+		fmt++;
+	}
+
+	while (*fmt >= '0' && *fmt <= '9') {
+		fmt++;
+	}
+
+	if (*fmt == '.') {
+		fmt++;
+		if (*fmt == '*') {
+			spec->nstar++;
+			fmt++;
+		}
+
+		while (*fmt >= '0' && *fmt <= '9') {
+			fmt++;
+		}
+	}
+
+	/* Length modifiers */
+
+	for (;; fmt++) {
+		if (*fmt == 'l') {
+			lmod++;
+		} else if (*fmt == 'j' || *fmt == 'q') {
+			lmod = 2;
+		} else if (*fmt != 'h' && *fmt != 'z' && *fmt != 't' && *fmt != 'L') {
+			break;
+		}
+	}
+
+	switch (*fmt) {
+	case 'd':
+	case 'i':
+	case 'u':
+	case 'o':
+	case 'x':
+	case 'X':
+		spec->type = lmod >= 2 ? LOGM_BIN_ARG_LLONG : (lmod == 1 ? LOGM_BIN_ARG_LONG : LOGM_BIN_ARG_INT);
+		break;
+
+	case 'c':
+		spec->type = LOGM_BIN_ARG_INT;
+		break;
+
+	case 'p':
+		spec->type = LOGM_BIN_ARG_PTR;
+		break;
+
+	case 's':
+		spec->type = LOGM_BIN_ARG_STR;
+		break;
+
+	case 'f':
+	case 'F':
+	case 'e':
+	case 'E':
+	case 'g':
+	case 'G':
+	case 'a':
+	case 'A':
+		spec->type = LOGM_BIN_ARG_DOUBLE;
+		break;
+
+	case 'n':
+		spec->type = LOGM_BIN_ARG_COUNT;
+		break;
+
+	default:
+		spec->type = LOGM_BIN_ARG_NONE;
+		break;
+	}
+
+	if (*fmt != '\0') {
+		fmt++;
+	}
+
+	spec->len = fmt - spec->start;
+	return fmt;
+}
+
+/****************************************************************************
+ * Name: logm_bin_putval
+ *
+ * Description:
+ *   Append a value to a record.  Returns false if it does not fit.
+ *
+ ****************************************************************************/
+
+static bool logm_bin_putval(FAR uint8_t **pos, FAR uint8_t *end, FAR const void *val, size_t size)
+{
+	if (*pos + size > end) {
+		return false;
+	}
+
+	memcpy(*pos, val, size);
+	*pos += size;
+	return true;
+}
+
+/****************************************************************************
+ * Name: logm_bin_putstr
+ *
+ * Description:
+ *   Append a string to a record, truncated to the room which is left.
+ *
+ ****************************************************************************/
+
+static bool logm_bin_putstr(FAR uint8_t **pos, FAR uint8_t *end, FAR const char *str)
+{
+	size_t len;
+
+	if (*pos >= end) {
+		return false;
+	}
+
+	len = strlen(str);
+	if (len > (size_t)(end - *pos) - 1) {
+		len = (size_t)(end - *pos) - 1;
+	}
+
+	memcpy(*pos, str, len);
+	(*pos)[len] = '\0';
+	*pos += len + 1;
+	return true;
+}
+
+#ifndef CONFIG_LOGM_BINARY_EXPORT
+/****************************************************************************
+ * Name: logm_bin_getval
+ *
+ * Description:
+ *   Extract the next value from a record.  Returns false at the end of the
+ *   record.
+ *
+ ****************************************************************************/
+
+static bool logm_bin_getval(FAR const uint8_t **pos, FAR const uint8_t *end, FAR void *val, size_t size)
+{
+	if (*pos + size > end) {
+		return false;
+	}
+
+	memcpy(val, *pos, size);
+	*pos += size;
+	return true;
+}
+
+/****************************************************************************
+ * Name: logm_bin_skipval
+ *
+ * Description:
+ *   Skip the value of a conversion in a record.  Returns false at the end
+ *   of the record.
+ *
+ ****************************************************************************/
+
+static bool logm_bin_skipval(FAR const uint8_t **pos, FAR const uint8_t *end, uint8_t type)
+{
+	size_t size;
+
+	switch (type) {
+	case LOGM_BIN_ARG_INT:
+		size = sizeof(int);
+		break;
+
+	case LOGM_BIN_ARG_LONG:
+		size = sizeof(long);
+		break;
+
+	case LOGM_BIN_ARG_LLONG:
+		size = sizeof(long long);
+		break;
+
+	case LOGM_BIN_ARG_PTR:
+	case LOGM_BIN_ARG_COUNT:
+		size = sizeof(FAR void *);
+		break;
+
+	case LOGM_BIN_ARG_DOUBLE:
+		size = sizeof(double);
+		break;
+
+	case LOGM_BIN_ARG_STR:
+		if (*pos >= end) {
+			return false;
+		}
+		size = strlen((FAR const char *)*pos) + 1;
+		break;
+
+	default:
+		size = 0;
+		break;
+	}
+
+	if (*pos + size > end) {
+		return false;
+	}
+
+	*pos += size;
+	return true;
+}
+#endif
+
+/****************************************************************************
+ * Name: logm_bin_copyin / logm_bin_copyout
+ *
+ * Description:
+ *   Copy between a linear buffer and the ring buffer, which may wrap.
+ *
+ ****************************************************************************/
+
+static void logm_bin_copyin(int offset, FAR const void *src, int len)
+{
+	int first = logm_bufsize - offset;
+
+	if (first >= len) {
+		memcpy(&g_logm_rsvbuf[offset], src, len);
+	} else {
+		memcpy(&g_logm_rsvbuf[offset], src, first);
+		memcpy(g_logm_rsvbuf, (FAR const uint8_t *)src + first, len - first);
+	}
+}
+
+static void logm_bin_copyout(int offset, FAR void *dest, int len)
+{
+	int first = logm_bufsize - offset;
+
+	if (first >= len) {
+		memcpy(dest, &g_logm_rsvbuf[offset], len);
+		memset(&g_logm_rsvbuf[offset], 0, len);
+	} else {
+		memcpy(dest, &g_logm_rsvbuf[offset], first);
+		memcpy((FAR uint8_t *)dest + first, g_logm_rsvbuf, len - first);
+		memset(&g_logm_rsvbuf[offset], 0, first);
+		memset(g_logm_rsvbuf, 0, len - first);
+	}
+}
+
+/****************************************************************************
+ * Name: logm_bin_print
+ *
+ * Description:
+ *   Format one record to stdout.  With CONFIG_LOGM_BINARY_EXPORT the record
+ *   is written in hex instead, for tools/logm_decode.py.
+ *
+ ****************************************************************************/
+
+static void logm_bin_print(FAR const uint32_t *rec, int len)
+{
+	FAR const struct logm_bin_hdr_s *hdr = (FAR const struct logm_bin_hdr_s *)rec;
+	FAR const uint8_t *pos = (FAR const uint8_t *)(hdr + 1);
+	FAR const uint8_t *end = (FAR const uint8_t *)rec + len;
+#ifdef CONFIG_LOGM_BINARY_EXPORT
+	int i;
+
+	fputs("@LM:", stdout);
+	for (i = 0; i < len; i++) {
+		fprintf(stdout, "%02x", ((FAR const uint8_t *)rec)[i]);
+	}
+	fputc('\n', stdout);
+#else
+	struct logm_bin_spec_s spec;
+	FAR const char *fmt;
+	FAR const char *next;
+	char buf[LOGM_BIN_SPECSIZE];
+	int ival;
+	long lval;
+	long long llval;
+	FAR void *pval;
+	double dval;
+	int blen;
+	int i;
+
+	if ((hdr->flags & LOGM_BIN_INLINEFMT) != 0) {
+		fmt = (FAR const char *)pos;
+		pos += strlen(fmt) + 1;
+	} else {
+		fmt = (FAR const char *)(uintptr_t)hdr->fmt;
+	}
+
+#ifdef CONFIG_LOGM_TIMESTAMP
+	fprintf(stdout, "[%4d.%4d] ", (int)(hdr->ticks / TICK_PER_SEC), (int)(((uint64_t)(hdr->ticks % TICK_PER_SEC) * NSEC_PER_TICK) / 100000));
+#endif
+
+	while ((next = logm_bin_nextspec(fmt, &spec)) != NULL) {
+		fwrite(fmt, 1, spec.start - fmt, stdout);
+
+		/* Rebuild the specification with the '*' replaced by their values */
+
+		for (i = 0, blen = 0; i < spec.len && blen < LOGM_BIN_SPECSIZE - 12; i++) {
+			if (spec.start[i] == '*') {
+				if (!logm_bin_getval(&pos, end, &ival, sizeof(int))) {
+					goto truncated;
+				}
+				blen += snprintf(&buf[blen], LOGM_BIN_SPECSIZE - blen, "%d", ival);
+			} else if (spec.start[i] != 'L') {
+				buf[blen++] = spec.start[i];
+			}
+		}
+		buf[blen] = '\0';
+
+		/* Print an overlong specification as it is, without its value */
+
+		if (i < spec.len) {
+			for (; i < spec.len; i++) {
+				if (spec.start[i] == '*' && !logm_bin_getval(&pos, end, &ival, sizeof(int))) {
+					goto truncated;
+				}
+			}
+
+			fwrite(spec.start, 1, spec.len, stdout);
+			if (!logm_bin_skipval(&pos, end, spec.type)) {
+				goto truncated;
+			}
+
+			fmt = next;
+			continue;
+		}
+
+		switch (spec.type) {
+		case LOGM_BIN_ARG_INT:
+			if (!logm_bin_getval(&pos, end, &ival, sizeof(int))) {
+				goto truncated;
+			}
+			fprintf(stdout, buf, ival);
+			break;
+
+		case LOGM_BIN_ARG_LONG:
+			if (!logm_bin_getval(&pos, end, &lval, sizeof(long))) {
+				goto truncated;
+			}
+			fprintf(stdout, buf, lval);
+			break;
+
+		case LOGM_BIN_ARG_LLONG:
+			if (!logm_bin_getval(&pos, end, &llval, sizeof(long long))) {
+				goto truncated;
+			}
+			fprintf(stdout, buf, llval);
+			break;
+
+		case LOGM_BIN_ARG_PTR:
+		case LOGM_BIN_ARG_COUNT:
+			if (!logm_bin_getval(&pos, end, &pval, sizeof(FAR void *))) {
+				goto truncated;
+			}
+			if (spec.type == LOGM_BIN_ARG_PTR) {
+				fprintf(stdout, buf, pval);
+			}
+			break;
+
+		case LOGM_BIN_ARG_DOUBLE:
+			if (!logm_bin_getval(&pos, end, &dval, sizeof(double))) {
+				goto truncated;
+			}
+			fprintf(stdout, buf, dval);
+			break;
+
+		case LOGM_BIN_ARG_STR:
+			if (pos >= end) {
+				goto truncated;
+			}
+			fprintf(stdout, buf, (FAR const char *)pos);
+			pos += strlen((FAR const char *)pos) + 1;
+			break;
+
+		default:
+			if (spec.len == 2 && spec.start[1] == '%') {
+				fputc('%', stdout);
+			} else {
+				fwrite(spec.start, 1, spec.len, stdout);
+			}
+			break;
+		}
+
+		fmt = next;
+	}
+
+	fputs(fmt, stdout);
+	return;
+
+truncated:
+	fputs("...\n", stdout);
+#endif
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: logm_bin_put
+ *
+ * Description:
+ *   Queue a message as a binary record.  The arguments are stored without
+ *   formatting and without disabling interrupts:  the record is built on
+ *   the stack, space is reserved in the ring with a compare-and-swap on the
+ *   tail, and the tag is written last to publish the record to logm_task.
+ *   Strings are copied.  The format string is referenced by address only
+ *   if it is in the kernel text (CONFIG_LOGM_BINARY_FMTPTR), because a
+ *   format in RAM may be gone when the record is printed.
+ *
+ * Returned Value:
+ *   The size of the record, 0 if the message was dropped because the
+ *   buffer is full, or ERROR if the buffer cannot be used at the moment.
+ *
+ ****************************************************************************/
+
+int logm_bin_put(int priority, FAR const char *fmt, va_list ap)
+{
+	uint32_t rec[LOGM_BIN_RECORDSIZE / 4];
+	FAR struct logm_bin_hdr_s *hdr = (FAR struct logm_bin_hdr_s *)rec;
+	FAR uint8_t *pos = (FAR uint8_t *)(hdr + 1);
+	FAR uint8_t *end = (FAR uint8_t *)rec + sizeof(rec);
+	struct logm_bin_spec_s spec;
+	FAR const char *next;
+	FAR const char *sval;
+	int ival;
+	long lval;
+	long long llval;
+	FAR void *pval;
+	double dval;
+	bool fit = true;
+	int head;
+	int tail;
+	int len;
+	int i;
+
+	hdr->ticks = (uint32_t)clock_systimer();
+	hdr->pid = (int16_t)getpid();
+	hdr->priority = (uint8_t)priority;
+	hdr->flags = 0;
+	hdr->fmt = 0;
+
+#ifdef CONFIG_LOGM_BINARY_FMTPTR
+	if (is_kernel_text_space((FAR void *)fmt)) {
+		hdr->fmt = (uint32_t)(uintptr_t)fmt;
+	} else
+#endif
+	{
+		hdr->flags |= LOGM_BIN_INLINEFMT;
+		(void)logm_bin_putstr(&pos, end, fmt);
+	}
+
+	/* Store the arguments.  Whatever does not fit in the record is
+	 * dropped, the message is printed up to there.
+	 */
+
+	next = fmt;
+	while (fit && (next = logm_bin_nextspec(next, &spec)) != NULL) {
+		for (i = 0; fit && i < spec.nstar; i++) {
+			ival = va_arg(ap, int);
+			fit = logm_bin_putval(&pos, end, &ival, sizeof(int));
+		}
+
+		if (!fit) {
+			break;
+		}
+
+		switch (spec.type) {
+		case LOGM_BIN_ARG_INT:
+			ival = va_arg(ap, int);
+			fit = logm_bin_putval(&pos, end, &ival, sizeof(int));
+			break;
+
+		case LOGM_BIN_ARG_LONG:
+			lval = va_arg(ap, long);
+			fit = logm_bin_putval(&pos, end, &lval, sizeof(long));
+			break;
+
+		case LOGM_BIN_ARG_LLONG:
+			llval = va_arg(ap, long long);
+			fit = logm_bin_putval(&pos, end, &llval, sizeof(long long));
+			break;
+
+		case LOGM_BIN_ARG_PTR:
+		case LOGM_BIN_ARG_COUNT:
+			pval = va_arg(ap, FAR void *);
+			fit = logm_bin_putval(&pos, end, &pval, sizeof(FAR void *));
+			break;
+
+		case LOGM_BIN_ARG_DOUBLE:
+			dval = va_arg(ap, double);
+			fit = logm_bin_putval(&pos, end, &dval, sizeof(double));
+			break;
+
+		case LOGM_BIN_ARG_STR:
+			sval = va_arg(ap, FAR const char *);
+			fit = logm_bin_putstr(&pos, end, sval != NULL ? sval : "(null)");
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	len = LOGM_BIN_ALIGN(pos - (FAR uint8_t *)rec);
+	memset(pos, 0, ((FAR uint8_t *)rec + len) - pos);
+
+	/* The buffer may be resized by logm_task when there are no writers */
+
+	__atomic_fetch_add(&g_logm_bin_writers, 1, __ATOMIC_SEQ_CST);
+	if (!LOGM_STATUS(LOGM_READY) || LOGM_STATUS(LOGM_BUFFER_RESIZE_REQ)) {
+		__atomic_fetch_sub(&g_logm_bin_writers, 1, __ATOMIC_RELEASE);
+		return ERROR;
+	}
+
+	/* Reserve the space.  One word is kept free to tell a full buffer from
+	 * an empty one.
+	 */
+
+	tail = __atomic_load_n(&g_logm_tail, __ATOMIC_RELAXED);
+	do {
+		head = __atomic_load_n(&g_logm_head, __ATOMIC_ACQUIRE);
+		if (len > (head + logm_bufsize - tail - 4) % logm_bufsize) {
+			__atomic_fetch_add(&g_logm_dropmsg_count, 1, __ATOMIC_RELAXED);
+			__atomic_fetch_sub(&g_logm_bin_writers, 1, __ATOMIC_RELEASE);
+			return 0;
+		}
+	} while (!__atomic_compare_exchange_n(&g_logm_tail, &tail, (tail + len) % logm_bufsize, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+
+	/* Fill in the record and publish it */
+
+	logm_bin_copyin((tail + 4) % logm_bufsize, &rec[1], len - 4);
+	__atomic_store_n((FAR uint32_t *)&g_logm_rsvbuf[tail], LOGM_BIN_TAG(len), __ATOMIC_RELEASE);
+
+	__atomic_fetch_sub(&g_logm_bin_writers, 1, __ATOMIC_RELEASE);
+	return len;
+}
+
+/****************************************************************************
+ * Name: logm_bin_flush
+ *
+ * Description:
+ *   Print the published records.  Called by logm_task.  A record which is
+ *   still being written stops the flush until the next period.  The space
+ *   of the printed records is cleared, so that a tag is never seen before
+ *   its record is complete.
+ *
+ ****************************************************************************/
+
+void logm_bin_flush(void)
+{
+	uint32_t rec[LOGM_BIN_RECORDSIZE / 4];
+	uint32_t tag;
+	int dropped;
+	int head;
+	int len;
+
+	head = g_logm_head;
+	while (head != __atomic_load_n(&g_logm_tail, __ATOMIC_ACQUIRE)) {
+		tag = __atomic_load_n((FAR uint32_t *)&g_logm_rsvbuf[head], __ATOMIC_ACQUIRE);
+		if (!LOGM_BIN_TAGVALID(tag)) {
+			break;
+		}
+
+		len = LOGM_BIN_TAGLEN(tag);
+		DEBUGASSERT(len >= (int)sizeof(struct logm_bin_hdr_s) && len <= (int)sizeof(rec));
+
+		logm_bin_copyout(head, rec, len);
+		head = (head + len) % logm_bufsize;
+		__atomic_store_n(&g_logm_head, head, __ATOMIC_RELEASE);
+
+		logm_bin_print(rec, len);
+	}
+
+	dropped = __atomic_exchange_n(&g_logm_dropmsg_count, 0, __ATOMIC_RELAXED);
+	if (dropped > 0) {
+		fprintf(stdout, "\n[LOGM BUFFER OVERFLOW] %d messages are dropped\n", dropped);
+	}
+}
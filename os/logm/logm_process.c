@@ -24,6 +24,7 @@
 #include <tinyara/logm.h>
 #include <tinyara/config.h>
 #include <tinyara/kmalloc.h>
+#include <tinyara/clock.h>
 #include "logm.h"
 #ifdef CONFIG_LOGM_TEST
 #include "logm_test.h"
@@ -36,6 +37,15 @@ volatile int logm_print_interval = LOGM_PRINT_INTERVAL * 1000;
 
 static int logm_change_bufsize(int buflen)
 {
+#ifdef CONFIG_LOGM_BINARY
+	/* Binary records are word aligned in the buffer, and one word stays free */
+	buflen &= ~0x3;
+	if (buflen < (int)sizeof(struct logm_bin_hdr_s) + 4) {
+		LOGM_STATUS_CLEAR(LOGM_BUFFER_RESIZE_REQ);
+		return ERROR;
+	}
+#endif
+
 	/* Keep using old size if a parameter is invalid */
 	if (buflen < 0) {
 		LOGM_STATUS_CLEAR(LOGM_BUFFER_RESIZE_REQ);
@@ -67,6 +77,10 @@ int logm_task(int argc, char *argv[])
 {
 	irqstate_t flags;
 
+#ifdef CONFIG_LOGM_BINARY
+	/* Binary records are word aligned in the buffer */
+	logm_bufsize &= ~0x3;
+#endif
 	g_logm_rsvbuf = (char *)kmm_malloc(logm_bufsize);
 	memset(g_logm_rsvbuf, 0, logm_bufsize);
 
@@ -78,6 +92,9 @@ int logm_task(int argc, char *argv[])
 #endif
 
 	while (1) {
+#ifdef CONFIG_LOGM_BINARY
+		logm_bin_flush();
+#else
 		while (g_logm_head != g_logm_tail) {
 			fputc(g_logm_rsvbuf[g_logm_head], stdout);
 			g_logm_head = (g_logm_head + 1) % logm_bufsize;
@@ -89,8 +106,15 @@ int logm_task(int argc, char *argv[])
 				g_logm_overflow_offset = -1;
 			}
 		}
+#endif
 
 		if (LOGM_STATUS(LOGM_BUFFER_RESIZE_REQ)) {
+#ifdef CONFIG_LOGM_BINARY
+			/* Let the writers which saw the old buffer finish their records */
+			while (g_logm_bin_writers != 0) {
+				usleep(USEC_PER_TICK);
+			}
+#endif
 			flags = irqsave();
 			if (logm_change_bufsize(new_logm_bufsize) != OK) {
 				fprintf(stdout, "\n[LOGM] Failed to change buffer size\n");
@@ -16,6 +16,8 @@
  *
  ****************************************************************************/
 #include <stdio.h>
+#include <stdint.h>
+#include <time.h>
 #include <unistd.h>
 #include <syslog.h>
 #include <tinyara/kthread.h>
@@ -26,9 +28,41 @@
 /* Global Variables */
 static int g_logmtest_handle = 123;
 
+#define LOGMTEST_PERF_COUNT 100
+
+/* Measure the cost of queuing a message.  In the text mode, interrupts are
+ * disabled while each message is formatted, so this is also the interrupt
+ * latency added by logging.  In the binary mode interrupts stay enabled.
+ */
+
+static void logmtest_perf(void)
+{
+	struct timespec start;
+	struct timespec end;
+	uint32_t usec;
+	int i;
+
+	clock_gettime(CLOCK_REALTIME, &start);
+	for (i = 0; i < LOGMTEST_PERF_COUNT; i++) {
+		logm(LOGM_NORMAL, 0, LOGM_INF, "logm perf test %d %s 0x%08x\n", i, "arg", g_logmtest_handle);
+	}
+	clock_gettime(CLOCK_REALTIME, &end);
+
+	usec = (uint32_t)((end.tv_sec - start.tv_sec) * 1000000 + (end.tv_nsec - start.tv_nsec) / 1000);
+	logm(LOGM_NORMAL, 0, LOGM_INF, "logm perf: %d messages in %u usec, %u ns/message (%s)\n",
+		 LOGMTEST_PERF_COUNT, usec, (uint32_t)(((uint64_t)usec * 1000) / LOGMTEST_PERF_COUNT),
+#ifdef CONFIG_LOGM_BINARY
+		 "binary, interrupts enabled");
+#else
+		 "text, interrupts disabled per message");
+#endif
+}
+
 /* LOGM test routine */
 static int logmtest_kthread(int argc, char *argv[])
 {
+	logmtest_perf();
+
 	while (1) {
 		logm(1, 0, 3, "lom direct call test1 %d\n", g_logmtest_handle);
 		logm(1, 0, 3, "lom direct call test2 %d\n", g_logmtest_handle);
@@ -60,6 +60,7 @@
 #include <debug.h>
 
 #include <tinyara/mm/mm.h>
+#include <tinyara/ttrace.h>
 
 #ifdef CONFIG_DEBUG_MM_HEAPINFO
 #include  <tinyara/sched.h>
@@ -132,6 +133,9 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
 		mm_givesemaphore(heap);
 		return;
 	}
+
+	ttrace_free(mem);
+
 #ifdef CONFIG_DEBUG_MM_HEAPINFO
 	heapinfo_subtract_size(heap, ((struct mm_allocnode_s *)node)->pid, ((struct mm_allocnode_s *)node)->size);
 	heapinfo_update_total_size(heap, ((-1) * ((struct mm_allocnode_s *)node)->size), ((struct mm_allocnode_s *)node)->pid);
@@ -59,6 +59,7 @@
 #include <debug.h>
 
 #include <tinyara/mm/mm.h>
+#include <tinyara/ttrace.h>
 
 #ifdef CONFIG_DEBUG_MM_HEAPINFO
 #include  <tinyara/sched.h>
@@ -227,6 +228,7 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
 
 	if (ret) {
 		mvdbg("Allocated %p, size %u\n", ret, size);
+		ttrace_malloc(ret, size);
 	}
 
 	return ret;
@@ -225,7 +225,7 @@ SYSCALL_LOOKUP(lseek,                   3, STUB_lseek)
 #if defined(CONFIG_PIPES)
 SYSCALL_LOOKUP(mkfifo,                  2, STUB_mkfifo)
 #endif
-SYSCALL_LOOKUP(mmap,                    6, NULL)
+SYSCALL_LOOKUP(mmap,                    6, STUB_mmap)
 SYSCALL_LOOKUP(open,                    6, STUB_open)
 SYSCALL_LOOKUP(opendir,                 1, STUB_opendir)
 #if defined(CONFIG_PIPES)
@@ -311,6 +311,7 @@ SYSCALL_LOOKUP(mq_setattr,              3, STUB_mq_setattr)
 SYSCALL_LOOKUP(mq_timedreceive,         5, STUB_mq_timedreceive)
 SYSCALL_LOOKUP(mq_timedsend,            5, STUB_mq_timedsend)
 SYSCALL_LOOKUP(mq_unlink,               1, STUB_mq_unlink)
+SYSCALL_LOOKUP(mq_receive_batch,        5, STUB_mq_receive_batch)
 #endif
 
 /* The following are defined only if environment variables are supported */
@@ -317,6 +317,8 @@ uintptr_t STUB_mq_timedreceive(int nbr, uintptr_t parm1, uintptr_t parm2,
 uintptr_t STUB_mq_timedsend(int nbr, uintptr_t parm1, uintptr_t parm2,
 							uintptr_t parm3, uintptr_t parm4, uintptr_t parm5);
 uintptr_t STUB_mq_unlink(int nbr, uintptr_t parm1);
+uintptr_t STUB_mq_receive_batch(int nbr, uintptr_t parm1, uintptr_t parm2,
+								uintptr_t parm3, uintptr_t parm4, uintptr_t parm5);
 
 /* The following are defined only if environment variables are supported */
 
@@ -0,0 +1,190 @@
+#!/usr/bin/env python
+###########################################################################
+#
+# Copyright 2023 Samsung Electronics All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+# either express or implied. See the License for the specific
+# language governing permissions and limitations under the License.
+#
+###########################################################################
+#
+# Decode the binary logm records exported with CONFIG_LOGM_BINARY_EXPORT.
+# The logm task writes each record as a "@LM:<hex>" line.  Other lines of
+# the captured console output are passed through unchanged.  Format strings
+# which are referenced by address are read from the ELF file of the build.
+#
+# Example: logm_decode.py -e build/output/bin/tinyara -i console.log
+#
+
+from __future__ import print_function
+from optparse import OptionParser
+import binascii
+import re
+import struct
+import sys
+
+LOGM_BIN_MAGIC = 0x4c4d
+LOGM_BIN_INLINEFMT = 0x01
+HDR = struct.Struct('<IIhBBI')
+
+SPEC_RE = re.compile(r'%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+)?)?(hh|h|ll|l|q|j|z|t|L)?(.)', re.S)
+
+
+class Elf32(object):
+    """Minimal reader of the allocated sections of a little-endian ELF32"""
+
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self.data = f.read()
+        if self.data[:4] != b'\x7fELF' or self.data[4:5] != b'\x01':
+            raise ValueError('%s is not an ELF32 file' % path)
+        shoff, = struct.unpack_from('<I', self.data, 0x20)
+        shentsize, shnum = struct.unpack_from('<HH', self.data, 0x2e)
+        self.sections = []
+        for i in range(shnum):
+            fields = struct.unpack_from('<IIIIIIIIII', self.data, shoff + i * shentsize)
+            sh_type, sh_flags, sh_addr, sh_offset, sh_size = fields[1:6]
+            # SHT_PROGBITS sections which are allocated in memory
+            if sh_type == 1 and (sh_flags & 0x2) and sh_size > 0:
+                self.sections.append((sh_addr, sh_size, sh_offset))
+
+    def string(self, addr):
+        for sh_addr, sh_size, sh_offset in self.sections:
+            if sh_addr <= addr < sh_addr + sh_size:
+                start = sh_offset + addr - sh_addr
+                end = self.data.find(b'\0', start, sh_offset + sh_size)
+                if end < 0:
+                    end = sh_offset + sh_size
+                return self.data[start:end].decode('utf-8', 'replace')
+        return None
+
+
+class Record(object):
+    def __init__(self, raw):
+        self.raw = raw
+        self.pos = HDR.size
+
+    def take(self, size):
+        if self.pos + size > len(self.raw):
+            raise EOFError()
+        value = self.raw[self.pos:self.pos + size]
+        self.pos += size
+        return value
+
+    def int32(self, signed=True):
+        return struct.unpack('<i' if signed else '<I', self.take(4))[0]
+
+    def int64(self, signed=True):
+        return struct.unpack('<q' if signed else '<Q', self.take(8))[0]
+
+    def double(self):
+        return struct.unpack('<d', self.take(8))[0]
+
+    def string(self):
+        end = self.raw.find(b'\0', self.pos)
+        if end < 0:
+            raise EOFError()
+        value = self.raw[self.pos:end].decode('utf-8', 'replace')
+        self.pos = end + 1
+        return value
+
+
+def format_record(rec, fmt):
+    out = []
+    last = 0
+    try:
+        for m in SPEC_RE.finditer(fmt):
+            out.append(fmt[last:m.start()])
+            last = m.end()
+            flags, width, prec, length, conv = m.groups()
+            if width == '*':
+                width = str(rec.int32())
+            if prec == '*':
+                prec = str(rec.int32())
+            spec = '%' + flags + (width or '') + ('.' + prec if prec is not None else '')
+            wide = length in ('ll', 'q', 'j')
+            if conv in 'di':
+                out.append((spec + 'd') % (rec.int64() if wide else rec.int32()))
+            elif conv in 'uoxX':
+                value = rec.int64(False) if wide else rec.int32(False)
+                out.append((spec + ('d' if conv == 'u' else conv)) % value)
+            elif conv == 'c':
+                out.append((spec + 'c') % chr(rec.int32() & 0xff))
+            elif conv == 'p':
+                out.append((spec + 's') % ('0x%x' % rec.int32(False)))
+            elif conv == 's':
+                out.append((spec + 's') % rec.string())
+            elif conv in 'fFeEgGaA':
+                out.append((spec + (conv if conv not in 'aA' else 'e')) % rec.double())
+            elif conv == 'n':
+                rec.int32(False)
+            elif conv == '%':
+                out.append('%')
+            else:
+                out.append(m.group(0))
+        out.append(fmt[last:])
+    except EOFError:
+        out.append('...\n')
+    return ''.join(out)
+
+
+def decode(raw, elf, usec_per_tick, timestamp):
+    if len(raw) < HDR.size:
+        return '[LOGM] short record\n'
+    tag, ticks, pid, priority, flags, fmtaddr = HDR.unpack_from(raw)
+    if (tag >> 16) != LOGM_BIN_MAGIC:
+        return '[LOGM] bad record tag 0x%08x\n' % tag
+    rec = Record(raw[:tag & 0xffff])
+    if flags & LOGM_BIN_INLINEFMT:
+        fmt = rec.string()
+    else:
+        fmt = elf.string(fmtaddr) if elf else None
+        if fmt is None:
+            return '[LOGM] unknown format at 0x%08x (pid %d)\n' % (fmtaddr, pid)
+    prefix = ''
+    if timestamp:
+        usec = ticks * usec_per_tick
+        prefix = '[%4d.%4d] ' % (usec // 1000000, (usec % 1000000) // 100)
+    return prefix + format_record(rec, fmt)
+
+
+def main():
+    parser = OptionParser()
+    parser.add_option("-i", "--input", dest="input",
+                      help="captured console output. Default is stdin.", metavar="INPUT_FILE")
+    parser.add_option("-e", "--elf", dest="elf",
+                      help="ELF file of the build, for formats referenced by address", metavar="ELF_FILE")
+    parser.add_option("-t", "--timestamp", action="store_true", dest="timestamp",
+                      help="prepend the timestamp of the records", default=False)
+    parser.add_option("-u", "--usec-per-tick", type="int", dest="usec_per_tick",
+                      help="CONFIG_USEC_PER_TICK of the build. Default is 10000.", default=10000)
+    (options, args) = parser.parse_args()
+
+    elf = Elf32(options.elf) if options.elf else None
+    infile = open(options.input, 'r') if options.input else sys.stdin
+
+    for line in infile:
+        idx = line.find('@LM:')
+        if idx < 0:
+            sys.stdout.write(line)
+            continue
+        sys.stdout.write(line[:idx])
+        try:
+            raw = binascii.unhexlify(line[idx + 4:].strip())
+        except (binascii.Error, TypeError, ValueError):
+            sys.stdout.write('[LOGM] corrupted record\n')
+            continue
+        sys.stdout.write(decode(raw, elf, options.usec_per_tick, options.timestamp))
+
+
+if __name__ == '__main__':
+    main()
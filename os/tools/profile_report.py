@@ -0,0 +1,199 @@
+#!/usr/bin/env python
+###########################################################################
+#
+# Copyright 2023 Samsung Electronics All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+# either express or implied. See the License for the specific
+# language governing permissions and limitations under the License.
+#
+###########################################################################
+#
+# Build a profile from the samples printed by 'cpuload -p' with
+# CONFIG_SCHED_PROFILER.  The addresses are symbolized with the function
+# symbols of the ELF files of the build.  The flat profile is printed on
+# stdout; folded stacks for flamegraph.pl can be written with -f.
+#
+# Example: profile_report.py -e build/output/bin/tinyara -i console.log -f out.folded
+#
+# Input lines:
+#   @PFI:<ticks per second> <ticks per sample> <depth>
+#   @PFN:<pid> <task name>
+#   @PF:<pid> <pc> [<return address> ...]
+#   @PFE:<samples> <dropped samples>
+#
+
+from __future__ import print_function
+from optparse import OptionParser
+import bisect
+import struct
+import sys
+
+STT_FUNC = 2
+
+
+class SymbolTable(object):
+    """Function symbols of little-endian ELF32 files"""
+
+    def __init__(self):
+        self.addrs = []
+        self.syms = []
+
+    def load(self, path):
+        with open(path, 'rb') as f:
+            data = f.read()
+        if data[:4] != b'\x7fELF' or data[4:5] != b'\x01':
+            raise ValueError('%s is not an ELF32 file' % path)
+        shoff, = struct.unpack_from('<I', data, 0x20)
+        shentsize, shnum = struct.unpack_from('<HH', data, 0x2e)
+        sections = [struct.unpack_from('<IIIIIIIIII', data, shoff + i * shentsize) for i in range(shnum)]
+        funcs = list(zip(self.addrs, self.syms))
+        for sec in sections:
+            # SHT_SYMTAB
+            if sec[1] != 2:
+                continue
+            offset, size, link, entsize = sec[4], sec[5], sec[6], sec[9]
+            stroff = sections[link][4]
+            for pos in range(offset, offset + size, entsize):
+                name, value, symsize, info = struct.unpack_from('<IIIB', data, pos)
+                if (info & 0xf) != STT_FUNC or value == 0:
+                    continue
+                end = data.find(b'\0', stroff + name)
+                # Thumb functions have bit 0 set
+                funcs.append((value & ~1, (data[stroff + name:end].decode('utf-8', 'replace'), symsize)))
+        funcs.sort()
+        self.addrs = [f[0] for f in funcs]
+        self.syms = [f[1] for f in funcs]
+
+    def lookup(self, addr):
+        idx = bisect.bisect_right(self.addrs, addr) - 1
+        if idx >= 0:
+            name, size = self.syms[idx]
+            if addr < self.addrs[idx] + max(size, 1) or size == 0:
+                return name
+        return '0x%08x' % addr
+
+
+class Profile(object):
+    def __init__(self):
+        self.rate = None
+        self.period = 1
+        self.names = {}
+        self.stacks = []
+        self.total = None
+        self.dropped = 0
+
+    def parse(self, infile):
+        for line in infile:
+            idx = line.find('@PF')
+            if idx < 0:
+                continue
+            tag, _, rest = line[idx:].strip().partition(':')
+            fields = rest.split()
+            try:
+                if tag == '@PF':
+                    self.stacks.append((int(fields[0]), [int(pc, 16) for pc in fields[1:]]))
+                elif tag == '@PFN' and len(fields) >= 2:
+                    self.names[int(fields[0])] = ' '.join(fields[1:])
+                elif tag == '@PFI':
+                    self.rate, self.period = int(fields[0]), int(fields[1])
+                elif tag == '@PFE':
+                    self.total, self.dropped = int(fields[0]), int(fields[1])
+            except (IndexError, ValueError):
+                sys.stderr.write('skipping corrupted line: %s' % line)
+
+    def task(self, pid):
+        return self.names.get(pid, 'pid%d' % pid)
+
+
+def symbolize(stack, symtab):
+    """Return the functions of a stack, outermost first, with the frames
+    of a function following itself collapsed."""
+    frames = []
+    for pc in reversed(stack):
+        name = symtab.lookup(pc)
+        if not frames or frames[-1] != name:
+            frames.append(name)
+    return frames
+
+
+def report(profile, symtab, options):
+    selfcount = {}
+    totalcount = {}
+    folded = {}
+    nsamples = 0
+
+    for pid, stack in profile.stacks:
+        task = profile.task(pid)
+        if options.task and options.task not in (task, str(pid)):
+            continue
+        if not stack:
+            continue
+        nsamples += 1
+        frames = symbolize(stack, symtab)
+        selfcount[frames[-1]] = selfcount.get(frames[-1], 0) + 1
+        for name in set(frames):
+            totalcount[name] = totalcount.get(name, 0) + 1
+        key = ';'.join([task] + frames)
+        folded[key] = folded.get(key, 0) + 1
+
+    if profile.rate:
+        print('%d samples, one every %.1f ms' % (nsamples, 1000.0 * profile.period / profile.rate))
+    else:
+        print('%d samples' % nsamples)
+    if profile.dropped:
+        print('%d samples dropped, the session buffer was too small' % profile.dropped)
+    print('')
+
+    if nsamples == 0:
+        return folded
+
+    print('%8s %7s %8s %7s  %s' % ('self', 'self%', 'total', 'total%', 'function'))
+    rows = sorted(totalcount.keys(), key=lambda n: (-selfcount.get(n, 0), -totalcount[n], n))
+    for name in rows[:options.limit] if options.limit > 0 else rows:
+        own = selfcount.get(name, 0)
+        print('%8d %6.2f%% %8d %6.2f%%  %s' % (own, 100.0 * own / nsamples,
+                                               totalcount[name], 100.0 * totalcount[name] / nsamples, name))
+    return folded
+
+
+def main():
+    parser = OptionParser()
+    parser.add_option("-i", "--input", dest="input",
+                      help="captured console output of 'cpuload -p'. Default is stdin.", metavar="INPUT_FILE")
+    parser.add_option("-e", "--elf", dest="elf", action="append", default=[],
+                      help="ELF file whose symbols are used, may be repeated", metavar="ELF_FILE")
+    parser.add_option("-f", "--folded", dest="folded",
+                      help="write folded stacks for flamegraph.pl", metavar="OUTPUT_FILE")
+    parser.add_option("-t", "--task", dest="task",
+                      help="only report the samples of the task with this name or pid", metavar="TASK")
+    parser.add_option("-n", "--limit", type="int", dest="limit", default=40,
+                      help="number of functions in the flat profile, 0 for all. Default is 40.")
+    (options, args) = parser.parse_args()
+
+    symtab = SymbolTable()
+    for path in options.elf:
+        symtab.load(path)
+
+    profile = Profile()
+    infile = open(options.input, 'r') if options.input else sys.stdin
+    profile.parse(infile)
+
+    folded = report(profile, symtab, options)
+
+    if options.folded:
+        with open(options.folded, 'w') as out:
+            for key in sorted(folded.keys()):
+                out.write('%s %d\n' % (key, folded[key]))
+
+
+if __name__ == '__main__':
+    main()
@@ -197,5 +197,9 @@ int work_hpstart(void)
 
 	g_hpwork.worker[0].pid = pid;
 	g_hpwork.worker[0].busy = true;
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+	g_hpwork.stats.nworkers = 1;
+	g_hpwork.stats.maxworkers = 1;
+#endif
 	return pid;
 }
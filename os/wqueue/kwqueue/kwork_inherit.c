@@ -335,7 +335,9 @@ void lpwork_boostpriority(uint8_t reqprio)
 
 	struct lp_wqueue_s *lwq = get_lpwork();
 	for (wndx = 0; wndx < CONFIG_SCHED_LPNTHREADS; wndx++) {
-		lpwork_boostworker(lwq->worker[wndx].pid, reqprio);
+		if (lwq->worker[wndx].pid != 0) {
+			lpwork_boostworker(lwq->worker[wndx].pid, reqprio);
+		}
 	}
 
 	sched_unlock();
@@ -380,7 +382,9 @@ void lpwork_restorepriority(uint8_t reqprio)
 
 	struct lp_wqueue_s *lwq = get_lpwork();
 	for (wndx = 0; wndx < CONFIG_SCHED_LPNTHREADS; wndx++) {
-		lpwork_restoreworker(lwq->worker[wndx].pid, reqprio);
+		if (lwq->worker[wndx].pid != 0) {
+			lpwork_restoreworker(lwq->worker[wndx].pid, reqprio);
+		}
 	}
 
 	sched_unlock();
@@ -57,6 +57,7 @@
 #include <tinyara/config.h>
 
 #include <unistd.h>
+#include <stdbool.h>
 #include <sched.h>
 #include <string.h>
 #include <errno.h>
@@ -67,6 +68,7 @@
 #include <tinyara/kthread.h>
 #include <tinyara/kmalloc.h>
 #include <tinyara/clock.h>
+#include <tinyara/irq.h>
 
 #include "wqueue.h"
 
@@ -94,6 +96,49 @@ static struct lp_wqueue_s g_lpwork;
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: work_lpretire
+ *
+ * Description:
+ *   Release the slot of a worker thread which was started on demand and
+ *   has been idle for CONFIG_SCHED_LPWORKIDLETIMEOUT milliseconds.  The
+ *   slot is kept if work was queued after the timeout.  Once the slot is
+ *   released, work_signal() does not select the thread anymore.
+ *
+ * Input parameters:
+ *   lwq  - The low priority work queue
+ *   wndx - The index of the calling worker thread
+ *
+ * Returned Value:
+ *   True if the calling thread must exit
+ *
+ ****************************************************************************/
+
+#ifdef WORK_LPSCALING
+static bool work_lpretire(FAR struct lp_wqueue_s *lwq, int wndx)
+{
+	irqstate_t flags;
+	bool retire = false;
+
+	flags = irqsave();
+	if (lwq->q.head == NULL) {
+		lwq->worker[wndx].pid = 0;
+		lwq->worker[wndx].busy = false;
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+		lwq->stats.nworkers--;
+#endif
+		retire = true;
+	}
+	irqrestore(flags);
+
+	if (retire) {
+		svdbg("Worker thread %d stopped\n", wndx);
+	}
+
+	return retire;
+}
+#endif
+
 /****************************************************************************
  * Name: work_lpthread
  *
@@ -115,7 +160,8 @@ static struct lp_wqueue_s g_lpwork;
  *   argc, argv (not used)
  *
  * Returned Value:
- *   Does not return
+ *   Does not return, unless the thread is one which was started on demand
+ *   and it has been idle for CONFIG_SCHED_LPWORKIDLETIMEOUT milliseconds.
  *
  ****************************************************************************/
 
@@ -153,7 +199,13 @@ static int work_lpthread(int argc, char *argv[])
 			 * to wait indefinitely until a signal is received.
 			 */
 
+#ifdef WORK_LPSCALING
+			if (work_process((FAR struct wqueue_s *)lwq, wndx) == -ETIMEDOUT && work_lpretire(lwq, wndx)) {
+				break;
+			}
+#else
 			work_process((FAR struct wqueue_s *)lwq, wndx);
+#endif
 		} else
 #endif
 		{
@@ -190,6 +242,70 @@ struct lp_wqueue_s *get_lpwork(void)
 	return &g_lpwork;
 }
 
+/****************************************************************************
+ * Name: work_lpspare
+ *
+ * Description:
+ *   Make sure that a low priority worker thread is idle while the calling
+ *   worker performs its work, starting a new thread if all are busy and the
+ *   pool is not full.  This keeps short work from being delayed by long
+ *   running work.
+ *
+ * Input parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef WORK_LPSCALING
+void work_lpspare(void)
+{
+	FAR struct lp_wqueue_s *lwq = get_lpwork();
+	int wndx = -1;
+	int pid;
+	int i;
+
+	/* The new thread looks up its slot, so it must not run before the slot
+	 * is filled in.
+	 */
+
+	sched_lock();
+
+	for (i = 0; i < CONFIG_SCHED_LPNTHREADS; i++) {
+		if (lwq->worker[i].pid == 0) {
+			if (wndx < 0) {
+				wndx = i;
+			}
+		} else if (!lwq->worker[i].busy) {
+			/* There is an idle worker already */
+
+			sched_unlock();
+			return;
+		}
+	}
+
+	if (wndx >= 0) {
+		pid = kernel_thread(LPWORKNAME, CONFIG_SCHED_LPWORKPRIORITY, CONFIG_SCHED_LPWORKSTACKSIZE, (main_t)work_lpthread, (FAR char *const *)NULL);
+		if (pid > 0) {
+			lwq->worker[wndx].pid = (pid_t)pid;
+			lwq->worker[wndx].busy = true;
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+			if (++lwq->stats.nworkers > lwq->stats.maxworkers) {
+				lwq->stats.maxworkers = lwq->stats.nworkers;
+			}
+#endif
+			svdbg("Worker thread %d started\n", wndx);
+		} else {
+			sdbg("kernel_thread %d failed: %d\n", wndx, errno);
+		}
+	}
+
+	sched_unlock();
+}
+#endif
+
 /****************************************************************************
  * Name: work_lpstart
  *
@@ -213,7 +329,7 @@ int work_lpstart(void)
 	/* Initialize work queue data structures */
 
 	struct lp_wqueue_s *lwq = get_lpwork();
-	memset(lwq, 0, sizeof(struct wqueue_s));
+	memset(lwq, 0, sizeof(struct lp_wqueue_s));
 
 	dq_init(&lwq->q);
 
@@ -223,11 +339,13 @@ int work_lpstart(void)
 
 	sched_lock();
 
-	/* Start the low-priority, kernel mode worker thread(s) */
+	/* Start the low-priority, kernel mode worker thread(s).  The others are
+	 * started on demand.
+	 */
 
 	svdbg("Starting low-priority kernel worker thread(s)\n");
 
-	for (wndx = 0; wndx < CONFIG_SCHED_LPNTHREADS; wndx++) {
+	for (wndx = 0; wndx < CONFIG_SCHED_LPNTHREADS_MIN; wndx++) {
 		pid = kernel_thread(LPWORKNAME, CONFIG_SCHED_LPWORKPRIORITY, CONFIG_SCHED_LPWORKSTACKSIZE, (main_t)work_lpthread, (FAR char *const *)NULL);
 
 		DEBUGASSERT(pid > 0);
@@ -244,6 +362,11 @@ int work_lpstart(void)
 		lwq->worker[wndx].busy = true;
 	}
 
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+	lwq->stats.nworkers = CONFIG_SCHED_LPNTHREADS_MIN;
+	lwq->stats.maxworkers = CONFIG_SCHED_LPNTHREADS_MIN;
+#endif
+
 	sched_unlock();
 	return lwq->worker[0].pid;
 }
@@ -93,7 +93,7 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: work_queue
+ * Name: work_queue_pri
  *
  * Description:
  *   Queue kernel-mode work to be performed at a later time.  All queued work
@@ -115,13 +115,19 @@
  *            int is invoked.
  *   delay  - Delay (in clock ticks) from the time queue until the worker
  *            is invoked. Zero means to perform the work immediately.
+ *   priority - Priority among the ready work (ignored without
+ *            CONFIG_SCHED_WORKPRIORITY)
  *
  * Returned Value:
  *   Zero on success, a negated errno on failure
  *
  ****************************************************************************/
 
-int work_queue(int qid, FAR struct work_s *work, worker_t worker, FAR void *arg, clock_t delay)
+#ifdef CONFIG_SCHED_WORKPRIORITY
+int work_queue_pri(int qid, FAR struct work_s *work, worker_t worker, FAR void *arg, clock_t delay, uint8_t priority)
+#else
+static int work_queue_pri(int qid, FAR struct work_s *work, worker_t worker, FAR void *arg, clock_t delay, uint8_t priority)
+#endif
 {
 #if defined(CONFIG_SCHED_HPWORK) || defined(CONFIG_SCHED_LPWORK)
 	int result;
@@ -131,7 +137,7 @@ int work_queue(int qid, FAR struct work_s *work, worker_t worker, FAR void *arg,
 		/* Cancel high priority work */
 
 		struct hp_wqueue_s *hwq = get_hpwork();
-		result = work_qqueue((FAR struct wqueue_s *)hwq, work, worker, arg, delay);
+		result = work_qqueue((FAR struct wqueue_s *)hwq, work, worker, arg, delay, priority);
 		if (result != OK) {
 			return result;
 		}
@@ -143,7 +149,7 @@ int work_queue(int qid, FAR struct work_s *work, worker_t worker, FAR void *arg,
 			/* Cancel low priority work */
 
 			struct lp_wqueue_s *lwq = get_lpwork();
-			result = work_qqueue((FAR struct wqueue_s *)lwq, work, worker, arg, delay);
+			result = work_qqueue((FAR struct wqueue_s *)lwq, work, worker, arg, delay, priority);
 			if (result != OK) {
 				return result;
 			}
@@ -154,3 +160,20 @@ int work_queue(int qid, FAR struct work_s *work, worker_t worker, FAR void *arg,
 			return -EINVAL;
 		}
 }
+
+/****************************************************************************
+ * Name: work_queue
+ *
+ * Description:
+ *   Queue work with the default priority.  See work_queue_pri().
+ *
+ ****************************************************************************/
+
+int work_queue(int qid, FAR struct work_s *work, worker_t worker, FAR void *arg, clock_t delay)
+{
+#ifdef CONFIG_SCHED_WORKPRIORITY
+	return work_queue_pri(qid, work, worker, arg, delay, WORK_PRIORITY_DEFAULT);
+#else
+	return work_queue_pri(qid, work, worker, arg, delay, 0);
+#endif
+}
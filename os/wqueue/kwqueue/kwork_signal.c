@@ -67,9 +67,9 @@ int work_signal(int qid)
 		/* Find an IDLE worker thread */
 
 		for (wndx = 0, i = 0; i < CONFIG_SCHED_LPNTHREADS; i++) {
-			/* Is this worker thread busy? */
+			/* Is this worker thread running and not busy? */
 
-			if (!lwq->worker[i].busy) {
+			if (lwq->worker[i].pid != 0 && !lwq->worker[i].busy) {
 				/* No.. select this thread */
 
 				wndx = i;
@@ -0,0 +1,83 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <string.h>
+#include <errno.h>
+
+#include <tinyara/irq.h>
+#include <tinyara/wqueue.h>
+
+#include "wqueue.h"
+
+#if defined(CONFIG_SCHED_WORKQUEUE_STATS) && (defined(CONFIG_SCHED_HPWORK) || defined(CONFIG_SCHED_LPWORK))
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: work_getstats
+ *
+ * Description:
+ *   Return a snapshot of the statistics of a kernel work queue.
+ *
+ * Input parameters:
+ *   qid   - The work queue ID
+ *   stats - Location to return the statistics
+ *
+ * Returned Value:
+ *   Zero on success, -EINVAL if there is no such work queue
+ *
+ ****************************************************************************/
+
+int work_getstats(int qid, FAR struct work_stats_s *stats)
+{
+	FAR struct work_stats_s *qstats;
+	irqstate_t flags;
+
+#ifdef CONFIG_SCHED_HPWORK
+	if (qid == HPWORK) {
+		qstats = &get_hpwork()->stats;
+	} else
+#endif
+#ifdef CONFIG_SCHED_LPWORK
+	if (qid == LPWORK) {
+		qstats = &get_lpwork()->stats;
+	} else
+#endif
+	{
+		return -EINVAL;
+	}
+
+	/* The statistics are updated with interrupts disabled */
+
+	flags = irqsave();
+	memcpy(stats, qstats, sizeof(struct work_stats_s));
+	irqrestore(flags);
+
+	return OK;
+}
+
+#endif							/* CONFIG_SCHED_WORKQUEUE_STATS && (CONFIG_SCHED_HPWORK || CONFIG_SCHED_LPWORK) */
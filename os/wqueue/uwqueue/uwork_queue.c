@@ -93,7 +93,7 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: work_queue
+ * Name: work_queue_pri
  *
  * Description:
  *   Queue user-mode work to be performed at a later time.  All queued work
@@ -115,18 +115,24 @@
  *            int is invoked.
  *   delay  - Delay (in clock ticks) from the time queue until the worker
  *            is invoked. Zero means to perform the work immediately.
+ *   priority - Priority among the ready work (ignored without
+ *            CONFIG_SCHED_WORKPRIORITY)
  *
  * Returned Value:
  *   Zero on success, a negated errno on failure
  *
  ****************************************************************************/
 
-int work_queue(int qid, FAR struct work_s *work, worker_t worker, FAR void *arg, clock_t delay)
+#ifdef CONFIG_SCHED_WORKPRIORITY
+int work_queue_pri(int qid, FAR struct work_s *work, worker_t worker, FAR void *arg, clock_t delay, uint8_t priority)
+#else
+static int work_queue_pri(int qid, FAR struct work_s *work, worker_t worker, FAR void *arg, clock_t delay, uint8_t priority)
+#endif
 {
 	int ret;
 	if (qid == USRWORK) {
 		struct wqueue_s *usrwq = get_usrwork();
-		ret = work_qqueue(usrwq, work, worker, arg, delay);
+		ret = work_qqueue(usrwq, work, worker, arg, delay, priority);
 		if (ret != OK) {
 			return ret;
 		}
@@ -135,3 +141,20 @@ int work_queue(int qid, FAR struct work_s *work, worker_t worker, FAR void *arg,
 		return -EINVAL;
 	}
 }
+
+/****************************************************************************
+ * Name: work_queue
+ *
+ * Description:
+ *   Queue work with the default priority.  See work_queue_pri().
+ *
+ ****************************************************************************/
+
+int work_queue(int qid, FAR struct work_s *work, worker_t worker, FAR void *arg, clock_t delay)
+{
+#ifdef CONFIG_SCHED_WORKPRIORITY
+	return work_queue_pri(qid, work, worker, arg, delay, WORK_PRIORITY_DEFAULT);
+#else
+	return work_queue_pri(qid, work, worker, arg, delay, 0);
+#endif
+}
@@ -156,6 +156,7 @@ int work_qcancel(FAR struct wqueue_s *wqueue, FAR struct work_s *work)
 		 */
 
 		dq_rem((FAR dq_entry_t *)work, &wqueue->q);
+		work_stats_removed(wqueue);
 		work->worker = NULL;
 		ret = OK;
 	}
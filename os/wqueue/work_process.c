@@ -59,6 +59,8 @@
 #include <unistd.h>
 #include <signal.h>
 #include <assert.h>
+#include <errno.h>
+#include <time.h>
 #include <queue.h>
 
 #include <tinyara/clock.h>
@@ -114,21 +116,34 @@ worker_t work_get_current(void)
  *   part of the internal implementation of each work queue; it should not
  *   be called from application level logic.
  *
+ *   Among the work which is ready to run, the work with the highest
+ *   priority is performed first.  The queue is sorted by deadline, so the
+ *   ready work is at the head of the queue and work of the same priority
+ *   is performed in deadline order.
+ *
  * Input parameters:
  *   wqueue - Describes the work queue to be processed
+ *   wndx   - The index of the calling worker thread
  *
  * Returned Value:
- *   None
+ *   Zero (OK) normally.  -ETIMEDOUT if the calling worker thread may be
+ *   stopped because it found no work for CONFIG_SCHED_LPWORKIDLETIMEOUT
+ *   milliseconds.
  *
  ****************************************************************************/
-void work_process(FAR struct wqueue_s *wqueue, int wndx)
+int work_process(FAR struct wqueue_s *wqueue, int wndx)
 {
 	volatile FAR struct work_s *work;
+	FAR struct work_s *ready;
 	worker_t worker;
 	FAR void *arg;
 	clock_t elapsed;
 	clock_t ctick;
 	clock_t next;
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+	clock_t wait;
+#endif
+	int ret = OK;
 
 	/* Then process queued work.  We need to keep interrupts disabled while
 	 * we process items in the work list.
@@ -153,80 +168,112 @@ void work_process(FAR struct wqueue_s *wqueue, int wndx)
 	
 	while (work) {
 		
-		/* Is this work ready?  It is ready if there is no delay or if
-		 * the delay has elapsed. qtime is the time that the work was added
+		/* Select the work to perform.  Work is ready if there is no delay or
+		 * if the delay has elapsed. qtime is the time that the work was added
 		 * to the work queue.  It will always be greater than or equal to
 		 * zero.  Therefore a delay of zero will always execute immediately.
+		 * The list is sorted by deadline, so the scan stops at the first work
+		 * which is not ready.
 		 */
 
 		ctick = clock();
-		elapsed = ctick - work->qtime;
+		ready = NULL;
+		next = 0;
+
+		for (; work != NULL; work = (FAR struct work_s *)work->dq.flink) {
+			elapsed = ctick - work->qtime;
+			if (elapsed < work->delay) {
+				next = work->delay - elapsed;
+				break;
+			}
 
-		if (elapsed >= work->delay) {
-			/* Remove the ready-to-execute work from the list */
+			if (ready == NULL || WORK_GETPRIORITY(work) > WORK_GETPRIORITY(ready)) {
+				ready = (FAR struct work_s *)work;
+			}
+		}
 
-			(void)dq_rem((struct dq_entry_s *)work, &wqueue->q);
+		if (ready == NULL) {
+			/* Nothing is ready.  Wait for the head of the list. */
 
-			/* Extract the work description from the entry (in case the work
-			 * instance by the re-used after it has been de-queued).
-			 */
+			break;
+		}
 
-			worker = work->worker;
+		/* Remove the ready-to-execute work from the list */
 
-			/* Check for a race condition where the work may be nullified
-			 * before it is removed from the queue.
-			 */
+		(void)dq_rem((struct dq_entry_s *)ready, &wqueue->q);
+		work_stats_removed(wqueue);
 
-			if (worker != NULL) {
-				/* Extract the work argument (before re-enabling interrupts) */
+		/* Extract the work description from the entry (in case the work
+		 * instance by the re-used after it has been de-queued).
+		 */
+
+		worker = ready->worker;
+
+		/* Check for a race condition where the work may be nullified
+		 * before it is removed from the queue.
+		 */
+
+		if (worker != NULL) {
+			/* Extract the work argument (before re-enabling interrupts) */
+
+			arg = ready->arg;
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+			wait = ctick - ready->qtime - ready->delay;
+			wqueue->stats.waittotal += wait;
+			if (wait > wqueue->stats.waitmax) {
+				wqueue->stats.waitmax = wait;
+			}
+#endif
 
-				arg = work->arg;
+			/* Mark the work as no longer being queued */
 
-				/* Mark the work as no longer being queued */
+			ready->worker = NULL;
 
-				work->worker = NULL;
+			/* Do the work.  Re-enable interrupts while the work is being
+			 * performed... we don't have any idea how long this will take!
+			 */
 
-				/* Do the work.  Re-enable interrupts while the work is being
-				 * performed... we don't have any idea how long this will take!
-				 */
-				
 #if defined(CONFIG_SCHED_USRWORK) && !defined(__KERNEL__)
-				work_unlock();
+			work_unlock();
 #else
-				irqrestore(flags);
+			irqrestore(flags);
+#endif
+#ifdef WORK_LPSCALING
+			if (wqueue == (FAR struct wqueue_s *)get_lpwork()) {
+				work_lpspare();
+			}
 #endif
 #if defined(CONFIG_DEBUG_WORKQUEUE)
 #if defined(CONFIG_BUILD_FLAT) || (defined(CONFIG_BUILD_PROTECTED) && defined(__KERNEL__))
-				cur_worker = worker;
+			cur_worker = worker;
 #endif
 #endif
-				worker(arg);
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+			ctick = clock();
+#endif
+			worker(arg);
 
-				/* Now, unfortunately, since we re-enabled interrupts we don't
-				 * know the state of the work list and we will have to start
-				 * back at the head of the list.
-				 */
+			/* Now, unfortunately, since we re-enabled interrupts we don't
+			 * know the state of the work list and we will have to start
+			 * back at the head of the list.
+			 */
 
 #if defined(CONFIG_SCHED_USRWORK) && !defined(__KERNEL__)
-				while (work_lock() < 0);
+			while (work_lock() < 0);
 #else
-				flags = irqsave();
+			flags = irqsave();
 #endif
-				work = (FAR struct work_s *)wqueue->q.head;
-			} else {
-				/* Cancelled.. Just move to the next work in the list with
-				 * interrupts still disabled.
-				 */
-
-				work = (FAR struct work_s *)work->dq.flink;
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+			elapsed = clock() - ctick;
+			wqueue->stats.nexecuted++;
+			wqueue->stats.exectotal += elapsed;
+			if (elapsed > wqueue->stats.execmax) {
+				wqueue->stats.execmax = elapsed;
 			}
-		} else {				/* elapsed < work->delay */
-
-			next = work->delay - elapsed;
-
-			/* Then break at while loop due to sorted list */
-			break;
+#endif
 		}
+
+		work = (FAR struct work_s *)wqueue->q.head;
 	}
 
 	if (wqueue->q.head == NULL) {
@@ -237,9 +284,25 @@ void work_process(FAR struct wqueue_s *wqueue, int wndx)
 		sigemptyset(&set);
 		sigaddset(&set, SIGWORK);
 
-		/* Wait indefinitely until signalled with SIGWORK */
 		wqueue->worker[wndx].busy = false;
-		DEBUGVERIFY(sigwaitinfo(&set, NULL));
+#ifdef WORK_LPSCALING
+		if (wndx >= CONFIG_SCHED_LPNTHREADS_MIN && wqueue == (FAR struct wqueue_s *)get_lpwork()) {
+			/* Extra worker threads wait for a limited time only */
+
+			struct timespec timeout;
+
+			timeout.tv_sec = CONFIG_SCHED_LPWORKIDLETIMEOUT / MSEC_PER_SEC;
+			timeout.tv_nsec = (CONFIG_SCHED_LPWORKIDLETIMEOUT % MSEC_PER_SEC) * NSEC_PER_MSEC;
+			if (sigtimedwait(&set, NULL, &timeout) < 0 && get_errno() == EAGAIN) {
+				ret = -ETIMEDOUT;
+			}
+		} else
+#endif
+		{
+			/* Wait indefinitely until signalled with SIGWORK */
+
+			DEBUGVERIFY(sigwaitinfo(&set, NULL));
+		}
 		wqueue->worker[wndx].busy = true;
 	} else if (next > 0) {
 #if defined(CONFIG_SCHED_USRWORK) && !defined(__KERNEL__)
@@ -261,4 +324,5 @@ void work_process(FAR struct wqueue_s *wqueue, int wndx)
 	irqrestore(flags);
 #endif
 
+	return ret;
 }
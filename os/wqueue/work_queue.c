@@ -94,6 +94,9 @@
  *   Queue work to be performed at a later time.  All queued work will be
  *   performed on the worker thread of execution (not the caller's).
  *
+ *   The queue is kept sorted by deadline (queue time plus delay), so that
+ *   the work which is ready to run is always at the head of the queue.
+ *
  *   The work structure is allocated by caller, but completely managed by
  *   the work queue logic.  The caller should never modify the contents of
  *   the work queue structure; the caller should not call work_queue()
@@ -110,13 +113,14 @@
  *            int is invoked.
  *   delay  - Delay (in clock ticks) from the time queue until the worker
  *            is invoked. Zero means to perform the work immediately.
+ *   priority - Priority among the ready work
  *
  * Returned Value:
  *   Zero (OK) on success, a negated errno on failure.
  *
  ****************************************************************************/
 
-int work_qqueue(FAR struct wqueue_s *wqueue, FAR struct work_s *work, worker_t worker, FAR void *arg, clock_t delay)
+int work_qqueue(FAR struct wqueue_s *wqueue, FAR struct work_s *work, worker_t worker, FAR void *arg, clock_t delay, uint8_t priority)
 {
 	DEBUGASSERT(work != NULL);
 
@@ -159,12 +163,17 @@ int work_qqueue(FAR struct wqueue_s *wqueue, FAR struct work_s *work, worker_t w
 	work->arg = arg;		/* Callback argument */
 	work->delay = delay;		/* Delay until work performed */
 	work->qtime = ctick;		/* Time work queued */
+#ifdef CONFIG_SCHED_WORKPRIORITY
+	work->priority = priority;	/* Priority among the ready work */
+#endif
 
 	if (next_work) {
 		dq_addbefore((FAR dq_entry_t *)next_work, (FAR dq_entry_t *)work, &wqueue->q);
 	} else {
 		dq_addlast((FAR dq_entry_t *)work, &wqueue->q);
 	}
+
+	work_stats_added(wqueue);
 #if defined(CONFIG_SCHED_USRWORK) && !defined(__KERNEL__)
 	work_unlock();
 #else
@@ -68,6 +68,44 @@
 
 #ifdef CONFIG_SCHED_WORKQUEUE
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The priority of a work item in the selection of the ready work */
+
+#ifdef CONFIG_SCHED_WORKPRIORITY
+#define WORK_GETPRIORITY(w)     ((w)->priority)
+#else
+#define WORK_GETPRIORITY(w)     0
+#endif
+
+/* The low priority work queue starts and stops worker threads on demand if
+ * fewer threads than the size of the pool are started at boot.  It is a
+ * kernel work queue, so the user-space build of work_process.c leaves it out.
+ */
+
+#if defined(CONFIG_SCHED_LPWORK) && CONFIG_SCHED_LPNTHREADS_MIN < CONFIG_SCHED_LPNTHREADS && \
+	(defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__))
+#define WORK_LPSCALING 1
+#endif
+
+/* Statistics updates.  They are called with the work queue locked. */
+
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+#define work_stats_added(wq) \
+	do { \
+		(wq)->stats.nqueued++; \
+		if (++(wq)->stats.depth > (wq)->stats.maxdepth) { \
+			(wq)->stats.maxdepth = (wq)->stats.depth; \
+		} \
+	} while (0)
+#define work_stats_removed(wq)  ((wq)->stats.depth--)
+#else
+#define work_stats_added(wq)
+#define work_stats_removed(wq)
+#endif
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -83,6 +121,9 @@ struct worker_s {
 
 struct wqueue_s {
 	struct dq_queue_s q;		/* The queue of pending work */
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+	struct work_stats_s stats;	/* Statistics of the queue */
+#endif
 	struct worker_s worker[1];	/* Describes a worker thread */
 };
 
@@ -93,6 +134,9 @@ struct wqueue_s {
 #ifdef CONFIG_SCHED_HPWORK
 struct hp_wqueue_s {
 	struct dq_queue_s q;		/* The queue of pending work */
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+	struct work_stats_s stats;	/* Statistics of the queue */
+#endif
 	struct worker_s worker[1];	/* Describes the single high priority worker */
 };
 #endif
@@ -104,6 +148,9 @@ struct hp_wqueue_s {
 #ifdef CONFIG_SCHED_LPWORK
 struct lp_wqueue_s {
 	struct dq_queue_s q;		/* The queue of pending work */
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+	struct work_stats_s stats;	/* Statistics of the queue */
+#endif
 
 	/* Describes each thread in the low priority queue's thread pool */
 	struct worker_s worker[CONFIG_SCHED_LPNTHREADS];
@@ -220,13 +267,15 @@ int work_qcancel(FAR struct wqueue_s *wqueue, FAR struct work_s *work);
  *            int is invoked.
  *   delay  - Delay (in clock ticks) from the time queue until the worker
  *            is invoked. Zero means to perform the work immediately.
+ *   priority - Priority among the ready work (ignored without
+ *            CONFIG_SCHED_WORKPRIORITY)
  *
  * Returned Value:
  *   Zero (OK) on success, a negated errno on failure.
  *
  ****************************************************************************/
 
-int work_qqueue(FAR struct wqueue_s *wqueue, FAR struct work_s *work, worker_t worker, FAR void *arg, clock_t delay);
+int work_qqueue(FAR struct wqueue_s *wqueue, FAR struct work_s *work, worker_t worker, FAR void *arg, clock_t delay, uint8_t priority);
 
 /****************************************************************************
  * Name: work_process
@@ -239,13 +288,37 @@ int work_qqueue(FAR struct wqueue_s *wqueue, FAR struct work_s *work, worker_t w
  *
  * Input parameters:
  *   wqueue - Describes the work queue to be processed
+ *   wndx   - The index of the calling worker thread
+ *
+ * Returned Value:
+ *   Zero (OK) normally.  -ETIMEDOUT if the calling worker thread may be
+ *   stopped because it found no work for CONFIG_SCHED_LPWORKIDLETIMEOUT
+ *   milliseconds.
+ *
+ ****************************************************************************/
+
+int work_process(FAR struct wqueue_s *wqueue, int wndx);
+
+/****************************************************************************
+ * Name: work_lpspare
+ *
+ * Description:
+ *   Make sure that a low priority worker thread is idle while the calling
+ *   worker performs its work, starting a new thread if all are busy and the
+ *   pool is not full.  This keeps short work from being delayed by long
+ *   running work.
+ *
+ * Input parameters:
+ *   None
  *
  * Returned Value:
  *   None
  *
  ****************************************************************************/
 
-void work_process(FAR struct wqueue_s *wqueue, int wdx);
+#ifdef WORK_LPSCALING
+void work_lpspare(void);
+#endif
 
 /****************************************************************************
  * Name: work_qsignal
@@ -0,0 +1,273 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define STB_TRUETYPE_IMPLEMENTATION
+#include <stb/stb_truetype.h>
+
+#include "emoji_assets.h"
+
+#define UI_PIXEL_FORMAT_RGBA8888 (10)
+#define UI_PIXEL_FORMAT_A8       (11)
+
+#define UI_GLYPH_ATLAS_MAGIC     (0x534c4741)
+
+#define ASCII_START              (0x20)
+#define ASCII_END                (0x7e)
+#define EMOJI_START              (0x1f600)
+#define EMOJI_COUNT              (69)
+
+typedef struct {
+	uint32_t id;
+	int32_t width;
+	int32_t height;
+	uint32_t pf;
+	uint32_t header_size;
+	uint32_t data_size;
+	int32_t reserved[8];
+} __attribute__((packed)) ui_bitmap_data_t;
+
+typedef struct {
+	uint32_t magic;
+	uint32_t font_size;
+	uint32_t glyph_count;
+	uint32_t header_size;
+} __attribute__((packed)) ui_glyph_atlas_t;
+
+typedef struct {
+	uint32_t utf_code;
+	int16_t offset_y;
+	uint16_t width;
+	uint16_t height;
+	uint16_t pf;
+	uint32_t offset;
+} __attribute__((packed)) ui_glyph_atlas_entry_t;
+
+static const uint8_t *g_emoji[EMOJI_COUNT] = {
+	__emoji_u1F600, __emoji_u1F601, __emoji_u1F602, __emoji_u1F603, __emoji_u1F604,
+	__emoji_u1F605, __emoji_u1F606, __emoji_u1F607, __emoji_u1F608, __emoji_u1F609,
+	__emoji_u1F60A, __emoji_u1F60B, __emoji_u1F60C, __emoji_u1F60D, __emoji_u1F60E,
+	__emoji_u1F60F, __emoji_u1F610, __emoji_u1F611, __emoji_u1F612, __emoji_u1F613,
+	__emoji_u1F614, __emoji_u1F615, __emoji_u1F616, __emoji_u1F617, __emoji_u1F618,
+	__emoji_u1F619, __emoji_u1F61A, __emoji_u1F61B, __emoji_u1F61C, __emoji_u1F61D,
+	__emoji_u1F61E, __emoji_u1F61F, __emoji_u1F620, __emoji_u1F621, __emoji_u1F622,
+	__emoji_u1F623, __emoji_u1F624, __emoji_u1F625, __emoji_u1F626, __emoji_u1F627,
+	__emoji_u1F628, __emoji_u1F629, __emoji_u1F62A, __emoji_u1F62B, __emoji_u1F62C,
+	__emoji_u1F62D, __emoji_u1F62E, __emoji_u1F62F, __emoji_u1F630, __emoji_u1F631,
+	__emoji_u1F632, __emoji_u1F633, __emoji_u1F634, __emoji_u1F635, __emoji_u1F636,
+	__emoji_u1F637, __emoji_u1F638, __emoji_u1F639, __emoji_u1F63A, __emoji_u1F63B,
+	__emoji_u1F63C, __emoji_u1F63D, __emoji_u1F63E, __emoji_u1F63F, __emoji_u1F640,
+	__emoji_u1F641, __emoji_u1F642, __emoji_u1F643, __emoji_u1F644
+};
+
+static uint8_t *g_atlas;
+static size_t g_atlas_size;
+
+static uint32_t append(const void *data, size_t size)
+{
+	uint32_t offset = (g_atlas_size + 3) & ~3;
+
+	g_atlas = realloc(g_atlas, offset + size);
+	if (!g_atlas) {
+		printf("Out of memory\n");
+		exit(1);
+	}
+
+	memset(g_atlas + g_atlas_size, 0, offset - g_atlas_size);
+	if (data) {
+		memcpy(g_atlas + offset, data, size);
+	}
+	g_atlas_size = offset + size;
+
+	return offset;
+}
+
+/*
+ * Scale the emoji down to size x size with a box filter. The colors are
+ * weighted by alpha, so the transparent pixels do not darken the edges.
+ */
+static void scale_emoji(const uint8_t *emoji, int size, uint8_t *out)
+{
+	const ui_bitmap_data_t *header = (const ui_bitmap_data_t *)emoji;
+	const uint8_t *src = emoji + header->header_size;
+	int w = header->width;
+	int h = header->height;
+
+	for (int y = 0; y < size; y++) {
+		for (int x = 0; x < size; x++) {
+			int sx1 = x * w / size;
+			int sx2 = ((x + 1) * w + size - 1) / size;
+			int sy1 = y * h / size;
+			int sy2 = ((y + 1) * h + size - 1) / size;
+			uint32_t sum[4] = { 0, };
+			uint32_t count = 0;
+
+			for (int sy = sy1; sy < sy2; sy++) {
+				for (int sx = sx1; sx < sx2; sx++) {
+					const uint8_t *p = &src[(sy * w + sx) * 4];
+					sum[0] += p[0] * p[3];
+					sum[1] += p[1] * p[3];
+					sum[2] += p[2] * p[3];
+					sum[3] += p[3];
+					count++;
+				}
+			}
+
+			uint8_t *q = &out[(y * size + x) * 4];
+			for (int i = 0; i < 3; i++) {
+				q[i] = sum[3] ? (sum[i] + sum[3] / 2) / sum[3] : 0;
+			}
+			q[3] = count ? (sum[3] + count / 2) / count : 0;
+		}
+	}
+}
+
+static void convert_to_c(const char *c_filename, const char *var_name)
+{
+	FILE *fp = fopen(c_filename, "w");
+	if (!fp) {
+		printf("Cannot open %s\n", c_filename);
+		exit(1);
+	}
+
+	fprintf(fp, "#include <stdint.h>\n\n");
+	fprintf(fp, "const uint8_t %s[%lu] __attribute__((aligned(4))) = {\n", var_name, (unsigned long)g_atlas_size);
+
+	for (size_t i = 0; i < g_atlas_size; i++) {
+		if (i % 32 == 0) {
+			fprintf(fp, "\t");
+		}
+		fprintf(fp, "0x%02x", g_atlas[i]);
+		if (i != g_atlas_size - 1) {
+			fprintf(fp, ",");
+		}
+		if (i % 32 == 31 || i == g_atlas_size - 1) {
+			fprintf(fp, "\n");
+		}
+	}
+
+	fprintf(fp, "};\n\n");
+
+	fclose(fp);
+}
+
+int main(int argc, char *argv[])
+{
+	stbtt_fontinfo info;
+	ui_glyph_atlas_t header;
+	ui_glyph_atlas_entry_t *entries;
+	uint8_t *ttf;
+	long ttf_size;
+	int font_size;
+	int with_emoji;
+	int count;
+	int n = 0;
+
+	if (argc < 5) {
+		printf("Usage: %s <ttf filename> <font size> <c filename> <variable name> [--no-emoji]\n", argv[0]);
+		return 0;
+	}
+
+	font_size = atoi(argv[2]);
+	with_emoji = !(argc > 5 && strcmp(argv[5], "--no-emoji") == 0);
+	if (font_size <= 0) {
+		printf("Invalid font size: %s\n", argv[2]);
+		return 1;
+	}
+
+	FILE *fp = fopen(argv[1], "rb");
+	if (!fp) {
+		printf("Cannot open %s\n", argv[1]);
+		return 1;
+	}
+
+	fseek(fp, 0, SEEK_END);
+	ttf_size = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+
+	ttf = malloc(ttf_size);
+	if (!ttf || fread(ttf, 1, ttf_size, fp) != (size_t)ttf_size) {
+		printf("Cannot read %s\n", argv[1]);
+		fclose(fp);
+		return 1;
+	}
+	fclose(fp);
+
+	if (!stbtt_InitFont(&info, ttf, 0)) {
+		printf("Invalid font file: %s\n", argv[1]);
+		return 1;
+	}
+
+	count = (ASCII_END - ASCII_START + 1) + (with_emoji ? EMOJI_COUNT : 0);
+
+	header.magic = UI_GLYPH_ATLAS_MAGIC;
+	header.font_size = font_size;
+	header.glyph_count = count;
+	header.header_size = sizeof(ui_glyph_atlas_t) + count * sizeof(ui_glyph_atlas_entry_t);
+
+	append(&header, sizeof(header));
+	append(NULL, count * sizeof(ui_glyph_atlas_entry_t));
+
+	// The same bitmaps as the text widget rasterizes
+	float scale = stbtt_ScaleForPixelHeight(&info, font_size);
+	for (int code = ASCII_START; code <= ASCII_END; code++, n++) {
+		int x1, y1, x2, y2;
+		ui_glyph_atlas_entry_t entry = { 0, };
+
+		stbtt_GetCodepointBitmapBox(&info, code, scale, scale, &x1, &y1, &x2, &y2);
+		entry.utf_code = code;
+		entry.pf = UI_PIXEL_FORMAT_A8;
+		entry.offset_y = y1;
+
+		if (x2 > x1 && y2 > y1) {
+			entry.width = x2 - x1;
+			entry.height = y2 - y1;
+			entry.offset = append(NULL, entry.width * entry.height);
+			stbtt_MakeCodepointBitmap(&info, g_atlas + entry.offset, entry.width, entry.height, entry.width, scale, scale, code);
+		}
+
+		entries = (ui_glyph_atlas_entry_t *)(g_atlas + sizeof(ui_glyph_atlas_t));
+		entries[n] = entry;
+	}
+
+	for (int i = 0; with_emoji && i < EMOJI_COUNT; i++, n++) {
+		ui_glyph_atlas_entry_t entry = { 0, };
+
+		entry.utf_code = EMOJI_START + i;
+		entry.pf = UI_PIXEL_FORMAT_RGBA8888;
+		entry.width = font_size;
+		entry.height = font_size;
+		entry.offset = append(NULL, font_size * font_size * 4);
+		scale_emoji(g_emoji[i], font_size, g_atlas + entry.offset);
+
+		entries = (ui_glyph_atlas_entry_t *)(g_atlas + sizeof(ui_glyph_atlas_t));
+		entries[n] = entry;
+	}
+
+	convert_to_c(argv[3], argv[4]);
+
+	printf("%s: %d glyphs of %dpx, %lu bytes\n", argv[4], count, font_size, (unsigned long)g_atlas_size);
+
+	free(g_atlas);
+	free(ttf);
+
+	return 0;
+}
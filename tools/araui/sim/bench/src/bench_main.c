@@ -0,0 +1,338 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <araui/ui_asset.h>
+#include <araui/ui_core.h>
+#include <araui/ui_window.h>
+#include <araui/ui_widget.h>
+#include "ui_asset_internal.h"
+#include "dal/dal_ram.h"
+#if defined(CONFIG_UI_DAL_LCD)
+#include "lcd/lcd_ram.h"
+#endif
+
+#define CARD_WIDTH      (160)
+#define CARD_HEIGHT     (100)
+#define CARD_ROWS       (12)
+#define CARD_MARGIN     (13)
+
+#define PAGE_COUNT      (4)
+#define ICON_SIZE       (96)
+
+#define TEXT_ROWS       (24)
+#define TEXT_HEIGHT     (40)
+#define FONT_SIZE       (20)
+
+#define GESTURES        (4)
+#define IDLE_MS         (200)
+
+#if defined(CONFIG_UI_GLYPH_ATLAS)
+extern const uint8_t g_bench_atlas[];
+#endif
+
+static uint8_t *g_bitmaps[CARD_ROWS * 2 + PAGE_COUNT * 5];
+static int g_bitmap_count;
+
+static void on_create_cb(ui_window_t window)
+{
+
+}
+
+static void on_destroy_cb(ui_window_t window)
+{
+
+}
+
+static void on_show_cb(ui_window_t window)
+{
+
+}
+
+static void on_hide_cb(ui_window_t window)
+{
+
+}
+
+/*
+ * A gradient bitmap. The RGBA8888 ones are rounded rectangles or circles,
+ * with transparent corners and soft edges.
+ */
+static ui_asset_t make_image(int32_t width, int32_t height, ui_pixel_format_t pf, int32_t radius, uint32_t seed)
+{
+	ui_bitmap_data_t *bitmap;
+	int32_t bpp = (pf == UI_PIXEL_FORMAT_RGBA8888) ? 4 : 3;
+	int32_t cx;
+	int32_t cy;
+	int32_t d;
+	int32_t a;
+	uint8_t *p;
+	int x;
+	int y;
+
+	bitmap = (ui_bitmap_data_t *)malloc(sizeof(ui_bitmap_data_t) + width * height * bpp);
+	if (!bitmap) {
+		return UI_NULL;
+	}
+	g_bitmaps[g_bitmap_count++] = (uint8_t *)bitmap;
+
+	memset(bitmap, 0, sizeof(ui_bitmap_data_t));
+	bitmap->width = width;
+	bitmap->height = height;
+	bitmap->pf = pf;
+	bitmap->header_size = sizeof(ui_bitmap_data_t);
+	bitmap->data_size = width * height * bpp;
+
+	p = (uint8_t *)bitmap + sizeof(ui_bitmap_data_t);
+	for (y = 0; y < height; y++) {
+		for (x = 0; x < width; x++, p += bpp) {
+			p[0] = (uint8_t)(seed * 37 + x * 255 / width);
+			p[1] = (uint8_t)(seed * 91 + y * 255 / height);
+			p[2] = (uint8_t)(seed * 53 + (x ^ y));
+			if (bpp == 3) {
+				continue;
+			}
+
+			// Distance out of the rounded rectangle, in 1/16 pixels
+			cx = x < radius ? radius - x : (x >= width - radius ? x - (width - radius - 1) : 0);
+			cy = y < radius ? radius - y : (y >= height - radius ? y - (height - radius - 1) : 0);
+			d = (cx * cx + cy * cy) * 16 / (radius ? radius : 1) - radius * 16 + 16;
+			a = (cx == 0 && cy == 0) ? 255 : 255 - d * 255 / 32;
+			p[3] = (uint8_t)(a < 0 ? 0 : (a > 255 ? 255 : a));
+		}
+	}
+
+	return ui_image_asset_create_from_buffer((uint8_t *)bitmap);
+}
+
+static void free_images(void)
+{
+	while (g_bitmap_count > 0) {
+		free(g_bitmaps[--g_bitmap_count]);
+	}
+}
+
+static void reset_stat(void)
+{
+	dal_ram_reset_stat();
+#if defined(CONFIG_UI_DAL_LCD)
+	lcd_ram_reset_stat();
+#endif
+}
+
+static void report(const char *name)
+{
+	dal_ram_stat_t stat = dal_ram_get_stat();
+	uint64_t usec = stat.usec ? stat.usec : 1;
+
+	printf("%-10s : %5u frames, %8u usec/frame, %5u.%u fps, %4u rects/frame, %7u pixels/frame, ",
+		name, stat.frames,
+		(unsigned int)(usec / (stat.frames ? stat.frames : 1)),
+		(unsigned int)(stat.frames * 1000000ULL / usec),
+		(unsigned int)(stat.frames * 10000000ULL / usec % 10),
+		stat.frames ? stat.rects / stat.frames : 0,
+		(unsigned int)(stat.frames ? stat.pixels / stat.frames : 0));
+#if defined(CONFIG_UI_DAL_LCD)
+	printf("%8u usec/frame on the link, ",
+		(unsigned int)(lcd_ram_get_busy_usec() / (stat.frames ? stat.frames : 1)));
+#endif
+	printf("checksum %08x\n", dal_ram_checksum());
+}
+
+/*
+ * Two columns of cards in a vertical scroll widget, which is dragged up and
+ * down by half of the display.
+ */
+static void bench_scroll(void)
+{
+	ui_window_t window;
+	ui_widget_t scroll;
+	ui_widget_t card;
+	int i;
+
+	window = ui_window_create(on_create_cb, on_destroy_cb, on_show_cb, on_hide_cb);
+	scroll = ui_scroll_widget_create(CONFIG_UI_DISPLAY_WIDTH, CONFIG_UI_DISPLAY_HEIGHT);
+	ui_scroll_widget_set_direction(scroll, UI_DIRECTION_VERTICAL);
+	ui_scroll_widget_set_content_size(scroll, CONFIG_UI_DISPLAY_WIDTH, CARD_ROWS * (CARD_HEIGHT + CARD_MARGIN) + CARD_MARGIN);
+
+	for (i = 0; i < CARD_ROWS * 2; i++) {
+		card = ui_image_widget_create(make_image(CARD_WIDTH, CARD_HEIGHT, UI_PIXEL_FORMAT_RGBA8888, 12, i));
+		ui_widget_add_child(scroll, card,
+			CARD_MARGIN + (i % 2) * (CARD_WIDTH + CARD_MARGIN),
+			CARD_MARGIN + (i / 2) * (CARD_HEIGHT + CARD_MARGIN));
+	}
+	ui_window_add_widget(window, scroll, 0, 0);
+	dal_ram_wait_idle(IDLE_MS);
+
+	reset_stat();
+	for (i = 0; i < GESTURES * 2; i++) {
+		if (i < GESTURES) {
+			dal_ram_drag(180, 270, 180, 90, 30);
+		} else {
+			dal_ram_drag(180, 90, 180, 270, 30);
+		}
+		dal_ram_wait_idle(IDLE_MS);
+	}
+	report("scroll");
+
+	ui_window_destroy(window);
+	dal_ram_wait_idle(IDLE_MS);
+}
+
+/*
+ * A vertical scroll of text rows, which is dragged up and down like the
+ * cards. Every frame redraws all visible glyphs.
+ */
+static void bench_text(const char *font_path)
+{
+	static const char *words[] = {
+		"Alarm", "Weather", "Music", "Settings", "Battery", "Message", "Timer", "Calendar"
+	};
+	ui_window_t window;
+	ui_widget_t scroll;
+	ui_widget_t text;
+	ui_asset_t font;
+	char buf[64];
+	int i;
+
+	font = ui_font_asset_create_from_file(font_path);
+	if (!font) {
+		printf("text       : cannot load %s\n", font_path);
+		return;
+	}
+
+#if defined(CONFIG_UI_GLYPH_ATLAS)
+	ui_font_asset_set_atlas(font, g_bench_atlas);
+#endif
+
+	window = ui_window_create(on_create_cb, on_destroy_cb, on_show_cb, on_hide_cb);
+	scroll = ui_scroll_widget_create(CONFIG_UI_DISPLAY_WIDTH, CONFIG_UI_DISPLAY_HEIGHT);
+	ui_scroll_widget_set_direction(scroll, UI_DIRECTION_VERTICAL);
+	ui_scroll_widget_set_content_size(scroll, CONFIG_UI_DISPLAY_WIDTH, TEXT_ROWS * TEXT_HEIGHT);
+
+	for (i = 0; i < TEXT_ROWS; i++) {
+		snprintf(buf, sizeof(buf), "%02d %s %s \xf0\x9f\x98\x80 0x%04X", i, words[i % 8], words[(i * 3 + 1) % 8], i * 2749);
+		text = ui_text_widget_create(CONFIG_UI_DISPLAY_WIDTH - 20, TEXT_HEIGHT, font, buf, FONT_SIZE);
+		ui_text_widget_set_align(text, UI_ALIGN_LEFT | UI_ALIGN_MIDDLE);
+		ui_widget_add_child(scroll, text, 10, i * TEXT_HEIGHT);
+	}
+	ui_window_add_widget(window, scroll, 0, 0);
+	dal_ram_wait_idle(IDLE_MS);
+
+	reset_stat();
+	for (i = 0; i < GESTURES * 2; i++) {
+		if (i < GESTURES) {
+			dal_ram_drag(180, 270, 180, 90, 30);
+		} else {
+			dal_ram_drag(180, 90, 180, 270, 30);
+		}
+		dal_ram_wait_idle(IDLE_MS);
+	}
+	report("text");
+
+	ui_window_destroy(window);
+	dal_ram_wait_idle(IDLE_MS);
+	ui_font_asset_destroy(font);
+}
+
+/*
+ * Pages of an RGB888 background with four RGBA8888 icons, swiped to the
+ * next page and back. The paginator tweens the pages after each swipe.
+ */
+static void bench_paginator(void)
+{
+	ui_window_t window;
+	ui_widget_t pages[PAGE_COUNT];
+	ui_widget_t paginator;
+	ui_widget_t icon;
+	int i;
+	int j;
+
+	window = ui_window_create(on_create_cb, on_destroy_cb, on_show_cb, on_hide_cb);
+	for (i = 0; i < PAGE_COUNT; i++) {
+		pages[i] = ui_image_widget_create(make_image(CONFIG_UI_DISPLAY_WIDTH, CONFIG_UI_DISPLAY_HEIGHT, UI_PIXEL_FORMAT_RGB888, 0, i));
+		for (j = 0; j < 4; j++) {
+			icon = ui_image_widget_create(make_image(ICON_SIZE, ICON_SIZE, UI_PIXEL_FORMAT_RGBA8888, ICON_SIZE / 2, i * 4 + j));
+			ui_widget_add_child(pages[i], icon, 56 + (j % 2) * 152, 56 + (j / 2) * 152);
+		}
+	}
+	paginator = ui_paginator_widget_create(CONFIG_UI_DISPLAY_WIDTH, CONFIG_UI_DISPLAY_HEIGHT, pages, PAGE_COUNT);
+	ui_window_add_widget(window, paginator, 0, 0);
+	dal_ram_wait_idle(IDLE_MS);
+
+	reset_stat();
+	for (i = 0; i < GESTURES * 2; i++) {
+		if (i < GESTURES) {
+			dal_ram_drag(300, 180, 60, 180, 20);
+		} else {
+			dal_ram_drag(60, 180, 300, 180, 20);
+		}
+		dal_ram_wait_idle(IDLE_MS);
+	}
+	report("paginator");
+
+	ui_window_destroy(window);
+	dal_ram_wait_idle(IDLE_MS);
+}
+
+int main(int argc, char *argv[])
+{
+	if (ui_start() != UI_OK) {
+		printf("ui_start failed\n");
+		return 1;
+	}
+
+#if defined(CONFIG_UI_SPAN_RENDERER)
+	printf("AraUI %dx%d, span renderer", CONFIG_UI_DISPLAY_WIDTH, CONFIG_UI_DISPLAY_HEIGHT);
+#else
+	printf("AraUI %dx%d, pixel renderer", CONFIG_UI_DISPLAY_WIDTH, CONFIG_UI_DISPLAY_HEIGHT);
+#endif
+#if defined(CONFIG_UI_GLYPH_ATLAS)
+	printf(", glyph atlas");
+#elif defined(CONFIG_UI_GLYPH_CACHE)
+	printf(", glyph cache");
+#endif
+#if defined(CONFIG_UI_DAL_LCD_SINGLE_BUFFER)
+	printf(", lcd single buffer");
+#elif defined(CONFIG_UI_DAL_LCD_DOUBLE_BUFFER)
+	printf(", lcd double buffer");
+#elif defined(CONFIG_UI_DAL_LCD_PARTIAL_BUFFER)
+	printf(", lcd partial buffer");
+#endif
+#if defined(CONFIG_UI_DAL_LCD_VSYNC)
+	printf(", vsync");
+#endif
+	printf("\n");
+
+	bench_scroll();
+	bench_paginator();
+	if (argc > 1) {
+		bench_text(argv[1]);
+	} else {
+		printf("text       : skipped, run with a TTF file to measure text rendering\n");
+	}
+
+	ui_stop();
+	free_images();
+
+	return 0;
+}
@@ -0,0 +1,357 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+#include <tinyara/config.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+
+//!< AraUI Public
+#include <araui/ui_commons.h>
+
+//!< AraUI Internal
+#include "ui_debug.h"
+#include "ui_commons_internal.h"
+#include "dal/ui_dal.h"
+
+//!< Local
+#include "dal_ram.h"
+#if defined(CONFIG_UI_DAL_LCD)
+#include "../lcd/lcd_ram.h"
+#endif
+
+/****************************************************************************
+ * Macros
+ ****************************************************************************/
+#define FRONT_PAGE     (0)
+#define BACK_PAGE      (1)
+#define FB_STRIDE      (CONFIG_UI_DISPLAY_WIDTH * 3)
+#define FB_SIZE        (FB_STRIDE * CONFIG_UI_DISPLAY_HEIGHT)
+
+#define IDLE_TIMEOUT_MS (10000)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+typedef struct {
+	bool active;
+	int step;
+	int steps;
+	int32_t x1;
+	int32_t y1;
+	int32_t x2;
+	int32_t y2;
+} dal_ram_drag_t;
+
+/****************************************************************************
+ * Private Variables
+ ****************************************************************************/
+#if !defined(CONFIG_UI_DAL_LCD)
+static uint8_t             *g_fb[2];
+static ui_rect_t            g_viewport = {0, };
+#endif
+static pthread_mutex_t      g_mutex = PTHREAD_MUTEX_INITIALIZER;
+static dal_ram_drag_t       g_drag;
+static bool                 g_touch_delivered;
+static bool                 g_redrawn;
+static uint64_t             g_frame_start;
+static uint64_t             g_last_redraw;
+static dal_ram_stat_t       g_stat;
+
+static uint64_t _now_usec(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void _dal_ram_count_redraw(int32_t width, int32_t height)
+{
+	pthread_mutex_lock(&g_mutex);
+	g_stat.rects++;
+	g_stat.pixels += width * height;
+	g_redrawn = true;
+	pthread_mutex_unlock(&g_mutex);
+}
+
+static void _dal_ram_start_frame(uint64_t now)
+{
+	pthread_mutex_lock(&g_mutex);
+	if (g_redrawn) {
+		g_stat.frames++;
+		g_stat.usec += now - g_frame_start;
+		g_last_redraw = now;
+		g_redrawn = false;
+	}
+	g_frame_start = now;
+	g_touch_delivered = false;
+	pthread_mutex_unlock(&g_mutex);
+}
+
+#if defined(CONFIG_UI_DAL_LCD)
+
+/****************************************************************************
+ * Frame Timing of the LCD DAL
+ ****************************************************************************/
+
+/*
+ * The DAL is ui_dal_lcd.c of AraUI on the LCD of lcd_ram.c. The Makefile
+ * links with --wrap, so the UI loop calls these around its redraw and clear.
+ */
+UI_DAL void __real_ui_dal_redraw(int32_t x, int32_t y, int32_t width, int32_t height);
+UI_DAL void __real_ui_dal_clear(void);
+
+UI_DAL void __wrap_ui_dal_redraw(int32_t x, int32_t y, int32_t width, int32_t height)
+{
+	__real_ui_dal_redraw(x, y, width, height);
+	_dal_ram_count_redraw(width, height);
+}
+
+UI_DAL void __wrap_ui_dal_clear(void)
+{
+	_dal_ram_start_frame(_now_usec());
+	__real_ui_dal_clear();
+}
+
+#else
+
+/****************************************************************************
+ * DAL Interface Implementation
+ ****************************************************************************/
+UI_DAL ui_error_t ui_dal_init(void)
+{
+	g_fb[FRONT_PAGE] = (uint8_t *)UI_ALLOC(FB_SIZE);
+	g_fb[BACK_PAGE] = (uint8_t *)UI_ALLOC(FB_SIZE);
+	if (!g_fb[FRONT_PAGE] || !g_fb[BACK_PAGE]) {
+		UI_LOGE("error: cannot alloc the framebuffer!\n");
+		return UI_INIT_FAILURE;
+	}
+
+	memset(g_fb[FRONT_PAGE], 0, FB_SIZE);
+	memset(g_fb[BACK_PAGE], 0, FB_SIZE);
+	g_frame_start = _now_usec();
+
+	return UI_OK;
+}
+
+UI_DAL ui_error_t ui_dal_deinit(void)
+{
+	UI_FREE(g_fb[FRONT_PAGE]);
+	UI_FREE(g_fb[BACK_PAGE]);
+
+	return UI_OK;
+}
+
+UI_DAL void ui_dal_redraw(int32_t x, int32_t y, int32_t width, int32_t height)
+{
+	int32_t offset;
+	int i;
+
+	pthread_mutex_lock(&g_mutex);
+	for (i = 0; i < height; i++) {
+		offset = (y + i) * FB_STRIDE + x * 3;
+		memcpy(&g_fb[FRONT_PAGE][offset], &g_fb[BACK_PAGE][offset], width * 3);
+	}
+	pthread_mutex_unlock(&g_mutex);
+
+	_dal_ram_count_redraw(width, height);
+}
+
+/* Called at the start of each frame of the UI loop */
+UI_DAL void ui_dal_clear(void)
+{
+	uint64_t now = _now_usec();
+
+	memset(g_fb[BACK_PAGE], 0, FB_SIZE);
+
+	_dal_ram_start_frame(now);
+}
+
+UI_DAL void ui_dal_put_pixel_rgba8888(int32_t x, int32_t y, ui_color_t color)
+{
+	ui_color_rgba8888_t *fg;
+	ui_color_rgb888_t *bg;
+
+	if (x < 0 || x >= CONFIG_UI_DISPLAY_WIDTH || y < 0 || y >= CONFIG_UI_DISPLAY_HEIGHT) {
+		return;
+	}
+
+	fg = (ui_color_rgba8888_t *)&color;
+	bg = (ui_color_rgb888_t *)&g_fb[BACK_PAGE][y * FB_STRIDE + x * 3];
+
+	bg->r = ((fg->r * fg->a) + (bg->r * (255 - fg->a))) / 255;
+	bg->g = ((fg->g * fg->a) + (bg->g * (255 - fg->a))) / 255;
+	bg->b = ((fg->b * fg->a) + (bg->b * (255 - fg->a))) / 255;
+}
+
+UI_DAL void ui_dal_put_pixel_rgb888(int32_t x, int32_t y, ui_color_t color)
+{
+	ui_color_rgb888_t *fg;
+	ui_color_rgb888_t *bg;
+
+	if (x < 0 || x >= CONFIG_UI_DISPLAY_WIDTH || y < 0 || y >= CONFIG_UI_DISPLAY_HEIGHT) {
+		return;
+	}
+
+	fg = (ui_color_rgb888_t *)&color;
+	bg = (ui_color_rgb888_t *)&g_fb[BACK_PAGE][y * FB_STRIDE + x * 3];
+	bg->r = fg->r;
+	bg->g = fg->g;
+	bg->b = fg->b;
+}
+
+#if defined(CONFIG_UI_SPAN_RENDERER)
+UI_DAL void ui_dal_blit_rgba8888(int32_t x, int32_t y, int32_t width, int32_t height,
+	const uint8_t *buf, int32_t stride)
+{
+	const uint8_t *fg;
+	uint8_t *bg;
+	int32_t a;
+	int i;
+	int j;
+
+	for (i = 0; i < height; i++) {
+		fg = buf + i * stride;
+		bg = &g_fb[BACK_PAGE][(y + i) * FB_STRIDE + x * 3];
+		for (j = 0; j < width; j++, fg += 4, bg += 3) {
+			a = fg[3];
+			if (a == 255) {
+				bg[0] = fg[0];
+				bg[1] = fg[1];
+				bg[2] = fg[2];
+			} else if (a != 0) {
+				bg[0] = ((fg[0] * a) + (bg[0] * (255 - a))) / 255;
+				bg[1] = ((fg[1] * a) + (bg[1] * (255 - a))) / 255;
+				bg[2] = ((fg[2] * a) + (bg[2] * (255 - a))) / 255;
+			}
+		}
+	}
+}
+#endif
+
+UI_DAL ui_error_t ui_dal_set_viewport(int32_t x, int32_t y, int32_t width, int32_t height)
+{
+	g_viewport.x = x;
+	g_viewport.y = y;
+	g_viewport.width = width;
+	g_viewport.height = height;
+
+	return UI_OK;
+}
+
+UI_DAL ui_rect_t ui_dal_get_viewport(void)
+{
+	return g_viewport;
+}
+
+#endif // CONFIG_UI_DAL_LCD
+
+UI_DAL bool ui_dal_get_touch(bool *pressed, ui_coord_t *coord)
+{
+	bool ret = false;
+
+	pthread_mutex_lock(&g_mutex);
+	if (g_drag.active && !g_touch_delivered) {
+		if (g_drag.step <= g_drag.steps) {
+			*pressed = true;
+			coord->x = g_drag.x1 + (g_drag.x2 - g_drag.x1) * g_drag.step / g_drag.steps;
+			coord->y = g_drag.y1 + (g_drag.y2 - g_drag.y1) * g_drag.step / g_drag.steps;
+		} else {
+			*pressed = false;
+			coord->x = g_drag.x2;
+			coord->y = g_drag.y2;
+			g_drag.active = false;
+		}
+		g_drag.step++;
+		g_touch_delivered = true;
+		ret = true;
+	}
+	pthread_mutex_unlock(&g_mutex);
+
+	return ret;
+}
+
+/****************************************************************************
+ * Benchmark Interface
+ ****************************************************************************/
+void dal_ram_drag(int32_t x1, int32_t y1, int32_t x2, int32_t y2, int steps)
+{
+	pthread_mutex_lock(&g_mutex);
+	g_drag.x1 = x1;
+	g_drag.y1 = y1;
+	g_drag.x2 = x2;
+	g_drag.y2 = y2;
+	g_drag.steps = steps > 0 ? steps : 1;
+	g_drag.step = 0;
+	g_drag.active = true;
+	pthread_mutex_unlock(&g_mutex);
+}
+
+void dal_ram_wait_idle(int idle_ms)
+{
+	uint64_t start = _now_usec();
+	uint64_t now;
+	bool idle;
+
+	do {
+		usleep(1000);
+		now = _now_usec();
+		pthread_mutex_lock(&g_mutex);
+		idle = !g_drag.active && now - g_last_redraw >= (uint64_t)idle_ms * 1000;
+		pthread_mutex_unlock(&g_mutex);
+	} while (!idle && now - start < (uint64_t)IDLE_TIMEOUT_MS * 1000);
+}
+
+void dal_ram_reset_stat(void)
+{
+	pthread_mutex_lock(&g_mutex);
+	memset(&g_stat, 0, sizeof(g_stat));
+	pthread_mutex_unlock(&g_mutex);
+}
+
+dal_ram_stat_t dal_ram_get_stat(void)
+{
+	dal_ram_stat_t stat;
+
+	pthread_mutex_lock(&g_mutex);
+	stat = g_stat;
+	pthread_mutex_unlock(&g_mutex);
+
+	return stat;
+}
+
+uint32_t dal_ram_checksum(void)
+{
+#if defined(CONFIG_UI_DAL_LCD)
+	return lcd_ram_checksum();
+#else
+	uint32_t sum = 2166136261U;
+	int i;
+
+	pthread_mutex_lock(&g_mutex);
+	for (i = 0; i < FB_SIZE; i++) {
+		sum = (sum ^ g_fb[FRONT_PAGE][i]) * 16777619;
+	}
+	pthread_mutex_unlock(&g_mutex);
+
+	return sum;
+#endif
+}
@@ -0,0 +1,50 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+#ifndef __DAL_RAM_H__
+#define __DAL_RAM_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct {
+	uint32_t frames;	//!< Frames which redrew the display
+	uint64_t usec;		//!< Time spent in those frames
+	uint32_t rects;		//!< Redrawn rects
+	uint64_t pixels;	//!< Redrawn pixels
+} dal_ram_stat_t;
+
+/**
+ * @brief Touch down at (x1, y1), move to (x2, y2) in steps frames, and touch up.
+ * One touch event is delivered in each frame.
+ */
+void dal_ram_drag(int32_t x1, int32_t y1, int32_t x2, int32_t y2, int steps);
+
+/**
+ * @brief Wait until the drag is delivered and the display is not redrawn for idle_ms.
+ */
+void dal_ram_wait_idle(int idle_ms);
+
+void dal_ram_reset_stat(void);
+dal_ram_stat_t dal_ram_get_stat(void);
+
+/**
+ * @brief FNV-1a hash of the displayed framebuffer.
+ */
+uint32_t dal_ram_checksum(void);
+
+#endif // __DAL_RAM_H__
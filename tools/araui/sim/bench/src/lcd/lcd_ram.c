@@ -0,0 +1,262 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+#include <tinyara/config.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include <tinyara/board.h>
+#include <tinyara/lcd/lcd.h>
+
+//!< Local
+#include "lcd_ram.h"
+
+/****************************************************************************
+ * Macros
+ ****************************************************************************/
+#define LCD_BPP        (3)
+#define GRAM_STRIDE    (CONFIG_UI_DISPLAY_WIDTH * LCD_BPP)
+#define GRAM_SIZE      (GRAM_STRIDE * CONFIG_UI_DISPLAY_HEIGHT)
+
+/****************************************************************************
+ * Private Variables
+ ****************************************************************************/
+static uint8_t              g_gram[GRAM_SIZE];
+static uint8_t              g_runbuffer[GRAM_STRIDE];
+static pthread_mutex_t      g_mutex = PTHREAD_MUTEX_INITIALIZER;
+static struct lcd_dev_s     g_lcddev;
+static int                  g_initialized;
+static int                  g_power;
+static uint64_t             g_link_free;
+static uint64_t             g_busy_usec;
+static uint64_t             g_start;
+
+static uint64_t _now_usec(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void _sleep_until(uint64_t usec)
+{
+	struct timespec ts;
+
+	ts.tv_sec = usec / 1000000;
+	ts.tv_nsec = (usec % 1000000) * 1000;
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {
+	}
+}
+
+/*
+ * Copy the rows into the memory, and keep the caller until the link would
+ * have sent them. Back to back transfers are timed from the end of the
+ * previous one, so the errors of the sleeps are not accumulated.
+ */
+static void _lcd_ram_write(fb_coord_t row, fb_coord_t col, fb_coord_t row2, fb_coord_t col2, const uint8_t *buffer)
+{
+	size_t bytes = (col2 - col + 1) * LCD_BPP;
+	uint64_t now = _now_usec();
+	uint64_t usec;
+	int i;
+
+	pthread_mutex_lock(&g_mutex);
+	for (i = row; i <= row2; i++, buffer += bytes) {
+		memcpy(&g_gram[i * GRAM_STRIDE + col * LCD_BPP], buffer, bytes);
+	}
+
+	usec = LCD_RAM_CMD_USEC + (uint64_t)bytes * (row2 - row + 1) * 1000000 / LCD_RAM_LINK_RATE;
+	g_link_free = (g_link_free > now ? g_link_free : now) + usec;
+	g_busy_usec += usec;
+	now = g_link_free;
+	pthread_mutex_unlock(&g_mutex);
+
+	_sleep_until(now);
+}
+
+static int lcd_ram_putrun(fb_coord_t row, fb_coord_t col, const uint8_t *buffer, size_t npixels)
+{
+	if (row >= CONFIG_UI_DISPLAY_HEIGHT || col + npixels > CONFIG_UI_DISPLAY_WIDTH) {
+		return -EINVAL;
+	}
+
+	_lcd_ram_write(row, col, row, col + npixels - 1, buffer);
+
+	return OK;
+}
+
+static int lcd_ram_getrun(fb_coord_t row, fb_coord_t col, uint8_t *buffer, size_t npixels)
+{
+	if (row >= CONFIG_UI_DISPLAY_HEIGHT || col + npixels > CONFIG_UI_DISPLAY_WIDTH) {
+		return -EINVAL;
+	}
+
+	pthread_mutex_lock(&g_mutex);
+	memcpy(buffer, &g_gram[row * GRAM_STRIDE + col * LCD_BPP], npixels * LCD_BPP);
+	pthread_mutex_unlock(&g_mutex);
+
+	return OK;
+}
+
+#ifdef CONFIG_LCD_DMA_SUPPORT
+static int lcd_ram_putdma(fb_coord_t row, fb_coord_t col, fb_coord_t row2, fb_coord_t col2, const uint8_t *buffer)
+{
+	if (row > row2 || col > col2 || row2 >= CONFIG_UI_DISPLAY_HEIGHT || col2 >= CONFIG_UI_DISPLAY_WIDTH) {
+		return -EINVAL;
+	}
+
+	_lcd_ram_write(row, col, row2, col2, buffer);
+
+	return OK;
+}
+#endif
+
+static int lcd_ram_getvideoinfo(struct lcd_dev_s *dev, struct fb_videoinfo_s *vinfo)
+{
+	vinfo->fmt = FB_FMT_RGB24;
+	vinfo->xres = CONFIG_UI_DISPLAY_WIDTH;
+	vinfo->yres = CONFIG_UI_DISPLAY_HEIGHT;
+	vinfo->nplanes = 1;
+
+	return OK;
+}
+
+static int lcd_ram_getplaneinfo(struct lcd_dev_s *dev, unsigned int planeno, struct lcd_planeinfo_s *pinfo)
+{
+	if (planeno != 0) {
+		return -EINVAL;
+	}
+
+	pinfo->putrun = lcd_ram_putrun;
+	pinfo->getrun = lcd_ram_getrun;
+	pinfo->buffer = g_runbuffer;
+	pinfo->bpp = LCD_BPP * 8;
+#ifdef CONFIG_LCD_DMA_SUPPORT
+	pinfo->putdma = lcd_ram_putdma;
+#endif
+
+	return OK;
+}
+
+static int lcd_ram_getpower(struct lcd_dev_s *dev)
+{
+	return g_power;
+}
+
+static int lcd_ram_setpower(struct lcd_dev_s *dev, int power)
+{
+	g_power = power;
+
+	return OK;
+}
+
+static int lcd_ram_getcontrast(struct lcd_dev_s *dev)
+{
+	return -ENOSYS;
+}
+
+static int lcd_ram_setcontrast(struct lcd_dev_s *dev, unsigned int contrast)
+{
+	return -ENOSYS;
+}
+
+#ifdef CONFIG_LCD_TEARING_EFFECT
+/* The panel starts a refresh every 1 / LCD_RAM_REFRESH_HZ second */
+static int lcd_ram_waitvsync(struct lcd_dev_s *dev)
+{
+	const uint64_t period = 1000000 / LCD_RAM_REFRESH_HZ;
+	uint64_t now = _now_usec();
+
+	_sleep_until(now + period - (now - g_start) % period);
+
+	return OK;
+}
+#endif
+
+/****************************************************************************
+ * Board Interface
+ ****************************************************************************/
+int board_lcd_initialize(void)
+{
+	g_lcddev.getvideoinfo = lcd_ram_getvideoinfo;
+	g_lcddev.getplaneinfo = lcd_ram_getplaneinfo;
+	g_lcddev.getpower = lcd_ram_getpower;
+	g_lcddev.setpower = lcd_ram_setpower;
+	g_lcddev.getcontrast = lcd_ram_getcontrast;
+	g_lcddev.setcontrast = lcd_ram_setcontrast;
+#ifdef CONFIG_LCD_TEARING_EFFECT
+	g_lcddev.waitvsync = lcd_ram_waitvsync;
+#endif
+
+	memset(g_gram, 0, GRAM_SIZE);
+	g_start = _now_usec();
+	g_initialized = 1;
+
+	return OK;
+}
+
+struct lcd_dev_s *board_lcd_getdev(int lcddev)
+{
+	if (lcddev != 0 || !g_initialized) {
+		return NULL;
+	}
+
+	return &g_lcddev;
+}
+
+void board_lcd_uninitialize(void)
+{
+	g_initialized = 0;
+}
+
+/****************************************************************************
+ * Benchmark Interface
+ ****************************************************************************/
+uint64_t lcd_ram_get_busy_usec(void)
+{
+	uint64_t usec;
+
+	pthread_mutex_lock(&g_mutex);
+	usec = g_busy_usec;
+	pthread_mutex_unlock(&g_mutex);
+
+	return usec;
+}
+
+void lcd_ram_reset_stat(void)
+{
+	pthread_mutex_lock(&g_mutex);
+	g_busy_usec = 0;
+	pthread_mutex_unlock(&g_mutex);
+}
+
+uint32_t lcd_ram_checksum(void)
+{
+	uint32_t sum = 2166136261U;
+	int i;
+
+	pthread_mutex_lock(&g_mutex);
+	for (i = 0; i < GRAM_SIZE; i++) {
+		sum = (sum ^ g_gram[i]) * 16777619;
+	}
+	pthread_mutex_unlock(&g_mutex);
+
+	return sum;
+}
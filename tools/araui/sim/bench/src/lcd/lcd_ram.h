@@ -0,0 +1,45 @@
+/****************************************************************************
+ *
+ * Copyright 2023 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+#ifndef __LCD_RAM_H__
+#define __LCD_RAM_H__
+
+#include <stdint.h>
+
+/*
+ * A 24bpp LCD in RAM, returned by board_lcd_getdev(0). The transfers take
+ * the time of an LCD link of LCD_RAM_LINK_RATE bytes per second, and the
+ * panel refreshes at LCD_RAM_REFRESH_HZ.
+ */
+#ifndef LCD_RAM_LINK_RATE
+#define LCD_RAM_LINK_RATE   (10000000)
+#endif
+#define LCD_RAM_CMD_USEC    (5)
+#define LCD_RAM_REFRESH_HZ  (60)
+
+/**
+ * @brief Time the link was busy with the transfers.
+ */
+uint64_t lcd_ram_get_busy_usec(void);
+void lcd_ram_reset_stat(void);
+
+/**
+ * @brief FNV-1a hash of the LCD memory.
+ */
+uint32_t lcd_ram_checksum(void);
+
+#endif // __LCD_RAM_H__
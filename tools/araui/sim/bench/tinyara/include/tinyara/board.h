@@ -0,0 +1,11 @@
+#ifndef __BOARD_H__
+#define __BOARD_H__
+
+//!< The part of TizenRT <tinyara/board.h> used by the LCD DAL
+struct lcd_dev_s;
+
+int board_lcd_initialize(void);
+struct lcd_dev_s *board_lcd_getdev(int lcddev);
+void board_lcd_uninitialize(void);
+
+#endif
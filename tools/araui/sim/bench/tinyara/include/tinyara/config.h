@@ -0,0 +1,45 @@
+#ifndef __CONFIG_H__
+#define __CONFIG_H__
+
+//!< TizenRT Macro
+#define OK 0
+
+//!< Features
+#define CONFIG_UI
+#define CONFIG_UI_DISPLAY_RGB888
+#define CONFIG_UI_ENABLE_TOUCH
+#define CONFIG_UI_ENABLE_EMOJI
+#define CONFIG_UI_USE_BUILTIN_EMOJI
+#define CONFIG_UI_PARTIAL_UPDATE
+
+//!< Values
+#define CONFIG_UI_TOUCH_THRESHOLD     (10)
+#define CONFIG_UI_DISPLAY_WIDTH       (360)
+#define CONFIG_UI_DISPLAY_HEIGHT      (360)
+#define CONFIG_UI_STACK_SIZE          (8192)
+#define CONFIG_UI_UPDATE_MEMPOOL_SIZE (128)
+#define CONFIG_UI_MAXIMUM_FPS         (0)
+#define CONFIG_UI_DISPLAY_SCALE       (1)
+
+//!< Enabled by the Makefile, make SPAN=1
+#if defined(CONFIG_UI_SPAN_RENDERER)
+#define CONFIG_UI_SPAN_TILE_HEIGHT    (8)
+#endif
+
+//!< Enabled by the Makefile, make GLYPH=1
+#if defined(CONFIG_UI_GLYPH_CACHE)
+#define CONFIG_UI_GLYPH_CACHE_SIZE    (16384)
+#endif
+
+//!< Enabled by the Makefile, make LCD=<single|double|partial>
+#if defined(CONFIG_UI_DAL_LCD)
+#define CONFIG_LCD
+#define CONFIG_LCD_MAXPOWER            (1)
+#define CONFIG_LCD_DMA_SUPPORT
+#define CONFIG_LCD_TEARING_EFFECT
+#define CONFIG_UI_DAL_LCD_DEVNO        (0)
+#define CONFIG_UI_DAL_LCD_PARTIAL_ROWS (40)
+#define CONFIG_UI_DAL_LCD_STACK_SIZE   (8192)
+#endif
+
+#endif
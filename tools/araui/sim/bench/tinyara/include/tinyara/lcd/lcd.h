@@ -0,0 +1,34 @@
+#ifndef __LCD_LCD_H__
+#define __LCD_LCD_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <tinyara/video/fb.h>
+
+//!< The part of TizenRT <tinyara/lcd/lcd.h> used by the LCD DAL
+#define LCD_FULL_OFF     (0)
+#define LCD_FULL_ON      CONFIG_LCD_MAXPOWER
+
+struct lcd_planeinfo_s {
+	int (*putrun)(fb_coord_t row, fb_coord_t col, const uint8_t *buffer, size_t npixels);
+	int (*getrun)(fb_coord_t row, fb_coord_t col, uint8_t *buffer, size_t npixels);
+	uint8_t *buffer;
+	uint8_t  bpp;
+#ifdef CONFIG_LCD_DMA_SUPPORT
+	int (*putdma)(fb_coord_t row, fb_coord_t col, fb_coord_t row2, fb_coord_t col2, const uint8_t *buffer);
+#endif
+};
+
+struct lcd_dev_s {
+	int (*getvideoinfo)(struct lcd_dev_s *dev, struct fb_videoinfo_s *vinfo);
+	int (*getplaneinfo)(struct lcd_dev_s *dev, unsigned int planeno, struct lcd_planeinfo_s *pinfo);
+	int (*getpower)(struct lcd_dev_s *dev);
+	int (*setpower)(struct lcd_dev_s *dev, int power);
+	int (*getcontrast)(struct lcd_dev_s *dev);
+	int (*setcontrast)(struct lcd_dev_s *dev, unsigned int contrast);
+#ifdef CONFIG_LCD_TEARING_EFFECT
+	int (*waitvsync)(struct lcd_dev_s *dev);
+#endif
+};
+
+#endif
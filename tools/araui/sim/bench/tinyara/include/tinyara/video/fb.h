@@ -0,0 +1,19 @@
+#ifndef __VIDEO_FB_H__
+#define __VIDEO_FB_H__
+
+#include <stdint.h>
+
+//!< The part of TizenRT <tinyara/video/fb.h> used by the LCD DAL
+#define FB_FMT_RGB16_565 11
+#define FB_FMT_RGB24     12
+
+typedef uint16_t fb_coord_t;
+
+struct fb_videoinfo_s {
+	uint8_t    fmt;
+	fb_coord_t xres;
+	fb_coord_t yres;
+	uint8_t    nplanes;
+};
+
+#endif
@@ -193,6 +193,35 @@ inline UI_DAL void ui_dal_put_pixel_rgb888(int32_t x, int32_t y, ui_color_t colo
 	bg->b = fg->b;
 }
 
+#if defined(CONFIG_UI_SPAN_RENDERER)
+UI_DAL void ui_dal_blit_rgba8888(int32_t x, int32_t y, int32_t width, int32_t height,
+	const uint8_t *buf, int32_t stride)
+{
+	const uint8_t *fg;
+	uint8_t *bg;
+	int32_t a;
+	int i;
+	int j;
+
+	for (i = 0; i < height; i++) {
+		fg = buf + i * stride;
+		bg = &g_fb[BACK_PAGE][((y + i) * CONFIG_UI_DISPLAY_WIDTH + x) * 3];
+		for (j = 0; j < width; j++, fg += 4, bg += 3) {
+			a = fg[3];
+			if (a == 255) {
+				bg[0] = fg[0];
+				bg[1] = fg[1];
+				bg[2] = fg[2];
+			} else if (a != 0) {
+				bg[0] = ((fg[0] * a) + (bg[0] * (255 - a))) / 255;
+				bg[1] = ((fg[1] * a) + (bg[1] * (255 - a))) / 255;
+				bg[2] = ((fg[2] * a) + (bg[2] * (255 - a))) / 255;
+			}
+		}
+	}
+}
+#endif
+
 UI_DAL ui_error_t ui_dal_set_viewport(int32_t x, int32_t y, int32_t width, int32_t height)
 {
 	g_viewport.x = x;
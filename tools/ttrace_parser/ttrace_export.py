@@ -0,0 +1,357 @@
+#!/usr/bin/env python
+###########################################################################
+#
+# Copyright 2023 Samsung Electronics All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+# either express or implied. See the License for the specific
+# language governing permissions and limitations under the License.
+#
+###########################################################################
+#
+# Convert the kernel events exported by 'ttrace -x' into a timeline.
+#
+#   json : Chrome trace event format, opened by chrome://tracing or
+#          https://ui.perfetto.dev
+#   ctf  : Common Trace Format 1.8 directory (metadata + stream), read by
+#          babeltrace or Trace Compass
+#
+# The target prints the following lines, other lines are ignored:
+#   @TTI:<timestamp frequency> <ring capacity>
+#   @TTN:<pid> <task name>
+#   @TT:<seq> <timestamp> <pid> <type> <arg0 hex> <arg1 hex>
+#   @TTE:<exported events> <lost events>
+#
+# Example: ttrace_export.py -i console.log -o trace.json
+#          ttrace_export.py -i console.log -f ctf -o trace_ctf
+#
+
+from __future__ import print_function
+from optparse import OptionParser
+import json
+import os
+import struct
+import sys
+
+KEVENT_SWITCH = 1
+KEVENT_IRQENTER = 2
+KEVENT_IRQEXIT = 3
+KEVENT_SEMBLOCK = 4
+KEVENT_SEMWAKE = 5
+KEVENT_MALLOC = 6
+KEVENT_FREE = 7
+
+CTF_MAGIC = 0xc1fc1fc1
+
+
+def signed32(value):
+    return value - 0x100000000 if value >= 0x80000000 else value
+
+
+class Event(object):
+    def __init__(self, seq, stamp, pid, etype, arg0, arg1):
+        self.seq = seq
+        self.stamp = stamp
+        self.pid = pid
+        self.type = etype
+        self.arg0 = arg0
+        self.arg1 = arg1
+        self.cycles = 0
+
+
+class Trace(object):
+    def __init__(self):
+        self.freq = 0
+        self.names = {}
+        self.events = []
+        self.lost = 0
+
+    def parse(self, infile):
+        for line in infile:
+            idx = line.find('@TT')
+            if idx < 0:
+                continue
+            tag, _, body = line[idx:].strip().partition(':')
+            fields = body.split()
+            try:
+                if tag == '@TTI':
+                    self.freq = int(fields[0])
+                elif tag == '@TTN':
+                    self.names[int(fields[0])] = ' '.join(fields[1:])
+                elif tag == '@TT':
+                    self.events.append(Event(int(fields[0]), int(fields[1]), int(fields[2]),
+                                             int(fields[3]), int(fields[4], 16), int(fields[5], 16)))
+                elif tag == '@TTE':
+                    self.lost = int(fields[1])
+            except (IndexError, ValueError):
+                sys.stderr.write('skipped corrupted line: %s' % line)
+
+        # The timestamps are 32-bit and wrap.  Interrupts may record an event
+        # between the reservation and the timestamp of another one, so the
+        # order of the sequence numbers is only close to the time order.
+        self.events.sort(key=lambda ev: ev.seq)
+        cycles = 0
+        prev = None
+        for ev in self.events:
+            if prev is not None:
+                delta = (ev.stamp - prev) & 0xffffffff
+                if delta >= 0x80000000:
+                    delta -= 0x100000000
+                cycles += delta
+            prev = ev.stamp
+            ev.cycles = cycles
+        if self.events:
+            base = min(ev.cycles for ev in self.events)
+            for ev in self.events:
+                ev.cycles -= base
+        self.events.sort(key=lambda ev: (ev.cycles, ev.seq))
+
+    def usec(self, ev):
+        return ev.cycles * 1000000.0 / self.freq
+
+    def name(self, pid):
+        return self.names.get(pid, 'pid %d' % pid)
+
+
+def export_json(trace, out):
+    # pid 0 holds the CPU timeline and the interrupts, the tasks are threads
+    # of pid 1 to get their semaphore and heap events on separate tracks.
+    cpu_pid = 0
+    task_pid = 1
+    irq_tid = -1
+    events = [
+        {'ph': 'M', 'pid': cpu_pid, 'name': 'process_name', 'args': {'name': 'CPU 0'}},
+        {'ph': 'M', 'pid': cpu_pid, 'tid': 0, 'name': 'thread_name', 'args': {'name': 'running'}},
+        {'ph': 'M', 'pid': cpu_pid, 'tid': irq_tid, 'name': 'thread_name', 'args': {'name': 'irq'}},
+        {'ph': 'M', 'pid': task_pid, 'name': 'process_name', 'args': {'name': 'tasks'}},
+    ]
+    for pid in sorted(set(ev.pid for ev in trace.events) | set(trace.names)):
+        events.append({'ph': 'M', 'pid': task_pid, 'tid': pid, 'name': 'thread_name',
+                       'args': {'name': '%s (%d)' % (trace.name(pid), pid)}})
+
+    running = None
+    heap = {}
+    heap_used = 0
+    irq_depth = 0
+    for ev in trace.events:
+        ts = trace.usec(ev)
+        if ev.type == KEVENT_SWITCH:
+            if running is not None:
+                events.append({'ph': 'X', 'pid': cpu_pid, 'tid': 0, 'ts': running[1],
+                               'dur': ts - running[1], 'name': trace.name(running[0])})
+            running = (ev.pid, ts)
+            events.append({'ph': 'i', 's': 't', 'pid': task_pid, 'tid': ev.pid, 'ts': ts,
+                           'name': 'switch in', 'args': {'prio': ev.arg0, 'prev': signed32(ev.arg1)}})
+        elif ev.type == KEVENT_IRQENTER:
+            irq_depth += 1
+            events.append({'ph': 'B', 'pid': cpu_pid, 'tid': irq_tid, 'ts': ts,
+                           'name': 'irq %d' % ev.arg0, 'args': {'handler': '0x%08x' % ev.arg1}})
+        elif ev.type == KEVENT_IRQEXIT:
+            # The entry may have been overwritten in the ring
+            if irq_depth > 0:
+                irq_depth -= 1
+                events.append({'ph': 'E', 'pid': cpu_pid, 'tid': irq_tid, 'ts': ts})
+        elif ev.type == KEVENT_SEMBLOCK:
+            events.append({'ph': 'i', 's': 't', 'pid': task_pid, 'tid': ev.pid, 'ts': ts,
+                           'name': 'sem block', 'args': {'sem': '0x%08x' % ev.arg0}})
+        elif ev.type == KEVENT_SEMWAKE:
+            events.append({'ph': 'i', 's': 't', 'pid': task_pid, 'tid': ev.pid, 'ts': ts,
+                           'name': 'sem wake', 'args': {'sem': '0x%08x' % ev.arg0, 'woken': ev.arg1}})
+        elif ev.type == KEVENT_MALLOC:
+            heap[ev.arg0] = ev.arg1
+            heap_used += ev.arg1
+            events.append({'ph': 'i', 's': 't', 'pid': task_pid, 'tid': ev.pid, 'ts': ts,
+                           'name': 'malloc', 'args': {'addr': '0x%08x' % ev.arg0, 'size': ev.arg1}})
+            events.append({'ph': 'C', 'pid': cpu_pid, 'ts': ts, 'name': 'kernel heap',
+                           'args': {'bytes': heap_used}})
+        elif ev.type == KEVENT_FREE:
+            # Only the blocks allocated during the trace are accounted
+            heap_used -= heap.pop(ev.arg0, 0)
+            events.append({'ph': 'i', 's': 't', 'pid': task_pid, 'tid': ev.pid, 'ts': ts,
+                           'name': 'free', 'args': {'addr': '0x%08x' % ev.arg0}})
+            events.append({'ph': 'C', 'pid': cpu_pid, 'ts': ts, 'name': 'kernel heap',
+                           'args': {'bytes': heap_used}})
+
+    if running is not None and trace.events:
+        last = trace.usec(trace.events[-1])
+        events.append({'ph': 'X', 'pid': cpu_pid, 'tid': 0, 'ts': running[1],
+                       'dur': last - running[1], 'name': trace.name(running[0])})
+
+    json.dump({'traceEvents': events, 'displayTimeUnit': 'ns',
+               'otherData': {'lost_events': trace.lost, 'timestamp_freq': trace.freq}}, out)
+
+
+CTF_METADATA = '''/* CTF 1.8 */
+
+typealias integer { size = 8; align = 8; signed = false; } := uint8_t;
+typealias integer { size = 16; align = 8; signed = true; } := int16_t;
+typealias integer { size = 32; align = 8; signed = false; } := uint32_t;
+typealias integer { size = 32; align = 8; signed = false; base = 16; } := hex32_t;
+
+trace {
+	major = 1;
+	minor = 8;
+	byte_order = le;
+	packet.header := struct {
+		uint32_t magic;
+	};
+};
+
+env {
+	domain = "kernel";
+	sysname = "TizenRT";
+	tracer_name = "ttrace";
+	lost_events = %d;
+};
+
+clock {
+	name = cycles;
+	freq = %d;
+};
+
+typealias integer { size = 64; align = 8; signed = false; map = clock.cycles.value; } := cycles_t;
+
+stream {
+	event.header := struct {
+		uint8_t id;
+		cycles_t timestamp;
+		int16_t pid;
+		uint8_t cpu;
+	};
+};
+
+event {
+	name = "sched_switch";
+	id = 1;
+	fields := struct {
+		int16_t prev_pid;
+		string prev_comm;
+		int16_t next_pid;
+		string next_comm;
+		uint32_t next_prio;
+	};
+};
+
+event {
+	name = "irq_handler_entry";
+	id = 2;
+	fields := struct {
+		uint32_t irq;
+		hex32_t handler;
+	};
+};
+
+event {
+	name = "irq_handler_exit";
+	id = 3;
+	fields := struct {
+		uint32_t irq;
+	};
+};
+
+event {
+	name = "sem_block";
+	id = 4;
+	fields := struct {
+		hex32_t sem;
+	};
+};
+
+event {
+	name = "sem_wake";
+	id = 5;
+	fields := struct {
+		hex32_t sem;
+		int16_t woken_pid;
+	};
+};
+
+event {
+	name = "kmem_malloc";
+	id = 6;
+	fields := struct {
+		hex32_t ptr;
+		uint32_t size;
+	};
+};
+
+event {
+	name = "kmem_free";
+	id = 7;
+	fields := struct {
+		hex32_t ptr;
+	};
+};
+'''
+
+
+def ctf_string(text):
+    return text.encode('utf-8', 'replace') + b'\0'
+
+
+def export_ctf(trace, outdir):
+    if not os.path.isdir(outdir):
+        os.makedirs(outdir)
+    with open(os.path.join(outdir, 'metadata'), 'w') as f:
+        f.write(CTF_METADATA % (trace.lost, trace.freq))
+
+    # A single packet, which extends to the end of the file
+    data = [struct.pack('<I', CTF_MAGIC)]
+    for ev in trace.events:
+        data.append(struct.pack('<BQhB', ev.type, ev.cycles, ev.pid, 0))
+        if ev.type == KEVENT_SWITCH:
+            prev = signed32(ev.arg1)
+            data.append(struct.pack('<h', prev) + ctf_string(trace.name(prev)) +
+                        struct.pack('<h', ev.pid) + ctf_string(trace.name(ev.pid)) +
+                        struct.pack('<I', ev.arg0))
+        elif ev.type in (KEVENT_IRQENTER, KEVENT_MALLOC):
+            data.append(struct.pack('<II', ev.arg0, ev.arg1))
+        elif ev.type in (KEVENT_IRQEXIT, KEVENT_SEMBLOCK, KEVENT_FREE):
+            data.append(struct.pack('<I', ev.arg0))
+        elif ev.type == KEVENT_SEMWAKE:
+            data.append(struct.pack('<Ih', ev.arg0, ev.arg1 & 0xffff))
+        else:
+            raise ValueError('unknown event type %d' % ev.type)
+    with open(os.path.join(outdir, 'stream_0'), 'wb') as f:
+        f.write(b''.join(data))
+
+
+def main():
+    parser = OptionParser()
+    parser.add_option("-i", "--input", dest="input",
+                      help="captured console output of 'ttrace -x'. Default is stdin.", metavar="INPUT_FILE")
+    parser.add_option("-o", "--output", dest="output",
+                      help="output file for json, output directory for ctf", metavar="OUTPUT")
+    parser.add_option("-f", "--format", dest="format", default="json",
+                      help="json (Chrome/Perfetto) or ctf. Default is json.")
+    (options, args) = parser.parse_args()
+
+    trace = Trace()
+    infile = open(options.input, 'r') if options.input else sys.stdin
+    trace.parse(infile)
+    if trace.freq == 0:
+        sys.exit('no @TTI line found, was the log captured from "ttrace -x"?')
+
+    if options.format == 'json':
+        out = open(options.output, 'w') if options.output else sys.stdout
+        export_json(trace, out)
+    elif options.format == 'ctf':
+        if not options.output:
+            sys.exit('ctf needs an output directory (-o)')
+        export_ctf(trace, options.output)
+    else:
+        sys.exit('unknown format %s' % options.format)
+
+    sys.stderr.write('%d events, %d lost\n' % (len(trace.events), trace.lost))
+
+
+if __name__ == '__main__':
+    main()